@@ -14,6 +14,8 @@ using Nan::Set;
 NAN_MODULE_INIT(InitAll) {
   Set(target, New<String>("calculateNFP").ToLocalChecked(),
     GetFunction(New<FunctionTemplate>(calculateNFP)).ToLocalChecked());
+  Set(target, New<String>("calculateNFPBatch").ToLocalChecked(),
+    GetFunction(New<FunctionTemplate>(calculateNFPBatch)).ToLocalChecked());
 }
 
 NODE_MODULE(addon, InitAll)
@@ -1,4 +1,10 @@
 {
+    # The N-API solver needs a runtime with node_api.h (Node 8.6 and later),
+    # which the Electron this app is built for lacks, and deepnest-core
+    # built first; "npm run build-solver" does both and turns it on
+    "variables": {
+        "build_solver%": 0
+    },
     "targets": [
         {
             "target_name": "addon",
@@ -15,7 +21,41 @@
             "include_dirs" : [
  	 		"<!(node -e \"require('nan')\")",
             "/Users/jackqiao/boost_1_62_0/"
-		]
+		],
+            # calculateNFPBatch runs on boost threads
+            "libraries": [ "-lboost_thread", "-lboost_system" ]
         }
     ],
+    "conditions": [
+        ["build_solver==1", {
+            "targets": [
+                {
+                    "target_name": "solver",
+                    "sources": [ "solver.cc" ],
+                    'cflags!': [ '-fno-exceptions' ],
+              'cflags_cc!': [ '-fno-exceptions', '-fno-rtti' ],
+              'cflags_cc': [ '-std=c++17' ],
+              'conditions': [
+                ['OS=="mac"', {
+                  'xcode_settings': {
+                    'GCC_ENABLE_CPP_EXCEPTIONS': 'YES',
+                    'CLANG_CXX_LANGUAGE_STANDARD': 'c++17'
+                  }
+                }]
+              ],
+                    "include_dirs" : [
+                    "deepnest-cpp/include",
+                    "Clipper2Lib/include"
+        		],
+                    # deepnest-core built by "npm run build-core"
+                    "libraries": [
+                    "<(module_root_dir)/deepnest-cpp/build/libdeepnest-core.a",
+                    "-lboost_thread",
+                    "-lboost_chrono",
+                    "-lboost_system"
+        		]
+                }
+            ]
+        }]
+    ]
 }
@@ -15,6 +15,23 @@ win32 {
     DEFINES += _WIN32_WINNT=0x0601  # Windows 7 target
 }
 
+# Hot-path trace events (qmake CONFIG+=trace, see include/deepnest/Trace.h)
+trace {
+    DEFINES += DEEPNEST_TRACE=1
+}
+
+# Single-precision point coordinates (qmake CONFIG+=single_precision, see include/deepnest/core/Coord.h)
+single_precision {
+    DEFINES += DEEPNEST_SINGLE_PRECISION=1
+}
+
+# Batched NFP convolution on an OpenCL GPU (qmake CONFIG+=opencl, see include/deepnest/nfp/NFPAccelerator.h)
+opencl {
+    DEFINES += DEEPNEST_OPENCL=1
+    macx: LIBS += -framework OpenCL
+    else: LIBS += -lOpenCL
+}
+
 # Build directories
 DESTDIR = $$PWD/lib
 OBJECTS_DIR = $$PWD/build/obj
@@ -45,54 +62,125 @@ SOURCES += $$PWD/../Clipper2Lib/src/clipper.engine.cpp \
 # Headers
 HEADERS += \
     include/deepnest/core/Types.h \
+    include/deepnest/core/Coord.h \
     include/deepnest/core/Point.h \
     include/deepnest/core/BoundingBox.h \
+    include/deepnest/core/CoordinateBuffer.h \
+    include/deepnest/core/MultiRing.h \
+    include/deepnest/core/CoordinateKernels.h \
     include/deepnest/core/Polygon.h \
     include/deepnest/geometry/GeometryUtil.h \
     include/deepnest/geometry/GeometryUtilAdvanced.h \
     include/deepnest/geometry/PolygonOperations.h \
+    include/deepnest/geometry/PolygonHierarchy.h \
     include/deepnest/geometry/ConvexHull.h \
+    include/deepnest/geometry/EdgeGrid.h \
+    include/deepnest/geometry/ClipperContext.h \
+    include/deepnest/converters/SvgImporter.h \
+    include/deepnest/converters/DxfImporter.h \
+    include/deepnest/converters/JobFile.h \
+    include/deepnest/converters/ResultExporter.h \
+    include/deepnest/converters/QtMetaTypes.h \
     include/deepnest/geometry/Transformation.h \
     include/geometry/OrbitalHelpers.h \
     include/deepnest/nfp/NFPCache.h \
+    include/deepnest/nfp/NFPBackendSelector.h \
+    include/deepnest/nfp/NFPAccelerator.h \
+    include/deepnest/nfp/HoleIndex.h \
     include/deepnest/nfp/MinkowskiSum.h \
     include/deepnest/nfp/NFPCalculator.h \
+    include/deepnest/nfp/PersistentNFPStore.h \
     include/deepnest/config/DeepNestConfig.h \
+    include/deepnest/config/JsonWriter.h \
+    include/deepnest/algorithm/FeasibleRotations.h \
+    include/deepnest/algorithm/GenePairStatistics.h \
     include/deepnest/algorithm/Individual.h \
     include/deepnest/algorithm/Population.h \
+    include/deepnest/algorithm/SurrogateFitness.h \
     include/deepnest/algorithm/GeneticAlgorithm.h \
     include/deepnest/placement/PlacementStrategy.h \
     include/deepnest/placement/MergeDetection.h \
+    include/deepnest/placement/PlacementJob.h \
+    include/deepnest/placement/FitnessMemo.h \
+    include/deepnest/placement/EvaluationRecorder.h \
+    include/deepnest/placement/ShapeCache.h \
+    include/deepnest/placement/RemnantStore.h \
+    include/deepnest/placement/PlacementMemo.h \
+    include/deepnest/placement/Skyline.h \
+    include/deepnest/placement/RasterGrid.h \
     include/deepnest/placement/PlacementWorker.h \
+    include/deepnest/parallel/CancellationToken.h \
+    include/deepnest/parallel/ContentionStats.h \
+    include/deepnest/parallel/CpuTopology.h \
+    include/deepnest/parallel/ThreadCountController.h \
     include/deepnest/parallel/ParallelProcessor.h \
+    include/deepnest/parallel/RemoteWorker.h \
+    include/deepnest/parallel/WireFormat.h \
+    include/deepnest/parallel/WorkStealingScheduler.h \
     include/deepnest/engine/NestingEngine.h \
-    include/deepnest/DeepNestSolver.h
+    include/deepnest/engine/NestingDaemon.h \
+    include/deepnest/DeepNestSolver.h \
+    include/deepnest/StageTimes.h \
+    include/deepnest/Trace.h
 
 # Sources
 SOURCES += \
     src/core/Types.cpp \
+    src/core/CoordinateBuffer.cpp \
+    src/core/MultiRing.cpp \
+    src/core/CoordinateKernels.cpp \
     src/core/Point.cpp \
     src/core/Polygon.cpp \
     src/geometry/GeometryUtil.cpp \
     src/geometry/GeometryUtilAdvanced.cpp \
     src/geometry/PolygonOperations.cpp \
+    src/geometry/PolygonHierarchy.cpp \
     src/geometry/ConvexHull.cpp \
+    src/geometry/EdgeGrid.cpp \
+    src/geometry/ClipperContext.cpp \
     src/geometry/Transformation.cpp \
     src/geometry/OrbitalHelpers.cpp \
     src/nfp/NFPCache.cpp \
+    src/nfp/NFPBackendSelector.cpp \
+    src/nfp/NFPAccelerator.cpp \
+    src/nfp/HoleIndex.cpp \
     src/nfp/MinkowskiSum.cpp \
     src/nfp/NFPCalculator.cpp \
+    src/nfp/PersistentNFPStore.cpp \
     src/config/DeepNestConfig.cpp \
+    src/algorithm/FeasibleRotations.cpp \
+    src/algorithm/GenePairStatistics.cpp \
     src/algorithm/Individual.cpp \
     src/algorithm/Population.cpp \
+    src/algorithm/SurrogateFitness.cpp \
     src/algorithm/GeneticAlgorithm.cpp \
     src/placement/PlacementStrategy.cpp \
     src/placement/MergeDetection.cpp \
+    src/placement/PlacementJob.cpp \
+    src/placement/FitnessMemo.cpp \
+    src/placement/EvaluationRecorder.cpp \
+    src/placement/ShapeCache.cpp \
+    src/placement/RemnantStore.cpp \
+    src/placement/PlacementMemo.cpp \
+    src/placement/Skyline.cpp \
+    src/placement/RasterGrid.cpp \
     src/placement/PlacementWorker.cpp \
+    src/parallel/ContentionStats.cpp \
+    src/parallel/CpuTopology.cpp \
+    src/parallel/ThreadCountController.cpp \
     src/parallel/ParallelProcessor.cpp \
+    src/parallel/RemoteWorker.cpp \
+    src/parallel/WorkStealingScheduler.cpp \
     src/engine/NestingEngine.cpp \
+    src/engine/NestingDaemon.cpp \
     src/converters/QtBoostConverter.cpp \
-    src/DeepNestSolver.cpp
+    src/converters/SvgImporter.cpp \
+    src/converters/DxfImporter.cpp \
+    src/converters/JobFile.cpp \
+    src/converters/ResultExporter.cpp \
+    src/DeepNestSolver.cpp \
+    src/StageTimes.cpp \
+    src/Trace.cpp
 
 # Installation
 headers.files = $$HEADERS
@@ -204,4 +204,39 @@
     #define LOG_PLACEMENT(msg) ((void)0)
 #endif
 
+// =============================================================================
+// SAMPLED LOGGING (hot paths)
+// =============================================================================
+
+/**
+ * @brief Log the first `first` passes of a statement on each thread, then
+ *        every `every`-th pass (0 = none after the first ones)
+ *
+ * For code run once per evaluation, mutation or placement, where logging
+ * every pass would drown the output. The pass count is thread_local, so
+ * worker threads neither race on it nor share its cache line; msg may use
+ * `pass`, the 1-based count on the calling thread. Use the per-category
+ * macros below, which compile to nothing when the category is disabled.
+ */
+#define DEEPNEST_LOG_SAMPLED(tag, first, every, msg) \
+    do { \
+        thread_local unsigned long deepnestPassCount = 0; \
+        const unsigned long pass = ++deepnestPassCount; \
+        if (pass <= (first) || ((every) > 0 && pass % (every) == 0)) { \
+            std::cerr << tag << msg << std::endl; \
+        } \
+    } while (0)
+
+#if DEBUG_GA
+    #define LOG_GA_SAMPLED(first, every, msg) DEEPNEST_LOG_SAMPLED("[GA] ", first, every, msg)
+#else
+    #define LOG_GA_SAMPLED(first, every, msg) ((void)0)
+#endif
+
+#if DEBUG_PLACEMENT
+    #define LOG_PLACEMENT_SAMPLED(first, every, msg) DEEPNEST_LOG_SAMPLED("[PLACE] ", first, every, msg)
+#else
+    #define LOG_PLACEMENT_SAMPLED(first, every, msg) ((void)0)
+#endif
+
 #endif // DEEPNEST_DEBUG_CONFIG_H
@@ -4,7 +4,13 @@
 #include "engine/NestingEngine.h"
 #include "config/DeepNestConfig.h"
 #include "core/Polygon.h"
+#include "placement/RemnantStore.h"
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/thread/mutex.hpp>
+#include <future>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 #include <functional>
 
@@ -117,20 +123,26 @@ struct SheetSpec {
  * // Get best result
  * auto bestResult = solver.getBestResult();
  * ```
+ *
+ * Or, without a loop of its own, on an asio executor:
+ * ```cpp
+ * std::future<NestResult> best = solver.startAsync(io.get_executor(), 100);
+ * std::future<NestResult> better = solver.nextResult();
+ * ```
  */
 class DeepNestSolver {
 public:
     /**
      * @brief Default constructor
      *
-     * Creates solver with default configuration.
+     * Creates solver with a copy of DeepNestConfig's global instance.
      */
     DeepNestSolver();
 
     /**
      * @brief Constructor with custom configuration
      *
-     * @param config Configuration to use
+     * @param config Configuration to use (copied)
      */
     explicit DeepNestSolver(const DeepNestConfig& config);
 
@@ -179,7 +191,7 @@ public:
     /**
      * @brief Set placement type
      *
-     * @param type Placement type: "gravity", "box", or "convexhull"
+     * @param type Placement type: "gravity", "box", "convexhull", "skyline", or "raster"
      */
     void setPlacementType(const std::string& type);
 
@@ -218,6 +230,13 @@ public:
      */
     const DeepNestConfig& getConfig() const;
 
+    /**
+     * @brief Configuration of this solver, for settings without a setter
+     *
+     * Changes apply from the next start().
+     */
+    DeepNestConfig& getConfig();
+
     // Part and sheet management
 
     /**
@@ -238,6 +257,21 @@ public:
      */
     void addSheet(const Polygon& polygon, int quantity = 1, const std::string& name = "");
 
+    /**
+     * @brief Add the stored offcuts that may hold the added parts, ahead of
+     *        the sheets already added
+     *
+     * Candidates (RemnantStore::candidates) are added smallest first, one
+     * of each, so the nest fills offcuts before new stock. Add the parts
+     * first. The remnants stay in the store; remove the ones the result
+     * used.
+     *
+     * @param store Remnant store
+     * @param limit Remnants to add at most (0 = all candidates)
+     * @return Ids of the remnants added, in sheet order
+     */
+    std::vector<uint64_t> addRemnants(const RemnantStore& store, size_t limit = 0);
+
     /**
      * @brief Clear all parts
      */
@@ -267,6 +301,28 @@ public:
      */
     size_t getSheetCount() const;
 
+    /**
+     * @brief Replace configuration, parts and sheets with a job file's
+     *
+     * The file is memory-mapped (JobFile) and its polygons are taken as
+     * stored, without the cleaning and simplification addPart() applies,
+     * since saveJob() writes them already cleaned. Precomputed NFPs and
+     * offsets it carries are added to the configured NFP store, where
+     * the engine finds them on start(); without a store they are unused.
+     *
+     * @param path Job file path
+     * @throws std::runtime_error if the file is not a valid job
+     */
+    void loadJob(const std::string& path);
+
+    /**
+     * @brief Write configuration, parts and sheets to a job file
+     *
+     * @param path Job file path
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveJob(const std::string& path) const;
+
     // Nesting control
 
     /**
@@ -274,11 +330,36 @@ public:
      *
      * Initializes the nesting engine and begins optimization.
      *
+     * With config.progressive, a start() after parts were added or
+     * removed continues from the best result of the previous run instead
+     * of starting over: the NFP cache stays warm, sheets whose parts are
+     * all still wanted keep their placements, except the last one used,
+     * and the remaining parts are re-nested on the other sheets, starting
+     * from the previous genome with the added parts appended. Results then
+     * include the kept sheets (see prepareProgressive()).
+     *
      * @param maxGenerations Maximum generations to run (0 = unlimited)
      * @throws std::runtime_error if no parts or sheets added
      */
     void start(int maxGenerations = 0);
 
+    /**
+     * @brief Continue nesting from a checkpoint
+     *
+     * Like start(), but the populations, random generator state and saved
+     * results come from a NestingEngine checkpoint of the same parts,
+     * sheets and settings (see DeepNestConfig::checkpointPath). Individuals
+     * evaluated before the checkpoint are not placed again, and NFPs kept
+     * in the NFP store are not computed again.
+     *
+     * @param checkpointPath Checkpoint file path
+     * @param maxGenerations Maximum generations to run (0 = unlimited),
+     *                       counted from the start of the original run
+     * @throws std::runtime_error if no parts or sheets added, or the
+     *         checkpoint is missing or belongs to another job
+     */
+    void resume(const std::string& checkpointPath, int maxGenerations = 0);
+
     /**
      * @brief Stop nesting process
      *
@@ -307,13 +388,50 @@ public:
      * @brief Run nesting synchronously until complete
      *
      * Blocks until nesting completes or is stopped.
-     * Calls step() in a loop with small delays.
+     * Calls step() in a loop. Between steps it sleeps until a worker
+     * finishes an evaluation (NestingEngine::waitForEvaluation), so the next
+     * generation is bred and the result callback fires as soon as results
+     * land.
      *
      * @param maxGenerations Maximum generations to run
-     * @param stepDelayMs Delay between steps in milliseconds (default: 100)
+     * @param stepDelayMs Longest wait between steps in milliseconds
+     *                    (default: 100)
      */
     void runUntilComplete(int maxGenerations = 0, int stepDelayMs = 100);
 
+    /**
+     * @brief Run nesting on an executor, without blocking
+     *
+     * Starts like start(), then steps the engine from handlers on the
+     * executor, with a timer of stepDelayMs between steps, so the threads
+     * already running the executor (an io_context of a server, say) drive
+     * the nest and no thread waits on it. Callbacks run on those threads.
+     *
+     * Until the returned future is ready the solver belongs to the
+     * executor: post stop() and other calls to it rather than making them
+     * from another thread, and keep the solver alive.
+     *
+     * @param executor Executor to step on
+     * @param maxGenerations Maximum generations to run (0 = unlimited)
+     * @param stepDelayMs Delay between steps in milliseconds
+     * @return Best result once nesting completes or is stopped; holds a
+     *         std::runtime_error if none was found or the executor shut
+     *         down first
+     * @throws std::runtime_error if no parts or sheets added
+     */
+    std::future<NestResult> startAsync(const boost::asio::any_io_executor& executor,
+                                       int maxGenerations = 0, int stepDelayMs = 10);
+
+    /**
+     * @brief Next improved result, for consuming results as a stream
+     *
+     * The future becomes ready with the first result reported after the
+     * call, the one the result callback receives, or holds a
+     * std::runtime_error if the run ends first. Call again for the one
+     * after it. May be called from any thread.
+     */
+    std::future<NestResult> nextResult();
+
     // Results
 
     /**
@@ -326,16 +444,55 @@ public:
     /**
      * @brief Get best result found so far
      *
-     * @return Pointer to best result, or nullptr if no results yet
+     * Results are immutable snapshots: while nesting runs, other threads
+     * (a UI, an exporter) may call this and keep the result without a
+     * lock or a copy. Only start(), resume() and clearing must not race
+     * with it.
+     *
+     * @return Best result, or nullptr if no results yet
      */
-    const NestResult* getBestResult() const;
+    std::shared_ptr<const NestResult> getBestResult() const;
 
     /**
      * @brief Get all saved results
      *
-     * @return Vector of results, sorted by fitness (best first)
+     * A snapshot, as getBestResult() returns; later results do not
+     * change it.
+     *
+     * @return Results, sorted by fitness (best first); never nullptr
+     */
+    std::shared_ptr<const ResultHistory> getResults() const;
+
+    /**
+     * @brief Get NFP cache counters of the current or last run
+     *
+     * @return Hits, misses and size of the engine's NFP cache; all zero
+     *         before the first start()
      */
-    const std::vector<NestResult>& getResults() const;
+    NFPCache::Statistics getNfpCacheStatistics() const;
+
+    /**
+     * @brief Get lock contention counters of the current or last run
+     *
+     * Wait and hold histograms of the processor's and NFP cache's locks,
+     * task queue depth and wait, and busy/idle time per worker thread,
+     * counted from start() while config.lockProfiling is on. Compare runs
+     * at increasing thread counts to see which lock or queue stops scaling.
+     *
+     * @return Counters; all zero before the first start()
+     */
+    ContentionStats getContentionStats() const;
+
+    /**
+     * @brief Estimated memory of the nest by subsystem
+     *
+     * NFP cache, population, saved results and geometry, as also reported
+     * in NestProgress::memory. With config.memoryLimitMB set, the engine
+     * trims the NFP cache to keep the total under it.
+     *
+     * @return Sizes; all zero before the first start()
+     */
+    MemoryUsage getMemoryUsage() const;
 
     // Callbacks
 
@@ -359,15 +516,110 @@ public:
 
 private:
     /**
-     * @brief Configuration (singleton reference)
+     * @brief Create and initialize a fresh engine for start() and resume()
+     *
+     * @param progressive Continue from the best result of the previous
+     *        engine (config.progressive); see prepareProgressive()
+     */
+    void prepareEngine(bool progressive = false);
+
+    /**
+     * @brief Keep the unaffected sheets of an earlier result
+     *
+     * Parts and sheets are matched to those of the previous run by
+     * geometry. A sheet of previous keeps its placements while its sheet
+     * and every part on it are still wanted; the last sheet used is
+     * always re-nested, so added parts find room. Kept sheets go to
+     * frozen_ and their parts and sheets are taken off the quantities.
+     *
+     * @param previous Best result of the previous run
+     * @param partQuantities Quantities of parts_, lowered by the kept parts
+     * @param sheetQuantities Quantities of sheets_, lowered by the kept sheets
+     * @return Genome of the parts left, as NestingEngine::seed() takes it
+     */
+    std::vector<std::pair<int, double>> prepareProgressive(
+        const NestResult& previous,
+        std::vector<int>& partQuantities,
+        std::vector<int>& sheetQuantities);
+
+    /**
+     * @brief Result of the engine with the sheets kept in frozen_ added
+     */
+    NestResult combine(const NestResult& result) const;
+
+    /**
+     * @brief Engine progress callback: calls progressCallback_ with the
+     *        best fitness of results_ in a progressive run
+     */
+    NestingEngine::ProgressCallback engineProgressCallback();
+
+    /**
+     * @brief Engine result callback: keeps results_ and calls resultCallback_
+     */
+    NestingEngine::ResultCallback engineResultCallback();
+
+    /**
+     * @brief Hand a result to the futures of nextResult(), or with
+     *        result nullptr tell them the run ended
+     */
+    void notifyResultWaiters(const NestResult* result);
+
+    /**
+     * @brief Configuration of this solver, independent of other solvers
      */
-    DeepNestConfig& config_;
+    DeepNestConfig config_;
+
+    /**
+     * @brief Worker threads lent to every engine
+     *
+     * Kept across start()/stop() cycles and only rebuilt when
+     * config.threads, config.taskScheduler or the thread affinity
+     * settings change. Declared before
+     * engine_ so that it outlives it.
+     */
+    std::shared_ptr<ParallelProcessor> processor_;
 
     /**
      * @brief Nesting engine (created when start() is called)
      */
     std::unique_ptr<NestingEngine> engine_;
 
+    /**
+     * @brief NFP cache kept warm across progressive runs
+     *
+     * Dropped when a setting its keys leave out changes (nfpCacheSettings_).
+     */
+    std::shared_ptr<NFPCache> nfpCache_;
+    std::string nfpCacheSettings_;
+
+    /**
+     * @brief Parts and sheets the engine was initialized with, in full
+     */
+    std::vector<PartSpec> nestedParts_;
+    std::vector<SheetSpec> nestedSheets_;
+
+    /**
+     * @brief Sheets a progressive run kept from the previous result
+     *
+     * placements, sheets, area and fitness (their sheet area) of the kept
+     * sheets; no placements unless a progressive run kept any.
+     */
+    NestResult frozen_;
+
+    /**
+     * @brief Sheet index among sheets_ with quantities expanded of each
+     *        sheet the engine of a progressive run nests on
+     */
+    std::vector<size_t> engineSheets_;
+
+    /**
+     * @brief Results of a progressive run with frozen_ added, best first
+     *
+     * Published like NestingEngine's: replaced with std::atomic_store,
+     * read with std::atomic_load from other threads.
+     */
+    std::shared_ptr<const ResultHistory> results_ = std::make_shared<const ResultHistory>();
+
     /**
      * @brief Parts to nest
      */
@@ -388,6 +640,12 @@ private:
      */
     NestingEngine::ResultCallback resultCallback_;
 
+    /**
+     * @brief Promises of the pending nextResult() futures
+     */
+    std::vector<std::promise<NestResult>> resultWaiters_;
+    boost::mutex resultWaitersMutex_;
+
     /**
      * @brief Running flag
      */
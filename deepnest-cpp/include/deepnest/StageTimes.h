@@ -0,0 +1,150 @@
+#ifndef DEEPNEST_STAGE_TIMES_H
+#define DEEPNEST_STAGE_TIMES_H
+
+#include "parallel/ContentionStats.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file StageTimes.h
+ * @brief Wall and CPU time per pipeline stage, summed over all threads
+ *
+ * Where Trace records individual events for one run under a profiler,
+ * stage timing keeps only per-stage totals and is switched at run time
+ * (DeepNestConfig::stageTiming), so it can stay on in production to see
+ * whether a nest spends its time in NFPs, clipping, scoring or waiting.
+ * NestingEngine reports the totals in NestProgress.
+ *
+ * Each thread adds to its own counters, which a snapshot sums; a scope
+ * costs one relaxed load while timing is off.
+ */
+
+namespace deepnest {
+
+/**
+ * @brief Timed stages; nested stages are also counted in the outer one
+ */
+enum class Stage : size_t {
+    NfpInner,         // Inner NFP computation (NFPCalculator::computeInnerNFP)
+    NfpOuterCompute,  // Outer NFP computation or persistent store read
+    NfpOuterCached,   // Outer NFP lookups answered by the cache
+    NfpUnion,         // Union of the placed parts' outer NFPs in placeParts
+    NfpDifference,    // Inner NFP minus that union
+    Candidates,       // Candidate position extraction
+    Scoring,          // PlacementStrategy::findBestPosition (includes MergeDetection)
+    MergeDetection,   // MergeDetection::calculateMergedLength
+    Overlap,          // Overlap verification of chosen positions
+    Breeding,         // Selection, crossover and mutation of a generation
+    Wait,             // Blocked on an NFP another thread computes, or on evaluations
+    COUNT
+};
+
+constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::COUNT);
+
+/**
+ * @brief Totals per stage
+ *
+ * Times of concurrent threads add up, so wallNs of a stage can exceed
+ * the elapsed time of the nest.
+ */
+struct StageTimes {
+    struct Entry {
+        uint64_t count = 0;   // Scopes completed
+        uint64_t wallNs = 0;
+        uint64_t cpuNs = 0;   // CPU time of the timed thread
+    };
+
+    std::array<Entry, STAGE_COUNT> stages{};
+
+    const Entry& operator[](Stage stage) const { return stages[static_cast<size_t>(stage)]; }
+
+    /**
+     * @brief Counts accumulated since an earlier snapshot
+     */
+    StageTimes operator-(const StageTimes& earlier) const;
+
+    /**
+     * @brief Lower-case stage name, e.g. "nfpOuterCompute"
+     */
+    static const char* name(Stage stage);
+};
+
+/**
+ * @brief Process-wide stage counters
+ */
+class StageTimer {
+public:
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Totals of every thread since the process started
+     */
+    static StageTimes snapshot();
+
+    /**
+     * @brief Wall time distribution of one stage's scopes, all threads
+     */
+    static LatencyHistogram::Snapshot latency(Stage stage);
+
+    /**
+     * @brief Add one completed scope to the calling thread's counters
+     */
+    static void record(Stage stage, uint64_t wallNs, uint64_t cpuNs);
+
+    static uint64_t wallNow() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief CPU time consumed by the calling thread, in nanoseconds
+     */
+    static uint64_t cpuNow();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief Times one stage from construction to destruction
+ */
+class StageScope {
+public:
+    explicit StageScope(Stage stage)
+        : stage_(stage)
+        , active_(StageTimer::enabled())
+        , wall_(active_ ? StageTimer::wallNow() : 0)
+        , cpu_(active_ ? StageTimer::cpuNow() : 0) {}
+
+    ~StageScope() {
+        if (active_) {
+            StageTimer::record(stage_, StageTimer::wallNow() - wall_, StageTimer::cpuNow() - cpu_);
+        }
+    }
+
+    StageScope(const StageScope&) = delete;
+    StageScope& operator=(const StageScope&) = delete;
+
+private:
+    Stage stage_;
+    bool active_;
+    uint64_t wall_;
+    uint64_t cpu_;
+};
+
+} // namespace deepnest
+
+#define DEEPNEST_STAGE_CONCAT_(a, b) a##b
+#define DEEPNEST_STAGE_CONCAT(a, b) DEEPNEST_STAGE_CONCAT_(a, b)
+
+/**
+ * @brief Time the rest of the enclosing scope as Stage::stage
+ */
+#define STAGE_SCOPE(stage) \
+    ::deepnest::StageScope DEEPNEST_STAGE_CONCAT(stageScope_, __LINE__)(::deepnest::Stage::stage)
+
+#endif // DEEPNEST_STAGE_TIMES_H
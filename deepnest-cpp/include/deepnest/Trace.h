@@ -0,0 +1,142 @@
+#ifndef DEEPNEST_TRACE_H
+#define DEEPNEST_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file Trace.h
+ * @brief Scoped trace events of the hot paths, exported as Chrome trace JSON
+ *
+ * Unlike the LOG_* macros of DebugConfig.h, tracing writes nothing while
+ * the nest runs: each thread records fixed-size events into its own ring
+ * buffer, so the timing stays close to an untraced run, and the buffers
+ * are merged only when the trace is exported. The output opens in
+ * chrome://tracing and ui.perfetto.dev.
+ *
+ * Tracing is compiled in only with DEEPNEST_TRACE=1 (CMake option
+ * DEEPNEST_TRACE, qmake CONFIG+=trace); otherwise TRACE_SCOPE expands to
+ * nothing. When compiled in, recording still has to be switched on:
+ * ```cpp
+ * Trace::start();
+ * solver.runUntilComplete(10);
+ * Trace::stop();
+ * Trace::writeChromeTrace("nest.trace.json");
+ * ```
+ * Event names are "<category>.<name>" string literals; the category is
+ * what Chrome filters and colours by.
+ */
+#ifndef DEEPNEST_TRACE
+#define DEEPNEST_TRACE 0
+#endif
+
+namespace deepnest {
+
+/**
+ * @brief Per-thread ring buffers of completed trace events
+ *
+ * Always built, so callers can export without their own #if; only the
+ * TRACE_SCOPE macro depends on DEEPNEST_TRACE.
+ */
+class Trace {
+public:
+    /**
+     * @brief Drop earlier events and start recording
+     *
+     * @param eventsPerThread Ring size of every thread's buffer; once a
+     *        thread has recorded more, its oldest events are overwritten
+     */
+    static void start(size_t eventsPerThread = 65536);
+
+    /**
+     * @brief Stop recording; recorded events are kept for export
+     */
+    static void stop();
+
+    /**
+     * @brief Whether events are being recorded
+     */
+    static bool recording() {
+        return recording_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drop every recorded event
+     */
+    static void clear();
+
+    /**
+     * @brief Recorded events in the Chrome trace event format
+     *
+     * Call after stop(): a thread still recording may overwrite an event
+     * while it is being read.
+     */
+    static std::string chromeTraceJson();
+
+    /**
+     * @brief Write chromeTraceJson() to a file
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void writeChromeTrace(const std::string& path);
+
+    /**
+     * @brief Nanoseconds on the trace clock
+     */
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Record a completed event on the calling thread
+     *
+     * @param name String literal "<category>.<name>" (stored as a pointer)
+     */
+    static void record(const char* name, uint64_t beginNs, uint64_t endNs);
+
+private:
+    static std::atomic<bool> recording_;
+};
+
+/**
+ * @brief Records one event from construction to destruction
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(Trace::recording() ? name : nullptr)
+        , begin_(name_ ? Trace::now() : 0) {}
+
+    ~TraceScope() {
+        if (name_) {
+            Trace::record(name_, begin_, Trace::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;  // Null when not recording
+    uint64_t begin_;
+};
+
+} // namespace deepnest
+
+#define DEEPNEST_TRACE_CONCAT_(a, b) a##b
+#define DEEPNEST_TRACE_CONCAT(a, b) DEEPNEST_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing scope as one event
+ */
+#if DEEPNEST_TRACE
+    #define TRACE_SCOPE(name) ::deepnest::TraceScope DEEPNEST_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+    #define TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // DEEPNEST_TRACE_H
@@ -0,0 +1,52 @@
+#ifndef DEEPNEST_FEASIBLE_ROTATIONS_H
+#define DEEPNEST_FEASIBLE_ROTATIONS_H
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Rotations at which each part fits the sheets, by part id
+ *
+ * Built once per run by NestingEngine::initialize() from inner NFPs, so
+ * that genomes only carry rotations placeParts() can use and no
+ * evaluation pays for turning an infeasible first part again. A part
+ * without an entry may take any of config.rotations angles.
+ */
+class FeasibleRotations {
+public:
+    /**
+     * @brief Restrict a part to the given angles (degrees)
+     *
+     * An empty list is ignored: a part that fits at no angle is unplaceable
+     * at every one, so it keeps them all.
+     */
+    void set(int partId, std::vector<double> rotations);
+
+    /**
+     * @brief Whether rotation is a feasible angle of the part
+     */
+    bool allows(int partId, double rotation) const;
+
+    /**
+     * @brief Random feasible angle of the part
+     *
+     * Draws from the part's angles, or like the JavaScript
+     * (floor(random * rotations) * 360 / rotations) without an entry.
+     */
+    double sample(int partId, int numRotations, std::mt19937& rng) const;
+
+    /**
+     * @brief Number of restricted parts
+     */
+    size_t size() const { return rotations_.size(); }
+
+private:
+    std::unordered_map<int, std::vector<double>> rotations_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_FEASIBLE_ROTATIONS_H
@@ -0,0 +1,86 @@
+#ifndef DEEPNEST_GENE_PAIR_STATISTICS_H
+#define DEEPNEST_GENE_PAIR_STATISTICS_H
+
+#include "Individual.h"
+#include "Population.h"
+#include "../core/Polygon.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Outer NFPs the next generation is likely to need, from the genes of this one
+ *
+ * Children are cut from their parents' orders and turned by mutation, so
+ * parts that are adjacent in many genomes stay adjacent in the next
+ * generation, but may meet at rotations no genome has combined yet. Each
+ * genome adds its adjacent gene pairs, by part source and regardless of
+ * rotation, and the rotation of each of its genes; elite genomes, which
+ * breeding favours, count ELITE_WEIGHT times. The pair (A at a, B at b)
+ * scores the weight share of A-before-B adjacencies times the share of a
+ * among A's genes and of b among B's.
+ */
+class GenePairStatistics {
+public:
+    /**
+     * @brief Weight of an elite genome relative to the others
+     */
+    static constexpr double ELITE_WEIGHT = 4.0;
+
+    /**
+     * @brief One outer NFP, of part around placed
+     */
+    struct Candidate {
+        std::shared_ptr<const Polygon> placed;
+        double placedRotation;
+        std::shared_ptr<const Polygon> part;
+        double partRotation;
+        double score;  // Estimated probability a genome needs the pair adjacently
+    };
+
+    /**
+     * @brief Count a genome's adjacent pairs and rotations
+     */
+    void add(const Individual& individual, double weight);
+
+    /**
+     * @brief Count every genome of a population, the elite at ELITE_WEIGHT
+     */
+    void addPopulation(const Population& population);
+
+    /**
+     * @brief Highest-scoring pairs that pass a filter
+     *
+     * @param wanted Called on candidates in descending score order (ties in
+     *               no particular order); false skips one, e.g. when its
+     *               NFP is cached already
+     * @param limit Pairs to return at most
+     * @return Up to limit candidates, highest score first
+     */
+    std::vector<Candidate> ranked(const std::function<bool(const Candidate&)>& wanted, size_t limit) const;
+
+    /**
+     * @brief Total weight of the genomes counted
+     */
+    double weight() const { return total_; }
+
+private:
+    struct Shape {
+        std::shared_ptr<const Polygon> polygon;          // First copy seen
+        std::map<int32_t, std::pair<double, double>> rotations;  // Rotation key -> degrees, weight
+        double weight = 0.0;
+    };
+
+    std::unordered_map<int, Shape> shapes_;             // By part source
+    std::map<std::pair<int, int>, double> adjacent_;    // (earlier, later) source -> weight
+    double total_ = 0.0;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_GENE_PAIR_STATISTICS_H
@@ -23,15 +23,21 @@ namespace deepnest {
  * 3. Evolving population using selection, crossover, and mutation
  * 4. Repeating until convergence or max generations
  *
+ * With config.islands > 1 it runs that many populations (islands), each
+ * with its own random generator. An island advances to its next generation
+ * as soon as its own individuals are evaluated, and every
+ * config.migrationInterval of its generations its elite migrate to the
+ * next island in a ring (Population::immigrate).
+ *
  * References:
  * - deepnest.js: GeneticAlgorithm class (lines 1329-1463)
  */
 class GeneticAlgorithm {
 private:
     /**
-     * @brief Population manager
+     * @brief Island populations; a single one unless config.islands > 1
      */
-    Population population_;
+    std::vector<Population> islands_;
 
     /**
      * @brief Algorithm configuration
@@ -47,9 +53,20 @@ private:
     std::vector<std::shared_ptr<Polygon>> parts_;
 
     /**
-     * @brief Generation counter
+     * @brief Generation counter of each island
+     */
+    std::vector<int> generations_;
+
+    /**
+     * @brief Children bred in steady-state mode since the last generation,
+     *        per island
+     */
+    std::vector<size_t> offspring_;
+
+    /**
+     * @brief Advance an island's generation counter, migrating when due
      */
-    int currentGeneration_;
+    void advance(size_t island);
 
 public:
     /**
@@ -62,10 +79,12 @@ public:
      *
      * @param adam List of parts to be nested (order preserved in first individual)
      * @param config Algorithm configuration
+     * @param feasible Angles each part may take (nullptr = any of config.rotations)
      *
      * Corresponds to JavaScript GeneticAlgorithm constructor (line 1329-1346)
      */
-    GeneticAlgorithm(const std::vector<std::shared_ptr<Polygon>>& adam, const DeepNestConfig& config);
+    GeneticAlgorithm(const std::vector<std::shared_ptr<Polygon>>& adam, const DeepNestConfig& config,
+                     std::shared_ptr<const FeasibleRotations> feasible = nullptr);
 
     /**
      * @brief Create next generation
@@ -76,15 +95,40 @@ public:
      * 3. Fill rest with crossover + mutation
      *
      * Should be called only when current generation is complete (all evaluated).
+     * Advances every island.
      *
      * Corresponds to JavaScript generation() method (line 1411-1437)
      */
     void generation();
 
+    /**
+     * @brief Create the next generation of one island
+     *
+     * Should be called only when that island's generation is complete.
+     * Sends the island's elite to the next island when a migration is due.
+     *
+     * @param island Index below getIslandCount()
+     */
+    void generation(size_t island);
+
+    /**
+     * @brief Replace and breed without a generation barrier (steady-state)
+     *
+     * Evaluated children replace the worst members so that populationSize
+     * evaluated individuals remain, then children are bred until
+     * concurrency individuals await or are under evaluation. Every
+     * populationSize children bred advance the generation counter.
+     * Islands share concurrency evenly and count generations on their own.
+     *
+     * @param concurrency Evaluations to keep in flight
+     * @return True if getCurrentGeneration() advanced
+     */
+    bool breedOffspring(size_t concurrency);
+
     /**
      * @brief Get best individual from current population
      *
-     * Returns the individual with lowest (best) fitness value.
+     * Returns the individual with lowest (best) fitness value on any island.
      * Population should be evaluated before calling this.
      *
      * @return Best individual (by reference)
@@ -95,7 +139,7 @@ public:
      * @brief Check if current generation is complete
      *
      * Returns true if all individuals in population have been evaluated
-     * (have valid fitness values and are not processing).
+     * (have valid fitness values and are not processing), on every island.
      *
      * @return True if generation is complete, false otherwise
      *
@@ -106,16 +150,56 @@ public:
 
     /**
      * @brief Get current generation number
+     *
+     * The generation of the island furthest behind.
      */
     int getCurrentGeneration() const;
 
     /**
-     * @brief Get population size
+     * @brief Get number of islands
+     */
+    size_t getIslandCount() const;
+
+    /**
+     * @brief Get an island's population
+     */
+    Population& getIsland(size_t island);
+    const Population& getIsland(size_t island) const;
+
+    /**
+     * @brief Get an island's generation number
+     */
+    int getIslandGeneration(size_t island) const;
+
+    /**
+     * @brief Get an island's steady-state children bred since its last generation
+     */
+    size_t getIslandOffspring(size_t island) const;
+
+    /**
+     * @brief Set an island's counters when resuming from a checkpoint
+     */
+    void restoreIsland(size_t island, int generation, size_t offspring);
+
+    /**
+     * @brief Screen every island's children with a fitness estimate
+     *
+     * See Population::setSurrogate().
+     */
+    void setSurrogate(const std::shared_ptr<SurrogateFitness>& surrogate);
+
+    /**
+     * @brief Get population size (of the first island)
      */
     size_t getPopulationSize() const;
 
     /**
-     * @brief Get individual at index
+     * @brief Estimated bytes held by the individuals of every island
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief Get individual at index (of the first island)
      *
      * @param index Index in population
      * @return Individual reference
@@ -124,7 +208,7 @@ public:
     const Individual& getIndividual(size_t index) const;
 
     /**
-     * @brief Get all individuals in population
+     * @brief Get all individuals in population (of the first island)
      */
     std::vector<Individual>& getPopulation();
     const std::vector<Individual>& getPopulation() const;
@@ -132,14 +216,15 @@ public:
     /**
      * @brief Get Population object
      *
-     * Returns reference to the underlying Population object.
+     * Returns reference to the underlying Population object (the first
+     * island; see getIsland()).
      * This is needed for ParallelProcessor::processPopulation.
      */
     Population& getPopulationObject();
     const Population& getPopulationObject() const;
 
     /**
-     * @brief Get number of individuals currently being processed
+     * @brief Get number of individuals currently being processed, on all islands
      */
     size_t getProcessingCount() const;
 
@@ -174,6 +259,16 @@ public:
      */
     void reinitialize(const std::vector<std::shared_ptr<Polygon>>& adam);
 
+    /**
+     * @brief Start every island from a given first individual
+     *
+     * Replaces the populations with Population::seed(adam); the
+     * generation counters are kept.
+     *
+     * @param adam Genome over the parts of this algorithm
+     */
+    void seed(const Individual& adam);
+
     /**
      * @brief Get statistics about current state
      *
@@ -4,13 +4,39 @@
 #include "../core/Polygon.h"
 #include "../config/DeepNestConfig.h"
 #include "../placement/PlacementWorker.h"
+#include "FeasibleRotations.h"
+#include <atomic>
 #include <vector>
 #include <limits>
 #include <random>
 #include <memory>
+#include <utility>
 
 namespace deepnest {
 
+/**
+ * @brief Lifecycle of an individual's evaluation
+ */
+enum class EvaluationState {
+    PENDING,     // Not launched
+    PROCESSING,  // Running on a worker thread
+    DONE         // Result published, not yet collected
+};
+
+/**
+ * @brief Result slot of one launched evaluation
+ *
+ * Only the worker running the evaluation writes result, then stores DONE
+ * with release order. A thread that loads DONE (acquire) reads result
+ * without a lock.
+ */
+struct EvaluationSlot {
+    std::atomic<EvaluationState> state;
+    PlacementWorker::PlacementResult result;
+
+    EvaluationSlot() : state(EvaluationState::PROCESSING) {}
+};
+
 /**
  * @brief Represents an individual solution in the genetic algorithm
  *
@@ -72,22 +98,44 @@ public:
      * @brief Placements organized by sheet
      *
      * Contains the actual placement results - position and rotation of each part
-     * on each sheet. Populated when individual is evaluated.
+     * on each sheet. Only filled by collect() when asked for: most individuals
+     * never become results, so their placements are dropped and regenerated on
+     * demand (see NestingEngine::materialize()).
      */
     std::vector<std::vector<PlacementWorker::Placement>> placements;
 
     /**
-     * @brief Processing flag
+     * @brief Evaluation in flight, nullptr when none is
      *
-     * True when this individual is currently being evaluated by a worker thread.
-     * Used to prevent duplicate evaluations.
+     * Set when the evaluation is launched and cleared by collect(). Copies
+     * share the slot, so the result reaches the individual wherever sorting
+     * has moved it. Used to prevent duplicate evaluations.
      */
-    bool processing;
+    std::shared_ptr<EvaluationSlot> evaluation;
+
+    /**
+     * @brief Evaluated with coarse screening outlines
+     *
+     * Set before evaluation to place the parts' coarse outlines instead of
+     * their full geometry (see DeepNestConfig::coarseScreeningGenerations).
+     * A coarse fitness is a pessimistic estimate and its placements are not
+     * reported as results.
+     */
+    bool coarse;
+
+    /**
+     * @brief Evaluation stopped at the survival threshold
+     *
+     * fitness is a lower bound that is known to be worse than the elite
+     * at evaluation time, and placements are partial
+     * (see DeepNestConfig::branchAndBound).
+     */
+    bool bounded;
 
     /**
      * @brief Default constructor
      *
-     * Creates an individual with maximum fitness (uncomputed) and not processing.
+     * Creates an individual with maximum fitness (uncomputed) and no evaluation.
      */
     Individual();
 
@@ -97,21 +145,24 @@ public:
      * @param parts List of polygons to be nested (shared_ptr for thread safety)
      * @param config Configuration containing rotation settings
      * @param seed Random seed for rotation generation (optional)
+     * @param feasible Angles each part may take (optional, nullptr = any)
      *
      * Initializes placement with the given parts in order, and assigns
-     * random rotation angles based on config.rotations.
+     * random rotation angles based on config.rotations. With
+     * config.groupQuantities, consecutive copies of a part share one angle.
      *
      * PHASE 2: Changed from Polygon* to shared_ptr for thread safety.
      */
     Individual(const std::vector<std::shared_ptr<Polygon>>& parts,
                const DeepNestConfig& config,
-               unsigned int seed = std::random_device{}());
+               unsigned int seed = std::random_device{}(),
+               const FeasibleRotations* feasible = nullptr);
 
     /**
      * @brief Clone this individual
      *
      * Creates a deep copy of this individual with the same placement order,
-     * rotations, and fitness value. The processing flag is reset to false.
+     * rotations, and fitness value. The copy has no evaluation in flight.
      *
      * @return A new Individual that is a copy of this one
      *
@@ -129,10 +180,29 @@ public:
      * @param mutationRate Mutation rate as percentage (0-100)
      * @param numRotations Number of allowed rotations (e.g., 4 for 90° increments)
      * @param seed Random seed (optional)
+     * @param feasible Angles each part may take (optional, nullptr = any).
+     *        New rotations are drawn from them, and a gene whose part a
+     *        swap left at an infeasible angle is given a feasible one.
      *
      * Corresponds to JavaScript mutate() (line 1349-1371)
      */
-    void mutate(double mutationRate, int numRotations, unsigned int seed = std::random_device{}());
+    void mutate(double mutationRate, int numRotations, unsigned int seed = std::random_device{}(),
+                const FeasibleRotations* feasible = nullptr);
+
+    /**
+     * @brief Mutate runs of copies of one part as single genes
+     *
+     * Same as mutate() with each run of consecutive genes of one source
+     * part in place of a gene: runs swap with their neighbour and turn as
+     * a whole (see DeepNestConfig::groupQuantities).
+     */
+    void mutateGroups(double mutationRate, int numRotations, unsigned int seed,
+                      const FeasibleRotations* feasible = nullptr);
+
+    /**
+     * @brief Runs of consecutive genes of one source part, as [begin, end)
+     */
+    std::vector<std::pair<size_t, size_t>> groups() const;
 
     /**
      * @brief Check if this individual has been evaluated
@@ -141,6 +211,31 @@ public:
      */
     bool hasValidFitness() const;
 
+    /**
+     * @brief Lifecycle state of the evaluation
+     *
+     * PENDING also covers an individual whose result has been collected;
+     * hasValidFitness() tells the two apart.
+     */
+    EvaluationState state() const;
+
+    /**
+     * @brief Whether an evaluation has been launched and not yet collected
+     */
+    bool isProcessing() const { return evaluation != nullptr; }
+
+    /**
+     * @brief Take over the result of a finished evaluation
+     *
+     * Copies fitness, area, merged length and the bounded flag from the
+     * slot and drops it. Call from the thread that owns the population.
+     *
+     * @param keepPlacements Also copy the placements; otherwise placements
+     *        is left empty
+     * @return True if a result was collected, false if none is DONE
+     */
+    bool collect(bool keepPlacements = false);
+
     /**
      * @brief Reset fitness to uncomputed state
      *
@@ -155,6 +250,15 @@ public:
      */
     size_t size() const;
 
+    /**
+     * @brief Estimated bytes held by the genome and placements
+     *
+     * Includes the result of a DONE evaluation, not the one a worker is
+     * still writing; the parts themselves are shared and not counted.
+     * Call from the thread that owns the population.
+     */
+    size_t memoryBytes() const;
+
     /**
      * @brief Comparison operator for sorting by fitness
      *
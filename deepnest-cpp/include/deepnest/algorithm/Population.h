@@ -2,10 +2,12 @@
 #define DEEPNEST_POPULATION_H
 
 #include "Individual.h"
+#include "SurrogateFitness.h"
 #include "../config/DeepNestConfig.h"
 #include <vector>
 #include <random>
 #include <algorithm>
+#include <string>
 
 namespace deepnest {
 
@@ -35,6 +37,16 @@ private:
      */
     std::mt19937 rng_;
 
+    /**
+     * @brief Estimate that screens bred children, nullptr for none
+     */
+    std::shared_ptr<SurrogateFitness> surrogate_;
+
+    /**
+     * @brief Angles each part may take, nullptr for any
+     */
+    std::shared_ptr<const FeasibleRotations> feasible_;
+
 public:
     /**
      * @brief Constructor with config
@@ -61,6 +73,37 @@ public:
      */
     void initialize(const std::vector<std::shared_ptr<Polygon>>& parts);
 
+    /**
+     * @brief Initialize population from a given first individual
+     *
+     * Same as initialize() with adam's order and rotations in place of
+     * the parts' order and random rotations, e.g. the best genome of an
+     * earlier nest (see DeepNestConfig::progressive).
+     *
+     * @param adam Genome of the first individual; its fitness is dropped
+     */
+    void seed(const Individual& adam);
+
+    /**
+     * @brief Screen bred children with a fitness estimate
+     *
+     * While the estimate is reliable, nextGeneration() and breed() breed
+     * config.surrogateOversampling times the children they need and keep
+     * the best estimated ones.
+     *
+     * @param surrogate Estimate, or nullptr to keep every child bred
+     */
+    void setSurrogate(std::shared_ptr<SurrogateFitness> surrogate);
+
+    /**
+     * @brief Draw rotations only from the angles each part fits at
+     *
+     * Applies to initialize() and every later mutation; set it first.
+     *
+     * @param feasible Angles by part, or nullptr for any of config.rotations
+     */
+    void setFeasibleRotations(std::shared_ptr<const FeasibleRotations> feasible);
+
     /**
      * @brief Perform single-point crossover between two parents
      *
@@ -87,11 +130,24 @@ public:
      * The population should be sorted by fitness before calling this method.
      *
      * @param exclude Optional individual to exclude from selection
-     * @return Selected individual
+     * @return Selected individual, valid until the population changes
      *
      * Corresponds to JavaScript randomWeightedIndividual() (line 1440-1463)
      */
-    Individual selectWeightedRandom(const Individual* exclude = nullptr);
+    const Individual& selectWeightedRandom(const Individual* exclude = nullptr);
+
+    /**
+     * @brief Rank picked by selectWeightedRandom() for a random draw
+     *
+     * The JavaScript weight series gives rank i the interval up to
+     * weight * (1 + 2 * (i*n - i*(i-1)/2) / n), weight = 1/n; the rank
+     * holding the draw is bisected on that closed form.
+     *
+     * @param rand Uniform draw in [0, 1)
+     * @param count Number of individuals to choose from (at least 1)
+     * @return Rank in [0, count), 0 = best
+     */
+    static size_t weightedRank(double rand, size_t count);
 
     /**
      * @brief Create next generation using genetic operations
@@ -105,11 +161,51 @@ public:
      */
     void nextGeneration();
 
+    /**
+     * @brief Append children of the evaluated individuals (steady-state)
+     *
+     * Sorts the population by fitness and appends children produced by
+     * crossover and mutation of parents selected among the evaluated
+     * individuals only. Individuals under evaluation stay in place.
+     *
+     * @param count Number of children to append
+     * @return Number of children appended; 0 while fewer than two
+     *         individuals are evaluated
+     */
+    size_t breed(size_t count);
+
+    /**
+     * @brief Drop the worst evaluated individuals (steady-state)
+     *
+     * Keeps the best size evaluated individuals and every individual that
+     * is not evaluated yet, so evaluated children replace the worst members.
+     *
+     * @param size Number of evaluated individuals to keep
+     */
+    void cull(size_t size);
+
+    /**
+     * @brief Take in an individual evaluated on another island
+     *
+     * The migrant replaces an individual that waits for evaluation and has
+     * not been launched, else the worst evaluated individual if the
+     * migrant is better. Individuals under evaluation are never replaced.
+     *
+     * @param migrant Evaluated individual; a copy is taken
+     * @return True if the migrant was taken in
+     */
+    bool immigrate(const Individual& migrant);
+
     /**
      * @brief Get current population size
      */
     size_t size() const;
 
+    /**
+     * @brief Estimated bytes held by the individuals (Individual::memoryBytes)
+     */
+    size_t memoryBytes() const;
+
     /**
      * @brief Check if population is empty
      */
@@ -134,6 +230,19 @@ public:
      */
     const Individual& getBest() const;
 
+    /**
+     * @brief Number of best individuals carried into the next generation
+     */
+    size_t eliteCount() const;
+
+    /**
+     * @brief Fitness an individual must beat to be among the elite
+     *
+     * The eliteCount()-th best fitness evaluated so far, or infinity while
+     * fewer individuals have been evaluated.
+     */
+    double survivalThreshold() const;
+
     /**
      * @brief Sort population by fitness (ascending)
      */
@@ -154,6 +263,18 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Random generator state (std::mt19937 text form), for checkpoints
+     */
+    std::string getGeneratorState() const;
+
+    /**
+     * @brief Continue the random sequence of a getGeneratorState() result
+     *
+     * @throws std::invalid_argument if the state cannot be parsed
+     */
+    void setGeneratorState(const std::string& state);
+
 private:
     /**
      * @brief Check if a placement sequence contains a polygon by ID
@@ -166,6 +287,58 @@ private:
      * @brief Find index of individual in population (by pointer comparison)
      */
     int findIndividualIndex(const Individual* individual) const;
+
+    /**
+     * @brief No individual, for selectWeightedIndex()
+     */
+    static constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+
+    /**
+     * @brief selectWeightedRandom() among the first poolSize individuals
+     *
+     * Ranks the pool in place and returns an index, so breeding copies
+     * neither the population nor the parents. The rank comes from
+     * weightedRank(), O(log poolSize) with no allocation.
+     *
+     * @param exclude Index to skip (NO_INDEX = none)
+     */
+    size_t selectWeightedIndex(size_t poolSize, size_t exclude = NO_INDEX);
+
+    /**
+     * @brief Append the parent's genes the child does not hold yet, in order
+     *
+     * Uses a table indexed by part id, so a crossover is linear in the
+     * number of parts; ids that are not indices fall back to containsPolygon().
+     */
+    static void appendMissing(Individual& child, const Individual& parent);
+
+    /**
+     * @brief Mutate a child, by runs with config.groupQuantities
+     */
+    void mutate(Individual& individual);
+
+    /**
+     * @brief Crossover cut moved onto a boundary between runs of copies
+     *
+     * Moves back to the start of the run holding the cut, or, in the first
+     * run, forward to its end.
+     */
+    static size_t groupBoundary(const Individual& individual, size_t cut);
+
+    /**
+     * @brief Number of children to breed for count children kept
+     */
+    size_t childrenToBreed(size_t count) const;
+
+    /**
+     * @brief Keep the count best estimated children (see setSurrogate())
+     */
+    void screen(std::vector<Individual>& children, size_t count);
+
+    /**
+     * @brief Sort by fitness and count the evaluated individuals, which lead
+     */
+    size_t sortEvaluatedFirst();
 };
 
 } // namespace deepnest
@@ -0,0 +1,83 @@
+#ifndef DEEPNEST_SURROGATE_FITNESS_H
+#define DEEPNEST_SURROGATE_FITNESS_H
+
+#include "Individual.h"
+#include "../core/Polygon.h"
+#include <deque>
+#include <map>
+#include <utility>
+
+namespace deepnest {
+
+/**
+ * @brief Cheap fitness estimate used to screen children before placement
+ *
+ * Packs the bounding boxes of the genome's turned parts into columns on
+ * copies of the first sheet, in genome order, and scores the result with
+ * the sheet-area and width terms of PlacementWorker's fitness. This takes
+ * microseconds where placeParts() takes NFPs.
+ *
+ * The estimate only ranks children, so it is calibrated online against
+ * the real fitness of evaluated individuals: the correlation over the
+ * latest samples decides whether the ranking can be trusted (reliable()).
+ * Not thread-safe; used from the thread driving the genetic algorithm.
+ */
+class SurrogateFitness {
+public:
+    /**
+     * @param sheet Sheet the parts are nested on
+     */
+    explicit SurrogateFitness(const Polygon& sheet);
+
+    /**
+     * @brief Estimated fitness of the individual's genome (lower is better)
+     */
+    double estimate(const Individual& individual);
+
+    /**
+     * @brief Record the real fitness of an evaluated individual
+     *
+     * Call for full-resolution, unbounded evaluations only.
+     */
+    void observe(const Individual& individual);
+
+    /**
+     * @brief Whether the estimate tracks real fitness well enough to screen
+     */
+    bool reliable() const;
+
+    /**
+     * @brief Correlation between estimates and real fitness, 0 without samples
+     */
+    double correlation() const;
+
+private:
+    struct Extent {
+        double width;
+        double height;
+        double area;
+    };
+
+    /**
+     * @brief Bounding box size and area of a part turned by rotation degrees
+     */
+    const Extent& extent(const Polygon& part, double rotation);
+
+    double sheetWidth_;
+    double sheetHeight_;
+    double sheetArea_;
+
+    /**
+     * @brief Extents by (part id, rotation)
+     */
+    std::map<std::pair<int, double>, Extent> extents_;
+
+    /**
+     * @brief Latest (estimate, fitness) pairs, oldest first
+     */
+    std::deque<std::pair<double, double>> samples_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_SURROGATE_FITNESS_H
@@ -1,7 +1,6 @@
 #ifndef DEEPNEST_CONFIG_H
 #define DEEPNEST_CONFIG_H
 
-#include <QString>
 #include <string>
 #include <memory>
 
@@ -24,8 +23,11 @@ enum class GravityDirection {
 /**
  * @brief Configuration class for DeepNest algorithm
  *
- * This class uses the Singleton pattern to provide global access to
- * configuration parameters used throughout the nesting algorithm.
+ * The global instance (getInstance()) holds the process defaults. Each
+ * DeepNestSolver starts from a copy of it, and each NestingEngine keeps a
+ * copy of the configuration it was constructed with, which everything the
+ * engine runs reads instead of the global instance. Jobs with different
+ * settings can therefore run in one process, e.g. on a shared pool.
  * Parameters are extracted from deepnest.js and svgnest.js
  */
 class DeepNestConfig {
@@ -37,9 +39,9 @@ private:
     DeepNestConfig();
 
 public:
-    // Delete copy constructor and assignment operator
-    DeepNestConfig(const DeepNestConfig&) = delete;
-    DeepNestConfig& operator=(const DeepNestConfig&) = delete;
+    // Copies are per-job snapshots, independent of the global instance
+    DeepNestConfig(const DeepNestConfig&) = default;
+    DeepNestConfig& operator=(const DeepNestConfig&) = default;
 
     // Singleton accessor
     static DeepNestConfig& getInstance();
@@ -48,10 +50,16 @@ public:
     void resetToDefaults();
 
     // Load configuration from JSON file
-    void loadFromJson(const QString& path);
+    void loadFromJson(const std::string& path);
 
     // Save configuration to JSON file
-    void saveToJson(const QString& path) const;
+    void saveToJson(const std::string& path) const;
+
+    // Load configuration from JSON text (as written by toJsonData)
+    void loadFromJsonData(const std::string& data);
+
+    // Configuration as JSON text, e.g. for embedding in a job file
+    std::string toJsonData() const;
 
     // Configuration parameters (from deepnest.js lines 20-33)
 
@@ -63,6 +71,17 @@ public:
      */
     double clipperScale;
 
+    /**
+     * @brief Snap all placement geometry to the clipperScale grid once
+     *
+     * Parts, sheets and NFPs are rounded to multiples of 1/clipperScale
+     * when they are prepared, and placement keeps the union, difference,
+     * candidate and overlap steps in Clipper's int64 coordinates. Positions
+     * are then exact grid points instead of truncated doubles, at the cost
+     * of moving every vertex by up to half a grid step.
+     */
+    bool integerGeometry;
+
     /**
      * @brief Tolerance for curve approximation
      *
@@ -85,6 +104,39 @@ public:
      */
     int rotations;
 
+    /**
+     * @brief Restrict genomes to the rotations at which each part fits
+     *
+     * NestingEngine::initialize() computes from inner NFPs which rotations
+     * of each part fit the sheets, and the genetic algorithm only draws
+     * those, so placeParts() skips the JavaScript loop that turns a first
+     * part until it fits. Default: true
+     */
+    bool feasibleRotations;
+
+    /**
+     * @brief Treat the copies of a part as one gene
+     *
+     * The copies NestingEngine::initialize() expands from a quantity stay
+     * consecutive in every genome and share one rotation: mutation swaps
+     * and turns whole runs and crossover cuts between runs, so the genetic
+     * algorithm searches orders of distinct parts and placeParts() places
+     * each run in a row, on NFPs that are still hot. Default: false
+     */
+    bool groupQuantities;
+
+    /**
+     * @brief Fill the holes of large parts with small parts before nesting
+     *
+     * NestingEngine::initialize() places small parts greedily into the
+     * holes of parts with holes, largest first, through inner NFPs of the
+     * holes. Each filled part then enters the genetic algorithm as one
+     * composite part, without the holes it filled, and results list its
+     * members as placements of their own. Shortens the genome and the
+     * hole NFPs every evaluation computes. Default: false
+     */
+    bool holeFilling;
+
     /**
      * @brief Size of the genetic algorithm population
      *
@@ -101,18 +153,189 @@ public:
      */
     int mutationRate;
 
+    /**
+     * @brief Breed children as workers free up instead of by generation
+     *
+     * A child is bred and launched whenever an evaluation slot frees up,
+     * and evaluated children replace the worst members of the population.
+     * Every populationSize children bred count as one generation.
+     * Default: false (generational, as the JavaScript)
+     */
+    bool steadyState;
+
+    /**
+     * @brief Number of island sub-populations
+     *
+     * Each island holds populationSize individuals with its own random
+     * generator and advances its generations on its own; all islands share
+     * the NFP cache. Islands pass their elite on every migrationInterval
+     * generations. Default: 1 (one population, as the JavaScript)
+     */
+    int islands;
+
+    /**
+     * @brief Generations of an island between two elite migrations
+     *
+     * Ignored with a single island.
+     */
+    int migrationInterval;
+
+    /**
+     * @brief Children bred per child kept in nextGeneration()
+     *
+     * Breeds this many times the children a generation needs and keeps the
+     * ones a cheap shelf-packing estimate ranks best, so fewer weak children
+     * reach placeParts(). Screening starts once the estimate has proven to
+     * track real fitness. Default: 1 (no screening)
+     */
+    int surrogateOversampling;
+
     /**
      * @brief Number of threads to use for parallel processing
      */
     int threads;
 
+    /**
+     * @brief Tune the number of threads evaluating to the throughput
+     *
+     * Measures evaluations per second and stall indicators each
+     * generation and moves the number of threads running this nest's
+     * tasks between minThreads and threads (ThreadCountController).
+     * Worth it where throughput peaks below the core count, on memory-
+     * bound nests or machines shared with other jobs. The level chosen
+     * is reported in NestProgress::activeThreads.
+     * Default: false
+     */
+    bool adaptiveThreads;
+
+    /**
+     * @brief Fewest threads adaptiveThreads goes down to
+     * Default: 1
+     */
+    int minThreads;
+
+    /**
+     * @brief Task queue of the worker thread pool
+     *
+     * Options: "workstealing" (per-thread deques; nested work such as
+     * parallel candidate scoring stays on the forking thread unless an
+     * idle thread steals it), "asio" (one shared io_context queue).
+     * Default: "workstealing"
+     */
+    std::string taskScheduler;
+
+    /**
+     * @brief Pin each worker thread to one CPU
+     *
+     * Keeps a thread's deque and caches on one core instead of letting the
+     * OS migrate it. Can hurt when other processes share the machine.
+     * Default: false
+     */
+    bool pinWorkerThreads;
+
+    /**
+     * @brief Group worker threads by NUMA node
+     *
+     * Each node gets its own threads and task queue; evaluations starting
+     * with the same part and rotation are sent to the same node, and idle
+     * threads steal from their own node first. Only has an effect with the
+     * "workstealing" scheduler on multi-socket Linux machines.
+     * Default: false
+     */
+    bool numaScheduling;
+
+    /**
+     * @brief Count lock waits and holds, task queue depth and worker idle
+     *        time (see DeepNestSolver::getContentionStats)
+     *
+     * Costs two clock reads per lock acquisition and task while on; the
+     * switch is process-wide (LockStats::setEnabled).
+     * Default: false
+     */
+    bool lockProfiling;
+
+    /**
+     * @brief Time the NFP, clipping, scoring, breeding and wait stages
+     *        (NestProgress::stageTimes)
+     *
+     * Costs a wall and a thread CPU clock read at both ends of every timed
+     * scope while on; the switch is process-wide (StageTimer::setEnabled).
+     * Default: false
+     */
+    bool stageTiming;
+
+    /**
+     * @brief Directory for recordings of slow evaluations
+     *
+     * When set, evaluations taking more than evaluationRecordFactor times
+     * the median are written here with their genome and cached NFPs, for
+     * the EvaluationReplay tool (see EvaluationRecorder). Each evaluation
+     * then collects the cache entries it looks up.
+     * Empty = no recording (default)
+     */
+    std::string evaluationRecordPath;
+
+    /**
+     * @brief Slowdown over the median evaluation that gets recorded
+     * Default: 50
+     */
+    double evaluationRecordFactor;
+
+    /**
+     * @brief Recordings written per run at most
+     * Default: 10
+     */
+    int evaluationRecordLimit;
+
+    /**
+     * @brief Launch each generation's evaluations longest predicted first
+     *
+     * The prediction weighs an individual's parts and the NFPs it needs
+     * that are not cached yet, fitted to the times of earlier evaluations.
+     * Shortens the tail of a generation where a few threads finish long
+     * evaluations while the others idle. Results do not change.
+     * Default: true
+     */
+    bool longestFirst;
+
+    /**
+     * @brief Remote worker processes, as a comma-separated "host:port" list
+     *
+     * Each runs a RemoteWorkerServer. Evaluations that find every local
+     * thread busy go to these nodes, which receive the job once per run.
+     * Empty = evaluate locally only (default)
+     */
+    std::string remoteWorkers;
+
+    /**
+     * @brief Shared secret sent to remote workers when connecting
+     *
+     * Must match the token the RemoteWorkerServer was started with, or the
+     * node turns the job down. Not part of the job snapshot, so evaluation
+     * recordings do not hold it.
+     * Default: empty (for nodes started without a token)
+     */
+    std::string remoteWorkerToken;
+
     /**
      * @brief Type of placement strategy to use
      *
-     * Options: "gravity", "boundingbox", "convexhull"
+     * Options: "gravity", "boundingbox", "convexhull", "skyline", "raster"
+     * ("skyline" packs rectangular parts without NFPs, "raster" places
+     * every part on an occupancy bitmap of rasterCellSize cells)
      */
     std::string placementType;
 
+    /**
+     * @brief Cell size of the "raster" placement bitmap, in part units
+     *
+     * Smaller cells pack tighter and scan longer. Positions are refined
+     * with exact geometry by up to one cell toward the top-left, so the
+     * cell size bounds the gap the raster leaves between parts.
+     * 0 = 1/256 of the longer side of the first sheet. Default: 0
+     */
+    double rasterCellSize;
+
     /**
      * @brief Whether to detect and optimize merged lines
      *
@@ -161,8 +384,10 @@ public:
     /**
      * @brief Whether to explore concave regions for better NFP
      *
-     * Experimental feature for finding additional NFP regions
-     * in concave polygons
+     * Outer NFPs of a concave stationary part are traced with the orbital
+     * backend from every start point, the loops in parallel, so a part can
+     * be placed in a pocket of another that it cannot slide into. Slower
+     * than the Minkowski backends. Default: false
      */
     bool exploreConcave;
 
@@ -178,19 +403,289 @@ public:
     // Additional runtime parameters
 
     /**
-     * @brief Maximum number of iterations for the nesting algorithm
+     * @brief Maximum number of generations for the nesting algorithm
+     *
+     * Caps the maxGenerations passed to NestingEngine::start(). 0 = unlimited
      */
     int maxIterations;
 
     /**
-     * @brief Timeout in seconds for the nesting process
+     * @brief Wall-clock budget in seconds for the nesting process
+     *
+     * Counted from NestingEngine::start(); the run ends with the best result
+     * found so far. 0 = no timeout
      */
     int timeoutSeconds;
 
     /**
-     * @brief Whether to use progressive nesting
+     * @brief Generations without a better result after which nesting stops
+     *
+     * 0 = never stop for lack of improvement
+     */
+    int stallGenerations;
+
+    /**
+     * @brief Stop once the best result reaches the sheet lower bound
+     *
+     * NestingEngine::initialize() bounds the sheets any layout needs from
+     * part and sheet areas (see NestingEngine::getSheetLowerBound()). When
+     * the best result places every part on that many sheets, the run ends
+     * as a generation budget would, with the local search of polishMoves
+     * compacting the layout. Default: false
+     */
+    bool stopAtSheetBound;
+
+    /**
+     * @brief Moves per round of the local search that ends a run
+     *
+     * When a generation or convergence budget ends the run, swap, insert
+     * and rotate moves are applied to the best individual, evaluated in
+     * parallel, and the best improving one is kept, round after round until
+     * none improves. 0 = no local search
+     */
+    int polishMoves;
+
+    /**
+     * @brief Generations of the per-sheet sub-nests that end a run
+     *
+     * When a budget ends the run (not a timeout), the parts the best
+     * individual puts on each sheet are frozen to that sheet, and every
+     * sheet is nested on its own for this many generations, all sheets in
+     * parallel on the pool (see NestingEngine::decompose()). The layouts
+     * are recombined and reported if they beat the best result. Worth it
+     * on jobs of many sheets, where one evaluation of the whole job places
+     * every part on every sheet in turn. 0 = off. Default: 0
+     */
+    int sheetDecompositionGenerations;
+
+    /**
+     * @brief Generations the best result must keep each sheet's parts
+     *        before the sheet sub-nests take over
+     *
+     * Ends the run as stallGenerations would, counting generations since
+     * the parts on each sheet of the best result last changed, once that
+     * result places every part on two sheets or more (otherwise there is
+     * nothing to decompose and the GA goes on). Only with
+     * sheetDecompositionGenerations; 0 = wait for another budget.
+     * Default: 10
+     */
+    int sheetDecompositionStall;
+
+    /**
+     * @brief Try other orders of the sheet types for each new best result
+     *
+     * With sheets of more than one shape, every new best genome is also
+     * placed, in parallel, on orders that start with each sheet type and
+     * on the sheets by ascending and descending area. An order that does
+     * better is reported as a result (NestResult::sheets). Part-vs-part
+     * NFPs are shared by all orders. Default: false
+     */
+    bool sheetOrderSearch;
+
+    /**
+     * @brief Outer NFPs to prefetch speculatively each generation
+     *
+     * NestingEngine ranks the pairs the next generation is likely to need
+     * by how often their parts are adjacent in the current genomes, the
+     * elite's counting most, and by how often each part takes each
+     * rotation (see GenePairStatistics). Up to this many that are not
+     * cached are queued behind the generation's work, so threads idle at
+     * its tail compute them. 0 = off. Default: 0
+     */
+    int speculativeNfpPairs;
+
+    /**
+     * @brief Evaluate a greedy individual first, for an early first result
+     *
+     * The first individual of the first island takes the parts by
+     * descending area, each at the rotation with the smallest bounding
+     * box that fits the first sheet. start() launches it, at full
+     * resolution even while the islands screen, before the rest of the
+     * population, and queues its NFPs on the pool right behind it, so its
+     * layout is reported as soon as those NFPs are computed. The GA then
+     * breeds from it like any other individual. Default: true
+     */
+    bool greedyFirstResult;
+
+    /**
+     * @brief Memory budget for the NFP cache in megabytes
+     *
+     * When the cached NFPs exceed this size, entries that are cheap to
+     * recompute relative to their size are evicted first.
+     * 0 = unlimited (cache grows for the whole engine lifetime)
+     */
+    int nfpCacheMaxMemoryMB;
+
+    /**
+     * @brief Keep cached NFPs delta-encoded on the Clipper grid
+     *
+     * Several times less memory per cached NFP, paid for by decoding on
+     * lookup (see NFPCache::setCompactStorage). NFP points move by at most
+     * 1/clipperScale, and not at all with integerGeometry.
+     */
+    bool nfpCacheCompact;
+
+    /**
+     * @brief Ceiling on the memory a nest tracks, in megabytes
+     *
+     * Checked after every round of collected evaluations against
+     * NestingEngine::getMemoryUsage(). Above it the NFP cache is trimmed
+     * to what the rest leaves over, and the fitness memo is dropped if
+     * that is not enough. 0 = no ceiling
+     */
+    int memoryLimitMB;
+
+    /**
+     * @brief Path of the persistent on-disk NFP store
+     *
+     * When set, NFPs are looked up in and appended to this file so that
+     * repeated runs over the same parts skip most Minkowski work.
+     * The file can be shared by several processes on the same host.
+     * Empty = disabled
+     */
+    std::string nfpStorePath;
+
+    /**
+     * @brief Path of the engine's checkpoint file
      *
-     * If true, nests parts incrementally; if false, nests all at once
+     * When set, the engine snapshots the populations, RNG state and best
+     * results here every checkpointGenerations generations and when the run
+     * ends; DeepNestSolver::resume() continues from it.
+     * Empty = no checkpoints
+     */
+    std::string checkpointPath;
+
+    /**
+     * @brief Generations between checkpoints (see checkpointPath)
+     * Default: 5
+     */
+    int checkpointGenerations;
+
+    /**
+     * @brief Keep the NFP cache with the checkpoint
+     *
+     * Without an nfpStorePath, NFPs are appended to a store next to the
+     * checkpoint (checkpointPath + ".nfp") as they are computed, so a
+     * resumed run does not compute them again.
+     * Default: true
+     */
+    bool checkpointNFPs;
+
+    /**
+     * @brief Cache outer NFPs by relative rotation
+     *
+     * NFP(rot(A,a), rot(B,b)) = rot(NFP(A, rot(B,b-a)), a), so outer NFPs
+     * are computed and cached with A unrotated and keyed by b-a; lookups
+     * rotate the cached NFP into place. Cuts NFP work and memory by up to
+     * the number of rotations, at the cost of a rotation per lookup.
+     * Default: false
+     */
+    bool nfpRotationEquivariant;
+
+    /**
+     * @brief Path of the NFP backend cost profile
+     *
+     * When the file exists, its calibrated cost models pick the NFP engine
+     * (convex merge, Clipper2, Boost.Polygon, orbital, libnfporb) for each
+     * outer NFP pair. Empty = built-in dispatch
+     */
+    std::string nfpBackendProfilePath;
+
+    /**
+     * @brief Benchmark the NFP backends on the job's parts at startup
+     *
+     * The fitted cost models are used for the run and written to
+     * nfpBackendProfilePath when it is set.
+     * Default: false
+     */
+    bool nfpBackendCalibrate;
+
+    /**
+     * @brief Convolve batched Minkowski sums on a GPU when one is present
+     *
+     * Only takes effect in builds with an accelerator compiled in (see
+     * NFPAccelerator); the NFPs are the same as on the CPU.
+     * Default: true
+     */
+    bool nfpAcceleration;
+
+    /**
+     * @brief Number of early generations evaluated with coarse NFPs
+     *
+     * Individuals of these generations are placed with conservative
+     * low-resolution outlines of the parts (see coarseScreeningTolerance),
+     * whose layouts never overlap at full resolution. Only the elite is
+     * re-evaluated at full resolution before it is reported or carried into
+     * a later generation.
+     * -1 = automatic: each island screens until its best fitness stops
+     *      improving, then switches to full resolution (default)
+     * 0 = disabled
+     */
+    int coarseScreeningGenerations;
+
+    /**
+     * @brief Simplification tolerance of the coarse screening outlines
+     *
+     * Outlines are simplified with this tolerance and grown by it, so they
+     * contain the part (in same units as input geometry). Default: 2.0
+     */
+    double coarseScreeningTolerance;
+
+    /**
+     * @brief Memory budget for first-sheet placement snapshots in megabytes
+     *
+     * Placements of individuals that share a gene prefix with an earlier
+     * individual resume from the stored first-sheet state of that prefix.
+     * Results are unchanged. 0 = disabled (default)
+     */
+    int placementMemoMaxMemoryMB;
+
+    /**
+     * @brief Complete evaluations remembered by genome
+     *
+     * An individual whose genes (part order, rotations and resolution)
+     * match an earlier evaluation of the run gets its fitness and
+     * placements without being placed again. 0 = disabled. Default: 4096
+     */
+    int fitnessMemoMaxEntries;
+
+    /**
+     * @brief Stop evaluations that cannot reach the elite
+     *
+     * Each placement stops once a lower bound on its fitness (sheet area
+     * used, the penalty of parts that exceed the remaining sheet area, minus
+     * the longest possible merged lines) exceeds the fitness the population
+     * needs to keep an elite place. Such individuals rank by that bound.
+     * Default: false
+     */
+    bool branchAndBound;
+
+    /**
+     * @brief Candidate count from which positions are scored in parallel
+     *
+     * A part with at least this many candidate positions has them scored
+     * in chunks on idle worker threads. The chosen position is the same as
+     * with serial scoring. 0 = always serial. Default: 1024
+     */
+    int parallelScoringThreshold;
+
+    /**
+     * @brief Recompute merged lines in a full pass after placement
+     *
+     * By default the fitness credits the merged length the placement
+     * strategy found at each chosen position, as the JavaScript does. When
+     * true, the merges of all placed parts are recomputed once placement is
+     * done and that total is used instead. Default: false
+     */
+    bool validateMergedLines;
+
+    /**
+     * @brief Re-nest incrementally when parts are added or removed
+     *
+     * A DeepNestSolver::start() after a run continues from its best
+     * result: the NFP cache stays warm, sheets whose parts are all still
+     * wanted keep their layout, and only the other sheets are re-nested,
+     * starting from the previous genome. Default: false
      */
     bool progressive;
 
@@ -213,7 +708,9 @@ public:
     /**
      * @brief Random seed for reproducible results
      *
-     * 0 = use system time for random seed
+     * Seeds the genetic algorithm (island i uses randomSeed + i). Runs
+     * with more than one thread can still differ, since placements finish
+     * in varying order. 0 = use system time for random seed
      */
     unsigned int randomSeed;
 
@@ -278,6 +775,16 @@ public:
      * @brief Set threads count with validation (must be > 0)
      */
     void setThreads(int value);
+
+    /**
+     * @brief Get NFP cache memory budget in megabytes
+     */
+    int getNfpCacheMaxMemoryMB() const { return nfpCacheMaxMemoryMB; }
+
+    /**
+     * @brief Set NFP cache memory budget with validation (must be >= 0)
+     */
+    void setNfpCacheMaxMemoryMB(int value);
 };
 
 } // namespace deepnest
@@ -0,0 +1,124 @@
+#ifndef DEEPNEST_JSON_WRITER_H
+#define DEEPNEST_JSON_WRITER_H
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Minimal indented JSON writer for configuration and profile files
+ *
+ * Writes objects of numbers, booleans and strings, nested as needed, in
+ * the layout QJsonDocument::Indented produced before the core dropped Qt.
+ * Files are read back with Boost.PropertyTree's read_json.
+ */
+class JsonWriter {
+public:
+    JsonWriter() : text_("{"), empty_{true} {}
+
+    void value(const std::string& name, double v) {
+        key(name);
+        if (!std::isfinite(v)) {
+            text_ += "null";
+            return;
+        }
+        char digits[32];
+        const auto written = std::to_chars(digits, digits + sizeof(digits), v);
+        text_.append(digits, written.ptr);
+    }
+
+    void value(const std::string& name, int v) {
+        key(name);
+        text_ += std::to_string(v);
+    }
+
+    void value(const std::string& name, bool v) {
+        key(name);
+        text_ += v ? "true" : "false";
+    }
+
+    void value(const std::string& name, const std::string& v) {
+        key(name);
+        quote(v);
+    }
+
+    void value(const std::string& name, const char* v) {
+        value(name, std::string(v));
+    }
+
+    void beginObject(const std::string& name) {
+        key(name);
+        text_ += "{";
+        empty_.push_back(true);
+    }
+
+    void endObject() {
+        close();
+    }
+
+    /**
+     * @brief The document, with every open object closed
+     */
+    std::string str() {
+        while (!empty_.empty()) {
+            close();
+        }
+        text_ += "\n";
+        return text_;
+    }
+
+private:
+    void key(const std::string& name) {
+        if (!empty_.back()) {
+            text_ += ",";
+        }
+        empty_.back() = false;
+        text_ += "\n";
+        text_.append(4 * empty_.size(), ' ');
+        quote(name);
+        text_ += ": ";
+    }
+
+    void close() {
+        const bool wasEmpty = empty_.back();
+        empty_.pop_back();
+        if (!wasEmpty) {
+            text_ += "\n";
+            text_.append(4 * empty_.size(), ' ');
+        }
+        text_ += "}";
+    }
+
+    void quote(const std::string& s) {
+        text_ += '"';
+        for (char c : s) {
+            switch (c) {
+                case '"': text_ += "\\\""; break;
+                case '\\': text_ += "\\\\"; break;
+                case '\n': text_ += "\\n"; break;
+                case '\r': text_ += "\\r"; break;
+                case '\t': text_ += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        text_ += escaped;
+                    } else {
+                        text_ += c;
+                    }
+            }
+        }
+        text_ += '"';
+    }
+
+    std::string text_;
+    std::vector<bool> empty_;  // Per open object: nothing written in it yet
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_JSON_WRITER_H
@@ -0,0 +1,84 @@
+#ifndef DEEPNEST_DXF_IMPORTER_H
+#define DEEPNEST_DXF_IMPORTER_H
+
+#include "../core/Polygon.h"
+#include "../geometry/PolygonHierarchy.h"
+#include <QString>
+#include <vector>
+
+class QIODevice;
+
+namespace deepnest {
+
+/**
+ * @brief Native ASCII DXF importer producing nestable polygons
+ *
+ * Reads the ENTITIES section as group code / value pairs, line by line,
+ * and buffers LINE, ARC, CIRCLE, LWPOLYLINE, POLYLINE (with its VERTEX
+ * list) and SPLINE entities a batch at a time. Each batch is flattened
+ * over parallelFor, one entity per task: polyline bulges, arcs and
+ * circles through GeometryUtil::Arc::linearize, splines by evaluating
+ * the NURBS and subdividing each knot span until it lies within the
+ * curve tolerance.
+ *
+ * Vertices taken from the file (line ends, polyline vertices, arc ends)
+ * are marked exact and interpolated points are not, so MergeDetection
+ * only credits shared edges that exist in the drawing. Open pieces are
+ * chained end to end when their ends lie within endpointTolerance, and
+ * every closed contour is nested with PolygonHierarchy::buildTree.
+ *
+ * Entities inside BLOCKS, and INSERT references to them, are not
+ * expanded; nor is binary DXF read.
+ */
+class DxfImporter {
+public:
+    using ParallelFor = PolygonHierarchy::ParallelFor;
+
+    struct Config {
+        double curveTolerance;     // Greatest distance of a flattened curve from the true one
+        double endpointTolerance;  // Open pieces whose ends lie this close are joined
+        double scale;              // Output units per drawing unit
+        size_t batchSize;          // Entities buffered before a batch is flattened
+
+        Config() : curveTolerance(0.3), endpointTolerance(0.01), scale(1.0), batchSize(1024) {}
+    };
+
+    struct Result {
+        /**
+         * @brief Top-level outlines in drawing order, holes as children
+         */
+        std::vector<Polygon> parts;
+
+        /**
+         * @brief Open pieces that could not be chained into a contour
+         */
+        size_t openPieces = 0;
+
+        /**
+         * @brief Empty on success
+         */
+        QString errorMessage;
+
+        bool success() const { return errorMessage.isEmpty(); }
+    };
+
+    explicit DxfImporter(const Config& config = Config(), ParallelFor parallelFor = nullptr);
+
+    /**
+     * @brief Import a DXF file
+     */
+    Result importFile(const QString& fileName) const;
+
+    /**
+     * @brief Import a DXF drawing from an open device
+     */
+    Result importDevice(QIODevice* device) const;
+
+private:
+    Config config_;
+    ParallelFor parallelFor_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_DXF_IMPORTER_H
@@ -0,0 +1,154 @@
+#ifndef DEEPNEST_JOB_FILE_H
+#define DEEPNEST_JOB_FILE_H
+
+#include "../core/Polygon.h"
+#include "../nfp/PersistentNFPStore.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Versioned binary container for a whole nesting job
+ *
+ * Holds the configuration (as DeepNestConfig JSON), every part and sheet
+ * with its quantity, name and holes, and optionally precomputed NFPs and
+ * spacing offsets under their PersistentNFPStore keys. open() maps the
+ * file read-only and checks its tables once; coordinates are then read
+ * in place, so ring() hands out pointers straight into the mapping and
+ * nothing is parsed per point.
+ *
+ * File layout (native byte order, every section 8-byte aligned):
+ *   FileHeader, SectionEntry[sectionCount], sections...
+ *   CONFIG  JSON bytes
+ *   POINTS  double x, y per point
+ *   EXACT   uint8 per point, 1 where the point is exact (MergeDetection)
+ *   RINGS   RingRecord per ring: first point, count, parent ring
+ *   ITEMS   ItemRecord per part or sheet: its rings, quantity, name
+ *   NAMES   UTF-8 names
+ *   NFPS    NfpRecord per stored NFP or offset: store key and its rings
+ *
+ * The rings of a polygon list are stored in preorder; each names its
+ * parent by index within the list (-1 for an outline), which keeps the
+ * hole hierarchy without nesting records.
+ */
+class JobFile {
+public:
+    /**
+     * @brief A part or sheet to write
+     */
+    struct Item {
+        Polygon polygon;
+        int quantity;
+        std::string name;
+        bool sheet;
+
+        Item(const Polygon& poly, int qty, const std::string& itemName, bool isSheet)
+            : polygon(poly), quantity(qty), name(itemName), sheet(isSheet) {}
+    };
+
+    /**
+     * @brief A precomputed NFP or spacing offset to write
+     */
+    struct StoredNfp {
+        PersistentNFPStore::Key key;
+        std::vector<Polygon> polygons;
+    };
+
+    /**
+     * @brief One ring's coordinates, in place in the mapping
+     */
+    struct Ring {
+        const double* xy;       // x0, y0, x1, y1, ...
+        const uint8_t* exact;   // One flag per point
+        uint32_t size;
+        int32_t parent;         // Ring index within the list, -1 for an outline
+
+        Point point(uint32_t i) const { return Point(xy[2 * i], xy[2 * i + 1], exact[i] != 0); }
+    };
+
+    JobFile();
+    ~JobFile();
+
+    JobFile(const JobFile&) = delete;
+    JobFile& operator=(const JobFile&) = delete;
+
+    /**
+     * @brief Write a job file
+     *
+     * @param config DeepNestConfig JSON (DeepNestConfig::toJsonData)
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void write(const std::string& path, const std::string& config,
+                      const std::vector<Item>& items,
+                      const std::vector<StoredNfp>& nfps = {});
+
+    /**
+     * @brief Map a job file and check its tables
+     *
+     * @return False if the file cannot be mapped or is not a valid job;
+     *         error() then says why
+     */
+    bool open(const std::string& path);
+
+    bool isOpen() const { return region_ != nullptr; }
+    const std::string& error() const { return error_; }
+
+    /**
+     * @brief The configuration JSON
+     */
+    std::string config() const;
+
+    size_t itemCount() const { return itemCount_; }
+    bool isSheet(size_t item) const;
+    int quantity(size_t item) const;
+    std::string name(size_t item) const;
+
+    /**
+     * @brief Rings of an item: its outline first, then holes in preorder
+     */
+    size_t ringCount(size_t item) const;
+    Ring ring(size_t item, size_t index) const;
+
+    /**
+     * @brief The item as a Polygon with its holes as children
+     */
+    Polygon polygon(size_t item) const;
+
+    size_t nfpCount() const { return nfpCount_; }
+    PersistentNFPStore::Key nfpKey(size_t nfp) const;
+
+    /**
+     * @brief A stored NFP or offset decoded to polygons
+     */
+    std::vector<Polygon> nfp(size_t nfp) const;
+
+private:
+    Ring ringAt(uint64_t index) const;
+    std::vector<Polygon> polygons(uint64_t firstRing, uint32_t ringCount) const;
+    bool fail(const std::string& message);
+
+    std::unique_ptr<boost::interprocess::file_mapping> mapping_;
+    std::unique_ptr<boost::interprocess::mapped_region> region_;
+    std::string error_;
+
+    // Section starts within the mapping, checked by open()
+    const char* config_ = nullptr;
+    uint64_t configBytes_ = 0;
+    const double* points_ = nullptr;
+    const uint8_t* exact_ = nullptr;
+    const char* rings_ = nullptr;
+    const char* items_ = nullptr;
+    const char* names_ = nullptr;
+    const char* nfps_ = nullptr;
+    size_t itemCount_ = 0;
+    size_t nfpCount_ = 0;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_JOB_FILE_H
@@ -0,0 +1,12 @@
+#ifndef DEEPNEST_QT_META_TYPES_H
+#define DEEPNEST_QT_META_TYPES_H
+
+#include "../engine/NestingEngine.h"
+#include <QMetaType>
+
+// Declare metatypes for Qt signal/slot system (part of the Qt adapter, so
+// that the engine headers stay free of Qt)
+Q_DECLARE_METATYPE(deepnest::NestResult)
+Q_DECLARE_METATYPE(deepnest::NestProgress)
+
+#endif // DEEPNEST_QT_META_TYPES_H
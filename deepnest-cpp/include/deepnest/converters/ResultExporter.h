@@ -0,0 +1,151 @@
+#ifndef DEEPNEST_RESULT_EXPORTER_H
+#define DEEPNEST_RESULT_EXPORTER_H
+
+#include "../core/Polygon.h"
+#include "../engine/NestingEngine.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Streams nesting results as SVG or DXF, without Qt
+ *
+ * Works sheet by sheet: the placed outlines and holes of one sheet are
+ * turned and moved in a single Transformation::applyBatch pass and
+ * written as text into a buffer that is handed to the sink whenever it
+ * fills, so memory stays at one sheet's geometry however large the
+ * result. Sheets are laid out left to right, sheetGap apart, as the
+ * TestApplication result view draws them.
+ *
+ * With mergeLines, an edge run that lies on one already written for an
+ * earlier part of the same sheet (within mergeTolerance, between exact
+ * vertices as MergeDetection counts them) is left out, so a common line
+ * is cut once. Parts are then written as open paths.
+ *
+ * submit() only copies the placements and wakes a writer thread, so it
+ * can be called from a ResultCallback without holding up the engine.
+ * A result arriving while another is still being written replaces any
+ * result not yet started; only the latest is worth writing.
+ */
+class ResultExporter {
+public:
+    enum class Format {
+        SVG,
+        DXF
+    };
+
+    /**
+     * @brief Receives the output text in order
+     *
+     * @return False to abandon the result being written
+     */
+    using Sink = std::function<bool(const char* data, size_t size)>;
+
+    /**
+     * @brief Opens a sink for a submitted result, on the writer thread
+     *
+     * Returning nullptr skips the result.
+     */
+    using SinkProvider = std::function<Sink(const NestResult& result)>;
+
+    struct Config {
+        Format format;
+        bool mergeLines;           // Leave out common lines already written
+        double mergeTolerance;     // Distance within which edges count as common
+        double minMergeLength;     // Shorter edges are never merged
+        double sheetGap;           // Space between sheets laid out in a row
+        size_t bufferBytes;        // Text buffered before it is passed to the sink
+
+        Config()
+            : format(Format::SVG), mergeLines(false), mergeTolerance(0.3),
+              minMergeLength(0.1), sheetGap(50.0), bufferBytes(64 * 1024) {}
+    };
+
+    /**
+     * @param parts Part outlines with holes as children, indexed by the
+     *              placement source (the polygons given to
+     *              NestingEngine::initialize)
+     * @param sheets Sheet outlines, as given to NestingEngine::initialize
+     * @param sheetQuantities Copies of each sheet; result sheets follow
+     *                        them in order, or NestResult::sheets
+     */
+    ResultExporter(const std::vector<Polygon>& parts,
+                   const std::vector<Polygon>& sheets,
+                   const std::vector<int>& sheetQuantities,
+                   const Config& config = Config());
+
+    /**
+     * @brief Finishes any result being written and stops the writer thread
+     */
+    ~ResultExporter();
+
+    ResultExporter(const ResultExporter&) = delete;
+    ResultExporter& operator=(const ResultExporter&) = delete;
+
+    /**
+     * @brief Write a result to a sink on the calling thread
+     *
+     * @return False if the sink refused the output
+     */
+    bool write(const NestResult& result, const Sink& sink) const;
+
+    /**
+     * @brief Queue a result for the writer thread
+     *
+     * Starts the thread on first use. Safe to call from any thread,
+     * including the engine's ResultCallback.
+     *
+     * @param provider Opens the sink for this result
+     */
+    void submit(const NestResult& result, SinkProvider provider);
+
+    /**
+     * @brief Wait until every submitted result has been written
+     */
+    void flush();
+
+    /**
+     * @brief Sink writing a file, created or truncated here
+     *
+     * Each piece is flushed as it arrives, so the file can be followed
+     * while it is written.
+     *
+     * @return nullptr if the file cannot be opened
+     */
+    static Sink fileSink(const std::string& path);
+
+private:
+    struct SheetLayout {
+        const Polygon* sheet;
+        double offsetX;  // Added to x to put the sheet in its place in the row
+    };
+
+    class Writer;
+
+    void run();
+    std::vector<SheetLayout> layout(const NestResult& result) const;
+
+    std::vector<Polygon> parts_;
+    std::vector<Polygon> sheets_;   // One per sheet copy, in engine order
+    Config config_;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    NestResult pending_;
+    SinkProvider pendingProvider_;
+    bool hasPending_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_RESULT_EXPORTER_H
@@ -0,0 +1,100 @@
+#ifndef DEEPNEST_SVG_IMPORTER_H
+#define DEEPNEST_SVG_IMPORTER_H
+
+#include "../core/Polygon.h"
+#include "../geometry/PolygonHierarchy.h"
+#include <QString>
+#include <string>
+#include <vector>
+
+class QIODevice;
+
+namespace deepnest {
+
+/**
+ * @brief Streaming SVG importer producing nestable polygons
+ *
+ * The document is read with QXmlStreamReader, one element at a time, and
+ * never held as a DOM. Shape elements (path, rect, circle, ellipse,
+ * polygon, polyline, line) are buffered with their accumulated transform,
+ * a batch at a time; each batch is then flattened, one element per task,
+ * over parallelFor. Curves are linearized with GeometryUtil's
+ * QuadraticBezier, CubicBezier and Arc directly into points, so memory
+ * stays proportional to the batch plus the polygons produced.
+ *
+ * Every closed contour becomes a polygon and PolygonHierarchy::buildTree
+ * then nests the whole document, as svgnest.js does, so a hole drawn as
+ * a separate element still ends up a child of its part. Elements whose id
+ * or class names a sheet (container, sheet, bin, stock, board, panel) are
+ * kept apart as containers.
+ *
+ * Corresponds to JavaScript svgparser.js (polygonify and splitPath)
+ */
+class SvgImporter {
+public:
+    using ParallelFor = PolygonHierarchy::ParallelFor;
+
+    struct Config {
+        /**
+         * @brief Greatest distance of a flattened curve from the true one,
+         *        in output units
+         */
+        double tolerance;
+
+        /**
+         * @brief Output units per inch, for documents with physical sizes
+         */
+        double scale;
+
+        /**
+         * @brief An open contour whose ends lie this close is closed
+         */
+        double endpointTolerance;
+
+        /**
+         * @brief Elements buffered before a batch is flattened
+         */
+        size_t batchSize;
+
+        Config() : tolerance(2.0), scale(72.0), endpointTolerance(2.0), batchSize(1024) {}
+    };
+
+    struct Result {
+        /**
+         * @brief Top-level outlines in document order, holes as children
+         */
+        std::vector<Polygon> parts;
+
+        /**
+         * @brief Outlines of elements marked as sheets
+         */
+        std::vector<Polygon> containers;
+
+        /**
+         * @brief Empty on success
+         */
+        QString errorMessage;
+
+        bool success() const { return errorMessage.isEmpty(); }
+    };
+
+    explicit SvgImporter(const Config& config = Config(), ParallelFor parallelFor = nullptr);
+
+    /**
+     * @brief Import an SVG file
+     */
+    Result importFile(const QString& fileName) const;
+
+    /**
+     * @brief Import an SVG document from an open device
+     */
+    Result importDevice(QIODevice* device) const;
+
+private:
+    Config config_;
+    ParallelFor parallelFor_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_SVG_IMPORTER_H
@@ -47,10 +47,10 @@ struct BoundingBox {
         double maxY = std::numeric_limits<double>::lowest();
 
         for (const auto& p : points) {
-            minX = std::min(minX, p.x);
-            minY = std::min(minY, p.y);
-            maxX = std::max(maxX, p.x);
-            maxY = std::max(maxY, p.y);
+            minX = std::min<double>(minX, p.x);
+            minY = std::min<double>(minY, p.y);
+            maxX = std::max<double>(maxX, p.x);
+            maxY = std::max<double>(maxY, p.y);
         }
 
         return BoundingBox(minX, minY, maxX - minX, maxY - minY);
@@ -0,0 +1,52 @@
+#ifndef DEEPNEST_COORD_H
+#define DEEPNEST_COORD_H
+
+namespace deepnest {
+
+#ifdef DEEPNEST_SINGLE_PRECISION
+
+/**
+ * @brief Point coordinate stored in single precision
+ *
+ * Built with DEEPNEST_SINGLE_PRECISION (CMake option of the same name,
+ * qmake CONFIG+=single_precision), Point keeps its coordinates as float:
+ * 12 bytes per point instead of 24, for parts, sheets and the NFPs the
+ * cache holds. Cache-heavy nests that are bound by memory bandwidth
+ * stream half the bytes.
+ *
+ * A Coord reads as double, so every expression over coordinates,
+ * including the tolerance checks in GeometryUtil, is still evaluated in
+ * double; only storing rounds to float. Parts and NFPs are kept relative
+ * to their own origin, so millimetre-scale geometry keeps about 1e-4 mm
+ * near a 1000 mm extent. That is coarser than the default clipperScale
+ * grid of 1e-7: use a clipperScale of 1e4 or less with this build, or
+ * integerGeometry to snap to that grid.
+ */
+class Coord {
+public:
+    Coord() : value_(0.0f) {}
+    Coord(double value) : value_(static_cast<float>(value)) {}
+
+    operator double() const { return value_; }
+
+    Coord& operator+=(double value) { return *this = *this + value; }
+    Coord& operator-=(double value) { return *this = *this - value; }
+    Coord& operator*=(double value) { return *this = *this * value; }
+    Coord& operator/=(double value) { return *this = *this / value; }
+
+private:
+    float value_;
+};
+
+#else
+
+/**
+ * @brief Point coordinate (double unless built with DEEPNEST_SINGLE_PRECISION)
+ */
+using Coord = double;
+
+#endif
+
+} // namespace deepnest
+
+#endif // DEEPNEST_COORD_H
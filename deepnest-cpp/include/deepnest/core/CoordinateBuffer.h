@@ -0,0 +1,142 @@
+#ifndef DEEPNEST_COORDINATE_BUFFER_H
+#define DEEPNEST_COORDINATE_BUFFER_H
+
+#include "Point.h"
+#include "BoundingBox.h"
+#include <clipper2/clipper.core.h>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Structure-of-arrays copy of a point list
+ *
+ * Point keeps its exact and marked flags next to the coordinates and pads
+ * to 24 bytes, so a loop over std::vector<Point> streams a third more
+ * memory than it reads and does not vectorize cleanly. This buffer keeps
+ * x and y in two contiguous arrays and the flags, which only merge
+ * detection and orbital tracing use, in bitsets. It converts to and from
+ * std::vector<Point>, the representation the rest of the code works on.
+ * The loops run on the vectorized CoordinateKernels.
+ *
+ * Polygons share their buffer read-only across threads, so area, bounds,
+ * rectangularity and convexity are computed on first request and kept:
+ * a part, sheet or cached NFP pays for each once per run. The first thread
+ * to finish a value publishes it; the others use their own result.
+ * translate() and rotate() drop the cached values.
+ */
+class CoordinateBuffer {
+public:
+    CoordinateBuffer() = default;
+
+    explicit CoordinateBuffer(const std::vector<Point>& points);
+
+    /**
+     * @brief Copy the coordinates and the values computed so far
+     */
+    CoordinateBuffer(const CoordinateBuffer& other);
+    CoordinateBuffer& operator=(const CoordinateBuffer& other);
+
+    /**
+     * @brief Points with their flags
+     */
+    std::vector<Point> toPoints() const;
+
+    size_t size() const { return x_.size(); }
+    bool empty() const { return x_.empty(); }
+
+    const double* x() const { return x_.data(); }
+    const double* y() const { return y_.data(); }
+
+    bool exact(size_t index) const { return exact_[index]; }
+    bool marked(size_t index) const { return marked_[index]; }
+
+    /**
+     * @brief Signed area, with the sign of GeometryUtil::polygonArea()
+     */
+    double area() const;
+
+    /**
+     * @brief Axis-aligned bounds, as GeometryUtil::getPolygonBounds()
+     */
+    BoundingBox bounds() const;
+
+    /**
+     * @brief GeometryUtil::isRectangle() at the default tolerance
+     */
+    bool isRectangle() const;
+
+    /**
+     * @brief GeometryUtil::isConvex() at the default tolerance
+     */
+    bool isConvex() const;
+
+    /**
+     * @brief GeometryUtil::pointInPolygon() against this outline
+     */
+    std::optional<bool> pointInPolygon(const Point& point, double tolerance = TOL) const;
+
+    /**
+     * @brief Move every point, as Polygon::translate()
+     *
+     * Like Transformation, resets the flags to exact and unmarked.
+     */
+    void translate(double dx, double dy);
+
+    /**
+     * @brief Turn every point about the origin, as Polygon::rotate()
+     *
+     * Like Transformation, resets the flags to exact and unmarked.
+     */
+    void rotate(double angleDegrees);
+
+    /**
+     * @brief rotate() with the cosine and sine of the angle given
+     */
+    void rotate(double cosA, double sinA);
+
+    /**
+     * @brief Integer path for Clipper at the given scale
+     */
+    Clipper2Lib::Path64 toPath64(double scale) const;
+
+private:
+    // Bits of claimed_ and ready_
+    enum Property : unsigned {
+        AREA = 1u << 0,
+        BOUNDS = 1u << 1,
+        RECTANGLE = 1u << 2,
+        CONVEX = 1u << 3
+    };
+
+    /**
+     * @brief Cached value of property, computing it on first request
+     */
+    template <typename T, typename Compute>
+    T cached(Property property, T& slot, Compute compute) const;
+
+    /**
+     * @brief Forget every cached value
+     */
+    void invalidate();
+
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<bool> exact_;
+    std::vector<bool> marked_;
+
+    // A property's slot is written once, by the thread that claims it, and
+    // read only after its ready bit is set
+    mutable std::atomic<unsigned> claimed_{0};
+    mutable std::atomic<unsigned> ready_{0};
+    mutable double area_ = 0.0;
+    mutable BoundingBox bounds_;
+    mutable bool rectangle_ = false;
+    mutable bool convex_ = false;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_COORDINATE_BUFFER_H
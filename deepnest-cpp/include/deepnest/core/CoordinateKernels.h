@@ -0,0 +1,79 @@
+#ifndef DEEPNEST_COORDINATE_KERNELS_H
+#define DEEPNEST_COORDINATE_KERNELS_H
+
+#include "Types.h"
+#include <cstddef>
+#include <optional>
+
+namespace deepnest {
+
+/**
+ * @brief Vectorized loops over structure-of-arrays coordinates
+ *
+ * The kernels behind CoordinateBuffer. Each one has a scalar version and,
+ * where the target has them, SSE2 and AVX2 (x86-64) or NEON (AArch64)
+ * versions; the widest one the CPU supports is picked on first use.
+ *
+ * bounds(), translate(), rotate() and pointInPolygon() give the same bits
+ * as the scalar versions: the arithmetic is done in the same order and
+ * never fused (a compiler that contracts the scalar multiply-adds, as GCC
+ * does on AArch64, can make rotate() differ in the last bit there).
+ * area() sums in a different order and agrees within rounding (relative
+ * error around 1e-15).
+ */
+namespace CoordinateKernels {
+
+    /**
+     * @brief Signed area, with the sign of GeometryUtil::polygonArea()
+     */
+    double area(const double* x, const double* y, size_t n);
+
+    /**
+     * @brief Extremes of the coordinates; n must be at least 1
+     */
+    void bounds(const double* x, const double* y, size_t n,
+                double& minX, double& minY, double& maxX, double& maxY);
+
+    /**
+     * @brief x += dx, y += dy
+     */
+    void translate(double* x, double* y, size_t n, double dx, double dy);
+
+    /**
+     * @brief x' = cos * x - sin * y, y' = sin * x + cos * y
+     */
+    void rotate(double* x, double* y, size_t n, double cosA, double sinA);
+
+    /**
+     * @brief GeometryUtil::pointInPolygon() over the outline (x, y)
+     *
+     * The vector pass counts ray crossings and only falls back to the
+     * scalar loop when the point lies within tolerance of an edge's
+     * bounds, where the vertex and on-segment checks may fire.
+     */
+    std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                       double px, double py, double tolerance = TOL);
+
+    /**
+     * @brief Instruction set of the dispatched kernels ("avx2", "sse2", "neon" or "scalar")
+     */
+    const char* instructionSet();
+
+    /**
+     * @brief Reference versions, for validation and benchmarks
+     */
+    namespace Scalar {
+        double area(const double* x, const double* y, size_t n);
+        void bounds(const double* x, const double* y, size_t n,
+                    double& minX, double& minY, double& maxX, double& maxY);
+        void translate(double* x, double* y, size_t n, double dx, double dy);
+        void rotate(double* x, double* y, size_t n, double cosA, double sinA);
+        std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                           double px, double py, double tolerance = TOL);
+    }
+
+} // namespace CoordinateKernels
+
+} // namespace deepnest
+
+#endif // DEEPNEST_COORDINATE_KERNELS_H
@@ -0,0 +1,141 @@
+#ifndef DEEPNEST_MULTI_RING_H
+#define DEEPNEST_MULTI_RING_H
+
+#include "Point.h"
+#include "BoundingBox.h"
+#include <clipper2/clipper.core.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepnest {
+
+class Polygon;
+
+/**
+ * @brief Outer boundary and holes of a polygon in one vertex buffer
+ *
+ * A flattened, read-only view of a Polygon and its children, for code that
+ * walks every ring, such as the Minkowski NFP. The vertices of every ring
+ * sit in one contiguous array; the ring offsets, kinds and nesting (the
+ * layout) and the part's metadata are shared by copies and by negated().
+ * Polygon itself still holds its holes in children, so copying a Polygon
+ * copies every hole, whether or not rings is set.
+ *
+ * Rings are stored depth-first as in the Polygon tree: ring 0 is the outer
+ * boundary and each hole is followed by the islands inside it. Converts to
+ * and from Polygon, the representation the rest of the code works on.
+ */
+class MultiRing {
+public:
+    /**
+     * @brief Role of a ring: even depths bound material, odd depths holes
+     */
+    enum class Kind : uint8_t {
+        Outer,
+        Hole
+    };
+
+    /**
+     * @brief Per-part fields of Polygon, stored once
+     */
+    struct Metadata {
+        int id = -1;
+        int source = -1;
+        int quantity = 1;
+        bool isSheet = false;
+        bool convex = false;
+        uint64_t fingerprint = 0;
+        std::string name;
+    };
+
+    MultiRing() = default;
+
+    /**
+     * @brief Flatten a polygon and its holes, recursively
+     */
+    explicit MultiRing(const Polygon& polygon);
+
+    /**
+     * @brief Polygon tree with the same rings, metadata on the root
+     *
+     * Holes carry only their points, as the importers create them.
+     */
+    Polygon toPolygon() const;
+
+    size_t ringCount() const { return layout_ ? layout_->kinds.size() : 0; }
+    bool empty() const { return vertices_.empty(); }
+
+    Kind kind(size_t ring) const { return layout_->kinds[ring]; }
+
+    /**
+     * @brief Index of the ring enclosing ring, or -1 for ring 0
+     */
+    int parent(size_t ring) const { return layout_->parents[ring]; }
+
+    size_t ringSize(size_t ring) const { return layout_->offsets[ring + 1] - layout_->offsets[ring]; }
+    const Point* ringBegin(size_t ring) const { return vertices_.data() + layout_->offsets[ring]; }
+    const Point* ringEnd(size_t ring) const { return vertices_.data() + layout_->offsets[ring + 1]; }
+
+    /**
+     * @brief Vertices of every ring, ring after ring
+     */
+    const std::vector<Point>& vertices() const { return vertices_; }
+
+    const Metadata& metadata() const { return *metadata_; }
+
+    /**
+     * @brief Rotation of this variant in degrees, as Polygon::rotation
+     */
+    double rotation() const { return rotation_; }
+
+    /**
+     * @brief Reflected through the origin, each ring reversed to keep its winding
+     *
+     * The second operand of a Minkowski difference.
+     */
+    MultiRing negated() const;
+
+    /**
+     * @brief Bounds of every vertex, which the outer boundary encloses
+     */
+    BoundingBox bounds() const;
+
+    /**
+     * @brief Integer paths for Clipper at the given scale, one per ring
+     */
+    Clipper2Lib::Paths64 toPaths64(double scale) const;
+
+    /**
+     * @brief Estimated bytes held, the shared layout and metadata included
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief Whether the rings have the sizes and end points of a polygon's
+     *
+     * Checks each ring as Polygon::currentCoordinates() checks the outer
+     * boundary, which catches replaced, moved, turned and reversed rings.
+     */
+    bool matches(const Polygon& polygon) const;
+
+private:
+    struct Layout {
+        std::vector<uint32_t> offsets;   // Ring i spans [offsets[i], offsets[i + 1])
+        std::vector<Kind> kinds;
+        std::vector<int32_t> parents;
+    };
+
+    // Copy with the layout and metadata shared and the vertices left to fill
+    MultiRing shell() const;
+
+    std::vector<Point> vertices_;
+    std::shared_ptr<const Layout> layout_;
+    std::shared_ptr<const Metadata> metadata_;
+    double rotation_ = 0.0;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_MULTI_RING_H
@@ -1,21 +1,24 @@
 #ifndef DEEPNEST_POINT_H
 #define DEEPNEST_POINT_H
 
+#include "Coord.h"
 #include "Types.h"
-#include <QPointF>
 #include <cmath>
 
+class QPointF;
+
 namespace deepnest {
 
 /**
  * @brief Point structure representing a 2D point
  *
  * This structure represents a point in 2D space and provides conversions
- * between different representations (Boost, Qt).
+ * between different representations (Boost, Qt). Coordinates are double
+ * unless built with DEEPNEST_SINGLE_PRECISION (see Coord).
  */
 struct Point {
-    double x;
-    double y;
+    Coord x;
+    Coord y;
     bool exact;   // Used for merge detection - marks if this point is an exact match
     bool marked;  // Used for orbital tracing - tracks visited vertices
 
@@ -36,10 +39,10 @@ struct Point {
     // Conversion from Boost point
     static Point fromBoost(const BoostPoint& p, bool exact = false);
 
-    // Conversion from Qt point
+    // Conversion from Qt point (defined in the Qt adapter, deepnest-qt)
     static Point fromQt(const QPointF& p, bool exact = false);
 
-    // Conversion to Qt point
+    // Conversion to Qt point (deepnest-qt)
     QPointF toQt() const;
 
     // Vector operations
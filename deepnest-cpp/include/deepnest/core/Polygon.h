@@ -4,10 +4,15 @@
 #include "Types.h"
 #include "Point.h"
 #include "BoundingBox.h"
-#include <QPainterPath>
+#include "CoordinateBuffer.h"
+#include "MultiRing.h"
+#include <clipper2/clipper.core.h>
 #include <vector>
+#include <cstdint>
 #include <memory>
 
+class QPainterPath;
+
 namespace deepnest {
 
 // Forward declarations
@@ -68,6 +73,76 @@ public:
      */
     std::string name;
 
+    /**
+     * @brief Content hash of the polygon geometry (0 = not computed)
+     *
+     * Set once by updateFingerprint() after spacing and simplification.
+     * Geometrically identical parts (quantity copies, duplicates imported
+     * under different names) share a fingerprint, so NFP caching can key on
+     * shape instead of id. Carried over by transforms, since the rotation
+     * is keyed separately.
+     */
+    uint64_t fingerprint;
+
+    /**
+     * @brief Whether the outer boundary is convex (false = not convex or not computed)
+     *
+     * Set once by updateConvexity(); lets NFP calculation take the linear
+     * convex Minkowski path. Carried over by transforms, since rotation,
+     * translation and mirroring preserve convexity.
+     */
+    bool convex;
+
+    /**
+     * @brief Outer boundary in Clipper integer coordinates
+     */
+    struct ScaledPath {
+        Clipper2Lib::Path64 path;
+        double scale;
+    };
+
+    /**
+     * @brief Outer boundary pre-scaled for Clipper (nullptr = not built)
+     *
+     * Built once by updateScaledPath() for cached NFPs and prepared parts so
+     * Clipper-based operations use it directly instead of rescaling the
+     * points on every call. Copies share it; transforms drop it.
+     */
+    std::shared_ptr<const ScaledPath> scaledPath;
+
+    /**
+     * @brief Outer boundary as a structure-of-arrays buffer (nullptr = not built)
+     *
+     * Built by updateCoordinates() for prepared parts, sheets and cached
+     * NFPs, whose area(), bounds() and isRectangle() are queried on every
+     * placement; those then run on contiguous x and y arrays, once per
+     * buffer. Copies share it; rotate() and translate() carry it along,
+     * other transforms drop it.
+     */
+    std::shared_ptr<const CoordinateBuffer> coordinates;
+
+    /**
+     * @brief Outer boundary and holes in one vertex buffer (nullptr = not built)
+     *
+     * Built by updateRings() for the sheets and turned parts of a
+     * PlacementJob that have holes. The Minkowski NFP reads both operands'
+     * rings from it instead of walking children. A cache beside children,
+     * not a replacement: copies share it but still copy children, and
+     * transforms build children and drop it.
+     */
+    std::shared_ptr<const MultiRing> rings;
+
+    /**
+     * @brief Low-resolution outline used for GA screening (nullptr = none)
+     *
+     * The coarse level of detail of a part. Set by NestingEngine::initialize()
+     * from conservativeOutline() unless coarse screening is disabled, and
+     * used until the GA island evaluating the part converges; the exact
+     * outline places the elite and every later generation. Copies share
+     * it; transforms drop it.
+     */
+    std::shared_ptr<const Polygon> coarse;
+
     // ========== Constructors ==========
 
     /**
@@ -99,6 +174,94 @@ public:
      */
     BoundingBox bounds() const;
 
+    /**
+     * @brief Compute the geometry fingerprint of the current points and holes
+     *
+     * Coordinates are quantized to 1e-6 before hashing. Never returns 0.
+     */
+    uint64_t computeFingerprint() const;
+
+    /**
+     * @brief Store computeFingerprint() in fingerprint, recursively for holes
+     */
+    void updateFingerprint();
+
+    /**
+     * @brief Whether the outer boundary is an axis-aligned rectangle
+     *
+     * GeometryUtil::isRectangle(points) at the default tolerance, computed
+     * once per coordinates buffer when there is one.
+     */
+    bool isRectangle() const;
+
+    /**
+     * @brief Store GeometryUtil::isConvex(points) in convex
+     */
+    void updateConvexity();
+
+    /**
+     * @brief Build scaledPath from points at the given scale
+     */
+    void updateScaledPath(double scale);
+
+    /**
+     * @brief Round every point, and the children's, to a multiple of 1/scale
+     *
+     * Builds scaledPath from the rounded integers, so it holds the exact
+     * grid coordinates rather than a truncated product. Drops coordinates
+     * and rings.
+     */
+    void snapToGrid(double scale);
+
+    /**
+     * @brief scaledPath if it was built at this scale and matches points
+     * @return Integer path, or nullptr if the caller must convert points
+     */
+    const Clipper2Lib::Path64* scaledPathAt(double scale) const;
+
+    /**
+     * @brief Build coordinates from points
+     */
+    void updateCoordinates();
+
+    /**
+     * @brief coordinates if they match points
+     *
+     * Checks the size and the end points, which catches replaced,
+     * translated, turned and reversed point lists.
+     *
+     * @return Buffer, or nullptr if the caller must read points
+     */
+    const CoordinateBuffer* currentCoordinates() const;
+
+    /**
+     * @brief Build rings from points and children
+     */
+    void updateRings();
+
+    /**
+     * @brief rings if they match points and children
+     *
+     * Checks every ring's size and end points, as currentCoordinates().
+     *
+     * @return Buffer, or nullptr if the caller must walk children
+     */
+    const MultiRing* currentRings() const;
+
+    /**
+     * @brief rings if current, otherwise the polygon flattened now
+     */
+    MultiRing flatten() const;
+
+    /**
+     * @brief Estimated bytes held by the polygon and its holes
+     *
+     * Counts the object, points, name, scaledPath, coordinates and rings,
+     * whether or not other copies share the last three; coarse is not
+     * counted.
+     */
+    size_t memoryBytes() const;
+
     /**
      * @brief Check if polygon is valid (at least 3 points)
      */
@@ -143,6 +306,15 @@ public:
      */
     Polygon rotate(double angleDegrees) const;
 
+    /**
+     * @brief Rotate polygon around origin by a precomputed turn
+     *
+     * Same result as rotate(angleDegrees) when cosA and sinA are the
+     * cosine and sine of angleDegrees, for callers that turn many polygons
+     * by the same few angles.
+     */
+    Polygon rotate(double angleDegrees, double cosA, double sinA) const;
+
     /**
      * @brief Rotate polygon around a center point
      *
@@ -206,6 +378,9 @@ public:
      */
     static Polygon fromBoostPolygon(const BoostPolygonWithHoles& boostPoly);
 
+    // QPainterPath conversions are defined in the Qt adapter (deepnest-qt);
+    // the headless core (deepnest-core) only declares them
+
     /**
      * @brief Convert to QPainterPath
      */
@@ -285,6 +460,20 @@ public:
      */
     Polygon simplify(double tolerance) const;
 
+    /**
+     * @brief Simplified outline that contains this polygon
+     *
+     * The outer boundary is simplified with the tolerance and grown by it,
+     * so every removed vertex stays inside; holes are filled. A placement
+     * that is overlap-free for the outline is overlap-free for the polygon.
+     *
+     * @param tolerance Simplification tolerance
+     * @param clipperScale Clipper scale of the nest's configuration
+     * @return Outline with the same id/source and its own fingerprint, or an
+     *         empty polygon if it has no fewer vertices than this one
+     */
+    Polygon conservativeOutline(double tolerance, double clipperScale) const;
+
     // ========== Operators ==========
 
     /**
@@ -0,0 +1,206 @@
+#ifndef DEEPNEST_NESTING_DAEMON_H
+#define DEEPNEST_NESTING_DAEMON_H
+
+#include "NestingEngine.h"
+#include "../nfp/NFPCache.h"
+#include "../parallel/ParallelProcessor.h"
+#include "../placement/ShapeCache.h"
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Long-running process that nests jobs submitted over a local socket
+ *
+ * Every job gets its own NestingEngine, but all engines share one worker
+ * pool, one NFPCache and one ShapeCache (spacing offsets and turned parts),
+ * so jobs over the same parts start with warm caches. Each engine runs on
+ * its own ParallelProcessor on the pool, which gives every running job an
+ * equal share of the threads and lets a job be cancelled without touching
+ * the others. One scheduler thread steps the engines in turn.
+ *
+ * Jobs are JobFile paths on the daemon's host. They run with the
+ * DeepNestConfig instance of the process; the configuration stored in a
+ * job file is ignored, since geometry code reads the shared instance and
+ * cache keys assume one set of geometry settings.
+ *
+ * The protocol is line based text on a TCP port bound to the loopback
+ * interface. Requests:
+ *   SUBMIT <maxGenerations> <job file path>   (0 = until the budget ends)
+ *   CANCEL <job>
+ *   STATS
+ * Replies and events, interleaved for all jobs of the connection:
+ *   ACCEPTED <job>
+ *   PROGRESS <job> <generation> <evaluations> <bestFitness> <percent>
+ *   RESULT <job> <fitness> <area> <mergedLength> <placementCount>
+ *   PLACE <job> <sheet> <source> <x> <y> <rotation>   (placementCount lines)
+ *   DONE <job> <bestFitness> <evaluations>
+ *   STATS <jobs> <nfpEntries> <shapeEntries> <shapeLookups> <shapeHits>
+ *   ERROR <message>
+ * Sheets are numbered in the job file's order with quantities expanded
+ * (NestResult::sheetIndex()); source is the index of the part among the
+ * job file's parts. A job whose client disconnects is cancelled.
+ *
+ * Events are queued per client and written by a thread of the client's
+ * own, so a client that reads slowly delays no job. While it is behind it
+ * misses PROGRESS events; one more than 16 MB behind is disconnected.
+ *
+ * With Config::metricsPort set, a second port answers HTTP GET /metrics
+ * with metrics() in the Prometheus text format, for scrapers and
+ * autoscalers; see metrics() for what it exposes.
+ */
+class NestingDaemon {
+public:
+    /**
+     * @brief Daemon settings
+     */
+    struct Config {
+        unsigned short port;      // Loopback TCP port to listen on
+        int threads;              // Pool threads (0 = hardware concurrency)
+        size_t shapeCacheEntries; // Offsets and turned parts kept at most
+        int stepIntervalMs;       // Pause between rounds over the jobs
+        unsigned short metricsPort;  // HTTP port of GET /metrics (0 = none)
+        std::string metricsAddress;  // Address the metrics port binds to
+
+        Config()
+            : port(47900)
+            , threads(0)
+            , shapeCacheEntries(65536)
+            , stepIntervalMs(10)
+            , metricsPort(0)
+            , metricsAddress("127.0.0.1") {}
+    };
+
+    /**
+     * @throws boost::system::system_error if a port cannot be bound
+     */
+    explicit NestingDaemon(const Config& config = Config());
+
+    /**
+     * @brief Stops the running jobs
+     */
+    ~NestingDaemon();
+
+    NestingDaemon(const NestingDaemon&) = delete;
+    NestingDaemon& operator=(const NestingDaemon&) = delete;
+
+    /**
+     * @brief Accept and serve clients until stop()
+     *
+     * Running jobs are stopped and every connection closed before it
+     * returns.
+     */
+    void run();
+
+    /**
+     * @brief Stop accepting; run() returns once the jobs are stopped
+     */
+    void stop();
+
+    /**
+     * @brief Daemon metrics in the Prometheus text exposition format
+     *
+     * Jobs active and submitted, evaluations (a counter; rate() gives
+     * evaluations per second), pool threads and busy threads, tasks queued
+     * or running, NFP and shape cache lookups, entries and bytes, and per
+     * job the generation, evaluations and best fitness. With
+     * DeepNestConfig::stageTiming on, also a latency histogram and CPU
+     * time per stage (see StageTimes.h). Safe to call from any thread.
+     */
+    std::string metrics() const;
+
+private:
+    struct Client;
+    struct Job;
+
+    /**
+     * @brief Read and answer one client's requests until it disconnects
+     */
+    void serve(const std::shared_ptr<Client>& client);
+
+    /**
+     * @brief Load, initialize and start a job, then hand it to schedule()
+     */
+    void submit(const std::shared_ptr<Client>& client, int maxGenerations, const std::string& path);
+
+    /**
+     * @brief Step the running jobs in turn until stop()
+     */
+    void schedule();
+
+    /**
+     * @brief Stop a job, report it to its client and drop it
+     */
+    void finish(const std::shared_ptr<Job>& job);
+
+    /**
+     * @brief Answer metrics requests until stop()
+     */
+    void serveMetrics();
+
+    /**
+     * @brief Close the metrics port and the connection being answered;
+     *        runs on metricsIo_
+     */
+    void closeMetrics();
+
+    Config config_;
+    const DeepNestConfig nestConfig_;
+
+    boost::asio::io_context io_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+
+    /**
+     * @brief Threads every job's processor runs on
+     */
+    std::shared_ptr<ParallelProcessor> pool_;
+
+    std::shared_ptr<NFPCache> nfpCache_;
+    std::shared_ptr<ShapeCache> shapeCache_;
+
+    /**
+     * @brief Metrics port, on its own io_context (nullptr = none)
+     */
+    boost::asio::io_context metricsIo_;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> metricsAcceptor_;
+
+    /**
+     * @brief Connection serveMetrics() is answering (nullptr = none);
+     *        only touched on the metrics thread
+     */
+    boost::asio::ip::tcp::socket* metricsSocket_;
+
+    /**
+     * @brief Guards jobs_, clients_, nextId_ and evaluationsFinished_
+     */
+    mutable boost::mutex mutex_;
+
+    /**
+     * @brief Signalled when a job is added or the daemon stops
+     */
+    boost::condition_variable wake_;
+
+    std::vector<std::shared_ptr<Job>> jobs_;
+    std::vector<std::shared_ptr<Client>> clients_;
+    int nextId_;
+
+    /**
+     * @brief Evaluations of jobs already dropped from jobs_
+     */
+    uint64_t evaluationsFinished_;
+
+    std::atomic<bool> stopped_;
+
+    boost::thread scheduler_;
+    boost::thread metricsServer_;
+    boost::thread_group sessions_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_NESTING_DAEMON_H
@@ -3,15 +3,26 @@
 
 #include "../algorithm/GeneticAlgorithm.h"
 #include "../algorithm/Population.h"
+#include "../algorithm/SurrogateFitness.h"
+#include "../placement/FitnessMemo.h"
+#include "../placement/PlacementJob.h"
 #include "../placement/PlacementWorker.h"
+#include "../placement/ShapeCache.h"
 #include "../parallel/ParallelProcessor.h"
+#include "../parallel/ThreadCountController.h"
 #include "../nfp/NFPCalculator.h"
 #include "../nfp/NFPCache.h"
 #include "../config/DeepNestConfig.h"
 #include "../core/Polygon.h"
+#include "../StageTimes.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <limits>
 
 namespace deepnest {
 
@@ -42,14 +53,56 @@ struct NestResult {
     double mergedLength;
 
     /**
-     * @brief Generation when this result was found
+     * @brief Generation when this result was found (of its island)
      */
     int generation;
 
     /**
-     * @brief Individual index in population
+     * @brief Individual index in population (islands counted in order)
      */
     int individualIndex;
+
+    /**
+     * @brief Sheet each entry of placements was laid out on, as an index
+     *        into the sheets with quantities expanded; empty when they
+     *        follow that order (see DeepNestConfig::sheetOrderSearch)
+     */
+    std::vector<size_t> sheets;
+
+    /**
+     * @brief Sheet of placements[i], as an index into the expanded sheets
+     */
+    size_t sheetIndex(size_t i) const { return i < sheets.size() ? sheets[i] : i; }
+};
+
+/**
+ * @brief Saved results, best first
+ *
+ * Published as immutable snapshots: a better result is published as a new
+ * history sharing the results it keeps, so a reader holding one needs no
+ * lock and copies nothing.
+ */
+using ResultHistory = std::vector<std::shared_ptr<const NestResult>>;
+
+/**
+ * @brief Estimated memory of a nest, by subsystem
+ *
+ * Sizes of the long-lived structures, summed from their contents when
+ * requested; Clipper temporaries and other per-evaluation scratch memory
+ * are not included. Shared structures (an NFP cache shared between
+ * engines, buffers shared by polygon copies) are counted in full.
+ */
+struct MemoryUsage {
+    size_t nfpCacheBytes = 0;       // NFPCache::residentBytes() of the cache in use
+    size_t nfpCacheLimitBytes = 0;  // Its budget, lowered by the ceiling (0 = unlimited)
+    size_t populationBytes = 0;     // Genomes, placements and finished evaluations of all islands
+    size_t resultBytes = 0;         // Saved results and the fitness memo
+    size_t geometryBytes = 0;       // Parts, sheets and the turned variants of the placement job
+    size_t limitBytes = 0;          // Ceiling (config.memoryLimitMB, 0 = none)
+
+    size_t totalBytes() const {
+        return nfpCacheBytes + populationBytes + resultBytes + geometryBytes;
+    }
 };
 
 /**
@@ -71,11 +124,48 @@ struct NestProgress {
      */
     double bestFitness;
 
+    /**
+     * @brief Individuals that got the result of an identical genome
+     *        instead of being placed (included in evaluationsCompleted)
+     */
+    int fitnessMemoHits;
+
     /**
      * @brief Percentage complete (0-100)
-     * Based on generation / max generations
+     * Based on generation / max generations or elapsed / timeout,
+     * whichever is further
      */
     double percentComplete;
+
+    /**
+     * @brief Estimated memory of the nest (NestingEngine::getMemoryUsage())
+     */
+    MemoryUsage memory;
+
+    /**
+     * @brief Time per stage since start(), summed over all threads
+     *
+     * Filled while config.stageTiming is on. The counters are process-wide,
+     * so engines running at the same time see each other's stages.
+     */
+    StageTimes stageTimes;
+
+    /**
+     * @brief Time per stage between the last two generation reports
+     */
+    StageTimes generationStageTimes;
+
+    /**
+     * @brief Threads running this nest's tasks, as config.adaptiveThreads
+     *        chose them (0 = not started)
+     */
+    int activeThreads = 0;
+
+    /**
+     * @brief Evaluations per second that count was chosen on
+     *        (0 = config.adaptiveThreads off or not measured yet)
+     */
+    double evaluationsPerSecond = 0.0;
 };
 
 /**
@@ -92,7 +182,8 @@ struct NestProgress {
  * 1. Initialize with parts and sheets
  * 2. Create initial GA population (adam sorted by area)
  * 3. For each generation:
- *    - Evaluate unevaluated individuals in parallel
+ *    - Evaluate unevaluated individuals in parallel (with coarse part
+ *      outlines during the screening generations)
  *    - Each evaluation uses PlacementWorker to place parts on sheets
  *    - Track best results
  *    - When generation complete, create next generation
@@ -121,9 +212,24 @@ public:
     /**
      * @brief Constructor
      *
-     * @param config Configuration for nesting
+     * @param config Configuration for nesting; the engine keeps a copy, so
+     *               later changes to it do not affect this engine
+     * @param processor Thread pool to run on, shared with later engines so
+     *                  its threads survive restarts (nullptr = create one
+     *                  from config.threads, config.taskScheduler and the
+     *                  affinity settings)
+     * @param nfpCache NFP cache shared with other engines, kept warm across
+     *                 runs over the same parts (nullptr = one of its own,
+     *                 cleared by initialize()). Its keys do not include
+     *                 the geometry settings, so all its engines must use the
+     *                 same curveTolerance, clipperScale and NFP settings
+     * @param shapeCache Spacing offsets and turned parts shared with other
+     *                   engines (nullptr = computed for each run)
      */
-    explicit NestingEngine(const DeepNestConfig& config);
+    explicit NestingEngine(const DeepNestConfig& config,
+                           std::shared_ptr<ParallelProcessor> processor = nullptr,
+                           std::shared_ptr<NFPCache> nfpCache = nullptr,
+                           std::shared_ptr<ShapeCache> shapeCache = nullptr);
 
     /**
      * @brief Destructor
@@ -161,6 +267,10 @@ public:
      *
      * @param progressCallback Called periodically with progress updates (optional)
      * @param resultCallback Called when better results are found (optional)
+     * The run also ends when config.maxIterations generations,
+     * config.timeoutSeconds or config.stallGenerations generations without a
+     * better result are reached; getBestResult() then holds the best layout.
+     *
      * @param maxGenerations Maximum number of generations to run (0 = unlimited)
      */
     void start(
@@ -172,7 +282,8 @@ public:
     /**
      * @brief Stop the nesting process
      *
-     * Gracefully stops nesting after current evaluations complete.
+     * Cancels the queued tasks and waits for running evaluations to
+     * complete. The thread pool keeps its threads for the next start().
      */
     void stop();
 
@@ -183,8 +294,11 @@ public:
      * It should be called periodically (e.g., from a timer or in a loop).
      *
      * Process:
-     * 1. Check if current generation is complete
-     * 2. If complete, create next generation
+     * 1. Check if current generation is complete (of each island on its
+     *    own, see DeepNestConfig::islands)
+     * 2. If complete, create next generation (in steady-state mode, replace
+     *    the worst members with evaluated children and breed new ones for
+     *    the idle threads instead, see DeepNestConfig::steadyState)
      * 3. Launch parallel workers for unevaluated individuals
      * 4. Update progress and call callbacks
      *
@@ -194,6 +308,19 @@ public:
      */
     bool step();
 
+    /**
+     * @brief Block until step() has something to do
+     *
+     * Returns at once if an evaluation has finished or none is in flight
+     * (the generation can be bred or more individuals launched); otherwise
+     * sleeps until a pool task completes. Lets a driving loop call step()
+     * the moment results land instead of polling on a timer.
+     *
+     * @param timeoutMs Longest wait in milliseconds
+     * @return False on timeout or if the engine is not running
+     */
+    bool waitForEvaluation(int timeoutMs);
+
     /**
      * @brief Check if nesting is currently running
      */
@@ -207,18 +334,116 @@ public:
     /**
      * @brief Get best result found so far
      *
-     * @return Pointer to best result, or nullptr if no results yet
+     * Safe to call from any thread while the engine runs; the result does
+     * not change and stays valid as long as it is held.
+     *
+     * @return Best result, or nullptr if no results yet
      */
-    const NestResult* getBestResult() const;
+    std::shared_ptr<const NestResult> getBestResult() const;
+
+    /**
+     * @brief Fewest sheets any layout placing every part can use
+     *
+     * Computed by initialize(): the sheets, largest first, needed to cover
+     * the parts' area (holes excluded), and at least one sheet per part
+     * larger than half the largest sheet, as two of those cannot share
+     * one. 0 if some part fits no sheet by area, inscribed circle or
+     * bounding size, or the sheets cannot cover the parts' area.
+     */
+    size_t getSheetLowerBound() const { return sheetLowerBound_; }
+
+    /**
+     * @brief Whether a result places every part on getSheetLowerBound() sheets
+     */
+    bool meetsSheetLowerBound(const NestResult& result) const;
 
     /**
      * @brief Get all saved results (top N)
      *
-     * Returns the best N results found during nesting.
+     * Returns the best N results found during nesting, as the snapshot
+     * last published; safe to call from any thread, like getBestResult().
+     *
+     * @return Results, sorted by fitness (best first); never nullptr
+     */
+    std::shared_ptr<const ResultHistory> getResults() const;
+
+    /**
+     * @brief Counters of the NFP cache this engine uses (shared or own)
+     */
+    NFPCache::Statistics getNfpCacheStatistics() const;
+
+    /**
+     * @brief Lock, queue and worker counters of this engine's processor
+     *        and NFP cache (filled while config.lockProfiling is on)
+     */
+    ContentionStats getContentionStats() const;
+
+    /**
+     * @brief Estimated memory of the NFP cache, population, saved results
+     *        and geometry of this engine
+     *
+     * Walks the population, so call it per generation rather than per
+     * evaluation, from the thread that runs step().
+     */
+    MemoryUsage getMemoryUsage() const;
+
+    /**
+     * @brief Regenerate the placements of an evaluated individual
+     *
+     * Individuals keep their fitness and genome, but only those reported
+     * as results keep their placements. placeParts() is deterministic, so
+     * placing the genome again on the full geometry reproduces the layout
+     * of a full-resolution evaluation. Do not call while nesting runs.
+     *
+     * @param individual Individual from the current population
+     * @return Placement result, empty if the engine is not initialized
+     */
+    PlacementWorker::PlacementResult materialize(const Individual& individual);
+
+    /**
+     * @brief Write the state of the run to a checkpoint file
+     *
+     * Stores per island the generation counters, random generator state,
+     * screening state and every genome with its fitness, plus the saved
+     * results and progress counters. Evaluations still running are stored
+     * as unevaluated; placements of individuals are not stored, see
+     * materialize(). The file is written next to path and renamed over it,
+     * so an interrupted write leaves the previous checkpoint intact.
+     * step() calls this every config.checkpointGenerations generations and
+     * when the run ends if config.checkpointPath is set.
      *
-     * @return Vector of results, sorted by fitness (best first)
+     * @param path Checkpoint file path
+     * @throws std::runtime_error if the file cannot be written
      */
-    const std::vector<NestResult>& getResults() const;
+    void saveCheckpoint(const std::string& path) const;
+
+    /**
+     * @brief Continue from a saveCheckpoint() file
+     *
+     * Call between initialize() and start(), with the same parts, sheets
+     * and population settings. Evaluated individuals keep their fitness and
+     * are not placed again.
+     *
+     * @param path Checkpoint file path
+     * @return False if the file is missing, damaged or belongs to another
+     *         job; the fresh population is then kept
+     */
+    bool loadCheckpoint(const std::string& path);
+
+    /**
+     * @brief Start the populations from a genome of an earlier nest
+     *
+     * Call between initialize() and start(). Genes name parts by their
+     * index in initialize()'s parts (Placement::source) and take the
+     * copies of a part in order; genes beyond a part's quantity are
+     * dropped, and copies no gene names follow, largest first, at
+     * rotation 0 where it is feasible. Rotations are rounded to the
+     * current rotation steps.
+     *
+     * @param genes (part index, rotation) in placement order
+     * @throws std::runtime_error if called before initialize()
+     */
+    void seed(const std::vector<std::pair<int, double>>& genes);
 
     /**
      * @brief Get configuration
@@ -251,8 +476,51 @@ public:
      * @return Offset polygon
      */
     static Polygon applySpacing(const Polygon& polygon, double offset, double curveTolerance);
+
+    /**
+     * @brief applySpacing() at the given Clipper scale instead of the
+     *        global configuration's
+     */
+    static Polygon applySpacing(const Polygon& polygon, double offset, double curveTolerance,
+                                double clipperScale);
 private:
 
+    /**
+     * @brief applySpacing() for every shape with a non-zero quantity
+     *
+     * Each distinct geometry (PersistentNFPStore::geometryHash) is offset
+     * once, across the pool, so quantity copies and repeated shapes cost a
+     * single offset. With a store attached, offsets are read from and
+     * written to it; its keys already carry spacing and curveTolerance.
+     *
+     * @return Per shape, a copy of it with the offset points and holes
+     *         (empty points where the quantity is zero or the shape vanished)
+     */
+    std::vector<Polygon> spaceShapes(const std::vector<Polygon>& shapes,
+                                     const std::vector<int>& quantities,
+                                     double offset,
+                                     PersistentNFPStore* store);
+
+    /**
+     * @brief Place small parts into the holes of larger ones (config.holeFilling)
+     *
+     * Parts with holes are hosts, largest first. Each hole, largest first,
+     * takes the unused parts small enough for it through placeParts() on
+     * the hole as a sheet, once per rotation step, with the parts already
+     * in it as obstacles. A host that took parts loses the holes it
+     * filled and stays in parts_ as a composite; its members leave
+     * parts_ and are recorded in holeFills_.
+     */
+    void fillHoles();
+
+    /**
+     * @brief Add the members of composite parts to placements
+     *
+     * Each composite placement is followed by its members, turned and
+     * moved with it.
+     */
+    void expandHoleFills(std::vector<std::vector<PlacementWorker::Placement>>& placements) const;
+
 
     /**
      * @brief Evaluate a single individual
@@ -266,7 +534,7 @@ private:
      * @return Placement result with fitness
      */
     PlacementWorker::PlacementResult evaluateIndividual(
-        Individual& individual,
+        const Individual& individual,
         const std::vector<Polygon>& parts,
         const std::vector<Polygon>& sheets
     );
@@ -300,8 +568,19 @@ private:
      * - Inner NFP: each part vs bin/sheet
      * - Outer NFP: each part vs previously placed parts
      *
-     * Only generates pairs that are not already in NFP cache.
+     * Only generates pairs that are not already in NFP cache. Pairs are
+     * deduplicated by cache key across the whole population and returned in
+     * priority order: inner NFPs first (every placement needs one), then by
+     * how many individuals need the pair, then by estimated cost.
      *
+     * @param cold Output, per island and population index: NFPs an
+     *             individual waiting for evaluation needs that are not
+     *             cached yet (0 = warm, or not waiting)
+     * @param sheetPairs Output, inner NFPs of the same parts on the sheet
+     *             types after the first (remnants, mixed stock) that are
+     *             not cached yet; step() queues them behind the generation
+     * @param select Island and population index of the individuals to
+     *             cover (nullptr = every one waiting for evaluation)
      * @return Vector of NFP pairs to calculate
      *
      * References:
@@ -309,35 +588,265 @@ private:
      * - svgnest.js line 293: Inner NFP key generation
      * - svgnest.js line 302: Outer NFP key generation
      */
-    std::vector<NFPPair> generateNFPPairs();
+    std::vector<NFPPair> generateNFPPairs(std::vector<std::vector<size_t>>& cold,
+                                         std::vector<NFPPair>& sheetPairs,
+                                         const std::function<bool(size_t, size_t)>& select = nullptr);
+
+    /**
+     * @brief Outer NFPs the next generation is likely to need that are not cached
+     *
+     * The config.speculativeNfpPairs best-ranked pairs of a
+     * GenePairStatistics over every island, leaving out cached pairs,
+     * pairs whose mirror is cached and the requested ones.
+     *
+     * @param requested Pairs generateNFPPairs() returned for this step
+     * @return Pairs to prefetch, most likely first
+     */
+    std::vector<NFPPair> speculativeNFPPairs(const std::vector<NFPPair>& requested);
+
+    /**
+     * @brief Take over finished evaluations and report new best results
+     *
+     * Collects every individual whose evaluation is DONE
+     * (Individual::collect) and passes full-resolution, unbounded ones
+     * that beat the best result to updateResults() and the result callback.
+     * Runs on the engine thread without locking; workers only write their
+     * own evaluation slots.
+     */
+    void collectEvaluations();
+
+    /**
+     * @brief Keep getMemoryUsage() under config.memoryLimitMB
+     *
+     * Lowers the NFP cache budget to what the other subsystems leave over,
+     * evicting at once; if they alone reach the ceiling, the fitness memo
+     * is dropped and the cache keeps 1/16 of the ceiling. The budget only
+     * tightens. Does nothing without a ceiling.
+     */
+    void enforceMemoryLimit();
+
+    /**
+     * @brief Close the per-generation stage times at a generation report
+     */
+    void markGenerationStages();
+
+    /**
+     * @brief Feed a generation's throughput to threadController_ and apply
+     *        the thread count it chooses (config.adaptiveThreads)
+     */
+    void adaptThreads();
+
+    /**
+     * @brief Choose the resolution of the individuals awaiting evaluation
+     *
+     * Individuals of the first config.coarseScreeningGenerations generations
+     * of their island are evaluated with the parts' coarse outlines, later
+     * ones at full resolution. In automatic mode (-1) an island screens
+     * until trackConvergence() finds it converged.
+     */
+    void markScreening();
+
+    /**
+     * @brief Genome of config.greedyFirstResult
+     *
+     * Parts in the GA's order (descending area), each at the feasible
+     * rotation whose bounding box fits the first sheet with the least
+     * area, narrower first on ties; copies of a part share it.
+     */
+    Individual greedyIndividual() const;
+
+    /**
+     * @brief Launch the first individual of the first island ahead of the
+     *        population (config.greedyFirstResult)
+     */
+    void launchGreedy();
+
+    /**
+     * @brief Move a converged island to full resolution (automatic screening)
+     *
+     * Called as the island's generation advances. Once its best fitness has
+     * not improved for a few generations the coarse outlines have nothing
+     * left to tell the island apart, and it evaluates at full resolution
+     * from then on.
+     *
+     * @param island Index of the island
+     */
+    void trackConvergence(size_t island);
+
+    /**
+     * @brief Re-evaluate an island's best individual at full resolution if needed
+     *
+     * Called when the island's generation is complete, before the elite is
+     * carried into the next one; in steady-state mode, when the generation
+     * counter advances.
+     *
+     * @param island Population of the island
+     * @return True if the best individual was coarse and its fitness was
+     *         reset for a full-resolution evaluation
+     */
+    bool refineElite(Population& island);
 
     /**
      * @brief Update saved results with new result
      *
-     * Keeps top N results sorted by fitness.
+     * Keeps top N results sorted by fitness, publishing a new snapshot.
      *
      * @param result New result to consider
      */
-    void updateResults(const NestResult& result);
+    void updateResults(const std::shared_ptr<const NestResult>& result);
+
+    /**
+     * @brief Fitness of the best saved result (max() if none)
+     */
+    double bestFitness() const;
+
+    /**
+     * @brief Rotations at which each part fits the sheets
+     *
+     * Tries every rotation step of one part per shape against one sheet
+     * per sheet type, through the inner NFPs, which stay cached for the
+     * placements. A part keeps the steps that fit every sheet type, else
+     * those that fit any; parts that fit at every step, or at none, are
+     * left unrestricted.
+     *
+     * @return Table, or nullptr if no part is restricted
+     */
+    std::shared_ptr<const FeasibleRotations> computeFeasibleRotations();
+
+    /**
+     * @brief Local search around the best individual (config.polishMoves)
+     *
+     * Each round applies config.polishMoves random swap, insert and rotate
+     * moves to the best full-resolution individual and places the moved
+     * genomes in parallel on the pool, cut off at the current fitness.
+     * Moves change a suffix of the genes, so placeParts() resumes from the
+     * placement memo's prefix snapshots instead of placing from scratch.
+     * The best improving move is kept and reported as a result; rounds
+     * repeat until none improves or the time budget runs out.
+     *
+     * @return True if the best individual improved
+     */
+    bool polish();
+
+    /**
+     * @brief Re-nest each sheet of the best individual on its own
+     *        (config.sheetDecompositionGenerations)
+     *
+     * The parts the best full-resolution individual puts on each sheet
+     * are frozen to that sheet, and every sheet gets a Population of its
+     * own, seeded with its parts in their current order and rotations.
+     * The sub-nests breed for config.sheetDecompositionGenerations
+     * generations; each generation's individuals of all of them are
+     * placed together on the pool, each on its sheet alone. The best
+     * layout of every sheet that places all its parts is kept, and their
+     * combination is reported as a result if it beats the best one.
+     *
+     * @return True if the combination improved on the best result
+     */
+    bool decompose();
+
+    /**
+     * @brief Best full-resolution individual of every island, nullptr if none
+     */
+    Individual* bestEvaluated();
+
+    /**
+     * @brief Hash of the parts each sheet of a result holds, by source
+     */
+    static uint64_t sheetAssignment(const NestResult& result);
+
+    /**
+     * @brief Alternative sheet orders for config.sheetOrderSearch
+     *
+     * Called by start() once job_ is built. Leaves sheetOrders_ empty
+     * unless the option is set and the sheets have more than one shape.
+     */
+    void buildSheetOrders();
+
+    /**
+     * @brief Place a new best genome on the alternative sheet orders
+     *
+     * The orders in sheetOrders_ are placed in parallel on the pool, cut
+     * off at the fitness of found; the best one that improves on it is
+     * reported as a result of its own.
+     *
+     * @param individual Full-resolution genome found was evaluated from
+     * @param found Result just reported for individual
+     */
+    void searchSheetOrders(const Individual& individual, const NestResult& found);
 
     /**
-     * @brief Configuration
+     * @brief Generation cap of this run: the lower of maxGenerations and
+     *        config.maxIterations that is set, 0 for none
      */
-    const DeepNestConfig& config_;
+    int generationLimit() const;
+
     /**
-     * @brief NFP cache for all NFP operations
+     * @brief Seconds since start()
+     */
+    double elapsedSeconds() const;
+
+    /**
+     * @brief Whether a generation, time or convergence budget ran out
+     */
+    bool budgetExhausted() const;
+
+    /**
+     * @brief Whether decompose() would split a result into sheet sub-nests:
+     *        it places every part, on two sheets or more
+     */
+    bool decomposable(const NestResult& result) const;
+
+    /**
+     * @brief See getSheetLowerBound()
+     */
+    size_t computeSheetLowerBound() const;
+
+    /**
+     * @brief Hash of the parts, sheets and settings a checkpoint is valid for
+     */
+    uint64_t checkpointFingerprint() const;
+
+    /**
+     * @brief Save to config.checkpointPath if checkpointGenerations passed
+     *
+     * @param force Save regardless of the generation (end of the run)
+     */
+    void checkpointIfDue(bool force = false);
+
+    /**
+     * @brief Configuration snapshot read by the engine, its genetic
+     *        algorithm, placement worker and NFP calculator
+     */
+    const DeepNestConfig config_;
+    /**
+     * @brief NFP cache for all NFP operations, unless one is shared
      */
     NFPCache nfpCache_;
 
+    /**
+     * @brief NFP cache shared with other engines, used instead of nfpCache_
+     *
+     * Declared before nfpCalculator_, which refers to it.
+     */
+    std::shared_ptr<NFPCache> sharedNfpCache_;
+
+    /**
+     * @brief Offsets and turned parts shared with other engines (optional)
+     */
+    std::shared_ptr<ShapeCache> shapeCache_;
+
     /**
      * @brief Parallel processor for concurrent evaluations
      *
      * CRITICAL: Must be declared BEFORE placementWorker_ and nfpCalculator_
      * because it's used by them and must be destroyed LAST (C++ destroys in
      * reverse order of declaration). This ensures threads are stopped and
-     * joined BEFORE the resources they use are destroyed.
+     * joined BEFORE the resources they use are destroyed. A pool shared
+     * with the caller outlives the engine; stop() then makes sure no task
+     * of this engine is left on it.
      */
-    std::unique_ptr<ParallelProcessor> parallelProcessor_;
+    std::shared_ptr<ParallelProcessor> parallelProcessor_;
 
     /**
      * @brief NFP calculator for all NFP operations
@@ -368,11 +877,51 @@ private:
      */
     std::vector<std::shared_ptr<Polygon>> partPointers_;
 
+    /**
+     * @brief Parts placed in a composite's holes by fillHoles(), by composite id
+     *
+     * Placements are relative to the unrotated composite.
+     */
+    std::unordered_map<int, std::vector<PlacementWorker::Placement>> holeFills_;
+
     /**
      * @brief Available sheets (with quantities expanded)
      */
     std::vector<Polygon> sheets_;
 
+    /**
+     * @brief Sheets and turned parts shared by this run's evaluations
+     *
+     * Built by start() from sheets_ and partPointers_.
+     */
+    std::shared_ptr<const PlacementJob> job_;
+
+    /**
+     * @brief Sheet orders tried by searchSheetOrders(), as indices into
+     *        sheets_, each with job_'s sheets in that order
+     */
+    std::vector<std::vector<size_t>> sheetOrders_;
+    std::vector<std::vector<Polygon>> orderedSheets_;
+
+    /**
+     * @brief Complete evaluations of job_ by genome
+     *
+     * Built by start() with job_, unless config.fitnessMemoMaxEntries is 0.
+     */
+    std::shared_ptr<FitnessMemo> fitnessMemo_;
+
+    /**
+     * @brief Estimate screening bred children, calibrated by collectEvaluations()
+     *
+     * Built by initialize() when config.surrogateOversampling exceeds 1.
+     */
+    std::shared_ptr<SurrogateFitness> surrogate_;
+
+    /**
+     * @brief Angles each part fits at, nullptr for any (built by initialize())
+     */
+    std::shared_ptr<const FeasibleRotations> feasibleRotations_;
+
     /**
      * @brief Running flag
      */
@@ -383,6 +932,86 @@ private:
      */
     int maxGenerations_;
 
+    /**
+     * @brief When start() was called, for config.timeoutSeconds
+     */
+    std::chrono::steady_clock::time_point startTime_;
+
+    /**
+     * @brief StageTimer totals at start() and at the last generation report
+     */
+    StageTimes stageBaseline_;
+    StageTimes generationStageBaseline_;
+
+    /**
+     * @brief Thread count tuning (config.adaptiveThreads; null = all threads)
+     */
+    std::unique_ptr<ThreadCountController> threadController_;
+
+    /**
+     * @brief Evaluations, time and task times at the last adaptThreads()
+     */
+    int threadSampleEvaluations_;
+    std::chrono::steady_clock::time_point threadSampleTime_;
+    ParallelProcessor::TaskTimes threadSampleTasks_;
+
+    /**
+     * @brief Stage times between the last two generation reports
+     */
+    StageTimes generationStages_;
+
+    /**
+     * @brief Generation in which the best result last improved
+     */
+    int lastImprovementGeneration_;
+
+    /**
+     * @brief sheetAssignment() of the best result, and the generation it
+     *        was first seen in
+     */
+    uint64_t assignment_;
+    int assignmentGeneration_;
+
+    /**
+     * @brief See getSheetLowerBound()
+     */
+    size_t sheetLowerBound_;
+
+    /**
+     * @brief Parts of the job, hole-filled ones included
+     */
+    size_t partCount_;
+
+    /**
+     * @brief Screening state of an island in automatic mode
+     */
+    struct IslandDetail {
+        double bestFitness = std::numeric_limits<double>::max();
+        int stalledGenerations = 0;
+        bool fullResolution = false;
+    };
+
+    /**
+     * @brief Per island, for trackConvergence()
+     */
+    std::vector<IslandDetail> islandDetail_;
+
+    /**
+     * @brief Generation of the last checkpoint written or loaded
+     */
+    int lastCheckpointGeneration_;
+
+    /**
+     * @brief Generation whose likely NFPs were last prefetched (-1 = none)
+     */
+    int speculatedGeneration_;
+
+    /**
+     * @brief Set by loadCheckpoint(), so that start() keeps the restored
+     *        convergence state
+     */
+    bool resumed_;
+
     /**
      * @brief Total evaluations completed
      */
@@ -400,8 +1029,12 @@ private:
 
     /**
      * @brief Saved results (top 10 by default)
+     *
+     * Replaced with std::atomic_store by the engine thread and read with
+     * std::atomic_load elsewhere; the engine thread, the only writer,
+     * reads it directly.
      */
-    std::vector<NestResult> results_;
+    std::shared_ptr<const ResultHistory> results_ = std::make_shared<const ResultHistory>();
 
     /**
      * @brief Maximum results to save
@@ -411,8 +1044,4 @@ private:
 
 } // namespace deepnest
 
-// Declare metatypes for Qt signal/slot system
-Q_DECLARE_METATYPE(deepnest::NestResult)
-Q_DECLARE_METATYPE(deepnest::NestProgress)
-
 #endif // DEEPNEST_NESTING_ENGINE_H
@@ -0,0 +1,101 @@
+#ifndef DEEPNEST_CLIPPER_CONTEXT_H
+#define DEEPNEST_CLIPPER_CONTEXT_H
+
+#include <clipper2/clipper.engine.h>
+#include <clipper2/clipper.offset.h>
+
+namespace deepnest {
+
+/**
+ * @brief Reusable Clipper2 engines for boolean and offset operations
+ *
+ * Clipper2's free functions (Union, Difference, InflatePaths, ...) build a
+ * fresh engine per call, so every call allocates the local minima list,
+ * the active edge and output record lists and the result paths again.
+ * A context keeps one Clipper64 and one ClipperOffset and clears them
+ * between operations, so those lists keep their capacity; results go to
+ * buffers the caller owns and reuses.
+ *
+ * A context is not thread-safe. local() hands out one per thread, which is
+ * what PolygonOperations and the placement loop use. An operation runs to
+ * completion before returning, so nested use on one thread is safe.
+ */
+class ClipperContext {
+public:
+    /**
+     * @brief The calling thread's context
+     */
+    static ClipperContext& local();
+
+    /**
+     * @brief Union of subjects; out is replaced
+     */
+    void unite(const Clipper2Lib::Paths64& subjects, Clipper2Lib::Paths64& out,
+               Clipper2Lib::FillRule fillRule = Clipper2Lib::FillRule::NonZero);
+
+    /**
+     * @brief Union of subjects and clips; out is replaced
+     */
+    void unite(const Clipper2Lib::Paths64& subjects, const Clipper2Lib::Paths64& clips,
+               Clipper2Lib::Paths64& out,
+               Clipper2Lib::FillRule fillRule = Clipper2Lib::FillRule::NonZero);
+
+    /**
+     * @brief subject - clips; out is replaced
+     *
+     * When subject is an axis-aligned rectangle, as the inner NFP of a
+     * rectangular sheet is, the clips are first cut to it with RectClip64.
+     * The region is the same; pieces that touch at a single vertex may
+     * come back joined in one path.
+     */
+    void difference(const Clipper2Lib::Path64& subject, const Clipper2Lib::Paths64& clips,
+                    Clipper2Lib::Paths64& out,
+                    Clipper2Lib::FillRule fillRule = Clipper2Lib::FillRule::NonZero);
+
+    /**
+     * @brief a - b; out is replaced
+     */
+    void difference(const Clipper2Lib::Path64& a, const Clipper2Lib::Path64& b,
+                    Clipper2Lib::Paths64& out,
+                    Clipper2Lib::FillRule fillRule = Clipper2Lib::FillRule::NonZero);
+
+    /**
+     * @brief Intersection of two paths; out is replaced
+     */
+    void intersect(const Clipper2Lib::Path64& a, const Clipper2Lib::Path64& b,
+                   Clipper2Lib::Paths64& out,
+                   Clipper2Lib::FillRule fillRule = Clipper2Lib::FillRule::NonZero);
+
+    /**
+     * @brief Offset closed paths by delta; out is replaced
+     *
+     * Same parameters as ClipperOffset, all in Clipper units.
+     */
+    void offset(const Clipper2Lib::Paths64& paths, double delta,
+                Clipper2Lib::JoinType joinType, double miterLimit, double arcTolerance,
+                Clipper2Lib::Paths64& out);
+
+private:
+    /**
+     * @brief Run the clipper on what has been added and clear it
+     */
+    void execute(Clipper2Lib::ClipType clipType, Clipper2Lib::FillRule fillRule,
+                 Clipper2Lib::Paths64& out);
+
+    /**
+     * @brief path as a one-element operand, reusing the buffer
+     */
+    const Clipper2Lib::Paths64& single(Clipper2Lib::Paths64& buffer, const Clipper2Lib::Path64& path);
+
+    Clipper2Lib::Clipper64 clipper_;
+    Clipper2Lib::ClipperOffset offset_;
+
+    // One-path operands and the open-path output Clipper64 requires
+    Clipper2Lib::Paths64 subject_;
+    Clipper2Lib::Paths64 clip_;
+    Clipper2Lib::Paths64 open_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_CLIPPER_CONTEXT_H
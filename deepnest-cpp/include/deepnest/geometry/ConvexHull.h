@@ -36,6 +36,31 @@ public:
      */
     static std::vector<Point> computeHullFromPolygon(const std::vector<Point>& polygon);
 
+    /**
+     * @brief Sort points by x, then y, for mergedHullArea()
+     */
+    static void sortForMerge(std::vector<Point>& points);
+
+    /**
+     * @brief Area of the convex hull of a together with b shifted by offset
+     *
+     * Both lists must be sorted with sortForMerge(). A shift keeps b sorted,
+     * so the lists are merged in O(|a| + |b|) and swept with Andrew's
+     * monotone chain, without polar angles or sorting. Passing the hulls
+     * of two point sets gives the hull area of their union, which makes
+     * repeated queries against a fixed hull cheap.
+     *
+     * @param a Sorted points
+     * @param b Sorted points, shifted by offset
+     * @param offset Translation of b
+     * @return Hull area (0 for fewer than 3 non-collinear points)
+     */
+    static double mergedHullArea(
+        const std::vector<Point>& a,
+        const std::vector<Point>& b,
+        const Point& offset
+    );
+
 private:
     /**
      * @brief Find the anchor point (lowest y, then leftmost x)
@@ -0,0 +1,66 @@
+#ifndef DEEPNEST_EDGE_GRID_H
+#define DEEPNEST_EDGE_GRID_H
+
+#include "../core/Point.h"
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Uniform grid over the edges of a closed polygon
+ *
+ * Edge i runs from polygon[i] to polygon[(i + 1) % n] and is entered in
+ * every cell its bounds, grown by the margin, overlap. A point or box
+ * query returns the edges whose grown bounds may reach it, so a test that
+ * can only succeed near an edge visits a handful of edges instead of all
+ * of them.
+ *
+ * The orbital noFitPolygon builds one grid per polygon and keeps it for
+ * the whole orbit: the contact and slide searches of every step then run
+ * in time proportional to the edges nearby rather than to |A| * |B|.
+ */
+class EdgeGrid {
+public:
+    /**
+     * @brief Index the edges of polygon
+     *
+     * @param polygon Closed outline; the edge back to the first point is implied
+     * @param margin Distance by which every edge's bounds are grown
+     */
+    EdgeGrid(const std::vector<Point>& polygon, double margin);
+
+    /**
+     * @brief Edges whose grown bounds may contain the point, ascending
+     */
+    const std::vector<int>& near(double x, double y) const;
+
+    /**
+     * @brief Edges whose grown bounds may overlap the box, ascending
+     *
+     * @param edges Cleared and filled with the edge indices
+     */
+    void overlapping(double minX, double minY, double maxX, double maxY,
+                     std::vector<int>& edges) const;
+
+    size_t edgeCount() const { return edgeCount_; }
+
+private:
+    int column(double x) const;
+    int row(double y) const;
+
+    size_t edgeCount_ = 0;
+    double minX_ = 0.0;
+    double minY_ = 0.0;
+    double maxX_ = 0.0;
+    double maxY_ = 0.0;
+    double cellSize_ = 1.0;
+    int columns_ = 0;
+    int rows_ = 0;
+
+    // Row-major cells, each listing its edges in ascending order
+    std::vector<std::vector<int>> cells_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_EDGE_GRID_H
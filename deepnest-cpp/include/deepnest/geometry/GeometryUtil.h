@@ -5,6 +5,7 @@
 #include "../core/Point.h"
 #include "../core/BoundingBox.h"
 #include "OrbitalTypes.h"
+#include <functional>
 #include <vector>
 #include <optional>
 
@@ -12,6 +13,7 @@ namespace deepnest {
 
 // Forward declaration
 class Polygon;
+class EdgeGrid;
 
 /**
  * @brief Geometry utility functions
@@ -287,6 +289,21 @@ namespace GeometryUtil {
         bool ignoreNegative = false
     );
 
+    /**
+     * @brief polygonSlideDistance() with ignoreNegative, as seen by a slide of length reach
+     *
+     * Only A edges within reach of a B edge along direction are tested, so
+     * a result beyond reach may be missed; the orbit caps every slide at
+     * its vector length anyway. gridA indexes A with a margin of at least TOL.
+     */
+    std::optional<double> polygonSlideDistance(
+        const std::vector<Point>& A,
+        const std::vector<Point>& B,
+        const Point& direction,
+        const EdgeGrid& gridA,
+        double reach
+    );
+
     /**
      * @brief Project polygon B onto polygon A in given direction
      */
@@ -306,17 +323,34 @@ namespace GeometryUtil {
         const std::vector<std::vector<Point>>& NFP = {}
     );
 
+    /**
+     * @brief Runs body over [0, count) in chunks, possibly concurrently
+     *        (e.g. ParallelProcessor::parallelFor)
+     */
+    using ParallelFor = std::function<void(size_t count,
+                                           const std::function<void(size_t begin, size_t end)>& body)>;
+
     /**
      * @brief Calculate No-Fit Polygon (NFP) of B orbiting around A
+     *
+     * With searchEdges, each loop after the first is found by searching
+     * for a start point off the loops traced so far and tracing from it, one
+     * at a time. With a parallelFor as well, the start points are all
+     * enumerated after the first loop (searchStartPoints) and traced as
+     * concurrent subtasks; starts on the same loop trace it repeatedly, and
+     * the repeats are dropped.
+     *
      * @param inside If true, B orbits inside A; if false, outside
      * @param searchEdges If true, find all NFPs; if false, only first
+     * @param parallelFor Runs the traces of the further loops (searchEdges only)
      * @return List of NFP polygons
      */
     std::vector<std::vector<Point>> noFitPolygon(
         const std::vector<Point>& A,
         const std::vector<Point>& B,
         bool inside = false,
-        bool searchEdges = false
+        bool searchEdges = false,
+        const ParallelFor& parallelFor = nullptr
     );
 
     /**
@@ -327,6 +361,29 @@ namespace GeometryUtil {
         const std::vector<Point>& B
     );
 
+    /**
+     * @brief Check if a polygon is convex (either winding)
+     *
+     * Collinear and duplicate vertices are allowed; self-intersecting
+     * polygons that turn consistently (e.g. a pentagram) are rejected.
+     */
+    bool isConvex(const std::vector<Point>& polygon, double tolerance = TOL);
+
+    /**
+     * @brief Minkowski sum of two convex polygons by edge merging
+     *
+     * Merges the edge sequences of A and B by polar angle, so the result
+     * is produced in O(n+m) without any boolean union. Both inputs must be
+     * convex (see isConvex()); either winding is accepted.
+     *
+     * @return Convex sum with counter-clockwise winding (negative polygonArea),
+     *         or empty if an input is degenerate
+     */
+    std::vector<Point> convexMinkowskiSum(
+        const std::vector<Point>& A,
+        const std::vector<Point>& B
+    );
+
     /**
      * @brief Calculate the outer hull of two touching polygons
      * @return Single polygon representing the combined perimeter
@@ -400,6 +457,20 @@ namespace GeometryUtil {
         const Point& offsetB
     );
 
+    /**
+     * @brief findTouchingContacts() over the edge pairs the grids put near each other
+     *
+     * Same contacts in the same order; gridA and gridB index A and B with a
+     * margin of at least TOL.
+     */
+    std::vector<TouchingContact> findTouchingContacts(
+        const std::vector<Point>& A,
+        const std::vector<Point>& B,
+        const Point& offsetB,
+        const EdgeGrid& gridA,
+        const EdgeGrid& gridB
+    );
+
     /**
      * @brief Generate translation vectors from a touching contact
      *
@@ -135,6 +135,25 @@ std::optional<double> polygonProjectionDistance(
     const Point& direction
 );
 
+/**
+ * @brief Whether B, moved by offset, overlaps A
+ *
+ * True if an edge of one crosses the other, or a vertex or edge midpoint
+ * of one lies strictly inside the other. Touching boundaries do not
+ * overlap; the midpoints catch B lying across a gap of A's with every
+ * vertex on A's boundary.
+ *
+ * @param A Fixed polygon
+ * @param B Moving polygon
+ * @param offset Translation of B
+ * @return True if the interiors overlap
+ */
+bool polygonsOverlap(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    const Point& offset
+);
+
 /**
  * @brief Search for a valid start point for NFP calculation
  *
@@ -155,6 +174,24 @@ std::optional<Point> searchStartPoint(
     const std::vector<std::vector<Point>>& NFP
 );
 
+/**
+ * @brief Every start point searchStartPoint() would accept
+ *
+ * The candidates searchStartPoint() tries, B's vertices on A's vertices and
+ * slid along A's edges, that pass its checks, in the same order and without
+ * duplicates. Each lies on some loop of the NFP.
+ *
+ * @param A Fixed polygon
+ * @param B Moving polygon
+ * @param inside If true, find interior NFP; if false, find exterior NFP
+ * @return Start point offsets for B
+ */
+std::vector<Point> searchStartPoints(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    bool inside
+);
+
 /**
  * @brief Calculate the convex hull of two positioned polygons
  *
@@ -2,6 +2,7 @@
 #define DEEPNEST_POLYGON_HIERARCHY_H
 
 #include "../core/Polygon.h"
+#include <functional>
 #include <vector>
 
 namespace deepnest {
@@ -16,6 +17,13 @@ namespace deepnest {
  */
 class PolygonHierarchy {
 public:
+    /**
+     * @brief Runs body over [0, count) in chunks, possibly concurrently
+     *        (ParallelProcessor::parallelFor)
+     */
+    using ParallelFor = std::function<void(size_t count,
+                                           const std::function<void(size_t, size_t)>& body)>;
+
     /**
      * @brief Build hierarchical tree from flat list of polygons
      *
@@ -26,8 +34,14 @@ public:
      * 4. Assign unique IDs to parent polygons
      * 5. Recursively process children
      *
+     * Step 1 only tests the polygons whose bounds, held in an R-tree,
+     * contain the point, so imports with thousands of contours build in
+     * O(n log n) in practice rather than O(n^2). The search runs over
+     * parallelFor when one is given and the list is large.
+     *
      * @param polygons Flat list of polygons (will be modified in-place)
      * @param idStart Starting ID for parent polygons (default: 0)
+     * @param parallelFor Spreads the containment search (nullptr = inline)
      * @return Vector of top-level polygons with children nested
      *
      * Example:
@@ -40,7 +54,8 @@ public:
      */
     static std::vector<Polygon> buildTree(
         std::vector<Polygon>& polygons,
-        int idStart = 0
+        int idStart = 0,
+        const ParallelFor& parallelFor = nullptr
     );
 
 private:
@@ -49,11 +64,13 @@ private:
      *
      * @param list List of polygons to process
      * @param id Current ID counter
+     * @param parallelFor As for buildTree()
      * @return Next available ID after processing
      */
     static int buildTreeRecursive(
         std::vector<Polygon>& list,
-        int id
+        int id,
+        const ParallelFor& parallelFor
     );
 };
 
@@ -3,6 +3,8 @@
 
 #include "../core/Types.h"
 #include "../core/Point.h"
+#include <clipper2/clipper.core.h>
+#include <cmath>
 #include <vector>
 
 namespace deepnest {
@@ -16,6 +18,12 @@ class Polygon;
  * This class provides polygon operations such as offset, simplification,
  * and boolean operations using the Clipper2 library.
  * Based on polygonOffset and cleanPolygon functions from deepnest.js
+ *
+ * Operations that convert to Clipper coordinates come in two forms: one
+ * reading clipperScale (and integerGeometry) from DeepNestConfig's global
+ * instance, and one taking them as arguments. Engine code passes the
+ * values of its own configuration, so jobs with different settings can
+ * run in one process.
  */
 class PolygonOperations {
 public:
@@ -38,6 +46,17 @@ public:
         double arcTolerance = 0.3
     );
 
+    /**
+     * @brief offset() rounding at the given Clipper scale
+     */
+    static std::vector<std::vector<Point>> offset(
+        const std::vector<Point>& poly,
+        double delta,
+        double miterLimit,
+        double arcTolerance,
+        double scale
+    );
+
     /**
      * @brief Clean a polygon by removing self-intersections
      *
@@ -50,6 +69,11 @@ public:
      */
     static std::vector<Point> cleanPolygon(const std::vector<Point>& poly);
 
+    /**
+     * @brief cleanPolygon() at the given Clipper scale
+     */
+    static std::vector<Point> cleanPolygon(const std::vector<Point>& poly, double scale);
+
     /**
      * @brief Simplify a polygon by reducing number of vertices
      *
@@ -74,6 +98,95 @@ public:
         const std::vector<std::vector<Point>>& polygons
     );
 
+    /**
+     * @brief Union of polygons, each shifted by its own offset
+     *
+     * The offset is applied while converting to Clipper coordinates, so
+     * callers can pass shared (e.g. cached) polygons without first building
+     * translated copies.
+     *
+     * @param polygons Polygons to union (not modified)
+     * @param offsets Translation for each polygon (same size as polygons)
+     * @return Vector of resulting polygons from union
+     */
+    static std::vector<std::vector<Point>> unionPolygons(
+        const std::vector<const std::vector<Point>*>& polygons,
+        const std::vector<Point>& offsets
+    );
+
+    /**
+     * @brief Union of pre-scaled Clipper paths, each shifted by its own offset
+     *
+     * Integer counterpart of unionPolygons() for polygons that carry a
+     * Polygon::scaledPath. The offsets are scaled once and added in integer
+     * coordinates, and the result stays in Clipper coordinates.
+     *
+     * @param paths Paths at the configured clipperScale (not modified)
+     * @param offsets Translation for each path in nest units (same size as paths)
+     * @return Union in Clipper coordinates
+     */
+    static Clipper2Lib::Paths64 unionPaths(
+        const std::vector<const Clipper2Lib::Path64*>& paths,
+        const std::vector<Point>& offsets
+    );
+
+    /**
+     * @brief unionPaths() for paths at the given scale and grid mode
+     */
+    static Clipper2Lib::Paths64 unionPaths(
+        const std::vector<const Clipper2Lib::Path64*>& paths,
+        const std::vector<Point>& offsets,
+        double scale,
+        bool integerGeometry
+    );
+
+    /**
+     * @brief Difference of pre-scaled Clipper paths (subject - clip)
+     *
+     * @param subject Subject path at the configured clipperScale
+     * @param clip Clip paths at the configured clipperScale
+     * @return Resulting polygons converted back to nest coordinates
+     */
+    static std::vector<std::vector<Point>> differencePaths(
+        const Clipper2Lib::Path64& subject,
+        const Clipper2Lib::Paths64& clip
+    );
+
+    /**
+     * @brief differencePaths() for paths at the given scale
+     */
+    static std::vector<std::vector<Point>> differencePaths(
+        const Clipper2Lib::Path64& subject,
+        const Clipper2Lib::Paths64& clip,
+        double scale
+    );
+
+    /**
+     * @brief Convert polygon points to a Clipper path at the configured clipperScale
+     */
+    static Clipper2Lib::Path64 toPath64(const std::vector<Point>& poly);
+
+    static Clipper2Lib::Path64 toPath64(const std::vector<Point>& poly, double scale);
+
+    /**
+     * @brief Convert a Clipper path at the configured clipperScale to polygon points
+     */
+    static std::vector<Point> fromPath64(const Clipper2Lib::Path64& path);
+
+    static std::vector<Point> fromPath64(const Clipper2Lib::Path64& path, double scale);
+
+    /**
+     * @brief Coordinate or offset in Clipper units
+     *
+     * Truncates like toPath64(), or rounds to the nearest grid point in
+     * integer geometry mode, where values are grid points up to rounding
+     * and truncation could land one unit short.
+     */
+    static int64_t toClipperUnits(double value, double scale, bool integerGeometry) {
+        return integerGeometry ? std::llround(value * scale)
+                               : static_cast<int64_t>(value * scale);
+    }
+
     /**
      * @brief Perform intersection operation on two polygons
      *
@@ -98,6 +211,15 @@ public:
         const std::vector<Point>& polyB
     );
 
+    /**
+     * @brief differencePolygons() at the given Clipper scale
+     */
+    static std::vector<std::vector<Point>> differencePolygons(
+        const std::vector<Point>& polyA,
+        const std::vector<Point>& polyB,
+        double scale
+    );
+
     /**
      * @brief Convert polygon points to Clipper coordinates
      *
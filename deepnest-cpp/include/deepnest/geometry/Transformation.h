@@ -7,6 +7,29 @@
 
 namespace deepnest {
 
+/**
+ * @brief Rings of many transformed polygons, back to back in one buffer
+ *
+ * Ring k is points[starts[k], starts[k + 1]); starts always holds one
+ * entry more than there are rings. Reused across calls, the buffer keeps
+ * its capacity.
+ */
+struct RingBatch {
+    std::vector<Point> points;
+    std::vector<size_t> starts{0};
+
+    size_t ringCount() const { return starts.size() - 1; }
+
+    const Point* ringBegin(size_t ring) const { return points.data() + starts[ring]; }
+    const Point* ringEnd(size_t ring) const { return points.data() + starts[ring + 1]; }
+    size_t ringSize(size_t ring) const { return starts[ring + 1] - starts[ring]; }
+
+    void clear() {
+        points.clear();
+        starts.assign(1, 0);
+    }
+};
+
 /**
  * @brief 2D Affine Transformation matrix
  *
@@ -138,6 +161,31 @@ public:
      */
     std::vector<Point> apply(const std::vector<Point>& points, bool isRelative = false) const;
 
+    /**
+     * @brief One ring to turn about the origin and then move
+     */
+    struct BatchItem {
+        const std::vector<Point>* ring;
+        double rotation;    // Degrees; 0 for rings already turned (e.g. PlacementJob variants)
+        Point offset;
+
+        BatchItem(const std::vector<Point>* r, double rot, const Point& off)
+            : ring(r), rotation(rot), offset(off) {}
+    };
+
+    /**
+     * @brief Turn and move many rings into one buffer
+     *
+     * Each item gives the bits of rotate(item.rotation) followed by
+     * translate(offset.x, offset.y), applied as one fused pass without
+     * intermediate polygons. The sine and cosine are evaluated once per
+     * distinct angle. Rings are appended to batch in item order.
+     *
+     * @param items Rings with their rotation and offset
+     * @param batch Output; cleared first
+     */
+    static void applyBatch(const std::vector<BatchItem>& items, RingBatch& batch);
+
     /**
      * @brief Get matrix elements as array
      *
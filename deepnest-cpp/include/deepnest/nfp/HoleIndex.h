@@ -0,0 +1,71 @@
+#ifndef DEEPNEST_HOLE_INDEX_H
+#define DEEPNEST_HOLE_INDEX_H
+
+#include "../core/Polygon.h"
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Size summary of a part's holes, to reject holes a part cannot enter
+ *
+ * A hole of the stationary polygon only adds to its outer NFP if the
+ * moving polygon fits inside it; otherwise the Minkowski sum fills it.
+ * Each hole is summarised by its bounding size, area and an upper bound on
+ * its inscribed circle, the moving polygon by its bounding size, area and
+ * a lower bound on its inscribed circle (convex outlines only). A hole is
+ * rejected when any of the three cannot hold; the tests are necessary
+ * conditions, so a hole the part does fit in is never rejected.
+ *
+ * Both polygons are taken as given: B only translates during NFP
+ * computation, so the bounding test compares axis-aligned boxes of the
+ * rotated shapes and an index is valid for one rotation of its part.
+ */
+class HoleIndex {
+public:
+    /**
+     * @brief Size summary of one outline
+     */
+    struct Extent {
+        double width = 0.0;
+        double height = 0.0;
+        double area = 0.0;
+        double inradius = 0.0;  // Upper bound for holes, lower bound for parts
+    };
+
+    /**
+     * @brief Index the holes (children) of a polygon
+     */
+    explicit HoleIndex(const Polygon& part);
+
+    /**
+     * @brief Extent of a moving polygon's outer boundary
+     *
+     * Its own holes do not matter: the outline has to fit either way.
+     */
+    static Extent footprint(const Polygon& B);
+
+    /**
+     * @brief Upper-bound extent of a hole, or of a sheet for an inner NFP
+     */
+    static Extent container(const Polygon& hole);
+
+    /**
+     * @brief Whether an outline of the given footprint may fit in the container
+     */
+    static bool mayFit(const Extent& container, const Extent& footprint);
+
+    size_t holeCount() const { return holes_.size(); }
+
+    /**
+     * @brief Indices of the holes a footprint may fit in, in child order
+     */
+    std::vector<size_t> candidates(const Extent& footprint) const;
+
+private:
+    std::vector<Extent> holes_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_HOLE_INDEX_H
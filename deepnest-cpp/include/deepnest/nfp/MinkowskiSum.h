@@ -142,16 +142,17 @@ namespace deepnest {
         private:
 
             /**
-                * @brief Convert polygon to Boost integer polygon
+                * @brief Convert flat rings to Boost integer polygon
                 *
                 * Converts double coordinates to integer by direct truncation.
                 * Assumes input polygons are in reasonable coordinate ranges.
+                * The outer boundary and its holes are converted.
                 *
-                * @param poly Input polygon
+                * @param rings Input polygon's rings
                 * @return Boost polygon with integer coordinates
                 */
             static boost::polygon::polygon_with_holes_data<int> toBoostIntPolygon(
-                const Polygon& poly
+                const MultiRing& rings
             );
 
             /**
@@ -0,0 +1,66 @@
+#ifndef DEEPNEST_NFP_ACCELERATOR_H
+#define DEEPNEST_NFP_ACCELERATOR_H
+
+#include <clipper2/clipper.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Device that computes the edge-pair convolution of Minkowski sums
+ *
+ * Clipper2's MinkowskiSum builds one quadrilateral per pair of edges of
+ * the two paths and unions them. The quadrilaterals are independent, so
+ * NFPCalculator::computeBatch hands a whole group of pairs to a device at
+ * once and runs the Clipper union of each pair's quadrilaterals on the
+ * CPU. Pairs the device cannot take, or a batch it fails on, go through
+ * the CPU path unchanged.
+ *
+ * The OpenCL device is compiled in with DEEPNEST_OPENCL (CMake option
+ * DEEPNEST_OPENCL, qmake CONFIG+=opencl); other devices can be attached
+ * with NFPCalculator::setAccelerator.
+ */
+class NFPAccelerator {
+public:
+    /**
+     * @brief One Minkowski sum A + B, the paths in Clipper coordinates
+     */
+    struct Job {
+        const Clipper2Lib::Path64* A;
+        const Clipper2Lib::Path64* B;
+    };
+
+    virtual ~NFPAccelerator() = default;
+
+    /**
+     * @brief Device name, for logs
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * @brief Convolve a batch of pairs
+     *
+     * For each job, the quadrilaterals Clipper2Lib::MinkowskiSum(A, B, true)
+     * unions, in the same order and orientation (positive area).
+     *
+     * @param jobs Pairs to convolve
+     * @param quads Receives one set of quadrilaterals per job
+     * @throws std::runtime_error if the device fails
+     */
+    virtual void convolve(const std::vector<Job>& jobs, std::vector<Clipper2Lib::Paths64>& quads) = 0;
+
+    /**
+     * @brief Device compiled in and present on this machine
+     *
+     * Probed once per process; later calls return the same device.
+     *
+     * @return The device, or nullptr if there is none
+     */
+    static std::shared_ptr<NFPAccelerator> detect();
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_NFP_ACCELERATOR_H
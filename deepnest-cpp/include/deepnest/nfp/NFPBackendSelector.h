@@ -0,0 +1,147 @@
+#ifndef DEEPNEST_NFP_BACKEND_SELECTOR_H
+#define DEEPNEST_NFP_BACKEND_SELECTOR_H
+
+#include "../core/Polygon.h"
+#include <array>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Engines that can compute an outer NFP
+ */
+enum class NFPBackend {
+    Convex,            ///< Linear edge merge (NFPCalculator::computeConvexNFP)
+    ClipperMinkowski,  ///< Clipper2 MinkowskiSum (NFPCalculator::computeDiffNFP)
+    BoostConvolution,  ///< Boost.Polygon convolution (trunk::MinkowskiSum)
+    Orbital,           ///< Orbiting/sliding NFP (GeometryUtil::noFitPolygon)
+    Libnfporb          ///< libnfporb (libnest2d_port::libnfporb_generateNFP)
+};
+
+/**
+ * @brief Shape class of an outer NFP pair
+ */
+enum class NFPPairClass {
+    ConvexConvex,  ///< Both convex, no holes in A
+    Simple,        ///< No holes in A
+    WithHoles      ///< A has holes
+};
+
+/**
+ * @brief Picks the NFP backend for each outer NFP pair from a cost model
+ *
+ * Each (pair class, backend) combination has a linear cost model
+ *   seconds = fixed + perUnit * size
+ * where size is n + m for the convex merge and the vertex product n * m
+ * (holes included) for the others. select() returns the cheapest enabled
+ * backend that supports the pair's class.
+ *
+ * The defaults reproduce the fixed dispatch (convex pairs -> Convex,
+ * simple pairs -> ClipperMinkowski, A with holes -> BoostConvolution).
+ * calibrate() benchmarks every backend on the job's own parts, disables
+ * backends whose NFP disagrees with the reference backend of the class and
+ * fits the cost models; save()/load() persist the result so later runs on
+ * the same catalog skip the calibration.
+ */
+class NFPBackendSelector {
+public:
+    static constexpr int BACKEND_COUNT = 5;
+    static constexpr int PAIR_CLASS_COUNT = 3;
+
+    /**
+     * @brief Cost model of one backend on one pair class
+     */
+    struct CostModel {
+        bool enabled;    // Known to give correct NFPs for the class
+        double fixed;    // Seconds per call
+        double perUnit;  // Seconds per size unit
+    };
+
+    /**
+     * @brief Computes an outer NFP with the given backend (empty on failure)
+     */
+    using ComputeFunction = std::function<Polygon(NFPBackend, const Polygon&, const Polygon&)>;
+
+    /**
+     * @brief Constructor (default cost models)
+     */
+    NFPBackendSelector();
+
+    /**
+     * @brief Classify an outer NFP pair (A stationary, B orbiting)
+     */
+    static NFPPairClass classify(const Polygon& A, const Polygon& B);
+
+    /**
+     * @brief Whether a backend handles the pair class at all
+     *
+     * Only the Boost convolution handles holes in A.
+     */
+    static bool supports(NFPBackend backend, NFPPairClass pairClass);
+
+    /**
+     * @brief Backend whose result defines correctness for the class
+     *
+     * ClipperMinkowski for hole-free pairs, BoostConvolution otherwise.
+     * It is always enabled and is the fallback when another backend fails.
+     */
+    static NFPBackend reference(NFPPairClass pairClass);
+
+    /**
+     * @brief Size term of the cost model for a pair
+     */
+    static double pairSize(NFPBackend backend, const Polygon& A, const Polygon& B);
+
+    /**
+     * @brief Cheapest enabled backend for the pair
+     */
+    NFPBackend select(const Polygon& A, const Polygon& B) const;
+
+    /**
+     * @brief Estimated seconds for computing the pair with a backend
+     */
+    double estimate(NFPBackend backend, const Polygon& A, const Polygon& B) const;
+
+    const CostModel& model(NFPBackend backend, NFPPairClass pairClass) const;
+    void setModel(NFPBackend backend, NFPPairClass pairClass, const CostModel& model);
+
+    /**
+     * @brief Benchmark the backends on pairs drawn from the given parts
+     *
+     * Parts with the same fingerprint are sampled once. For every sampled
+     * pair each supporting backend is timed and its NFP compared with the
+     * reference backend's (area and bounds); a backend that disagrees or
+     * throws on any pair is disabled for that class. The remaining models
+     * are fitted by least squares.
+     *
+     * @param parts Prepared parts (convexity and fingerprints set)
+     * @param compute Runs one backend on one pair
+     * @param maxPairsPerClass Cap on sampled pairs per class
+     */
+    void calibrate(const std::vector<Polygon>& parts, const ComputeFunction& compute,
+                   size_t maxPairsPerClass = 16);
+
+    /**
+     * @brief Load cost models from a JSON profile written by save()
+     * @return True if the file was read
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Write the cost models as a JSON profile
+     * @return True on success
+     */
+    bool save(const std::string& path) const;
+
+    static const char* backendName(NFPBackend backend);
+    static const char* pairClassName(NFPPairClass pairClass);
+
+private:
+    std::array<std::array<CostModel, BACKEND_COUNT>, PAIR_CLASS_COUNT> models_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_NFP_BACKEND_SELECTOR_H
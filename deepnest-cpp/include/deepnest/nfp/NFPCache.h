@@ -2,11 +2,17 @@
 #define DEEPNEST_NFPCACHE_H
 
 #include "../core/Polygon.h"
+#include "../parallel/ContentionStats.h"
 #include <boost/thread/shared_mutex.hpp>
 #include <boost/thread/locks.hpp>
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <cstdint>
 
 namespace deepnest {
 
@@ -17,30 +23,79 @@ namespace deepnest {
  * computations. Since NFP calculation is expensive, caching can
  * significantly improve performance.
  *
+ * The cache is split into NUM_SHARDS independent shards, each guarded by
+ * its own shared_mutex. A key is routed to a shard by its NFPKeyHash, so
+ * concurrent placement threads only contend when they touch the same shard,
+ * and lookups only ever take a shared (reader) lock. Hit/miss statistics are
+ * kept in atomics so the read path never needs exclusive access.
+ *
+ * An optional memory limit bounds the resident size. When a shard exceeds
+ * its share of the budget, entries are evicted using GreedyDual-Size: each
+ * entry's priority is its recompute cost per byte plus the shard's current
+ * inflation value, refreshed on every hit, so cheap-to-recompute bulky
+ * NFPs go first and recently used expensive ones stay.
+ *
+ * With compact storage (setCompactStorage) an entry is one byte block
+ * instead of Polygon objects: its rings quantized to the Clipper grid,
+ * zigzag varint delta-encoded after a ring index (point count, parent
+ * ring, convexity), typically 2-4 bytes per vertex instead of the point,
+ * Clipper path and coordinate buffer a prepared NFP carries. Lookups
+ * decode the block; while a decoded copy is still held by some caller,
+ * later hits share it instead of decoding again.
+ *
+ * A pair whose NFP could not be computed, or has no regions, is cached as
+ * a tombstone (an empty entry), so later requests for it cost one lookup
+ * instead of the same failed computation.
+ *
  * Based on window.db object from background.js
  */
 class NFPCache {
 public:
+    /**
+     * @brief Rotation key resolution (steps per degree)
+     *
+     * Rotations are multiples of 360/config.rotations plus the same steps
+     * tried by PlacementWorker, so a millidegree grid maps every rotation
+     * in use to a distinct small integer.
+     */
+    static constexpr int ROTATION_KEY_STEPS_PER_DEGREE = 1000;
+
+    /**
+     * @brief Convert a rotation in degrees to its integer cache key
+     *
+     * Normalized to [0, 360) so that e.g. -90 and 270 share a key.
+     */
+    static int32_t rotationKey(double degrees) {
+        const int64_t fullTurn = 360 * ROTATION_KEY_STEPS_PER_DEGREE;
+        int64_t key = std::llround(degrees * ROTATION_KEY_STEPS_PER_DEGREE) % fullTurn;
+        return static_cast<int32_t>(key < 0 ? key + fullTurn : key);
+    }
+
     /**
      * @brief Cache key for NFP lookup
+     *
+     * Plain integers only, so hashing and equality are exact and agree:
+     * keys that compare equal always land in the same bucket.
      */
     struct NFPKey {
-        int idA;           // Source ID of polygon A
-        int idB;           // Source ID of polygon B
-        double rotationA;  // Rotation of polygon A
-        double rotationB;  // Rotation of polygon B
-        bool inside;       // Whether B is inside A or outside
+        uint64_t idA;       // Shape key of polygon A (see NFPCalculator::shapeKey)
+        uint64_t idB;       // Shape key of polygon B
+        int32_t rotationA;  // Rotation key of polygon A (see rotationKey)
+        int32_t rotationB;  // Rotation key of polygon B
+        bool inside;        // Whether B is inside A or outside
 
-        NFPKey() : idA(-1), idB(-1), rotationA(0.0), rotationB(0.0), inside(false) {}
+        NFPKey() : idA(static_cast<uint64_t>(-1)), idB(static_cast<uint64_t>(-1)),
+                   rotationA(0), rotationB(0), inside(false) {}
 
-        NFPKey(int a, int b, double rotA, double rotB, bool ins = false)
-            : idA(a), idB(b), rotationA(rotA), rotationB(rotB), inside(ins) {}
+        NFPKey(uint64_t a, uint64_t b, double rotA, double rotB, bool ins = false)
+            : idA(a), idB(b), rotationA(rotationKey(rotA)), rotationB(rotationKey(rotB)),
+              inside(ins) {}
 
         bool operator==(const NFPKey& other) const {
             return idA == other.idA &&
                    idB == other.idB &&
-                   Point::almostEqual(rotationA, other.rotationA) &&
-                   Point::almostEqual(rotationB, other.rotationB) &&
+                   rotationA == other.rotationA &&
+                   rotationB == other.rotationB &&
                    inside == other.inside;
         }
 
@@ -59,31 +114,164 @@ public:
                 seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
             };
 
-            hash_combine(seed, std::hash<int>{}(key.idA));
-            hash_combine(seed, std::hash<int>{}(key.idB));
-
-            // Normalize rotations to avoid floating point precision issues
-            // Use same precision as in equality check (Point::almostEqual uses epsilon)
-            // Here we map to integer for stable hashing
-            int rotA = static_cast<int>(key.rotationA * 1000000.0);
-            int rotB = static_cast<int>(key.rotationB * 1000000.0);
-            hash_combine(seed, std::hash<int>{}(rotA));
-            hash_combine(seed, std::hash<int>{}(rotB));
+            hash_combine(seed, std::hash<uint64_t>{}(key.idA));
+            hash_combine(seed, std::hash<uint64_t>{}(key.idB));
 
-            hash_combine(seed, std::hash<bool>{}(key.inside));
+            // Both rotation keys fit in 20 bits; pack them with the flag
+            uint64_t rotations = (static_cast<uint64_t>(static_cast<uint32_t>(key.rotationA)) << 21) ^
+                                 (static_cast<uint64_t>(static_cast<uint32_t>(key.rotationB)) << 1) ^
+                                 (key.inside ? 1u : 0u);
+            hash_combine(seed, std::hash<uint64_t>{}(rotations));
 
             return seed;
         }
     };
 
+    /**
+     * @brief Shared, immutable handle to a cached NFP
+     *
+     * Entries are stored behind a refcounted pointer so that lookups can
+     * hand out the cached polygons without deep-copying points and holes.
+     * The pointee is never modified after insertion.
+     */
+    using NFPHandle = std::shared_ptr<const std::vector<Polygon>>;
+
+    /**
+     * @brief Entry recording that a pair has no NFP (shared, empty)
+     */
+    static NFPHandle tombstone();
+
+    /**
+     * @brief Whether a looked-up entry is a tombstone
+     */
+    static bool isTombstone(const NFPHandle& nfp) { return nfp && nfp->empty(); }
+
+    /**
+     * @brief Number of lock stripes (must be a power of two)
+     */
+    static constexpr std::size_t NUM_SHARDS = 64;
+
+    /**
+     * @brief Snapshot of cache counters
+     */
+    struct Statistics {
+        size_t hits;           // Successful lookups
+        size_t misses;         // Failed lookups
+        size_t entries;        // Number of cached NFPs
+        size_t residentBytes;  // Estimated memory held by cached NFPs
+        size_t evictions;      // Entries dropped to honor the memory limit
+        size_t memoryLimit;    // Configured byte budget (0 = unlimited)
+
+        Statistics()
+            : hits(0), misses(0), entries(0), residentBytes(0),
+              evictions(0), memoryLimit(0) {}
+    };
+
 private:
+    /**
+     * @brief Cached NFP together with its eviction bookkeeping
+     */
+    struct Entry {
+        NFPHandle nfp;                         // Null for compact entries
+        std::vector<uint8_t> packed;           // Compact form (see encodeCompact)
+        size_t bytes;                          // Estimated footprint
+        double costPerByte;                    // Recompute cost / bytes
+        mutable std::atomic<double> priority;  // GreedyDual-Size H value
+
+        // Last decoded copy of a compact entry, guarded by decodedLock
+        mutable std::weak_ptr<const std::vector<Polygon>> decoded;
+        mutable std::atomic_flag decodedLock = ATOMIC_FLAG_INIT;
+
+        Entry() : bytes(0), costPerByte(0.0), priority(0.0) {}
+    };
+
+    /**
+     * @brief What insertLocked() stores for one NFP
+     *
+     * Built before the shard lock is taken.
+     */
+    struct Stored {
+        NFPHandle nfp;                // Kept as is unless compact
+        std::vector<uint8_t> packed;  // Compact form, if compact storage is on
+        size_t bytes;
+    };
+
+    /**
+     * @brief One lock stripe of the cache
+     *
+     * Aligned to a cache line so neighbouring shard mutexes do not
+     * false-share when different threads lock them.
+     */
+    struct alignas(64) Shard {
+        mutable boost::shared_mutex mutex;
+        std::unordered_map<NFPKey, Entry, NFPKeyHash> entries;
+        size_t residentBytes = 0;             // Guarded by mutex
+        std::atomic<double> inflation{0.0};   // GreedyDual-Size L value
+    };
+
     // Thread-safe cache storage
-    mutable boost::shared_mutex mutex_;
-    std::unordered_map<NFPKey, std::vector<Polygon>, NFPKeyHash> cache_;
+    std::array<Shard, NUM_SHARDS> shards_;
+
+    // Statistics (atomic so lookups only need a shared lock)
+    mutable std::atomic<size_t> hits_;
+    mutable std::atomic<size_t> misses_;
+    std::atomic<size_t> evictions_;
+    std::atomic<size_t> residentBytes_;
+
+    // Byte budget across all shards (0 = unlimited)
+    std::atomic<size_t> memoryLimit_;
+
+    // Grid of compact entries (0 = entries kept as polygons)
+    std::atomic<double> compactScale_;
+
+    // Shard lock counters, all shards together (see LockStats::enabled())
+    mutable LockStats sharedLockStats_;
+    mutable LockStats exclusiveLockStats_;
+
+    /**
+     * @brief Select the shard responsible for a key
+     */
+    Shard& shardFor(const NFPKey& key) {
+        return shards_[shardIndex(key)];
+    }
+
+    const Shard& shardFor(const NFPKey& key) const {
+        return shards_[shardIndex(key)];
+    }
+
+    /**
+     * @brief Evict lowest-priority entries until the shard fits its budget
+     *
+     * Must be called with the shard's unique lock held.
+     */
+    void evictFromShard(Shard& shard, size_t shardBudget);
+
+    /**
+     * @brief Store an entry in its shard
+     *
+     * Must be called with the shard's unique lock held; eviction is left
+     * to the caller.
+     */
+    void insertLocked(Shard& shard, const NFPKey& key, Stored stored, double costPerByte);
 
-    // Statistics
-    mutable size_t hits_;
-    mutable size_t misses_;
+    /**
+     * @brief Encode or keep an NFP for storage, per the storage mode
+     */
+    Stored prepare(NFPHandle nfp) const;
+
+    /**
+     * @brief The entry's NFP, decoded if it is compact
+     *
+     * Must be called with the shard's lock held (shared is enough).
+     */
+    static NFPHandle handleOf(const Entry& entry, double compactScale);
+
+    /**
+     * @brief Index of the shard responsible for a key
+     */
+    static size_t shardIndex(const NFPKey& key) {
+        return NFPKeyHash{}(key) & (NUM_SHARDS - 1);
+    }
 
 public:
     /**
@@ -108,6 +296,14 @@ public:
      */
     bool find(const NFPKey& key, std::vector<Polygon>& result) const;
 
+    /**
+     * @brief Find NFP in cache without copying it
+     *
+     * @param key Cache key
+     * @return Shared handle to the cached NFP, or nullptr if not found
+     */
+    NFPHandle lookup(const NFPKey& key) const;
+
     /**
      * @brief Insert NFP into cache
      *
@@ -116,6 +312,112 @@ public:
      */
     void insert(const NFPKey& key, const std::vector<Polygon>& nfp);
 
+    /**
+     * @brief Insert an already shared NFP into cache
+     *
+     * @param key Cache key
+     * @param nfp Shared handle to the NFP polygons (ignored if null)
+     * @param cost Estimated recompute cost (e.g. vertex count product of
+     *        A and B); 0 means use the entry size
+     */
+    void insert(const NFPKey& key, NFPHandle nfp, double cost = 0.0);
+
+    /**
+     * @brief One entry of a bulk insert
+     */
+    struct BatchEntry {
+        NFPKey key;
+        NFPHandle nfp;
+        double cost;  // As for insert(); 0 means use the entry size
+    };
+
+    /**
+     * @brief Find several NFPs, locking each shard once
+     *
+     * @param keys Cache keys
+     * @return Handle per key (nullptr for misses), in key order
+     */
+    std::vector<NFPHandle> lookupBatch(const std::vector<NFPKey>& keys) const;
+
+    /**
+     * @brief Insert several NFPs, locking each shard once
+     *
+     * Same result as calling insert() for each entry in order.
+     *
+     * @param entries Entries to insert (null handles are skipped)
+     */
+    void insertBatch(const std::vector<BatchEntry>& entries);
+
+    /**
+     * @brief Set the memory budget for cached NFPs
+     *
+     * Entries are evicted on insertion once a shard exceeds its
+     * share of the budget.
+     *
+     * @param bytes Byte budget (0 = unlimited)
+     */
+    void setMemoryLimit(size_t bytes);
+
+    /**
+     * @brief Store entries inserted from now on in compact form
+     *
+     * Coordinates are rounded to multiples of 1/scale; pass the Clipper
+     * scale, so the integer rings are exactly the Clipper paths the
+     * entries carry and decoding rebuilds them without loss. Points move
+     * by at most 1/scale (not at all in integer geometry mode, where
+     * cached NFPs are already on that grid). Switching mode clears the
+     * cache.
+     *
+     * @param scale Grid scale, 0 to keep entries as polygons
+     */
+    void setCompactStorage(double scale);
+
+    /**
+     * @brief Grid scale of compact storage (0 = off)
+     */
+    double compactScale() const { return compactScale_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Encode NFP polygons to the compact form
+     *
+     * Holes of any depth are kept; all other Polygon fields except
+     * convexity are dropped, since an NFP does not use them.
+     */
+    static std::vector<uint8_t> encodeCompact(const std::vector<Polygon>& nfp, double scale);
+
+    /**
+     * @brief Decode the compact form
+     *
+     * The polygons get their Clipper path at this scale and their
+     * coordinate buffer, as NFPCalculator prepares cached NFPs.
+     */
+    static std::vector<Polygon> decodeCompact(const uint8_t* data, size_t size, double scale);
+
+    /**
+     * @brief Get the memory budget (0 = unlimited)
+     */
+    size_t memoryLimit() const { return memoryLimit_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get estimated bytes held by cached NFPs
+     */
+    size_t residentBytes() const { return residentBytes_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get number of entries evicted to honor the memory limit
+     */
+    size_t evictionCount() const { return evictions_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get a snapshot of all cache counters
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief Estimate the heap footprint of an NFP entry
+     */
+    static size_t estimateBytes(const std::vector<Polygon>& nfp);
+
     /**
      * @brief Clear the entire cache
      */
@@ -129,19 +431,20 @@ public:
     /**
      * @brief Get cache hit count
      */
-    size_t hitCount() const { return hits_; }
+    size_t hitCount() const { return hits_.load(std::memory_order_relaxed); }
 
     /**
      * @brief Get cache miss count
      */
-    size_t missCount() const { return misses_; }
+    size_t missCount() const { return misses_.load(std::memory_order_relaxed); }
 
     /**
      * @brief Get cache hit rate
      */
     double hitRate() const {
-        size_t total = hits_ + misses_;
-        return total > 0 ? static_cast<double>(hits_) / total : 0.0;
+        size_t hits = hitCount();
+        size_t total = hits + missCount();
+        return total > 0 ? static_cast<double>(hits) / total : 0.0;
     }
 
     /**
@@ -149,32 +452,68 @@ public:
      */
     void resetStatistics();
 
+    /**
+     * @brief Shard lock counters of readers (lookups) and writers
+     *        (inserts, eviction, clear), while LockStats::enabled()
+     */
+    LockStats::Snapshot sharedLockStats() const { return sharedLockStats_.snapshot(); }
+    LockStats::Snapshot exclusiveLockStats() const { return exclusiveLockStats_.snapshot(); }
+
+    /**
+     * @brief What the lookups of one thread saw (see setCapture())
+     *
+     * Holds the handle of every key first found in the cache, and nullptr
+     * for a key first missed: the thread computed or waited for that NFP,
+     * so later hits on it were not cached for it.
+     */
+    struct Capture {
+        std::unordered_map<NFPKey, NFPHandle, NFPKeyHash> entries;
+    };
+
+    /**
+     * @brief Record the calling thread's lookups of every cache
+     *
+     * Lookups made for it on other threads are not seen.
+     *
+     * @param capture Receives the lookups, or nullptr to stop
+     */
+    static void setCapture(Capture* capture) { capture_ = capture; }
+
     // ========== Convenience methods ==========
 
     /**
      * @brief Check if cache contains entry (using parameters)
      */
-    bool has(int idA, int idB, double rotA, double rotB, bool inside = false) const {
+    bool has(uint64_t idA, uint64_t idB, double rotA, double rotB, bool inside = false) const {
         return has(NFPKey(idA, idB, rotA, rotB, inside));
     }
 
     /**
      * @brief Find NFP in cache (using parameters)
      */
-    bool find(int idA, int idB, double rotA, double rotB,
+    bool find(uint64_t idA, uint64_t idB, double rotA, double rotB,
               std::vector<Polygon>& result, bool inside = false) const {
         return find(NFPKey(idA, idB, rotA, rotB, inside), result);
     }
 
+    /**
+     * @brief Find NFP in cache without copying it (using parameters)
+     */
+    NFPHandle lookup(uint64_t idA, uint64_t idB, double rotA, double rotB, bool inside = false) const {
+        return lookup(NFPKey(idA, idB, rotA, rotB, inside));
+    }
+
     /**
      * @brief Insert NFP into cache (using parameters)
      */
-    void insert(int idA, int idB, double rotA, double rotB,
+    void insert(uint64_t idA, uint64_t idB, double rotA, double rotB,
                 const std::vector<Polygon>& nfp, bool inside = false) {
         insert(NFPKey(idA, idB, rotA, rotB, inside), nfp);
     }
 
 private:
+    static thread_local Capture* capture_;
+
     /**
      * @brief Generate string key from NFPKey
      */
@@ -3,12 +3,36 @@
 
 #include "../core/Polygon.h"
 #include "../config/DeepNestConfig.h"
+#include "../geometry/GeometryUtil.h"
+#include "../parallel/CancellationToken.h"
+#include "NFPAccelerator.h"
+#include "NFPBackendSelector.h"
 #include "NFPCache.h"
+#include "HoleIndex.h"
+#include "PersistentNFPStore.h"
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
 namespace deepnest {
 
+/**
+ * @brief One NFP of a batch (see NFPCalculator::computeBatch)
+ *
+ * A and B are used as given: they must already be rotated and carry the
+ * rotation, id and source placement will look them up with.
+ */
+struct NFPRequest {
+    std::shared_ptr<const Polygon> A;  // Stationary polygon (sheet when inner)
+    std::shared_ptr<const Polygon> B;  // Moving polygon
+    bool inner;                        // true = getInnerNFP, false = outer NFP
+};
+
 /**
  * @brief High-level NFP (No-Fit Polygon) calculator
  *
@@ -23,14 +47,151 @@ class NFPCalculator {
 private:
     NFPCache& cache_;
 
+    /**
+     * @brief Optional on-disk store consulted on cache misses
+     */
+    std::shared_ptr<PersistentNFPStore> store_;
+
+    /**
+     * @brief NFPs currently being computed, keyed like the cache
+     *
+     * Concurrent misses on the same key wait on the first computation's
+     * future instead of running the Minkowski sum again.
+     */
+    std::unordered_map<NFPCache::NFPKey, std::shared_future<NFPCache::NFPHandle>, NFPCache::NFPKeyHash> inFlight_;
+    boost::mutex inFlightMutex_;
+
+    /**
+     * @brief Clipper settings of the configuration given at construction
+     */
+    double clipperScale_;
+    bool integerGeometry_;
+
+    /**
+     * @brief Cache outer NFPs in A's unrotated frame (see setRotationEquivariant)
+     */
+    bool rotationEquivariant_;
+
+    /**
+     * @brief config.exploreConcave: concave stationary parts get orbital
+     *        NFPs with their pockets (see backendFor)
+     */
+    bool exploreConcave_;
+
+    /**
+     * @brief Runs the loop traces of those NFPs (see setParallelFor)
+     */
+    GeometryUtil::ParallelFor parallelFor_;
+
+    /**
+     * @brief Chooses the engine for each outer NFP computed on a miss
+     */
+    NFPBackendSelector backends_;
+
+    /**
+     * @brief Device convolving the Clipper Minkowski sums of computeBatch, if any
+     */
+    std::shared_ptr<NFPAccelerator> accelerator_;
+
+    std::atomic<size_t> computations_;
+    std::atomic<size_t> deduplicated_;
+    std::atomic<size_t> mirrored_;
+    std::atomic<size_t> holesSkipped_;
+    std::atomic<size_t> accelerated_;
+    std::atomic<size_t> negative_;
+
+    /**
+     * @brief Hole index per stationary shape and rotation, built on first use
+     */
+    std::map<std::pair<uint64_t, double>, std::shared_ptr<const HoleIndex>> holeIndexes_;
+    boost::mutex holeIndexMutex_;
+
+    /**
+     * @brief Hole index of A at its current rotation (A must have holes)
+     */
+    std::shared_ptr<const HoleIndex> holeIndex(const Polygon& A);
+
+    /**
+     * @brief Run compute() once per key across concurrent callers
+     *
+     * The first caller for a key runs compute(); callers arriving while it
+     * runs block on its result. compute() must insert into the cache before
+     * returning so that later callers hit the cache instead. If a cancelled
+     * computeBatch() gives up a key it claimed, its waiters claim it again.
+     *
+     * @param key Cache key of the NFP being computed
+     * @param compute Computes (and caches) the NFP
+     * @return Result of the single computation
+     */
+    NFPCache::NFPHandle computeOnce(const NFPCache::NFPKey& key,
+                                    const std::function<NFPCache::NFPHandle()>& compute);
+
+    /**
+     * @brief Build the persistent store key for an NFP request
+     */
+    static PersistentNFPStore::Key storeKey(const Polygon& A, const Polygon& B,
+                                            double rotationA, bool inside);
+
+    /**
+     * @brief Cache-miss path of getOuterNFPShared (store lookup, compute, cache insert)
+     */
+    NFPCache::NFPHandle computeOuterNFP(const Polygon& A, const Polygon& B, bool inside);
+
+    /**
+     * @brief Outer NFP for a rotated A in rotation-equivariant mode
+     *
+     * Looks up (or computes) the NFP in A's unrotated frame and returns a
+     * copy rotated by A.rotation.
+     */
+    NFPCache::NFPHandle getRotatedOuterNFP(const Polygon& A, const Polygon& B);
+
+    /**
+     * @brief Derive the outer NFP of B around A from a cached NFP(B, A)
+     *
+     * The outer NFP is point-symmetric: NFP(A,B) = -NFP(B,A) + A[0] + B[0].
+     * Only used when neither polygon has holes.
+     *
+     * @return Reflected copy, or nullptr if the mirrored pair is not cached
+     */
+    NFPCache::NFPHandle getMirroredOuterNFP(const Polygon& A, const Polygon& B);
+
+    /**
+     * @brief computeOuterNFP() without the cache insert
+     *
+     * @param convolved Quadrilaterals of A + (-B) from the accelerator,
+     *                  used if the pair goes through the Clipper backend
+     */
+    NFPCache::NFPHandle computeOuterEntry(const Polygon& A, const Polygon& B, bool inside,
+                                          const Clipper2Lib::Paths64* convolved = nullptr);
+
+    /**
+     * @brief Cache-miss path of getInnerNFPShared (store lookup, compute, cache insert)
+     */
+    NFPCache::NFPHandle computeInnerNFP(const Polygon& A, const Polygon& B);
+
     /**
      * @brief Compute NFP without cache lookup
      * @param A Stationary polygon
      * @param B Moving polygon
-     * @param inside If true, compute inner NFP; if false, compute outer NFP
+     * @param convolved Quadrilaterals of A + (-B) to union instead of
+     *                  running Clipper2's MinkowskiSum (see NFPAccelerator)
      * @return Computed NFP polygon
      */
-    Polygon computeDiffNFP(const Polygon& A, const Polygon& B) const;
+    Polygon computeDiffNFP(const Polygon& A, const Polygon& B,
+                           const Clipper2Lib::Paths64* convolved = nullptr) const;
+
+    /**
+     * @brief Compute outer NFP of two convex polygons
+     *
+     * Same result as computeDiffNFP() (A + (-B), translated by B[0]) but by
+     * linear edge merging instead of Clipper2's quadrilateral union.
+     * Requires A.convex, B.convex and no holes in A.
+     *
+     * @param A Stationary convex polygon
+     * @param B Moving convex polygon
+     * @return Computed NFP polygon
+     */
+    Polygon computeConvexNFP(const Polygon& A, const Polygon& B) const;
     /**
      * @brief Compute NFP 
      *
@@ -53,11 +214,19 @@ private:
 
 public:
     /**
-     * @brief Constructor
+     * @brief Constructor, with the settings of DeepNestConfig's global instance
      * @param cache Reference to NFP cache for storing/retrieving results
      */
     explicit NFPCalculator(NFPCache& cache);
 
+    /**
+     * @brief Constructor
+     * @param cache Reference to NFP cache for storing/retrieving results
+     * @param config Configuration whose clipperScale and integerGeometry
+     *               the calculator keeps (read once, here)
+     */
+    NFPCalculator(NFPCache& cache, const DeepNestConfig& config);
+
     /**
      * @brief Calculate outer NFP between two polygons
      *
@@ -73,6 +242,19 @@ public:
      */
     Polygon getOuterNFP(const Polygon& A, const Polygon& B, bool inside = false);
 
+    /**
+     * @brief Calculate outer NFP without copying the cached result
+     *
+     * Same as getOuterNFP(), but returns the shared immutable cache entry
+     * (a single-element vector) so hot callers avoid deep copies.
+     *
+     * @param A Stationary polygon
+     * @param B Moving polygon
+     * @param inside If true, B orbits inside A; if false, B orbits outside A
+     * @return Shared NFP entry, or nullptr if calculation fails
+     */
+    NFPCache::NFPHandle getOuterNFPShared(const Polygon& A, const Polygon& B, bool inside = false);
+
     /**
      * @brief Calculate inner NFP for placing B inside A
      *
@@ -87,6 +269,37 @@ public:
      */
     std::vector<Polygon> getInnerNFP(const Polygon& A, const Polygon& B);
 
+    /**
+     * @brief Calculate inner NFP without copying the cached result
+     *
+     * @param A Container polygon (stationary)
+     * @param B Polygon to be placed inside A
+     * @return Shared inner NFP regions, or nullptr if none
+     */
+    NFPCache::NFPHandle getInnerNFPShared(const Polygon& A, const Polygon& B);
+
+    /**
+     * @brief Compute many NFPs in one call
+     *
+     * Outer requests are looked up in the cache in bulk. Misses are claimed
+     * for single-flight under one lock, computed grouped by A (A's Clipper
+     * path is built once per group) and inserted into the cache in bulk.
+     * Inner requests and rotated requests in equivariant mode go through
+     * getInnerNFPShared()/getOuterNFPShared(). Failures are logged and
+     * leave a nullptr result. Runs on the calling thread; see
+     * ParallelProcessor::prefetchNFPs for spreading batches over the pool.
+     * With an accelerator, the Clipper Minkowski sums of each group are
+     * convolved on the device in one call and unioned here.
+     *
+     * @param requests Pairs to compute
+     * @param token Checked before each computation; claimed pairs not
+     *              computed yet are released for other callers
+     * @return One handle per request (nullptr if it failed), in request order
+     * @throws OperationCancelled once token is cancelled
+     */
+    std::vector<NFPCache::NFPHandle> computeBatch(const std::vector<NFPRequest>& requests,
+                                                  const CancellationToken& token = CancellationToken());
+
     /**
      * @brief Get the rectangular frame for a polygon
      *
@@ -100,6 +313,113 @@ public:
      */
     Polygon getFrame(const Polygon& A) const;
 
+    /**
+     * @brief Cache key identifying a polygon's shape
+     *
+     * Uses the geometry fingerprint when available, so identical shapes
+     * share cached NFPs regardless of id; otherwise falls back to the id.
+     *
+     * @param polygon The polygon
+     * @param fallbackId Id to use when no fingerprint has been computed
+     */
+    static uint64_t shapeKey(const Polygon& polygon, int fallbackId);
+
+    /**
+     * @brief Cache key the outer NFP of A (at rotA) and B (at rotB) is stored under
+     *
+     * In rotation-equivariant mode the key is (0, rotB - rotA).
+     *
+     * @param A Stationary polygon
+     * @param B Moving polygon
+     * @param rotA Rotation of A in degrees
+     * @param rotB Rotation of B in degrees
+     */
+    NFPCache::NFPKey outerKey(const Polygon& A, const Polygon& B, double rotA, double rotB) const;
+
+    /**
+     * @brief Enable the rotation-equivariant outer NFP cache mode
+     *
+     * Outer NFPs are computed with A rotated back to 0 and cached by the
+     * relative rotation of B; requests for other orientations rotate the
+     * cached NFP around the origin on read.
+     *
+     * @param enabled True to enable
+     */
+    void setRotationEquivariant(bool enabled);
+
+    /**
+     * @brief Attach a persistent NFP store shared across runs
+     *
+     * Cache misses are looked up in the store before computing, and newly
+     * computed NFPs are appended to it.
+     *
+     * @param store Opened store, or nullptr to detach
+     */
+    void setPersistentStore(std::shared_ptr<PersistentNFPStore> store);
+
+    /**
+     * @brief Set the cost models used to pick the outer NFP backend
+     *
+     * Not synchronized with NFP computation; set it before nesting starts.
+     */
+    void setBackendSelector(const NFPBackendSelector& selector);
+
+    /**
+     * @brief Cost models used to pick the outer NFP backend
+     */
+    const NFPBackendSelector& backendSelector() const { return backends_; }
+
+    /**
+     * @brief Set the device computeBatch convolves Minkowski sums on
+     *
+     * The constructor attaches NFPAccelerator::detect() when the
+     * configuration's nfpAcceleration is set. Not synchronized with NFP
+     * computation; set it before nesting starts.
+     *
+     * @param accelerator Device, or nullptr to compute on the CPU only
+     */
+    void setAccelerator(std::shared_ptr<NFPAccelerator> accelerator);
+
+    /**
+     * @brief Device computeBatch convolves on, or nullptr
+     */
+    const std::shared_ptr<NFPAccelerator>& accelerator() const { return accelerator_; }
+
+    /**
+     * @brief Set how the loops of an orbital NFP are traced concurrently
+     *
+     * With config.exploreConcave, the loops after the first are traced as
+     * subtasks of this (e.g. ParallelProcessor::parallelFor, which may be
+     * called from a pool task); unset, they are traced one after another.
+     * Not synchronized with NFP computation; set it before nesting starts.
+     */
+    void setParallelFor(GeometryUtil::ParallelFor parallelFor);
+
+    /**
+     * @brief Compute an outer NFP with a specific backend, bypassing the cache
+     *
+     * All backends return the NFP of B's reference point B[0] with the
+     * Clipper orientation. Used for calibration and comparison. With
+     * config.exploreConcave, the orbital backend traces every loop: the
+     * largest is the NFP, the others are its children, oriented the other
+     * way, the pockets of A that B fits in.
+     *
+     * @param backend Engine to use (must support the pair's class)
+     * @param A Stationary polygon
+     * @param B Moving polygon
+     * @return NFP polygon (empty if the backend failed)
+     */
+    Polygon computeWithBackend(NFPBackend backend, const Polygon& A, const Polygon& B) const;
+
+    /**
+     * @brief Engine for an outer NFP of hole-free A computed on a miss
+     *
+     * The selector's choice, except that with config.exploreConcave a
+     * concave A takes the orbital backend, the only one that keeps the
+     * pockets B fits in.
+     */
+    NFPBackend backendFor(const Polygon& A, const Polygon& B) const;
+
     /**
      * @brief Clear the NFP cache
      *
@@ -109,9 +429,26 @@ public:
 
     /**
      * @brief Get cache statistics
-     * @return Tuple of (hits, misses, size)
+     * @return Hits, misses, entry count, resident bytes, evictions and memory limit
+     */
+    NFPCache::Statistics getCacheStats() const;
+
+    /**
+     * @brief Counters for NFP computations on cache misses
+     */
+    struct ComputeStatistics {
+        size_t computed;      // Misses that ran (or loaded from the store) themselves
+        size_t deduplicated;  // Misses that waited on an in-flight computation
+        size_t mirrored;      // Misses answered by reflecting the cached NFP(B,A)
+        size_t holesSkipped;  // Holes left out of NFPs because B cannot fit in them
+        size_t accelerated;   // Misses convolved on the accelerator
+        size_t negative;      // Requests answered by a cached failure (tombstone)
+    };
+
+    /**
+     * @brief Get computation deduplication counters
      */
-    std::tuple<size_t, size_t, size_t> getCacheStats() const;
+    ComputeStatistics getComputeStats() const;
 };
 
 } // namespace deepnest
@@ -0,0 +1,203 @@
+#ifndef DEEPNEST_PERSISTENT_NFP_STORE_H
+#define DEEPNEST_PERSISTENT_NFP_STORE_H
+
+#include "../core/Polygon.h"
+#include "NFPCache.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief On-disk NFP store shared across nesting runs and processes
+ *
+ * NFPCache only lives as long as one NestingEngine, so every run of the same
+ * part catalog recomputes all Minkowski sums. This store keeps NFPs in an
+ * append-only file keyed by the *geometry* of A and B (not their ids), the
+ * rotation pair, the inside flag and the spacing/curveTolerance they were
+ * computed with.
+ *
+ * On open() the existing file is memory-mapped read-only and indexed; lookups
+ * decode records straight from the mapping, outside the store's lock, so
+ * concurrent lookups do not wait on each other. New NFPs are appended under
+ * an exclusive advisory file lock, so several processes on the same host can
+ * share one store. Each record carries a checksum; a torn tail left by a
+ * crashed writer is truncated on open(). A lookup that misses first indexes
+ * whatever other processes appended since the last scan.
+ *
+ * File layout:
+ *   FileHeader, then repeated { RecordHeader, payload }
+ *   payload = uint32 polygonCount, polygons...
+ *   polygon = uint32 pointCount, pointCount * (double x, double y),
+ *             uint32 childCount, children...
+ */
+class PersistentNFPStore {
+public:
+    /**
+     * @brief Lookup key for a stored NFP
+     */
+    struct Key {
+        uint64_t geometryA;   // Geometry hash of polygon A (as passed to the NFP)
+        uint64_t geometryB;   // Geometry hash of polygon B
+        int32_t rotationA;    // Rotation key (see NFPCache::rotationKey)
+        int32_t rotationB;
+        bool inside;
+
+        Key() : geometryA(0), geometryB(0), rotationA(0), rotationB(0), inside(false) {}
+
+        Key(uint64_t a, uint64_t b, double rotA, double rotB, bool ins)
+            : geometryA(a), geometryB(b),
+              rotationA(NFPCache::rotationKey(rotA)), rotationB(NFPCache::rotationKey(rotB)),
+              inside(ins) {}
+
+        /**
+         * @brief Key of the spacing offset of a polygon's geometry
+         *
+         * Offset outlines (NestingEngine::applySpacing) share the store
+         * with NFPs. Their rotation keys are -1, which no NFP key has;
+         * inside marks a shrinking (sheet) offset.
+         */
+        static Key spacing(uint64_t geometry, bool shrink) {
+            Key key;
+            key.geometryA = geometry;
+            key.rotationA = -1;
+            key.rotationB = -1;
+            key.inside = shrink;
+            return key;
+        }
+
+        bool operator==(const Key& other) const {
+            return geometryA == other.geometryA &&
+                   geometryB == other.geometryB &&
+                   rotationA == other.rotationA &&
+                   rotationB == other.rotationB &&
+                   inside == other.inside;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param spacing Spacing the NFPs are computed with
+     * @param curveTolerance Curve tolerance the NFPs are computed with
+     */
+    PersistentNFPStore(double spacing, double curveTolerance);
+
+    ~PersistentNFPStore();
+
+    PersistentNFPStore(const PersistentNFPStore&) = delete;
+    PersistentNFPStore& operator=(const PersistentNFPStore&) = delete;
+
+    /**
+     * @brief Open (or create) the store file and index existing records
+     *
+     * Only records written with the same spacing/curveTolerance are indexed.
+     *
+     * @param path Store file path
+     * @return True if the store is usable
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Whether open() succeeded
+     */
+    bool isOpen() const { return !path_.empty(); }
+
+    /**
+     * @brief Find a stored NFP
+     *
+     * A key not indexed yet is looked for again after indexing the
+     * records appended to the file since open() or the last miss.
+     *
+     * @param key Store key
+     * @param result Output NFP (decoded from the mapping or the file)
+     * @return True if found
+     */
+    bool find(const Key& key, std::vector<Polygon>& result) const;
+
+    /**
+     * @brief Append an NFP to the store file
+     *
+     * Duplicate keys already indexed are skipped.
+     *
+     * @param key Store key
+     * @param nfp NFP polygons
+     */
+    void append(const Key& key, const std::vector<Polygon>& nfp);
+
+    /**
+     * @brief Number of NFPs available for lookup
+     */
+    size_t size() const;
+
+    /**
+     * @brief Hash polygon geometry (points and holes) for use in Key
+     *
+     * Coordinates are quantized to 1e-6 so that bitwise noise below the
+     * geometry tolerance does not change the hash.
+     */
+    static uint64_t geometryHash(const Polygon& polygon);
+
+private:
+    double spacing_;
+    double curveTolerance_;
+    std::string path_;
+
+    /**
+     * @brief Position of a record payload in the file
+     */
+    struct Location {
+        std::size_t offset;
+        uint32_t bytes;
+    };
+
+    // Read-only view of the file as it was at open()
+    std::unique_ptr<boost::interprocess::file_mapping> mapping_;
+    std::unique_ptr<boost::interprocess::mapped_region> region_;
+
+    // Cross-process lock serializing appends
+    std::unique_ptr<boost::interprocess::file_lock> fileLock_;
+
+    // Key -> payload location (mapped records, our own appends and records
+    // of other processes found by find()); extended by find() on a miss
+    mutable std::unordered_map<Key, Location, KeyHash> index_;
+
+    // File offset up to which records have been scanned
+    mutable std::size_t indexedEnd_;
+
+    // Guards index_ and indexedEnd_; payloads are decoded outside it
+    mutable boost::mutex mutex_;
+
+    /**
+     * @brief Index the valid records in a span of the file
+     *
+     * @param data Bytes of the file starting at offset begin
+     * @param begin File offset of the first record
+     * @param end File offset just past the span
+     * @return Offset just past the last valid record
+     */
+    std::size_t indexRecords(const char* data, std::size_t begin, std::size_t end) const;
+
+    /**
+     * @brief Index the records appended to the file since indexedEnd_
+     *
+     * Called with mutex_ held. A record still being written fails its
+     * checksum and is picked up by a later call.
+     */
+    void indexAppendedRecords() const;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_PERSISTENT_NFP_STORE_H
@@ -0,0 +1,71 @@
+#ifndef DEEPNEST_CANCELLATION_TOKEN_H
+#define DEEPNEST_CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace deepnest {
+
+/**
+ * @brief Thrown by long-running work that noticed its token was cancelled
+ */
+class OperationCancelled : public std::runtime_error {
+public:
+    OperationCancelled() : std::runtime_error("Operation cancelled") {}
+};
+
+/**
+ * @brief Cooperative cancellation flag shared by a group of tasks
+ *
+ * Copies share one flag. Work polls it between steps that are cheap to
+ * abandon (placing one part, computing one NFP) and throws
+ * OperationCancelled, so cancelling bounds the wait for running tasks by
+ * one such step. A default-constructed token is never cancelled and costs
+ * nothing to check.
+ */
+class CancellationToken {
+public:
+    /**
+     * @brief Token that is never cancelled
+     */
+    CancellationToken() = default;
+
+    /**
+     * @brief Token with a flag of its own, not cancelled yet
+     */
+    static CancellationToken create() {
+        CancellationToken token;
+        token.cancelled_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    /**
+     * @brief Cancel every copy of this token
+     */
+    void cancel() const {
+        if (cancelled_) {
+            cancelled_->store(true, std::memory_order_relaxed);
+        }
+    }
+
+    bool isCancelled() const {
+        return cancelled_ && cancelled_->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @throws OperationCancelled if the token was cancelled
+     */
+    void throwIfCancelled() const {
+        if (isCancelled()) {
+            throw OperationCancelled();
+        }
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_CANCELLATION_TOKEN_H
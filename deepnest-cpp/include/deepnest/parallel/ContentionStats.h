@@ -0,0 +1,216 @@
+#ifndef DEEPNEST_CONTENTION_STATS_H
+#define DEEPNEST_CONTENTION_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Latency histogram with power-of-two nanosecond buckets
+ *
+ * Bucket i counts samples in [2^i, 2^(i+1)) ns (bucket 0 also takes 0 ns,
+ * the last bucket everything longer). Counters are relaxed atomics, so
+ * any thread can record; a snapshot taken while threads record may be
+ * off by the samples in flight.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 40;
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        std::array<uint64_t, BUCKETS> buckets{};
+
+        double meanNs() const { return count > 0 ? static_cast<double>(totalNs) / count : 0.0; }
+
+        /**
+         * @brief Upper bound of the bucket holding the p-th quantile (0..1)
+         */
+        uint64_t percentileNs(double p) const;
+    };
+
+    LatencyHistogram();
+
+    /**
+     * @brief Bucket a sample of ns nanoseconds falls into
+     */
+    static size_t bucketOf(uint64_t ns);
+
+    void record(uint64_t ns);
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> totalNs_;
+    std::atomic<uint64_t> maxNs_;
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_;
+};
+
+/**
+ * @brief Acquisition, wait and hold counters of one lock
+ *
+ * Filled by ProfiledLock while profiling is switched on (setEnabled());
+ * otherwise a ProfiledLock is a plain scoped lock behind one relaxed load.
+ */
+class LockStats {
+public:
+    struct Snapshot {
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;           // Acquisitions that had to wait
+        LatencyHistogram::Snapshot wait;  // Time blocked before acquiring
+        LatencyHistogram::Snapshot hold;  // Time between acquire and release
+    };
+
+    LockStats() : acquisitions_(0), contended_(0) {}
+
+    /**
+     * @brief Switch lock, queue and worker profiling on or off, process-wide
+     */
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void recordAcquire(uint64_t waitNs, bool contended);
+    void recordHold(uint64_t holdNs) { hold_.record(holdNs); }
+
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    static std::atomic<bool> enabled_;
+
+    std::atomic<uint64_t> acquisitions_;
+    std::atomic<uint64_t> contended_;
+    LatencyHistogram wait_;
+    LatencyHistogram hold_;
+};
+
+/**
+ * @brief Scoped lock that reports to a LockStats while profiling is on
+ *
+ * An uncontended acquisition (try_lock succeeds) costs one clock read;
+ * a contended one is timed until the lock is granted. Not for locks
+ * handed to a condition variable, whose waits would count as holds.
+ *
+ * @tparam Shared Take the mutex shared (lock_shared) instead of exclusive
+ */
+template<typename Mutex, bool Shared = false>
+class ProfiledLock {
+public:
+    ProfiledLock(Mutex& mutex, LockStats& stats)
+        : mutex_(mutex)
+        , stats_(LockStats::enabled() ? &stats : nullptr)
+        , acquired_(0)
+    {
+        if (!stats_) {
+            lock();
+            return;
+        }
+        const bool contended = !tryLock();
+        const uint64_t begin = contended ? LockStats::now() : 0;
+        if (contended) {
+            lock();
+        }
+        acquired_ = LockStats::now();
+        stats_->recordAcquire(contended ? acquired_ - begin : 0, contended);
+    }
+
+    ~ProfiledLock() {
+        const uint64_t released = stats_ ? LockStats::now() : 0;
+        unlock();
+        if (stats_) {
+            stats_->recordHold(released - acquired_);
+        }
+    }
+
+    ProfiledLock(const ProfiledLock&) = delete;
+    ProfiledLock& operator=(const ProfiledLock&) = delete;
+
+private:
+    void lock() {
+        if constexpr (Shared) mutex_.lock_shared(); else mutex_.lock();
+    }
+    bool tryLock() {
+        if constexpr (Shared) return mutex_.try_lock_shared(); else return mutex_.try_lock();
+    }
+    void unlock() {
+        if constexpr (Shared) mutex_.unlock_shared(); else mutex_.unlock();
+    }
+
+    Mutex& mutex_;
+    LockStats* stats_;  // Null when profiling is off
+    uint64_t acquired_;
+};
+
+/**
+ * @brief Depth of a task queue and the time tasks spend in it
+ */
+class QueueStats {
+public:
+    struct Snapshot {
+        uint64_t depth = 0;               // Tasks queued now
+        uint64_t maxDepth = 0;
+        double meanDepth = 0.0;           // Seen by each submitted task
+        LatencyHistogram::Snapshot wait;  // Submit to start of the task
+    };
+
+    QueueStats() : depth_(0), maxDepth_(0), depthSum_(0), submitted_(0) {}
+
+    void pushed();
+    void started(uint64_t waitNs);
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    std::atomic<int64_t> depth_;
+    std::atomic<uint64_t> maxDepth_;
+    std::atomic<uint64_t> depthSum_;
+    std::atomic<uint64_t> submitted_;
+    LatencyHistogram wait_;
+};
+
+/**
+ * @brief Where the time of a worker thread went since the counters were reset
+ */
+struct WorkerStats {
+    uint64_t tasks = 0;
+    uint64_t busyNs = 0;
+    uint64_t idleNs = 0;  // Elapsed time not spent running tasks
+};
+
+/**
+ * @brief Counters of one ParallelProcessor and the pool it runs on
+ */
+struct ProcessorContention {
+    double seconds = 0.0;               // Covered since the counters were reset
+    LockStats::Snapshot stateMutex;     // mutex_: stopped_ checks
+    LockStats::Snapshot pendingMutex;   // pendingMutex_: every post and completion
+    QueueStats::Snapshot taskQueue;     // Threads' queue (asio or work stealing)
+    std::vector<WorkerStats> workers;   // One per pool thread
+};
+
+/**
+ * @brief Snapshot of every profiled lock and queue of a nest
+ */
+struct ContentionStats {
+    bool enabled = false;                  // Profiling was on (DeepNestConfig::lockProfiling)
+    ProcessorContention processor;
+    LockStats::Snapshot nfpCacheShared;    // NFPCache shard locks taken by readers
+    LockStats::Snapshot nfpCacheExclusive; // NFPCache shard locks taken by writers
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_CONTENTION_STATS_H
@@ -0,0 +1,70 @@
+#ifndef DEEPNEST_CPU_TOPOLOGY_H
+#define DEEPNEST_CPU_TOPOLOGY_H
+
+#include <cstddef>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Where pool worker threads may run
+ *
+ * Both off by default: threads float over all CPUs and share one queue.
+ */
+struct WorkerAffinity {
+    bool pinThreads = false;  // Pin each worker to one CPU
+    bool numaNodes = false;   // Keep workers and their queues on NUMA nodes
+
+    bool operator==(const WorkerAffinity& other) const {
+        return pinThreads == other.pinThreads && numaNodes == other.numaNodes;
+    }
+    bool operator!=(const WorkerAffinity& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief CPUs of the machine grouped by NUMA node, and thread pinning
+ *
+ * Nodes are read from /sys/devices/system/node on Linux. Elsewhere, or if
+ * that fails, all CPUs form a single node. Only CPUs the process may run on
+ * are listed.
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief CPU set assigned to one worker
+     */
+    struct Slot {
+        size_t node;            // Node index, < node count
+        std::vector<int> cpus;  // CPUs to pin to (empty = unpinned)
+    };
+
+    /**
+     * @brief Usable CPUs per NUMA node (at least one node)
+     */
+    static std::vector<std::vector<int>> nodes();
+
+    /**
+     * @brief Spread workers over the nodes and CPUs
+     *
+     * With affinity.numaNodes, worker i goes to node i % nodes and is
+     * restricted to that node's CPUs. With affinity.pinThreads it gets a
+     * single CPU, taken round-robin within its node (or across all CPUs
+     * without numaNodes).
+     *
+     * @param workers Number of worker threads
+     * @param affinity Requested placement
+     * @param nodeCount Receives the number of nodes the workers use
+     *                  (1 without affinity.numaNodes)
+     */
+    static std::vector<Slot> assign(size_t workers, const WorkerAffinity& affinity, size_t& nodeCount);
+
+    /**
+     * @brief Restrict the calling thread to the given CPUs
+     * @return False if not supported on this platform or refused
+     */
+    static bool pinCurrentThread(const std::vector<int>& cpus);
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_CPU_TOPOLOGY_H
@@ -3,37 +3,59 @@
 
 #include "../algorithm/GeneticAlgorithm.h"
 #include "../algorithm/Population.h"
+#include "../placement/FitnessMemo.h"
+#include "../placement/PlacementJob.h"
 #include "../placement/PlacementWorker.h"
+#include "CancellationToken.h"
+#include "ContentionStats.h"
+#include "WorkStealingScheduler.h"
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <future>
 #include <functional>
+#include <string>
 
 namespace deepnest {
 
+class RemoteNode;
+
 /**
  * @brief Structure representing an NFP calculation pair
- * 
- * Matches JavaScript nfpPairs structure from svgnest.js lines 287-310
+ *
+ * Matches JavaScript nfpPairs structure from svgnest.js lines 287-310.
+ * A and B point at the shared (unrotated) part and sheet data instead of
+ * holding copies; they are rotated when the pair is calculated.
  */
 struct NFPPair {
-    Polygon A;           // Stationary polygon
-    Polygon B;           // Moving polygon
+    std::shared_ptr<const Polygon> A;  // Stationary polygon (sheet when inside)
+    std::shared_ptr<const Polygon> B;  // Moving polygon
     bool inside;         // true = inner NFP, false = outer NFP
     double Arotation;    // Rotation of A in degrees
     double Brotation;    // Rotation of B in degrees
-    int Asource;         // Source ID of A
-    int Bsource;         // Source ID of B
+    size_t demand;       // Number of individuals needing this pair
+
+    // A and B already turned by their rotation (PlacementJob variants), or
+    // nullptr to turn them in the NFP task
+    std::shared_ptr<const Polygon> turnedA;
+    std::shared_ptr<const Polygon> turnedB;
+
+    NFPPair() : inside(false), Arotation(0.0), Brotation(0.0), demand(0) {}
 };
 
 /**
  * @brief Parallel processor using Boost.Thread for concurrent placement evaluation
  *
  * This class manages a thread pool for parallel processing of genetic algorithm
- * individuals. It uses boost::asio::io_service as a task queue and boost::thread_group
- * for managing worker threads.
+ * individuals. Tasks run on a WorkStealingScheduler by default; the original
+ * backend, a boost::asio::io_context queue shared by a boost::thread_group,
+ * can be selected instead for comparison.
  *
  * The parallel processing pattern:
  * 1. Create thread pool with N worker threads
@@ -48,6 +70,14 @@ struct NFPPair {
  */
 class ParallelProcessor {
 public:
+    /**
+     * @brief Task queue behind the pool
+     */
+    enum class Backend {
+        WORK_STEALING,  // Per-thread deques with stealing (WorkStealingScheduler)
+        ASIO            // One io_context queue shared by all threads
+    };
+
     /**
      * @brief Constructor
      *
@@ -55,8 +85,51 @@ public:
      * Threads are started immediately and wait for tasks.
      *
      * @param numThreads Number of worker threads (default: hardware concurrency)
+     * @param backend Task queue to use
+     * @param affinity CPU pinning and NUMA grouping of the threads; the
+     *                 ASIO backend pins but keeps a single queue
+     */
+    explicit ParallelProcessor(int numThreads = 0, Backend backend = Backend::WORK_STEALING,
+                               const WorkerAffinity& affinity = WorkerAffinity());
+
+    /**
+     * @brief Run on the threads of another processor
+     *
+     * Tasks, cancel(), waitAll() and the completion counts are this
+     * processor's own, so several nesting runs can share one pool and
+     * cancel their own work without touching the others' (see
+     * NestingDaemon). The pool's threads are shared fairly: each processor
+     * on the pool keeps at most its share of the threads (rounded up)
+     * queued or running there, and holds further tasks back until one of
+     * its own completes. stop() only drops this processor's tasks. The
+     * pool must not be stopped while processors on it have tasks.
+     *
+     * @param pool Processor owning the threads
+     * @throws std::invalid_argument if pool is null
+     */
+    explicit ParallelProcessor(std::shared_ptr<ParallelProcessor> pool);
+
+    /**
+     * @brief Backend by config name: "asio", otherwise work stealing
+     */
+    static Backend backendFromName(const std::string& name);
+
+    /**
+     * @brief Task queue this processor was created with
+     */
+    Backend getBackend() const { return backend_; }
+
+    /**
+     * @brief Thread placement this processor was created with
      */
-    explicit ParallelProcessor(int numThreads = 0);
+    const WorkerAffinity& getAffinity() const { return affinity_; }
+
+    /**
+     * @brief Number of NUMA nodes tasks can be directed to (see enqueue())
+     */
+    size_t getNodeCount() const {
+        return pool_ ? pool_->getNodeCount() : scheduler_ ? scheduler_->nodeCount() : 1;
+    }
 
     /**
      * @brief Destructor
@@ -73,6 +146,7 @@ public:
      *
      * @tparam Func Callable type (function, lambda, functor)
      * @param f Task to execute
+     * @param node NUMA node to run it on, < getNodeCount() (-1 = any)
      * @return Future containing the task result
      *
      * Example:
@@ -82,7 +156,7 @@ public:
      * ```
      */
     template<typename Func>
-    auto enqueue(Func&& f) -> std::future<typename std::result_of<Func()>::type>;
+    auto enqueue(Func&& f, int node = -1) -> std::future<typename std::result_of<Func()>::type>;
 
     /**
      * @brief Process population individuals in parallel
@@ -91,19 +165,32 @@ public:
      * This is the main method for concurrent fitness evaluation.
      *
      * Algorithm:
-     * 1. Count currently processing individuals
-     * 2. For each unevaluated individual (fitness == 0):
-     *    - If slots available (running < numThreads):
-     *      - Mark as processing
-     *      - Enqueue placement task
-     *      - Increment running count
-     * 3. Tasks execute concurrently in thread pool
-     * 4. On completion, update individual fitness
+     * 1. For each unevaluated individual that is not processing:
+     *    - Give it a fresh EvaluationSlot (state PROCESSING)
+     *    - Enqueue a placement task holding the slot, the job and the
+     *      individual's genes as PlacementJob variant indices
+     * 2. Tasks execute concurrently in thread pool
+     * 3. On completion, a task writes the result into its slot and marks
+     *    it DONE; the population itself is only touched by the calling
+     *    thread, which collects results with Individual::collect()
      *
      * @param population Population to process
-     * @param sheets Available sheets for placement
+     * @param job Sheets and turned parts shared by all evaluations
      * @param worker PlacementWorker instance for evaluations
      * @param maxConcurrent Maximum concurrent evaluations (0 = use thread count)
+     * @param select Optional filter on population indices; only selected
+     *               individuals are launched (nullptr = all)
+     * @param bounded Stop each evaluation once it cannot beat the
+     *                population's survival threshold at launch
+     *                (Population::survivalThreshold)
+     * @param memo Results of earlier evaluations of the job; an individual
+     *             found there is published at once without a task, and
+     *             complete results are added (nullptr = none)
+     * @param coldNFPs NFPs an individual needs that are not cached, by
+     *             population index. Given it, individuals are launched
+     *             longest predicted evaluation first, from their gene
+     *             count, these NFPs and the times of earlier evaluations
+     *             (nullptr = population order)
      *
      * References:
      * - background.js line 1105: var running = GA.population.filter(...)
@@ -111,11 +198,49 @@ public:
      */
     void processPopulation(
         Population& population,
-        const std::vector<Polygon>& sheets,
+        const std::shared_ptr<const PlacementJob>& job,
         PlacementWorker& worker,
-        int maxConcurrent = 0
+        int maxConcurrent = 0,
+        const std::function<bool(size_t)>& select = nullptr,
+        bool bounded = false,
+        const std::shared_ptr<FitnessMemo>& memo = nullptr,
+        const std::function<size_t(size_t)>& coldNFPs = nullptr
     );
 
+    /**
+     * @brief Evaluate on remote worker processes as well as locally
+     *
+     * Connects to each endpoint (see RemoteNode) and sends it the job
+     * snapshot. While every local thread has work, processPopulation() then
+     * sends further evaluations of job to the connected node with the most
+     * free capacity instead of queueing them; results land in the same
+     * evaluation slots. Evaluations of a node that drops are run locally.
+     * Replaces the nodes connected before. Call from the thread that calls
+     * processPopulation().
+     *
+     * @param endpoints "host:port" of each RemoteWorkerServer
+     * @param job Job the nodes evaluate
+     * @param snapshot RemoteNode::encodeJob() of that job
+     * @param token Shared secret of the nodes (see RemoteNode::connect())
+     * @return Number of nodes connected
+     */
+    size_t connectRemoteWorkers(
+        const std::vector<std::string>& endpoints,
+        const std::shared_ptr<const PlacementJob>& job,
+        const std::string& snapshot,
+        const std::string& token = std::string()
+    );
+
+    /**
+     * @brief Abandon remote evaluations and close the connections
+     */
+    void disconnectRemoteWorkers();
+
+    /**
+     * @brief Number of remote nodes connected
+     */
+    size_t getRemoteWorkerCount() const { return remotes_.size(); }
+
     /**
      * @brief Get number of worker threads
      *
@@ -123,6 +248,74 @@ public:
      */
     int getThreadCount() const { return threadCount_; }
 
+    /**
+     * @brief Number of worker threads not running a task
+     */
+    int getIdleThreadCount() const {
+        return pool_ ? pool_->getIdleThreadCount() : std::max(0, threadCount_ - busy_.load());
+    }
+
+    /**
+     * @brief Run this processor's tasks on at most count threads
+     *
+     * Further tasks wait in this processor's backlog until one of its
+     * running tasks completes, as beyond its share of a shared pool.
+     * Raising the limit hands waiting tasks to the threads at once. The
+     * other threads stay idle, or run other sharers' tasks.
+     *
+     * @param count Threads to use at most (0 = all)
+     */
+    void setActiveThreads(int count);
+
+    /**
+     * @brief Threads this processor's tasks may occupy at once
+     *
+     * The limit of setActiveThreads(), or the share of a shared pool if
+     * smaller, or else getThreadCount().
+     */
+    int getActiveThreads() const;
+
+    /**
+     * @brief Time spent running tasks, counted while setTaskTiming() is on
+     */
+    struct TaskTimes {
+        uint64_t tasks = 0;
+        double wallSeconds = 0.0;  // Summed over threads
+        double cpuSeconds = 0.0;   // CPU time of the running threads
+    };
+
+    /**
+     * @brief Time each task of this processor (two clock reads each)
+     */
+    void setTaskTiming(bool enabled) { taskTiming_.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief Totals of the tasks timed so far
+     */
+    TaskTimes taskTimes() const;
+
+    /**
+     * @brief Run body over [0, count) split across idle worker threads
+     *
+     * The range is cut into at most one chunk per idle thread plus one,
+     * each of at least minChunk items. The calling thread works through
+     * the chunks too and only waits for chunks a worker has already
+     * started, so it may be called from inside a pool task. This is the
+     * fork/join primitive for nested work: with the work-stealing backend,
+     * chunks forked from a pool task go to that thread's own deque, where
+     * idle threads steal them. With no idle thread, body(0, count) runs
+     * inline.
+     *
+     * @param count Number of items
+     * @param minChunk Minimum number of items per chunk
+     * @param body Called concurrently with [begin, end) of each chunk
+     */
+    void parallelFor(
+        size_t count,
+        size_t minChunk,
+        const std::function<void(size_t, size_t)>& body
+    );
+
     /**
      * @brief Stop all worker threads
      *
@@ -130,61 +323,154 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Drop every task posted so far that has not started
+     *
+     * Dropped tasks are taken off the queue without running their work;
+     * their futures report std::future_errc::broken_promise. Running tasks
+     * see their cancellationToken() cancelled: placement and NFP tasks stop
+     * at the next part or NFP, others finish. A cancel() followed by
+     * waitAll() thus leaves the pool idle and ready for new tasks within
+     * about one NFP computation, without stopping its threads. Applies to
+     * all tasks of the pool, whoever posted them. Remote evaluations are
+     * abandoned (RemoteNode::abandon()).
+     */
+    void cancel();
+
+    /**
+     * @brief Token of the tasks posted until the next cancel()
+     *
+     * Long-running tasks pass it to PlacementWorker::placeParts and
+     * NFPCalculator::computeBatch.
+     */
+    CancellationToken cancellationToken() const;
+
     /**
      * @brief Wait for all tasks to complete
      *
-     * Blocks until the task queue is empty.
+     * Blocks until every task posted so far has run or been cancelled, or
+     * the processor is stopped. The caller sleeps on a completion barrier
+     * and runs no pool work itself, so it must not be called from inside a
+     * pool task.
      */
     void waitAll();
 
     /**
-     * @brief Calculate NFPs in parallel for given pairs
+     * @brief Number of tasks that have run or been cancelled so far
+     */
+    uint64_t getCompletedCount() const;
+
+    /**
+     * @brief Number of tasks posted and not finished: queued or running
+     */
+    size_t getPendingCount() const;
+
+    /**
+     * @brief Wait until getCompletedCount() exceeds seen
      *
-     * Matches JavaScript Parallel.js worker behavior from svgnest.js lines 338-447.
-     * Calculates NFPs for all pairs concurrently and stores results in cache.
-     *
-     * Algorithm (matching JavaScript):
-     * 1. For each pair:
-     *    - Rotate A and B to specified rotations
-     *    - If inside (inner NFP):
-     *      - Check if A is rectangle → use noFitPolygonRectangle
-     *      - Otherwise → use noFitPolygon(A, B, true, searchEdges)
-     *      - Ensure correct winding direction (negative area)
-     *    - If outside (outer NFP):
-     *      - Use noFitPolygon(A, B, false, searchEdges)
-     *      - Validate area (NFP area >= A area)
-     *      - Handle holes if useHoles enabled
-     *      - Ensure correct winding direction
-     * 2. Store results in NFP cache
+     * Read the count before checking the results of earlier tasks, then
+     * wait with it: a task finishing in between is not missed.
      *
-     * @param pairs Vector of NFP pairs to calculate
-     * @param cache NFP cache for storing results
-     * @param config Configuration (searchEdges, useHoles, etc.)
+     * @param seen Count the caller has already accounted for
+     * @param timeoutMs Longest wait in milliseconds
+     * @return False on timeout or when the processor is stopped
+     */
+    bool waitForCompletion(uint64_t seen, int timeoutMs);
+
+    /**
+     * @brief Lock, queue and worker counters since the last reset
+     *
+     * Counted only while LockStats::enabled(). The queue and worker
+     * figures are those of the pool this processor runs on; a processor
+     * on a shared pool sees the tasks of every sharer there.
+     */
+    ProcessorContention contentionStats() const;
+
+    /**
+     * @brief Zero the counters of contentionStats()
+     */
+    void resetContentionStats();
+
+    /**
+     * @brief Enqueue NFP calculations for the given pairs without waiting
+     *
+     * Pairs with the same A, A rotation and kind are grouped and enqueued
+     * as batches of up to 16 in the order of each group's first pair, so
+     * callers pass them sorted by priority. Each task takes the turned A
+     * and B of the pair, or rotates them like PlacementWorker::placeParts,
+     * and hands the batch to
+     * NFPCalculator::computeBatch, so results land in the cache under the
+     * same keys placement looks up. Placement tasks enqueued
+     * afterwards that need a pair still being computed wait on it instead of
+     * computing it again (see NFPCalculator single-flight).
+     *
+     * @param pairs NFP pairs to calculate (copied; they only hold pointers)
+     * @param calculator NFP calculator whose cache is populated
+     * @return One future per batch
      *
      * References:
      * - svgnest.js lines 338-447: Parallel.js map function
-     * - svgnest.js lines 350-370: Inner NFP calculation
-     * - svgnest.js lines 372-438: Outer NFP calculation with validation
      */
-    void calculateNFPsParallel(
+    std::vector<std::future<void>> prefetchNFPs(
         const std::vector<NFPPair>& pairs,
-        NFPCache& cache,
-        const DeepNestConfig& config
+        NFPCalculator& calculator
     );
 
     /**
-     * @brief Execute a function under the processor's lock
-     * 
-     * Allows external components (like NestingEngine) to synchronize access
-     * to shared data protected by the processor's mutex.
-     * 
-     * @param func Function to execute while holding the lock
+     * @brief Calculate NFPs in parallel for given pairs
+     *
+     * Same as prefetchNFPs() but blocks until every pair is calculated.
+     *
+     * @param pairs Vector of NFP pairs to calculate
+     * @param calculator NFP calculator whose cache is populated
      */
-    void executeLocked(std::function<void()> func);
+    void calculateNFPsParallel(
+        const std::vector<NFPPair>& pairs,
+        NFPCalculator& calculator
+    );
 
 private:
     /**
-     * @brief IO context for task queue
+     * @brief Processor whose threads run this one's tasks (nullptr = own threads)
+     */
+    std::shared_ptr<ParallelProcessor> pool_;
+
+    /**
+     * @brief Processors running on this one's threads
+     */
+    std::atomic<int> sharers_;
+
+    /**
+     * @brief Tasks handed to the pool's threads and not yet completed
+     *        (guarded by pendingMutex_)
+     */
+    size_t dispatched_;
+
+    /**
+     * @brief Tasks held back beyond this processor's share of the pool
+     *        or its active thread limit, with their node (guarded by
+     *        pendingMutex_)
+     */
+    std::deque<std::pair<std::function<void()>, int>> backlog_;
+
+    /**
+     * @brief Limit of setActiveThreads() (0 = none; guarded by pendingMutex_)
+     */
+    int activeThreads_;
+
+    /**
+     * @brief Tasks this processor may have on the threads at once
+     *        (pendingMutex_ held)
+     */
+    size_t share() const;
+
+    /**
+     * @brief Work-stealing task queue (Backend::WORK_STEALING)
+     */
+    std::unique_ptr<WorkStealingScheduler> scheduler_;
+
+    /**
+     * @brief IO context for task queue (Backend::ASIO)
      */
     boost::asio::io_context ioContext_;
 
@@ -203,26 +489,231 @@ private:
      */
     int threadCount_;
 
+    /**
+     * @brief Task queue in use
+     */
+    Backend backend_;
+
+    /**
+     * @brief CPU pinning and NUMA grouping of the threads
+     */
+    WorkerAffinity affinity_;
+
+    /**
+     * @brief Cancelled and replaced by cancel(); tasks posted under a
+     *        cancelled token are dropped (guarded by pendingMutex_)
+     */
+    CancellationToken token_;
+
     /**
      * @brief Flag indicating if processor is stopped
      */
     bool stopped_;
 
     /**
-     * @brief Mutex for thread-safe operations
+     * @brief Number of worker threads running a task
+     */
+    std::atomic<int> busy_;
+
+    /**
+     * @brief Guards stopped_
      */
     mutable boost::mutex mutex_;
+
+    /**
+     * @brief Tasks posted but not yet run (guarded by pendingMutex_)
+     */
+    size_t pending_;
+
+    /**
+     * @brief Tasks that have run or been cancelled (guarded by pendingMutex_)
+     */
+    uint64_t completed_;
+
+    /**
+     * @brief Guards pending_; separate from mutex_, which enqueue() takes
+     */
+    mutable boost::mutex pendingMutex_;
+
+    /**
+     * @brief Set by stop(); dropped tasks leave pending_ above zero
+     *        (guarded by pendingMutex_)
+     */
+    bool halted_;
+
+    /**
+     * @brief Signalled when a task completes or the processor stops
+     */
+    boost::condition_variable idle_;
+
+    /**
+     * @brief Counters of mutex_ and pendingMutex_ (waits on idle_ excluded)
+     */
+    mutable LockStats stateLockStats_;
+    mutable LockStats pendingLockStats_;
+
+    /**
+     * @brief Tasks handed to this processor's threads and not yet started
+     */
+    QueueStats queueStats_;
+
+    /**
+     * @brief Tasks run and time spent running them, per thread; a thread
+     *        takes the next slot when it first runs a profiled task
+     */
+    struct WorkerCounters {
+        std::atomic<uint64_t> tasks{0};
+        std::atomic<uint64_t> busyNs{0};
+    };
+    std::unique_ptr<WorkerCounters[]> workerCounters_;
+    std::atomic<size_t> nextWorkerSlot_;
+
+    /**
+     * @brief LockStats::now() at construction or the last reset
+     */
+    std::atomic<uint64_t> statsSince_;
+
+    /**
+     * @brief Counters of taskTimes(), while taskTiming_ is set
+     */
+    std::atomic<bool> taskTiming_;
+    std::atomic<uint64_t> timedTasks_;
+    std::atomic<uint64_t> taskWallNs_;
+    std::atomic<uint64_t> taskCpuNs_;
+
+    /**
+     * @brief Run a task and add its times to the counters
+     */
+    void runTimed(const std::function<void()>& task);
+
+    /**
+     * @brief Least-squares fit of evaluation time to gene count and cold
+     *        NFPs, decayed per sample so it follows the cache warming up
+     *        (guarded by costMutex_)
+     */
+    struct CostModel {
+        double gg = 0.0;  // Sum of genes^2
+        double gc = 0.0;  // Sum of genes * cold
+        double cc = 0.0;  // Sum of cold^2
+        double gt = 0.0;  // Sum of genes * seconds
+        double ct = 0.0;  // Sum of cold * seconds
+        size_t samples = 0;
+    };
+    CostModel costModel_;
+    mutable boost::mutex costMutex_;
+
+    /**
+     * @brief Seconds per gene and per cold NFP predicted by costModel_
+     */
+    std::pair<double, double> costCoefficients() const;
+
+    /**
+     * @brief Add a complete local evaluation to costModel_
+     */
+    void recordCost(size_t genes, size_t cold, double seconds);
+
+    /**
+     * @brief Connected remote worker processes (see connectRemoteWorkers())
+     */
+    std::vector<std::unique_ptr<RemoteNode>> remotes_;
+
+    /**
+     * @brief Job the remote nodes were given
+     */
+    std::shared_ptr<const PlacementJob> remoteJob_;
+
+    /**
+     * @brief Send one evaluation to a remote node if the local threads are
+     *        all busy and a node has free capacity
+     *
+     * The evaluation counts as pending until its result is published or it
+     * is abandoned. Its result is added to memo, if given.
+     *
+     * @return False if it should be evaluated locally
+     */
+    bool evaluateRemotely(
+        const std::shared_ptr<EvaluationSlot>& slot,
+        const std::shared_ptr<const PlacementJob>& job,
+        PlacementWorker& worker,
+        const std::vector<size_t>& variants,
+        double cutoff,
+        const std::shared_ptr<FitnessMemo>& memo
+    );
+
+    /**
+     * @brief Count remote evaluations as completed (or abandoned)
+     */
+    void releaseRemote(size_t count);
+
+    /**
+     * @brief Post a handler to the pool
+     *
+     * The handler counts as pending until it has run or been cancelled
+     * and as busy while it runs.
+     *
+     * @param node NUMA node for the work-stealing backend (-1 = any)
+     */
+    template<typename Handler>
+    void post(Handler handler, int node = -1);
+
+    /**
+     * @brief Queue a counted task, or hold it back beyond this processor's
+     *        share of a shared pool
+     */
+    void dispatch(std::function<void()> task, int node);
+
+    /**
+     * @brief Hand a task to the threads' queue
+     */
+    void submitToThreads(std::function<void()> task, int node);
+
+    /**
+     * @brief Account for a completed task and release a held-back one
+     */
+    void finishTask();
+
+    /**
+     * @brief Wrap a task for the queue and worker counters of this pool
+     */
+    std::function<void()> profiled(std::function<void()> task);
 };
 
+template<typename Handler>
+void ParallelProcessor::post(Handler handler, int node) {
+    CancellationToken token;
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        ++pending_;
+        token = token_;
+    }
+
+    // Busy threads are counted where the threads are
+    std::atomic<int>& busy = pool_ ? pool_->busy_ : busy_;
+    auto counted = [this, &busy, handler, token]() mutable {
+        if (!token.isCancelled()) {
+            ++busy;
+            if (taskTiming_.load(std::memory_order_relaxed)) {
+                runTimed([&handler]() { handler(); });
+            } else {
+                handler();
+            }
+            --busy;
+        }
+        finishTask();
+    };
+
+    dispatch(std::move(counted), node);
+}
+
 // Template implementation must be in header
 template<typename Func>
-auto ParallelProcessor::enqueue(Func&& f) -> std::future<typename std::result_of<Func()>::type> {
+auto ParallelProcessor::enqueue(Func&& f, int node) -> std::future<typename std::result_of<Func()>::type> {
     using return_type = typename std::result_of<Func()>::type;
 
     // CRITICAL FIX: Don't enqueue tasks if processor is stopped
     // This prevents adding tasks that will never execute and may hold dangling references
     {
-        boost::lock_guard<boost::mutex> lock(mutex_);
+        ProfiledLock<boost::mutex> lock(mutex_, stateLockStats_);
         if (stopped_) {
             // Return an immediately ready future with default value
             // This prevents crashes when trying to enqueue after stop()
@@ -248,9 +739,9 @@ auto ParallelProcessor::enqueue(Func&& f) -> std::future<typename std::result_of
     std::future<return_type> result = task->get_future();
 
     // Post task to io_context
-    boost::asio::post(ioContext_, [task]() {
+    post([task]() {
         (*task)();
-    });
+    }, node);
 
     return result;
 }
@@ -0,0 +1,225 @@
+#ifndef DEEPNEST_REMOTE_WORKER_H
+#define DEEPNEST_REMOTE_WORKER_H
+
+#include "../config/DeepNestConfig.h"
+#include "../core/Polygon.h"
+#include "../placement/PlacementWorker.h"
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Connection to one remote worker process (RemoteWorkerServer)
+ *
+ * The node receives the job snapshot once, when connecting, and rebuilds
+ * the same PlacementJob from it. Each evaluation then only sends its genes
+ * as PlacementJob variant indices (part and rotation in one number) with
+ * the cutoff, and the node answers with fitness and placements. Requests
+ * are pipelined on one TCP connection; a reader thread hands each answer
+ * to the handler given with its request.
+ *
+ * Messages are length-prefixed binary frames in little-endian byte order.
+ * Both ends must run the same build: the node relies on getting the same
+ * variant numbering and placement results as a local evaluation. The
+ * connection is neither authenticated beyond the shared token nor
+ * encrypted; across hosts, run it on a trusted network or a tunnel.
+ */
+class RemoteNode {
+public:
+    using ResultHandler = std::function<void(PlacementWorker::PlacementResult&&)>;
+    using FailureHandler = std::function<void()>;
+
+    /**
+     * @param endpoint "host:port" of the worker process
+     */
+    explicit RemoteNode(const std::string& endpoint);
+
+    /**
+     * @brief Closes the connection (see close())
+     */
+    ~RemoteNode();
+
+    RemoteNode(const RemoteNode&) = delete;
+    RemoteNode& operator=(const RemoteNode&) = delete;
+
+    /**
+     * @brief Connect, send the job snapshot and wait until the node is ready
+     *
+     * @param snapshot Output of encodeJob()
+     * @param token Shared secret the node was started with (empty = none)
+     * @return False if the node cannot be reached or rejects the job
+     */
+    bool connect(const std::string& snapshot, const std::string& token = std::string());
+
+    /**
+     * @brief Send one evaluation
+     *
+     * Exactly one of done and failed runs, on the reader thread, unless the
+     * request is abandoned first. failed runs if the connection drops
+     * before the answer arrives, so the caller can evaluate locally.
+     *
+     * @param variants Genes as PlacementJob variant indices
+     * @param cutoff See PlacementWorker::placeParts
+     * @return False if the node is not connected; no handler runs then
+     */
+    bool submit(const std::vector<size_t>& variants, double cutoff,
+                ResultHandler done, FailureHandler failed);
+
+    /**
+     * @brief Forget every outstanding request
+     *
+     * Their handlers never run and late answers are ignored. The node is
+     * told to drop its evaluations, running ones included.
+     *
+     * @return Number of requests abandoned
+     */
+    size_t abandon();
+
+    /**
+     * @brief Shut the connection down and join the reader thread
+     *
+     * Outstanding requests are failed, so abandon() them first if they
+     * should not be evaluated locally.
+     */
+    void close();
+
+    /**
+     * @brief Evaluations the node runs at once (its thread count)
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Requests sent and not yet answered
+     */
+    size_t inFlight() const;
+
+    /**
+     * @brief Whether the connection is up
+     */
+    bool alive() const;
+
+    /**
+     * @brief Endpoint this node connects to
+     */
+    const std::string& endpoint() const { return endpoint_; }
+
+    /**
+     * @brief Split a comma-separated "host:port" list (config.remoteWorkers)
+     */
+    static std::vector<std::string> parseEndpoints(const std::string& list);
+
+    /**
+     * @brief Serialize a job for connect()
+     *
+     * Holds the placement settings of config, the spaced sheets and the
+     * spaced parts (with fingerprints, convexity and coarse outlines) in
+     * the order PlacementJob numbers them.
+     */
+    static std::string encodeJob(const DeepNestConfig& config,
+                                 const std::vector<Polygon>& sheets,
+                                 const std::vector<std::shared_ptr<Polygon>>& parts);
+
+    /**
+     * @brief Rebuild a job serialized by encodeJob()
+     *
+     * Applies the job's placement settings to config and rebuilds the
+     * sheets and parts with their coordinates and scaled paths.
+     *
+     * @throws std::runtime_error on a truncated snapshot or another protocol version
+     */
+    static void decodeJob(const std::string& snapshot,
+                          DeepNestConfig& config,
+                          std::vector<Polygon>& sheets,
+                          std::vector<std::shared_ptr<Polygon>>& parts);
+
+private:
+    struct Request {
+        ResultHandler done;
+        FailureHandler failed;
+    };
+
+    void read();
+
+    bool send(const std::string& frame);
+
+    std::string endpoint_;
+
+    boost::asio::io_context io_;
+    boost::asio::ip::tcp::socket socket_;
+
+    /**
+     * @brief Serializes frames written by submit() and abandon()
+     */
+    boost::mutex writeMutex_;
+
+    /**
+     * @brief Guards requests_, nextId_ and alive_
+     */
+    mutable boost::mutex mutex_;
+    std::unordered_map<uint64_t, Request> requests_;
+    uint64_t nextId_;
+    bool alive_;
+
+    size_t capacity_;
+    boost::thread reader_;
+};
+
+/**
+ * @brief Worker process side of RemoteNode
+ *
+ * Serves one master at a time: receives the job snapshot, applies its
+ * placement settings to the DeepNestConfig instance, evaluates genomes on
+ * a local ParallelProcessor and returns the results as they finish. A
+ * master that disconnects has its remaining evaluations dropped.
+ *
+ * Listens on the loopback interface unless given another address. A
+ * master whose token differs from the server's is disconnected before its
+ * job is decoded.
+ */
+class RemoteWorkerServer {
+public:
+    /**
+     * @param port TCP port to listen on
+     * @param threads Evaluation threads (0 = hardware concurrency)
+     * @param address Address to bind ("0.0.0.0" = every interface)
+     * @param token Shared secret masters must send (empty = none)
+     * @throws boost::system::system_error if the port cannot be bound
+     */
+    RemoteWorkerServer(unsigned short port, int threads = 0,
+                       const std::string& address = "127.0.0.1",
+                       const std::string& token = std::string());
+
+    /**
+     * @brief Accept and serve masters until stop()
+     */
+    void run();
+
+    /**
+     * @brief Stop accepting; run() returns once the current master is done
+     */
+    void stop();
+
+private:
+    void serve(boost::asio::ip::tcp::socket& socket);
+
+    boost::asio::io_context io_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    int threads_;
+    std::string token_;
+
+    /**
+     * @brief Set by stop(); only touched on the thread in run()
+     */
+    bool stopped_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_REMOTE_WORKER_H
@@ -0,0 +1,111 @@
+#ifndef DEEPNEST_THREAD_COUNT_CONTROLLER_H
+#define DEEPNEST_THREAD_COUNT_CONTROLLER_H
+
+#include <cstddef>
+
+namespace deepnest {
+
+/**
+ * @brief Number of worker threads that maximizes evaluations per second
+ *
+ * More threads stop helping once they compete for memory bandwidth (the
+ * NFP cache, Clipper temporaries) or for CPUs other processes use, and
+ * past that point they slow every evaluation down. The controller climbs
+ * the throughput curve one step per window: it keeps moving while the
+ * rate improves, turns back when a move costs throughput, and returns to
+ * the best level seen when the rate falls well below it. After turning
+ * back it stays a few windows before probing the other side.
+ *
+ * Where a move changes the rate by less than TOLERANCE, two stall
+ * indicators decide. A rising CPU time per evaluation (compared with the
+ * leanest window so far) means the threads wait on memory; a share of
+ * task time spent off the CPU means the machine is oversubscribed. Either
+ * one moves toward fewer threads, which then do the same work.
+ *
+ * Windows shorter than MIN_SECONDS or with fewer evaluations than two per
+ * thread are merged with the next, so one slow generation is not taken
+ * for a trend.
+ */
+class ThreadCountController {
+public:
+    /**
+     * @brief Work done since the previous sample
+     */
+    struct Sample {
+        size_t evaluations = 0;    // Evaluations completed
+        double seconds = 0.0;      // Wall time elapsed
+        double busySeconds = 0.0;  // Wall time of the pool's tasks, summed over threads
+        double cpuSeconds = 0.0;   // CPU time of the same tasks
+    };
+
+    /**
+     * @brief Relative rate change taken for noise
+     */
+    static constexpr double TOLERANCE = 0.05;
+
+    /**
+     * @brief Share of task time off the CPU beyond which threads are shed
+     */
+    static constexpr double OFF_CPU_LIMIT = 0.2;
+
+    static constexpr double MIN_SECONDS = 0.5;
+    static constexpr size_t MIN_EVALUATIONS = 8;
+
+    /**
+     * @param minThreads Fewest threads to use (at least 1)
+     * @param maxThreads Most threads to use, where the controller starts
+     */
+    ThreadCountController(int minThreads, int maxThreads);
+
+    /**
+     * @brief Add a sample and, once the window is long enough, move
+     *
+     * @return Number of threads to use from now on
+     */
+    int update(const Sample& sample);
+
+    /**
+     * @brief Number of threads chosen
+     */
+    int level() const { return level_; }
+
+    /**
+     * @brief Evaluations per second of the last complete window (0 = none yet)
+     */
+    double throughput() const { return throughput_; }
+
+    /**
+     * @brief Share of task time off the CPU in the last complete window
+     */
+    double offCpu() const { return offCpu_; }
+
+    /**
+     * @brief CPU time per evaluation of the last window over the leanest
+     */
+    double cpuInflation() const { return inflation_; }
+
+private:
+    void move(int direction);
+
+    int min_;
+    int max_;
+    int step_;
+    int level_;
+    int direction_;       // -1 = shed threads, +1 = add threads
+    int hold_;            // Windows left before the next move
+
+    Sample window_;       // Samples not decided on yet
+    int lastLevel_;       // Level of the previous window (0 = none)
+    double last_;         // Its rate
+    int bestLevel_;
+    double best_;         // Rate at bestLevel_, refreshed on each visit
+    double leanCpu_;      // Lowest CPU seconds per evaluation seen
+
+    double throughput_;
+    double offCpu_;
+    double inflation_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_THREAD_COUNT_CONTROLLER_H
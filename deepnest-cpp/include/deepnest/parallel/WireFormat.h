@@ -0,0 +1,176 @@
+#ifndef DEEPNEST_WIRE_FORMAT_H
+#define DEEPNEST_WIRE_FORMAT_H
+
+#include "../core/Polygon.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace deepnest {
+
+/**
+ * @brief Little-endian binary encoder
+ *
+ * Shared by the remote worker frames (RemoteWorker.h) and evaluation
+ * recordings (EvaluationRecorder.h). Both ends must run the same build.
+ */
+class WireWriter {
+public:
+    void u8(uint8_t value) { data_.push_back(static_cast<char>(value)); }
+
+    void u32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            u8(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void u64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            u8(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void i32(int32_t value) { u32(static_cast<uint32_t>(value)); }
+
+    void f64(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u64(bits);
+    }
+
+    void str(const std::string& value) {
+        u32(static_cast<uint32_t>(value.size()));
+        data_.append(value);
+    }
+
+    void polygon(const Polygon& polygon) {
+        i32(polygon.id);
+        i32(polygon.source);
+        f64(polygon.rotation);
+        u8(polygon.isSheet ? 1 : 0);
+        u64(polygon.fingerprint);
+        u8(polygon.convex ? 1 : 0);
+        u32(static_cast<uint32_t>(polygon.points.size()));
+        for (const auto& point : polygon.points) {
+            f64(point.x);
+            f64(point.y);
+            u8(point.exact ? 1 : 0);
+        }
+        u32(static_cast<uint32_t>(polygon.children.size()));
+        for (const auto& child : polygon.children) {
+            this->polygon(child);
+        }
+    }
+
+    const std::string& data() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+/**
+ * @brief Decoder for WireWriter output; throws on truncated input
+ */
+class WireReader {
+public:
+    /**
+     * @brief Polygon nesting depth accepted when decoding (holes of holes ...)
+     */
+    static constexpr int MAX_POLYGON_DEPTH = 64;
+
+    explicit WireReader(const std::string& data) : data_(data), pos_(0) {}
+
+    uint8_t u8() {
+        need(1);
+        return static_cast<uint8_t>(data_[pos_++]);
+    }
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(u8()) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t u64() {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(u8()) << (8 * i);
+        }
+        return value;
+    }
+
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+
+    double f64() {
+        const uint64_t bits = u64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string str() {
+        const uint32_t size = u32();
+        need(size);
+        std::string value = data_.substr(pos_, size);
+        pos_ += size;
+        return value;
+    }
+
+    /**
+     * @brief Element count, checked against the bytes left
+     */
+    size_t count(size_t minElementSize) {
+        const uint32_t n = u32();
+        need(static_cast<size_t>(n) * minElementSize);
+        return n;
+    }
+
+    Polygon polygon(int depth = 0) {
+        if (depth > MAX_POLYGON_DEPTH) {
+            throw std::runtime_error("Encoded polygon nested too deeply");
+        }
+
+        Polygon polygon;
+        polygon.id = i32();
+        polygon.source = i32();
+        polygon.rotation = f64();
+        polygon.isSheet = u8() != 0;
+        polygon.fingerprint = u64();
+        polygon.convex = u8() != 0;
+        const size_t points = count(17);
+        polygon.points.reserve(points);
+        for (size_t i = 0; i < points; ++i) {
+            const double x = f64();
+            const double y = f64();
+            polygon.points.emplace_back(x, y, u8() != 0);
+        }
+        const size_t children = count(1);
+        polygon.children.reserve(children);
+        for (size_t i = 0; i < children; ++i) {
+            polygon.children.push_back(this->polygon(depth + 1));
+        }
+        return polygon;
+    }
+
+    /**
+     * @brief Whether every byte has been read
+     */
+    bool atEnd() const { return pos_ == data_.size(); }
+
+private:
+    void need(size_t size) const {
+        if (data_.size() - pos_ < size) {
+            throw std::runtime_error("Truncated binary message");
+        }
+    }
+
+    const std::string& data_;
+    size_t pos_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_WIRE_FORMAT_H
@@ -0,0 +1,117 @@
+#ifndef DEEPNEST_WORK_STEALING_SCHEDULER_H
+#define DEEPNEST_WORK_STEALING_SCHEDULER_H
+
+#include "CpuTopology.h"
+#include <boost/thread.hpp>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Thread pool with one task deque per worker
+ *
+ * A task submitted from a worker goes to the back of that worker's deque,
+ * which the worker pops first (newest first), so nested work stays on the
+ * thread whose data is warm. Tasks from other threads go to a shared
+ * injection queue. A worker with nothing of its own takes from the
+ * injection queue, then steals the oldest task of another worker. Idle
+ * workers sleep until a task is submitted.
+ *
+ * With WorkerAffinity::numaNodes, workers are spread over the NUMA nodes
+ * and each node has its own injection queue. A worker exhausts its own
+ * node (queue, then stealing from its node's workers) before it turns to
+ * other nodes, so a task submitted for a node normally runs there.
+ */
+class WorkStealingScheduler {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param threads Number of worker threads (at least 1)
+     * @param affinity Where the workers run (default: anywhere)
+     */
+    explicit WorkStealingScheduler(int threads, const WorkerAffinity& affinity = WorkerAffinity());
+
+    /**
+     * @brief Stops the workers (see stop())
+     */
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    /**
+     * @brief Queue a task; dropped once the scheduler is stopped
+     *
+     * @param task Task to run
+     * @param node Node whose workers should run it (taken modulo
+     *             nodeCount()), or -1 for the submitting worker's node
+     */
+    void submit(Task task, int node = -1);
+
+    /**
+     * @brief Number of NUMA nodes the workers are spread over (1 unless
+     *        WorkerAffinity::numaNodes)
+     */
+    size_t nodeCount() const { return injected_.size(); }
+
+    /**
+     * @brief Stop the workers
+     *
+     * Running tasks finish; queued tasks are dropped without running, as
+     * with a stopped io_context. Returns once every worker has exited.
+     */
+    void stop();
+
+private:
+    /**
+     * @brief Task deque; a worker's owner uses the back, thieves the front
+     */
+    struct Queue {
+        boost::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t index);
+
+    /**
+     * @brief Take the next task for worker index
+     *
+     * Own deque (back), then the node's injection queue, then the node's
+     * other workers (front); then the same for the other nodes.
+     */
+    bool take(size_t index, Task& task);
+
+    /**
+     * @brief Pop the front task of a queue
+     * @param wait Block on the queue's lock instead of skipping it if busy
+     */
+    bool popFront(Queue& queue, Task& task, bool wait);
+
+    std::vector<std::unique_ptr<Queue>> workers_;
+
+    // Node and CPUs of each worker
+    std::vector<CpuTopology::Slot> slots_;
+
+    // Tasks from outside the pool, per node
+    std::vector<std::unique_ptr<Queue>> injected_;
+
+    // Node for the next task submitted from outside without a node
+    std::atomic<size_t> nextNode_;
+
+    // Tasks queued and not yet taken; workers sleep on wake_ while it is 0
+    std::atomic<size_t> queued_;
+    std::atomic<bool> stopping_;
+    boost::mutex sleepMutex_;
+    boost::condition_variable wake_;
+
+    boost::thread_group threads_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_WORK_STEALING_SCHEDULER_H
@@ -0,0 +1,114 @@
+#ifndef DEEPNEST_EVALUATION_RECORDER_H
+#define DEEPNEST_EVALUATION_RECORDER_H
+
+#include "PlacementWorker.h"
+#include "../nfp/NFPCache.h"
+#include "../parallel/ContentionStats.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Writes the inputs of unusually slow evaluations to replay files
+ *
+ * Set on a PlacementWorker (DeepNestConfig::evaluationRecordPath), it
+ * times every placement of a shared job and captures the NFP cache
+ * entries the evaluation looked up (NFPCache::Capture). Once MIN_SAMPLES
+ * evaluations have been timed, one taking more than factor times the
+ * median is saved as a Recording: the job snapshot, the genome, the
+ * cutoff, the cached NFPs it found and the result it produced. The
+ * EvaluationReplay tool runs a recording again on one thread, so the
+ * evaluation can be profiled outside the genetic algorithm.
+ *
+ * NFPs the evaluation computed or waited for are not stored, so a replay
+ * computes them as the original did. Lookups made for it on helper
+ * threads and the first-sheet prefix it resumed from (PlacementMemo) are
+ * not captured either; a replay computes those too.
+ */
+class EvaluationRecorder {
+public:
+    /**
+     * @brief Evaluations timed before any is judged slow
+     */
+    static constexpr uint64_t MIN_SAMPLES = 32;
+
+    /**
+     * @brief Everything needed to run one evaluation again
+     */
+    struct Recording {
+        std::string snapshot;             // RemoteNode::encodeJob of the job
+        std::vector<size_t> variants;     // Genes as PlacementJob variant indices
+        double cutoff = std::numeric_limits<double>::infinity();
+        uint64_t wallNs = 0;              // Time the evaluation took
+        uint64_t medianNs = 0;            // Median evaluation time when it was recorded
+        double fitness = 0.0;             // Result of the evaluation
+        bool bounded = false;
+
+        /**
+         * @brief Cache entries the evaluation found, by cache key
+         *
+         * Loaded without Clipper paths or coordinate buffers, which the
+         * cache entries carried; build them at the job's clipperScale.
+         */
+        std::vector<std::pair<NFPCache::NFPKey, NFPCache::NFPHandle>> nfps;
+
+        /**
+         * @throws std::runtime_error if the file cannot be written
+         */
+        void save(const std::string& path) const;
+
+        /**
+         * @throws std::runtime_error if the file cannot be read or is not a recording
+         */
+        static Recording load(const std::string& path);
+    };
+
+    /**
+     * @param directory Where recordings are written (created if missing)
+     * @param snapshot RemoteNode::encodeJob of the job being evaluated
+     * @param factor Record evaluations slower than this times the median
+     * @param limit Recordings to write at most
+     */
+    EvaluationRecorder(std::string directory, std::string snapshot, double factor, size_t limit);
+
+    /**
+     * @brief Run one evaluation, timed and with its lookups captured
+     *
+     * @param variants Genes of the evaluation, for the recording
+     * @param cutoff Cutoff of the evaluation, for the recording
+     * @param place Runs the evaluation on the calling thread
+     * @return Result of place
+     */
+    PlacementWorker::PlacementResult evaluate(
+        const std::vector<size_t>& variants,
+        double cutoff,
+        const std::function<PlacementWorker::PlacementResult()>& place);
+
+    /**
+     * @brief Recordings written so far
+     */
+    size_t recorded() const { return recorded_.load(std::memory_order_relaxed); }
+
+private:
+    std::string directory_;
+    std::string snapshot_;
+    double factor_;
+    size_t limit_;
+
+    LatencyHistogram durations_;
+
+    /**
+     * @brief Recordings written or being written
+     */
+    std::atomic<size_t> recorded_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_EVALUATION_RECORDER_H
@@ -0,0 +1,94 @@
+#ifndef DEEPNEST_FITNESS_MEMO_H
+#define DEEPNEST_FITNESS_MEMO_H
+
+#include "PlacementWorker.h"
+#include <boost/thread/mutex.hpp>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Bounded, thread-safe table of complete evaluations by genome
+ *
+ * Crossover of similar parents regularly breeds a child identical to an
+ * individual evaluated before, and placeParts() is deterministic, so its
+ * result can be reused as is. Genomes are keyed by their PlacementJob
+ * variant indices, which encode part, rotation and resolution of every
+ * gene; a table therefore belongs to one job.
+ *
+ * Only unbounded results are stored: a result cut off by one survival
+ * threshold is no answer under another. When full, the oldest entries
+ * are dropped first.
+ */
+class FitnessMemo {
+public:
+    using ResultHandle = std::shared_ptr<const PlacementWorker::PlacementResult>;
+
+    /**
+     * @brief Memo counters
+     */
+    struct Statistics {
+        size_t lookups = 0;  // find() calls
+        size_t hits = 0;     // find() calls that returned a result
+        size_t entries = 0;  // Results held
+        size_t bytes = 0;    // Estimated memory held by the entries
+    };
+
+    /**
+     * @param maxEntries Results to keep at most
+     */
+    explicit FitnessMemo(size_t maxEntries);
+
+    /**
+     * @brief Result of an earlier evaluation of the same genome
+     *
+     * @param variants Genes as PlacementJob variant indices
+     * @return Result, or nullptr if the genome was not evaluated
+     */
+    ResultHandle find(const std::vector<size_t>& variants);
+
+    /**
+     * @brief Store the result of an evaluation
+     *
+     * Bounded results are ignored; an existing entry for the genome is kept.
+     */
+    void insert(const std::vector<size_t>& variants, const PlacementWorker::PlacementResult& result);
+
+    Statistics statistics() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        std::vector<size_t> variants;
+        ResultHandle result;
+        size_t bytes;
+    };
+
+    static uint64_t hash(const std::vector<size_t>& variants);
+
+    size_t maxEntries_;
+    size_t lookups_;
+    size_t hits_;
+    size_t bytes_;
+
+    /**
+     * @brief Entries by genome hash; a colliding genome is not stored
+     */
+    std::unordered_map<uint64_t, Entry> entries_;
+
+    /**
+     * @brief Hashes in insertion order, for eviction
+     */
+    std::deque<uint64_t> order_;
+
+    mutable boost::mutex mutex_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_FITNESS_MEMO_H
@@ -3,6 +3,8 @@
 
 #include "../core/Point.h"
 #include "../core/Polygon.h"
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -45,6 +47,63 @@ public:
         MergeResult() : totalLength(0.0) {}
     };
 
+    /**
+     * @brief Mergeable edges of placed parts, bucketed for candidate queries
+     *
+     * Built once per set of placed parts. Edges are bucketed by direction
+     * (modulo 180 degrees) and by grid cell, so an edge of the new part
+     * only visits edges that can lie on its line within tolerance and
+     * overlap it. An edge is entered in every direction bucket it can align
+     * with: two points within tolerance of a line put an edge of length L
+     * at most asin(2*tolerance/L) off its direction.
+     */
+    class EdgeIndex {
+    public:
+        EdgeIndex();
+
+        /**
+         * @param placed Placed polygons (world coordinates)
+         * @param minLength Minimum edge length to keep
+         * @param tolerance Alignment tolerance the index is queried with
+         */
+        EdgeIndex(const std::vector<Polygon>& placed, double minLength, double tolerance);
+
+        /**
+         * @brief Number of indexed outline edges
+         */
+        size_t size() const { return edges_.size(); }
+
+    private:
+        friend class MergeDetection;
+
+        /**
+         * @brief Exact outline edge of at least minLength
+         */
+        struct Edge {
+            Point start;
+            Point end;
+            uint32_t part;  // Index of the placed part
+        };
+
+        /**
+         * @brief Edges that may merge with A1-A2, in (part, edge) order
+         *
+         * @param angle Direction of A1-A2 (atan2)
+         * @param out Receives indices into edges_
+         */
+        void query(const Point& A1, const Point& A2, double angle, std::vector<uint32_t>& out) const;
+
+        int directionBucket(double angle) const;
+
+        std::vector<Edge> edges_;
+        std::vector<std::pair<uint32_t, std::vector<Polygon>>> holes_;  // By part, in part order
+        double tolerance_;
+        double minX_, minY_, cellSize_;
+        int columns_, rows_;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;  // (bucket, row, column)
+        std::vector<std::vector<uint32_t>> spanning_;  // Per bucket: edges over many cells
+    };
+
     /**
      * @brief Calculate merged length between placed parts and new part
      *
@@ -78,6 +137,26 @@ public:
         double tolerance
     );
 
+    /**
+     * @brief Calculate merged length against an edge index
+     *
+     * Same result as the polygon variant on the indexed parts.
+     *
+     * @param placed Index of the placed parts (same minLength and tolerance)
+     * @param newPart New part in its own coordinates
+     * @param offset Translation of newPart
+     * @param minLength Minimum edge length to consider
+     * @param tolerance Floating-point tolerance for alignment detection
+     * @return MergeResult containing total length and segment list
+     */
+    static MergeResult calculateMergedLength(
+        const EdgeIndex& placed,
+        const Polygon& newPart,
+        const Point& offset,
+        double minLength,
+        double tolerance
+    );
+
 private:
     /**
      * @brief Helper to calculate merged length recursively
@@ -106,6 +185,19 @@ private:
      * @return true if |a - b| < tolerance
      */
     static bool almostEqual(double a, double b, double tolerance);
+
+    /**
+     * @brief Add the overlap of edge A1-A2 with an aligned edge B1-B2
+     *
+     * Shared by both calculateMergedLength() variants; c/s rotate A1-A2 onto
+     * the x axis, c2/s2 rotate back, rotA2x is A2 in the rotated frame.
+     */
+    static void mergeEdge(
+        const Point& A1, double c, double s, double c2, double s2, double rotA2x,
+        const Point& B1, const Point& B2,
+        double min2, double tolerance,
+        MergeResult& result
+    );
 };
 
 } // namespace deepnest
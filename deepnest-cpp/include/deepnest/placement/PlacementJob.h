@@ -0,0 +1,125 @@
+#ifndef DEEPNEST_PLACEMENT_JOB_H
+#define DEEPNEST_PLACEMENT_JOB_H
+
+#include "../core/Polygon.h"
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace deepnest {
+
+class ShapeCache;
+
+/**
+ * @brief Immutable inputs shared by the evaluations of one nesting run
+ *
+ * Holds the spaced sheets and every part turned to each allowed rotation,
+ * for its full outline and its coarse screening outline, if it has one.
+ * An evaluation then only carries variant indices instead of copies of
+ * the sheets and parts. NestingEngine::start() builds one and hands it out
+ * as a shared_ptr<const PlacementJob>; it is never changed afterwards, so
+ * tasks read it without locking.
+ *
+ * Variants are turned from one cosine and sine table for the job's
+ * rotations and carry their Clipper path and coordinates buffer, so
+ * neither placement nor NFP calculation turns or converts a part again.
+ * With snapToGrid they are rounded to the Clipper grid after turning, so
+ * that path is exact.
+ */
+class PlacementJob {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Runs body over [0, count) in chunks, possibly concurrently
+     *        (ParallelProcessor::parallelFor)
+     */
+    using ParallelFor = std::function<void(size_t count,
+                                           const std::function<void(size_t, size_t)>& body)>;
+
+    /**
+     * @param sheets Spaced sheets, in order of use
+     * @param parts Spaced parts, as referenced by Individual::placement
+     * @param rotations Number of allowed rotations (config.rotations)
+     * @param clipperScale Scale of the variants' Clipper paths (config.clipperScale)
+     * @param snapToGrid Round sheets and variants to the clipperScale grid
+     *        (config.integerGeometry)
+     * @param parallelFor Spreads the turning of the variants (nullptr = inline)
+     * @param turned Variants kept from earlier jobs, looked up by outline
+     *        fingerprint before turning and filled with the ones turned
+     *        here (nullptr = turn every variant)
+     */
+    PlacementJob(std::vector<Polygon> sheets,
+                 const std::vector<std::shared_ptr<Polygon>>& parts,
+                 int rotations,
+                 double clipperScale,
+                 bool snapToGrid,
+                 const ParallelFor& parallelFor = nullptr,
+                 ShapeCache* turned = nullptr);
+
+    /**
+     * @brief Sheets, in order of use
+     */
+    const std::vector<Polygon>& sheets() const { return sheets_; }
+
+    /**
+     * @brief Index of a turned part for variant()
+     *
+     * @param partId Polygon::id of the part
+     * @param rotation Rotation in degrees, k * 360/rotations for k in [0, rotations)
+     * @param coarse Use the coarse outline if the part has one
+     * @return Variant index, or npos if the part or rotation is not in the job
+     */
+    size_t variantIndex(int partId, double rotation, bool coarse) const;
+
+    /**
+     * @brief Turned part, as placeParts() places it
+     */
+    const Polygon& variant(size_t index) const { return variants_[index]; }
+
+    /**
+     * @brief Number of turned parts; variant indices are below it
+     */
+    size_t variantCount() const { return variants_.size(); }
+
+    /**
+     * @brief Estimated bytes held by the sheets, variants and index tables
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief Part turned by its rotation field
+     *
+     * Keeps rotation, id and source, as the JavaScript placeParts() does
+     * before placing.
+     */
+    static Polygon rotated(const Polygon& part);
+
+    /**
+     * @brief rotated() with the cosine and sine of part.rotation given
+     */
+    static Polygon rotated(const Polygon& part, double cosA, double sinA);
+
+private:
+    std::vector<Polygon> sheets_;
+
+    /**
+     * @brief Turned parts; rotations_ consecutive entries per outline
+     */
+    std::vector<Polygon> variants_;
+
+    /**
+     * @brief First variant of each part id's full and coarse outline
+     *        (npos if there is none)
+     */
+    std::vector<size_t> fullBase_;
+    std::vector<size_t> coarseBase_;
+
+    int rotations_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_PLACEMENT_JOB_H
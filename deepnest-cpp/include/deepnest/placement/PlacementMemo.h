@@ -0,0 +1,159 @@
+#ifndef DEEPNEST_PLACEMENT_MEMO_H
+#define DEEPNEST_PLACEMENT_MEMO_H
+
+#include "PlacementWorker.h"
+#include "RasterGrid.h"
+#include "Skyline.h"
+#include <boost/thread/mutex.hpp>
+#include <clipper2/clipper.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief State of the first sheet after placing a prefix of the genes
+ *
+ * Everything placeParts() needs to carry on with the next gene as if it
+ * had placed the prefix itself.
+ */
+struct PlacementSnapshot {
+    size_t genes = 0;                                  // Prefix length
+    std::vector<Polygon> placed;                      // Rotated placed parts
+    std::vector<PlacementWorker::Placement> placements;
+    std::vector<Clipper2Lib::Path64> placedPaths;     // World outlines
+    std::map<std::pair<uint64_t, int32_t>, PlacementWorker::ForbiddenRegion> forbidden;
+    double minarea = 0.0;                             // Strategy area terms so far
+    double merged = 0.0;                              // Merged lines of the chosen positions
+    Skyline skyline;                                  // Skyline of the placed rectangles
+    size_t skylinePlaced = 0;                         // Parts placed against the skyline
+    RasterGrid raster;                                // Occupancy bitmap (RASTER placement)
+    std::vector<size_t> skipped;                      // Prefix genes that did not fit
+    std::vector<std::pair<size_t, Polygon>> retried;  // Prefix parts placed at another rotation
+};
+
+/**
+ * @brief Bounded, thread-safe trie of first-sheet placement snapshots
+ *
+ * Crossover and low-rate mutation keep long gene prefixes of the parents,
+ * and placeParts() is deterministic, so the first sheet looks the same
+ * after an identical prefix. The trie is keyed by the first sheet and then
+ * by one (part, shape, rotation) gene per level; placeParts() resumes from
+ * the deepest snapshot along an individual's genes.
+ *
+ * Snapshots are taken every snapshotStride() genes. When the estimated
+ * footprint exceeds the budget, the least recently used snapshots are
+ * dropped in a batch and empty branches pruned.
+ */
+class PlacementMemo {
+public:
+    /**
+     * @brief One gene of an individual as seen by placeParts()
+     */
+    struct Gene {
+        int id;            // Part id
+        uint64_t shape;    // NFPCalculator::shapeKey of the placed outline
+        int32_t rotation;  // NFPCache::rotationKey of the gene rotation
+
+        bool operator<(const Gene& other) const {
+            if (id != other.id) return id < other.id;
+            if (shape != other.shape) return shape < other.shape;
+            return rotation < other.rotation;
+        }
+    };
+
+    using SnapshotHandle = std::shared_ptr<const PlacementSnapshot>;
+
+    /**
+     * @brief Memo counters
+     */
+    struct Statistics {
+        size_t lookups = 0;       // find() calls
+        size_t hits = 0;          // find() calls that returned a snapshot
+        size_t resumedGenes = 0;  // Genes skipped over all hits
+        size_t snapshots = 0;     // Snapshots held
+        size_t bytes = 0;         // Estimated bytes held
+    };
+
+    /**
+     * @brief Constructor
+     * @param maxBytes Memory budget for the snapshots
+     */
+    explicit PlacementMemo(size_t maxBytes);
+
+    /**
+     * @brief Deepest snapshot along the genes
+     *
+     * @param sheet NFPCalculator::shapeKey of the first sheet
+     * @param genes Genes of the individual, in placement order
+     * @return Snapshot, or nullptr if no prefix is stored
+     */
+    SnapshotHandle find(uint64_t sheet, const std::vector<Gene>& genes);
+
+    /**
+     * @brief Whether a snapshot of the first length genes is stored
+     */
+    bool contains(uint64_t sheet, const std::vector<Gene>& genes, size_t length) const;
+
+    /**
+     * @brief Store the snapshot of its first snapshot->genes genes
+     *
+     * Keeps an existing snapshot of the same prefix.
+     */
+    void insert(uint64_t sheet, const std::vector<Gene>& genes, SnapshotHandle snapshot);
+
+    /**
+     * @brief Snapshot spacing in genes for an individual of the given length
+     *
+     * About 16 snapshots per individual, so a resumed evaluation redoes at
+     * most 1/16 of the genes past the shared prefix.
+     */
+    static size_t snapshotStride(size_t genes);
+
+    /**
+     * @brief Estimate the heap footprint of a snapshot
+     */
+    static size_t estimateBytes(const PlacementSnapshot& snapshot);
+
+    Statistics statistics() const;
+
+    void clear();
+
+private:
+    struct Node {
+        std::map<Gene, std::unique_ptr<Node>> children;
+        SnapshotHandle snapshot;
+        size_t bytes = 0;
+        uint64_t lastUse = 0;
+    };
+
+    /**
+     * @brief Drop least recently used snapshots until under the target
+     */
+    void evict();
+
+    static void collect(Node& node, std::vector<Node*>& out);
+
+    /**
+     * @brief Remove branches without snapshots
+     * @return True if the node itself is empty
+     */
+    static bool prune(Node& node);
+
+    size_t maxBytes_;
+    size_t bytes_;
+    size_t snapshots_;
+    uint64_t tick_;
+    size_t lookups_;
+    size_t hits_;
+    size_t resumedGenes_;
+    std::map<uint64_t, Node> roots_;
+    mutable boost::mutex mutex_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_PLACEMENT_MEMO_H
@@ -4,14 +4,16 @@
 #include "../core/Polygon.h"
 #include "../core/Point.h"
 #include "../core/BoundingBox.h"
+#include "MergeDetection.h"
 #include <vector>
 #include <memory>
 #include <string>
 
 namespace deepnest {
 
-// Forward declaration
+// Forward declarations
 class DeepNestConfig;
+class ParallelProcessor;
 
 /**
  * @brief Structure representing a positioned part
@@ -26,6 +28,45 @@ struct PlacedPart {
     PlacedPart() : rotation(0.0), id(-1), source(-1) {}
 };
 
+/**
+ * @brief Placed geometry shared by every candidate position of one part
+ *
+ * Built once per part placement by PlacementContext::build() so the
+ * strategies do not re-translate the placed parts for every candidate.
+ */
+struct PlacementContext {
+    bool hasPlacedPoints;     // False if nothing (valid) is placed yet
+    BoundingBox placedBounds; // Bounds of all placed points (world coordinates)
+    BoundingBox partBounds;   // Bounds of the part being placed (its own coordinates)
+
+    /**
+     * @brief Convex hull of all placed points (ConvexHullPlacement only)
+     */
+    std::vector<Point> placedHull;
+
+    /**
+     * @brief Merge index of the placed parts (only with mergeLines)
+     */
+    MergeDetection::EdgeIndex mergeIndex;
+
+    PlacementContext() : hasPlacedPoints(false) {}
+
+    /**
+     * @brief Prepare the context for placing part next to placed
+     *
+     * @param part Part to be placed
+     * @param placed Previously placed parts with positions
+     * @param config Configuration (mergeLines selects edge collection)
+     * @param withHull Also compute placedHull
+     */
+    static PlacementContext build(
+        const Polygon& part,
+        const std::vector<PlacedPart>& placed,
+        const DeepNestConfig& config,
+        bool withHull
+    );
+};
+
 /**
  * @brief Structure representing the result of best position selection
  *
@@ -37,7 +78,7 @@ struct PlacedPart {
 struct BestPositionResult {
     Point position;         // Best position found
     double area;           // Area metric used for selection (minarea component)
-    double mergedLength;   // Merged line length (for future line merge bonus)
+    double mergedLength;   // Merged line length at the chosen position
 
     BestPositionResult() : area(0.0), mergedLength(0.0) {}
     BestPositionResult(const Point& pos, double a, double ml = 0.0)
@@ -51,6 +92,8 @@ struct BestPositionResult {
  * - Gravity: Compress parts downward (minimize width*2 + height)
  * - Bounding Box: Minimize rectangular bounding box area
  * - Convex Hull: Minimize convex hull area
+ * - Skyline: Gravity, with rectangles packed against a skyline
+ * - Raster: Gravity order on an occupancy bitmap instead of NFPs
  *
  * References:
  * - background.js: placeParts logic (lines 995-1090)
@@ -63,7 +106,9 @@ public:
     enum class Type {
         GRAVITY,        // Compress in gravity direction (weight width more)
         BOUNDING_BOX,   // Minimize bounding box area
-        CONVEX_HULL     // Minimize convex hull area
+        CONVEX_HULL,    // Minimize convex hull area
+        SKYLINE,        // Gravity; rectangles skip the NFPs (PlacementWorker)
+        RASTER          // Bitmap positions, exact refinement (PlacementWorker)
     };
 
     virtual ~PlacementStrategy() = default;
@@ -113,6 +158,19 @@ public:
      */
     static std::unique_ptr<PlacementStrategy> create(const std::string& typeName);
 
+    /**
+     * @brief Score large candidate lists on the processor's idle threads
+     *
+     * findBestPosition() then scores candidate lists of at least threshold
+     * positions in chunks in parallel, and selects over the scores in
+     * candidate order afterwards, so it picks the same position as with
+     * serial scoring.
+     *
+     * @param processor Thread pool to borrow idle threads from (nullptr = serial)
+     * @param threshold Minimum number of candidates (0 = always serial)
+     */
+    void setParallelScoring(ParallelProcessor* processor, size_t threshold);
+
 protected:
     /**
      * @brief Calculate metric for a given placement
@@ -121,14 +179,54 @@ protected:
      *
      * @param part Part being placed
      * @param position Candidate position for part
-     * @param placed Previously placed parts
+     * @param context Placed geometry prepared for this part
      * @return Metric value (lower is better)
      */
     virtual double calculateMetric(
         const Polygon& part,
         const Point& position,
-        const std::vector<PlacedPart>& placed
+        const PlacementContext& context
     ) const = 0;
+
+    /**
+     * @brief Merged line length of the part at a candidate position
+     *
+     * JavaScript background.js:1094: area -= merged.totalLength * config.timeRatio
+     *
+     * @return Merged length (0 unless config.mergeLines)
+     */
+    static double mergedLength(
+        const Polygon& part,
+        const Point& position,
+        const PlacementContext& context,
+        const DeepNestConfig& config
+    );
+
+    /**
+     * @brief Score every candidate position
+     *
+     * metrics[k] is metric(candidate k) less its merge bonus, merged[k] its
+     * merged length. The loop is instantiated per metric kernel and per
+     * mergeLines setting, so it has no per-candidate dispatch. Runs in
+     * parallel when enabled with setParallelScoring() and the list is long
+     * enough. Defined in PlacementStrategy.cpp for the kernels used there.
+     *
+     * @param metric Kernel called as metric(position), equal to calculateMetric()
+     */
+    template <typename Metric>
+    void scoreCandidates(
+        const Metric& metric,
+        const Polygon& part,
+        const std::vector<Point>& candidatePositions,
+        const PlacementContext& context,
+        const DeepNestConfig& config,
+        std::vector<double>& metrics,
+        std::vector<double>& merged
+    ) const;
+
+private:
+    ParallelProcessor* scoringProcessor_ = nullptr;
+    size_t parallelScoringThreshold_ = 0;
 };
 
 /**
@@ -156,7 +254,7 @@ protected:
     double calculateMetric(
         const Polygon& part,
         const Point& position,
-        const std::vector<PlacedPart>& placed
+        const PlacementContext& context
     ) const override;
 };
 
@@ -184,7 +282,7 @@ protected:
     double calculateMetric(
         const Polygon& part,
         const Point& position,
-        const std::vector<PlacedPart>& placed
+        const PlacementContext& context
     ) const override;
 };
 
@@ -212,10 +310,39 @@ protected:
     double calculateMetric(
         const Polygon& part,
         const Point& position,
-        const std::vector<PlacedPart>& placed
+        const PlacementContext& context
     ) const override;
 };
 
+/**
+ * @brief Skyline placement for rectangle-dominated jobs
+ *
+ * PlacementWorker places axis-aligned rectangular parts on a rectangular
+ * sheet against a Skyline, without NFPs, as long as the sheet holds only
+ * such parts. Other parts, and every part after one of them, go through
+ * the NFP path and are positioned by the gravity metric.
+ */
+class SkylinePlacement : public GravityPlacement {
+public:
+    Type getType() const override { return Type::SKYLINE; }
+    std::string getName() const override { return "skyline"; }
+};
+
+/**
+ * @brief Raster placement for jobs where NFPs are the bottleneck
+ *
+ * PlacementWorker places every part on a RasterGrid of the sheet at
+ * DeepNestConfig::rasterCellSize: the bitmap gives the free position at
+ * the lowest column, then the lowest row, and exact overlap tests slide
+ * the part by up to one cell further toward the top-left. No NFPs are
+ * computed; positions are scored by the gravity metric.
+ */
+class RasterPlacement : public GravityPlacement {
+public:
+    Type getType() const override { return Type::RASTER; }
+    std::string getName() const override { return "raster"; }
+};
+
 } // namespace deepnest
 
 #endif // DEEPNEST_PLACEMENT_STRATEGY_H
@@ -5,13 +5,25 @@
 #include "../core/Point.h"
 #include "../config/DeepNestConfig.h"
 #include "../nfp/NFPCalculator.h"
+#include "../parallel/CancellationToken.h"
 #include "PlacementStrategy.h"
 #include "MergeDetection.h"
+#include "RasterGrid.h"
+#include <boost/thread/mutex.hpp>
+#include <cstdint>
+#include <map>
+#include <tuple>
 #include <vector>
 #include <memory>
+#include <limits>
 
 namespace deepnest {
 
+class EvaluationRecorder;
+class PlacementJob;
+class PlacementMemo;
+class ParallelProcessor;
+
 /**
  * @brief Worker class for placing parts on sheets
  *
@@ -25,14 +37,18 @@ namespace deepnest {
  *      - Calculate inner NFP (part vs sheet boundary)
  *      - If first part: place at top-left corner
  *      - Otherwise:
- *        - Calculate outer NFPs with all placed parts
- *        - Union all outer NFPs
+ *        - Calculate outer NFPs with parts placed since the last part of
+ *          the same shape and rotation
+ *        - Fold them into that shape's union of outer NFPs
  *        - Difference with inner NFP to get valid placement region
  *        - Choose best position using placement strategy
  *    - Calculate fitness based on area utilization
  * 3. Calculate merged lines for cutting optimization
  * 4. Return placements with fitness metrics
  *
+ * With config.placementMemoMaxMemoryMB set, the first sheet resumes from
+ * the deepest stored state of the individual's gene prefix (PlacementMemo).
+ *
  * References:
  * - placementworker.js (complete implementation)
  * - background.js: placeParts function (lines 804-1090)
@@ -86,8 +102,39 @@ public:
          */
         std::vector<Polygon> unplacedParts;
 
+        /**
+         * @brief Evaluation stopped at the cutoff
+         *
+         * fitness is then a lower bound above the cutoff, and placements
+         * and unplacedParts reflect the state where placement stopped.
+         */
+        bool bounded;
+
         PlacementResult()
-            : fitness(0.0), area(0.0), mergedLength(0.0) {}
+            : fitness(0.0), area(0.0), mergedLength(0.0), bounded(false) {}
+
+        /**
+         * @brief Estimated bytes held by the result
+         */
+        size_t memoryBytes() const;
+    };
+
+    /**
+     * @brief Estimated bytes held by a per-sheet placement list
+     */
+    static size_t memoryBytes(const std::vector<std::vector<Placement>>& placements);
+
+    /**
+     * @brief Union of the translated outer NFPs of a sheet's placed parts
+     *
+     * Every part with the same shape and rotation sees the same forbidden
+     * region on a sheet, so placeParts() keeps one per (shape, rotation)
+     * while filling the sheet and folds in only the parts placed since it
+     * was last used, instead of re-unioning all placed parts per part.
+     */
+    struct ForbiddenRegion {
+        Clipper2Lib::Paths64 paths;  // Union in Clipper coordinates
+        size_t folded = 0;           // Number of placed parts included
     };
 
     /**
@@ -98,25 +145,105 @@ public:
      */
     PlacementWorker(const DeepNestConfig& config, NFPCalculator& calculator);
 
+    ~PlacementWorker();
+
     /**
      * @brief Place parts on sheets
      *
      * Main placement function that distributes parts across sheets,
      * minimizing waste and optimizing for the configured objective.
      *
-     * @param sheets Available sheets/bins (will be consumed)
+     * @param sheets Available sheets/bins, used in order
      * @param parts Parts to place (must have rotation field set)
+     * @param cutoff Stop as soon as a lower bound on the fitness exceeds
+     *               this value and return that bound (see
+     *               PlacementResult::bounded); infinity = always complete
+     * @param token Checked before each part and each outer NFP
      * @return PlacementResult with placements and metrics
+     * @throws OperationCancelled once token is cancelled
      *
      * References:
      * - background.js line 804: function placeParts(sheets, parts, config, nestindex)
      * - placementworker.js line 59: this.placePaths = function(paths)
      */
     PlacementResult placeParts(
-        std::vector<Polygon> sheets,
-        std::vector<Polygon> parts
+        const std::vector<Polygon>& sheets,
+        const std::vector<Polygon>& parts,
+        double cutoff = std::numeric_limits<double>::infinity(),
+        const CancellationToken& token = CancellationToken()
+    );
+
+    /**
+     * @brief Place turned parts of a shared job on its sheets
+     *
+     * Same as placeParts(sheets, parts, cutoff) for the job's sheets and
+     * the parts its variants were turned from, without copying or turning
+     * any part.
+     *
+     * @param job Sheets and turned parts
+     * @param variants Parts to place, as PlacementJob::variantIndex values
+     * @param cutoff See placeParts(sheets, parts, cutoff)
+     * @param token See placeParts(sheets, parts, cutoff, token)
+     */
+    PlacementResult placeParts(
+        const PlacementJob& job,
+        const std::vector<size_t>& variants,
+        double cutoff = std::numeric_limits<double>::infinity(),
+        const CancellationToken& token = CancellationToken()
     );
 
+    /**
+     * @brief Place turned parts of a shared job on other sheets
+     *
+     * Same as placeParts(job, variants, cutoff, token) with sheets in
+     * place of the job's, e.g. the job's sheets in another order. Not
+     * recorded (see setRecorder()).
+     *
+     * @param sheets Sheets prepared as the job's are, used in order
+     */
+    PlacementResult placeParts(
+        const PlacementJob& job,
+        const std::vector<Polygon>& sheets,
+        const std::vector<size_t>& variants,
+        double cutoff = std::numeric_limits<double>::infinity(),
+        const CancellationToken& token = CancellationToken()
+    );
+
+    /**
+     * @brief Prefix memo shared by all placeParts() calls
+     * @return Memo, or nullptr if config.placementMemoMaxMemoryMB is 0
+     */
+    const PlacementMemo* memo() const { return memo_.get(); }
+
+    /**
+     * @brief Thread pool whose idle threads help individual placements
+     *
+     * Idle threads score large candidate lists (config.parallelScoringThreshold)
+     * and try the rotations of a sheet's first part concurrently.
+     * Not to be changed while placements run.
+     *
+     * @param processor Pool, or nullptr to run everything on the caller
+     */
+    void setParallelProcessor(ParallelProcessor* processor);
+
+    /**
+     * @brief Whether a sheet's first part is turned until it fits
+     *
+     * On by default, as in the JavaScript. Genomes that only carry
+     * rotations known to fit (DeepNestConfig::feasibleRotations) do not
+     * need it. Not to be changed while placements run.
+     */
+    void setRotationRetry(bool retry);
+
+    /**
+     * @brief Time placements of shared jobs and record slow ones
+     *
+     * Not to be changed while placements run.
+     *
+     * @param recorder Recorder, or nullptr to stop recording
+     */
+    void setRecorder(std::shared_ptr<EvaluationRecorder> recorder);
+
 private:
     /**
      * @brief Configuration settings
@@ -133,6 +260,73 @@ private:
      */
     std::unique_ptr<PlacementStrategy> strategy_;
 
+    /**
+     * @brief First-sheet snapshots keyed by gene prefix (optional)
+     */
+    std::unique_ptr<PlacementMemo> memo_;
+
+    /**
+     * @brief Pool lending idle threads to placements (optional)
+     */
+    ParallelProcessor* processor_;
+
+    /**
+     * @brief See setRotationRetry()
+     */
+    bool rotationRetry_;
+
+    /**
+     * @brief See setRecorder()
+     */
+    std::shared_ptr<EvaluationRecorder> recorder_;
+
+    /**
+     * @brief Whether a part fits a sheet, by (sheet shape, part shape,
+     *        NFPCache::rotationKey of the part rotation)
+     *
+     * NFPCache keeps no entry for a part that does not fit, so without
+     * this every new sheet would redo the failing rotation trials.
+     */
+    std::map<std::tuple<uint64_t, uint64_t, int32_t>, bool> innerFits_;
+    mutable boost::mutex innerFitsMutex_;
+
+    /**
+     * @brief Raster masks by (part shape, NFPCache::rotationKey of the
+     *        part rotation, cell size), for RASTER placement
+     */
+    std::map<std::tuple<uint64_t, int32_t, double>, std::shared_ptr<const RasterMask>> rasterMasks_;
+    mutable boost::mutex rasterMasksMutex_;
+
+    /**
+     * @brief Raster mask of a rotated part, built once per shape and rotation
+     */
+    std::shared_ptr<const RasterMask> rasterMask(const Polygon& part, double cell);
+
+    /**
+     * @brief Inner NFP of the earliest rotation attempt that fits the sheet
+     *
+     * Attempt k is the part turned by k * 360/config.rotations degrees
+     * (attempt 0 is the part as given), as in the JavaScript retry loop.
+     * Attempts of distinct rotations not yet in innerFits_ run concurrently
+     * on idle threads of processor_; the earliest fitting attempt wins, so
+     * the outcome matches trying them one by one.
+     *
+     * @param sheet Sheet to fit into
+     * @param part Part as it stands
+     * @param attempts Number of attempts
+     * @param rotated Receives the turned part of the chosen attempt, or of
+     *                the last attempt if none fits
+     * @param rotatedAttempt Receives the attempt held in rotated (0 = none)
+     * @return Inner NFP, or nullptr if no attempt fits
+     */
+    NFPCache::NFPHandle firstFittingRotation(
+        const Polygon& sheet,
+        const Polygon& part,
+        int attempts,
+        Polygon& rotated,
+        int& rotatedAttempt
+    );
+
     /**
      * @brief Find best position for a part on current sheet
      *
@@ -161,25 +355,53 @@ private:
      *
      * @param finalNfp NFP polygons after difference operation
      * @param part The part being placed (needed to subtract reference point)
-     * @return List of candidate placement positions
+     * @param positions Receives the candidate placement positions
+     */
+    void extractCandidatePositions(
+        const std::vector<const Polygon*>& finalNfp,
+        const Polygon& part,
+        std::vector<Point>& positions
+    ) const;
+
+    /**
+     * @brief extractCandidatePositions() for integer geometry mode
+     *
+     * @param finalPaths NFP regions after the difference, at config clipperScale
+     * @param part The part being placed, snapped to the same grid
+     * @param positions Receives the candidate placement positions
      */
-    std::vector<Point> extractCandidatePositions(
-        const std::vector<Polygon>& finalNfp,
-        const Polygon& part
+    void extractCandidatePositions(
+        const Clipper2Lib::Paths64& finalPaths,
+        const Polygon& part,
+        std::vector<Point>& positions
     ) const;
 
+    /**
+     * @brief Place parts already turned by their rotation
+     *
+     * Shared by both placeParts() overloads.
+     */
+    PlacementResult placeRotated(
+        const std::vector<Polygon>& sheets,
+        const std::vector<const Polygon*>& rotatedParts,
+        double cutoff,
+        const CancellationToken& token
+    );
+
     /**
      * @brief Calculate merged length for all placed parts
      *
      * Detects aligned edges between parts to optimize cutting operations.
+     * placeParts() sums the merges of the chosen positions instead and only
+     * runs this full pass with config.validateMergedLines.
      *
      * @param allPlacements All placements across all sheets
-     * @param originalParts Original parts (before rotation)
+     * @param originalParts Parts turned to their placement rotation
      * @return Total merged line length
      */
     double calculateTotalMergedLength(
         const std::vector<std::vector<Placement>>& allPlacements,
-        const std::vector<Polygon>& originalParts
+        const std::vector<const Polygon*>& originalParts
     ) const;
 
     /**
@@ -195,24 +417,36 @@ private:
     ) const;
 
     /**
-     * @brief Check if two parts have significant overlap
+     * @brief Check if two placed parts have significant overlap
      *
-     * Uses Clipper2 intersection to detect overlaps between parts.
-     * Returns true if intersection area exceeds config.overlapTolerance.
+     * Works on the outlines in scaled world coordinates. Edges that reach
+     * into the other part's bounds are tested for contact first; only when
+     * the boundaries touch or cross is the overlap measured with a Clipper2
+     * intersection. Otherwise the parts are disjoint or one contains the
+     * other, which a point-in-polygon test decides.
      *
      * This implements the overlap detection from JavaScript background.js:1210-1241.
      * Parts are considered overlapping if their intersection area is greater than
      * the configured tolerance (default 0.0001).
      *
-     * @param partA First part
-     * @param positionA Position of first part
-     * @param partB Second part
-     * @param positionB Position of second part
-     * @param config Configuration with overlapTolerance
+     * @param pathA First part, scaled by clipperScale and translated
+     * @param pathB Second part, scaled by clipperScale and translated
+     * @param config Configuration with overlapTolerance and clipperScale
      * @return true if overlap area > overlapTolerance
      *
      * @see DeepNestConfig::overlapTolerance
      */
+    bool hasSignificantOverlap(
+        const Clipper2Lib::Path64& pathA,
+        const Clipper2Lib::Path64& pathB,
+        const DeepNestConfig& config
+    ) const;
+
+    /**
+     * @brief Check if two parts at the given positions have significant overlap
+     *
+     * Converts both parts to scaled world paths and runs the check above.
+     */
     bool hasSignificantOverlap(
         const Polygon& partA,
         const Point& positionA,
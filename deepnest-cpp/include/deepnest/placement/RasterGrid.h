@@ -0,0 +1,105 @@
+#ifndef DEEPNEST_RASTER_GRID_H
+#define DEEPNEST_RASTER_GRID_H
+
+#include "../core/Polygon.h"
+#include "../core/BoundingBox.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Cells of a square grid that a part's outline covers
+ *
+ * Anchored at the top-left corner of the part's bounds: cell (0, 0) spans
+ * [bounds.x, bounds.x + cell) x [bounds.y, bounds.y + cell). A cell is
+ * covered when its interior meets the outline or its holes, so a part's
+ * holes are taken as filled. The mask is a covering: wherever every
+ * covered cell is free the part itself is clear.
+ */
+struct RasterMask {
+    double cell = 0.0;
+    BoundingBox bounds;  // Bounds of the part the mask was built from
+    int rows = 0;
+    int cols = 0;
+    std::vector<std::vector<std::pair<int, int>>> runs;  // Per row, [first, last) columns
+
+    RasterMask() = default;
+
+    /**
+     * @param part Part as placed (rotated)
+     * @param cell Cell size, in part units
+     */
+    RasterMask(const Polygon& part, double cell);
+
+    size_t memoryBytes() const;
+};
+
+/**
+ * @brief Occupancy bitmap of a sheet for raster placement
+ *
+ * One bit per cell, 64 cells per word, row-major. A cell is blocked when
+ * it is not entirely inside the sheet (outside its outline, in one of its
+ * holes, or cut by its boundary) or when a part inserted on it covers it.
+ *
+ * find() slides a RasterMask over the bitmap and returns the free
+ * position at the lowest column, then the lowest row, which is where
+ * gravity placement puts a part. For each candidate row the cells the
+ * mask would hit are ORed together one word at a time: every run of the
+ * mask dilates its grid row by shifted ORs, doubling the span each step,
+ * so a row costs O(words x log run) instead of O(cells x run).
+ */
+class RasterGrid {
+public:
+    RasterGrid() = default;
+
+    /**
+     * @param sheet Sheet outline with its holes as children
+     * @param cell Cell size, in sheet units
+     */
+    RasterGrid(const Polygon& sheet, double cell);
+
+    double cellSize() const { return cell_; }
+
+    /**
+     * @brief Find where a mask goes
+     *
+     * @param col Receives the column of the mask's cell (0, 0)
+     * @param row Receives its row
+     * @return False if no position is free
+     */
+    bool find(const RasterMask& mask, int& col, int& row) const;
+
+    /**
+     * @brief World position of the top-left corner of a cell
+     */
+    Point corner(int col, int row) const;
+
+    /**
+     * @brief Block the cells of a mask placed at a position from find()
+     *
+     * The mask is also blocked one cell further left and up, where the
+     * exact placement may have slid it.
+     */
+    void insert(const RasterMask& mask, int col, int row);
+
+    size_t memoryBytes() const;
+
+private:
+    /**
+     * @brief Block columns [first, last) of a row, clamped to the grid
+     */
+    void block(int row, int first, int last);
+
+    BoundingBox sheet_;
+    double cell_ = 0.0;
+    int rows_ = 0;
+    int cols_ = 0;
+    size_t words_ = 0;            // Words per row
+    std::vector<uint64_t> bits_;  // 1 = blocked
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_RASTER_GRID_H
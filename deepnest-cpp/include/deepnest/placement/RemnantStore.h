@@ -0,0 +1,110 @@
+#ifndef DEEPNEST_REMNANT_STORE_H
+#define DEEPNEST_REMNANT_STORE_H
+
+#include "../core/Polygon.h"
+#include <boost/thread/mutex.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Index of offcut sheets (remnants) kept for later jobs
+ *
+ * Remnants are indexed by usable area and by the size of their bounding
+ * box, so candidates() can pick the offcuts a part set may use without
+ * testing every stored outline. Both filters are necessary conditions
+ * only: a candidate can still turn out too narrow for every part, but a
+ * remnant that could hold one of the parts is never left out. Candidates
+ * come smallest first, so a job uses up small offcuts before large ones.
+ *
+ * DeepNestSolver::addRemnants() places candidates ahead of the job's
+ * sheets; the engine computes the inner NFPs of sheet types after the
+ * first in the background (NestingEngine::step), so the extra sheets do
+ * not delay the first generation.
+ */
+class RemnantStore {
+public:
+    /**
+     * @brief A stored offcut
+     */
+    struct Remnant {
+        uint64_t id = 0;
+        Polygon outline;
+        double area = 0.0;      // Outline area less holes
+        double width = 0.0;     // Bounding box
+        double height = 0.0;
+        std::string name;
+    };
+
+    RemnantStore();
+
+    /**
+     * @brief Add an offcut
+     *
+     * @param outline Remnant shape (at least three points)
+     * @param name Optional name, e.g. of the job it was cut from
+     * @return Id of the remnant
+     * @throws std::invalid_argument if the outline has no area
+     */
+    uint64_t add(const Polygon& outline, const std::string& name = "");
+
+    /**
+     * @brief Remove an offcut, e.g. once a job has used it
+     *
+     * @return False if no remnant has the id
+     */
+    bool remove(uint64_t id);
+
+    /**
+     * @brief Copy of a remnant
+     *
+     * @return False if no remnant has the id
+     */
+    bool get(uint64_t id, Remnant& remnant) const;
+
+    size_t size() const;
+
+    /**
+     * @brief Remnants that may hold at least one of the parts
+     *
+     * A remnant qualifies if its area is at least the part's and the
+     * part's shorter bounding side fits within the remnant's diagonal.
+     *
+     * @param parts Parts of the job
+     * @param limit Candidates to return at most (0 = all)
+     * @return Candidates in ascending area
+     */
+    std::vector<Remnant> candidates(const std::vector<Polygon>& parts, size_t limit = 0) const;
+
+    /**
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Replace the stored remnants with a file's
+     *
+     * @throws std::runtime_error if the file cannot be read or is not a remnant store
+     */
+    void load(const std::string& path);
+
+private:
+    mutable boost::mutex mutex_;
+    uint64_t nextId_;
+    std::unordered_map<uint64_t, Remnant> remnants_;
+
+    /**
+     * @brief Area -> id, for the smallest-first candidate scan
+     */
+    std::multimap<double, uint64_t> byArea_;
+
+    void insert(Remnant remnant);
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_REMNANT_STORE_H
@@ -0,0 +1,103 @@
+#ifndef DEEPNEST_SHAPE_CACHE_H
+#define DEEPNEST_SHAPE_CACHE_H
+
+#include "../core/Polygon.h"
+#include <boost/thread/mutex.hpp>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace deepnest {
+
+/**
+ * @brief Bounded, thread-safe table of spacing offsets and turned parts
+ *        kept across nesting runs
+ *
+ * NestingEngine offsets every distinct shape once per run and PlacementJob
+ * turns every part to each rotation once per run. Runs over the same
+ * catalog (see NestingDaemon) can take both from here instead. Offsets are
+ * keyed by PersistentNFPStore::geometryHash, the offset and the curve
+ * tolerance; turned parts by outline fingerprint, rotation, Clipper scale
+ * and grid snapping. A turned part found here shares its Clipper path and
+ * coordinates buffer with the stored copy; callers set id and source.
+ * When full, the oldest entries are dropped first.
+ */
+class ShapeCache {
+public:
+    /**
+     * @brief Cache counters
+     */
+    struct Statistics {
+        size_t lookups = 0;  // find calls
+        size_t hits = 0;     // find calls that returned a shape
+        size_t entries = 0;  // Shapes held
+    };
+
+    /**
+     * @param maxEntries Shapes to keep at most
+     */
+    explicit ShapeCache(size_t maxEntries);
+
+    /**
+     * @brief Spacing offset of a geometry (NestingEngine::applySpacing)
+     *
+     * @return False if it is not cached
+     */
+    bool findOffset(uint64_t geometry, double offset, double curveTolerance, Polygon& outline);
+
+    void insertOffset(uint64_t geometry, double offset, double curveTolerance, const Polygon& outline);
+
+    /**
+     * @brief Outline turned to rotation, as PlacementJob stores it
+     *
+     * @return False if it is not cached
+     */
+    bool findTurned(uint64_t fingerprint, double rotation, double clipperScale, bool snapToGrid,
+                    Polygon& turned);
+
+    void insertTurned(uint64_t fingerprint, double rotation, double clipperScale, bool snapToGrid,
+                      const Polygon& turned);
+
+    Statistics statistics() const;
+
+    void clear();
+
+private:
+    struct Key {
+        uint64_t shape;     // Geometry hash or fingerprint
+        double scale;       // Offset, or Clipper scale
+        double tolerance;   // Curve tolerance (offsets only)
+        int32_t rotation;   // NFPCache::rotationKey, -1 for offsets
+        bool snapped;
+
+        bool operator==(const Key& other) const {
+            return shape == other.shape && scale == other.scale && tolerance == other.tolerance &&
+                   rotation == other.rotation && snapped == other.snapped;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    bool find(const Key& key, Polygon& shape);
+
+    void insert(const Key& key, const Polygon& shape);
+
+    size_t maxEntries_;
+    size_t lookups_;
+    size_t hits_;
+
+    std::unordered_map<Key, Polygon, KeyHash> entries_;
+
+    /**
+     * @brief Keys in insertion order, for eviction
+     */
+    std::deque<Key> order_;
+
+    mutable boost::mutex mutex_;
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_SHAPE_CACHE_H
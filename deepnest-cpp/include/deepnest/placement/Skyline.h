@@ -0,0 +1,57 @@
+#ifndef DEEPNEST_SKYLINE_H
+#define DEEPNEST_SKYLINE_H
+
+#include "../core/Point.h"
+#include "../core/BoundingBox.h"
+#include <vector>
+
+namespace deepnest {
+
+/**
+ * @brief Left-packing skyline of a rectangular sheet
+ *
+ * Tracks, for bands of y, the x from which the sheet is free. Axis-aligned
+ * rectangles are placed against the skyline at the lowest x, then the
+ * lowest y, which is where gravity placement puts the first part of a
+ * sheet. Space beneath an overhang is not reused. Both operations are
+ * linear in the number of bands, which stays small next to the NFP path.
+ */
+class Skyline {
+public:
+    Skyline() = default;
+
+    /**
+     * @param sheet Bounds of the (rectangular) sheet
+     */
+    explicit Skyline(const BoundingBox& sheet);
+
+    /**
+     * @brief Find where a width x height rectangle goes
+     *
+     * @param corner Receives the top-left corner (lowest x, then lowest y)
+     * @return False if the rectangle does not fit against the skyline
+     */
+    bool find(double width, double height, Point& corner) const;
+
+    /**
+     * @brief Add a rectangle at a corner returned by find()
+     */
+    void insert(const Point& corner, double width, double height);
+
+private:
+    /**
+     * @brief Band [y, y + length) of the sheet, free from x on
+     */
+    struct Band {
+        double y;
+        double length;
+        double x;
+    };
+
+    BoundingBox sheet_;
+    std::vector<Band> bands_;  // Sorted by y, covering the sheet height
+};
+
+} // namespace deepnest
+
+#endif // DEEPNEST_SKYLINE_H
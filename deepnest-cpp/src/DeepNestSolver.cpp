@@ -1,12 +1,79 @@
 #include "../include/deepnest/DeepNestSolver.h"
+#include "../include/deepnest/converters/JobFile.h"
 #include "../include/deepnest/geometry/GeometryUtil.h"
 #include "../include/deepnest/geometry/PolygonOperations.h"
-#include <stdexcept>
-#include <thread>
+#include "../include/deepnest/nfp/PersistentNFPStore.h"
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/thread/locks.hpp>
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace deepnest {
 
+namespace {
+
+// Results kept by a progressive run, as NestingEngine keeps them
+const size_t MAX_SAVED_RESULTS = 10;
+
+// Settings that change geometry without changing the parts' outlines:
+// layouts and cached NFPs of a run with other values cannot be reused
+std::string progressiveSettings(const DeepNestConfig& config) {
+    return std::to_string(config.spacing) + ' ' + std::to_string(config.curveTolerance) + ' ' +
+           std::to_string(config.clipperScale) + ' ' + std::to_string(config.rotations) + ' ' +
+           std::to_string(config.integerGeometry) + ' ' + std::to_string(config.nfpRotationEquivariant);
+}
+
+// Timer and outcome of a startAsync() run, shared by its handlers
+struct AsyncRun {
+    explicit AsyncRun(const boost::asio::any_io_executor& executor)
+        : timer(executor)
+    {}
+
+    boost::asio::steady_timer timer;
+    std::promise<NestResult> outcome;
+};
+
+// One step of an asynchronous run; schedules the next or settles outcome
+void stepAsync(DeepNestSolver* solver, const std::shared_ptr<AsyncRun>& run, int stepDelayMs) {
+    bool running = false;
+    try {
+        running = solver->step();
+    } catch (...) {
+        solver->stop();
+        run->outcome.set_exception(std::current_exception());
+        return;
+    }
+
+    if (!running) {
+        const std::shared_ptr<const NestResult> best = solver->getBestResult();
+        if (best) {
+            run->outcome.set_value(*best);
+        } else {
+            run->outcome.set_exception(std::make_exception_ptr(
+                std::runtime_error("Nesting ended without a result")));
+        }
+        return;
+    }
+
+    run->timer.expires_after(std::chrono::milliseconds(stepDelayMs));
+    run->timer.async_wait([solver, run, stepDelayMs](const boost::system::error_code& ec) {
+        if (ec) {
+            solver->stop();
+            run->outcome.set_exception(std::make_exception_ptr(
+                std::runtime_error("Nesting executor shut down: " + ec.message())));
+            return;
+        }
+        stepAsync(solver, run, stepDelayMs);
+    });
+}
+
+} // anonymous namespace
+
 DeepNestSolver::DeepNestSolver()
     : config_(DeepNestConfig::getInstance())
     , running_(false)
@@ -14,21 +81,9 @@ DeepNestSolver::DeepNestSolver()
 }
 
 DeepNestSolver::DeepNestSolver(const DeepNestConfig& config)
-    : config_(DeepNestConfig::getInstance())
+    : config_(config)
     , running_(false)
 {
-    // Copy configuration values
-    config_.clipperScale = config.clipperScale;
-    config_.curveTolerance = config.curveTolerance;
-    config_.spacing = config.spacing;
-    config_.rotations = config.rotations;
-    config_.populationSize = config.populationSize;
-    config_.mutationRate = config.mutationRate;
-    config_.threads = config.threads;
-    config_.placementType = config.placementType;
-    config_.mergeLines = config.mergeLines;
-    config_.timeRatio = config.timeRatio;
-    config_.simplify = config.simplify;
 }
 
 DeepNestSolver::~DeepNestSolver() {
@@ -70,8 +125,9 @@ void DeepNestSolver::setThreads(int threads) {
 }
 
 void DeepNestSolver::setPlacementType(const std::string& type) {
-    if (type != "gravity" && type != "boundingbox" && type != "convexhull") {
-        throw std::invalid_argument("Placement type must be 'gravity', 'box', or 'convexhull'");
+    if (type != "gravity" && type != "boundingbox" && type != "convexhull" && type != "skyline" &&
+        type != "raster") {
+        throw std::invalid_argument("Placement type must be 'gravity', 'box', 'convexhull', 'skyline', or 'raster'");
     }
     config_.placementType = type;
 }
@@ -96,6 +152,10 @@ const DeepNestConfig& DeepNestSolver::getConfig() const {
     return config_;
 }
 
+DeepNestConfig& DeepNestSolver::getConfig() {
+    return config_;
+}
+
 void DeepNestSolver::addPart(const Polygon& polygon, int quantity, const std::string& name) {
     if (quantity < 1) {
         throw std::invalid_argument("Part quantity must be at least 1");
@@ -115,7 +175,7 @@ void DeepNestSolver::addPart(const Polygon& polygon, int quantity, const std::st
 
     // Clean polygon (remove self-intersections)
     // Use PolygonOperations::cleanPolygon which uses Clipper's SimplifyPolygon
-    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(polygon.points);
+    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(polygon.points, config_.getClipperScale());
     
     if (cleanedPoints.size() < 3) {
         return;
@@ -142,7 +202,7 @@ void DeepNestSolver::addPart(const Polygon& polygon, int quantity, const std::st
         for (const auto& hole : simplifiedPoly.children) {
             if (hole.points.size() < 3) continue;
 
-            std::vector<Point> cleanedHole = PolygonOperations::cleanPolygon(hole.points);
+            std::vector<Point> cleanedHole = PolygonOperations::cleanPolygon(hole.points, config_.getClipperScale());
             if (cleanedHole.size() < 3) continue;
 
             std::vector<Point> simplifiedHole = GeometryUtil::simplifyPolygon(
@@ -177,7 +237,7 @@ void DeepNestSolver::addSheet(const Polygon& polygon, int quantity, const std::s
         return;
     }
 
-    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(polygon.points);
+    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(polygon.points, config_.getClipperScale());
     if (cleanedPoints.size() < 3) {
         return;
     }
@@ -200,7 +260,7 @@ void DeepNestSolver::addSheet(const Polygon& polygon, int quantity, const std::s
         for (const auto& hole : simplifiedPoly.children) {
             if (hole.points.size() < 3) continue;
 
-            std::vector<Point> cleanedHole = PolygonOperations::cleanPolygon(hole.points);
+            std::vector<Point> cleanedHole = PolygonOperations::cleanPolygon(hole.points, config_.getClipperScale());
             if (cleanedHole.size() < 3) continue;
 
             std::vector<Point> simplifiedHole = GeometryUtil::simplifyPolygon(
@@ -228,6 +288,29 @@ void DeepNestSolver::clearParts() {
     parts_.clear();
 }
 
+std::vector<uint64_t> DeepNestSolver::addRemnants(const RemnantStore& store, size_t limit) {
+    std::vector<Polygon> parts;
+    parts.reserve(parts_.size());
+    for (const auto& part : parts_) {
+        parts.push_back(part.polygon);
+    }
+
+    const size_t before = sheets_.size();
+    std::vector<uint64_t> added;
+    for (const auto& remnant : store.candidates(parts, limit)) {
+        const size_t count = sheets_.size();
+        addSheet(remnant.outline, 1,
+                 remnant.name.empty() ? "remnant " + std::to_string(remnant.id) : remnant.name);
+        if (sheets_.size() > count) {
+            added.push_back(remnant.id);
+        }
+    }
+
+    // Offcuts first, in candidate order
+    std::rotate(sheets_.begin(), sheets_.begin() + static_cast<std::ptrdiff_t>(before), sheets_.end());
+    return added;
+}
+
 void DeepNestSolver::clearSheets() {
     sheets_.clear();
 }
@@ -245,7 +328,70 @@ size_t DeepNestSolver::getSheetCount() const {
     return sheets_.size();
 }
 
+void DeepNestSolver::loadJob(const std::string& path) {
+    JobFile job;
+    if (!job.open(path)) {
+        throw std::runtime_error(job.error());
+    }
+
+    config_.loadFromJsonData(job.config());
+
+    parts_.clear();
+    sheets_.clear();
+    for (size_t i = 0; i < job.itemCount(); ++i) {
+        if (job.isSheet(i)) {
+            sheets_.push_back(SheetSpec(job.polygon(i), job.quantity(i), job.name(i)));
+        } else {
+            parts_.push_back(PartSpec(job.polygon(i), job.quantity(i), job.name(i)));
+        }
+    }
+
+    // The NFPs were computed with the job's spacing and curve tolerance,
+    // which the store keys on; append() skips those it already holds
+    if (job.nfpCount() > 0 && !config_.nfpStorePath.empty()) {
+        PersistentNFPStore store(config_.spacing, config_.curveTolerance);
+        if (store.open(config_.nfpStorePath)) {
+            for (size_t i = 0; i < job.nfpCount(); ++i) {
+                store.append(job.nfpKey(i), job.nfp(i));
+            }
+        }
+    }
+}
+
+void DeepNestSolver::saveJob(const std::string& path) const {
+    std::vector<JobFile::Item> items;
+    items.reserve(parts_.size() + sheets_.size());
+    for (const auto& part : parts_) {
+        items.emplace_back(part.polygon, part.quantity, part.name, false);
+    }
+    for (const auto& sheet : sheets_) {
+        items.emplace_back(sheet.polygon, sheet.quantity, sheet.name, true);
+    }
+    JobFile::write(path, config_.toJsonData(), items);
+}
+
 void DeepNestSolver::start(int maxGenerations) {
+    prepareEngine(config_.progressive);
+
+    // Start engine
+    engine_->start(engineProgressCallback(), engineResultCallback(), maxGenerations);
+
+    running_ = true;
+}
+
+void DeepNestSolver::resume(const std::string& checkpointPath, int maxGenerations) {
+    prepareEngine();
+
+    if (!engine_->loadCheckpoint(checkpointPath)) {
+        throw std::runtime_error("Cannot resume from checkpoint " + checkpointPath +
+                                 ": missing, damaged or from another job");
+    }
+    engine_->start(engineProgressCallback(), engineResultCallback(), maxGenerations);
+
+    running_ = true;
+}
+
+void DeepNestSolver::prepareEngine(bool progressive) {
     if (running_) {
         throw std::runtime_error("Nesting is already running");
     }
@@ -258,6 +404,14 @@ void DeepNestSolver::start(int maxGenerations) {
         throw std::runtime_error("No sheets added. Use addSheet() to add sheets.");
     }
 
+    // The previous nest, taken before its engine goes; layouts and NFPs of
+    // other geometry settings are of no use
+    const std::string settings = progressiveSettings(config_);
+    std::shared_ptr<const NestResult> previous;
+    if (progressive && settings == nfpCacheSettings_) {
+        previous = getBestResult();
+    }
+
     // CRITICAL FIX: Explicitly destroy old engine and release all resources
     // before creating a new one to prevent memory corruption and dangling references
     if (engine_) {
@@ -267,8 +421,30 @@ void DeepNestSolver::start(int maxGenerations) {
         engine_.reset();
     }
 
+    // Reuse the worker threads of the previous run unless their settings changed
+    const auto backend = ParallelProcessor::backendFromName(config_.taskScheduler);
+    const WorkerAffinity affinity{config_.pinWorkerThreads, config_.numaScheduling};
+    if (!processor_ || processor_->getThreadCount() != config_.threads ||
+        processor_->getBackend() != backend || processor_->getAffinity() != affinity) {
+        processor_ = std::make_shared<ParallelProcessor>(config_.threads, backend, affinity);
+    }
+
+    // Progressive runs share one NFP cache, so NFPs of the parts they
+    // have in common are not computed again
+    if (!config_.progressive) {
+        nfpCache_.reset();
+    } else if (!nfpCache_ || settings != nfpCacheSettings_) {
+        nfpCache_ = std::make_shared<NFPCache>();
+    }
+    if (nfpCache_) {
+        nfpCache_->setMemoryLimit(static_cast<size_t>(config_.nfpCacheMaxMemoryMB) * 1024 * 1024);
+        nfpCache_->setCompactStorage(config_.nfpCacheCompact ? config_.getClipperScale() : 0.0);
+    }
+    nfpCacheSettings_ = settings;
+
     // Create new nesting engine with clean state
-    engine_ = std::make_unique<NestingEngine>(config_);
+    engine_ = std::make_unique<NestingEngine>(config_, processor_, nfpCache_);
+    processor_->resetContentionStats();
 
     // Convert PartSpec to Polygon vectors
     std::vector<Polygon> partPolygons;
@@ -288,13 +464,220 @@ void DeepNestSolver::start(int maxGenerations) {
         sheetQuantities.push_back(sheet.quantity);
     }
 
+    frozen_ = NestResult();
+    engineSheets_.clear();
+    std::atomic_store(&results_, std::make_shared<const ResultHistory>());
+    std::vector<std::pair<int, double>> genome;
+    if (previous) {
+        genome = prepareProgressive(*previous, partQuantities, sheetQuantities);
+    }
+    nestedParts_ = parts_;
+    nestedSheets_ = sheets_;
+
     // Initialize engine
     engine_->initialize(partPolygons, partQuantities, sheetPolygons, sheetQuantities);
+    if (!genome.empty()) {
+        engine_->seed(genome);
+    }
+}
 
-    // Start engine
-    engine_->start(progressCallback_, resultCallback_, maxGenerations);
+std::vector<std::pair<int, double>> DeepNestSolver::prepareProgressive(
+    const NestResult& previous,
+    std::vector<int>& partQuantities,
+    std::vector<int>& sheetQuantities
+) {
+    // Parts and sheets of the previous run by index of the current ones
+    std::unordered_map<uint64_t, int> partOf;
+    for (size_t i = 0; i < parts_.size(); ++i) {
+        partOf.emplace(PersistentNFPStore::geometryHash(parts_[i].polygon), static_cast<int>(i));
+    }
+    std::unordered_map<uint64_t, int> sheetOf;
+    for (size_t i = 0; i < sheets_.size(); ++i) {
+        sheetOf.emplace(PersistentNFPStore::geometryHash(sheets_[i].polygon), static_cast<int>(i));
+    }
+    std::vector<int> partNow;
+    for (const auto& part : nestedParts_) {
+        auto it = partOf.find(PersistentNFPStore::geometryHash(part.polygon));
+        partNow.push_back(it != partOf.end() ? it->second : -1);
+    }
+    std::vector<int> sheetNow;  // By sheet copy
+    for (const auto& sheet : nestedSheets_) {
+        auto it = sheetOf.find(PersistentNFPStore::geometryHash(sheet.polygon));
+        sheetNow.insert(sheetNow.end(), static_cast<size_t>(sheet.quantity), it != sheetOf.end() ? it->second : -1);
+    }
+    auto current = [&partNow](int source) {
+        return source >= 0 && static_cast<size_t>(source) < partNow.size() ? partNow[source] : -1;
+    };
+
+    // First copy of each sheet among the sheets with quantities expanded
+    std::vector<size_t> firstCopy(sheets_.size(), 0);
+    for (size_t i = 1; i < sheets_.size(); ++i) {
+        firstCopy[i] = firstCopy[i - 1] + static_cast<size_t>(sheets_[i - 1].quantity);
+    }
+
+    std::vector<int> partsLeft = partQuantities;
+    std::vector<int> sheetsLeft = sheetQuantities;
+    std::vector<int> sheetsKept(sheets_.size(), 0);
+    std::vector<bool> kept(previous.placements.size(), false);
+    NestResult frozen = NestResult();
+    frozen.individualIndex = -1;
+    for (size_t s = 0; s + 1 < previous.placements.size(); ++s) {
+        const size_t copy = previous.sheetIndex(s);
+        const int sheet = copy < sheetNow.size() ? sheetNow[copy] : -1;
+        if (sheet < 0 || sheetsLeft[sheet] == 0 || previous.placements[s].empty()) {
+            continue;
+        }
 
-    running_ = true;
+        std::unordered_map<int, int> needed;
+        bool wanted = true;
+        for (const auto& placement : previous.placements[s]) {
+            const int part = current(placement.source);
+            if (part < 0 || ++needed[part] > partsLeft[part]) {
+                wanted = false;
+                break;
+            }
+        }
+        if (!wanted) {
+            continue;
+        }
+
+        for (const auto& need : needed) {
+            partsLeft[need.first] -= need.second;
+        }
+        sheetsLeft[sheet]--;
+        kept[s] = true;
+
+        std::vector<PlacementWorker::Placement> placements = previous.placements[s];
+        for (auto& placement : placements) {
+            placement.source = current(placement.source);
+        }
+        frozen.placements.push_back(std::move(placements));
+        frozen.sheets.push_back(firstCopy[sheet] + static_cast<size_t>(sheetsKept[sheet]++));
+        const double area = std::abs(sheets_[sheet].polygon.area());
+        frozen.area += area;
+        frozen.fitness += area;
+    }
+
+    // Nothing kept, or nothing left to nest: the whole order is re-nested
+    const bool partial = !frozen.placements.empty() &&
+        std::accumulate(partsLeft.begin(), partsLeft.end(), 0) > 0 &&
+        std::accumulate(sheetsLeft.begin(), sheetsLeft.end(), 0) > 0;
+    if (partial) {
+        partQuantities = partsLeft;
+        sheetQuantities = sheetsLeft;
+        frozen_ = std::move(frozen);
+        for (size_t i = 0; i < sheets_.size(); ++i) {
+            for (int q = 0; q < sheetsLeft[i]; ++q) {
+                engineSheets_.push_back(firstCopy[i] + static_cast<size_t>(sheetsKept[i] + q));
+            }
+        }
+    }
+
+    std::vector<std::pair<int, double>> genome;
+    for (size_t s = 0; s < previous.placements.size(); ++s) {
+        if (partial && kept[s]) {
+            continue;
+        }
+        for (const auto& placement : previous.placements[s]) {
+            const int part = current(placement.source);
+            if (part >= 0) {
+                genome.emplace_back(part, placement.rotation);
+            }
+        }
+    }
+    return genome;
+}
+
+NestResult DeepNestSolver::combine(const NestResult& result) const {
+    NestResult combined = result;
+    combined.placements = frozen_.placements;
+    combined.placements.insert(combined.placements.end(), result.placements.begin(), result.placements.end());
+    combined.sheets = frozen_.sheets;
+    for (size_t i = 0; i < result.placements.size(); ++i) {
+        const size_t sheet = result.sheetIndex(i);
+        combined.sheets.push_back(sheet < engineSheets_.size() ? engineSheets_[sheet] : sheet);
+    }
+    combined.fitness += frozen_.fitness;
+    combined.area += frozen_.area;
+    return combined;
+}
+
+NestingEngine::ProgressCallback DeepNestSolver::engineProgressCallback() {
+    return [this](const NestProgress& progress) {
+        if (!progressCallback_) {
+            return;
+        }
+        if (frozen_.placements.empty()) {
+            progressCallback_(progress);
+            return;
+        }
+        NestProgress combined = progress;
+        combined.bestFitness = results_->empty() ? std::numeric_limits<double>::max() : results_->front()->fitness;
+        progressCallback_(combined);
+    };
+}
+
+NestingEngine::ResultCallback DeepNestSolver::engineResultCallback() {
+    return [this](const NestResult& result) {
+        if (frozen_.placements.empty()) {
+            if (resultCallback_) {
+                resultCallback_(result);
+            }
+            notifyResultWaiters(&result);
+            return;
+        }
+
+        auto combined = std::make_shared<const NestResult>(combine(result));
+        auto results = std::make_shared<ResultHistory>(*results_);
+        auto position = std::lower_bound(results->begin(), results->end(), combined,
+            [](const std::shared_ptr<const NestResult>& a, const std::shared_ptr<const NestResult>& b) {
+                return a->fitness < b->fitness;
+            });
+        results->insert(position, combined);
+        if (results->size() > MAX_SAVED_RESULTS) {
+            results->resize(MAX_SAVED_RESULTS);
+        }
+        std::atomic_store(&results_, std::shared_ptr<const ResultHistory>(std::move(results)));
+        if (resultCallback_) {
+            resultCallback_(*combined);
+        }
+        notifyResultWaiters(combined.get());
+    };
+}
+
+std::future<NestResult> DeepNestSolver::startAsync(const boost::asio::any_io_executor& executor,
+                                                   int maxGenerations, int stepDelayMs) {
+    start(maxGenerations);
+
+    auto run = std::make_shared<AsyncRun>(executor);
+    std::future<NestResult> outcome = run->outcome.get_future();
+    const int delay = std::max(0, stepDelayMs);
+    boost::asio::post(executor, [this, run, delay]() {
+        stepAsync(this, run, delay);
+    });
+    return outcome;
+}
+
+std::future<NestResult> DeepNestSolver::nextResult() {
+    boost::lock_guard<boost::mutex> lock(resultWaitersMutex_);
+    resultWaiters_.emplace_back();
+    return resultWaiters_.back().get_future();
+}
+
+void DeepNestSolver::notifyResultWaiters(const NestResult* result) {
+    std::vector<std::promise<NestResult>> waiters;
+    {
+        boost::lock_guard<boost::mutex> lock(resultWaitersMutex_);
+        waiters.swap(resultWaiters_);
+    }
+    for (auto& waiter : waiters) {
+        if (result) {
+            waiter.set_value(*result);
+        } else {
+            waiter.set_exception(std::make_exception_ptr(
+                std::runtime_error("Nesting ended before another result")));
+        }
+    }
 }
 
 void DeepNestSolver::stop() {
@@ -302,6 +685,7 @@ void DeepNestSolver::stop() {
         engine_->stop();
     }
     running_ = false;
+    notifyResultWaiters(nullptr);
 }
 
 bool DeepNestSolver::step() {
@@ -313,6 +697,7 @@ bool DeepNestSolver::step() {
 
     if (!stillRunning) {
         running_ = false;
+        notifyResultWaiters(nullptr);
     }
 
     return stillRunning;
@@ -328,9 +713,9 @@ void DeepNestSolver::runUntilComplete(int maxGenerations, int stepDelayMs) {
         start(maxGenerations);
     }
 
-    // Run until complete
+    // Run until complete, stepping whenever an evaluation finishes
     while (step()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(stepDelayMs));
+        engine_->waitForEvaluation(stepDelayMs);
     }
 }
 
@@ -339,46 +724,77 @@ NestProgress DeepNestSolver::getProgress() const {
         NestProgress progress;
         progress.generation = 0;
         progress.evaluationsCompleted = 0;
+        progress.fitnessMemoHits = 0;
         progress.bestFitness = std::numeric_limits<double>::max();
         progress.percentComplete = 0.0;
         return progress;
     }
 
-    return engine_->getProgress();
+    NestProgress progress = engine_->getProgress();
+    if (!frozen_.placements.empty()) {
+        const std::shared_ptr<const ResultHistory> results = std::atomic_load(&results_);
+        progress.bestFitness = results->empty() ? std::numeric_limits<double>::max() : results->front()->fitness;
+    }
+    return progress;
 }
 
-const NestResult* DeepNestSolver::getBestResult() const {
+std::shared_ptr<const NestResult> DeepNestSolver::getBestResult() const {
     if (!engine_) {
         return nullptr;
     }
+    if (!frozen_.placements.empty()) {
+        const std::shared_ptr<const ResultHistory> results = std::atomic_load(&results_);
+        return results->empty() ? nullptr : results->front();
+    }
 
     return engine_->getBestResult();
 }
 
-const std::vector<NestResult>& DeepNestSolver::getResults() const {
-    static const std::vector<NestResult> emptyResults;
-
+std::shared_ptr<const ResultHistory> DeepNestSolver::getResults() const {
     if (!engine_) {
-        return emptyResults;
+        return std::make_shared<const ResultHistory>();
+    }
+    if (!frozen_.placements.empty()) {
+        return std::atomic_load(&results_);
     }
 
     return engine_->getResults();
 }
 
+NFPCache::Statistics DeepNestSolver::getNfpCacheStatistics() const {
+    if (!engine_) {
+        return NFPCache::Statistics();
+    }
+
+    return engine_->getNfpCacheStatistics();
+}
+
+ContentionStats DeepNestSolver::getContentionStats() const {
+    if (!engine_) {
+        return ContentionStats();
+    }
+
+    return engine_->getContentionStats();
+}
+
+MemoryUsage DeepNestSolver::getMemoryUsage() const {
+    if (!engine_) {
+        return MemoryUsage();
+    }
+
+    return engine_->getMemoryUsage();
+}
+
 void DeepNestSolver::setProgressCallback(NestingEngine::ProgressCallback callback) {
+    // The engine calls it through engineProgressCallback(), so a running
+    // engine picks it up as well
     progressCallback_ = callback;
-    if (engine_) {
-        // Update callback on running engine dynamically
-        engine_->setProgressCallback(callback);
-    }
 }
 
 void DeepNestSolver::setResultCallback(NestingEngine::ResultCallback callback) {
+    // The engine calls it through engineResultCallback(), so a running
+    // engine picks it up as well
     resultCallback_ = callback;
-    if (engine_) {
-        // Update callback on running engine dynamically
-        engine_->setResultCallback(callback);
-    }
 }
 
 } // namespace deepnest
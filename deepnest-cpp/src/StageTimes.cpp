@@ -0,0 +1,155 @@
+#include "../include/deepnest/StageTimes.h"
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace deepnest {
+
+std::atomic<bool> StageTimer::enabled_{false};
+
+namespace {
+
+/**
+ * @brief One thread's counters; only that thread writes them
+ */
+struct ThreadCounters {
+    struct Counter {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> wallNs{0};
+        std::atomic<uint64_t> cpuNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> buckets{};
+    };
+    std::array<Counter, STAGE_COUNT> stages;
+};
+
+/**
+ * @brief Counters of every thread that timed a stage; kept after the
+ *        thread exits, so the totals never go back
+ */
+struct Registry {
+    boost::mutex mutex;
+    std::vector<std::shared_ptr<ThreadCounters>> threads;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadCounters& localCounters() {
+    thread_local std::shared_ptr<ThreadCounters> counters;
+    if (!counters) {
+        counters = std::make_shared<ThreadCounters>();
+        Registry& r = registry();
+        boost::lock_guard<boost::mutex> lock(r.mutex);
+        r.threads.push_back(counters);
+    }
+    return *counters;
+}
+
+void add(std::atomic<uint64_t>& counter, uint64_t value) {
+    // Single writer: a load and a store instead of a locked add
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+StageTimes StageTimes::operator-(const StageTimes& earlier) const {
+    StageTimes delta;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        delta.stages[i].count = stages[i].count - earlier.stages[i].count;
+        delta.stages[i].wallNs = stages[i].wallNs - earlier.stages[i].wallNs;
+        delta.stages[i].cpuNs = stages[i].cpuNs - earlier.stages[i].cpuNs;
+    }
+    return delta;
+}
+
+const char* StageTimes::name(Stage stage) {
+    switch (stage) {
+        case Stage::NfpInner:        return "nfpInner";
+        case Stage::NfpOuterCompute: return "nfpOuterCompute";
+        case Stage::NfpOuterCached:  return "nfpOuterCached";
+        case Stage::NfpUnion:        return "nfpUnion";
+        case Stage::NfpDifference:   return "nfpDifference";
+        case Stage::Candidates:      return "candidates";
+        case Stage::Scoring:         return "scoring";
+        case Stage::MergeDetection:  return "mergeDetection";
+        case Stage::Overlap:         return "overlap";
+        case Stage::Breeding:        return "breeding";
+        case Stage::Wait:            return "wait";
+        default:                     return "unknown";
+    }
+}
+
+LatencyHistogram::Snapshot StageTimer::latency(Stage stage) {
+    Registry& r = registry();
+    boost::lock_guard<boost::mutex> lock(r.mutex);
+
+    const size_t index = static_cast<size_t>(stage);
+    LatencyHistogram::Snapshot histogram;
+    for (const auto& thread : r.threads) {
+        const ThreadCounters::Counter& counter = thread->stages[index];
+        histogram.count += counter.count.load(std::memory_order_relaxed);
+        histogram.totalNs += counter.wallNs.load(std::memory_order_relaxed);
+        histogram.maxNs = std::max(histogram.maxNs, counter.maxNs.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+            histogram.buckets[i] += counter.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    return histogram;
+}
+
+StageTimes StageTimer::snapshot() {
+    Registry& r = registry();
+    boost::lock_guard<boost::mutex> lock(r.mutex);
+
+    StageTimes totals;
+    for (const auto& thread : r.threads) {
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            totals.stages[i].count += thread->stages[i].count.load(std::memory_order_relaxed);
+            totals.stages[i].wallNs += thread->stages[i].wallNs.load(std::memory_order_relaxed);
+            totals.stages[i].cpuNs += thread->stages[i].cpuNs.load(std::memory_order_relaxed);
+        }
+    }
+    return totals;
+}
+
+void StageTimer::record(Stage stage, uint64_t wallNs, uint64_t cpuNs) {
+    ThreadCounters::Counter& counter = localCounters().stages[static_cast<size_t>(stage)];
+    add(counter.count, 1);
+    add(counter.wallNs, wallNs);
+    add(counter.cpuNs, cpuNs);
+    add(counter.buckets[LatencyHistogram::bucketOf(wallNs)], 1);
+    if (wallNs > counter.maxNs.load(std::memory_order_relaxed)) {
+        counter.maxNs.store(wallNs, std::memory_order_relaxed);
+    }
+}
+
+uint64_t StageTimer::cpuNow() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0;
+    }
+    const uint64_t kernel100ns = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+    const uint64_t user100ns = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+    return (kernel100ns + user100ns) * 100;
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+} // namespace deepnest
@@ -0,0 +1,159 @@
+#include "../include/deepnest/Trace.h"
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace deepnest {
+
+std::atomic<bool> Trace::recording_{false};
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+/**
+ * @brief One thread's ring; only that thread writes it
+ */
+struct ThreadBuffer {
+    ThreadBuffer(size_t capacity, int tid) : events(capacity), written(0), tid(tid) {}
+
+    std::vector<Event> events;
+    std::atomic<uint64_t> written;  // Events ever recorded; slot = written % size
+    int tid;
+};
+
+/**
+ * @brief Buffers of the current session, in registration order
+ */
+struct Registry {
+    boost::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    size_t capacity = 65536;
+    uint64_t epoch = 0;                  // Trace clock at start(), exported as 0
+    std::atomic<uint64_t> session{1};    // Bumped by clear(), so threads register again
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @brief The calling thread's buffer, registered on first use in a session
+ */
+ThreadBuffer& localBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    thread_local uint64_t session = 0;
+
+    Registry& r = registry();
+    const uint64_t current = r.session.load(std::memory_order_acquire);
+    if (!buffer || session != current) {
+        boost::lock_guard<boost::mutex> lock(r.mutex);
+        buffer = std::make_shared<ThreadBuffer>(r.capacity, static_cast<int>(r.buffers.size()) + 1);
+        r.buffers.push_back(buffer);
+        session = current;
+    }
+    return *buffer;
+}
+
+void appendEscaped(std::ostringstream& out, const char* s) {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') {
+            out << '\\' << *s;
+        } else if (static_cast<unsigned char>(*s) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*s));
+            out << escaped;
+        } else {
+            out << *s;
+        }
+    }
+}
+
+} // anonymous namespace
+
+void Trace::start(size_t eventsPerThread) {
+    clear();
+    {
+        Registry& r = registry();
+        boost::lock_guard<boost::mutex> lock(r.mutex);
+        r.capacity = std::max<size_t>(1, eventsPerThread);
+        r.epoch = now();
+    }
+    recording_.store(true, std::memory_order_release);
+}
+
+void Trace::stop() {
+    recording_.store(false, std::memory_order_release);
+}
+
+void Trace::clear() {
+    Registry& r = registry();
+    boost::lock_guard<boost::mutex> lock(r.mutex);
+    r.buffers.clear();
+    r.session.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void Trace::record(const char* name, uint64_t beginNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % buffer.events.size()] = Event{name, beginNs, endNs};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+std::string Trace::chromeTraceJson() {
+    Registry& r = registry();
+    boost::lock_guard<boost::mutex> lock(r.mutex);
+
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"deepnest\"}}";
+
+    for (const auto& buffer : r.buffers) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+
+        // Oldest surviving event first
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const uint64_t size = buffer->events.size();
+        for (uint64_t i = written > size ? written - size : 0; i < written; ++i) {
+            const Event& e = buffer->events[i % size];
+            const char* dot = std::strchr(e.name, '.');
+            const std::string category = dot ? std::string(e.name, dot) : std::string(e.name);
+
+            out << ",\n{\"name\":\"";
+            appendEscaped(out, e.name);
+            out << "\",\"cat\":\"";
+            appendEscaped(out, category.c_str());
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << (e.begin >= r.epoch ? e.begin - r.epoch : 0) / 1000.0
+                << ",\"dur\":" << (e.end - e.begin) / 1000.0 << "}";
+        }
+    }
+
+    out << "\n]}\n";
+    return out.str();
+}
+
+void Trace::writeChromeTrace(const std::string& path) {
+    const std::string json = chromeTraceJson();
+    std::ofstream file(path, std::ios::binary);
+    if (!file || !file.write(json.data(), static_cast<std::streamsize>(json.size()))) {
+        throw std::runtime_error("Cannot write trace file " + path);
+    }
+}
+
+} // namespace deepnest
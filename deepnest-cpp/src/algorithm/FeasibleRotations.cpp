@@ -0,0 +1,36 @@
+#include "../../include/deepnest/algorithm/FeasibleRotations.h"
+#include <algorithm>
+#include <cmath>
+
+namespace deepnest {
+
+void FeasibleRotations::set(int partId, std::vector<double> rotations) {
+    if (rotations.empty()) {
+        rotations_.erase(partId);
+        return;
+    }
+    rotations_[partId] = std::move(rotations);
+}
+
+bool FeasibleRotations::allows(int partId, double rotation) const {
+    auto it = rotations_.find(partId);
+    if (it == rotations_.end()) {
+        return true;
+    }
+    return std::any_of(it->second.begin(), it->second.end(),
+        [rotation](double feasible) { return std::abs(feasible - rotation) < 1e-6; });
+}
+
+double FeasibleRotations::sample(int partId, int numRotations, std::mt19937& rng) const {
+    auto it = rotations_.find(partId);
+    if (it != rotations_.end()) {
+        std::uniform_int_distribution<size_t> dist(0, it->second.size() - 1);
+        return it->second[dist(rng)];
+    }
+
+    // JavaScript: Math.floor(Math.random()*this.config.rotations)*(360/this.config.rotations);
+    std::uniform_int_distribution<int> dist(0, numRotations - 1);
+    return dist(rng) * (360.0 / numRotations);
+}
+
+} // namespace deepnest
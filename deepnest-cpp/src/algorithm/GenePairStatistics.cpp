@@ -0,0 +1,95 @@
+#include "../../include/deepnest/algorithm/GenePairStatistics.h"
+#include "../../include/deepnest/nfp/NFPCache.h"
+#include <algorithm>
+#include <queue>
+
+namespace deepnest {
+
+void GenePairStatistics::add(const Individual& individual, double weight) {
+    const size_t genes = std::min(individual.placement.size(), individual.rotation.size());
+    if (genes == 0 || !(weight > 0.0)) {
+        return;
+    }
+    total_ += weight;
+
+    for (size_t i = 0; i < genes; ++i) {
+        const std::shared_ptr<Polygon>& part = individual.placement[i];
+        Shape& shape = shapes_[part->source];
+        if (!shape.polygon) {
+            shape.polygon = part;
+        }
+        const double rotation = individual.rotation[i];
+        auto& slot = shape.rotations[NFPCache::rotationKey(rotation)];
+        slot.first = rotation;
+        slot.second += weight;
+        shape.weight += weight;
+
+        if (i > 0) {
+            adjacent_[std::make_pair(individual.placement[i - 1]->source, part->source)] += weight;
+        }
+    }
+}
+
+void GenePairStatistics::addPopulation(const Population& population) {
+    const double threshold = population.survivalThreshold();
+    for (const auto& individual : population.getIndividuals()) {
+        const bool elite = individual.hasValidFitness() && individual.fitness <= threshold;
+        add(individual, elite ? ELITE_WEIGHT : 1.0);
+    }
+}
+
+std::vector<GenePairStatistics::Candidate> GenePairStatistics::ranked(
+    const std::function<bool(const Candidate&)>& wanted, size_t limit) const {
+    std::vector<Candidate> result;
+    if (limit == 0 || !(total_ > 0.0)) {
+        return result;
+    }
+
+    // A pair scores at most its adjacency share, so adjacencies are
+    // visited from the most frequent and the search stops once the
+    // limit-th best candidate outscores the next adjacency
+    std::vector<std::pair<double, const std::pair<int, int>*>> order;
+    order.reserve(adjacent_.size());
+    for (const auto& entry : adjacent_) {
+        order.emplace_back(entry.second / total_, &entry.first);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    auto worse = [](const Candidate& a, const Candidate& b) { return a.score > b.score; };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(worse)> best(worse);
+
+    for (const auto& adjacency : order) {
+        if (best.size() >= limit && best.top().score >= adjacency.first) {
+            break;
+        }
+        const Shape& placed = shapes_.at(adjacency.second->first);
+        const Shape& part = shapes_.at(adjacency.second->second);
+        for (const auto& a : placed.rotations) {
+            for (const auto& b : part.rotations) {
+                Candidate candidate{placed.polygon, a.second.first, part.polygon, b.second.first,
+                                    adjacency.first * (a.second.second / placed.weight) *
+                                                      (b.second.second / part.weight)};
+                if (best.size() >= limit && best.top().score >= candidate.score) {
+                    continue;
+                }
+                if (!wanted(candidate)) {
+                    continue;
+                }
+                best.push(std::move(candidate));
+                if (best.size() > limit) {
+                    best.pop();
+                }
+            }
+        }
+    }
+
+    result.reserve(best.size());
+    while (!best.empty()) {
+        result.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+} // namespace deepnest
@@ -1,14 +1,14 @@
 #include "../../include/deepnest/algorithm/GeneticAlgorithm.h"
+#include "../../include/deepnest/DebugConfig.h"
 #include <stdexcept>
 #include <algorithm>
 
 namespace deepnest {
 
-GeneticAlgorithm::GeneticAlgorithm(const std::vector<std::shared_ptr<Polygon>>& adam, const DeepNestConfig& config)
-    : population_(config)
-    , config_(config)
-    , parts_(adam)  // PHASE 2: Now stores shared_ptr, not raw pointers
-    , currentGeneration_(0) {
+GeneticAlgorithm::GeneticAlgorithm(const std::vector<std::shared_ptr<Polygon>>& adam, const DeepNestConfig& config,
+                                   std::shared_ptr<const FeasibleRotations> feasible)
+    : config_(config)
+    , parts_(adam) {  // PHASE 2: Now stores shared_ptr, not raw pointers
 
     if (adam.empty()) {
         throw std::invalid_argument("Parts list (adam) cannot be empty");
@@ -20,7 +20,21 @@ GeneticAlgorithm::GeneticAlgorithm(const std::vector<std::shared_ptr<Polygon>>&
     //                 var mutant = this.mutate(this.population[0]);
     //                 this.population.push(mutant);
     //             }
-    population_.initialize(adam);  // Population::initialize now accepts shared_ptr
+    // Each island seeds its own generator, so their populations differ;
+    // with config.randomSeed set, island i starts from randomSeed + i
+    const size_t islands = static_cast<size_t>(std::max(1, config_.islands));
+    islands_.reserve(islands);
+    for (size_t i = 0; i < islands; ++i) {
+        if (config_.randomSeed != 0) {
+            islands_.emplace_back(config_, config_.randomSeed + static_cast<unsigned int>(i));
+        } else {
+            islands_.emplace_back(config_);
+        }
+        islands_.back().setFeasibleRotations(feasible);
+        islands_.back().initialize(adam);  // Population::initialize now accepts shared_ptr
+    }
+    generations_.assign(islands, 0);
+    offspring_.assign(islands, 0);
 }
 
 void GeneticAlgorithm::generation() {
@@ -43,30 +57,97 @@ void GeneticAlgorithm::generation() {
     //   }
     //   this.population = newpopulation;
     // }
-    population_.nextGeneration();
-    currentGeneration_++;
+    for (size_t i = 0; i < islands_.size(); ++i) {
+        islands_[i].nextGeneration();
+        advance(i);
+    }
 }
 
-const Individual& GeneticAlgorithm::getBestIndividual() const {
-    if (population_.empty()) {
-        throw std::runtime_error("Cannot get best individual from empty population");
+void GeneticAlgorithm::generation(size_t island) {
+    if (!islands_.at(island).isGenerationComplete()) {
+        throw std::runtime_error("Cannot create next generation: island generation not complete");
     }
 
+    islands_[island].nextGeneration();
+    advance(island);
+}
+
+bool GeneticAlgorithm::breedOffspring(size_t concurrency) {
+    const size_t target = static_cast<size_t>(config_.populationSize);
+    const size_t share = (concurrency + islands_.size() - 1) / islands_.size();
+    const int before = getCurrentGeneration();
+
+    for (size_t i = 0; i < islands_.size(); ++i) {
+        Population& population = islands_[i];
+        population.cull(target);
+
+        // Individuals without a fitness are launched or about to be
+        size_t unevaluated = 0;
+        for (const auto& individual : population.getIndividuals()) {
+            if (!individual.hasValidFitness()) {
+                ++unevaluated;
+            }
+        }
+        if (unevaluated >= share) {
+            continue;
+        }
+
+        offspring_[i] += population.breed(share - unevaluated);
+
+        while (target > 0 && offspring_[i] >= target) {
+            offspring_[i] -= target;
+            advance(i);
+        }
+    }
+    return getCurrentGeneration() > before;
+}
+
+void GeneticAlgorithm::advance(size_t island) {
+    generations_[island]++;
+
+    if (islands_.size() < 2 || generations_[island] % std::max(1, config_.migrationInterval) != 0) {
+        return;
+    }
+
+    // Both generational and steady-state populations sort evaluated
+    // individuals first after breeding, so the elite lead
+    const Population& source = islands_[island];
+    Population& destination = islands_[(island + 1) % islands_.size()];
+    const size_t elites = std::min(source.eliteCount(), source.size());
+
+    size_t migrated = 0;
+    for (size_t i = 0; i < elites && source[i].hasValidFitness(); ++i) {
+        if (destination.immigrate(source[i])) {
+            ++migrated;
+        }
+    }
+    LOG_GA("Island " << island << " generation " << generations_[island] << ": "
+              << migrated << " of " << elites << " elite migrated");
+}
+
+const Individual& GeneticAlgorithm::getBestIndividual() const {
     // Population's getBest() assumes population is sorted by fitness
     // We need to sort first if not already sorted
     // For safety, let's find the minimum manually
-    const auto& individuals = population_.getIndividuals();
+    const Individual* best = nullptr;
+    for (const auto& island : islands_) {
+        const auto& individuals = island.getIndividuals();
+
+        auto minIt = std::min_element(individuals.begin(), individuals.end(),
+                                      [](const Individual& a, const Individual& b) {
+                                          return a.fitness < b.fitness;
+                                      });
 
-    auto minIt = std::min_element(individuals.begin(), individuals.end(),
-                                  [](const Individual& a, const Individual& b) {
-                                      return a.fitness < b.fitness;
-                                  });
+        if (minIt != individuals.end() && (best == nullptr || minIt->fitness < best->fitness)) {
+            best = &*minIt;
+        }
+    }
 
-    if (minIt == individuals.end()) {
-        throw std::runtime_error("No individuals in population");
+    if (best == nullptr) {
+        throw std::runtime_error("Cannot get best individual from empty population");
     }
 
-    return *minIt;
+    return *best;
 }
 
 bool GeneticAlgorithm::isGenerationComplete() const {
@@ -78,45 +159,93 @@ bool GeneticAlgorithm::isGenerationComplete() const {
     //       break;
     //     }
     //   }
-    return population_.isGenerationComplete();
+    for (const auto& island : islands_) {
+        if (!island.isGenerationComplete()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 int GeneticAlgorithm::getCurrentGeneration() const {
-    return currentGeneration_;
+    return *std::min_element(generations_.begin(), generations_.end());
+}
+
+size_t GeneticAlgorithm::getIslandCount() const {
+    return islands_.size();
+}
+
+Population& GeneticAlgorithm::getIsland(size_t island) {
+    return islands_.at(island);
+}
+
+const Population& GeneticAlgorithm::getIsland(size_t island) const {
+    return islands_.at(island);
+}
+
+int GeneticAlgorithm::getIslandGeneration(size_t island) const {
+    return generations_.at(island);
+}
+
+size_t GeneticAlgorithm::getIslandOffspring(size_t island) const {
+    return offspring_.at(island);
+}
+
+void GeneticAlgorithm::restoreIsland(size_t island, int generation, size_t offspring) {
+    generations_.at(island) = generation;
+    offspring_.at(island) = offspring;
+}
+
+void GeneticAlgorithm::setSurrogate(const std::shared_ptr<SurrogateFitness>& surrogate) {
+    for (auto& island : islands_) {
+        island.setSurrogate(surrogate);
+    }
 }
 
 size_t GeneticAlgorithm::getPopulationSize() const {
-    return population_.size();
+    return islands_.front().size();
+}
+
+size_t GeneticAlgorithm::memoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& island : islands_) {
+        bytes += island.memoryBytes();
+    }
+    return bytes;
 }
 
 Individual& GeneticAlgorithm::getIndividual(size_t index) {
-    return population_[index];
+    return islands_.front()[index];
 }
 
 const Individual& GeneticAlgorithm::getIndividual(size_t index) const {
-    return population_[index];
+    return islands_.front()[index];
 }
 
 std::vector<Individual>& GeneticAlgorithm::getPopulation() {
-    return population_.getIndividuals();
+    return islands_.front().getIndividuals();
 }
 
 const std::vector<Individual>& GeneticAlgorithm::getPopulation() const {
-    return population_.getIndividuals();
+    return islands_.front().getIndividuals();
 }
 
 Population& GeneticAlgorithm::getPopulationObject() {
-    return population_;
+    return islands_.front();
 }
 
 const Population& GeneticAlgorithm::getPopulationObject() const {
-    return population_;
+    return islands_.front();
 }
 
 size_t GeneticAlgorithm::getProcessingCount() const {
     // Count individuals currently being processed
     // JavaScript: var running = GA.population.filter(function(p){ return !!p.processing; }).length;
-    return population_.getProcessingCount();
+    size_t count = 0;
+    for (const auto& island : islands_) {
+        count += island.getProcessingCount();
+    }
+    return count;
 }
 
 const DeepNestConfig& GeneticAlgorithm::getConfig() const {
@@ -128,8 +257,11 @@ const std::vector<std::shared_ptr<Polygon>>& GeneticAlgorithm::getParts() const
 }
 
 void GeneticAlgorithm::reset() {
-    population_.clear();
-    currentGeneration_ = 0;
+    for (auto& island : islands_) {
+        island.clear();
+    }
+    std::fill(generations_.begin(), generations_.end(), 0);
+    std::fill(offspring_.begin(), offspring_.end(), 0);
 }
 
 void GeneticAlgorithm::reinitialize(const std::vector<std::shared_ptr<Polygon>>& adam) {
@@ -139,14 +271,25 @@ void GeneticAlgorithm::reinitialize(const std::vector<std::shared_ptr<Polygon>>&
 
     reset();
     parts_ = adam;  // PHASE 2: Stores shared_ptr
-    population_.initialize(adam);  // Population::initialize now accepts shared_ptr
+    for (auto& island : islands_) {
+        island.initialize(adam);  // Population::initialize now accepts shared_ptr
+    }
+}
+
+void GeneticAlgorithm::seed(const Individual& adam) {
+    for (auto& island : islands_) {
+        island.seed(adam);
+    }
 }
 
 std::tuple<int, size_t, size_t, bool> GeneticAlgorithm::getStatistics() const {
-    int generation = currentGeneration_;
-    size_t popSize = population_.size();
-    size_t processing = population_.getProcessingCount();
-    bool complete = population_.isGenerationComplete();
+    int generation = getCurrentGeneration();
+    size_t popSize = 0;
+    for (const auto& island : islands_) {
+        popSize += island.size();
+    }
+    size_t processing = getProcessingCount();
+    bool complete = isGenerationComplete();
 
     return std::make_tuple(generation, popSize, processing, complete);
 }
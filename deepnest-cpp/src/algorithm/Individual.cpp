@@ -1,4 +1,5 @@
 #include "../../include/deepnest/algorithm/Individual.h"
+#include "../../include/deepnest/DebugConfig.h"
 #include <algorithm>
 #include <cmath>
 
@@ -8,17 +9,20 @@ Individual::Individual()
     : fitness(std::numeric_limits<double>::max())
     , area(0.0)
     , mergedLength(0.0)
-    , processing(false) {
+    , coarse(false)
+    , bounded(false) {
 }
 
 Individual::Individual(const std::vector<std::shared_ptr<Polygon>>& parts,
                        const DeepNestConfig& config,
-                       unsigned int seed)
+                       unsigned int seed,
+                       const FeasibleRotations* feasible)
     : placement(parts)  // PHASE 2: Now copies shared_ptr, not raw pointers
     , fitness(std::numeric_limits<double>::max())
     , area(0.0)
     , mergedLength(0.0)
-    , processing(false) {
+    , coarse(false)
+    , bounded(false) {
 
     // Initialize random number generator
     std::mt19937 rng(seed);
@@ -27,7 +31,13 @@ Individual::Individual(const std::vector<std::shared_ptr<Polygon>>& parts,
     // JavaScript: angle = Math.floor(Math.random()*this.config.rotations)*(360/this.config.rotations);
     rotation.reserve(parts.size());
     for (size_t i = 0; i < parts.size(); ++i) {
-        rotation.push_back(generateRandomRotation(config.rotations, rng));
+        if (config.groupQuantities && i > 0 && parts[i]->source == parts[i - 1]->source) {
+            rotation.push_back(rotation.back());
+            continue;
+        }
+        rotation.push_back(feasible
+            ? feasible->sample(parts[i]->id, config.rotations, rng)
+            : generateRandomRotation(config.rotations, rng));
     }
 }
 
@@ -39,12 +49,15 @@ Individual Individual::clone() const {
     copy.area = this->area;
     copy.mergedLength = this->mergedLength;
     copy.placements = this->placements; // Copy placement results
-    copy.processing = false;           // Reset processing flag
+    // copy.evaluation stays empty: the copy is not being evaluated
+    copy.coarse = this->coarse;
+    copy.bounded = this->bounded;
 
     return copy;
 }
 
-void Individual::mutate(double mutationRate, int numRotations, unsigned int seed) {
+void Individual::mutate(double mutationRate, int numRotations, unsigned int seed,
+                        const FeasibleRotations* feasible) {
     // Initialize random number generator
     std::mt19937 rng(seed);
     std::uniform_real_distribution<double> dist(0.0, 1.0);
@@ -77,37 +90,108 @@ void Individual::mutate(double mutationRate, int numRotations, unsigned int seed
     for (size_t i = 0; i < rotation.size(); ++i) {
         double rand = dist(rng);
         if (rand < mutationProb) {
-            rotation[i] = generateRandomRotation(numRotations, rng);
+            rotation[i] = feasible
+                ? feasible->sample(placement[i]->id, numRotations, rng)
+                : generateRandomRotation(numRotations, rng);
             rotationChangeCount++;
+        } else if (feasible && !feasible->allows(placement[i]->id, rotation[i])) {
+            // Rotations stay with their position, so a swap can hand a part
+            // an angle it does not fit at
+            rotation[i] = feasible->sample(placement[i]->id, numRotations, rng);
         }
     }
 
-    // GA DEBUG: Log mutations for every call during initialization and first generation
-    static int mutationCount = 0;
-    mutationCount++;
-
-    // Log first 15 mutations to see initial diversity, then every 100th
-    if (mutationCount <= 15 || mutationCount % 100 == 0) {
-#if DEBUG_GA
-        std::cout << "  Mutation #" << mutationCount << ": swaps=" << swapCount
-                  << ", rotation_changes=" << rotationChangeCount
-                  << ", prob=" << mutationProb << std::endl;
-        std::cout.flush();
-#endif
-    }
+    // Log first 15 mutations per thread to see initial diversity, then every 100th
+    LOG_GA_SAMPLED(15, 100, "Mutation #" << pass << ": swaps=" << swapCount
+                            << ", rotation_changes=" << rotationChangeCount
+                            << ", prob=" << mutationProb);
 
     // Reset fitness since individual has changed
     resetFitness();
 }
 
+void Individual::mutateGroups(double mutationRate, int numRotations, unsigned int seed,
+                              const FeasibleRotations* feasible) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    const double mutationProb = mutationRate * 0.01;
+
+    std::vector<std::pair<size_t, size_t>> runs = groups();
+
+    // Swap adjacent runs, as mutate() swaps adjacent genes
+    for (size_t i = 0; i + 1 < runs.size(); ++i) {
+        if (dist(rng) < mutationProb) {
+            std::swap(runs[i], runs[i + 1]);
+        }
+    }
+
+    std::vector<std::shared_ptr<Polygon>> newPlacement;
+    std::vector<double> newRotation;
+    newPlacement.reserve(placement.size());
+    newRotation.reserve(rotation.size());
+    for (const auto& run : runs) {
+        const int partId = placement[run.first]->id;
+        double angle = rotation[run.first];
+        if (dist(rng) < mutationProb) {
+            angle = feasible ? feasible->sample(partId, numRotations, rng)
+                             : generateRandomRotation(numRotations, rng);
+        } else if (feasible && !feasible->allows(partId, angle)) {
+            angle = feasible->sample(partId, numRotations, rng);
+        }
+
+        newPlacement.insert(newPlacement.end(), placement.begin() + run.first, placement.begin() + run.second);
+        newRotation.insert(newRotation.end(), run.second - run.first, angle);
+    }
+    placement = std::move(newPlacement);
+    rotation = std::move(newRotation);
+
+    resetFitness();
+}
+
+std::vector<std::pair<size_t, size_t>> Individual::groups() const {
+    std::vector<std::pair<size_t, size_t>> runs;
+    size_t begin = 0;
+    for (size_t i = 1; i <= placement.size(); ++i) {
+        if (i == placement.size() || placement[i]->source != placement[begin]->source) {
+            runs.emplace_back(begin, i);
+            begin = i;
+        }
+    }
+    return runs;
+}
+
 bool Individual::hasValidFitness() const {
     return fitness < std::numeric_limits<double>::max();
 }
 
+EvaluationState Individual::state() const {
+    return evaluation ? evaluation->state.load(std::memory_order_acquire) : EvaluationState::PENDING;
+}
+
+bool Individual::collect(bool keepPlacements) {
+    if (state() != EvaluationState::DONE) {
+        return false;
+    }
+
+    const PlacementWorker::PlacementResult& result = evaluation->result;
+    fitness = result.fitness;
+    area = result.area;
+    mergedLength = result.mergedLength;
+    if (keepPlacements) {
+        placements = result.placements;
+    } else {
+        placements.clear();
+    }
+    bounded = result.bounded;
+    evaluation.reset();
+    return true;
+}
+
 void Individual::resetFitness() {
     fitness = std::numeric_limits<double>::max();
     area = 0.0;
     mergedLength = 0.0;
+    bounded = false;
     placements.clear();  // Clear placement results when fitness is reset
 }
 
@@ -115,6 +199,20 @@ size_t Individual::size() const {
     return placement.size();
 }
 
+size_t Individual::memoryBytes() const {
+    size_t bytes = sizeof(Individual) - sizeof(placements)
+                 + placement.capacity() * sizeof(std::shared_ptr<Polygon>)
+                 + rotation.capacity() * sizeof(double)
+                 + PlacementWorker::memoryBytes(placements);
+    if (evaluation) {
+        bytes += sizeof(EvaluationSlot);
+        if (state() == EvaluationState::DONE) {
+            bytes += evaluation->result.memoryBytes() - sizeof(PlacementWorker::PlacementResult);
+        }
+    }
+    return bytes;
+}
+
 bool Individual::operator<(const Individual& other) const {
     return fitness < other.fitness;
 }
@@ -1,5 +1,10 @@
 #include "../../include/deepnest/algorithm/Population.h"
+#include "../../include/deepnest/DebugConfig.h"
+#include "../../include/deepnest/StageTimes.h"
+#include "../../include/deepnest/Trace.h"
 #include <algorithm>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
 namespace deepnest {
@@ -20,7 +25,7 @@ void Population::initialize(const std::vector<std::shared_ptr<Polygon>>& parts)
     if (parts.empty()) {
         throw std::invalid_argument("Parts list cannot be empty");
     }
-#ifdef DEBUG_GA
+#if DEBUG_GA
     std::cout << "\n=== POPULATION INITIALIZATION ===" << std::endl;
     std::cout << "Creating population of " << config_.populationSize
               << " individuals from " << parts.size() << " parts" << std::endl;
@@ -30,9 +35,9 @@ void Population::initialize(const std::vector<std::shared_ptr<Polygon>>& parts)
     // Create first individual "adam" with parts in given order and random rotations
     // JavaScript: this.population = [{placement: adam, rotation: angles}];
     // PHASE 2: Individual constructor now accepts shared_ptr
-    Individual adam(parts, config_, rng_());
+    Individual adam(parts, config_, rng_(), feasible_.get());
     individuals_.push_back(adam);
-#ifdef DEBUG_GA
+#if DEBUG_GA
     std::cout << "Adam created with rotations: ";
     for (size_t i = 0; i < std::min(size_t(5), adam.rotation.size()); ++i) {
         std::cout << adam.rotation[i] << "° ";
@@ -45,9 +50,9 @@ void Population::initialize(const std::vector<std::shared_ptr<Polygon>>& parts)
     // JavaScript: while(this.population.length < config.populationSize)
     while (individuals_.size() < static_cast<size_t>(config_.populationSize)) {
         Individual mutant = adam.clone();
-        mutant.mutate(config_.mutationRate, config_.rotations, rng_());
+        mutate(mutant);
         individuals_.push_back(mutant);
-#ifdef DEBUG_GA
+#if DEBUG_GA
         // Show first mutant's rotations to verify diversity
         if (individuals_.size() == 2) {
             std::cout << "First mutant rotations: ";
@@ -59,13 +64,31 @@ void Population::initialize(const std::vector<std::shared_ptr<Polygon>>& parts)
         }
 #endif
     }
-#ifdef DEBUG_GA
+#if DEBUG_GA
     std::cout << "Population initialized with " << individuals_.size() << " individuals" << std::endl;
     std::cout << "=== END INITIALIZATION ===" << std::endl;
     std::cout.flush();
 #endif
 }
 
+void Population::seed(const Individual& adam) {
+    if (adam.placement.empty()) {
+        throw std::invalid_argument("Seed individual cannot be empty");
+    }
+
+    individuals_.clear();
+    Individual first;
+    first.placement = adam.placement;
+    first.rotation = adam.rotation;
+    individuals_.push_back(first);
+
+    while (individuals_.size() < static_cast<size_t>(config_.populationSize)) {
+        Individual mutant = first.clone();
+        mutate(mutant);
+        individuals_.push_back(mutant);
+    }
+}
+
 std::pair<Individual, Individual> Population::crossover(
     const Individual& parent1,
     const Individual& parent2) {
@@ -80,15 +103,18 @@ std::pair<Individual, Individual> Population::crossover(
     double randomVal = dist(rng_);
     size_t cutpoint = static_cast<size_t>(std::round(randomVal * (parent1.placement.size() - 1)));
 
-    // GA DEBUG: Log crossover cutpoint
-    static bool first_crossover = true;
-    if (first_crossover) {
-#ifdef DEBUG_GA
-        std::cout << "  Crossover cutpoint: " << cutpoint << " out of " << parent1.placement.size() << " parts" << std::endl;
-#endif
-        first_crossover = false;
+    // Grouped copies are only cut between runs, so each child takes a run
+    // whole from one parent and it stays together
+    size_t cut1 = cutpoint;
+    size_t cut2 = cutpoint;
+    if (config_.groupQuantities) {
+        cut1 = groupBoundary(parent1, cutpoint);
+        cut2 = groupBoundary(parent2, cutpoint);
     }
 
+    // GA DEBUG: Log the first crossover cutpoint of each thread
+    LOG_GA_SAMPLED(1, 0, "Crossover cutpoint: " << cutpoint << " out of " << parent1.placement.size() << " parts");
+
     // Create children
     Individual child1, child2;
 
@@ -96,92 +122,93 @@ std::pair<Individual, Individual> Population::crossover(
     // JavaScript: var gene1 = male.placement.slice(0,cutpoint);
     child1.placement.insert(child1.placement.end(),
                            parent1.placement.begin(),
-                           parent1.placement.begin() + cutpoint);
+                           parent1.placement.begin() + cut1);
     child1.rotation.insert(child1.rotation.end(),
                           parent1.rotation.begin(),
-                          parent1.rotation.begin() + cutpoint);
+                          parent1.rotation.begin() + cut1);
 
     // Child 2: Take first part from parent2 up to cutpoint
     child2.placement.insert(child2.placement.end(),
                            parent2.placement.begin(),
-                           parent2.placement.begin() + cutpoint);
+                           parent2.placement.begin() + cut2);
     child2.rotation.insert(child2.rotation.end(),
                           parent2.rotation.begin(),
-                          parent2.rotation.begin() + cutpoint);
+                          parent2.rotation.begin() + cut2);
 
     // Fill child1 with remaining parts from parent2 (avoiding duplicates)
     // JavaScript: for(i=0; i<female.placement.length; i++)
     //   if(!contains(gene1, female.placement[i].id)) { gene1.push(female.placement[i]); }
-    for (size_t i = 0; i < parent2.placement.size(); ++i) {
-        if (!containsPolygon(child1.placement, parent2.placement[i]->id)) {
-            child1.placement.push_back(parent2.placement[i]);
-            child1.rotation.push_back(parent2.rotation[i]);
-        }
-    }
+    appendMissing(child1, parent2);
 
     // Fill child2 with remaining parts from parent1 (avoiding duplicates)
-    for (size_t i = 0; i < parent1.placement.size(); ++i) {
-        if (!containsPolygon(child2.placement, parent1.placement[i]->id)) {
-            child2.placement.push_back(parent1.placement[i]);
-            child2.rotation.push_back(parent1.rotation[i]);
-        }
-    }
+    appendMissing(child2, parent1);
 
     return std::make_pair(child1, child2);
 }
 
-Individual Population::selectWeightedRandom(const Individual* exclude) {
-    if (individuals_.empty()) {
+const Individual& Population::selectWeightedRandom(const Individual* exclude) {
+    const int excludeIdx = findIndividualIndex(exclude);
+    return individuals_[selectWeightedIndex(
+        individuals_.size(), excludeIdx >= 0 ? static_cast<size_t>(excludeIdx) : NO_INDEX)];
+}
+
+size_t Population::selectWeightedIndex(size_t poolSize, size_t exclude) {
+    poolSize = std::min(poolSize, individuals_.size());
+    if (poolSize == 0) {
         throw std::runtime_error("Cannot select from empty population");
     }
 
-    // Create working copy of population
-    std::vector<Individual> pop = individuals_;
-
-    // Remove excluded individual if specified
+    // The pool is ranked in place; nothing is copied
     // JavaScript: if(exclude && pop.indexOf(exclude) >= 0) { pop.splice(pop.indexOf(exclude),1); }
-    if (exclude != nullptr) {
-        int excludeIdx = findIndividualIndex(exclude);
-        if (excludeIdx >= 0) {
-            pop.erase(pop.begin() + excludeIdx);
-        }
-    }
-
-    if (pop.empty()) {
+    const size_t count = exclude < poolSize ? poolSize - 1 : poolSize;
+    if (count == 0) {
         throw std::runtime_error("Population empty after exclusion");
     }
 
     // Weighted random selection (favor lower fitness = better individuals)
     // JavaScript: var weight = 1/pop.length; var upper = weight;
     std::uniform_real_distribution<double> dist(0.0, 1.0);
-    double rand = dist(rng_);
+    const size_t rank = weightedRank(dist(rng_), count);
 
-    double lower = 0.0;
-    double weight = 1.0 / pop.size();
-    double upper = weight;
+    // Ranks count the pool without the excluded individual
+    return exclude <= rank ? rank + 1 : rank;
+}
 
+size_t Population::weightedRank(double rand, size_t count) {
     // JavaScript: for(var i=0; i<pop.length; i++)
     //   if(rand > lower && rand < upper) { return pop[i]; }
     //   upper += 2*weight * ((pop.length-i)/pop.length);
-    for (size_t i = 0; i < pop.size(); ++i) {
-        if (rand > lower && rand < upper) {
-            return pop[i];
+    // The upper bound of rank k is the sum of that series,
+    // weight * (1 + 2 * (k*n - k*(k-1)/2) / n), so the rank is found by
+    // bisection on the closed form rather than a scan of the pool
+    const double n = static_cast<double>(count);
+    const double weight = 1.0 / n;
+    auto upper = [&](size_t rank) {
+        const double k = static_cast<double>(rank);
+        return weight * (1.0 + 2.0 * (k * n - k * (k - 1.0) / 2.0) / n);
+    };
+    size_t low = 0;
+    size_t high = count - 1;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (rand < upper(mid)) {
+            high = mid;
+        } else {
+            low = mid + 1;
         }
-        lower = upper;
-        upper += 2.0 * weight * (static_cast<double>(pop.size() - i) / pop.size());
     }
-
-    // Fallback: return first individual
-    return pop[0];
+    return low;
 }
 
 void Population::nextGeneration() {
+    TRACE_SCOPE("ga.breed");
+    STAGE_SCOPE(Breeding);
     if (individuals_.empty()) {
         throw std::runtime_error("Cannot create next generation from empty population");
     }
 
     // GA DEBUG: Log population fitness BEFORE sorting
-#ifdef DEBUG_GA
+#if DEBUG_GA
     std::cout << "\n=== GA: nextGeneration() START ===" << std::endl;
     std::cout << "Population fitness values BEFORE sort: ";
     for (size_t i = 0; i < std::min(size_t(5), individuals_.size()); ++i) {
@@ -196,7 +223,7 @@ void Population::nextGeneration() {
     sortByFitness();
 
     // GA DEBUG: Log best fitness after sort
-#ifdef DEBUG_GA
+#if DEBUG_GA
     std::cout << "AFTER sort - Best fitness: " << individuals_[0].fitness
               << ", Worst fitness: " << individuals_[individuals_.size()-1].fitness << std::endl;
 #endif
@@ -205,30 +232,30 @@ void Population::nextGeneration() {
     // Original JavaScript only keeps best 1 (elitism = 1/popSize ≈ 1-2%)
     // Increase to 10% for faster convergence and more genetic diversity preservation
     // JavaScript: var newpopulation = [this.population[0]];
-    std::vector<Individual> newPopulation;
-    
-    size_t eliteCount = std::max(size_t(1), static_cast<size_t>(individuals_.size() * 0.10));  // At least 1, ideally 10%
-    
-    for (size_t i = 0; i < std::min(eliteCount, individuals_.size()); ++i) {
-        newPopulation.push_back(individuals_[i]);
-    }
-    
-#ifdef DEBUG_GA
-    std::cout << "Elitism: Preserving top " << elite Count << " individuals ("
-              << (100.0 * eliteCount / individuals_.size()) << "%)" << std::endl;
+    // The elites are moved over once breeding no longer reads them
+    const size_t elites = std::min(eliteCount(), individuals_.size());  // At least 1, ideally 10%
+
+#if DEBUG_GA
+    std::cout << "Elitism: Preserving top " << elites << " individuals ("
+              << (100.0 * elites / individuals_.size()) << "%)" << std::endl;
 #endif
 
     // Fill rest of population with children from crossover + mutation
     // JavaScript: while(newpopulation.length < this.population.length)
-    size_t targetSize = individuals_.size();
+    const size_t needed = individuals_.size() - elites;
+    const size_t targetSize = childrenToBreed(needed);
+    std::vector<Individual> children;
+    children.reserve(targetSize);
     int childCount = 0;
-    while (newPopulation.size() < targetSize) {
+    while (children.size() < targetSize) {
         // Select two parents using weighted random selection
-        Individual male = selectWeightedRandom(nullptr);
-        Individual female = selectWeightedRandom(&male);
+        const size_t maleIndex = selectWeightedIndex(individuals_.size());
+        const size_t femaleIndex = selectWeightedIndex(individuals_.size(), maleIndex);
+        const Individual& male = individuals_[maleIndex];
+        const Individual& female = individuals_[femaleIndex];
 
         // GA DEBUG: Log selected parents (only for first child)
-#ifdef DEBUG_GA
+#if DEBUG_GA
         if (childCount == 0) {
             std::cout << "First crossover: Male fitness=" << male.fitness
                       << ", Female fitness=" << female.fitness << std::endl;
@@ -237,37 +264,154 @@ void Population::nextGeneration() {
 
         // Crossover to produce two children
         // JavaScript: var children = this.mate(male, female);
-        auto children = crossover(male, female);
+        auto offspring = crossover(male, female);
 
         // Mutate and add first child
         // JavaScript: newpopulation.push(this.mutate(children[0]));
-        children.first.mutate(config_.mutationRate, config_.rotations, rng_());
-        newPopulation.push_back(children.first);
+        mutate(offspring.first);
+        children.push_back(std::move(offspring.first));
         childCount++;
 
         // Mutate and add second child if there's room
         // JavaScript: if(newpopulation.length < this.population.length)
-        if (newPopulation.size() < targetSize) {
-            children.second.mutate(config_.mutationRate, config_.rotations, rng_());
-            newPopulation.push_back(children.second);
+        if (children.size() < targetSize) {
+            mutate(offspring.second);
+            children.push_back(std::move(offspring.second));
             childCount++;
         }
     }
-#ifdef DEBUG_GA
-    std::cout << "Created " << childCount << " new children (+ " << eliteCount 
+
+    screen(children, needed);
+    std::vector<Individual> newPopulation;
+    newPopulation.reserve(elites + children.size());
+    newPopulation.insert(newPopulation.end(),
+                         std::make_move_iterator(individuals_.begin()),
+                         std::make_move_iterator(individuals_.begin() + elites));
+    newPopulation.insert(newPopulation.end(),
+                         std::make_move_iterator(children.begin()),
+                         std::make_move_iterator(children.end()));
+#if DEBUG_GA
+    std::cout << "Created " << childCount << " new children (+ " << elites 
               << " elites = " << newPopulation.size() << " total)" << std::endl;
     std::cout << "=== GA: nextGeneration() END ===" << std::endl;
     std::cout.flush();
 #endif
 
     // Replace old population with new one
-    individuals_ = newPopulation;
+    individuals_ = std::move(newPopulation);
+}
+
+void Population::setSurrogate(std::shared_ptr<SurrogateFitness> surrogate) {
+    surrogate_ = std::move(surrogate);
+}
+
+void Population::setFeasibleRotations(std::shared_ptr<const FeasibleRotations> feasible) {
+    feasible_ = std::move(feasible);
+}
+
+size_t Population::childrenToBreed(size_t count) const {
+    if (!surrogate_ || config_.surrogateOversampling <= 1 || !surrogate_->reliable()) {
+        return count;
+    }
+    return count * static_cast<size_t>(config_.surrogateOversampling);
+}
+
+void Population::screen(std::vector<Individual>& children, size_t count) {
+    if (children.size() <= count) {
+        return;
+    }
+
+    std::vector<std::pair<double, size_t>> ranked;
+    ranked.reserve(children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        ranked.emplace_back(surrogate_->estimate(children[i]), i);
+    }
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end());
+
+    std::vector<Individual> kept;
+    kept.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        kept.push_back(std::move(children[ranked[i].second]));
+    }
+    children = std::move(kept);
+}
+
+size_t Population::breed(size_t count) {
+    STAGE_SCOPE(Breeding);
+    // Parents come from the evaluated individuals only; the ones under
+    // evaluation sort behind them with the maximum fitness
+    const size_t evaluated = sortEvaluatedFirst();
+    if (evaluated < 2 || count == 0) {
+        return 0;
+    }
+
+    const size_t bred = childrenToBreed(count);
+    std::vector<Individual> children;
+    children.reserve(bred);
+    while (children.size() < bred) {
+        const size_t male = selectWeightedIndex(evaluated);
+        const size_t female = selectWeightedIndex(evaluated, male);
+
+        auto offspring = crossover(individuals_[male], individuals_[female]);
+
+        mutate(offspring.first);
+        children.push_back(std::move(offspring.first));
+
+        if (children.size() < bred) {
+            mutate(offspring.second);
+            children.push_back(std::move(offspring.second));
+        }
+    }
+    screen(children, count);
+
+    individuals_.insert(individuals_.end(),
+                        std::make_move_iterator(children.begin()),
+                        std::make_move_iterator(children.end()));
+    return children.size();
+}
+
+void Population::cull(size_t size) {
+    const size_t evaluated = sortEvaluatedFirst();
+    if (evaluated > size) {
+        individuals_.erase(individuals_.begin() + size, individuals_.begin() + evaluated);
+    }
+}
+
+bool Population::immigrate(const Individual& migrant) {
+    // A child nobody launched yet costs no evaluation to replace
+    auto target = std::find_if(individuals_.begin(), individuals_.end(),
+        [](const Individual& individual) {
+            return !individual.hasValidFitness() && !individual.isProcessing();
+        });
+
+    if (target == individuals_.end()) {
+        for (auto it = individuals_.begin(); it != individuals_.end(); ++it) {
+            if (it->hasValidFitness() &&
+                (target == individuals_.end() || it->fitness > target->fitness)) {
+                target = it;
+            }
+        }
+        if (target == individuals_.end() || target->fitness <= migrant.fitness) {
+            return false;
+        }
+    }
+
+    *target = migrant.clone();
+    return true;
 }
 
 size_t Population::size() const {
     return individuals_.size();
 }
 
+size_t Population::memoryBytes() const {
+    size_t bytes = (individuals_.capacity() - individuals_.size()) * sizeof(Individual);
+    for (const auto& individual : individuals_) {
+        bytes += individual.memoryBytes();
+    }
+    return bytes;
+}
+
 bool Population::empty() const {
     return individuals_.empty();
 }
@@ -297,6 +441,26 @@ const Individual& Population::getBest() const {
     return individuals_[0];
 }
 
+size_t Population::eliteCount() const {
+    return std::max(size_t(1), static_cast<size_t>(individuals_.size() * 0.10));
+}
+
+double Population::survivalThreshold() const {
+    std::vector<double> evaluated;
+    for (const auto& individual : individuals_) {
+        if (individual.hasValidFitness()) {
+            evaluated.push_back(individual.fitness);
+        }
+    }
+
+    const size_t elite = eliteCount();
+    if (evaluated.size() < elite) {
+        return std::numeric_limits<double>::infinity();
+    }
+    std::nth_element(evaluated.begin(), evaluated.begin() + (elite - 1), evaluated.end());
+    return evaluated[elite - 1];
+}
+
 void Population::sortByFitness() {
     std::sort(individuals_.begin(), individuals_.end(),
               [](const Individual& a, const Individual& b) {
@@ -304,6 +468,14 @@ void Population::sortByFitness() {
               });
 }
 
+size_t Population::sortEvaluatedFirst() {
+    sortByFitness();
+    return static_cast<size_t>(std::partition_point(individuals_.begin(), individuals_.end(),
+        [](const Individual& individual) {
+            return individual.hasValidFitness();
+        }) - individuals_.begin());
+}
+
 bool Population::isGenerationComplete() const {
     // Check if all individuals have been evaluated (have valid fitness)
     // JavaScript: for(i=0; i<GA.population.length; i++) { if(!GA.population[i].fitness) return false; }
@@ -320,7 +492,7 @@ size_t Population::getProcessingCount() const {
     // JavaScript: var running = GA.population.filter(function(p){ return !!p.processing; }).length;
     size_t count = 0;
     for (const auto& individual : individuals_) {
-        if (individual.processing) {
+        if (individual.isProcessing()) {
             ++count;
         }
     }
@@ -331,6 +503,92 @@ void Population::clear() {
     individuals_.clear();
 }
 
+std::string Population::getGeneratorState() const {
+    std::ostringstream out;
+    out << rng_;
+    return out.str();
+}
+
+void Population::setGeneratorState(const std::string& state) {
+    std::istringstream in(state);
+    std::mt19937 restored;
+    if (!(in >> restored)) {
+        throw std::invalid_argument("Invalid random generator state");
+    }
+    rng_ = restored;
+}
+
+void Population::mutate(Individual& individual) {
+    if (config_.groupQuantities) {
+        individual.mutateGroups(config_.mutationRate, config_.rotations, rng_(), feasible_.get());
+    } else {
+        individual.mutate(config_.mutationRate, config_.rotations, rng_(), feasible_.get());
+    }
+}
+
+size_t Population::groupBoundary(const Individual& individual, size_t cut) {
+    const auto& placement = individual.placement;
+    auto boundary = [&](size_t i) {
+        return i == 0 || i >= placement.size() || placement[i - 1]->source != placement[i]->source;
+    };
+
+    // Back to the start of the run holding the cut, or past the first run
+    size_t back = std::min(cut, placement.size());
+    while (!boundary(back)) {
+        --back;
+    }
+    if (back > 0) {
+        return back;
+    }
+
+    size_t forward = 1;
+    while (!boundary(forward)) {
+        ++forward;
+    }
+    return std::min(forward, placement.size());
+}
+
+void Population::appendMissing(Individual& child, const Individual& parent) {
+    child.placement.reserve(parent.placement.size());
+    child.rotation.reserve(parent.rotation.size());
+
+    // Part ids are small indices, so membership is one table lookup
+    // instead of a scan of the child's genes
+    int maxId = -1;
+    for (const auto& poly : parent.placement) {
+        if (poly == nullptr || poly->id < 0) {
+            maxId = -1;
+            break;
+        }
+        maxId = std::max(maxId, poly->id);
+    }
+
+    if (maxId < 0) {
+        for (size_t i = 0; i < parent.placement.size(); ++i) {
+            if (!containsPolygon(child.placement, parent.placement[i]->id)) {
+                child.placement.push_back(parent.placement[i]);
+                child.rotation.push_back(parent.rotation[i]);
+            }
+        }
+        return;
+    }
+
+    std::vector<char> present(static_cast<size_t>(maxId) + 1, 0);
+    for (const auto& poly : child.placement) {
+        if (poly != nullptr && poly->id >= 0 && poly->id <= maxId) {
+            present[poly->id] = 1;
+        }
+    }
+    for (size_t i = 0; i < parent.placement.size(); ++i) {
+        char& seen = present[parent.placement[i]->id];
+        if (!seen) {
+            seen = 1;
+            child.placement.push_back(parent.placement[i]);
+            child.rotation.push_back(parent.rotation[i]);
+        }
+    }
+}
+
 bool Population::containsPolygon(const std::vector<std::shared_ptr<Polygon>>& placement, int polygonId) {
     // JavaScript: function contains(gene, id) { for(var i=0; i<gene.length; i++)
     //   if(gene[i].id == id) { return true; } }
@@ -0,0 +1,139 @@
+#include "../../include/deepnest/algorithm/SurrogateFitness.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace deepnest {
+
+namespace {
+
+// Samples kept for calibration, and the least needed to trust the estimate
+constexpr size_t MAX_SAMPLES = 64;
+constexpr size_t MIN_SAMPLES = 16;
+
+// Correlation from which the estimate ranks children
+constexpr double MIN_CORRELATION = 0.5;
+
+} // anonymous namespace
+
+SurrogateFitness::SurrogateFitness(const Polygon& sheet) {
+    const BoundingBox bounds = sheet.bounds();
+    sheetWidth_ = bounds.width;
+    sheetHeight_ = bounds.height;
+    sheetArea_ = std::max(std::abs(sheet.area()), 1e-9);
+}
+
+const SurrogateFitness::Extent& SurrogateFitness::extent(const Polygon& part, double rotation) {
+    const auto key = std::make_pair(part.id, rotation);
+    auto it = extents_.find(key);
+    if (it != extents_.end()) {
+        return it->second;
+    }
+
+    const double radians = rotation * M_PI / 180.0;
+    const double c = std::cos(radians);
+    const double s = std::sin(radians);
+
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (const auto& point : part.points) {
+        const double x = point.x * c - point.y * s;
+        const double y = point.x * s + point.y * c;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    Extent value;
+    value.width = part.points.empty() ? 0.0 : maxX - minX;
+    value.height = part.points.empty() ? 0.0 : maxY - minY;
+    value.area = std::abs(part.area());
+    return extents_.emplace(key, value).first->second;
+}
+
+double SurrogateFitness::estimate(const Individual& individual) {
+    // Columns filled top to bottom, left to right, as gravity placement
+    // grows the nest along x
+    double fitness = sheetArea_;
+    double columnX = 0.0;
+    double columnWidth = 0.0;
+    double y = 0.0;
+
+    for (size_t i = 0; i < individual.placement.size(); ++i) {
+        const Extent& part = extent(*individual.placement[i], individual.rotation[i]);
+
+        // Never placed: PlacementWorker's unplaced-part penalty
+        if (part.width > sheetWidth_ || part.height > sheetHeight_) {
+            fitness += 100000000.0 * (part.area / sheetArea_);
+            continue;
+        }
+
+        if (y + part.height > sheetHeight_) {
+            columnX += columnWidth;
+            columnWidth = 0.0;
+            y = 0.0;
+        }
+        if (columnX + part.width > sheetWidth_) {
+            // Sheet full: its width term, and a new sheet
+            fitness += columnX / sheetArea_ + sheetArea_;
+            columnX = 0.0;
+            columnWidth = 0.0;
+            y = 0.0;
+        }
+
+        y += part.height;
+        columnWidth = std::max(columnWidth, part.width);
+    }
+
+    return fitness + (columnX + columnWidth) / sheetArea_;
+}
+
+void SurrogateFitness::observe(const Individual& individual) {
+    if (!individual.hasValidFitness()) {
+        return;
+    }
+
+    samples_.emplace_back(estimate(individual), individual.fitness);
+    if (samples_.size() > MAX_SAMPLES) {
+        samples_.pop_front();
+    }
+}
+
+double SurrogateFitness::correlation() const {
+    const double n = static_cast<double>(samples_.size());
+    if (samples_.size() < 2) {
+        return 0.0;
+    }
+
+    double meanX = 0.0, meanY = 0.0;
+    for (const auto& sample : samples_) {
+        meanX += sample.first;
+        meanY += sample.second;
+    }
+    meanX /= n;
+    meanY /= n;
+
+    double covariance = 0.0, varianceX = 0.0, varianceY = 0.0;
+    for (const auto& sample : samples_) {
+        const double dx = sample.first - meanX;
+        const double dy = sample.second - meanY;
+        covariance += dx * dy;
+        varianceX += dx * dx;
+        varianceY += dy * dy;
+    }
+
+    // Constant estimates or fitnesses carry no ranking information
+    if (varianceX <= 0.0 || varianceY <= 0.0) {
+        return 0.0;
+    }
+    return covariance / std::sqrt(varianceX * varianceY);
+}
+
+bool SurrogateFitness::reliable() const {
+    return samples_.size() >= MIN_SAMPLES && correlation() >= MIN_CORRELATION;
+}
+
+} // namespace deepnest
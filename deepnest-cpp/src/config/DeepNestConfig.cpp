@@ -1,12 +1,32 @@
 #include "../../include/deepnest/config/DeepNestConfig.h"
-#include <QFile>
-#include <QJsonDocument>
-#include <QJsonObject>
+#include "../../include/deepnest/config/JsonWriter.h"
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <fstream>
+#include <sstream>
 #include <stdexcept>
 #include <ctime>
 
 namespace deepnest {
 
+namespace {
+
+bool has(const boost::property_tree::ptree& obj, const char* key) {
+    return obj.find(key) != obj.not_found();
+}
+
+// The value under key as a T, or fallback if it is missing or not a T
+template<typename T>
+T value(const boost::property_tree::ptree& obj, const char* key, const T& fallback) {
+    const auto it = obj.find(key);
+    if (it == obj.not_found()) {
+        return fallback;
+    }
+    return it->second.get_value<T>(fallback);
+}
+
+} // namespace
+
 // Initialize static member
 std::unique_ptr<DeepNestConfig> DeepNestConfig::instance = nullptr;
 
@@ -24,13 +44,35 @@ DeepNestConfig& DeepNestConfig::getInstance() {
 void DeepNestConfig::resetToDefaults() {
     // Default values from deepnest.js (lines 20-33)
     clipperScale = 10000000.0;
+    integerGeometry = false;
     curveTolerance = 0.3;
     spacing = 0.0;
     rotations = 4;
+    feasibleRotations = true;
+    groupQuantities = false;
+    holeFilling = false;
     populationSize = 10;
     mutationRate = 10;
+    steadyState = false;
+    islands = 1;
+    migrationInterval = 5;
+    surrogateOversampling = 1;  // 1 = no surrogate screening
     threads = 4;
+    adaptiveThreads = false;
+    minThreads = 1;
+    taskScheduler = "workstealing";
+    pinWorkerThreads = false;
+    numaScheduling = false;
+    lockProfiling = false;
+    stageTiming = false;
+    evaluationRecordPath.clear();  // empty = no recording
+    evaluationRecordFactor = 50.0;
+    evaluationRecordLimit = 10;
+    longestFirst = true;
+    remoteWorkers.clear();  // empty = local evaluation only
+    remoteWorkerToken.clear();
     placementType = "gravity";
+    rasterCellSize = 0.0;
     mergeLines = true;
     timeRatio = 0.5;
     scale = 72.0;
@@ -44,147 +86,479 @@ void DeepNestConfig::resetToDefaults() {
     // Additional runtime parameters
     maxIterations = 0;  // 0 = unlimited
     timeoutSeconds = 0;  // 0 = no timeout
+    stallGenerations = 0;  // 0 = no convergence stop
+    stopAtSheetBound = false;
+    polishMoves = 0;  // 0 = no local search
+    sheetDecompositionGenerations = 0;  // 0 = no sheet sub-nests
+    sheetDecompositionStall = 10;
+    sheetOrderSearch = false;
+    speculativeNfpPairs = 0;
+    greedyFirstResult = true;
+    nfpCacheMaxMemoryMB = 0;  // 0 = unlimited
+    nfpCacheCompact = false;
+    memoryLimitMB = 0;        // 0 = no ceiling
+    nfpStorePath.clear();     // empty = no persistent NFP store
+    checkpointPath.clear();   // empty = no checkpoints
+    checkpointGenerations = 5;
+    checkpointNFPs = true;
+    nfpRotationEquivariant = false;
+    nfpBackendProfilePath.clear();  // empty = built-in NFP backend dispatch
+    nfpBackendCalibrate = false;
+    nfpAcceleration = true;
+    coarseScreeningGenerations = -1;  // -1 = until each island converges, 0 = never
+    coarseScreeningTolerance = 2.0;
+    placementMemoMaxMemoryMB = 0;  // 0 = no placement prefix memo
+    fitnessMemoMaxEntries = 4096;
+    branchAndBound = false;
+    parallelScoringThreshold = 1024;
+    validateMergedLines = false;
     progressive = false;
     gravityDirection = GravityDirection::LEFT; // Default: prefer leftmost positions
     randomSeed = 0;  // 0 = use system time
 }
 
-void DeepNestConfig::loadFromJson(const QString& path) {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open configuration file: " + path.toStdString());
+void DeepNestConfig::loadFromJson(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open configuration file: " + path);
     }
 
-    QByteArray data = file.readAll();
-    file.close();
+    std::ostringstream data;
+    data << file.rdbuf();
+    loadFromJsonData(data.str());
+}
 
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (!doc.isObject()) {
+void DeepNestConfig::loadFromJsonData(const std::string& data) {
+    boost::property_tree::ptree obj;
+    try {
+        std::istringstream stream(data);
+        boost::property_tree::read_json(stream, obj);
+    } catch (const boost::property_tree::json_parser_error&) {
+        throw std::runtime_error("Invalid JSON configuration file");
+    }
+    // A top-level array reads as children without names
+    if (!obj.empty() && obj.front().first.empty()) {
         throw std::runtime_error("Invalid JSON configuration file");
     }
-
-    QJsonObject obj = doc.object();
 
     // Load parameters with validation (similar to svgnest.js config() method)
-    if (obj.contains("clipperScale")) {
-        clipperScale = obj["clipperScale"].toDouble(clipperScale);
+    if (has(obj, "clipperScale")) {
+        clipperScale = value(obj, "clipperScale", clipperScale);
     }
 
-    if (obj.contains("curveTolerance")) {
-        double val = obj["curveTolerance"].toDouble();
+    if (has(obj, "integerGeometry")) {
+        integerGeometry = value(obj, "integerGeometry", false);
+    }
+
+    if (has(obj, "curveTolerance")) {
+        double val = value(obj, "curveTolerance", 0.0);
         if (val > 0) {
             curveTolerance = val;
         }
     }
 
-    if (obj.contains("spacing")) {
-        spacing = obj["spacing"].toDouble(spacing);
+    if (has(obj, "spacing")) {
+        spacing = value(obj, "spacing", spacing);
     }
 
-    if (obj.contains("rotations")) {
-        int val = obj["rotations"].toInt();
+    if (has(obj, "rotations")) {
+        int val = value(obj, "rotations", 0);
         if (val > 0) {
             rotations = val;
         }
     }
 
-    if (obj.contains("populationSize")) {
-        int val = obj["populationSize"].toInt();
+    if (has(obj, "feasibleRotations")) {
+        feasibleRotations = value(obj, "feasibleRotations", feasibleRotations);
+    }
+
+    if (has(obj, "groupQuantities")) {
+        groupQuantities = value(obj, "groupQuantities", groupQuantities);
+    }
+
+    if (has(obj, "holeFilling")) {
+        holeFilling = value(obj, "holeFilling", holeFilling);
+    }
+
+    if (has(obj, "populationSize")) {
+        int val = value(obj, "populationSize", 0);
         if (val > 2) {
             populationSize = val;
         }
     }
 
-    if (obj.contains("mutationRate")) {
-        int val = obj["mutationRate"].toInt();
+    if (has(obj, "mutationRate")) {
+        int val = value(obj, "mutationRate", 0);
         if (val > 0 && val <= 100) {
             mutationRate = val;
         }
     }
 
-    if (obj.contains("threads")) {
-        int val = obj["threads"].toInt();
+    if (has(obj, "steadyState")) {
+        steadyState = value(obj, "steadyState", false);
+    }
+
+    if (has(obj, "islands")) {
+        int val = value(obj, "islands", 0);
+        if (val > 0) {
+            islands = val;
+        }
+    }
+
+    if (has(obj, "migrationInterval")) {
+        int val = value(obj, "migrationInterval", 0);
+        if (val > 0) {
+            migrationInterval = val;
+        }
+    }
+
+    if (has(obj, "surrogateOversampling")) {
+        int val = value(obj, "surrogateOversampling", 0);
+        if (val > 0) {
+            surrogateOversampling = val;
+        }
+    }
+
+    if (has(obj, "threads")) {
+        int val = value(obj, "threads", 0);
         if (val > 0) {
             threads = val;
         }
     }
 
-    if (obj.contains("placementType")) {
-        placementType = obj["placementType"].toString().toStdString();
+    if (has(obj, "adaptiveThreads")) {
+        adaptiveThreads = value(obj, "adaptiveThreads", false);
     }
 
-    if (obj.contains("mergeLines")) {
-        mergeLines = obj["mergeLines"].toBool();
+    if (has(obj, "minThreads")) {
+        int val = value(obj, "minThreads", 0);
+        if (val > 0) {
+            minThreads = val;
+        }
     }
 
-    if (obj.contains("timeRatio")) {
-        timeRatio = obj["timeRatio"].toDouble(timeRatio);
+    if (has(obj, "taskScheduler")) {
+        taskScheduler = value(obj, "taskScheduler", std::string());
     }
 
-    if (obj.contains("scale")) {
-        scale = obj["scale"].toDouble(scale);
+    if (has(obj, "pinWorkerThreads")) {
+        pinWorkerThreads = value(obj, "pinWorkerThreads", false);
     }
 
-    if (obj.contains("simplify")) {
-        simplify = obj["simplify"].toBool();
+    if (has(obj, "numaScheduling")) {
+        numaScheduling = value(obj, "numaScheduling", false);
     }
 
-    if (obj.contains("useHoles")) {
-        useHoles = obj["useHoles"].toBool();
+    if (has(obj, "lockProfiling")) {
+        lockProfiling = value(obj, "lockProfiling", false);
     }
 
-    if (obj.contains("exploreConcave")) {
-        exploreConcave = obj["exploreConcave"].toBool();
+    if (has(obj, "stageTiming")) {
+        stageTiming = value(obj, "stageTiming", false);
     }
 
-    if (obj.contains("maxIterations")) {
-        maxIterations = obj["maxIterations"].toInt(maxIterations);
+    if (has(obj, "evaluationRecordPath")) {
+        evaluationRecordPath = value(obj, "evaluationRecordPath", std::string());
     }
 
-    if (obj.contains("timeoutSeconds")) {
-        timeoutSeconds = obj["timeoutSeconds"].toInt(timeoutSeconds);
+    if (has(obj, "evaluationRecordFactor")) {
+        double val = value(obj, "evaluationRecordFactor", 50.0);
+        if (val > 1.0) {
+            evaluationRecordFactor = val;
+        }
     }
 
-    if (obj.contains("progressive")) {
-        progressive = obj["progressive"].toBool();
+    if (has(obj, "evaluationRecordLimit")) {
+        int val = value(obj, "evaluationRecordLimit", 10);
+        if (val >= 0) {
+            evaluationRecordLimit = val;
+        }
     }
 
-    if (obj.contains("randomSeed")) {
-        randomSeed = obj["randomSeed"].toInt(randomSeed);
+    if (has(obj, "longestFirst")) {
+        longestFirst = value(obj, "longestFirst", true);
+    }
+
+    if (has(obj, "remoteWorkers")) {
+        remoteWorkers = value(obj, "remoteWorkers", std::string());
+    }
+
+    if (has(obj, "remoteWorkerToken")) {
+        remoteWorkerToken = value(obj, "remoteWorkerToken", std::string());
+    }
+
+    if (has(obj, "placementType")) {
+        placementType = value(obj, "placementType", std::string());
+    }
+
+    if (has(obj, "rasterCellSize")) {
+        rasterCellSize = value(obj, "rasterCellSize", rasterCellSize);
+    }
+
+    if (has(obj, "mergeLines")) {
+        mergeLines = value(obj, "mergeLines", false);
+    }
+
+    if (has(obj, "timeRatio")) {
+        timeRatio = value(obj, "timeRatio", timeRatio);
+    }
+
+    if (has(obj, "scale")) {
+        scale = value(obj, "scale", scale);
     }
-}
 
-void DeepNestConfig::saveToJson(const QString& path) const {
-    QJsonObject obj;
+    if (has(obj, "simplify")) {
+        simplify = value(obj, "simplify", false);
+    }
 
-    obj["clipperScale"] = clipperScale;
-    obj["curveTolerance"] = curveTolerance;
-    obj["spacing"] = spacing;
-    obj["rotations"] = rotations;
-    obj["populationSize"] = populationSize;
-    obj["mutationRate"] = mutationRate;
-    obj["threads"] = threads;
-    obj["placementType"] = QString::fromStdString(placementType);
-    obj["mergeLines"] = mergeLines;
-    obj["timeRatio"] = timeRatio;
-    obj["scale"] = scale;
-    obj["simplify"] = simplify;
-    obj["useHoles"] = useHoles;
-    obj["exploreConcave"] = exploreConcave;
-    obj["maxIterations"] = maxIterations;
-    obj["timeoutSeconds"] = timeoutSeconds;
-    obj["progressive"] = progressive;
-    obj["randomSeed"] = static_cast<int>(randomSeed);
+    if (has(obj, "useHoles")) {
+        useHoles = value(obj, "useHoles", false);
+    }
 
-    QJsonDocument doc(obj);
+    if (has(obj, "exploreConcave")) {
+        exploreConcave = value(obj, "exploreConcave", false);
+    }
+
+    if (has(obj, "maxIterations")) {
+        maxIterations = value(obj, "maxIterations", maxIterations);
+    }
 
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly)) {
-        throw std::runtime_error("Failed to open file for writing: " + path.toStdString());
+    if (has(obj, "timeoutSeconds")) {
+        timeoutSeconds = value(obj, "timeoutSeconds", timeoutSeconds);
     }
 
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
+    if (has(obj, "stallGenerations")) {
+        int val = value(obj, "stallGenerations", 0);
+        if (val >= 0) {
+            stallGenerations = val;
+        }
+    }
+
+    if (has(obj, "stopAtSheetBound")) {
+        stopAtSheetBound = value(obj, "stopAtSheetBound", stopAtSheetBound);
+    }
+
+    if (has(obj, "polishMoves")) {
+        int val = value(obj, "polishMoves", 0);
+        if (val >= 0) {
+            polishMoves = val;
+        }
+    }
+
+    if (has(obj, "sheetDecompositionGenerations")) {
+        int val = value(obj, "sheetDecompositionGenerations", 0);
+        if (val >= 0) {
+            sheetDecompositionGenerations = val;
+        }
+    }
+
+    if (has(obj, "sheetDecompositionStall")) {
+        int val = value(obj, "sheetDecompositionStall", 10);
+        if (val >= 0) {
+            sheetDecompositionStall = val;
+        }
+    }
+
+    if (has(obj, "sheetOrderSearch")) {
+        sheetOrderSearch = value(obj, "sheetOrderSearch", false);
+    }
+
+    if (has(obj, "speculativeNfpPairs")) {
+        int val = value(obj, "speculativeNfpPairs", 0);
+        if (val >= 0) {
+            speculativeNfpPairs = val;
+        }
+    }
+
+    if (has(obj, "greedyFirstResult")) {
+        greedyFirstResult = value(obj, "greedyFirstResult", true);
+    }
+
+    if (has(obj, "nfpCacheMaxMemoryMB")) {
+        int val = value(obj, "nfpCacheMaxMemoryMB", 0);
+        if (val >= 0) {
+            nfpCacheMaxMemoryMB = val;
+        }
+    }
+
+    if (has(obj, "nfpCacheCompact")) {
+        nfpCacheCompact = value(obj, "nfpCacheCompact", false);
+    }
+
+    if (has(obj, "memoryLimitMB")) {
+        int val = value(obj, "memoryLimitMB", 0);
+        if (val >= 0) {
+            memoryLimitMB = val;
+        }
+    }
+
+    if (has(obj, "nfpStorePath")) {
+        nfpStorePath = value(obj, "nfpStorePath", std::string());
+    }
+
+    if (has(obj, "checkpointPath")) {
+        checkpointPath = value(obj, "checkpointPath", std::string());
+    }
+
+    if (has(obj, "checkpointGenerations")) {
+        int val = value(obj, "checkpointGenerations", 5);
+        if (val > 0) {
+            checkpointGenerations = val;
+        }
+    }
+
+    if (has(obj, "checkpointNFPs")) {
+        checkpointNFPs = value(obj, "checkpointNFPs", true);
+    }
+
+    if (has(obj, "nfpRotationEquivariant")) {
+        nfpRotationEquivariant = value(obj, "nfpRotationEquivariant", false);
+    }
+
+    if (has(obj, "nfpBackendProfilePath")) {
+        nfpBackendProfilePath = value(obj, "nfpBackendProfilePath", std::string());
+    }
+
+    if (has(obj, "nfpBackendCalibrate")) {
+        nfpBackendCalibrate = value(obj, "nfpBackendCalibrate", false);
+    }
+
+    if (has(obj, "nfpAcceleration")) {
+        nfpAcceleration = value(obj, "nfpAcceleration", true);
+    }
+
+    if (has(obj, "coarseScreeningGenerations")) {
+        int val = value(obj, "coarseScreeningGenerations", 0);
+        if (val >= -1) {
+            coarseScreeningGenerations = val;
+        }
+    }
+
+    if (has(obj, "coarseScreeningTolerance")) {
+        double val = value(obj, "coarseScreeningTolerance", 0.0);
+        if (val > 0.0) {
+            coarseScreeningTolerance = val;
+        }
+    }
+
+    if (has(obj, "placementMemoMaxMemoryMB")) {
+        int val = value(obj, "placementMemoMaxMemoryMB", 0);
+        if (val >= 0) {
+            placementMemoMaxMemoryMB = val;
+        }
+    }
+
+    if (has(obj, "fitnessMemoMaxEntries")) {
+        int val = value(obj, "fitnessMemoMaxEntries", 0);
+        if (val >= 0) {
+            fitnessMemoMaxEntries = val;
+        }
+    }
+
+    if (has(obj, "branchAndBound")) {
+        branchAndBound = value(obj, "branchAndBound", false);
+    }
+
+    if (has(obj, "parallelScoringThreshold")) {
+        int val = value(obj, "parallelScoringThreshold", 0);
+        if (val >= 0) {
+            parallelScoringThreshold = val;
+        }
+    }
+
+    if (has(obj, "validateMergedLines")) {
+        validateMergedLines = value(obj, "validateMergedLines", false);
+    }
+
+    if (has(obj, "progressive")) {
+        progressive = value(obj, "progressive", false);
+    }
+
+    if (has(obj, "randomSeed")) {
+        randomSeed = value(obj, "randomSeed", randomSeed);
+    }
+}
+
+void DeepNestConfig::saveToJson(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+
+    file << toJsonData();
+}
+
+std::string DeepNestConfig::toJsonData() const {
+    JsonWriter obj;
+
+    obj.value("clipperScale", clipperScale);
+    obj.value("integerGeometry", integerGeometry);
+    obj.value("curveTolerance", curveTolerance);
+    obj.value("spacing", spacing);
+    obj.value("rotations", rotations);
+    obj.value("feasibleRotations", feasibleRotations);
+    obj.value("groupQuantities", groupQuantities);
+    obj.value("holeFilling", holeFilling);
+    obj.value("populationSize", populationSize);
+    obj.value("mutationRate", mutationRate);
+    obj.value("steadyState", steadyState);
+    obj.value("islands", islands);
+    obj.value("migrationInterval", migrationInterval);
+    obj.value("surrogateOversampling", surrogateOversampling);
+    obj.value("threads", threads);
+    obj.value("adaptiveThreads", adaptiveThreads);
+    obj.value("minThreads", minThreads);
+    obj.value("taskScheduler", taskScheduler);
+    obj.value("pinWorkerThreads", pinWorkerThreads);
+    obj.value("numaScheduling", numaScheduling);
+    obj.value("lockProfiling", lockProfiling);
+    obj.value("stageTiming", stageTiming);
+    obj.value("evaluationRecordPath", evaluationRecordPath);
+    obj.value("evaluationRecordFactor", evaluationRecordFactor);
+    obj.value("evaluationRecordLimit", evaluationRecordLimit);
+    obj.value("longestFirst", longestFirst);
+    obj.value("remoteWorkers", remoteWorkers);
+    obj.value("remoteWorkerToken", remoteWorkerToken);
+    obj.value("placementType", placementType);
+    obj.value("rasterCellSize", rasterCellSize);
+    obj.value("mergeLines", mergeLines);
+    obj.value("timeRatio", timeRatio);
+    obj.value("scale", scale);
+    obj.value("simplify", simplify);
+    obj.value("useHoles", useHoles);
+    obj.value("exploreConcave", exploreConcave);
+    obj.value("maxIterations", maxIterations);
+    obj.value("timeoutSeconds", timeoutSeconds);
+    obj.value("stallGenerations", stallGenerations);
+    obj.value("stopAtSheetBound", stopAtSheetBound);
+    obj.value("polishMoves", polishMoves);
+    obj.value("sheetDecompositionGenerations", sheetDecompositionGenerations);
+    obj.value("sheetDecompositionStall", sheetDecompositionStall);
+    obj.value("sheetOrderSearch", sheetOrderSearch);
+    obj.value("speculativeNfpPairs", speculativeNfpPairs);
+    obj.value("greedyFirstResult", greedyFirstResult);
+    obj.value("nfpCacheMaxMemoryMB", nfpCacheMaxMemoryMB);
+    obj.value("nfpCacheCompact", nfpCacheCompact);
+    obj.value("memoryLimitMB", memoryLimitMB);
+    obj.value("nfpStorePath", nfpStorePath);
+    obj.value("checkpointPath", checkpointPath);
+    obj.value("checkpointGenerations", checkpointGenerations);
+    obj.value("checkpointNFPs", checkpointNFPs);
+    obj.value("nfpRotationEquivariant", nfpRotationEquivariant);
+    obj.value("nfpBackendProfilePath", nfpBackendProfilePath);
+    obj.value("nfpBackendCalibrate", nfpBackendCalibrate);
+    obj.value("nfpAcceleration", nfpAcceleration);
+    obj.value("coarseScreeningGenerations", coarseScreeningGenerations);
+    obj.value("coarseScreeningTolerance", coarseScreeningTolerance);
+    obj.value("placementMemoMaxMemoryMB", placementMemoMaxMemoryMB);
+    obj.value("fitnessMemoMaxEntries", fitnessMemoMaxEntries);
+    obj.value("branchAndBound", branchAndBound);
+    obj.value("parallelScoringThreshold", parallelScoringThreshold);
+    obj.value("validateMergedLines", validateMergedLines);
+    obj.value("progressive", progressive);
+    obj.value("randomSeed", static_cast<int>(randomSeed));
+
+    return obj.str();
 }
 
 // Setter methods with validation
@@ -237,4 +611,12 @@ void DeepNestConfig::setThreads(int value) {
     }
 }
 
+void DeepNestConfig::setNfpCacheMaxMemoryMB(int value) {
+    if (value >= 0) {
+        nfpCacheMaxMemoryMB = value;
+    } else {
+        throw std::invalid_argument("NFP cache memory limit must be non-negative");
+    }
+}
+
 } // namespace deepnest
@@ -0,0 +1,646 @@
+#include "../../include/deepnest/converters/DxfImporter.h"
+#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include <QFile>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace deepnest {
+
+namespace {
+
+enum class EntityKind { Line, Arc, Circle, Polyline, Spline };
+
+// An entity as read, waiting for its batch to be flattened. LWPOLYLINE
+// and POLYLINE with its VERTEX list both become a Polyline.
+struct Entity {
+    EntityKind kind = EntityKind::Line;
+    std::vector<Point> points;   // line ends, polyline vertices or spline control points
+    std::vector<double> bulges;  // one per polyline vertex
+    std::vector<double> knots;
+    std::vector<double> weights;
+    std::vector<Point> fitPoints;
+    Point center;
+    double radius = 0.0;
+    double startAngle = 0.0;
+    double endAngle = 360.0;
+    int flags = 0;
+    int degree = 3;
+    bool mirrored = false;  // Extrusion (0, 0, -1): the entity's x axis runs the other way
+};
+
+struct Piece {
+    std::vector<Point> points;
+    bool closed = false;
+};
+
+// Group code / value pairs, one line each
+class GroupReader {
+public:
+    explicit GroupReader(QIODevice* device) : device_(device) {}
+
+    // False at the end of input or when a code is not a number
+    bool next() {
+        if (!readLine(value_)) {
+            return false;
+        }
+        const auto parsed = std::from_chars(value_.data(), value_.data() + value_.size(), code_);
+        if (parsed.ec != std::errc()) {
+            malformed_ = true;
+            return false;
+        }
+        return readLine(value_);
+    }
+
+    int code() const { return code_; }
+    const std::string& value() const { return value_; }
+    bool malformed() const { return malformed_; }
+    long long line() const { return line_; }
+
+    double number() const {
+        double v = 0.0;
+        const char* begin = value_.data();
+        if (!value_.empty() && value_[0] == '+') {
+            ++begin;
+        }
+        std::from_chars(begin, value_.data() + value_.size(), v);
+        return v;
+    }
+
+    int integer() const {
+        int v = 0;
+        std::from_chars(value_.data(), value_.data() + value_.size(), v);
+        return v;
+    }
+
+private:
+    bool readLine(std::string& out) {
+        // Group values are at most 2049 characters
+        char buffer[4096];
+        if (device_->atEnd()) {
+            return false;
+        }
+        const qint64 length = device_->readLine(buffer, sizeof(buffer));
+        if (length < 0) {
+            return false;
+        }
+        ++line_;
+
+        const char* begin = buffer;
+        const char* end = buffer + length;
+        while (begin != end && std::isspace(static_cast<unsigned char>(*begin))) {
+            ++begin;
+        }
+        while (end != begin && std::isspace(static_cast<unsigned char>(end[-1]))) {
+            --end;
+        }
+        out.assign(begin, end);
+        return true;
+    }
+
+    QIODevice* device_;
+    std::string value_;
+    int code_ = 0;
+    long long line_ = 0;
+    bool malformed_ = false;
+};
+
+// Interior points of a circular arc; the ends are the caller's
+void appendArc(const Point& p1, const Point& p2, double radius, bool largeArc, bool ccw,
+               double tolerance, std::vector<Point>& out) {
+    // Arc::linearize follows SVG, whose positive sweep runs from +x
+    // towards +y: counter-clockwise in the drawing's y-up frame
+    const std::vector<Point> arc = GeometryUtil::Arc::linearize(
+        p1, p2, radius, radius, 0.0, largeArc ? 1 : 0, ccw ? 1 : 0, tolerance);
+    for (size_t i = 1; i + 1 < arc.size(); ++i) {
+        out.emplace_back(arc[i].x, arc[i].y, false);
+    }
+}
+
+void flattenCircle(const Point& center, double radius, double tolerance, Piece& piece) {
+    if (!(radius > 0.0)) {
+        return;
+    }
+    const Point east(center.x + radius, center.y, false);
+    const Point west(center.x - radius, center.y, false);
+    piece.points.push_back(east);
+    appendArc(east, west, radius, false, true, tolerance, piece.points);
+    piece.points.push_back(west);
+    appendArc(west, east, radius, false, true, tolerance, piece.points);
+    piece.closed = true;
+}
+
+void flattenArc(const Entity& e, double tolerance, Piece& piece) {
+    double extent = std::fmod(e.endAngle - e.startAngle, 360.0);
+    if (extent <= 0.0) {
+        extent += 360.0;
+    }
+    if (extent >= 360.0 - 1e-9) {
+        flattenCircle(e.center, e.radius, tolerance, piece);
+        return;
+    }
+    if (!(e.radius > 0.0)) {
+        return;
+    }
+
+    const double a0 = e.startAngle * M_PI / 180.0;
+    const double a1 = e.endAngle * M_PI / 180.0;
+    const Point p1(e.center.x + e.radius * std::cos(a0), e.center.y + e.radius * std::sin(a0));
+    const Point p2(e.center.x + e.radius * std::cos(a1), e.center.y + e.radius * std::sin(a1));
+    piece.points.push_back(p1);
+    appendArc(p1, p2, e.radius, extent > 180.0, true, tolerance, piece.points);
+    piece.points.push_back(p2);
+}
+
+void flattenPolyline(const Entity& e, double tolerance, Piece& piece) {
+    const size_t n = e.points.size();
+    if (n == 0) {
+        return;
+    }
+    piece.closed = (e.flags & 1) != 0;
+
+    const size_t segments = piece.closed ? n : n - 1;
+    piece.points.push_back(e.points[0]);
+    for (size_t i = 0; i < segments; ++i) {
+        const Point& a = e.points[i];
+        const Point& b = e.points[(i + 1) % n];
+        const double bulge = e.bulges[i];
+
+        // Bulge = tan(included angle / 4), positive counter-clockwise
+        const double chord = std::hypot(b.x - a.x, b.y - a.y);
+        if (std::abs(bulge) > 1e-12 && chord > 0.0) {
+            const double included = 4.0 * std::atan(std::abs(bulge));
+            const double radius = chord / (2.0 * std::sin(0.5 * included));
+            appendArc(a, b, radius, std::abs(bulge) > 1.0, bulge > 0.0, tolerance, piece.points);
+        }
+        if (i + 1 < n) {
+            piece.points.push_back(b);
+        }
+    }
+}
+
+// Rational B-spline point by de Boor's algorithm
+Point evaluateSpline(const Entity& e, double t) {
+    const int p = e.degree;
+    const auto& u = e.knots;
+    const int n = static_cast<int>(e.points.size());
+
+    int k = static_cast<int>(std::upper_bound(u.begin() + p, u.begin() + n, t) - u.begin()) - 1;
+    k = std::clamp(k, p, n - 1);
+
+    double x[16];
+    double y[16];
+    double w[16];
+    for (int j = 0; j <= p; ++j) {
+        const int i = j + k - p;
+        const double weight = e.weights.size() == e.points.size() ? e.weights[i] : 1.0;
+        x[j] = e.points[i].x * weight;
+        y[j] = e.points[i].y * weight;
+        w[j] = weight;
+    }
+    for (int r = 1; r <= p; ++r) {
+        for (int j = p; j >= r; --j) {
+            const int i = j + k - p;
+            const double span = u[i + p - r + 1] - u[i];
+            const double alpha = span > 0.0 ? (t - u[i]) / span : 0.0;
+            x[j] = (1.0 - alpha) * x[j - 1] + alpha * x[j];
+            y[j] = (1.0 - alpha) * y[j - 1] + alpha * y[j];
+            w[j] = (1.0 - alpha) * w[j - 1] + alpha * w[j];
+        }
+    }
+    return Point(x[p] / w[p], y[p] / w[p], false);
+}
+
+double distanceToSegment(const Point& p, const Point& a, const Point& b) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+// Halve [t0, t1] until the midpoint lies within tolerance of the chord;
+// one split at least, so an S-shaped span is not taken for a line
+void flattenSpan(const Entity& e, double t0, const Point& p0, double t1, const Point& p1,
+                 double tolerance, int depth, std::vector<Point>& out) {
+    const double tm = 0.5 * (t0 + t1);
+    const Point pm = evaluateSpline(e, tm);
+    if (depth >= 1 && (depth >= 16 || distanceToSegment(pm, p0, p1) <= tolerance)) {
+        out.push_back(p1);
+        return;
+    }
+    flattenSpan(e, t0, p0, tm, pm, tolerance, depth + 1, out);
+    flattenSpan(e, tm, pm, t1, p1, tolerance, depth + 1, out);
+}
+
+void flattenSpline(const Entity& e, double tolerance, Piece& piece) {
+    piece.closed = (e.flags & 1) != 0;
+
+    const int n = static_cast<int>(e.points.size());
+    const int p = e.degree;
+    const bool valid = p >= 1 && p < 16 && n > p &&
+                       e.knots.size() == static_cast<size_t>(n + p + 1);
+    if (!valid) {
+        // Fit points alone still trace the curve closely enough to nest
+        for (const auto& fit : e.fitPoints.empty() ? e.points : e.fitPoints) {
+            piece.points.emplace_back(fit.x, fit.y, false);
+        }
+        return;
+    }
+
+    Point previous = evaluateSpline(e, e.knots[p]);
+    piece.points.push_back(previous);
+    for (int i = p; i < n; ++i) {
+        const double t0 = e.knots[i];
+        const double t1 = e.knots[i + 1];
+        if (t1 <= t0) {
+            continue;
+        }
+        const Point end = evaluateSpline(e, t1);
+        flattenSpan(e, t0, previous, t1, end, tolerance, 0, piece.points);
+        previous = end;
+    }
+}
+
+void flattenEntity(const Entity& e, const DxfImporter::Config& config, Piece& piece) {
+    // Curves are flattened in drawing units
+    const double tolerance = config.curveTolerance / config.scale;
+
+    switch (e.kind) {
+        case EntityKind::Line:
+            piece.points = e.points;
+            break;
+        case EntityKind::Arc:
+            flattenArc(e, tolerance, piece);
+            break;
+        case EntityKind::Circle:
+            flattenCircle(e.center, e.radius, tolerance, piece);
+            break;
+        case EntityKind::Polyline:
+            flattenPolyline(e, tolerance, piece);
+            break;
+        case EntityKind::Spline:
+            flattenSpline(e, tolerance, piece);
+            break;
+    }
+
+    const double sx = e.mirrored ? -config.scale : config.scale;
+    for (auto& point : piece.points) {
+        point.x *= sx;
+        point.y *= config.scale;
+    }
+}
+
+// Joins open pieces whose ends meet, through a grid of their end points
+class PieceChainer {
+public:
+    PieceChainer(std::vector<Piece>& pieces, double tolerance)
+        : pieces_(pieces)
+        , used_(pieces.size(), false)
+        , tolerance_(tolerance)
+        , cell_(std::max(tolerance, 1e-9))
+    {
+        for (size_t i = 0; i < pieces_.size(); ++i) {
+            const auto& points = pieces_[i].points;
+            if (!pieces_[i].closed && !points.empty()) {
+                grid_[key(points.front())].push_back(2 * i);
+                grid_[key(points.back())].push_back(2 * i + 1);
+            }
+        }
+    }
+
+    // Closed contours in drawing order; counts the chains left open
+    std::vector<Piece> chain(size_t& open) {
+        std::vector<Piece> closed;
+        for (size_t i = 0; i < pieces_.size(); ++i) {
+            if (used_[i]) {
+                continue;
+            }
+            used_[i] = true;
+            Piece piece = std::move(pieces_[i]);
+            if (piece.points.empty()) {
+                continue;
+            }
+
+            if (!piece.closed) {
+                extend(piece.points);
+                if (!meets(piece.points)) {
+                    std::reverse(piece.points.begin(), piece.points.end());
+                    extend(piece.points);
+                }
+                piece.closed = meets(piece.points);
+            }
+
+            auto& points = piece.points;
+            while (points.size() > 1 && points.front().withinDistance(points.back(), tolerance_)) {
+                points.pop_back();
+            }
+            if (!piece.closed) {
+                ++open;
+            } else if (points.size() >= 3) {
+                closed.push_back(std::move(piece));
+            }
+        }
+        return closed;
+    }
+
+private:
+    using Key = std::pair<long long, long long>;
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            return std::hash<long long>()(k.first * 73856093LL ^ k.second * 19349663LL);
+        }
+    };
+
+    Key key(const Point& p) const {
+        return {static_cast<long long>(std::floor(p.x / cell_)),
+                static_cast<long long>(std::floor(p.y / cell_))};
+    }
+
+    bool meets(const std::vector<Point>& points) const {
+        return points.size() > 2 && points.front().withinDistance(points.back(), tolerance_);
+    }
+
+    // Append unused pieces at the back of the chain while one touches it
+    void extend(std::vector<Point>& chain) {
+        while (!meets(chain)) {
+            const size_t end = find(chain.back());
+            if (end == SIZE_MAX) {
+                return;
+            }
+            const size_t j = end / 2;
+            used_[j] = true;
+            const auto& next = pieces_[j].points;
+            if (end % 2 == 0) {
+                chain.insert(chain.end(), next.begin() + 1, next.end());
+            } else {
+                chain.insert(chain.end(), next.rbegin() + 1, next.rend());
+            }
+        }
+    }
+
+    // First unused end within tolerance, as 2 * piece + (1 for the back)
+    size_t find(const Point& p) const {
+        const Key center = key(p);
+        for (long long dx = -1; dx <= 1; ++dx) {
+            for (long long dy = -1; dy <= 1; ++dy) {
+                const auto it = grid_.find({center.first + dx, center.second + dy});
+                if (it == grid_.end()) {
+                    continue;
+                }
+                for (size_t end : it->second) {
+                    const size_t j = end / 2;
+                    if (used_[j]) {
+                        continue;
+                    }
+                    const auto& points = pieces_[j].points;
+                    const Point& q = end % 2 == 0 ? points.front() : points.back();
+                    if (p.withinDistance(q, tolerance_)) {
+                        return end;
+                    }
+                }
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    std::vector<Piece>& pieces_;
+    std::vector<bool> used_;
+    double tolerance_;
+    double cell_;
+    std::unordered_map<Key, std::vector<size_t>, KeyHash> grid_;
+};
+
+} // anonymous namespace
+
+DxfImporter::DxfImporter(const Config& config, ParallelFor parallelFor)
+    : config_(config)
+    , parallelFor_(std::move(parallelFor))
+{
+}
+
+DxfImporter::Result DxfImporter::importFile(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Result result;
+        result.errorMessage = QString("Cannot open file: %1").arg(fileName);
+        return result;
+    }
+    return importDevice(&file);
+}
+
+DxfImporter::Result DxfImporter::importDevice(QIODevice* device) const {
+    Result result;
+
+    // Binary DXF starts with this sentinel instead of a group code
+    if (device->peek(22).startsWith("AutoCAD Binary DXF")) {
+        result.errorMessage = QString("Binary DXF is not supported");
+        return result;
+    }
+
+    std::vector<Piece> pieces;
+    std::vector<Entity> batch;
+    batch.reserve(config_.batchSize);
+
+    auto flush = [&]() {
+        const size_t first = pieces.size();
+        pieces.resize(first + batch.size());
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                flattenEntity(batch[i], config_, pieces[first + i]);
+            }
+        };
+        if (parallelFor_ && batch.size() > 1) {
+            parallelFor_(batch.size(), body);
+        } else {
+            body(0, batch.size());
+        }
+        batch.clear();
+    };
+
+    GroupReader reader(device);
+    Entity entity;
+    bool inEntities = false;
+    bool sectionName = false;   // The next code 2 names a section
+    bool reading = false;       // Codes belong to entity
+    bool vertexList = false;    // entity is a POLYLINE whose VERTEX list is open
+    bool inVertex = false;      // Codes belong to the last VERTEX
+
+    auto finish = [&]() {
+        if (reading) {
+            batch.push_back(std::move(entity));
+            if (batch.size() >= config_.batchSize) {
+                flush();
+            }
+        }
+        reading = vertexList = inVertex = false;
+    };
+
+    while (reader.next()) {
+        const int code = reader.code();
+        const std::string& value = reader.value();
+
+        if (code == 0) {
+            if (vertexList && value == "VERTEX") {
+                entity.points.emplace_back();
+                entity.bulges.push_back(0.0);
+                inVertex = true;
+                continue;
+            }
+            finish();
+
+            if (value == "SECTION") {
+                sectionName = true;
+            } else if (value == "ENDSEC") {
+                inEntities = false;
+            } else if (inEntities) {
+                entity = Entity();
+                reading = true;
+                if (value == "LINE") {
+                    entity.kind = EntityKind::Line;
+                    entity.points.resize(2);
+                } else if (value == "ARC") {
+                    entity.kind = EntityKind::Arc;
+                } else if (value == "CIRCLE") {
+                    entity.kind = EntityKind::Circle;
+                } else if (value == "LWPOLYLINE") {
+                    entity.kind = EntityKind::Polyline;
+                } else if (value == "POLYLINE") {
+                    entity.kind = EntityKind::Polyline;
+                    vertexList = true;
+                } else if (value == "SPLINE") {
+                    entity.kind = EntityKind::Spline;
+                } else {
+                    reading = false;
+                }
+            }
+            continue;
+        }
+
+        if (sectionName && code == 2) {
+            inEntities = value == "ENTITIES";
+            sectionName = false;
+            continue;
+        }
+        if (!reading) {
+            continue;
+        }
+        if (code == 230) {
+            // LINE and SPLINE are in world coordinates, the rest in the entity's own
+            entity.mirrored = reader.number() < 0.0 &&
+                              entity.kind != EntityKind::Line && entity.kind != EntityKind::Spline;
+            continue;
+        }
+
+        if (inVertex) {
+            switch (code) {
+                case 10: entity.points.back().x = reader.number(); break;
+                case 20: entity.points.back().y = reader.number(); break;
+                case 42: entity.bulges.back() = reader.number(); break;
+                case 70:
+                    // Spline frame control points are not on the outline
+                    if (reader.integer() & 16) {
+                        entity.points.pop_back();
+                        entity.bulges.pop_back();
+                        inVertex = false;
+                    }
+                    break;
+                default: break;
+            }
+            continue;
+        }
+        if (vertexList) {
+            // The POLYLINE header's own point is a dummy
+            if (code == 70) {
+                entity.flags = reader.integer();
+            }
+            continue;
+        }
+
+        switch (entity.kind) {
+            case EntityKind::Line:
+                switch (code) {
+                    case 10: entity.points[0].x = reader.number(); break;
+                    case 20: entity.points[0].y = reader.number(); break;
+                    case 11: entity.points[1].x = reader.number(); break;
+                    case 21: entity.points[1].y = reader.number(); break;
+                    default: break;
+                }
+                break;
+            case EntityKind::Arc:
+            case EntityKind::Circle:
+                switch (code) {
+                    case 10: entity.center.x = reader.number(); break;
+                    case 20: entity.center.y = reader.number(); break;
+                    case 40: entity.radius = reader.number(); break;
+                    case 50: entity.startAngle = reader.number(); break;
+                    case 51: entity.endAngle = reader.number(); break;
+                    default: break;
+                }
+                break;
+            case EntityKind::Polyline:
+                switch (code) {
+                    case 10:
+                        entity.points.emplace_back(reader.number(), 0.0);
+                        entity.bulges.push_back(0.0);
+                        break;
+                    case 20:
+                        if (!entity.points.empty()) entity.points.back().y = reader.number();
+                        break;
+                    case 42:
+                        if (!entity.bulges.empty()) entity.bulges.back() = reader.number();
+                        break;
+                    case 70: entity.flags = reader.integer(); break;
+                    default: break;
+                }
+                break;
+            case EntityKind::Spline:
+                switch (code) {
+                    case 10: entity.points.emplace_back(reader.number(), 0.0, false); break;
+                    case 20:
+                        if (!entity.points.empty()) entity.points.back().y = reader.number();
+                        break;
+                    case 11: entity.fitPoints.emplace_back(reader.number(), 0.0, false); break;
+                    case 21:
+                        if (!entity.fitPoints.empty()) entity.fitPoints.back().y = reader.number();
+                        break;
+                    case 40: entity.knots.push_back(reader.number()); break;
+                    case 41: entity.weights.push_back(reader.number()); break;
+                    case 70: entity.flags = reader.integer(); break;
+                    case 71: entity.degree = reader.integer(); break;
+                    default: break;
+                }
+                break;
+        }
+    }
+
+    if (reader.malformed()) {
+        result.errorMessage = QString("Malformed group code at line %1").arg(reader.line());
+        return result;
+    }
+
+    finish();
+    flush();
+
+    PieceChainer chainer(pieces, config_.endpointTolerance);
+    std::vector<Piece> contours = chainer.chain(result.openPieces);
+
+    std::vector<Polygon> outlines;
+    outlines.reserve(contours.size());
+    for (auto& contour : contours) {
+        Polygon polygon;
+        polygon.points = std::move(contour.points);
+        polygon.id = static_cast<int>(outlines.size());
+        outlines.push_back(std::move(polygon));
+    }
+    result.parts = PolygonHierarchy::buildTree(outlines, 0, parallelFor_);
+    return result;
+}
+
+} // namespace deepnest
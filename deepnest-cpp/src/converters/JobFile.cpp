@@ -0,0 +1,403 @@
+#include "../../include/deepnest/converters/JobFile.h"
+#include <boost/interprocess/exceptions.hpp>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace deepnest {
+
+namespace {
+
+namespace bip = boost::interprocess;
+
+const char FILE_MAGIC[8] = {'D', 'N', 'J', 'O', 'B', '0', '0', '1'};
+const uint32_t FILE_VERSION = 1;
+
+enum SectionType : uint32_t {
+    SECTION_CONFIG = 1,
+    SECTION_POINTS = 2,
+    SECTION_EXACT = 3,
+    SECTION_RINGS = 4,
+    SECTION_ITEMS = 5,
+    SECTION_NAMES = 6,
+    SECTION_NFPS = 7
+};
+
+const uint32_t ITEM_SHEET = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+};
+
+struct SectionEntry {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+struct RingRecord {
+    uint64_t firstPoint;
+    uint32_t pointCount;
+    int32_t parent;
+};
+
+struct ItemRecord {
+    uint64_t firstRing;
+    uint64_t nameOffset;
+    uint32_t ringCount;
+    uint32_t nameBytes;
+    int32_t quantity;
+    uint32_t flags;
+};
+
+struct NfpRecord {
+    uint64_t geometryA;
+    uint64_t geometryB;
+    uint64_t firstRing;
+    int32_t rotationA;
+    int32_t rotationB;
+    uint32_t ringCount;
+    uint32_t inside;
+};
+
+// Records are read in place, so every section start must suit them
+static_assert(sizeof(RingRecord) % 8 == 0 && sizeof(ItemRecord) % 8 == 0 &&
+              sizeof(NfpRecord) % 8 == 0 && sizeof(SectionEntry) % 8 == 0 &&
+              sizeof(FileHeader) % 8 == 0, "job records must keep 8-byte alignment");
+
+/**
+ * @brief Flattens polygon lists into the POINTS, EXACT and RINGS sections
+ */
+class RingWriter {
+public:
+    std::string points;
+    std::string exact;
+    std::vector<RingRecord> rings;
+
+    // Rings of list in preorder; returns how many were added
+    uint32_t add(const std::vector<Polygon>& list) {
+        const size_t first = rings.size();
+        for (const auto& polygon : list) {
+            add(polygon, -1, first);
+        }
+        return static_cast<uint32_t>(rings.size() - first);
+    }
+
+private:
+    void add(const Polygon& polygon, int32_t parent, size_t first) {
+        const int32_t index = static_cast<int32_t>(rings.size() - first);
+        rings.push_back(RingRecord{points.size() / (2 * sizeof(double)),
+                                   static_cast<uint32_t>(polygon.points.size()), parent});
+        for (const auto& p : polygon.points) {
+            // Stored as double whatever the build's Coord
+            const double xy[2] = {p.x, p.y};
+            points.append(reinterpret_cast<const char*>(xy), sizeof(xy));
+            exact.push_back(p.exact ? 1 : 0);
+        }
+        for (const auto& child : polygon.children) {
+            add(child, index, first);
+        }
+    }
+};
+
+template <typename T>
+std::string bytesOf(const std::vector<T>& records) {
+    return std::string(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+}
+
+uint64_t padded(uint64_t bytes) {
+    return (bytes + 7) & ~uint64_t(7);
+}
+
+// Rings [first, first + count) in preorder: each parent is an ancestor
+// still open at that point, so decoding needs no second pass
+bool isPreorder(const RingRecord* rings, uint64_t first, uint32_t count, bool singleRoot) {
+    std::vector<int32_t> open;
+    for (uint32_t k = 0; k < count; ++k) {
+        const int32_t parent = rings[first + k].parent;
+        if (parent == -1) {
+            if (singleRoot && k > 0) {
+                return false;
+            }
+            open.clear();
+        } else {
+            while (!open.empty() && open.back() != parent) {
+                open.pop_back();
+            }
+            if (open.empty()) {
+                return false;
+            }
+        }
+        open.push_back(static_cast<int32_t>(k));
+    }
+    return !singleRoot || count > 0;
+}
+
+} // anonymous namespace
+
+JobFile::JobFile() = default;
+
+JobFile::~JobFile() = default;
+
+void JobFile::write(const std::string& path, const std::string& config,
+                    const std::vector<Item>& items, const std::vector<StoredNfp>& nfps) {
+    RingWriter rings;
+    std::vector<ItemRecord> itemRecords;
+    std::string names;
+    itemRecords.reserve(items.size());
+    for (const auto& item : items) {
+        ItemRecord record{};
+        record.firstRing = rings.rings.size();
+        record.ringCount = rings.add({item.polygon});
+        record.nameOffset = names.size();
+        record.nameBytes = static_cast<uint32_t>(item.name.size());
+        record.quantity = item.quantity;
+        record.flags = item.sheet ? ITEM_SHEET : 0;
+        names += item.name;
+        itemRecords.push_back(record);
+    }
+
+    std::vector<NfpRecord> nfpRecords;
+    nfpRecords.reserve(nfps.size());
+    for (const auto& nfp : nfps) {
+        NfpRecord record{};
+        record.geometryA = nfp.key.geometryA;
+        record.geometryB = nfp.key.geometryB;
+        record.rotationA = nfp.key.rotationA;
+        record.rotationB = nfp.key.rotationB;
+        record.inside = nfp.key.inside ? 1 : 0;
+        record.firstRing = rings.rings.size();
+        record.ringCount = rings.add(nfp.polygons);
+        nfpRecords.push_back(record);
+    }
+
+    const std::vector<std::pair<uint32_t, std::string>> sections = {
+        {SECTION_CONFIG, config},
+        {SECTION_POINTS, rings.points},
+        {SECTION_EXACT, rings.exact},
+        {SECTION_RINGS, bytesOf(rings.rings)},
+        {SECTION_ITEMS, bytesOf(itemRecords)},
+        {SECTION_NAMES, names},
+        {SECTION_NFPS, bytesOf(nfpRecords)},
+    };
+
+    FileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+
+    std::vector<SectionEntry> table;
+    uint64_t offset = sizeof(FileHeader) + sections.size() * sizeof(SectionEntry);
+    for (const auto& section : sections) {
+        table.push_back(SectionEntry{section.first, 0, offset, section.second.size()});
+        offset += padded(section.second.size());
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to open job file for writing: " + path);
+    }
+    const char zeros[8] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(SectionEntry));
+    for (const auto& section : sections) {
+        out.write(section.second.data(), section.second.size());
+        out.write(zeros, padded(section.second.size()) - section.second.size());
+    }
+    if (!out.flush()) {
+        throw std::runtime_error("Failed to write job file: " + path);
+    }
+}
+
+bool JobFile::fail(const std::string& message) {
+    region_.reset();
+    mapping_.reset();
+    error_ = message;
+    return false;
+}
+
+bool JobFile::open(const std::string& path) {
+    region_.reset();
+    mapping_.reset();
+    error_.clear();
+
+    try {
+        mapping_.reset(new bip::file_mapping(path.c_str(), bip::read_only));
+        region_.reset(new bip::mapped_region(*mapping_, bip::read_only));
+    } catch (const bip::interprocess_exception& e) {
+        return fail("Cannot map job file " + path + ": " + e.what());
+    }
+
+    const char* base = static_cast<const char*>(region_->get_address());
+    const uint64_t size = region_->get_size();
+
+    FileHeader header;
+    if (size < sizeof(header)) {
+        return fail(path + " is not a job file");
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        return fail(path + " is not a job file");
+    }
+    if (header.version != FILE_VERSION) {
+        return fail(path + " has unsupported job version " + std::to_string(header.version));
+    }
+    if (header.sectionCount > (size - sizeof(header)) / sizeof(SectionEntry)) {
+        return fail(path + " has a truncated section table");
+    }
+
+    // Sections of later versions are skipped; the known ones must fit
+    uint64_t bytes[SECTION_NFPS + 1] = {};
+    const char* start[SECTION_NFPS + 1] = {};
+    const auto* table = reinterpret_cast<const SectionEntry*>(base + sizeof(header));
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        const SectionEntry& entry = table[i];
+        if (entry.offset % 8 != 0 || entry.offset > size || entry.bytes > size - entry.offset) {
+            return fail(path + " has a section outside the file");
+        }
+        if (entry.type >= SECTION_CONFIG && entry.type <= SECTION_NFPS) {
+            start[entry.type] = base + entry.offset;
+            bytes[entry.type] = entry.bytes;
+        }
+    }
+    for (uint32_t type = SECTION_CONFIG; type <= SECTION_NAMES; ++type) {
+        if (!start[type]) {
+            return fail(path + " is missing a required section");
+        }
+    }
+
+    const uint64_t pointCount = bytes[SECTION_POINTS] / (2 * sizeof(double));
+    const uint64_t ringCount = bytes[SECTION_RINGS] / sizeof(RingRecord);
+    if (bytes[SECTION_EXACT] != pointCount ||
+        bytes[SECTION_ITEMS] % sizeof(ItemRecord) != 0 ||
+        bytes[SECTION_NFPS] % sizeof(NfpRecord) != 0) {
+        return fail(path + " has inconsistent section sizes");
+    }
+
+    const auto* rings = reinterpret_cast<const RingRecord*>(start[SECTION_RINGS]);
+    for (uint64_t r = 0; r < ringCount; ++r) {
+        if (rings[r].firstPoint > pointCount || rings[r].pointCount > pointCount - rings[r].firstPoint) {
+            return fail(path + " has a ring outside the point table");
+        }
+    }
+
+    const auto* items = reinterpret_cast<const ItemRecord*>(start[SECTION_ITEMS]);
+    const uint64_t itemTotal = bytes[SECTION_ITEMS] / sizeof(ItemRecord);
+    for (uint64_t i = 0; i < itemTotal; ++i) {
+        const ItemRecord& item = items[i];
+        if (item.firstRing > ringCount || item.ringCount > ringCount - item.firstRing ||
+            !isPreorder(rings, item.firstRing, item.ringCount, true) ||
+            item.nameOffset > bytes[SECTION_NAMES] ||
+            item.nameBytes > bytes[SECTION_NAMES] - item.nameOffset) {
+            return fail(path + " has an invalid item " + std::to_string(i));
+        }
+    }
+
+    const auto* nfps = reinterpret_cast<const NfpRecord*>(start[SECTION_NFPS]);
+    const uint64_t nfpTotal = bytes[SECTION_NFPS] / sizeof(NfpRecord);
+    for (uint64_t i = 0; i < nfpTotal; ++i) {
+        const NfpRecord& nfp = nfps[i];
+        if (nfp.firstRing > ringCount || nfp.ringCount > ringCount - nfp.firstRing ||
+            !isPreorder(rings, nfp.firstRing, nfp.ringCount, false)) {
+            return fail(path + " has an invalid NFP " + std::to_string(i));
+        }
+    }
+
+    config_ = start[SECTION_CONFIG];
+    configBytes_ = bytes[SECTION_CONFIG];
+    points_ = reinterpret_cast<const double*>(start[SECTION_POINTS]);
+    exact_ = reinterpret_cast<const uint8_t*>(start[SECTION_EXACT]);
+    rings_ = start[SECTION_RINGS];
+    items_ = start[SECTION_ITEMS];
+    names_ = start[SECTION_NAMES];
+    nfps_ = start[SECTION_NFPS];
+    itemCount_ = static_cast<size_t>(itemTotal);
+    nfpCount_ = static_cast<size_t>(nfpTotal);
+    return true;
+}
+
+std::string JobFile::config() const {
+    return std::string(config_, configBytes_);
+}
+
+bool JobFile::isSheet(size_t item) const {
+    return (reinterpret_cast<const ItemRecord*>(items_)[item].flags & ITEM_SHEET) != 0;
+}
+
+int JobFile::quantity(size_t item) const {
+    return reinterpret_cast<const ItemRecord*>(items_)[item].quantity;
+}
+
+std::string JobFile::name(size_t item) const {
+    const ItemRecord& record = reinterpret_cast<const ItemRecord*>(items_)[item];
+    return std::string(names_ + record.nameOffset, record.nameBytes);
+}
+
+size_t JobFile::ringCount(size_t item) const {
+    return reinterpret_cast<const ItemRecord*>(items_)[item].ringCount;
+}
+
+JobFile::Ring JobFile::ring(size_t item, size_t index) const {
+    return ringAt(reinterpret_cast<const ItemRecord*>(items_)[item].firstRing + index);
+}
+
+JobFile::Ring JobFile::ringAt(uint64_t index) const {
+    const RingRecord& record = reinterpret_cast<const RingRecord*>(rings_)[index];
+    return Ring{points_ + 2 * record.firstPoint, exact_ + record.firstPoint,
+                record.pointCount, record.parent};
+}
+
+std::vector<Polygon> JobFile::polygons(uint64_t firstRing, uint32_t ringCount) const {
+    // Preorder: a ring's children follow it directly, so a stack of the
+    // open ancestors places each ring
+    std::vector<Polygon> roots;
+    std::vector<Polygon*> open;
+    for (uint32_t k = 0; k < ringCount; ++k) {
+        const Ring r = ringAt(firstRing + k);
+        Polygon polygon;
+        polygon.points.reserve(r.size);
+        for (uint32_t i = 0; i < r.size; ++i) {
+            polygon.points.push_back(r.point(i));
+        }
+
+        std::vector<Polygon>* siblings = &roots;
+        if (r.parent < 0) {
+            open.clear();
+        } else {
+            open.resize(static_cast<size_t>(r.parent) + 1);
+            siblings = &open.back()->children;
+        }
+        siblings->push_back(std::move(polygon));
+        open.resize(static_cast<size_t>(k) + 1);
+        open[k] = &siblings->back();
+    }
+    return roots;
+}
+
+Polygon JobFile::polygon(size_t item) const {
+    const ItemRecord& record = reinterpret_cast<const ItemRecord*>(items_)[item];
+    Polygon result = std::move(polygons(record.firstRing, record.ringCount).front());
+    result.id = static_cast<int>(item);
+    return result;
+}
+
+PersistentNFPStore::Key JobFile::nfpKey(size_t nfp) const {
+    const NfpRecord& record = reinterpret_cast<const NfpRecord*>(nfps_)[nfp];
+    PersistentNFPStore::Key key;
+    key.geometryA = record.geometryA;
+    key.geometryB = record.geometryB;
+    key.rotationA = record.rotationA;
+    key.rotationB = record.rotationB;
+    key.inside = record.inside != 0;
+    return key;
+}
+
+std::vector<Polygon> JobFile::nfp(size_t nfp) const {
+    const NfpRecord& record = reinterpret_cast<const NfpRecord*>(nfps_)[nfp];
+    return polygons(record.firstRing, record.ringCount);
+}
+
+} // namespace deepnest
@@ -1,8 +1,199 @@
 #include "../../include/deepnest/converters/QtBoostConverter.h"
+#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/geometry/PolygonHierarchy.h"
 #include <boost/polygon/polygon.hpp>
 #include <QPolygonF>
 
 namespace deepnest {
+
+// ========== Qt members of Point and Polygon ==========
+// Declared in core/Point.h and core/Polygon.h, defined here so that the
+// headless core library does not link Qt
+
+Point Point::fromQt(const QPointF& p, bool exact) {
+    return Point(p.x(), p.y(), exact);
+}
+
+QPointF Point::toQt() const {
+    return QPointF(x, y);
+}
+
+QPainterPath Polygon::toQPainterPath() const {
+    QPainterPath path;
+
+    if (points.empty()) {
+        return path;
+    }
+
+    // Add outer boundary
+    path.moveTo(points[0].toQt());
+    for (size_t i = 1; i < points.size(); i++) {
+        path.lineTo(points[i].toQt());
+    }
+    path.closeSubpath();
+
+    // Add holes
+    for (const auto& hole : children) {
+        if (!hole.points.empty()) {
+            path.moveTo(hole.points[0].toQt());
+            for (size_t i = 1; i < hole.points.size(); i++) {
+                path.lineTo(hole.points[i].toQt());
+            }
+            path.closeSubpath();
+        }
+    }
+
+    return path;
+}
+
+Polygon Polygon::fromQPainterPath(const QPainterPath& path) {
+    return fromQPainterPath(path, -1);
+}
+
+Polygon Polygon::fromQPainterPath(const QPainterPath& path, int polygonId) {
+    Polygon result;
+    result.id = polygonId;
+
+    if (path.isEmpty()) {
+        return result;
+    }
+
+    // Simplify path BEFORE conversion to remove degenerate geometries
+    // and redundant curve control points that cause Boost.Polygon scanline failures
+    // Step 1: Set proper fill rule for complex paths
+    QPainterPath cleanPath = path;
+    cleanPath.setFillRule(Qt::WindingFill);
+
+    // Step 2: Apply simplified() which merges overlapping/degenerate regions
+    cleanPath = cleanPath.simplified();
+
+    // Convert QPainterPath to polygon points
+    // Use Qt's toSubpathPolygons() which automatically converts curves to line segments
+    QList<QPolygonF> subpaths = cleanPath.toSubpathPolygons();
+
+    if (subpaths.isEmpty()) {
+        return result;
+    }
+
+    // If only one subpath, simple case - no hierarchy needed
+    if (subpaths.size() == 1) {
+        const QPolygonF& firstSubpath = subpaths.first();
+
+        // Convert QPolygonF to vector<Point>
+        std::vector<Point> pathPoints;
+        pathPoints.reserve(firstSubpath.size());
+        for (const QPointF& qpt : firstSubpath) {
+            pathPoints.push_back(Point::fromQt(qpt));
+        }
+
+        // Apply Ramer-Douglas-Peucker simplification
+        std::vector<Point> simplifiedPoints = GeometryUtil::simplifyPolygon(
+            pathPoints,
+            2.0,        // tolerance (matches JavaScript config)
+            false       // use two-pass approach
+        );
+
+        if (simplifiedPoints.size() >= 3) {
+            result.points = std::move(simplifiedPoints);
+        }
+
+        return result;
+    }
+
+    // Multiple subpaths - use PolygonHierarchy::buildTree to automatically
+    // determine parent-child relationships based on containment
+    // This matches JavaScript toTree() logic from svgnest.js lines 541-591
+    
+    std::vector<Polygon> allPolygons;
+    
+    for (int i = 0; i < subpaths.size(); ++i) {
+        const QPolygonF& subpath = subpaths[i];
+
+        Polygon poly;
+        poly.points.reserve(subpath.size());
+        for (const QPointF& pt : subpath) {
+            poly.points.push_back(Point::fromQt(pt));
+        }
+
+        // Apply simplification to each subpath
+        if (poly.points.size() >= 3) {
+            std::vector<Point> simplifiedPoints = GeometryUtil::simplifyPolygon(
+                poly.points,
+                2.0,
+                false
+            );
+            
+            if (simplifiedPoints.size() >= 3) {
+                poly.points = std::move(simplifiedPoints);
+                allPolygons.push_back(poly);
+            }
+        }
+    }
+
+    if (allPolygons.empty()) {
+        return result;
+    }
+
+    // Build hierarchy using PolygonHierarchy::buildTree
+    // This automatically identifies which polygons are holes based on containment
+    std::vector<Polygon> tree = PolygonHierarchy::buildTree(allPolygons, polygonId);
+
+    // Return the first top-level polygon (or empty if none)
+    if (!tree.empty()) {
+        result = tree[0];
+        // If polygonId was specified, ensure it's set
+        if (polygonId >= 0) {
+            result.id = polygonId;
+        }
+    }
+
+    return result;
+}
+
+std::vector<Polygon> Polygon::extractFromQPainterPath(const QPainterPath& path) {
+    std::vector<Polygon> polygons;
+
+    // QPainterPath can contain multiple disconnected subpaths
+    // We need to extract each one as a separate polygon
+
+    // Apply same cleaning as fromQPainterPath for consistency
+    QPainterPath cleanPath = path;
+    cleanPath.setFillRule(Qt::WindingFill);
+    cleanPath = cleanPath.simplified();
+    QList<QPolygonF> qtPolygons = cleanPath.toSubpathPolygons();
+
+    for (const auto& qtPoly : qtPolygons) {
+        if (qtPoly.size() < 3) {
+            continue;
+        }
+
+        // Convert QPolygonF to vector<Point>
+        std::vector<Point> pathPoints;
+        pathPoints.reserve(qtPoly.size());
+        for (const QPointF& qpt : qtPoly) {
+            pathPoints.push_back(Point::fromQt(qpt));
+        }
+
+        // Apply Ramer-Douglas-Peucker simplification (same as fromQPainterPath)
+        std::vector<Point> simplifiedPoints = GeometryUtil::simplifyPolygon(
+            pathPoints,
+            2.0,        // tolerance (matches JavaScript config)
+            false       // use two-pass approach
+        );
+
+        if (simplifiedPoints.size() >= 3) {
+            Polygon poly;
+            poly.points = std::move(simplifiedPoints);
+
+            if (poly.isValid()) {
+                polygons.push_back(poly);
+            }
+        }
+    }
+
+    return polygons;
+}
+
 namespace QtBoostConverter {
 
 // ========== Point Conversions ==========
@@ -0,0 +1,560 @@
+#include "../../include/deepnest/converters/ResultExporter.h"
+#include "../../include/deepnest/geometry/Transformation.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace deepnest {
+
+namespace {
+
+// A run of points written as one path; closed when it is a whole ring
+struct Run {
+    std::vector<Point> points;
+    bool closed = false;
+};
+
+/**
+ * Edges already written on the current sheet, bucketed by grid cell so
+ * that a new edge only visits those that can lie along it
+ */
+class CommonLines {
+public:
+    CommonLines(double tolerance, double cellSize)
+        : tolerance_(tolerance), cellSize_(std::max(cellSize, 4.0 * tolerance)) {}
+
+    /**
+     * Parts of a-b, as distances from a, that no written edge covers
+     */
+    void uncovered(const Point& a, const Point& b, std::vector<std::pair<double, double>>& keep) {
+        keep.clear();
+        const double dx = b.x - a.x;
+        const double dy = b.y - a.y;
+        const double length = std::sqrt(dx * dx + dy * dy);
+        const double ux = dx / length;
+        const double uy = dy / length;
+
+        covered_.clear();
+        ++epoch_;
+        visit(a, b, [&](uint32_t index) {
+            if (seen_[index] == epoch_) {
+                return;
+            }
+            seen_[index] = epoch_;
+
+            const Edge& e = edges_[index];
+            // Both ends of the written edge within tolerance of the line
+            const double d1 = (e.a.x - a.x) * uy - (e.a.y - a.y) * ux;
+            const double d2 = (e.b.x - a.x) * uy - (e.b.y - a.y) * ux;
+            if (std::abs(d1) > tolerance_ || std::abs(d2) > tolerance_) {
+                return;
+            }
+            const double t1 = (e.a.x - a.x) * ux + (e.a.y - a.y) * uy;
+            const double t2 = (e.b.x - a.x) * ux + (e.b.y - a.y) * uy;
+            const double lo = std::max(0.0, std::min(t1, t2));
+            const double hi = std::min(length, std::max(t1, t2));
+            if (hi - lo > tolerance_) {
+                covered_.emplace_back(lo, hi);
+            }
+        });
+
+        std::sort(covered_.begin(), covered_.end());
+        double from = 0.0;
+        for (const auto& span : covered_) {
+            if (span.first - from > tolerance_) {
+                keep.emplace_back(from, span.first);
+            }
+            from = std::max(from, span.second);
+        }
+        if (length - from > tolerance_) {
+            keep.emplace_back(from, length);
+        }
+    }
+
+    void add(const Point& a, const Point& b) {
+        const uint32_t index = static_cast<uint32_t>(edges_.size());
+        edges_.push_back({a, b});
+        seen_.push_back(0);
+
+        const Cells cells = span(a, b);
+        if (cells.count() > MAX_CELLS) {
+            long_.push_back(index);
+            return;
+        }
+        for (int64_t row = cells.row0; row <= cells.row1; ++row) {
+            for (int64_t column = cells.column0; column <= cells.column1; ++column) {
+                cells_[key(column, row)].push_back(index);
+            }
+        }
+    }
+
+private:
+    struct Edge {
+        Point a;
+        Point b;
+    };
+
+    struct Cells {
+        int64_t column0, row0, column1, row1;
+        int64_t count() const { return (column1 - column0 + 1) * (row1 - row0 + 1); }
+    };
+
+    // Edges over more cells than this are checked against every query
+    static constexpr int64_t MAX_CELLS = 256;
+
+    Cells span(const Point& a, const Point& b) const {
+        auto cell = [this](double v) { return static_cast<int64_t>(std::floor(v / cellSize_)); };
+        return {cell(std::min(a.x, b.x) - tolerance_), cell(std::min(a.y, b.y) - tolerance_),
+                cell(std::max(a.x, b.x) + tolerance_), cell(std::max(a.y, b.y) + tolerance_)};
+    }
+
+    static uint64_t key(int64_t column, int64_t row) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(column)) << 32) | static_cast<uint32_t>(row);
+    }
+
+    template<typename Visit>
+    void visit(const Point& a, const Point& b, Visit&& f) const {
+        for (uint32_t index : long_) {
+            f(index);
+        }
+        const Cells cells = span(a, b);
+        if (cells.count() > MAX_CELLS) {
+            for (uint32_t index = 0; index < edges_.size(); ++index) {
+                f(index);
+            }
+            return;
+        }
+        for (int64_t row = cells.row0; row <= cells.row1; ++row) {
+            for (int64_t column = cells.column0; column <= cells.column1; ++column) {
+                const auto it = cells_.find(key(column, row));
+                if (it != cells_.end()) {
+                    for (uint32_t index : it->second) {
+                        f(index);
+                    }
+                }
+            }
+        }
+    }
+
+    double tolerance_;
+    double cellSize_;
+    std::vector<Edge> edges_;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+    std::vector<uint32_t> long_;
+    std::vector<uint32_t> seen_;
+    uint32_t epoch_ = 0;
+    std::vector<std::pair<double, double>> covered_;
+};
+
+Point along(const Point& a, const Point& b, double length, double t) {
+    const double f = t / length;
+    return Point(a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f);
+}
+
+} // namespace
+
+/**
+ * Formats one result into the sink, a buffer at a time
+ */
+class ResultExporter::Writer {
+public:
+    Writer(const ResultExporter::Config& config, const Sink& sink) : config_(config), sink_(sink) {
+        buffer_.reserve(config.bufferBytes + 4096);
+    }
+
+    bool ok() const { return ok_; }
+
+    void begin(double minX, double minY, double width, double height) {
+        if (config_.format == Format::SVG) {
+            text("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"");
+            number(width);
+            text("\" height=\"");
+            number(height);
+            text("\" viewBox=\"");
+            number(minX);
+            text(" ");
+            number(minY);
+            text(" ");
+            number(width);
+            text(" ");
+            number(height);
+            text("\">\n");
+        } else {
+            text("0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1009\n0\nENDSEC\n"
+                 "0\nSECTION\n2\nENTITIES\n");
+        }
+    }
+
+    void end() {
+        if (config_.format == Format::SVG) {
+            text("</svg>\n");
+        } else {
+            text("0\nENDSEC\n0\nEOF\n");
+        }
+        drain();
+    }
+
+    void beginSheet(size_t index, const RingBatch& outline) {
+        if (config_.format == Format::SVG) {
+            text("<g id=\"sheet-");
+            integer(static_cast<long long>(index));
+            text("\" fill=\"none\" stroke=\"#000\">\n<path class=\"sheet\" d=\"");
+            for (size_t r = 0; r < outline.ringCount(); ++r) {
+                svgRun(outline.ringBegin(r), outline.ringEnd(r), true);
+            }
+            text("\"/>\n");
+        } else {
+            for (size_t r = 0; r < outline.ringCount(); ++r) {
+                dxfRun(outline.ringBegin(r), outline.ringEnd(r), true, "SHEET");
+            }
+        }
+    }
+
+    void endSheet() {
+        if (config_.format == Format::SVG) {
+            text("</g>\n");
+        }
+        // Hand each finished sheet on, even if the buffer is not full
+        drain();
+    }
+
+    void part(const PlacementWorker::Placement& placement, const std::vector<Run>& runs) {
+        if (config_.format == Format::SVG) {
+            text("<path class=\"part\" data-id=\"");
+            integer(placement.id);
+            text("\" data-source=\"");
+            integer(placement.source);
+            text("\" d=\"");
+            for (const auto& run : runs) {
+                svgRun(run.points.data(), run.points.data() + run.points.size(), run.closed);
+            }
+            text("\"/>\n");
+        } else {
+            for (const auto& run : runs) {
+                dxfRun(run.points.data(), run.points.data() + run.points.size(), run.closed, "PART");
+            }
+        }
+        if (buffer_.size() >= config_.bufferBytes) {
+            drain();
+        }
+    }
+
+private:
+    void svgRun(const Point* begin, const Point* end, bool closed) {
+        if (begin == end) {
+            return;
+        }
+        text("M");
+        for (const Point* p = begin; p != end; ++p) {
+            if (p != begin) {
+                text(p == begin + 1 ? " L" : " ");
+            }
+            number(p->x);
+            text(",");
+            number(p->y);
+        }
+        text(closed ? " Z " : " ");
+    }
+
+    void dxfRun(const Point* begin, const Point* end, bool closed, const char* layer) {
+        if (end - begin < 2) {
+            return;
+        }
+        text("0\nPOLYLINE\n8\n");
+        text(layer);
+        text(closed ? "\n66\n1\n70\n1\n" : "\n66\n1\n70\n0\n");
+        text("10\n0\n20\n0\n30\n0\n");
+        for (const Point* p = begin; p != end; ++p) {
+            text("0\nVERTEX\n8\n");
+            text(layer);
+            text("\n10\n");
+            number(p->x);
+            text("\n20\n");
+            number(p->y);
+            text("\n");
+        }
+        text("0\nSEQEND\n8\n");
+        text(layer);
+        text("\n");
+    }
+
+    void text(const char* s) { buffer_ += s; }
+
+    // Shortest text that reads back as the same double
+    void number(double v) {
+        char digits[32];
+        const auto written = std::to_chars(digits, digits + sizeof(digits), v == 0.0 ? 0.0 : v);
+        buffer_.append(digits, written.ptr);
+    }
+
+    void integer(long long v) {
+        char digits[24];
+        const auto written = std::to_chars(digits, digits + sizeof(digits), v);
+        buffer_.append(digits, written.ptr);
+    }
+
+    void drain() {
+        if (ok_ && !buffer_.empty()) {
+            ok_ = sink_(buffer_.data(), buffer_.size());
+        }
+        buffer_.clear();
+    }
+
+    const ResultExporter::Config& config_;
+    const Sink& sink_;
+    std::string buffer_;
+    bool ok_ = true;
+};
+
+ResultExporter::ResultExporter(const std::vector<Polygon>& parts,
+                               const std::vector<Polygon>& sheets,
+                               const std::vector<int>& sheetQuantities,
+                               const Config& config)
+    : parts_(parts), config_(config) {
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        const int quantity = i < sheetQuantities.size() ? sheetQuantities[i] : 1;
+        for (int q = 0; q < quantity; ++q) {
+            sheets_.push_back(sheets[i]);
+        }
+    }
+}
+
+ResultExporter::~ResultExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::vector<ResultExporter::SheetLayout> ResultExporter::layout(const NestResult& result) const {
+    std::vector<SheetLayout> sheets;
+    sheets.reserve(result.placements.size());
+    double x = 0.0;
+    for (size_t i = 0; i < result.placements.size(); ++i) {
+        const size_t index = result.sheetIndex(i);
+        if (index >= sheets_.size()) {
+            break;
+        }
+        const BoundingBox box = sheets_[index].bounds();
+        sheets.push_back({&sheets_[index], x - box.x});
+        x += box.width + config_.sheetGap;
+    }
+    return sheets;
+}
+
+bool ResultExporter::write(const NestResult& result, const Sink& sink) const {
+    const std::vector<SheetLayout> sheets = layout(result);
+
+    double minY = 0.0;
+    double maxY = 0.0;
+    double maxX = 0.0;
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        const BoundingBox box = sheets[i].sheet->bounds();
+        minY = i == 0 ? box.y : std::min(minY, box.y);
+        maxY = i == 0 ? box.y + box.height : std::max(maxY, box.y + box.height);
+        maxX = box.x + sheets[i].offsetX + box.width;
+    }
+
+    Writer writer(config_, sink);
+    writer.begin(0.0, minY, maxX, maxY - minY);
+
+    std::vector<Transformation::BatchItem> items;
+    std::vector<size_t> firstRing;
+    RingBatch outline;
+    RingBatch placed;
+    std::vector<Run> runs;
+    std::vector<std::pair<double, double>> keep;
+
+    for (size_t s = 0; s < sheets.size() && writer.ok(); ++s) {
+        const Polygon& sheet = *sheets[s].sheet;
+        const Point sheetOffset(sheets[s].offsetX, 0.0);
+
+        items.clear();
+        items.emplace_back(&sheet.points, 0.0, sheetOffset);
+        for (const auto& hole : sheet.children) {
+            items.emplace_back(&hole.points, 0.0, sheetOffset);
+        }
+        Transformation::applyBatch(items, outline);
+        writer.beginSheet(s, outline);
+
+        // Every placed outline and hole of the sheet in one pass:
+        // rotate about the origin, then move to position + sheet offset
+        const auto& sheetPlacements = result.placements[s];
+        items.clear();
+        firstRing.clear();
+        for (const auto& placement : sheetPlacements) {
+            const int sourceId = placement.source >= 0 ? placement.source : placement.id;
+            firstRing.push_back(items.size());
+            if (sourceId >= 0 && sourceId < static_cast<int>(parts_.size())) {
+                const Polygon& part = parts_[sourceId];
+                const Point offset(placement.position.x + sheetOffset.x, placement.position.y);
+                items.emplace_back(&part.points, placement.rotation, offset);
+                for (const auto& hole : part.children) {
+                    items.emplace_back(&hole.points, placement.rotation, offset);
+                }
+            }
+        }
+        firstRing.push_back(items.size());
+        Transformation::applyBatch(items, placed);
+
+        std::unique_ptr<CommonLines> common;
+        if (config_.mergeLines) {
+            double edgeLength = 0.0;
+            for (size_t r = 0; r < placed.ringCount(); ++r) {
+                const Point* p = placed.ringBegin(r);
+                const size_t n = placed.ringSize(r);
+                for (size_t i = 0; i < n; ++i) {
+                    const Point& q = p[(i + 1) % n];
+                    edgeLength += std::hypot(q.x - p[i].x, q.y - p[i].y);
+                }
+            }
+            const double cellSize = placed.points.empty() ? 1.0 : 2.0 * edgeLength / placed.points.size();
+            common.reset(new CommonLines(config_.mergeTolerance, cellSize));
+        }
+
+        for (size_t k = 0; k < sheetPlacements.size() && writer.ok(); ++k) {
+            runs.clear();
+            for (size_t r = firstRing[k]; r < firstRing[k + 1]; ++r) {
+                const Point* p = placed.ringBegin(r);
+                const size_t n = placed.ringSize(r);
+                if (n < 2) {
+                    continue;
+                }
+                if (!common) {
+                    runs.push_back({std::vector<Point>(p, p + n), true});
+                    continue;
+                }
+
+                // Walk the edges, leaving out the stretches already written.
+                // Exactness comes from the source ring, in the same order.
+                const std::vector<Point>& source = *items[r].ring;
+                const size_t ringRuns = runs.size();
+                bool whole = true;
+                bool open = false;  // The last run ends where the next edge starts
+                for (size_t i = 0; i < n; ++i) {
+                    const size_t j = (i + 1) % n;
+                    const Point& a = p[i];
+                    const Point& b = p[j];
+                    const double length = std::hypot(b.x - a.x, b.y - a.y);
+                    if (length == 0.0) {
+                        continue;
+                    }
+
+                    keep.clear();
+                    if (source[i].exact && source[j].exact && length >= config_.minMergeLength) {
+                        common->uncovered(a, b, keep);
+                        common->add(a, b);
+                    } else {
+                        keep.emplace_back(0.0, length);
+                    }
+
+                    if (keep.size() != 1 || keep[0].first != 0.0 || keep[0].second != length) {
+                        whole = false;
+                    }
+                    for (const auto& span : keep) {
+                        const bool fromA = span.first == 0.0;
+                        if (!(fromA && open)) {
+                            runs.push_back({{fromA ? a : along(a, b, length, span.first)}, false});
+                        }
+                        runs.back().points.push_back(span.second == length ? b : along(a, b, length, span.second));
+                        open = span.second == length;
+                    }
+                    if (keep.empty()) {
+                        open = false;
+                    }
+                }
+
+                if (whole) {
+                    runs.resize(ringRuns);
+                    runs.push_back({std::vector<Point>(p, p + n), true});
+                } else if (open && runs.size() - ringRuns > 1 &&
+                           runs[ringRuns].points.front().x == p[0].x &&
+                           runs[ringRuns].points.front().y == p[0].y) {
+                    // The last run ends at the first vertex, where the first run starts
+                    Run& last = runs.back();
+                    last.points.insert(last.points.end(),
+                                       runs[ringRuns].points.begin() + 1, runs[ringRuns].points.end());
+                    runs[ringRuns] = std::move(last);
+                    runs.pop_back();
+                }
+            }
+            writer.part(sheetPlacements[k], runs);
+        }
+        writer.endSheet();
+    }
+
+    if (writer.ok()) {
+        writer.end();
+    }
+    return writer.ok();
+}
+
+void ResultExporter::submit(const NestResult& result, SinkProvider provider) {
+    NestResult copy = result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = std::move(copy);
+        pendingProvider_ = std::move(provider);
+        hasPending_ = true;
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&ResultExporter::run, this);
+        }
+    }
+    wake_.notify_one();
+}
+
+void ResultExporter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !hasPending_ && !busy_; });
+}
+
+void ResultExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return hasPending_ || stop_; });
+        if (!hasPending_) {
+            break;
+        }
+
+        NestResult result = std::move(pending_);
+        SinkProvider provider = std::move(pendingProvider_);
+        hasPending_ = false;
+        busy_ = true;
+        lock.unlock();
+
+        Sink sink = provider ? provider(result) : nullptr;
+        if (sink) {
+            write(result, sink);
+        }
+
+        lock.lock();
+        busy_ = false;
+        idle_.notify_all();
+    }
+}
+
+ResultExporter::Sink ResultExporter::fileSink(const std::string& path) {
+    std::shared_ptr<std::FILE> file(std::fopen(path.c_str(), "wb"), [](std::FILE* f) {
+        if (f) {
+            std::fclose(f);
+        }
+    });
+    if (!file) {
+        return nullptr;
+    }
+    return [file](const char* data, size_t size) {
+        return std::fwrite(data, 1, size, file.get()) == size && std::fflush(file.get()) == 0;
+    };
+}
+
+} // namespace deepnest
@@ -0,0 +1,671 @@
+#include "../../include/deepnest/converters/SvgImporter.h"
+#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/geometry/Transformation.h"
+#include <QFile>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+namespace deepnest {
+
+namespace {
+
+enum class ElementKind { Path, Rect, Circle, Ellipse, Polygon, Polyline, Line };
+
+// A shape element as read, waiting for its batch to be flattened
+struct Element {
+    ElementKind kind = ElementKind::Path;
+    std::string data;               // d or points
+    std::array<double, 6> values{}; // geometry attributes, in the order read
+    Transformation transform;
+    bool container = false;
+};
+
+struct Contour {
+    std::vector<Point> points;
+    bool closed = false;
+};
+
+// Reads numbers, flags and command letters from path data, points lists
+// and transform lists. std::from_chars is locale-independent, unlike
+// strtod, and does not allocate.
+class Tokens {
+public:
+    explicit Tokens(const std::string& text)
+        : pos_(text.data()), end_(text.data() + text.size()) {}
+
+    bool atEnd() {
+        skipSeparators();
+        return pos_ == end_;
+    }
+
+    bool atNumber() {
+        skipSeparators();
+        return pos_ != end_ && (std::isdigit(static_cast<unsigned char>(*pos_)) ||
+                                *pos_ == '-' || *pos_ == '+' || *pos_ == '.');
+    }
+
+    char next() { return *pos_++; }
+
+    bool expect(char c) {
+        skipSeparators();
+        if (pos_ != end_ && *pos_ == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool number(double& value) {
+        skipSeparators();
+        if (pos_ != end_ && *pos_ == '+') {
+            ++pos_;
+        }
+        const auto parsed = std::from_chars(pos_, end_, value);
+        if (parsed.ec != std::errc()) {
+            return false;
+        }
+        pos_ = parsed.ptr;
+        return true;
+    }
+
+    // Arc flags may be written without separators ("a5 5 0 01 10 0")
+    bool flag(int& value) {
+        skipSeparators();
+        if (pos_ == end_ || (*pos_ != '0' && *pos_ != '1')) {
+            return false;
+        }
+        value = *pos_++ - '0';
+        return true;
+    }
+
+    bool point(Point& p) {
+        return number(p.x) && number(p.y);
+    }
+
+    std::string word() {
+        skipSeparators();
+        const char* start = pos_;
+        while (pos_ != end_ && std::isalpha(static_cast<unsigned char>(*pos_))) {
+            ++pos_;
+        }
+        return std::string(start, pos_);
+    }
+
+private:
+    void skipSeparators() {
+        while (pos_ != end_ && (std::isspace(static_cast<unsigned char>(*pos_)) || *pos_ == ',')) {
+            ++pos_;
+        }
+    }
+
+    const char* pos_;
+    const char* end_;
+};
+
+// Collects the contours of one element in its local coordinates
+class ContourBuilder {
+public:
+    ContourBuilder(std::vector<Contour>& contours, double tolerance)
+        : contours_(contours), tolerance_(tolerance) {}
+
+    const Point& current() const { return current_; }
+
+    void moveTo(const Point& p) {
+        contours_.emplace_back();
+        contours_.back().points.push_back(p);
+        current_ = start_ = p;
+        open_ = true;
+    }
+
+    void lineTo(const Point& p) {
+        begin();
+        contours_.back().points.push_back(p);
+        current_ = p;
+    }
+
+    void quadraticTo(const Point& c1, const Point& p) {
+        begin();
+        append(GeometryUtil::QuadraticBezier::linearize(current_, p, c1, tolerance_));
+        current_ = p;
+    }
+
+    void cubicTo(const Point& c1, const Point& c2, const Point& p) {
+        begin();
+        append(GeometryUtil::CubicBezier::linearize(current_, p, c1, c2, tolerance_));
+        current_ = p;
+    }
+
+    void arcTo(double rx, double ry, double angle, int largeArc, int sweep, const Point& p) {
+        // Zero radii draw a line and equal ends draw nothing (SVG 1.1 F.6.2)
+        if (p.x == current_.x && p.y == current_.y) {
+            return;
+        }
+        if (rx == 0.0 || ry == 0.0) {
+            lineTo(p);
+            return;
+        }
+        begin();
+        append(GeometryUtil::Arc::linearize(current_, p, std::abs(rx), std::abs(ry),
+                                            angle, largeArc, sweep, tolerance_));
+        current_ = p;
+    }
+
+    void close() {
+        if (open_) {
+            contours_.back().closed = true;
+            open_ = false;
+        }
+        current_ = start_;
+    }
+
+private:
+    // Drawing after a close, or without a moveto, starts a contour in place
+    void begin() {
+        if (!open_) {
+            moveTo(current_);
+        }
+    }
+
+    // Linearized segments start at the current point, already present
+    void append(const std::vector<Point>& points) {
+        if (points.size() > 1) {
+            auto& target = contours_.back().points;
+            target.insert(target.end(), points.begin() + 1, points.end());
+        }
+    }
+
+    std::vector<Contour>& contours_;
+    double tolerance_;
+    Point current_;
+    Point start_;
+    bool open_ = false;
+};
+
+Point reflect(const Point& control, const Point& about) {
+    return Point(2.0 * about.x - control.x, 2.0 * about.y - control.y);
+}
+
+// Path data grammar of SVG 1.1 section 8.3; stops at the first error and
+// keeps what was drawn before it, as renderers do
+void flattenPathData(const std::string& data, ContourBuilder& builder) {
+    Tokens tokens(data);
+    char command = 0;
+    char previous = 0;
+    Point control;
+
+    while (!tokens.atEnd()) {
+        if (!tokens.atNumber()) {
+            command = tokens.next();
+        } else if (command == 'M') {
+            command = 'L';  // Coordinates after a moveto are linetos
+        } else if (command == 'm') {
+            command = 'l';
+        } else if (command == 0 || command == 'Z' || command == 'z') {
+            return;
+        }
+
+        const bool relative = std::islower(static_cast<unsigned char>(command)) != 0;
+        const Point origin = relative ? builder.current() : Point(0.0, 0.0);
+        const char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(command)));
+        auto absolute = [&](const Point& p) { return Point(p.x + origin.x, p.y + origin.y); };
+
+        Point p;
+        Point c1;
+        Point c2;
+        double value = 0.0;
+
+        switch (upper) {
+            case 'M':
+                if (!tokens.point(p)) return;
+                builder.moveTo(absolute(p));
+                break;
+            case 'L':
+                if (!tokens.point(p)) return;
+                builder.lineTo(absolute(p));
+                break;
+            case 'H':
+                if (!tokens.number(value)) return;
+                builder.lineTo(Point(value + origin.x, builder.current().y));
+                break;
+            case 'V':
+                if (!tokens.number(value)) return;
+                builder.lineTo(Point(builder.current().x, value + origin.y));
+                break;
+            case 'C':
+                if (!tokens.point(c1) || !tokens.point(c2) || !tokens.point(p)) return;
+                control = absolute(c2);
+                builder.cubicTo(absolute(c1), control, absolute(p));
+                break;
+            case 'S': {
+                if (!tokens.point(c2) || !tokens.point(p)) return;
+                const bool smooth = previous == 'C' || previous == 'S';
+                const Point first = smooth ? reflect(control, builder.current()) : builder.current();
+                control = absolute(c2);
+                builder.cubicTo(first, control, absolute(p));
+                break;
+            }
+            case 'Q':
+                if (!tokens.point(c1) || !tokens.point(p)) return;
+                control = absolute(c1);
+                builder.quadraticTo(control, absolute(p));
+                break;
+            case 'T': {
+                if (!tokens.point(p)) return;
+                const bool smooth = previous == 'Q' || previous == 'T';
+                control = smooth ? reflect(control, builder.current()) : builder.current();
+                builder.quadraticTo(control, absolute(p));
+                break;
+            }
+            case 'A': {
+                double rx = 0.0;
+                double ry = 0.0;
+                double angle = 0.0;
+                int largeArc = 0;
+                int sweep = 0;
+                if (!tokens.number(rx) || !tokens.number(ry) || !tokens.number(angle) ||
+                    !tokens.flag(largeArc) || !tokens.flag(sweep) || !tokens.point(p)) {
+                    return;
+                }
+                builder.arcTo(rx, ry, angle, largeArc, sweep, absolute(p));
+                break;
+            }
+            case 'Z':
+                builder.close();
+                break;
+            default:
+                return;
+        }
+        previous = upper;
+    }
+}
+
+void flattenPoints(const std::string& data, bool closed, ContourBuilder& builder) {
+    Tokens tokens(data);
+    Point p;
+    bool first = true;
+    while (tokens.point(p)) {
+        if (first) {
+            builder.moveTo(p);
+            first = false;
+        } else {
+            builder.lineTo(p);
+        }
+    }
+    if (closed && !first) {
+        builder.close();
+    }
+}
+
+void flattenEllipse(double cx, double cy, double rx, double ry, ContourBuilder& builder) {
+    if (rx <= 0.0 || ry <= 0.0) {
+        return;
+    }
+    builder.moveTo(Point(cx + rx, cy));
+    builder.arcTo(rx, ry, 0.0, 0, 1, Point(cx - rx, cy));
+    builder.arcTo(rx, ry, 0.0, 0, 1, Point(cx + rx, cy));
+    builder.close();
+}
+
+void flattenRect(const std::array<double, 6>& v, ContourBuilder& builder) {
+    const double x = v[0];
+    const double y = v[1];
+    const double w = v[2];
+    const double h = v[3];
+    if (w <= 0.0 || h <= 0.0) {
+        return;
+    }
+
+    // One missing radius takes the other's value; both are clamped to half a side
+    double rx = v[4] > 0.0 ? v[4] : v[5];
+    double ry = v[5] > 0.0 ? v[5] : v[4];
+    rx = std::min(std::max(rx, 0.0), 0.5 * w);
+    ry = std::min(std::max(ry, 0.0), 0.5 * h);
+
+    builder.moveTo(Point(x + rx, y));
+    builder.lineTo(Point(x + w - rx, y));
+    builder.arcTo(rx, ry, 0.0, 0, 1, Point(x + w, y + ry));
+    builder.lineTo(Point(x + w, y + h - ry));
+    builder.arcTo(rx, ry, 0.0, 0, 1, Point(x + w - rx, y + h));
+    builder.lineTo(Point(x + rx, y + h));
+    builder.arcTo(rx, ry, 0.0, 0, 1, Point(x, y + h - ry));
+    builder.lineTo(Point(x, y + ry));
+    builder.arcTo(rx, ry, 0.0, 0, 1, Point(x + rx, y));
+    builder.close();
+}
+
+// Closed contours of one element in document coordinates
+void flattenElement(const Element& element, const SvgImporter::Config& config,
+                    std::vector<Contour>& contours) {
+    const auto& m = element.transform.getMatrix();
+    const double determinant = m[0] * m[3] - m[1] * m[2];
+    if (determinant == 0.0) {
+        return;
+    }
+
+    // The tolerance is in output units; curves are flattened before the
+    // transform, so shrink it by the transform's mean scale
+    ContourBuilder builder(contours, config.tolerance / std::sqrt(std::abs(determinant)));
+    const auto& v = element.values;
+    switch (element.kind) {
+        case ElementKind::Path:
+            flattenPathData(element.data, builder);
+            break;
+        case ElementKind::Polygon:
+            flattenPoints(element.data, true, builder);
+            break;
+        case ElementKind::Polyline:
+            flattenPoints(element.data, false, builder);
+            break;
+        case ElementKind::Rect:
+            flattenRect(v, builder);
+            break;
+        case ElementKind::Circle:
+            flattenEllipse(v[0], v[1], v[2], v[2], builder);
+            break;
+        case ElementKind::Ellipse:
+            flattenEllipse(v[0], v[1], v[2], v[3], builder);
+            break;
+        case ElementKind::Line:
+            builder.moveTo(Point(v[0], v[1]));
+            builder.lineTo(Point(v[2], v[3]));
+            break;
+    }
+
+    size_t kept = 0;
+    for (auto& contour : contours) {
+        auto& points = contour.points;
+        if (!element.transform.isIdentity()) {
+            for (auto& p : points) {
+                p = element.transform.apply(p);
+            }
+        }
+
+        // An explicit segment back to the start duplicates the first point
+        while (points.size() > 1 && GeometryUtil::almostEqualPoints(points.front(), points.back())) {
+            points.pop_back();
+            contour.closed = true;
+        }
+        if (!contour.closed && points.size() > 2 &&
+            points.front().withinDistance(points.back(), config.endpointTolerance)) {
+            contour.closed = true;
+        }
+        if (contour.closed && points.size() >= 3) {
+            if (kept != static_cast<size_t>(&contour - contours.data())) {
+                contours[kept] = std::move(contour);
+            }
+            ++kept;
+        }
+    }
+    contours.resize(kept);
+}
+
+// Length with an optional unit, in user units at 96 per inch
+double parseLength(const QStringRef& text) {
+    const std::string s = text.toLatin1().toStdString();
+    double value = 0.0;
+    const char* begin = s.data();
+    const char* end = begin + s.size();
+    while (begin != end && (std::isspace(static_cast<unsigned char>(*begin)) || *begin == '+')) {
+        ++begin;
+    }
+    const auto parsed = std::from_chars(begin, end, value);
+    if (parsed.ec != std::errc()) {
+        return 0.0;
+    }
+
+    const std::string unit(parsed.ptr, end);
+    if (unit == "in") return value * 96.0;
+    if (unit == "mm") return value * 96.0 / 25.4;
+    if (unit == "cm") return value * 96.0 / 2.54;
+    if (unit == "pt") return value * 96.0 / 72.0;
+    if (unit == "pc") return value * 16.0;
+    return value;
+}
+
+// Output units per user unit for a root with a physical width and a
+// viewBox (SVGLoader::getScalingFactor, svgparser.js getScalingFactor)
+double rootScale(const QXmlStreamAttributes& attrs, double configScale) {
+    const std::string width = attrs.value(QLatin1String("width")).toLatin1().toStdString();
+    const std::string viewBoxText = attrs.value(QLatin1String("viewBox")).toLatin1().toStdString();
+    Tokens viewBox(viewBoxText);
+    double box[4] = {0.0, 0.0, 0.0, 0.0};
+    for (double& v : box) {
+        if (!viewBox.number(v)) {
+            return 1.0;
+        }
+    }
+
+    double value = 0.0;
+    const auto parsed = std::from_chars(width.data(), width.data() + width.size(), value);
+    if (parsed.ec != std::errc() || value <= 0.0 || box[2] <= 0.0) {
+        return 1.0;
+    }
+
+    // Inches the document is wide, then output units per viewBox unit
+    const std::string unit(parsed.ptr, width.data() + width.size());
+    double inches = 0.0;
+    if (unit == "in") inches = value;
+    else if (unit == "mm") inches = value / 25.4;
+    else if (unit == "cm") inches = value / 2.54;
+    else if (unit == "pt") inches = value / 72.0;
+    else if (unit == "pc") inches = value / 6.0;
+    else if (unit == "px") inches = value / 96.0;
+    else return 1.0;
+
+    return configScale * inches / box[2];
+}
+
+// transform attribute (SVG 1.1 section 7.6), applied left to right
+Transformation parseTransform(const QStringRef& text) {
+    Transformation transform;
+    const std::string list = text.toLatin1().toStdString();
+    Tokens tokens(list);
+
+    while (!tokens.atEnd()) {
+        const std::string name = tokens.word();
+        if (name.empty() || !tokens.expect('(')) {
+            break;
+        }
+        double v[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        int count = 0;
+        while (count < 6 && tokens.number(v[count])) {
+            ++count;
+        }
+        if (!tokens.expect(')')) {
+            break;
+        }
+
+        if (name == "matrix" && count == 6) {
+            transform.combine(Transformation(v[0], v[1], v[2], v[3], v[4], v[5]));
+        } else if (name == "translate" && count >= 1) {
+            transform.translate(v[0], count > 1 ? v[1] : 0.0);
+        } else if (name == "scale" && count >= 1) {
+            transform.scale(v[0], count > 1 ? v[1] : v[0]);
+        } else if (name == "rotate" && count >= 1) {
+            transform.rotate(v[0], count > 2 ? v[1] : 0.0, count > 2 ? v[2] : 0.0);
+        } else if (name == "skewX" && count == 1) {
+            transform.skewX(v[0]);
+        } else if (name == "skewY" && count == 1) {
+            transform.skewY(v[0]);
+        }
+    }
+    return transform;
+}
+
+bool isContainer(const QXmlStreamAttributes& attrs) {
+    static const QStringList keywords = {"container", "sheet", "bin", "stock", "board", "panel"};
+    const QString id = attrs.value(QLatin1String("id")).toString().toLower();
+    const QString className = attrs.value(QLatin1String("class")).toString().toLower();
+    for (const QString& keyword : keywords) {
+        if (id.contains(keyword) || className.contains(keyword)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Subtrees that define content drawn elsewhere, or nothing at all
+bool isSkipped(const QStringRef& name) {
+    return name == QLatin1String("defs") || name == QLatin1String("clipPath") ||
+           name == QLatin1String("mask") || name == QLatin1String("pattern") ||
+           name == QLatin1String("symbol") || name == QLatin1String("marker") ||
+           name == QLatin1String("metadata");
+}
+
+bool readElement(const QStringRef& name, const QXmlStreamAttributes& attrs, Element& element) {
+    auto length = [&](const char* attribute) {
+        return parseLength(attrs.value(QLatin1String(attribute)));
+    };
+    auto text = [&](const char* attribute) {
+        return attrs.value(QLatin1String(attribute)).toLatin1().toStdString();
+    };
+
+    if (name == QLatin1String("path")) {
+        element.kind = ElementKind::Path;
+        element.data = text("d");
+    } else if (name == QLatin1String("polygon")) {
+        element.kind = ElementKind::Polygon;
+        element.data = text("points");
+    } else if (name == QLatin1String("polyline")) {
+        element.kind = ElementKind::Polyline;
+        element.data = text("points");
+    } else if (name == QLatin1String("rect")) {
+        element.kind = ElementKind::Rect;
+        element.values = {length("x"), length("y"), length("width"), length("height"),
+                          length("rx"), length("ry")};
+    } else if (name == QLatin1String("circle")) {
+        element.kind = ElementKind::Circle;
+        element.values = {length("cx"), length("cy"), length("r"), 0.0, 0.0, 0.0};
+    } else if (name == QLatin1String("ellipse")) {
+        element.kind = ElementKind::Ellipse;
+        element.values = {length("cx"), length("cy"), length("rx"), length("ry"), 0.0, 0.0};
+    } else if (name == QLatin1String("line")) {
+        element.kind = ElementKind::Line;
+        element.values = {length("x1"), length("y1"), length("x2"), length("y2"), 0.0, 0.0};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+SvgImporter::SvgImporter(const Config& config, ParallelFor parallelFor)
+    : config_(config)
+    , parallelFor_(std::move(parallelFor))
+{
+}
+
+SvgImporter::Result SvgImporter::importFile(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Result result;
+        result.errorMessage = QString("Cannot open file: %1").arg(fileName);
+        return result;
+    }
+    return importDevice(&file);
+}
+
+SvgImporter::Result SvgImporter::importDevice(QIODevice* device) const {
+    Result result;
+    std::vector<Polygon> outlines;
+
+    std::vector<Element> batch;
+    batch.reserve(config_.batchSize);
+    std::vector<std::vector<Contour>> flattened;
+
+    auto flush = [&]() {
+        flattened.assign(batch.size(), {});
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                flattenElement(batch[i], config_, flattened[i]);
+            }
+        };
+        if (parallelFor_ && batch.size() > 1) {
+            parallelFor_(batch.size(), body);
+        } else {
+            body(0, batch.size());
+        }
+
+        // Collected in document order whatever order the tasks ran in
+        for (size_t i = 0; i < batch.size(); ++i) {
+            auto& target = batch[i].container ? result.containers : outlines;
+            for (auto& contour : flattened[i]) {
+                Polygon polygon;
+                polygon.points = std::move(contour.points);
+                polygon.id = static_cast<int>(target.size());
+                polygon.isSheet = batch[i].container;
+                target.push_back(std::move(polygon));
+            }
+        }
+        batch.clear();
+    };
+
+    QXmlStreamReader xml(device);
+    std::vector<Transformation> transformStack;
+    Transformation current;
+    bool rootSeen = false;
+
+    while (!xml.atEnd()) {
+        xml.readNext();
+
+        if (xml.isStartElement()) {
+            const QStringRef name = xml.name();
+            if (isSkipped(name)) {
+                xml.skipCurrentElement();
+                continue;
+            }
+
+            const QXmlStreamAttributes attrs = xml.attributes();
+            Transformation transform = current;
+            if (name == QLatin1String("svg") && !rootSeen) {
+                transform.scale(rootScale(attrs, config_.scale));
+                rootSeen = true;
+            }
+            if (attrs.hasAttribute(QLatin1String("transform"))) {
+                transform.combine(parseTransform(attrs.value(QLatin1String("transform"))));
+            }
+
+            if (name == QLatin1String("g") || name == QLatin1String("svg")) {
+                transformStack.push_back(current);
+                current = transform;
+                continue;
+            }
+
+            Element element;
+            if (readElement(name, attrs, element)) {
+                element.transform = transform;
+                element.container = isContainer(attrs);
+                batch.push_back(std::move(element));
+                if (batch.size() >= config_.batchSize) {
+                    flush();
+                }
+            }
+        } else if (xml.isEndElement()) {
+            const QStringRef name = xml.name();
+            if ((name == QLatin1String("g") || name == QLatin1String("svg")) && !transformStack.empty()) {
+                current = transformStack.back();
+                transformStack.pop_back();
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        result.errorMessage = QString("XML parse error at line %1: %2")
+                                  .arg(xml.lineNumber())
+                                  .arg(xml.errorString());
+        result.containers.clear();
+        return result;
+    }
+
+    flush();
+    result.parts = PolygonHierarchy::buildTree(outlines, 0, parallelFor_);
+    return result;
+}
+
+} // namespace deepnest
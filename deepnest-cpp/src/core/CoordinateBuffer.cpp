@@ -0,0 +1,153 @@
+#include "../../include/deepnest/core/CoordinateBuffer.h"
+#include "../../include/deepnest/core/CoordinateKernels.h"
+#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include <cmath>
+
+namespace deepnest {
+
+CoordinateBuffer::CoordinateBuffer(const std::vector<Point>& points)
+    : x_(points.size())
+    , y_(points.size())
+    , exact_(points.size())
+    , marked_(points.size())
+{
+    for (size_t i = 0; i < points.size(); ++i) {
+        x_[i] = points[i].x;
+        y_[i] = points[i].y;
+        exact_[i] = points[i].exact;
+        marked_[i] = points[i].marked;
+    }
+}
+
+CoordinateBuffer::CoordinateBuffer(const CoordinateBuffer& other) {
+    *this = other;
+}
+
+CoordinateBuffer& CoordinateBuffer::operator=(const CoordinateBuffer& other) {
+    if (this == &other) {
+        return *this;
+    }
+    x_ = other.x_;
+    y_ = other.y_;
+    exact_ = other.exact_;
+    marked_ = other.marked_;
+
+    // Only published values are safe to read while other is shared
+    const unsigned ready = other.ready_.load(std::memory_order_acquire);
+    if (ready & AREA) area_ = other.area_;
+    if (ready & BOUNDS) bounds_ = other.bounds_;
+    if (ready & RECTANGLE) rectangle_ = other.rectangle_;
+    if (ready & CONVEX) convex_ = other.convex_;
+    claimed_.store(ready, std::memory_order_relaxed);
+    ready_.store(ready, std::memory_order_release);
+    return *this;
+}
+
+template <typename T, typename Compute>
+T CoordinateBuffer::cached(Property property, T& slot, Compute compute) const {
+    if (ready_.load(std::memory_order_acquire) & property) {
+        return slot;
+    }
+
+    const T value = compute();
+    if (!(claimed_.fetch_or(property, std::memory_order_acq_rel) & property)) {
+        slot = value;
+        ready_.fetch_or(property, std::memory_order_release);
+    }
+    return value;
+}
+
+void CoordinateBuffer::invalidate() {
+    claimed_.store(0, std::memory_order_relaxed);
+    ready_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<Point> CoordinateBuffer::toPoints() const {
+    std::vector<Point> points;
+    points.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        points.emplace_back(x_[i], y_[i], exact_[i]);
+        points.back().marked = marked_[i];
+    }
+    return points;
+}
+
+double CoordinateBuffer::area() const {
+    return cached(AREA, area_, [this]() {
+        return CoordinateKernels::area(x_.data(), y_.data(), size());
+    });
+}
+
+BoundingBox CoordinateBuffer::bounds() const {
+    if (empty()) {
+        return BoundingBox();
+    }
+
+    return cached(BOUNDS, bounds_, [this]() {
+        double minX, minY, maxX, maxY;
+        CoordinateKernels::bounds(x_.data(), y_.data(), size(), minX, minY, maxX, maxY);
+        return BoundingBox(minX, minY, maxX - minX, maxY - minY);
+    });
+}
+
+bool CoordinateBuffer::isRectangle() const {
+    return cached(RECTANGLE, rectangle_, [this]() {
+        // GeometryUtil::isRectangle: every point on a side of the bounds
+        const BoundingBox bb = bounds();
+        for (size_t i = 0; i < size(); ++i) {
+            if (!GeometryUtil::almostEqual(x_[i], bb.x) &&
+                !GeometryUtil::almostEqual(x_[i], bb.x + bb.width)) {
+                return false;
+            }
+            if (!GeometryUtil::almostEqual(y_[i], bb.y) &&
+                !GeometryUtil::almostEqual(y_[i], bb.y + bb.height)) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+bool CoordinateBuffer::isConvex() const {
+    return cached(CONVEX, convex_, [this]() {
+        return GeometryUtil::isConvex(toPoints());
+    });
+}
+
+std::optional<bool> CoordinateBuffer::pointInPolygon(const Point& point, double tolerance) const {
+    return CoordinateKernels::pointInPolygon(x_.data(), y_.data(), size(), point.x, point.y, tolerance);
+}
+
+void CoordinateBuffer::translate(double dx, double dy) {
+    CoordinateKernels::translate(x_.data(), y_.data(), size(), dx, dy);
+    exact_.assign(size(), true);
+    marked_.assign(size(), false);
+    invalidate();
+}
+
+void CoordinateBuffer::rotate(double angleDegrees) {
+    // Transformation::rotate: x' = cos*x - sin*y, y' = sin*x + cos*y
+    const double rad = angleDegrees * M_PI / 180.0;
+    rotate(std::cos(rad), std::sin(rad));
+}
+
+void CoordinateBuffer::rotate(double cosA, double sinA) {
+    CoordinateKernels::rotate(x_.data(), y_.data(), size(), cosA, sinA);
+    exact_.assign(size(), true);
+    marked_.assign(size(), false);
+    invalidate();
+}
+
+Clipper2Lib::Path64 CoordinateBuffer::toPath64(double scale) const {
+    Clipper2Lib::Path64 path;
+    path.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        path.push_back(Clipper2Lib::Point64(
+            static_cast<int64_t>(x_[i] * scale),
+            static_cast<int64_t>(y_[i] * scale)
+        ));
+    }
+    return path;
+}
+
+} // namespace deepnest
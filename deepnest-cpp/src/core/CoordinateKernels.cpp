@@ -0,0 +1,628 @@
+#include "../../include/deepnest/core/CoordinateKernels.h"
+#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define DEEPNEST_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts AVX2 intrinsics in any function
+#define DEEPNEST_TARGET_AVX2
+#else
+#define DEEPNEST_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DEEPNEST_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace deepnest {
+namespace CoordinateKernels {
+
+// ========== Scalar ==========
+
+namespace Scalar {
+
+double area(const double* x, const double* y, size_t n) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    // GeometryUtil::polygonArea: sum of (x[j] + x[i]) * (y[j] - y[i]) with
+    // j = i - 1, the closing edge first
+    double sum = (x[n - 1] + x[0]) * (y[n - 1] - y[0]);
+    for (size_t i = 1; i < n; ++i) {
+        sum += (x[i - 1] + x[i]) * (y[i - 1] - y[i]);
+    }
+    return 0.5 * sum;
+}
+
+void bounds(const double* x, const double* y, size_t n,
+            double& minX, double& minY, double& maxX, double& maxY) {
+    minX = maxX = x[0];
+    minY = maxY = y[0];
+    for (size_t i = 1; i < n; ++i) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+}
+
+void translate(double* x, double* y, size_t n, double dx, double dy) {
+    for (size_t i = 0; i < n; ++i) {
+        x[i] += dx;
+        y[i] += dy;
+    }
+}
+
+void rotate(double* x, double* y, size_t n, double cosA, double sinA) {
+    for (size_t i = 0; i < n; ++i) {
+        const double px = x[i];
+        const double py = y[i];
+        x[i] = cosA * px - sinA * py;
+        y[i] = sinA * px + cosA * py;
+    }
+}
+
+std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                   double px, double py, double tolerance) {
+    if (n < 3) {
+        return std::nullopt;
+    }
+
+    // GeometryUtil::pointInPolygon, check for check
+    const Point point(px, py);
+    bool inside = false;
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+        const Point pi(x[i], y[i]);
+        const Point pj(x[j], y[j]);
+
+        if (GeometryUtil::almostEqual(pi.x, point.x, tolerance) &&
+            GeometryUtil::almostEqual(pi.y, point.y, tolerance)) {
+            return std::nullopt;
+        }
+        if (GeometryUtil::onSegment(pi, pj, point, tolerance)) {
+            return std::nullopt;
+        }
+        if (GeometryUtil::almostEqual(pi.x, pj.x, tolerance) &&
+            GeometryUtil::almostEqual(pi.y, pj.y, tolerance)) {
+            continue;
+        }
+
+        bool intersect = ((pi.y > point.y) != (pj.y > point.y)) &&
+                         (point.x < (pj.x - pi.x) * (point.y - pi.y) / (pj.y - pi.y) + pi.x);
+        if (intersect) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+} // namespace Scalar
+
+namespace {
+
+/**
+ * Edge (i, j) for the vector point-in-polygon passes: -1 when the point is
+ * within tolerance of the edge's bounds (the vertex and on-segment checks
+ * can only fire there), otherwise 1 for a ray crossing and 0 for none
+ */
+inline int edgeCrossing(double xi, double yi, double xj, double yj,
+                        double px, double py, double tolerance) {
+    if (px >= std::min(xi, xj) - tolerance && px <= std::max(xi, xj) + tolerance &&
+        py >= std::min(yi, yj) - tolerance && py <= std::max(yi, yj) + tolerance) {
+        return -1;
+    }
+    if (std::abs(xi - xj) < tolerance && std::abs(yi - yj) < tolerance) {
+        return 0;
+    }
+    return ((yi > py) != (yj > py)) && (px < (xj - xi) * (py - yi) / (yj - yi) + xi) ? 1 : 0;
+}
+
+inline int bitCount(int mask) {
+    return static_cast<int>(std::bitset<8>(static_cast<unsigned>(mask)).count());
+}
+
+// ========== SSE2 ==========
+
+#if defined(DEEPNEST_KERNELS_X86)
+
+namespace Sse2 {
+
+double area(const double* x, const double* y, size_t n) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    double sum = (x[n - 1] + x[0]) * (y[n - 1] - y[0]);
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 1;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d xs = _mm_add_pd(_mm_loadu_pd(x + i - 1), _mm_loadu_pd(x + i));
+        const __m128d ys = _mm_sub_pd(_mm_loadu_pd(y + i - 1), _mm_loadu_pd(y + i));
+        acc = _mm_add_pd(acc, _mm_mul_pd(xs, ys));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    sum += lanes[0] + lanes[1];
+    for (; i < n; ++i) {
+        sum += (x[i - 1] + x[i]) * (y[i - 1] - y[i]);
+    }
+    return 0.5 * sum;
+}
+
+void bounds(const double* x, const double* y, size_t n,
+            double& minX, double& minY, double& maxX, double& maxY) {
+    __m128d lowX = _mm_set1_pd(x[0]);
+    __m128d highX = lowX;
+    __m128d lowY = _mm_set1_pd(y[0]);
+    __m128d highY = lowY;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d xs = _mm_loadu_pd(x + i);
+        const __m128d ys = _mm_loadu_pd(y + i);
+        lowX = _mm_min_pd(lowX, xs);
+        highX = _mm_max_pd(highX, xs);
+        lowY = _mm_min_pd(lowY, ys);
+        highY = _mm_max_pd(highY, ys);
+    }
+
+    double lanes[4][2];
+    _mm_storeu_pd(lanes[0], lowX);
+    _mm_storeu_pd(lanes[1], highX);
+    _mm_storeu_pd(lanes[2], lowY);
+    _mm_storeu_pd(lanes[3], highY);
+    minX = std::min(lanes[0][0], lanes[0][1]);
+    maxX = std::max(lanes[1][0], lanes[1][1]);
+    minY = std::min(lanes[2][0], lanes[2][1]);
+    maxY = std::max(lanes[3][0], lanes[3][1]);
+    for (; i < n; ++i) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+}
+
+void translate(double* x, double* y, size_t n, double dx, double dy) {
+    const __m128d vdx = _mm_set1_pd(dx);
+    const __m128d vdy = _mm_set1_pd(dy);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(x + i, _mm_add_pd(_mm_loadu_pd(x + i), vdx));
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), vdy));
+    }
+    Scalar::translate(x + i, y + i, n - i, dx, dy);
+}
+
+void rotate(double* x, double* y, size_t n, double cosA, double sinA) {
+    const __m128d c = _mm_set1_pd(cosA);
+    const __m128d s = _mm_set1_pd(sinA);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d xs = _mm_loadu_pd(x + i);
+        const __m128d ys = _mm_loadu_pd(y + i);
+        _mm_storeu_pd(x + i, _mm_sub_pd(_mm_mul_pd(c, xs), _mm_mul_pd(s, ys)));
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_mul_pd(s, xs), _mm_mul_pd(c, ys)));
+    }
+    Scalar::rotate(x + i, y + i, n - i, cosA, sinA);
+}
+
+std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                   double px, double py, double tolerance) {
+    if (n < 3) {
+        return std::nullopt;
+    }
+
+    int crossings = edgeCrossing(x[0], y[0], x[n - 1], y[n - 1], px, py, tolerance);
+    if (crossings < 0) {
+        return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+    }
+
+    const __m128d vpx = _mm_set1_pd(px);
+    const __m128d vpy = _mm_set1_pd(py);
+    const __m128d vtol = _mm_set1_pd(tolerance);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    size_t i = 1;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d xi = _mm_loadu_pd(x + i);
+        const __m128d yi = _mm_loadu_pd(y + i);
+        const __m128d xj = _mm_loadu_pd(x + i - 1);
+        const __m128d yj = _mm_loadu_pd(y + i - 1);
+
+        const __m128d near = _mm_and_pd(
+            _mm_and_pd(_mm_cmpge_pd(vpx, _mm_sub_pd(_mm_min_pd(xi, xj), vtol)),
+                       _mm_cmple_pd(vpx, _mm_add_pd(_mm_max_pd(xi, xj), vtol))),
+            _mm_and_pd(_mm_cmpge_pd(vpy, _mm_sub_pd(_mm_min_pd(yi, yj), vtol)),
+                       _mm_cmple_pd(vpy, _mm_add_pd(_mm_max_pd(yi, yj), vtol))));
+        if (_mm_movemask_pd(near) != 0) {
+            return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+        }
+
+        const __m128d tiny = _mm_and_pd(
+            _mm_cmplt_pd(_mm_andnot_pd(sign, _mm_sub_pd(xi, xj)), vtol),
+            _mm_cmplt_pd(_mm_andnot_pd(sign, _mm_sub_pd(yi, yj)), vtol));
+        const __m128d straddle = _mm_xor_pd(_mm_cmpgt_pd(yi, vpy), _mm_cmpgt_pd(yj, vpy));
+        const __m128d cross = _mm_cmplt_pd(vpx, _mm_add_pd(
+            _mm_div_pd(_mm_mul_pd(_mm_sub_pd(xj, xi), _mm_sub_pd(vpy, yi)), _mm_sub_pd(yj, yi)), xi));
+        crossings += bitCount(_mm_movemask_pd(_mm_andnot_pd(tiny, _mm_and_pd(straddle, cross))));
+    }
+    for (; i < n; ++i) {
+        const int edge = edgeCrossing(x[i], y[i], x[i - 1], y[i - 1], px, py, tolerance);
+        if (edge < 0) {
+            return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+        }
+        crossings += edge;
+    }
+    return (crossings & 1) != 0;
+}
+
+} // namespace Sse2
+
+// ========== AVX2 ==========
+
+namespace Avx2 {
+
+DEEPNEST_TARGET_AVX2
+double area(const double* x, const double* y, size_t n) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    double sum = (x[n - 1] + x[0]) * (y[n - 1] - y[0]);
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 1;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xs = _mm256_add_pd(_mm256_loadu_pd(x + i - 1), _mm256_loadu_pd(x + i));
+        const __m256d ys = _mm256_sub_pd(_mm256_loadu_pd(y + i - 1), _mm256_loadu_pd(y + i));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(xs, ys));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; ++i) {
+        sum += (x[i - 1] + x[i]) * (y[i - 1] - y[i]);
+    }
+    return 0.5 * sum;
+}
+
+DEEPNEST_TARGET_AVX2
+void bounds(const double* x, const double* y, size_t n,
+            double& minX, double& minY, double& maxX, double& maxY) {
+    __m256d lowX = _mm256_set1_pd(x[0]);
+    __m256d highX = lowX;
+    __m256d lowY = _mm256_set1_pd(y[0]);
+    __m256d highY = lowY;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xs = _mm256_loadu_pd(x + i);
+        const __m256d ys = _mm256_loadu_pd(y + i);
+        lowX = _mm256_min_pd(lowX, xs);
+        highX = _mm256_max_pd(highX, xs);
+        lowY = _mm256_min_pd(lowY, ys);
+        highY = _mm256_max_pd(highY, ys);
+    }
+
+    double lanes[4][4];
+    _mm256_storeu_pd(lanes[0], lowX);
+    _mm256_storeu_pd(lanes[1], highX);
+    _mm256_storeu_pd(lanes[2], lowY);
+    _mm256_storeu_pd(lanes[3], highY);
+    minX = *std::min_element(lanes[0], lanes[0] + 4);
+    maxX = *std::max_element(lanes[1], lanes[1] + 4);
+    minY = *std::min_element(lanes[2], lanes[2] + 4);
+    maxY = *std::max_element(lanes[3], lanes[3] + 4);
+    for (; i < n; ++i) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+}
+
+DEEPNEST_TARGET_AVX2
+void translate(double* x, double* y, size_t n, double dx, double dy) {
+    const __m256d vdx = _mm256_set1_pd(dx);
+    const __m256d vdy = _mm256_set1_pd(dy);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_loadu_pd(x + i), vdx));
+        _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), vdy));
+    }
+    Scalar::translate(x + i, y + i, n - i, dx, dy);
+}
+
+DEEPNEST_TARGET_AVX2
+void rotate(double* x, double* y, size_t n, double cosA, double sinA) {
+    // Separate multiplies and adds: the target enables no FMA, so the
+    // results round exactly as Transformation's
+    const __m256d c = _mm256_set1_pd(cosA);
+    const __m256d s = _mm256_set1_pd(sinA);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xs = _mm256_loadu_pd(x + i);
+        const __m256d ys = _mm256_loadu_pd(y + i);
+        _mm256_storeu_pd(x + i, _mm256_sub_pd(_mm256_mul_pd(c, xs), _mm256_mul_pd(s, ys)));
+        _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_mul_pd(s, xs), _mm256_mul_pd(c, ys)));
+    }
+    Scalar::rotate(x + i, y + i, n - i, cosA, sinA);
+}
+
+DEEPNEST_TARGET_AVX2
+std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                   double px, double py, double tolerance) {
+    if (n < 3) {
+        return std::nullopt;
+    }
+
+    int crossings = edgeCrossing(x[0], y[0], x[n - 1], y[n - 1], px, py, tolerance);
+    if (crossings < 0) {
+        return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+    }
+
+    const __m256d vpx = _mm256_set1_pd(px);
+    const __m256d vpy = _mm256_set1_pd(py);
+    const __m256d vtol = _mm256_set1_pd(tolerance);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    size_t i = 1;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xi = _mm256_loadu_pd(x + i);
+        const __m256d yi = _mm256_loadu_pd(y + i);
+        const __m256d xj = _mm256_loadu_pd(x + i - 1);
+        const __m256d yj = _mm256_loadu_pd(y + i - 1);
+
+        const __m256d near = _mm256_and_pd(
+            _mm256_and_pd(
+                _mm256_cmp_pd(vpx, _mm256_sub_pd(_mm256_min_pd(xi, xj), vtol), _CMP_GE_OQ),
+                _mm256_cmp_pd(vpx, _mm256_add_pd(_mm256_max_pd(xi, xj), vtol), _CMP_LE_OQ)),
+            _mm256_and_pd(
+                _mm256_cmp_pd(vpy, _mm256_sub_pd(_mm256_min_pd(yi, yj), vtol), _CMP_GE_OQ),
+                _mm256_cmp_pd(vpy, _mm256_add_pd(_mm256_max_pd(yi, yj), vtol), _CMP_LE_OQ)));
+        if (_mm256_movemask_pd(near) != 0) {
+            return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+        }
+
+        const __m256d tiny = _mm256_and_pd(
+            _mm256_cmp_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(xi, xj)), vtol, _CMP_LT_OQ),
+            _mm256_cmp_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(yi, yj)), vtol, _CMP_LT_OQ));
+        const __m256d straddle = _mm256_xor_pd(_mm256_cmp_pd(yi, vpy, _CMP_GT_OQ),
+                                               _mm256_cmp_pd(yj, vpy, _CMP_GT_OQ));
+        const __m256d cross = _mm256_cmp_pd(vpx, _mm256_add_pd(
+            _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(xj, xi), _mm256_sub_pd(vpy, yi)),
+                          _mm256_sub_pd(yj, yi)), xi), _CMP_LT_OQ);
+        crossings += bitCount(_mm256_movemask_pd(
+            _mm256_andnot_pd(tiny, _mm256_and_pd(straddle, cross))));
+    }
+    for (; i < n; ++i) {
+        const int edge = edgeCrossing(x[i], y[i], x[i - 1], y[i - 1], px, py, tolerance);
+        if (edge < 0) {
+            return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+        }
+        crossings += edge;
+    }
+    return (crossings & 1) != 0;
+}
+
+} // namespace Avx2
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // AVX state must be enabled by the OS as well as supported
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // DEEPNEST_KERNELS_X86
+
+// ========== NEON ==========
+
+#if defined(DEEPNEST_KERNELS_NEON)
+
+namespace Neon {
+
+double area(const double* x, const double* y, size_t n) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    double sum = (x[n - 1] + x[0]) * (y[n - 1] - y[0]);
+    float64x2_t acc = vdupq_n_f64(0.0);
+    size_t i = 1;
+    for (; i + 2 <= n; i += 2) {
+        const float64x2_t xs = vaddq_f64(vld1q_f64(x + i - 1), vld1q_f64(x + i));
+        const float64x2_t ys = vsubq_f64(vld1q_f64(y + i - 1), vld1q_f64(y + i));
+        acc = vaddq_f64(acc, vmulq_f64(xs, ys));
+    }
+    sum += vgetq_lane_f64(acc, 0) + vgetq_lane_f64(acc, 1);
+    for (; i < n; ++i) {
+        sum += (x[i - 1] + x[i]) * (y[i - 1] - y[i]);
+    }
+    return 0.5 * sum;
+}
+
+void bounds(const double* x, const double* y, size_t n,
+            double& minX, double& minY, double& maxX, double& maxY) {
+    float64x2_t lowX = vdupq_n_f64(x[0]);
+    float64x2_t highX = lowX;
+    float64x2_t lowY = vdupq_n_f64(y[0]);
+    float64x2_t highY = lowY;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const float64x2_t xs = vld1q_f64(x + i);
+        const float64x2_t ys = vld1q_f64(y + i);
+        lowX = vminq_f64(lowX, xs);
+        highX = vmaxq_f64(highX, xs);
+        lowY = vminq_f64(lowY, ys);
+        highY = vmaxq_f64(highY, ys);
+    }
+    minX = vminvq_f64(lowX);
+    maxX = vmaxvq_f64(highX);
+    minY = vminvq_f64(lowY);
+    maxY = vmaxvq_f64(highY);
+    for (; i < n; ++i) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+}
+
+void translate(double* x, double* y, size_t n, double dx, double dy) {
+    const float64x2_t vdx = vdupq_n_f64(dx);
+    const float64x2_t vdy = vdupq_n_f64(dy);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        vst1q_f64(x + i, vaddq_f64(vld1q_f64(x + i), vdx));
+        vst1q_f64(y + i, vaddq_f64(vld1q_f64(y + i), vdy));
+    }
+    Scalar::translate(x + i, y + i, n - i, dx, dy);
+}
+
+void rotate(double* x, double* y, size_t n, double cosA, double sinA) {
+    const float64x2_t c = vdupq_n_f64(cosA);
+    const float64x2_t s = vdupq_n_f64(sinA);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const float64x2_t xs = vld1q_f64(x + i);
+        const float64x2_t ys = vld1q_f64(y + i);
+        vst1q_f64(x + i, vsubq_f64(vmulq_f64(c, xs), vmulq_f64(s, ys)));
+        vst1q_f64(y + i, vaddq_f64(vmulq_f64(s, xs), vmulq_f64(c, ys)));
+    }
+    Scalar::rotate(x + i, y + i, n - i, cosA, sinA);
+}
+
+std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                   double px, double py, double tolerance) {
+    if (n < 3) {
+        return std::nullopt;
+    }
+
+    int crossings = edgeCrossing(x[0], y[0], x[n - 1], y[n - 1], px, py, tolerance);
+    if (crossings < 0) {
+        return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+    }
+
+    const float64x2_t vpx = vdupq_n_f64(px);
+    const float64x2_t vpy = vdupq_n_f64(py);
+    const float64x2_t vtol = vdupq_n_f64(tolerance);
+    size_t i = 1;
+    for (; i + 2 <= n; i += 2) {
+        const float64x2_t xi = vld1q_f64(x + i);
+        const float64x2_t yi = vld1q_f64(y + i);
+        const float64x2_t xj = vld1q_f64(x + i - 1);
+        const float64x2_t yj = vld1q_f64(y + i - 1);
+
+        const uint64x2_t near = vandq_u64(
+            vandq_u64(vcgeq_f64(vpx, vsubq_f64(vminq_f64(xi, xj), vtol)),
+                      vcleq_f64(vpx, vaddq_f64(vmaxq_f64(xi, xj), vtol))),
+            vandq_u64(vcgeq_f64(vpy, vsubq_f64(vminq_f64(yi, yj), vtol)),
+                      vcleq_f64(vpy, vaddq_f64(vmaxq_f64(yi, yj), vtol))));
+        if ((vgetq_lane_u64(near, 0) | vgetq_lane_u64(near, 1)) != 0) {
+            return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+        }
+
+        const uint64x2_t tiny = vandq_u64(vcltq_f64(vabsq_f64(vsubq_f64(xi, xj)), vtol),
+                                          vcltq_f64(vabsq_f64(vsubq_f64(yi, yj)), vtol));
+        const uint64x2_t straddle = veorq_u64(vcgtq_f64(yi, vpy), vcgtq_f64(yj, vpy));
+        const uint64x2_t cross = vcltq_f64(vpx, vaddq_f64(
+            vdivq_f64(vmulq_f64(vsubq_f64(xj, xi), vsubq_f64(vpy, yi)), vsubq_f64(yj, yi)), xi));
+        const uint64x2_t hit = vbicq_u64(vandq_u64(straddle, cross), tiny);
+        crossings += static_cast<int>((vgetq_lane_u64(hit, 0) & 1) + (vgetq_lane_u64(hit, 1) & 1));
+    }
+    for (; i < n; ++i) {
+        const int edge = edgeCrossing(x[i], y[i], x[i - 1], y[i - 1], px, py, tolerance);
+        if (edge < 0) {
+            return Scalar::pointInPolygon(x, y, n, px, py, tolerance);
+        }
+        crossings += edge;
+    }
+    return (crossings & 1) != 0;
+}
+
+} // namespace Neon
+
+#endif // DEEPNEST_KERNELS_NEON
+
+// ========== Dispatch ==========
+
+struct Kernels {
+    const char* name;
+    double (*area)(const double*, const double*, size_t);
+    void (*bounds)(const double*, const double*, size_t, double&, double&, double&, double&);
+    void (*translate)(double*, double*, size_t, double, double);
+    void (*rotate)(double*, double*, size_t, double, double);
+    std::optional<bool> (*pointInPolygon)(const double*, const double*, size_t,
+                                          double, double, double);
+};
+
+Kernels selectKernels() {
+#if defined(DEEPNEST_KERNELS_X86)
+    if (cpuHasAvx2()) {
+        return {"avx2", Avx2::area, Avx2::bounds, Avx2::translate, Avx2::rotate,
+                Avx2::pointInPolygon};
+    }
+    return {"sse2", Sse2::area, Sse2::bounds, Sse2::translate, Sse2::rotate,
+            Sse2::pointInPolygon};
+#elif defined(DEEPNEST_KERNELS_NEON)
+    return {"neon", Neon::area, Neon::bounds, Neon::translate, Neon::rotate,
+            Neon::pointInPolygon};
+#else
+    return {"scalar", Scalar::area, Scalar::bounds, Scalar::translate, Scalar::rotate,
+            Scalar::pointInPolygon};
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+} // anonymous namespace
+
+double area(const double* x, const double* y, size_t n) {
+    return kernels().area(x, y, n);
+}
+
+void bounds(const double* x, const double* y, size_t n,
+            double& minX, double& minY, double& maxX, double& maxY) {
+    kernels().bounds(x, y, n, minX, minY, maxX, maxY);
+}
+
+void translate(double* x, double* y, size_t n, double dx, double dy) {
+    kernels().translate(x, y, n, dx, dy);
+}
+
+void rotate(double* x, double* y, size_t n, double cosA, double sinA) {
+    kernels().rotate(x, y, n, cosA, sinA);
+}
+
+std::optional<bool> pointInPolygon(const double* x, const double* y, size_t n,
+                                   double px, double py, double tolerance) {
+    return kernels().pointInPolygon(x, y, n, px, py, tolerance);
+}
+
+const char* instructionSet() {
+    return kernels().name;
+}
+
+} // namespace CoordinateKernels
+} // namespace deepnest
@@ -0,0 +1,191 @@
+#include "../../include/deepnest/core/MultiRing.h"
+#include "../../include/deepnest/core/Polygon.h"
+#include <algorithm>
+
+namespace deepnest {
+
+namespace {
+
+struct RingCounts {
+    size_t rings = 0;
+    size_t vertices = 0;
+};
+
+void countRings(const Polygon& polygon, RingCounts& counts) {
+    counts.rings++;
+    counts.vertices += polygon.points.size();
+    for (const auto& child : polygon.children) {
+        countRings(child, counts);
+    }
+}
+
+} // anonymous namespace
+
+MultiRing::MultiRing(const Polygon& polygon) {
+    RingCounts counts;
+    countRings(polygon, counts);
+
+    auto layout = std::make_shared<Layout>();
+    layout->offsets.reserve(counts.rings + 1);
+    layout->kinds.reserve(counts.rings);
+    layout->parents.reserve(counts.rings);
+    vertices_.reserve(counts.vertices);
+
+    // Depth-first, as the tree is walked everywhere else
+    struct Frame {
+        const Polygon* polygon;
+        int32_t parent;
+        bool hole;
+    };
+    std::vector<Frame> stack{{&polygon, -1, false}};
+    while (!stack.empty()) {
+        const Frame frame = stack.back();
+        stack.pop_back();
+
+        const int32_t index = static_cast<int32_t>(layout->kinds.size());
+        layout->offsets.push_back(static_cast<uint32_t>(vertices_.size()));
+        layout->kinds.push_back(frame.hole ? Kind::Hole : Kind::Outer);
+        layout->parents.push_back(frame.parent);
+        vertices_.insert(vertices_.end(), frame.polygon->points.begin(), frame.polygon->points.end());
+
+        const auto& children = frame.polygon->children;
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.push_back({&*it, index, !frame.hole});
+        }
+    }
+    layout->offsets.push_back(static_cast<uint32_t>(vertices_.size()));
+    layout_ = std::move(layout);
+
+    auto metadata = std::make_shared<Metadata>();
+    metadata->id = polygon.id;
+    metadata->source = polygon.source;
+    metadata->quantity = polygon.quantity;
+    metadata->isSheet = polygon.isSheet;
+    metadata->convex = polygon.convex;
+    metadata->fingerprint = polygon.fingerprint;
+    metadata->name = polygon.name;
+    metadata_ = std::move(metadata);
+    rotation_ = polygon.rotation;
+}
+
+Polygon MultiRing::toPolygon() const {
+    Polygon root;
+    if (!layout_) {
+        return root;
+    }
+    root.id = metadata_->id;
+    root.source = metadata_->source;
+    root.quantity = metadata_->quantity;
+    root.isSheet = metadata_->isSheet;
+    root.convex = metadata_->convex;
+    root.fingerprint = metadata_->fingerprint;
+    root.name = metadata_->name;
+    root.rotation = rotation_;
+    root.points.assign(ringBegin(0), ringEnd(0));
+
+    // A ring's parent precedes it, and its children vector is complete
+    // before any ring after it is attached, so the pointers stay valid
+    std::vector<Polygon*> nodes(ringCount(), nullptr);
+    nodes[0] = &root;
+    for (size_t ring = 1; ring < ringCount(); ++ring) {
+        Polygon* parentNode = nodes[static_cast<size_t>(parent(ring))];
+        parentNode->children.emplace_back(std::vector<Point>(ringBegin(ring), ringEnd(ring)));
+        nodes[ring] = &parentNode->children.back();
+    }
+    return root;
+}
+
+MultiRing MultiRing::shell() const {
+    MultiRing result;
+    result.layout_ = layout_;
+    result.metadata_ = metadata_;
+    result.rotation_ = rotation_;
+    result.vertices_.reserve(vertices_.size());
+    return result;
+}
+
+MultiRing MultiRing::negated() const {
+    MultiRing result = shell();
+    for (const auto& p : vertices_) {
+        result.vertices_.push_back(Point(-p.x, -p.y));
+    }
+    // Negating coordinates inverts the winding; reverse to restore it
+    for (size_t ring = 0; ring < ringCount(); ++ring) {
+        std::reverse(result.vertices_.begin() + layout_->offsets[ring],
+                     result.vertices_.begin() + layout_->offsets[ring + 1]);
+    }
+    return result;
+}
+
+BoundingBox MultiRing::bounds() const {
+    if (vertices_.empty()) {
+        return BoundingBox();
+    }
+    double minX = vertices_[0].x, maxX = vertices_[0].x;
+    double minY = vertices_[0].y, maxY = vertices_[0].y;
+    for (const auto& p : vertices_) {
+        minX = std::min<double>(minX, p.x);
+        maxX = std::max<double>(maxX, p.x);
+        minY = std::min<double>(minY, p.y);
+        maxY = std::max<double>(maxY, p.y);
+    }
+    return BoundingBox(minX, minY, maxX - minX, maxY - minY);
+}
+
+Clipper2Lib::Paths64 MultiRing::toPaths64(double scale) const {
+    Clipper2Lib::Paths64 paths(ringCount());
+    for (size_t ring = 0; ring < ringCount(); ++ring) {
+        paths[ring].reserve(ringSize(ring));
+        for (const Point* p = ringBegin(ring); p != ringEnd(ring); ++p) {
+            paths[ring].push_back(Clipper2Lib::Point64(
+                static_cast<int64_t>(p->x * scale),
+                static_cast<int64_t>(p->y * scale)
+            ));
+        }
+    }
+    return paths;
+}
+
+size_t MultiRing::memoryBytes() const {
+    size_t bytes = sizeof(MultiRing) + vertices_.capacity() * sizeof(Point);
+    if (layout_) {
+        bytes += sizeof(Layout)
+               + layout_->offsets.capacity() * sizeof(uint32_t)
+               + layout_->kinds.capacity() * sizeof(Kind)
+               + layout_->parents.capacity() * sizeof(int32_t);
+    }
+    if (metadata_) {
+        bytes += sizeof(Metadata) + metadata_->name.capacity();
+    }
+    return bytes;
+}
+
+bool MultiRing::matches(const Polygon& polygon) const {
+    if (!layout_) {
+        return false;
+    }
+    size_t ring = 0;
+    bool same = true;
+    // Same depth-first order as the constructor
+    std::vector<const Polygon*> stack{&polygon};
+    while (same && !stack.empty()) {
+        const Polygon* node = stack.back();
+        stack.pop_back();
+        if (ring >= ringCount() || ringSize(ring) != node->points.size()) {
+            return false;
+        }
+        if (!node->points.empty()) {
+            const Point* begin = ringBegin(ring);
+            const Point* last = ringEnd(ring) - 1;
+            same = begin->x == node->points.front().x && begin->y == node->points.front().y &&
+                   last->x == node->points.back().x && last->y == node->points.back().y;
+        }
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) {
+            stack.push_back(&*it);
+        }
+        ring++;
+    }
+    return same && ring == ringCount();
+}
+
+} // namespace deepnest
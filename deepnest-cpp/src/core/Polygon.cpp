@@ -2,10 +2,10 @@
 #include "../../include/deepnest/geometry/Transformation.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
 #include "../../include/deepnest/geometry/PolygonOperations.h"
-#include "../../include/deepnest/geometry/PolygonHierarchy.h"
 #include <boost/polygon/polygon.hpp>
 #include <algorithm>
 #include <numeric>
+#include <cmath>
 
 namespace deepnest {
 
@@ -17,6 +17,8 @@ Polygon::Polygon()
     , rotation(0.0)
     , quantity(1)
     , isSheet(false)
+    , fingerprint(0)
+    , convex(false)
 {}
 
 Polygon::Polygon(const std::vector<Point>& pts)
@@ -26,6 +28,8 @@ Polygon::Polygon(const std::vector<Point>& pts)
     , rotation(0.0)
     , quantity(1)
     , isSheet(false)
+    , fingerprint(0)
+    , convex(false)
 {}
 
 Polygon::Polygon(const std::vector<Point>& pts, int polygonId)
@@ -35,6 +39,8 @@ Polygon::Polygon(const std::vector<Point>& pts, int polygonId)
     , rotation(0.0)
     , quantity(1)
     , isSheet(false)
+    , fingerprint(0)
+    , convex(false)
 {}
 
 // ========== Geometric Properties ==========
@@ -43,6 +49,9 @@ double Polygon::area() const {
     if (points.size() < 3) {
         return 0.0;
     }
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        return buffer->area();
+    }
     return GeometryUtil::polygonArea(points);
 }
 
@@ -50,15 +59,171 @@ BoundingBox Polygon::bounds() const {
     if (points.empty()) {
         return BoundingBox();
     }
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        return buffer->bounds();
+    }
     return GeometryUtil::getPolygonBounds(points);
 }
 
+namespace {
+
+inline void fingerprintMix(uint64_t& hash, uint64_t value) {
+    // FNV-1a over the 8 bytes of value
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 1099511628211ull;
+    }
+}
+
+} // anonymous namespace
+
+uint64_t Polygon::computeFingerprint() const {
+    uint64_t hash = 1469598103934665603ull;
+    fingerprintMix(hash, points.size());
+    for (const auto& p : points) {
+        fingerprintMix(hash, static_cast<uint64_t>(std::llround(p.x * 1e6)));
+        fingerprintMix(hash, static_cast<uint64_t>(std::llround(p.y * 1e6)));
+    }
+    fingerprintMix(hash, children.size());
+    for (const auto& child : children) {
+        fingerprintMix(hash, child.computeFingerprint());
+    }
+    // 0 is reserved for "not computed"
+    return hash != 0 ? hash : 1;
+}
+
+void Polygon::updateFingerprint() {
+    for (auto& child : children) {
+        child.updateFingerprint();
+    }
+    fingerprint = computeFingerprint();
+}
+
+bool Polygon::isRectangle() const {
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        return buffer->isRectangle();
+    }
+    return GeometryUtil::isRectangle(points);
+}
+
+void Polygon::updateConvexity() {
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        convex = buffer->isConvex();
+        return;
+    }
+    convex = GeometryUtil::isConvex(points);
+}
+
+void Polygon::updateScaledPath(double scale) {
+    auto scaled = std::make_shared<ScaledPath>();
+    scaled->scale = scale;
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        scaled->path = buffer->toPath64(scale);
+    } else {
+        scaled->path.reserve(points.size());
+        for (const auto& p : points) {
+            scaled->path.push_back(Clipper2Lib::Point64(
+                static_cast<int64_t>(p.x * scale),
+                static_cast<int64_t>(p.y * scale)
+            ));
+        }
+    }
+    scaledPath = std::move(scaled);
+}
+
+void Polygon::snapToGrid(double scale) {
+    auto scaled = std::make_shared<ScaledPath>();
+    scaled->scale = scale;
+    scaled->path.reserve(points.size());
+    for (auto& p : points) {
+        const int64_t x = std::llround(p.x * scale);
+        const int64_t y = std::llround(p.y * scale);
+        scaled->path.push_back(Clipper2Lib::Point64(x, y));
+        p.x = static_cast<double>(x) / scale;
+        p.y = static_cast<double>(y) / scale;
+    }
+    scaledPath = std::move(scaled);
+    coordinates.reset();
+    rings.reset();
+
+    for (auto& child : children) {
+        child.snapToGrid(scale);
+    }
+}
+
+const Clipper2Lib::Path64* Polygon::scaledPathAt(double scale) const {
+    // Points edited after the path was built leave it stale; the size
+    // check catches the common case of a replaced point list
+    if (!scaledPath || scaledPath->scale != scale || scaledPath->path.size() != points.size()) {
+        return nullptr;
+    }
+    return &scaledPath->path;
+}
+
+void Polygon::updateCoordinates() {
+    coordinates = std::make_shared<const CoordinateBuffer>(points);
+}
+
+const CoordinateBuffer* Polygon::currentCoordinates() const {
+    // Points edited in place leave the buffer stale. A replaced point list
+    // changes the size, while a translated, turned or reversed one moves
+    // the end points
+    if (!coordinates || coordinates->size() != points.size()) {
+        return nullptr;
+    }
+    if (!points.empty()) {
+        const size_t last = points.size() - 1;
+        if (coordinates->x()[0] != points[0].x || coordinates->y()[0] != points[0].y ||
+            coordinates->x()[last] != points[last].x || coordinates->y()[last] != points[last].y) {
+            return nullptr;
+        }
+    }
+    return coordinates.get();
+}
+
+void Polygon::updateRings() {
+    rings = std::make_shared<const MultiRing>(*this);
+}
+
+const MultiRing* Polygon::currentRings() const {
+    return rings && rings->matches(*this) ? rings.get() : nullptr;
+}
+
+MultiRing Polygon::flatten() const {
+    if (const MultiRing* current = currentRings()) {
+        return *current;
+    }
+    return MultiRing(*this);
+}
+
+size_t Polygon::memoryBytes() const {
+    size_t bytes = sizeof(Polygon)
+                 + points.capacity() * sizeof(Point)
+                 + name.capacity();
+    if (scaledPath) {
+        bytes += sizeof(ScaledPath) + scaledPath->path.capacity() * sizeof(Clipper2Lib::Point64);
+    }
+    if (coordinates) {
+        bytes += sizeof(CoordinateBuffer) + coordinates->size() * 2 * sizeof(double);
+    }
+    if (rings) {
+        bytes += rings->memoryBytes();
+    }
+    for (const auto& child : children) {
+        bytes += child.memoryBytes();
+    }
+    return bytes;
+}
+
 bool Polygon::isValid() const {
     return points.size() >= 3;
 }
 
 void Polygon::reverse() {
     std::reverse(points.begin(), points.end());
+    scaledPath.reset();
+    coordinates.reset();
+    rings.reset();
 
     // Also reverse all holes
     for (auto& hole : children) {
@@ -79,9 +244,29 @@ bool Polygon::isCounterClockwise() const {
 // ========== Transformations ==========
 
 Polygon Polygon::rotate(double angleDegrees) const {
-    Transformation t;
-    t.rotate(angleDegrees);
-    return transform(t);
+    // Transformation::rotate
+    const double rad = angleDegrees * M_PI / 180.0;
+    return rotate(angleDegrees, std::cos(rad), std::sin(rad));
+}
+
+Polygon Polygon::rotate(double angleDegrees, double cosA, double sinA) const {
+    // The matrix Transformation::rotate() builds on the identity
+    Polygon result = angleDegrees == 0.0
+        ? transform(Transformation())
+        : transform(Transformation(cosA, sinA, -sinA, cosA, 0.0, 0.0));
+
+    // A zero rotation leaves every coordinate unchanged, so the scaled path stays valid
+    if (angleDegrees == 0.0) {
+        result.scaledPath = scaledPath;
+    }
+
+    // The buffer is turned by the same arithmetic as Transformation
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        auto turned = std::make_shared<CoordinateBuffer>(*buffer);
+        turned->rotate(cosA, sinA);
+        result.coordinates = std::move(turned);
+    }
+    return result;
 }
 
 Polygon Polygon::rotateAround(double angleDegrees, const Point& center) const {
@@ -93,7 +278,15 @@ Polygon Polygon::rotateAround(double angleDegrees, const Point& center) const {
 Polygon Polygon::translate(double dx, double dy) const {
     Transformation t;
     t.translate(dx, dy);
-    return transform(t);
+    Polygon result = transform(t);
+
+    // x * 1 + y * 0 + dx rounds as x + dx, so the moved buffer matches
+    if (const CoordinateBuffer* buffer = currentCoordinates()) {
+        auto moved = std::make_shared<CoordinateBuffer>(*buffer);
+        moved->translate(dx, dy);
+        result.coordinates = std::move(moved);
+    }
+    return result;
 }
 
 Polygon Polygon::translate(const Point& offset) const {
@@ -133,6 +326,8 @@ void Polygon::updateMetadataAfterTransform(const Polygon& source) {
     this->quantity = source.quantity;
     this->isSheet = source.isSheet;
     this->name = source.name;
+    this->fingerprint = source.fingerprint;
+    this->convex = source.convex;
 }
 
 // ========== Conversions ==========
@@ -194,182 +389,6 @@ Polygon Polygon::fromBoostPolygon(const BoostPolygonWithHoles& boostPoly) {
     return result;
 }
 
-QPainterPath Polygon::toQPainterPath() const {
-    QPainterPath path;
-
-    if (points.empty()) {
-        return path;
-    }
-
-    // Add outer boundary
-    path.moveTo(points[0].toQt());
-    for (size_t i = 1; i < points.size(); i++) {
-        path.lineTo(points[i].toQt());
-    }
-    path.closeSubpath();
-
-    // Add holes
-    for (const auto& hole : children) {
-        if (!hole.points.empty()) {
-            path.moveTo(hole.points[0].toQt());
-            for (size_t i = 1; i < hole.points.size(); i++) {
-                path.lineTo(hole.points[i].toQt());
-            }
-            path.closeSubpath();
-        }
-    }
-
-    return path;
-}
-
-Polygon Polygon::fromQPainterPath(const QPainterPath& path) {
-    return fromQPainterPath(path, -1);
-}
-
-Polygon Polygon::fromQPainterPath(const QPainterPath& path, int polygonId) {
-    Polygon result;
-    result.id = polygonId;
-
-    if (path.isEmpty()) {
-        return result;
-    }
-
-    // Simplify path BEFORE conversion to remove degenerate geometries
-    // and redundant curve control points that cause Boost.Polygon scanline failures
-    // Step 1: Set proper fill rule for complex paths
-    QPainterPath cleanPath = path;
-    cleanPath.setFillRule(Qt::WindingFill);
-
-    // Step 2: Apply simplified() which merges overlapping/degenerate regions
-    cleanPath = cleanPath.simplified();
-
-    // Convert QPainterPath to polygon points
-    // Use Qt's toSubpathPolygons() which automatically converts curves to line segments
-    QList<QPolygonF> subpaths = cleanPath.toSubpathPolygons();
-
-    if (subpaths.isEmpty()) {
-        return result;
-    }
-
-    // If only one subpath, simple case - no hierarchy needed
-    if (subpaths.size() == 1) {
-        const QPolygonF& firstSubpath = subpaths.first();
-
-        // Convert QPolygonF to vector<Point>
-        std::vector<Point> pathPoints;
-        pathPoints.reserve(firstSubpath.size());
-        for (const QPointF& qpt : firstSubpath) {
-            pathPoints.push_back(Point::fromQt(qpt));
-        }
-
-        // Apply Ramer-Douglas-Peucker simplification
-        std::vector<Point> simplifiedPoints = GeometryUtil::simplifyPolygon(
-            pathPoints,
-            2.0,        // tolerance (matches JavaScript config)
-            false       // use two-pass approach
-        );
-
-        if (simplifiedPoints.size() >= 3) {
-            result.points = std::move(simplifiedPoints);
-        }
-
-        return result;
-    }
-
-    // Multiple subpaths - use PolygonHierarchy::buildTree to automatically
-    // determine parent-child relationships based on containment
-    // This matches JavaScript toTree() logic from svgnest.js lines 541-591
-    
-    std::vector<Polygon> allPolygons;
-    
-    for (int i = 0; i < subpaths.size(); ++i) {
-        const QPolygonF& subpath = subpaths[i];
-
-        Polygon poly;
-        poly.points.reserve(subpath.size());
-        for (const QPointF& pt : subpath) {
-            poly.points.push_back(Point::fromQt(pt));
-        }
-
-        // Apply simplification to each subpath
-        if (poly.points.size() >= 3) {
-            std::vector<Point> simplifiedPoints = GeometryUtil::simplifyPolygon(
-                poly.points,
-                2.0,
-                false
-            );
-            
-            if (simplifiedPoints.size() >= 3) {
-                poly.points = std::move(simplifiedPoints);
-                allPolygons.push_back(poly);
-            }
-        }
-    }
-
-    if (allPolygons.empty()) {
-        return result;
-    }
-
-    // Build hierarchy using PolygonHierarchy::buildTree
-    // This automatically identifies which polygons are holes based on containment
-    std::vector<Polygon> tree = PolygonHierarchy::buildTree(allPolygons, polygonId);
-
-    // Return the first top-level polygon (or empty if none)
-    if (!tree.empty()) {
-        result = tree[0];
-        // If polygonId was specified, ensure it's set
-        if (polygonId >= 0) {
-            result.id = polygonId;
-        }
-    }
-
-    return result;
-}
-
-std::vector<Polygon> Polygon::extractFromQPainterPath(const QPainterPath& path) {
-    std::vector<Polygon> polygons;
-
-    // QPainterPath can contain multiple disconnected subpaths
-    // We need to extract each one as a separate polygon
-
-    // Apply same cleaning as fromQPainterPath for consistency
-    QPainterPath cleanPath = path;
-    cleanPath.setFillRule(Qt::WindingFill);
-    cleanPath = cleanPath.simplified();
-    QList<QPolygonF> qtPolygons = cleanPath.toSubpathPolygons();
-
-    for (const auto& qtPoly : qtPolygons) {
-        if (qtPoly.size() < 3) {
-            continue;
-        }
-
-        // Convert QPolygonF to vector<Point>
-        std::vector<Point> pathPoints;
-        pathPoints.reserve(qtPoly.size());
-        for (const QPointF& qpt : qtPoly) {
-            pathPoints.push_back(Point::fromQt(qpt));
-        }
-
-        // Apply Ramer-Douglas-Peucker simplification (same as fromQPainterPath)
-        std::vector<Point> simplifiedPoints = GeometryUtil::simplifyPolygon(
-            pathPoints,
-            2.0,        // tolerance (matches JavaScript config)
-            false       // use two-pass approach
-        );
-
-        if (simplifiedPoints.size() >= 3) {
-            Polygon poly;
-            poly.points = std::move(simplifiedPoints);
-
-            if (poly.isValid()) {
-                polygons.push_back(poly);
-            }
-        }
-    }
-
-    return polygons;
-}
-
 // ========== Utilities ==========
 
 Polygon Polygon::clone() const {
@@ -462,8 +481,59 @@ Polygon Polygon::simplify(double tolerance) const {
         result.children.push_back(hole.simplify(tolerance));
     }
 
-    // Copy metadata
+    // Copy metadata (geometry changed, so the fingerprint no longer applies)
+    result.updateMetadataAfterTransform(*this);
+    result.fingerprint = 0;
+    result.updateConvexity();
+
+    return result;
+}
+
+Polygon Polygon::conservativeOutline(double tolerance, double clipperScale) const {
+    if (points.size() < 3 || tolerance <= 0.0) {
+        return Polygon();
+    }
+
+    std::vector<Point> simplified = PolygonOperations::simplifyPolygon(points, tolerance);
+    if (simplified.size() < 3) {
+        return Polygon();
+    }
+
+    // Removed vertices lie within tolerance of the simplified boundary, so
+    // growing it by the tolerance covers them (miter joins add few vertices)
+    std::vector<std::vector<Point>> grown = PolygonOperations::offset(simplified, tolerance, 2.0, tolerance, clipperScale);
+
+    std::vector<Point>* outline = nullptr;
+    double outlineArea = 0.0;
+    for (auto& candidate : grown) {
+        double candidateArea = std::abs(GeometryUtil::polygonArea(candidate));
+        if (candidateArea > outlineArea) {
+            outlineArea = candidateArea;
+            outline = &candidate;
+        }
+    }
+
+    if (!outline || outline->size() >= points.size()) {
+        return Polygon();
+    }
+
+    // Reject the outline if any of the original sticks out of it
+    double outside = 0.0;
+    for (const auto& part : PolygonOperations::differencePolygons(points, *outline, clipperScale)) {
+        outside += std::abs(GeometryUtil::polygonArea(part));
+    }
+    if (outside > 1e-9 * outlineArea) {
+        return Polygon();
+    }
+
+    Polygon result(*outline);
+    if ((GeometryUtil::polygonArea(result.points) < 0.0) != (GeometryUtil::polygonArea(points) < 0.0)) {
+        std::reverse(result.points.begin(), result.points.end());
+    }
+
     result.updateMetadataAfterTransform(*this);
+    result.updateFingerprint();
+    result.updateConvexity();
 
     return result;
 }
@@ -0,0 +1,641 @@
+#include "../../include/deepnest/engine/NestingDaemon.h"
+#include "../../include/deepnest/converters/JobFile.h"
+#include "../../include/deepnest/DebugConfig.h"
+#include "../../include/deepnest/StageTimes.h"
+#include <algorithm>
+#include <deque>
+#include <istream>
+#include <limits>
+#include <sstream>
+
+namespace deepnest {
+
+using boost::asio::ip::tcp;
+
+/**
+ * @brief One connection; events of its jobs are queued from the
+ *        scheduler thread, replies from its session thread, and a writer
+ *        thread of its own sends them, so a slow client stalls no job
+ */
+struct NestingDaemon::Client {
+    // Bytes queued at most; a client further behind is disconnected
+    static constexpr size_t MAX_QUEUED_BYTES = size_t(16) << 20;
+
+    // PROGRESS events are dropped while more than this is queued
+    static constexpr size_t MAX_PROGRESS_BACKLOG = size_t(64) << 10;
+
+    explicit Client(tcp::socket s) : socket(std::move(s)), open(true), queuedBytes(0), writing(false) {}
+
+    /**
+     * @brief Queue lines for the writer; never blocks on the socket
+     *
+     * With droppable set the lines are skipped while the client is behind,
+     * for events the next one supersedes.
+     */
+    bool send(const std::string& lines, bool droppable = false) {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        if (!open) {
+            return false;
+        }
+        if (droppable && queuedBytes > MAX_PROGRESS_BACKLOG) {
+            return true;
+        }
+        if (queuedBytes + lines.size() > MAX_QUEUED_BYTES) {
+            LOG_NESTING("Daemon client too slow, disconnecting");
+            disconnect();
+            return false;
+        }
+        queue.push_back(lines);
+        queuedBytes += lines.size();
+        ready.notify_all();
+        return true;
+    }
+
+    /**
+     * @brief Writer thread: send queued lines until closed and drained
+     */
+    void write() {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        for (;;) {
+            while (open && queue.empty()) {
+                ready.wait(lock);
+            }
+            if (queue.empty()) {
+                break;
+            }
+            std::string lines = std::move(queue.front());
+            queue.pop_front();
+            queuedBytes -= lines.size();
+            writing = true;
+            lock.unlock();
+
+            boost::system::error_code ec;
+            boost::asio::write(socket, boost::asio::buffer(lines), ec);
+
+            lock.lock();
+            writing = false;
+            if (ec) {
+                disconnect();
+            }
+            ready.notify_all();
+        }
+    }
+
+    /**
+     * @brief Drop what is queued and shut the connection down
+     */
+    void close() {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        disconnect();
+    }
+
+    /**
+     * @brief Stop queueing, give the writer up to timeout to send what is
+     *        queued, then shut the connection down
+     */
+    void flushAndClose(boost::chrono::milliseconds timeout) {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        open = false;
+        ready.notify_all();
+        ready.wait_for(lock, timeout, [this]() { return queue.empty() && !writing; });
+        disconnect();
+    }
+
+    tcp::socket socket;
+    std::atomic<bool> open;
+
+private:
+    // Under mutex; the shutdown also ends a blocked read or write
+    void disconnect() {
+        open = false;
+        queue.clear();
+        queuedBytes = 0;
+        boost::system::error_code ec;
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+        ready.notify_all();
+    }
+
+    boost::mutex mutex;
+    boost::condition_variable ready;
+    std::deque<std::string> queue;
+    size_t queuedBytes;
+    bool writing;
+};
+
+/**
+ * @brief A submitted job; only the scheduler thread steps its engine
+ */
+struct NestingDaemon::Job {
+    int id = 0;
+    std::shared_ptr<Client> client;
+    std::shared_ptr<ParallelProcessor> processor;
+    std::unique_ptr<NestingEngine> engine;
+    std::atomic<bool> cancelled{false};
+
+    // Last reported progress, for metrics()
+    std::atomic<int> generation{0};
+    std::atomic<int> evaluations{0};
+    std::atomic<double> bestFitness{std::numeric_limits<double>::max()};
+};
+
+namespace {
+
+// How long a stopping daemon lets each client take its last events
+constexpr int CLOSE_TIMEOUT_MS = 1000;
+
+// How long a metrics request may take to arrive and be answered
+constexpr int METRICS_TIMEOUT_MS = 5000;
+
+// Round-trip precision for coordinates and fitness values
+std::ostringstream numberStream() {
+    std::ostringstream out;
+    out.precision(std::numeric_limits<double>::max_digits10);
+    return out;
+}
+
+void describe(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+} // anonymous namespace
+
+NestingDaemon::NestingDaemon(const Config& config)
+    : config_(config)
+    , nestConfig_(DeepNestConfig::getInstance())
+    , acceptor_(io_, tcp::endpoint(boost::asio::ip::address_v4::loopback(), config.port))
+    , pool_(std::make_shared<ParallelProcessor>(
+          config.threads, ParallelProcessor::backendFromName(nestConfig_.taskScheduler),
+          WorkerAffinity{nestConfig_.pinWorkerThreads, nestConfig_.numaScheduling}))
+    , nfpCache_(std::make_shared<NFPCache>())
+    , shapeCache_(std::make_shared<ShapeCache>(config.shapeCacheEntries))
+    , metricsSocket_(nullptr)
+    , nextId_(0)
+    , evaluationsFinished_(0)
+    , stopped_(false)
+{
+    nfpCache_->setMemoryLimit(static_cast<size_t>(nestConfig_.nfpCacheMaxMemoryMB) * 1024 * 1024);
+    nfpCache_->setCompactStorage(nestConfig_.nfpCacheCompact ? nestConfig_.getClipperScale() : 0.0);
+
+    if (config.metricsPort != 0) {
+        metricsAcceptor_ = std::make_unique<tcp::acceptor>(
+            metricsIo_, tcp::endpoint(boost::asio::ip::make_address(config.metricsAddress), config.metricsPort));
+    }
+}
+
+NestingDaemon::~NestingDaemon() {
+    stopped_ = true;
+    wake_.notify_all();
+    if (scheduler_.joinable()) {
+        scheduler_.join();
+    }
+    if (metricsServer_.joinable()) {
+        boost::asio::post(metricsIo_, [this]() { closeMetrics(); });
+        metricsServer_.join();
+    }
+    for (auto& client : clients_) {
+        client->flushAndClose(boost::chrono::milliseconds(CLOSE_TIMEOUT_MS));
+    }
+    sessions_.join_all();
+}
+
+void NestingDaemon::run() {
+    scheduler_ = boost::thread([this]() { schedule(); });
+    if (metricsAcceptor_) {
+        metricsServer_ = boost::thread([this]() { serveMetrics(); });
+    }
+
+    while (!stopped_) {
+        tcp::socket socket(io_);
+        boost::system::error_code result;
+        acceptor_.async_accept(socket, [&result](const boost::system::error_code& ec) {
+            result = ec;
+        });
+
+        // Returns once a client connects or stop() closes the acceptor
+        io_.restart();
+        io_.run();
+        if (result) {
+            continue;
+        }
+
+        socket.set_option(tcp::no_delay(true), result);
+        auto client = std::make_shared<Client>(std::move(socket));
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            clients_.push_back(client);
+        }
+        sessions_.create_thread([this, client]() { serve(client); });
+    }
+
+    // Jobs end first, so no event is written to a closed connection
+    wake_.notify_all();
+    scheduler_.join();
+
+    std::vector<std::shared_ptr<Client>> clients;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        clients.swap(clients_);
+    }
+    for (auto& client : clients) {
+        client->flushAndClose(boost::chrono::milliseconds(CLOSE_TIMEOUT_MS));
+    }
+    sessions_.join_all();
+    if (metricsServer_.joinable()) {
+        metricsServer_.join();
+    }
+}
+
+void NestingDaemon::stop() {
+    boost::asio::post(io_, [this]() {
+        stopped_ = true;
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+    });
+    if (metricsAcceptor_) {
+        boost::asio::post(metricsIo_, [this]() { closeMetrics(); });
+    }
+}
+
+std::string NestingDaemon::metrics() const {
+    struct JobMetrics {
+        int id;
+        int generation;
+        int evaluations;
+        double bestFitness;
+    };
+    std::vector<JobMetrics> jobs;
+    uint64_t evaluations = 0;
+    size_t pendingTasks = 0;
+    int submitted = 0;
+    {
+        // Under the lock, every listed job still has its processor
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        submitted = nextId_;
+        evaluations = evaluationsFinished_;
+        for (const auto& job : jobs_) {
+            jobs.push_back({job->id, job->generation.load(), job->evaluations.load(), job->bestFitness.load()});
+            evaluations += static_cast<uint64_t>(jobs.back().evaluations);
+            pendingTasks += job->processor->getPendingCount();
+        }
+    }
+    const NFPCache::Statistics nfp = nfpCache_->statistics();
+    const ShapeCache::Statistics shapes = shapeCache_->statistics();
+
+    std::ostringstream out = numberStream();
+    describe(out, "deepnest_jobs_active", "gauge", "Jobs being nested");
+    out << "deepnest_jobs_active " << jobs.size() << '\n';
+    describe(out, "deepnest_jobs_submitted_total", "counter", "Jobs accepted since the daemon started");
+    out << "deepnest_jobs_submitted_total " << submitted << '\n';
+    describe(out, "deepnest_evaluations_total", "counter", "Individuals evaluated, as of each job's last generation");
+    out << "deepnest_evaluations_total " << evaluations << '\n';
+    describe(out, "deepnest_pool_threads", "gauge", "Worker threads of the shared pool");
+    out << "deepnest_pool_threads " << pool_->getThreadCount() << '\n';
+    describe(out, "deepnest_pool_busy_threads", "gauge", "Worker threads running a task");
+    out << "deepnest_pool_busy_threads " << pool_->getThreadCount() - pool_->getIdleThreadCount() << '\n';
+    describe(out, "deepnest_tasks_pending", "gauge", "Tasks of all jobs queued or running");
+    out << "deepnest_tasks_pending " << pendingTasks << '\n';
+
+    describe(out, "deepnest_nfp_cache_lookups_total", "counter", "NFP cache lookups by result");
+    out << "deepnest_nfp_cache_lookups_total{result=\"hit\"} " << nfp.hits << '\n';
+    out << "deepnest_nfp_cache_lookups_total{result=\"miss\"} " << nfp.misses << '\n';
+    describe(out, "deepnest_nfp_cache_entries", "gauge", "NFPs cached");
+    out << "deepnest_nfp_cache_entries " << nfp.entries << '\n';
+    describe(out, "deepnest_nfp_cache_bytes", "gauge", "Estimated memory of the cached NFPs");
+    out << "deepnest_nfp_cache_bytes " << nfp.residentBytes << '\n';
+    describe(out, "deepnest_nfp_cache_limit_bytes", "gauge", "NFP cache memory budget (0 = unlimited)");
+    out << "deepnest_nfp_cache_limit_bytes " << nfp.memoryLimit << '\n';
+    describe(out, "deepnest_nfp_cache_evictions_total", "counter", "NFPs evicted to honor the budget");
+    out << "deepnest_nfp_cache_evictions_total " << nfp.evictions << '\n';
+    describe(out, "deepnest_shape_cache_lookups_total", "counter", "Shape cache lookups by result");
+    out << "deepnest_shape_cache_lookups_total{result=\"hit\"} " << shapes.hits << '\n';
+    out << "deepnest_shape_cache_lookups_total{result=\"miss\"} " << shapes.lookups - shapes.hits << '\n';
+    describe(out, "deepnest_shape_cache_entries", "gauge", "Offsets and turned parts cached");
+    out << "deepnest_shape_cache_entries " << shapes.entries << '\n';
+
+    describe(out, "deepnest_job_generation", "gauge", "Generation of each active job");
+    for (const auto& job : jobs) {
+        out << "deepnest_job_generation{job=\"" << job.id << "\"} " << job.generation << '\n';
+    }
+    describe(out, "deepnest_job_evaluations", "gauge", "Individuals evaluated by each active job");
+    for (const auto& job : jobs) {
+        out << "deepnest_job_evaluations{job=\"" << job.id << "\"} " << job.evaluations << '\n';
+    }
+    describe(out, "deepnest_job_best_fitness", "gauge", "Best fitness of each active job with a result");
+    for (const auto& job : jobs) {
+        if (job.bestFitness < std::numeric_limits<double>::max()) {
+            out << "deepnest_job_best_fitness{job=\"" << job.id << "\"} " << job.bestFitness << '\n';
+        }
+    }
+
+    if (StageTimer::enabled()) {
+        // Every other power-of-two bucket from 1 us to 69 s
+        const StageTimes times = StageTimer::snapshot();
+        describe(out, "deepnest_stage_seconds", "histogram", "Wall time of each timed stage scope");
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            const Stage stage = static_cast<Stage>(i);
+            const LatencyHistogram::Snapshot latency = StageTimer::latency(stage);
+            const std::string label = std::string("stage=\"") + StageTimes::name(stage) + "\"";
+            uint64_t cumulative = 0;
+            size_t bucket = 0;
+            for (size_t power = 10; power <= 36; power += 2) {
+                for (; bucket < power; ++bucket) {
+                    cumulative += latency.buckets[bucket];
+                }
+                out << "deepnest_stage_seconds_bucket{" << label << ",le=\""
+                    << static_cast<double>(uint64_t(1) << power) / 1e9 << "\"} " << cumulative << '\n';
+            }
+            out << "deepnest_stage_seconds_bucket{" << label << ",le=\"+Inf\"} " << latency.count << '\n';
+            out << "deepnest_stage_seconds_sum{" << label << "} " << latency.totalNs / 1e9 << '\n';
+            out << "deepnest_stage_seconds_count{" << label << "} " << latency.count << '\n';
+        }
+        describe(out, "deepnest_stage_cpu_seconds_total", "counter", "CPU time of each timed stage");
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            const Stage stage = static_cast<Stage>(i);
+            out << "deepnest_stage_cpu_seconds_total{stage=\"" << StageTimes::name(stage) << "\"} "
+                << times[stage].cpuNs / 1e9 << '\n';
+        }
+    }
+    return out.str();
+}
+
+void NestingDaemon::serveMetrics() {
+    for (;;) {
+        tcp::socket socket(metricsIo_);
+        boost::system::error_code result;
+        metricsAcceptor_->async_accept(socket, [&result](const boost::system::error_code& ec) {
+            result = ec;
+        });
+
+        // Returns once a scraper connects or stop() closes the acceptor
+        metricsIo_.restart();
+        metricsIo_.run();
+        if (result) {
+            if (!metricsAcceptor_->is_open()) {
+                break;
+            }
+            continue;
+        }
+
+        // One request per connection, read and answered on metricsIo_
+        // under a deadline: a silent scraper cannot hold the port, and
+        // stop() closes the socket to end the exchange at once
+        boost::asio::streambuf buffer;
+        std::string response;
+        boost::asio::steady_timer deadline(metricsIo_, boost::asio::chrono::milliseconds(METRICS_TIMEOUT_MS));
+        deadline.async_wait([&socket](const boost::system::error_code& ec) {
+            if (!ec) {
+                boost::system::error_code ignored;
+                socket.close(ignored);
+            }
+        });
+        boost::asio::async_read_until(socket, buffer, "\r\n\r\n",
+            [this, &socket, &buffer, &response, &deadline](const boost::system::error_code& ec, size_t) {
+                if (ec) {
+                    deadline.cancel();
+                    return;
+                }
+                std::istream request(&buffer);
+                std::string method;
+                std::string target;
+                request >> method >> target;
+
+                std::string status = "200 OK";
+                std::string body;
+                if (method == "GET" && (target == "/metrics" || target == "/")) {
+                    body = metrics();
+                } else {
+                    status = "404 Not Found";
+                    body = "GET /metrics\n";
+                }
+                response = "HTTP/1.1 " + status + "\r\n"
+                    "Content-Type: text/plain; version=0.0.4\r\n"
+                    "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                    "Connection: close\r\n\r\n" + body;
+                boost::asio::async_write(socket, boost::asio::buffer(response),
+                    [&socket, &deadline](const boost::system::error_code&, size_t) {
+                        boost::system::error_code ignored;
+                        socket.shutdown(tcp::socket::shutdown_both, ignored);
+                        deadline.cancel();
+                    });
+            });
+
+        metricsSocket_ = &socket;
+        metricsIo_.restart();
+        metricsIo_.run();
+        metricsSocket_ = nullptr;
+        if (!metricsAcceptor_->is_open()) {
+            break;
+        }
+    }
+}
+
+void NestingDaemon::closeMetrics() {
+    boost::system::error_code ec;
+    metricsAcceptor_->close(ec);
+    if (metricsSocket_) {
+        metricsSocket_->close(ec);
+    }
+}
+
+void NestingDaemon::serve(const std::shared_ptr<Client>& client) {
+    boost::thread writer([client]() { client->write(); });
+
+    boost::asio::streambuf buffer;
+    std::istream input(&buffer);
+    boost::system::error_code ec;
+
+    while (client->open && boost::asio::read_until(client->socket, buffer, '\n', ec)) {
+        std::string line;
+        std::getline(input, line);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        std::istringstream request(line);
+        std::string command;
+        request >> command;
+
+        if (command == "SUBMIT") {
+            int maxGenerations = 0;
+            std::string path;
+            if (!(request >> maxGenerations) || !std::getline(request >> std::ws, path) || path.empty()) {
+                client->send("ERROR usage: SUBMIT <maxGenerations> <job file path>\n");
+            } else {
+                submit(client, std::max(0, maxGenerations), path);
+            }
+        } else if (command == "CANCEL") {
+            int id = 0;
+            request >> id;
+            bool found = false;
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                for (auto& job : jobs_) {
+                    if (job->id == id && job->client == client) {
+                        job->cancelled = true;
+                        found = true;
+                    }
+                }
+            }
+            if (!found) {
+                client->send("ERROR unknown job " + std::to_string(id) + "\n");
+            }
+        } else if (command == "STATS") {
+            size_t jobs;
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                jobs = jobs_.size();
+            }
+            const ShapeCache::Statistics shapes = shapeCache_->statistics();
+            client->send("STATS " + std::to_string(jobs) + " " + std::to_string(nfpCache_->size()) + " " +
+                         std::to_string(shapes.entries) + " " + std::to_string(shapes.lookups) + " " +
+                         std::to_string(shapes.hits) + "\n");
+        } else if (!command.empty()) {
+            client->send("ERROR unknown command " + command + "\n");
+        }
+    }
+
+    // Its jobs are cancelled by the scheduler, which sees it closed
+    client->close();
+    writer.join();
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+}
+
+void NestingDaemon::submit(const std::shared_ptr<Client>& client, int maxGenerations, const std::string& path) {
+    JobFile file;
+    if (!file.open(path)) {
+        client->send("ERROR " + file.error() + "\n");
+        return;
+    }
+
+    std::vector<Polygon> parts;
+    std::vector<int> quantities;
+    std::vector<Polygon> sheets;
+    std::vector<int> sheetQuantities;
+    for (size_t i = 0; i < file.itemCount(); ++i) {
+        if (file.isSheet(i)) {
+            sheets.push_back(file.polygon(i));
+            sheetQuantities.push_back(file.quantity(i));
+        } else {
+            parts.push_back(file.polygon(i));
+            quantities.push_back(file.quantity(i));
+        }
+    }
+
+    auto job = std::make_shared<Job>();
+    job->client = client;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        job->id = ++nextId_;
+    }
+
+    // Callbacks run on the scheduler thread, inside step(); the engine,
+    // and with it the callbacks, does not outlive the job
+    const int id = job->id;
+    Job* state = job.get();
+    auto progress = [client, id, state](const NestProgress& p) {
+        state->generation = p.generation;
+        state->evaluations = p.evaluationsCompleted;
+        std::ostringstream out = numberStream();
+        out << "PROGRESS " << id << ' ' << p.generation << ' ' << p.evaluationsCompleted << ' '
+            << p.bestFitness << ' ' << p.percentComplete << '\n';
+        client->send(out.str(), true);
+    };
+    auto result = [client, id, state](const NestResult& r) {
+        if (r.fitness < state->bestFitness) {
+            state->bestFitness = r.fitness;
+        }
+        size_t count = 0;
+        for (const auto& sheet : r.placements) {
+            count += sheet.size();
+        }
+        std::ostringstream out = numberStream();
+        out << "RESULT " << id << ' ' << r.fitness << ' ' << r.area << ' ' << r.mergedLength << ' ' << count << '\n';
+        for (size_t s = 0; s < r.placements.size(); ++s) {
+            for (const auto& placement : r.placements[s]) {
+                out << "PLACE " << id << ' ' << r.sheetIndex(s) << ' ' << placement.source << ' ' << placement.position.x << ' '
+                    << placement.position.y << ' ' << placement.rotation << '\n';
+            }
+        }
+        client->send(out.str());
+    };
+
+    try {
+        job->processor = std::make_shared<ParallelProcessor>(pool_);
+        job->engine = std::make_unique<NestingEngine>(nestConfig_, job->processor, nfpCache_, shapeCache_);
+        job->engine->initialize(parts, quantities, sheets, sheetQuantities);
+        job->engine->start(progress, result, maxGenerations);
+    } catch (const std::exception& e) {
+        client->send(std::string("ERROR ") + e.what() + "\n");
+        return;
+    }
+
+    client->send("ACCEPTED " + std::to_string(id) + "\n");
+    LOG_NESTING("Daemon job " << id << ": " << path);
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        jobs_.push_back(job);
+    }
+    wake_.notify_all();
+}
+
+void NestingDaemon::schedule() {
+    std::vector<std::shared_ptr<Job>> jobs;
+    for (;;) {
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (jobs_.empty() && !stopped_) {
+                wake_.wait(lock);
+            }
+            if (stopped_) {
+                jobs.swap(jobs_);
+                break;
+            }
+            jobs = jobs_;
+        }
+
+        for (auto& job : jobs) {
+            const bool running = !job->cancelled && job->client->open && job->engine->step();
+            if (!running) {
+                finish(job);
+            }
+        }
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(config_.stepIntervalMs));
+    }
+
+    // Daemon stopping: every job still running ends now
+    for (auto& job : jobs) {
+        job->cancelled = true;
+        finish(job);
+    }
+}
+
+void NestingDaemon::finish(const std::shared_ptr<Job>& job) {
+    job->engine->stop();
+
+    const std::shared_ptr<const NestResult> best = job->engine->getBestResult();
+    std::ostringstream out = numberStream();
+    out << "DONE " << job->id << ' ';
+    if (best) {
+        out << best->fitness;
+    } else {
+        out << "none";
+    }
+    const int evaluations = job->engine->getProgress().evaluationsCompleted;
+    out << ' ' << evaluations << '\n';
+
+    // Dropped first, so STATS after DONE no longer counts it
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        jobs_.erase(std::remove(jobs_.begin(), jobs_.end(), job), jobs_.end());
+        evaluationsFinished_ += static_cast<uint64_t>(evaluations);
+    }
+    job->client->send(out.str());
+    LOG_NESTING("Daemon job " << job->id << (job->cancelled ? " cancelled" : " finished"));
+
+    // Releases the job's share of the pool
+    job->engine.reset();
+    job->processor.reset();
+}
+
+} // namespace deepnest
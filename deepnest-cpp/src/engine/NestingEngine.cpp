@@ -1,29 +1,171 @@
 #include "../../include/deepnest/engine/NestingEngine.h"
+#include "../../include/deepnest/algorithm/GenePairStatistics.h"
+#include "../../include/deepnest/parallel/RemoteWorker.h"
+#include "../../include/deepnest/placement/EvaluationRecorder.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
 #include "../../include/deepnest/geometry/PolygonOperations.h"
+#include "../../include/deepnest/nfp/HoleIndex.h"
 #include "../../include/deepnest/DebugConfig.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
 #include <stdexcept>
-#include <thread>
-#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace deepnest {
 
-NestingEngine::NestingEngine(const DeepNestConfig& config)
+namespace {
+
+// Generations without a better island best after which automatic
+// screening moves the island to full resolution
+const int SCREENING_STALL_GENERATIONS = 3;
+
+const char CHECKPOINT_MAGIC[8] = {'D', 'N', 'C', 'K', 'P', 'T', '0', '1'};
+const uint32_t CHECKPOINT_VERSION = 2;
+
+// FNV-1a over raw bytes, for job fingerprints and checkpoint checksums
+uint64_t fnv1a(const void* data, size_t bytes, uint64_t hash = 1469598103934665603ULL) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Appends fixed-size values to a checkpoint buffer
+ */
+class CheckpointWriter {
+public:
+    std::string data;
+
+    template <typename T>
+    void put(const T& value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(const std::string& value) {
+        put(static_cast<uint32_t>(value.size()));
+        data.append(value);
+    }
+};
+
+/**
+ * @brief Reads what CheckpointWriter wrote; ok() turns false past the end
+ */
+class CheckpointReader {
+public:
+    CheckpointReader(const char* data, size_t size) : data_(data), size_(size), pos_(0), ok_(true) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (!ok_ || size_ - pos_ < sizeof(T)) {
+            ok_ = false;
+            return value;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        const uint32_t length = get<uint32_t>();
+        if (!ok_ || size_ - pos_ < length) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string value(data_ + pos_, length);
+        pos_ += length;
+        return value;
+    }
+
+    // Element count of a list of at least minBytes per element
+    uint32_t getCount(size_t minBytes) {
+        const uint32_t count = get<uint32_t>();
+        if (ok_ && count > (size_ - pos_) / std::max<size_t>(minBytes, 1)) {
+            ok_ = false;
+        }
+        return ok_ ? count : 0;
+    }
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ == size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_;
+    bool ok_;
+};
+
+// Outline area less the area of its holes
+double netArea(const Polygon& polygon) {
+    double area = std::abs(polygon.area());
+    for (const auto& hole : polygon.children) {
+        area -= std::abs(hole.area());
+    }
+    return std::max(0.0, area);
+}
+
+} // anonymous namespace
+
+NestingEngine::NestingEngine(const DeepNestConfig& config,
+                             std::shared_ptr<ParallelProcessor> processor,
+                             std::shared_ptr<NFPCache> nfpCache,
+                             std::shared_ptr<ShapeCache> shapeCache)
     : config_(config)
     , nfpCache_()
+    , sharedNfpCache_(std::move(nfpCache))
+    , shapeCache_(std::move(shapeCache))
+    , parallelProcessor_(std::move(processor))
     , running_(false)
     , maxGenerations_(0)
+    , threadSampleEvaluations_(0)
+    , lastImprovementGeneration_(0)
+    , assignment_(0)
+    , assignmentGeneration_(0)
+    , sheetLowerBound_(0)
+    , partCount_(0)
+    , lastCheckpointGeneration_(0)
+    , speculatedGeneration_(-1)
+    , resumed_(false)
     , evaluationsCompleted_(0)
 {
+    // Bound the NFP cache if a memory budget is configured
+    nfpCache_.setMemoryLimit(static_cast<size_t>(config_.nfpCacheMaxMemoryMB) * 1024 * 1024);
+    nfpCache_.setCompactStorage(config_.nfpCacheCompact ? config_.getClipperScale() : 0.0);
+
+    // Process-wide, as the locks it counts may be shared with other engines
+    LockStats::setEnabled(config_.lockProfiling);
+    StageTimer::setEnabled(config_.stageTiming);
+
     // Create NFP calculator with cache
-    nfpCalculator_ = std::make_unique<NFPCalculator>(nfpCache_);
+    nfpCalculator_ = std::make_unique<NFPCalculator>(sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_, config_);
+
+    // Share outer NFPs across rotations when configured
+    nfpCalculator_->setRotationEquivariant(config_.nfpRotationEquivariant);
 
     // Create placement worker
     placementWorker_ = std::make_unique<PlacementWorker>(config_, *nfpCalculator_);
 
-    // Create parallel processor with configured thread count
-    parallelProcessor_ = std::make_unique<ParallelProcessor>(config_.threads);
+    // Create parallel processor with configured thread count, unless one is shared
+    if (!parallelProcessor_) {
+        parallelProcessor_ = std::make_shared<ParallelProcessor>(
+            config_.threads, ParallelProcessor::backendFromName(config_.taskScheduler),
+            WorkerAffinity{config_.pinWorkerThreads, config_.numaScheduling});
+    }
+    placementWorker_->setParallelProcessor(parallelProcessor_.get());
 }
 
 NestingEngine::~NestingEngine() {
@@ -41,12 +183,12 @@ NestingEngine::~NestingEngine() {
     LOG_MEMORY("NFP cache cleared (" << nfpCache_.size() << " entries now)");
 
     // Explicitly destroy components in correct order
-    // ParallelProcessor must be destroyed first to stop all threads
+    // ParallelProcessor must be released first; an engine-owned pool stops
+    // its threads here, a shared one holds no task of this engine after stop()
     if (parallelProcessor_) {
-        LOG_MEMORY("Destroying parallel processor (should already be null from stop())");
+        LOG_MEMORY("Releasing parallel processor");
+        placementWorker_->setParallelProcessor(nullptr);
         parallelProcessor_.reset();
-    } else {
-        LOG_MEMORY("Parallel processor already destroyed");
     }
 
     // Then destroy placement worker
@@ -92,14 +234,41 @@ void NestingEngine::initialize(
     LOG_MEMORY("Clearing previous state: parts_(" << parts_.size() << "), partPointers_(" << partPointers_.size() << "), sheets_(" << sheets_.size() << ")");
     parts_.clear();
     partPointers_.clear();
+    holeFills_.clear();
     sheets_.clear();
-    results_.clear();
+    job_.reset();
+    fitnessMemo_.reset();
+    surrogate_.reset();
+    feasibleRotations_.reset();
+    std::atomic_store(&results_, std::make_shared<const ResultHistory>());
     evaluationsCompleted_ = 0;
+    lastCheckpointGeneration_ = 0;
+    speculatedGeneration_ = -1;
+    resumed_ = false;
     geneticAlgorithm_.reset();
     nfpCache_.clear();
     
     LOG_MEMORY("Previous state cleared");
 
+    // Attach the persistent NFP store; keys include spacing and curve
+    // tolerance, which are final for this run. Spacing offsets are kept
+    // in it too, so it is opened before they are computed. Checkpointed
+    // runs without a store of their own keep one beside the checkpoint
+    std::string storePath = config_.nfpStorePath;
+    if (storePath.empty() && !config_.checkpointPath.empty() && config_.checkpointNFPs) {
+        storePath = config_.checkpointPath + ".nfp";
+    }
+    std::shared_ptr<PersistentNFPStore> store;
+    if (!storePath.empty()) {
+        store = std::make_shared<PersistentNFPStore>(config_.spacing, config_.curveTolerance);
+        if (store->open(storePath)) {
+            LOG_NESTING("Opened NFP store " << storePath << " with " << store->size() << " NFPs");
+        } else {
+            store.reset();
+        }
+    }
+    nfpCalculator_->setPersistentStore(store);
+
     // JavaScript: for(i=0; i<parts.length; i++) {
     //               if(parts[i].sheet) {
     //                 offsetTree(parts[i].polygontree, -0.5*config.spacing, ...);
@@ -108,24 +277,36 @@ void NestingEngine::initialize(
     //               }
     //             }
 
+    // Spacing offsets, once per distinct shape
+    std::vector<Polygon> spacedSheets;
+    std::vector<Polygon> spacedParts;
+    if (config_.spacing > 0) {
+        spacedSheets = spaceShapes(sheets, sheetQuantities, -0.5 * config_.spacing, store.get());
+        spacedParts = spaceShapes(parts, quantities, 0.5 * config_.spacing, store.get());
+    }
+
     // Prepare sheets with spacing (shrink sheets by spacing)
     // JavaScript uses -0.5*spacing for sheets
     for (size_t i = 0; i < sheets.size(); ++i) {
         for (int q = 0; q < sheetQuantities[i]; ++q) {
-            Polygon sheet = sheets[i];
+            Polygon sheet = config_.spacing > 0 ? spacedSheets[i] : sheets[i];
             sheet.id = static_cast<int>(sheets_.size());
             sheet.source = static_cast<int>(i);
 
-            // Apply negative offset to sheets (shrink)
+            // Negative offset applied to sheets (shrink)
             if (config_.spacing > 0) {
-                sheet = applySpacing(sheet, -0.5 * config_.spacing,  config_.curveTolerance);
-                
                 // If sheet became invalid/empty after spacing, skip it
                 if (sheet.points.size() < 3 || std::abs(sheet.area()) < 1e-6) {
                     continue;
                 }
             }
 
+            // Content-address the final geometry for NFP caching
+            sheet.updateFingerprint();
+            sheet.updateCoordinates();
+            if (!sheet.children.empty()) {
+                sheet.updateRings();
+            }
             sheets_.push_back(sheet);
         }
     }
@@ -136,32 +317,77 @@ void NestingEngine::initialize(
     int id = 0;
     for (size_t i = 0; i < parts.size(); ++i) {
         for (int q = 0; q < quantities[i]; ++q) {
-            Polygon part = parts[i];
+            Polygon part = config_.spacing > 0 ? spacedParts[i] : parts[i];
             part.id = id++;
             part.source = static_cast<int>(i);
 
-            // Apply positive offset to parts (expand)
+            // Positive offset applied to parts (expand)
             if (config_.spacing > 0) {
-                part = applySpacing(part, 0.5 * config_.spacing,  config_.curveTolerance);
-                
                 // If part became invalid/empty after spacing, skip it
                 if (part.points.size() < 3 || std::abs(part.area()) < 1e-6) {
                     continue;
                 }
             }
 
+            // Content-address the final geometry so that quantity copies and
+            // duplicate shapes share their NFPs
+            part.updateFingerprint();
+
+            // Convexity is rotation invariant, so it is detected once here
+            // and carried to every rotated copy
+            part.updateConvexity();
+
+            // Contiguous coordinates for the area and bounds queries of
+            // every placement; rotated variants inherit them
+            part.updateCoordinates();
+
+            // Integer Clipper path shared by every copy; unrotated
+            // placements feed it straight into the Minkowski sum
+            part.updateScaledPath(config_.clipperScale);
+
+            // Low-resolution outline for the screening generations; parts
+            // it would not simplify keep a single level
+            if (config_.coarseScreeningGenerations != 0) {
+                Polygon outline = part.conservativeOutline(config_.coarseScreeningTolerance,
+                                                           config_.getClipperScale());
+                if (!outline.points.empty()) {
+                    outline.updateCoordinates();
+                    outline.updateScaledPath(config_.clipperScale);
+                    part.coarse = std::make_shared<const Polygon>(std::move(outline));
+                }
+            }
             parts_.push_back(part);
         }
     }
 
+    // Pick the NFP engine per pair from a calibrated cost profile
+    NFPBackendSelector backends;
+    if (config_.nfpBackendCalibrate) {
+        NFPCalculator& calculator = *nfpCalculator_;
+        backends.calibrate(parts_, [&calculator](NFPBackend backend, const Polygon& A, const Polygon& B) {
+            return calculator.computeWithBackend(backend, A, B);
+        });
+        LOG_NESTING("Calibrated NFP backends on " << parts_.size() << " parts");
+        if (!config_.nfpBackendProfilePath.empty()) {
+            backends.save(config_.nfpBackendProfilePath);
+        }
+    } else if (!config_.nfpBackendProfilePath.empty() && backends.load(config_.nfpBackendProfilePath)) {
+        LOG_NESTING("Loaded NFP backend profile " << config_.nfpBackendProfilePath);
+    }
+    nfpCalculator_->setBackendSelector(backends);
+
+    if (config_.holeFilling) {
+        fillHoles();
+    }
+
     // JavaScript: adam.sort(function(a, b) {
     //               return Math.abs(GeometryUtil.polygonArea(b)) - Math.abs(GeometryUtil.polygonArea(a));
     //             });
-    // Sort parts by area (largest first)
-    std::sort(parts_.begin(), parts_.end(),
+    // Sort parts by area (largest first); stable, so the copies of a part
+    // stay consecutive for config.groupQuantities
+    std::stable_sort(parts_.begin(), parts_.end(),
         [](const Polygon& a, const Polygon& b) {
-            return std::abs(GeometryUtil::polygonArea(a.points)) >
-                   std::abs(GeometryUtil::polygonArea(b.points));
+            return std::abs(a.area()) > std::abs(b.area());
         });
 
     // Create shared_ptr for GA instead of raw pointers
@@ -178,8 +404,29 @@ void NestingEngine::initialize(
     // JavaScript: GA = new GeneticAlgorithm(adam, config);
     // Initialize genetic algorithm
     LOG_NESTING("Creating GeneticAlgorithm with " << partPointers_.size() << " parts");
-    geneticAlgorithm_ = std::make_unique<GeneticAlgorithm>(partPointers_, config_);
+    if (config_.feasibleRotations) {
+        feasibleRotations_ = computeFeasibleRotations();
+    }
+    // Genomes only carry feasible rotations, so no first part needs turning
+    placementWorker_->setRotationRetry(feasibleRotations_ == nullptr);
+
+    geneticAlgorithm_ = std::make_unique<GeneticAlgorithm>(partPointers_, config_, feasibleRotations_);
     LOG_NESTING("GeneticAlgorithm created successfully");
+    if (config_.greedyFirstResult && !sheets_.empty()) {
+        geneticAlgorithm_->getIsland(0).getIndividuals().front() = greedyIndividual();
+    }
+
+    partCount_ = parts_.size();
+    for (const auto& fill : holeFills_) {
+        partCount_ += fill.second.size();
+    }
+    sheetLowerBound_ = computeSheetLowerBound();
+    LOG_NESTING("Sheet lower bound: " << sheetLowerBound_);
+
+    if (config_.surrogateOversampling > 1 && !sheets_.empty()) {
+        surrogate_ = std::make_shared<SurrogateFitness>(sheets_[0]);
+        geneticAlgorithm_->setSurrogate(surrogate_);
+    }
     LOG_NESTING("NestingEngine::initialize() completed successfully");
 }
 
@@ -192,18 +439,83 @@ void NestingEngine::start(
         throw std::runtime_error("Must call initialize() before start()");
     }
 
-    // Recreate ParallelProcessor if it was previously stopped
-    // A stopped processor cannot be reused (stopped_=true prevents new tasks)
-    // This fixes the segfault when running nesting a second time
-    if (!parallelProcessor_) {
-        parallelProcessor_ = std::make_unique<ParallelProcessor>(config_.threads);
+    // Every evaluation of this run shares one copy of the sheets and the
+    // parts turned to each rotation, turned across the pool
+    PlacementJob::ParallelFor turnAcrossPool;
+    if (parallelProcessor_) {
+        turnAcrossPool = [this](size_t count, const std::function<void(size_t, size_t)>& body) {
+            parallelProcessor_->parallelFor(count, 1, body);
+        };
+    }
+    job_ = std::make_shared<const PlacementJob>(sheets_, partPointers_, config_.rotations,
+                                                config_.clipperScale, config_.integerGeometry,
+                                                turnAcrossPool, shapeCache_.get());
+    // Loops of concave orbital NFPs (config.exploreConcave) likewise
+    nfpCalculator_->setParallelFor(turnAcrossPool);
+
+    buildSheetOrders();
+
+    // Genomes are keyed by variants of this job
+    fitnessMemo_ = config_.fitnessMemoMaxEntries > 0
+        ? std::make_shared<FitnessMemo>(static_cast<size_t>(config_.fitnessMemoMaxEntries))
+        : nullptr;
+
+    // Evaluations overflow to remote worker processes, which get the job once
+    if (!config_.remoteWorkers.empty() && parallelProcessor_) {
+        const auto endpoints = RemoteNode::parseEndpoints(config_.remoteWorkers);
+        const size_t connected = parallelProcessor_->connectRemoteWorkers(
+            endpoints, job_, RemoteNode::encodeJob(config_, sheets_, partPointers_), config_.remoteWorkerToken);
+        if (connected < endpoints.size()) {
+            std::cerr << "WARNING: connected " << connected << " of " << endpoints.size()
+                      << " remote workers" << std::endl;
+        }
     }
 
+    // Slow evaluations are recorded with the same snapshot remote workers get
+    placementWorker_->setRecorder(config_.evaluationRecordPath.empty() ? nullptr
+        : std::make_shared<EvaluationRecorder>(config_.evaluationRecordPath,
+                                               RemoteNode::encodeJob(config_, sheets_, partPointers_),
+                                               config_.evaluationRecordFactor,
+                                               static_cast<size_t>(config_.evaluationRecordLimit)));
+
     progressCallback_ = progressCallback;
     resultCallback_ = resultCallback;
     maxGenerations_ = maxGenerations;
+    startTime_ = std::chrono::steady_clock::now();
+    stageBaseline_ = StageTimer::snapshot();
+    generationStageBaseline_ = stageBaseline_;
+    generationStages_ = StageTimes();
+
+    // Each run tunes from all threads; a pool kept from the last run is
+    // released from its limit otherwise
+    threadController_.reset();
+    if (parallelProcessor_) {
+        parallelProcessor_->setActiveThreads(0);
+        parallelProcessor_->setTaskTiming(config_.adaptiveThreads);
+        if (config_.adaptiveThreads) {
+            threadController_ = std::make_unique<ThreadCountController>(
+                config_.minThreads, parallelProcessor_->getActiveThreads());
+            threadSampleEvaluations_ = evaluationsCompleted_;
+            threadSampleTime_ = startTime_;
+            threadSampleTasks_ = parallelProcessor_->taskTimes();
+        }
+    }
     running_ = true;
 
+    // A resumed run continues the convergence state of its checkpoint
+    if (!resumed_) {
+        lastImprovementGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+        islandDetail_.assign(geneticAlgorithm_->getIslandCount(), IslandDetail());
+    }
+    resumed_ = false;
+    lastCheckpointGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+    assignment_ = results_->empty() ? 0 : sheetAssignment(*results_->front());
+    assignmentGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+    markScreening();
+    if (config_.greedyFirstResult && results_->empty()) {
+        launchGreedy();
+    }
+
     // Note: In the JavaScript version, this uses a timer (setInterval)
     // In C++, the user should call step() in their main loop or from a timer
 }
@@ -211,36 +523,36 @@ void NestingEngine::start(
 void NestingEngine::stop() {
     LOG_NESTING("NestingEngine::stop() called");
 
-    if (!running_) {
-        LOG_NESTING("Already stopped, returning");
-        return;
+    if (running_) {
+        LOG_NESTING("Stopping nesting engine");
+        running_ = false;
     }
 
-    LOG_NESTING("Stopping nesting engine");
-    running_ = false;
-
+    // Evaluations may still be running when step() has ended the run
+    // itself, and the pool outlives the engine, so this always drains it
     if (parallelProcessor_) {
-        LOG_THREAD("Stopping parallel processor");
-
-        // Explicit stop with task queue flush
-        // This now waits for all pending tasks to complete (see ParallelProcessor::stop())
-        parallelProcessor_->stop();
+        // Queued tasks are dropped and running evaluations stop at their
+        // next part or NFP, instead of tearing the threads down; the pool
+        // stays ready for the next start()
+        LOG_THREAD("Cancelling queued and running tasks");
+        parallelProcessor_->cancel();
 
-        // Explicit wait to ensure all tasks completed
-        LOG_THREAD("Waiting for all tasks to complete");
+        LOG_THREAD("Waiting for running tasks to complete");
         parallelProcessor_->waitAll();
 
-        // Destroy the processor to force recreation on next start()
-        // A stopped processor cannot be reused, so we must create a fresh one
-        LOG_THREAD("Destroying parallel processor");
-        parallelProcessor_.reset();
-
-        // Small delay to ensure complete cleanup before destructor
-        // This gives time for any remaining cleanup operations in threads
-        LOG_THREAD("Waiting 50ms for complete cleanup");
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Nodes hold this run's job
+        parallelProcessor_->disconnectRemoteWorkers();
+    }
 
-        LOG_THREAD("Parallel processor destroyed and cleaned up");
+    // Cancelled evaluations never publish; launch them again on restart
+    if (geneticAlgorithm_) {
+        for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+            for (auto& individual : geneticAlgorithm_->getIsland(k).getIndividuals()) {
+                if (individual.state() == EvaluationState::PROCESSING) {
+                    individual.evaluation.reset();
+                }
+            }
+        }
     }
 
     LOG_NESTING("Nesting engine stopped successfully");
@@ -251,9 +563,30 @@ bool NestingEngine::step() {
         return false;
     }
 
-    // Check if we've reached max generations
-    if (maxGenerations_ > 0 && geneticAlgorithm_->getCurrentGeneration() >= maxGenerations_) {
+    // Anytime termination: the best result so far stays in results_, and
+    // evaluations still running would only be discarded, so they are
+    // cancelled rather than waited for
+    if (budgetExhausted()) {
+        LOG_NESTING("Budget exhausted at generation " << geneticAlgorithm_->getCurrentGeneration()
+                    << " after " << elapsedSeconds() << " s");
         running_ = false;
+        if (parallelProcessor_) {
+            parallelProcessor_->cancel();
+        }
+
+        // A run that converged or used its generations ends with a local
+        // search around its best individual
+        const bool timedOut = config_.timeoutSeconds > 0 && elapsedSeconds() >= config_.timeoutSeconds;
+        if (!timedOut && (config_.polishMoves > 0 || config_.sheetDecompositionGenerations > 0)) {
+            collectEvaluations();
+            if (config_.polishMoves > 0) {
+                polish();
+            }
+            if (config_.sheetDecompositionGenerations > 0) {
+                decompose();
+            }
+        }
+        checkpointIfDue(true);
         return false;
     }
 
@@ -269,32 +602,82 @@ bool NestingEngine::step() {
     //               GA.generation();
     //             }
 
-    // Check if current generation is complete
-    if (isGenerationComplete()) {
-        // Get current best before creating next generation
-        const Individual& bestBefore = geneticAlgorithm_->getBestIndividual();
-        double fitnessBefore = bestBefore.fitness;
-        int genBefore = geneticAlgorithm_->getCurrentGeneration();
-
-        // All individuals evaluated, create next generation
-        geneticAlgorithm_->generation();
-
-        // Log generation transition with fitness comparison
-        const Individual& bestAfter = geneticAlgorithm_->getBestIndividual();
-        LOG_GA("*** Generation " << genBefore << " -> " << geneticAlgorithm_->getCurrentGeneration()
-                  << ": Best fitness " << fitnessBefore);
-        if (bestAfter.fitness < fitnessBefore) {
-            LOG_GA(" -> " << bestAfter.fitness << " (IMPROVED by "
-                      << (fitnessBefore - bestAfter.fitness) << ")");
-        } else if (bestAfter.fitness == fitnessBefore) {
-            LOG_GA(" (NO CHANGE)");
-        } else {
-            LOG_GA(" -> " << bestAfter.fitness << " (WORSE?!)");
+    // JavaScript processes results in the background-response IPC callback;
+    // here workers publish into each individual's slot and they are
+    // collected before the population is inspected
+    collectEvaluations();
+    enforceMemoryLimit();
+
+    if (config_.steadyState) {
+        // No generation barrier: children fill the slots finished evaluations
+        // freed, so a slow individual does not leave the other threads idle
+        [[maybe_unused]] const int genBefore = geneticAlgorithm_->getCurrentGeneration();
+        const size_t concurrency = parallelProcessor_ ? parallelProcessor_->getThreadCount() : 0;
+
+        if (geneticAlgorithm_->breedOffspring(concurrency)) {
+            LOG_GA("*** Generation " << genBefore << " -> " << geneticAlgorithm_->getCurrentGeneration()
+                      << " (steady-state): Best fitness " << geneticAlgorithm_->getBestIndividual().fitness);
+
+            for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+                trackConvergence(k);
+                refineElite(geneticAlgorithm_->getIsland(k));
+            }
+
+            markGenerationStages();
+            adaptThreads();
+            if (progressCallback_) {
+                progressCallback_(getProgress());
+            }
+            checkpointIfDue();
+        }
+        markScreening();
+    }
+    // Each island moves on as soon as its own generation is complete
+    else {
+        bool advanced = false;
+        for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+            Population& island = geneticAlgorithm_->getIsland(k);
+
+            // A coarse elite is evaluated at full resolution before it is
+            // carried into the next generation
+            if (!island.isGenerationComplete() || refineElite(island)) {
+                continue;
+            }
+
+            // Get current best before creating next generation
+            island.sortByFitness();
+            double fitnessBefore = island.getBest().fitness;
+            [[maybe_unused]] const int genBefore = geneticAlgorithm_->getIslandGeneration(k);
+
+            // All individuals evaluated, create next generation
+            trackConvergence(k);
+            geneticAlgorithm_->generation(k);
+            advanced = true;
+
+            // Log generation transition with fitness comparison
+            const Individual& bestAfter = island.getBest();
+            LOG_GA("*** Island " << k << " generation " << genBefore << " -> "
+                      << geneticAlgorithm_->getIslandGeneration(k) << ": Best fitness " << fitnessBefore);
+            if (bestAfter.fitness < fitnessBefore) {
+                LOG_GA(" -> " << bestAfter.fitness << " (IMPROVED by "
+                          << (fitnessBefore - bestAfter.fitness) << ")");
+            } else if (bestAfter.fitness == fitnessBefore) {
+                LOG_GA(" (NO CHANGE)");
+            } else {
+                LOG_GA(" -> " << bestAfter.fitness << " (WORSE?!)");
+            }
         }
 
-        // Report progress
-        if (progressCallback_) {
-            progressCallback_(getProgress());
+        if (advanced) {
+            markScreening();
+
+            // Report progress
+            markGenerationStages();
+            adaptThreads();
+            if (progressCallback_) {
+                progressCallback_(getProgress());
+            }
+            checkpointIfDue();
         }
     }
 
@@ -307,84 +690,108 @@ bool NestingEngine::step() {
     //               }
     //             }
 
-    // CRITICAL: Generate and calculate NFPs BEFORE launching placement workers
-    // This matches JavaScript behavior (svgnest.js lines 287-447)
-    // JavaScript generates nfpPairs, calculates them in parallel, populates nfpCache,
-    // THEN passes the cache to PlacementWorker
-    
-    //LOG_NESTING("Generating NFP pairs for unevaluated individuals");
-    //std::vector<NFPPair> nfpPairs = generateNFPPairs();
-    
-    //if (!nfpPairs.empty()) {
-    //    LOG_NESTING("Calculating " << nfpPairs.size() << " NFP pairs in parallel");
-    //    parallelProcessor_->calculateNFPsParallel(nfpPairs, nfpCache_, config_);
-    //    LOG_NESTING("NFP calculation complete");
-    //}
-
-    // Launch parallel evaluations for unevaluated individuals
-    // Note: ParallelProcessor::processPopulation handles the parallel execution
-    // NOW PlacementWorker can use the populated NFP cache
     // Check if parallelProcessor_ exists (may be nullptr after stop())
     if (!parallelProcessor_) {
         running_ = false;
         return false;
     }
 
-    parallelProcessor_->processPopulation(
-        geneticAlgorithm_->getPopulationObject(), // Access population object through GA
-        sheets_,
-        *placementWorker_,
-        config_.threads
-    );
+    // Generate NFPs ahead of placement (svgnest.js lines 287-447).
+    // JavaScript calculates all nfpPairs, then launches placement workers.
+    // Here the prioritized batch is enqueued before the placement tasks that
+    // need it, while individuals whose NFPs are already cached start first
+    // and overlap with the batch. Placement tasks that reach a pair still
+    // being calculated wait on it rather than computing it again.
+    std::vector<std::vector<size_t>> cold;
+    std::vector<NFPPair> sheetPairs;
+    std::vector<NFPPair> nfpPairs = generateNFPPairs(cold, sheetPairs);
+
+    // Within each launch, the individuals predicted to take longest start
+    // first, so no expensive one is left to run alone at the end
+    auto coldOf = [&cold](size_t k) -> std::function<size_t(size_t)> {
+        const std::vector<size_t>& island = cold[k];
+        return [&island](size_t i) { return i < island.size() ? island[i] : 0; };
+    };
+
+    if (!nfpPairs.empty()) {
+        LOG_NESTING("Prefetching " << nfpPairs.size() << " NFP pairs");
+        for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+            const std::vector<size_t>& islandCold = cold[k];
+            parallelProcessor_->processPopulation(
+                geneticAlgorithm_->getIsland(k),
+                job_,
+                *placementWorker_,
+                config_.threads,
+                [&islandCold](size_t i) { return i < islandCold.size() && islandCold[i] == 0; },
+                config_.branchAndBound,
+                fitnessMemo_,
+                config_.longestFirst ? coldOf(k) : nullptr
+            );
+        }
+        parallelProcessor_->prefetchNFPs(nfpPairs, *nfpCalculator_);
+    }
 
-    // Note: The JavaScript version processes results via IPC callback
-    // In our C++ version, the PlacementWorker execution happens in parallel threads
-    // and updates Individual.fitness directly. We need to check for new best results.
-
-    // Check for best results and update
-    // Use executeLocked to safely read results from individuals
-    // This prevents race conditions where worker threads are updating the individual
-    // while we are trying to read its fitness or placements.
-    std::vector<NestResult> newBetterResults;
-
-    parallelProcessor_->executeLocked([&]() {
-    auto& population = geneticAlgorithm_->getPopulation();
-    for (size_t i = 0; i < population.size(); ++i) {
-        Individual& individual = population[i];
-
-        // Check if this individual was just evaluated
-        if (individual.hasValidFitness() && !individual.processing) {
-                // Check if it's a new best result
-                // We check against results_ here (safe as we are on main thread)
-                // to avoid unnecessary copying of placements for non-best results
-            if (results_.empty() || results_[0].fitness > individual.fitness) {
-                NestResult result;
-                result.fitness = individual.fitness;
-                result.generation = geneticAlgorithm_->getCurrentGeneration();
-                result.individualIndex = static_cast<int>(i);
-                result.area = individual.area;
-                result.mergedLength = individual.mergedLength;
-                    result.placements = individual.placements;  // Copy actual placements! SAFE under lock
-
-                    newBetterResults.push_back(result);
-                }
-            }
+    // Launch parallel evaluations for the remaining unevaluated individuals
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        parallelProcessor_->processPopulation(
+            geneticAlgorithm_->getIsland(k), // Access population object through GA
+            job_,
+            *placementWorker_,
+            config_.threads,
+            nullptr,
+            config_.branchAndBound,
+            fitnessMemo_,
+            config_.longestFirst ? coldOf(k) : nullptr
+        );
+    }
+
+    // Inner NFPs on the later sheet types (remnants, mixed stock) queue
+    // behind this generation's work instead of being computed by the
+    // first placement to reach such a sheet
+    if (!sheetPairs.empty()) {
+        LOG_NESTING("Prefetching " << sheetPairs.size() << " inner NFPs of later sheets");
+        parallelProcessor_->prefetchNFPs(sheetPairs, *nfpCalculator_);
+    }
+
+    // Once per generation, behind its work so that threads it leaves idle
+    // run them: the NFPs the gene statistics expect the next one to need
+    const int generation = geneticAlgorithm_->getCurrentGeneration();
+    if (config_.speculativeNfpPairs > 0 && generation != speculatedGeneration_) {
+        speculatedGeneration_ = generation;
+        std::vector<NFPPair> speculative = speculativeNFPPairs(nfpPairs);
+        if (!speculative.empty()) {
+            LOG_NESTING("Speculatively prefetching " << speculative.size() << " NFP pairs");
+            parallelProcessor_->prefetchNFPs(speculative, *nfpCalculator_);
         }
-    });
+    }
 
-    // Process the collected results outside the lock
-    for (const auto& result : newBetterResults) {
-        // Re-check condition as we might have multiple better results
-        if (results_.empty() || results_[0].fitness > result.fitness) {
-                updateResults(result);
+    return running_;
+}
 
-                if (resultCallback_) {
-                    resultCallback_(result);
-                }
+bool NestingEngine::waitForEvaluation(int timeoutMs) {
+    if (!running_ || !geneticAlgorithm_ || !parallelProcessor_) {
+        return false;
+    }
+
+    // Taken before looking at the slots, so a task publishing in between
+    // still ends the wait
+    const uint64_t seen = parallelProcessor_->getCompletedCount();
+
+    bool inFlight = false;
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        for (const auto& individual : geneticAlgorithm_->getIsland(k).getIndividuals()) {
+            if (individual.state() == EvaluationState::DONE) {
+                return true;
             }
+            inFlight = inFlight || individual.isProcessing();
         }
+    }
+    if (!inFlight) {
+        return true;
+    }
 
-    return running_;
+    STAGE_SCOPE(Wait);
+    return parallelProcessor_->waitForCompletion(seen, timeoutMs);
 }
 
 bool NestingEngine::isRunning() const {
@@ -397,21 +804,32 @@ NestProgress NestingEngine::getProgress() const {
     if (geneticAlgorithm_) {
         progress.generation = geneticAlgorithm_->getCurrentGeneration();
         progress.evaluationsCompleted = evaluationsCompleted_;
+        progress.fitnessMemoHits = fitnessMemo_
+            ? static_cast<int>(fitnessMemo_->statistics().hits) : 0;
 
-        if (!results_.empty()) {
-            progress.bestFitness = results_[0].fitness;
-        } else {
-            progress.bestFitness = std::numeric_limits<double>::max();
-        }
+        const std::shared_ptr<const ResultHistory> results = getResults();
+        progress.bestFitness = results->empty()
+            ? std::numeric_limits<double>::max() : results->front()->fitness;
 
-        if (maxGenerations_ > 0) {
-            progress.percentComplete = 100.0 * progress.generation / maxGenerations_;
-        } else {
-            progress.percentComplete = 0.0;
+        progress.percentComplete = 0.0;
+        const int limit = generationLimit();
+        if (limit > 0) {
+            progress.percentComplete = 100.0 * progress.generation / limit;
         }
+        if (config_.timeoutSeconds > 0 && running_) {
+            progress.percentComplete = std::max(progress.percentComplete,
+                100.0 * elapsedSeconds() / config_.timeoutSeconds);
+        }
+        progress.percentComplete = std::min(progress.percentComplete, 100.0);
+        progress.memory = getMemoryUsage();
+        progress.stageTimes = StageTimer::snapshot() - stageBaseline_;
+        progress.generationStageTimes = generationStages_;
+        progress.activeThreads = parallelProcessor_ ? parallelProcessor_->getActiveThreads() : 0;
+        progress.evaluationsPerSecond = threadController_ ? threadController_->throughput() : 0.0;
     } else {
         progress.generation = 0;
         progress.evaluationsCompleted = 0;
+        progress.fitnessMemoHits = 0;
         progress.bestFitness = std::numeric_limits<double>::max();
         progress.percentComplete = 0.0;
     }
@@ -419,15 +837,70 @@ NestProgress NestingEngine::getProgress() const {
     return progress;
 }
 
-const NestResult* NestingEngine::getBestResult() const {
-    if (results_.empty()) {
+std::shared_ptr<const NestResult> NestingEngine::getBestResult() const {
+    const std::shared_ptr<const ResultHistory> results = getResults();
+    if (results->empty()) {
         return nullptr;
     }
-    return &results_[0];
+    return results->front();
+}
+
+std::shared_ptr<const ResultHistory> NestingEngine::getResults() const {
+    return std::atomic_load(&results_);
+}
+
+double NestingEngine::bestFitness() const {
+    return results_->empty() ? std::numeric_limits<double>::max() : results_->front()->fitness;
+}
+
+NFPCache::Statistics NestingEngine::getNfpCacheStatistics() const {
+    return (sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_).statistics();
+}
+
+ContentionStats NestingEngine::getContentionStats() const {
+    const NFPCache& cache = sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_;
+    ContentionStats stats;
+    stats.enabled = LockStats::enabled();
+    stats.processor = parallelProcessor_->contentionStats();
+    stats.nfpCacheShared = cache.sharedLockStats();
+    stats.nfpCacheExclusive = cache.exclusiveLockStats();
+    return stats;
 }
 
-const std::vector<NestResult>& NestingEngine::getResults() const {
-    return results_;
+MemoryUsage NestingEngine::getMemoryUsage() const {
+    const NFPCache& cache = sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_;
+    MemoryUsage usage;
+    usage.nfpCacheBytes = cache.residentBytes();
+    usage.nfpCacheLimitBytes = cache.memoryLimit();
+    usage.limitBytes = static_cast<size_t>(config_.memoryLimitMB) * 1024 * 1024;
+
+    if (geneticAlgorithm_) {
+        usage.populationBytes = geneticAlgorithm_->memoryBytes();
+    }
+
+    const std::shared_ptr<const ResultHistory> results = getResults();
+    usage.resultBytes = results->capacity() * sizeof(ResultHistory::value_type);
+    for (const auto& result : *results) {
+        usage.resultBytes += sizeof(NestResult) +
+            PlacementWorker::memoryBytes(result->placements) - sizeof(result->placements);
+    }
+    if (fitnessMemo_) {
+        usage.resultBytes += fitnessMemo_->statistics().bytes;
+    }
+
+    for (const auto& part : parts_) {
+        usage.geometryBytes += part.memoryBytes();
+    }
+    for (const auto& part : partPointers_) {
+        usage.geometryBytes += part->memoryBytes();
+    }
+    for (const auto& sheet : sheets_) {
+        usage.geometryBytes += sheet.memoryBytes();
+    }
+    if (job_) {
+        usage.geometryBytes += job_->memoryBytes();
+    }
+    return usage;
 }
 
 const DeepNestConfig& NestingEngine::getConfig() const {
@@ -443,6 +916,11 @@ void NestingEngine::setResultCallback(ResultCallback callback) {
 }
 
 Polygon NestingEngine::applySpacing(const Polygon& polygon, double offset, double curveTolerance) {
+    return applySpacing(polygon, offset, curveTolerance, DeepNestConfig::getInstance().getClipperScale());
+}
+
+Polygon NestingEngine::applySpacing(const Polygon& polygon, double offset, double curveTolerance,
+                                    double clipperScale) {
     if (std::abs(offset) < 1e-6) {
         return polygon;
     }
@@ -452,7 +930,7 @@ Polygon NestingEngine::applySpacing(const Polygon& polygon, double offset, doubl
 
     // Use PolygonOperations::offset
     std::vector<std::vector<Point>> offsetResults =
-        PolygonOperations::offset(polygon.points, offset, 4.0, curveTolerance);
+        PolygonOperations::offset(polygon.points, offset, 4.0, curveTolerance, clipperScale);
 
     if (offsetResults.empty()) {
         // Offset failed or polygon vanished (e.g. negative offset on small part)
@@ -468,7 +946,7 @@ Polygon NestingEngine::applySpacing(const Polygon& polygon, double offset, doubl
     
     // Clean the result to ensure valid geometry (remove self-intersections)
     // This matches the "clean shapes" strategy
-    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(offsetResults[0]);
+    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(offsetResults[0], clipperScale);
     
     if (cleanedPoints.size() < 3) {
         // Invalid after cleaning
@@ -483,7 +961,7 @@ Polygon NestingEngine::applySpacing(const Polygon& polygon, double offset, doubl
     if (!polygon.children.empty()) {
         result.children.clear();
         for (const auto& child : polygon.children) {
-            Polygon offsetChild = applySpacing(child, -offset, curveTolerance);
+            Polygon offsetChild = applySpacing(child, -offset, curveTolerance, clipperScale);
             // Only add valid children
             if (offsetChild.points.size() >= 3 && std::abs(offsetChild.area()) > 1e-6) {
                 result.children.push_back(offsetChild);
@@ -494,8 +972,259 @@ Polygon NestingEngine::applySpacing(const Polygon& polygon, double offset, doubl
     return result;
 }
 
+std::vector<Polygon> NestingEngine::spaceShapes(
+    const std::vector<Polygon>& shapes,
+    const std::vector<int>& quantities,
+    double offset,
+    PersistentNFPStore* store
+) {
+    // Distinct geometries, each with the first shape that has it
+    std::vector<size_t> distinctOf(shapes.size(), 0);
+    std::vector<size_t> firstShape;
+    std::vector<uint64_t> geometry;
+    std::unordered_map<uint64_t, size_t> seen;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (quantities[i] <= 0) {
+            continue;
+        }
+        const uint64_t hash = PersistentNFPStore::geometryHash(shapes[i]);
+        auto inserted = seen.emplace(hash, firstShape.size());
+        if (inserted.second) {
+            firstShape.push_back(i);
+            geometry.push_back(hash);
+        }
+        distinctOf[i] = inserted.first->second;
+    }
+
+    const double curveTolerance = config_.curveTolerance;
+    std::vector<Polygon> spaced(firstShape.size());
+    std::vector<size_t> missing;
+    for (size_t k = 0; k < firstShape.size(); ++k) {
+        std::vector<Polygon> stored;
+        if (shapeCache_ && shapeCache_->findOffset(geometry[k], offset, curveTolerance, spaced[k])) {
+            continue;
+        }
+        if (store && store->find(PersistentNFPStore::Key::spacing(geometry[k], offset < 0), stored) &&
+            !stored.empty()) {
+            spaced[k] = std::move(stored.front());
+            if (shapeCache_) {
+                shapeCache_->insertOffset(geometry[k], offset, curveTolerance, spaced[k]);
+            }
+        } else {
+            missing.push_back(k);
+        }
+    }
+
+    auto offsetShapes = [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            const size_t k = missing[m];
+            spaced[k] = applySpacing(shapes[firstShape[k]], offset, curveTolerance,
+                                     config_.getClipperScale());
+        }
+    };
+    if (parallelProcessor_) {
+        parallelProcessor_->parallelFor(missing.size(), 1, offsetShapes);
+    } else {
+        offsetShapes(0, missing.size());
+    }
+
+    for (size_t k : missing) {
+        if (spaced[k].points.size() < 3) {
+            continue;
+        }
+        if (store) {
+            store->append(PersistentNFPStore::Key::spacing(geometry[k], offset < 0), {spaced[k]});
+        }
+        if (shapeCache_) {
+            shapeCache_->insertOffset(geometry[k], offset, curveTolerance, spaced[k]);
+        }
+    }
+    LOG_NESTING("Spaced " << firstShape.size() << " distinct shapes, "
+                << firstShape.size() - missing.size() << " from the caches");
+
+    // Each shape keeps its own attributes and takes the offset geometry
+    std::vector<Polygon> result(shapes.size());
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (quantities[i] <= 0) {
+            continue;
+        }
+        const Polygon& outline = spaced[distinctOf[i]];
+        result[i] = shapes[i];
+        result[i].points = outline.points;
+        result[i].children = outline.children;
+    }
+    return result;
+}
+
+void NestingEngine::fillHoles() {
+    // Hosts and members largest first
+    std::vector<size_t> order(parts_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return std::abs(parts_[a].area()) > std::abs(parts_[b].area());
+    });
+
+    // A worker of its own, so the pre-stage leaves no memo entries or recordings
+    PlacementWorker worker(config_, *nfpCalculator_);
+    worker.setRotationRetry(false);
+    const int steps = std::max(1, config_.rotations);
+
+    std::vector<char> member(parts_.size(), 0);
+    std::vector<char> host(parts_.size(), 0);
+    size_t members = 0;
+    for (size_t h : order) {
+        Polygon& part = parts_[h];
+        if (member[h] || part.children.empty()) {
+            continue;
+        }
+
+        std::vector<size_t> holes(part.children.size());
+        std::iota(holes.begin(), holes.end(), 0);
+        std::stable_sort(holes.begin(), holes.end(), [&part](size_t a, size_t b) {
+            return std::abs(part.children[a].area()) > std::abs(part.children[b].area());
+        });
+
+        std::vector<PlacementWorker::Placement> fills;
+        std::vector<char> filled(part.children.size(), 0);
+        for (size_t k : holes) {
+            // The hole as a sheet, wound like the part's outline
+            Polygon room = part.children[k];
+            room.children.clear();
+            if ((room.area() < 0) != (part.area() < 0)) {
+                std::reverse(room.points.begin(), room.points.end());
+            }
+            room.isSheet = true;
+            room.id = 0;
+            room.source = 0;
+            room.rotation = 0;
+            room.scaledPath.reset();
+            const HoleIndex::Extent space = HoleIndex::container(room);
+
+            // Area and inscribed circle do not depend on the rotation
+            std::vector<size_t> candidates;
+            for (size_t c : order) {
+                if (c == h || member[c] || host[c]) {
+                    continue;
+                }
+                const HoleIndex::Extent extent = HoleIndex::footprint(parts_[c]);
+                if (extent.area <= space.area && extent.inradius <= space.inradius) {
+                    candidates.push_back(c);
+                }
+            }
+
+            for (int step = 0; step < steps && !candidates.empty(); ++step) {
+                room.updateFingerprint();
+                room.updateCoordinates();
+
+                std::vector<Polygon> turned;
+                for (size_t c : candidates) {
+                    turned.push_back(parts_[c]);
+                    turned.back().rotation = step * 360.0 / steps;
+                }
+                const PlacementWorker::PlacementResult result = worker.placeParts({room}, turned);
+                if (result.placements.empty() || result.placements[0].empty()) {
+                    continue;
+                }
+
+                // Placed parts are obstacles for the next rotation step
+                for (const auto& placement : result.placements[0]) {
+                    auto it = std::find_if(candidates.begin(), candidates.end(),
+                                           [&](size_t c) { return parts_[c].id == placement.id; });
+                    Polygon placed = parts_[*it];
+                    placed.rotation = placement.rotation;
+                    placed = PlacementJob::rotated(placed).translate(placement.position.x, placement.position.y);
+                    placed.children.clear();
+                    placed.scaledPath.reset();
+                    if ((placed.area() < 0) == (room.area() < 0)) {
+                        std::reverse(placed.points.begin(), placed.points.end());
+                    }
+                    room.children.push_back(std::move(placed));
+
+                    member[*it] = 1;
+                    candidates.erase(it);
+                    fills.push_back(placement);
+                }
+                filled[k] = 1;
+            }
+        }
+
+        if (fills.empty()) {
+            continue;
+        }
+
+        // The composite keeps the holes nothing went into
+        std::vector<Polygon> open;
+        for (size_t k = 0; k < part.children.size(); ++k) {
+            if (!filled[k]) {
+                open.push_back(part.children[k]);
+            }
+        }
+        part.children = std::move(open);
+        part.updateFingerprint();
+        if (part.coarse) {
+            Polygon outline = part.conservativeOutline(config_.coarseScreeningTolerance,
+                                                       config_.getClipperScale());
+            if (!outline.points.empty()) {
+                outline.updateCoordinates();
+                outline.updateScaledPath(config_.clipperScale);
+                part.coarse = std::make_shared<const Polygon>(std::move(outline));
+            } else {
+                part.coarse.reset();
+            }
+        }
+
+        host[h] = 1;
+        members += fills.size();
+        holeFills_[part.id] = std::move(fills);
+    }
+
+    if (members == 0) {
+        return;
+    }
+    std::vector<Polygon> remaining;
+    for (size_t i = 0; i < parts_.size(); ++i) {
+        if (!member[i]) {
+            remaining.push_back(std::move(parts_[i]));
+        }
+    }
+    parts_ = std::move(remaining);
+    LOG_NESTING("Hole filling placed " << members << " parts in holes of " << holeFills_.size() << " parts");
+}
+
+void NestingEngine::expandHoleFills(std::vector<std::vector<PlacementWorker::Placement>>& placements) const {
+    if (holeFills_.empty()) {
+        return;
+    }
+    for (auto& sheet : placements) {
+        const size_t count = sheet.size();
+        for (size_t i = 0; i < count; ++i) {
+            auto it = holeFills_.find(sheet[i].id);
+            if (it == holeFills_.end()) {
+                continue;
+            }
+            const PlacementWorker::Placement composite = sheet[i];
+            const double rad = composite.rotation * M_PI / 180.0;
+            const double cosA = std::cos(rad);
+            const double sinA = std::sin(rad);
+            for (const auto& fill : it->second) {
+                const Point offset(fill.position.x * cosA - fill.position.y * sinA,
+                                   fill.position.x * sinA + fill.position.y * cosA);
+                sheet.emplace_back(Point(composite.position.x + offset.x, composite.position.y + offset.y),
+                                   fill.id, fill.source, std::fmod(composite.rotation + fill.rotation, 360.0));
+            }
+        }
+    }
+}
+
+PlacementWorker::PlacementResult NestingEngine::materialize(const Individual& individual) {
+    if (!placementWorker_) {
+        return PlacementWorker::PlacementResult();
+    }
+    return evaluateIndividual(individual, parts_, sheets_);
+}
+
 PlacementWorker::PlacementResult NestingEngine::evaluateIndividual(
-    Individual& individual,
+    const Individual& individual,
     const std::vector<Polygon>& parts,
     const std::vector<Polygon>& sheets
 ) {
@@ -537,6 +1266,7 @@ NestResult NestingEngine::toNestResult(
 ) const {
     NestResult nestResult;
     nestResult.placements = result.placements;
+    expandHoleFills(nestResult.placements);
     nestResult.fitness = result.fitness;
     nestResult.area = result.area;
     nestResult.mergedLength = result.mergedLength;
@@ -546,91 +1276,1471 @@ NestResult NestingEngine::toNestResult(
     return nestResult;
 }
 
-void NestingEngine::updateResults(const NestResult& result) {
+void NestingEngine::updateResults(const std::shared_ptr<const NestResult>& result) {
     // JavaScript: if(this.nests.length == 0 || this.nests[0].fitness > payload.fitness) {
     //               this.nests.unshift(payload);
     //               if(this.nests.length > 10) { this.nests.pop(); }
     //             }
 
-    // Insert result in sorted order (best first)
+    // Insert result in sorted order (best first), into a new history:
+    // readers may still hold the current one
+    auto results = std::make_shared<ResultHistory>(*results_);
     auto insertPos = std::lower_bound(
-        results_.begin(),
-        results_.end(),
+        results->begin(),
+        results->end(),
         result,
-        [](const NestResult& a, const NestResult& b) {
-            return a.fitness < b.fitness;
+        [](const std::shared_ptr<const NestResult>& a, const std::shared_ptr<const NestResult>& b) {
+            return a->fitness < b->fitness;
         }
     );
 
-    results_.insert(insertPos, result);
+    results->insert(insertPos, result);
+
+    if (results->front() == result && geneticAlgorithm_) {
+        const uint64_t assignment = sheetAssignment(*result);
+        if (assignment != assignment_) {
+            assignment_ = assignment;
+            assignmentGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+        }
+    }
 
     // Keep only top N results
-    if (results_.size() > MAX_SAVED_RESULTS) {
-        results_.resize(MAX_SAVED_RESULTS);
+    if (results->size() > MAX_SAVED_RESULTS) {
+        results->resize(MAX_SAVED_RESULTS);
     }
+    std::atomic_store(&results_, std::shared_ptr<const ResultHistory>(std::move(results)));
 }
 
-std::vector<NFPPair> NestingEngine::generateNFPPairs() {
-    // JavaScript reference: svgnest.js lines 287-310
-    
-    std::vector<NFPPair> pairs;
-    
-    if (sheets_.empty()) {
-        return pairs;
+std::shared_ptr<const FeasibleRotations> NestingEngine::computeFeasibleRotations() {
+    if (sheets_.empty() || config_.rotations <= 1) {
+        return nullptr;
     }
-    
-    const Polygon& binPolygon = sheets_[0];
-    auto& population = geneticAlgorithm_->getPopulation();
-    
-    // For each unevaluated individual
-    for (auto& individual : population) {
-        // Skip already evaluated or currently processing individuals
-        if (individual.hasValidFitness() || individual.processing) {
-            continue;
+
+    // One sheet per type; copies of a sheet share its fit
+    std::vector<const Polygon*> sheetTypes;
+    for (const auto& sheet : sheets_) {
+        if (std::none_of(sheetTypes.begin(), sheetTypes.end(),
+                         [&](const Polygon* type) { return type->source == sheet.source; })) {
+            sheetTypes.push_back(&sheet);
         }
-        
-        const auto& placelist = individual.placement;
-        const auto& rotations = individual.rotation;
-        
-        // For each part in the placement sequence
-        for (size_t i = 0; i < placelist.size(); ++i) {
-            const Polygon& part = *placelist[i];
-            double partRotation = rotations[i];
-            
-            // Inner NFP: part vs bin (JavaScript line 293)
-            std::vector<Polygon> cached;
-            if (!nfpCache_.find(binPolygon.id, part.id, 0.0, partRotation, cached, true)) {
-                NFPPair pair;
-                pair.A = binPolygon;
-                pair.B = part;
-                pair.inside = true;
-                pair.Arotation = 0.0;
-                pair.Brotation = partRotation;
-                pair.Asource = binPolygon.id;
-                pair.Bsource = part.id;
-                pairs.push_back(pair);
-            }
-            
-            // Outer NFP: part vs previously placed parts (JavaScript lines 300-309)
-            for (size_t j = 0; j < i; ++j) {
-                const Polygon& placed = *placelist[j];
-                double placedRotation = rotations[j];
-                
-                if (!nfpCache_.find(placed.id, part.id, placedRotation, partRotation, cached, false)) {
-                    NFPPair pair;
-                    pair.A = placed;
-                    pair.B = part;
-                    pair.inside = false;
-                    pair.Arotation = placedRotation;
-                    pair.Brotation = partRotation;
-                    pair.Asource = placed.id;
-                    pair.Bsource = part.id;
-                    pairs.push_back(pair);
-                }
+    }
+
+    // One part per shape; quantity copies share its rotations
+    std::unordered_map<uint64_t, size_t> shapeIndex;
+    std::vector<const Polygon*> shapes;
+    std::vector<size_t> partShape;
+    partShape.reserve(parts_.size());
+    for (const auto& part : parts_) {
+        const uint64_t key = NFPCalculator::shapeKey(part, part.source);
+        auto inserted = shapeIndex.emplace(key, shapes.size());
+        if (inserted.second) {
+            shapes.push_back(&part);
+        }
+        partShape.push_back(inserted.first->second);
+    }
+
+    const size_t steps = static_cast<size_t>(config_.rotations);
+    const double stepAngle = 360.0 / config_.rotations;
+
+    // fits[(shape * steps + step) * sheet types + sheet type]
+    std::vector<char> fits(shapes.size() * steps * sheetTypes.size(), 0);
+    NFPCalculator& calculator = *nfpCalculator_;
+    auto trial = [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            const size_t sheetType = t % sheetTypes.size();
+            const size_t step = (t / sheetTypes.size()) % steps;
+            const size_t shape = t / (sheetTypes.size() * steps);
+
+            Polygon part = *shapes[shape];
+            part.rotation = step * stepAngle;
+            try {
+                auto nfp = calculator.getInnerNFPShared(*sheetTypes[sheetType], PlacementJob::rotated(part));
+                fits[t] = nfp && !nfp->empty() && !nfp->front().points.empty();
+            } catch (const std::exception& e) {
+                LOG_NESTING("Inner NFP failed while checking rotations: " << e.what());
             }
         }
+    };
+    if (parallelProcessor_) {
+        parallelProcessor_->parallelFor(fits.size(), 1, trial);
+    } else {
+        trial(0, fits.size());
+    }
+
+    std::vector<std::vector<double>> shapeRotations(shapes.size());
+    for (size_t shape = 0; shape < shapes.size(); ++shape) {
+        std::vector<double> everywhere;
+        std::vector<double> anywhere;
+        for (size_t step = 0; step < steps; ++step) {
+            const auto first = fits.begin() + (shape * steps + step) * sheetTypes.size();
+            const auto last = first + sheetTypes.size();
+            if (std::all_of(first, last, [](char fit) { return fit != 0; })) {
+                everywhere.push_back(step * stepAngle);
+            }
+            if (std::any_of(first, last, [](char fit) { return fit != 0; })) {
+                anywhere.push_back(step * stepAngle);
+            }
+        }
+        shapeRotations[shape] = everywhere.empty() ? std::move(anywhere) : std::move(everywhere);
+    }
+
+    auto feasible = std::make_shared<FeasibleRotations>();
+    for (size_t i = 0; i < parts_.size(); ++i) {
+        const auto& rotations = shapeRotations[partShape[i]];
+        if (rotations.size() < steps) {
+            feasible->set(parts_[i].id, rotations);
+        }
+    }
+
+    LOG_NESTING("Restricted rotations of " << feasible->size() << " of " << parts_.size() << " parts");
+    if (feasible->size() == 0) {
+        return nullptr;
+    }
+    return feasible;
+}
+
+Individual* NestingEngine::bestEvaluated() {
+    Individual* best = nullptr;
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        for (auto& individual : geneticAlgorithm_->getIsland(k).getIndividuals()) {
+            if (individual.hasValidFitness() && !individual.coarse && !individual.bounded &&
+                !individual.isProcessing() && (!best || individual.fitness < best->fitness)) {
+                best = &individual;
+            }
+        }
+    }
+    return best;
+}
+
+uint64_t NestingEngine::sheetAssignment(const NestResult& result) {
+    // FNV-1a over each sheet's sorted sources, sheets in order
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+    std::vector<int> sources;
+    for (size_t i = 0; i < result.placements.size(); ++i) {
+        sources.clear();
+        for (const auto& placed : result.placements[i]) {
+            sources.push_back(placed.source);
+        }
+        std::sort(sources.begin(), sources.end());
+        mix(result.sheetIndex(i));
+        for (int source : sources) {
+            mix(static_cast<uint64_t>(static_cast<uint32_t>(source)));
+        }
+        mix(~uint64_t(0));
+    }
+    return hash;
+}
+
+bool NestingEngine::polish() {
+    if (!job_ || !parallelProcessor_) {
+        return false;
+    }
+
+    Individual* best = bestEvaluated();
+    if (!best || best->placement.size() < 2) {
+        return false;
+    }
+
+    struct Move {
+        std::vector<std::shared_ptr<Polygon>> placement;
+        std::vector<double> rotation;
+        std::vector<size_t> variants;
+        PlacementWorker::PlacementResult result;
+    };
+
+    const size_t genes = best->placement.size();
+    const double stepAngle = 360.0 / std::max(1, config_.rotations);
+    std::mt19937 rng(static_cast<unsigned int>(evaluationsCompleted_));
+    std::uniform_int_distribution<size_t> geneDist(0, genes - 1);
+    std::uniform_int_distribution<int> stepDist(0, std::max(1, config_.rotations) - 1);
+
+    std::vector<std::shared_ptr<Polygon>> placement = best->placement;
+    std::vector<double> rotation = best->rotation;
+    PlacementWorker::PlacementResult polished;
+    double fitness = best->fitness;
+    bool improved = false;
+    int rounds = 0;
+
+    for (;;) {
+        if (config_.timeoutSeconds > 0 && elapsedSeconds() >= config_.timeoutSeconds) {
+            break;
+        }
+
+        std::vector<Move> moves(static_cast<size_t>(config_.polishMoves));
+        for (auto& move : moves) {
+            move.placement = placement;
+            move.rotation = rotation;
+
+            const size_t from = geneDist(rng);
+            size_t to = geneDist(rng);
+            if (to == from) {
+                to = (from + 1) % genes;
+            }
+
+            switch (rng() % 3) {
+            case 0:
+                std::swap(move.placement[from], move.placement[to]);
+                std::swap(move.rotation[from], move.rotation[to]);
+                break;
+            case 1: {
+                auto part = move.placement[from];
+                const double angle = move.rotation[from];
+                move.placement.erase(move.placement.begin() + from);
+                move.rotation.erase(move.rotation.begin() + from);
+                move.placement.insert(move.placement.begin() + to, part);
+                move.rotation.insert(move.rotation.begin() + to, angle);
+                break;
+            }
+            default: {
+                const double angle = stepDist(rng) * stepAngle;
+                if (!feasibleRotations_ || feasibleRotations_->allows(move.placement[from]->id, angle)) {
+                    move.rotation[from] = angle;
+                }
+                break;
+            }
+            }
+
+            for (size_t j = 0; j < genes; ++j) {
+                const size_t variant = job_->variantIndex(move.placement[j]->id, move.rotation[j], false);
+                if (variant == PlacementJob::npos) {
+                    move.variants.clear();
+                    break;
+                }
+                move.variants.push_back(variant);
+            }
+        }
+
+        // Moves worse than the current fitness stop early at the cutoff
+        const CancellationToken token = parallelProcessor_->cancellationToken();
+        PlacementWorker& worker = *placementWorker_;
+        const std::shared_ptr<const PlacementJob> job = job_;
+        std::atomic<bool> cancelled(false);
+        parallelProcessor_->parallelFor(moves.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m) {
+                if (moves[m].variants.empty()) {
+                    continue;
+                }
+                try {
+                    moves[m].result = worker.placeParts(*job, moves[m].variants, fitness, token);
+                } catch (const OperationCancelled&) {
+                    cancelled = true;
+                    moves[m].variants.clear();
+                } catch (const std::exception& e) {
+                    LOG_NESTING("Local search move failed: " << e.what());
+                    moves[m].variants.clear();
+                }
+            }
+        });
+        if (cancelled) {
+            break;
+        }
+
+        Move* chosen = nullptr;
+        for (auto& move : moves) {
+            if (!move.variants.empty() && !move.result.bounded && move.result.fitness < fitness &&
+                (!chosen || move.result.fitness < chosen->result.fitness)) {
+                chosen = &move;
+            }
+        }
+        if (!chosen) {
+            break;
+        }
+
+        placement = std::move(chosen->placement);
+        rotation = std::move(chosen->rotation);
+        polished = std::move(chosen->result);
+        fitness = polished.fitness;
+        improved = true;
+        rounds++;
+    }
+
+    LOG_NESTING("Local search: " << rounds << " improving rounds, fitness " << best->fitness << " -> " << fitness);
+    if (!improved) {
+        return false;
+    }
+
+    best->placement = std::move(placement);
+    best->rotation = std::move(rotation);
+    best->fitness = polished.fitness;
+    best->area = polished.area;
+    best->mergedLength = polished.mergedLength;
+    best->placements = polished.placements;
+
+    if (bestFitness() > polished.fitness) {
+        auto result = std::make_shared<const NestResult>(
+            toNestResult(polished, geneticAlgorithm_->getCurrentGeneration(), -1));
+        updateResults(result);
+        lastImprovementGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+
+        if (resultCallback_) {
+            resultCallback_(*result);
+        }
+    }
+    return true;
+}
+
+bool NestingEngine::decompose() {
+    if (!job_ || !parallelProcessor_) {
+        return false;
+    }
+
+    Individual* best = bestEvaluated();
+    if (!best) {
+        return false;
+    }
+
+    const CancellationToken token = parallelProcessor_->cancellationToken();
+    PlacementWorker& worker = *placementWorker_;
+    const std::shared_ptr<const PlacementJob> job = job_;
+    auto variantsOf = [&job](const Individual& individual, std::vector<size_t>& variants) {
+        variants.clear();
+        for (size_t j = 0; j < individual.placement.size(); ++j) {
+            const size_t variant = job->variantIndex(individual.placement[j]->id, individual.rotation[j], false);
+            if (variant == PlacementJob::npos) {
+                return false;
+            }
+            variants.push_back(variant);
+        }
+        return true;
+    };
+
+    // The sheets the best individual fills, and the genes on each
+    std::vector<size_t> variants;
+    PlacementWorker::PlacementResult whole;
+    if (!variantsOf(*best, variants)) {
+        return false;
+    }
+    try {
+        whole = worker.placeParts(*job, variants, std::numeric_limits<double>::infinity(), token);
+    } catch (const OperationCancelled&) {
+        return false;
+    }
+    if (whole.placements.size() < 2 || !whole.unplacedParts.empty()) {
+        return false;
+    }
+
+    struct SubNest {
+        size_t index;  // Of the sheet in the job
+        std::vector<Polygon> sheet;
+        Population population;
+        PlacementWorker::PlacementResult best;  // Best layout placing every part
+        bool found = false;
+
+        SubNest(const DeepNestConfig& config, unsigned int seed) : population(config, seed) {}
+    };
+
+    std::unordered_map<int, size_t> geneOf;
+    for (size_t j = 0; j < best->placement.size(); ++j) {
+        geneOf[best->placement[j]->id] = j;
+    }
+    std::vector<SubNest> nests;
+    nests.reserve(whole.placements.size());
+    for (size_t s = 0; s < whole.placements.size(); ++s) {
+        if (whole.placements[s].empty()) {
+            continue;
+        }
+        Individual adam;
+        for (const auto& placed : whole.placements[s]) {
+            const size_t gene = geneOf.at(placed.id);
+            adam.placement.push_back(best->placement[gene]);
+            adam.rotation.push_back(best->rotation[gene]);
+        }
+        nests.emplace_back(config_, static_cast<unsigned int>(config_.randomSeed + s));
+        nests.back().index = s;
+        nests.back().sheet.push_back(job->sheets()[s]);
+        nests.back().population.setFeasibleRotations(feasibleRotations_);
+        nests.back().population.seed(adam);
+    }
+
+    int generations = 0;
+    for (; generations < config_.sheetDecompositionGenerations; ++generations) {
+        if (config_.timeoutSeconds > 0 && elapsedSeconds() >= config_.timeoutSeconds) {
+            break;
+        }
+        if (generations > 0) {
+            for (auto& nest : nests) {
+                nest.population.nextGeneration();
+            }
+        }
+
+        // The individuals of every sub-nest waiting for evaluation, placed
+        // together so that all sheets progress at once
+        std::vector<std::pair<size_t, size_t>> pending;
+        for (size_t s = 0; s < nests.size(); ++s) {
+            const auto& individuals = nests[s].population.getIndividuals();
+            for (size_t i = 0; i < individuals.size(); ++i) {
+                if (!individuals[i].hasValidFitness()) {
+                    pending.emplace_back(s, i);
+                }
+            }
+        }
+
+        std::vector<PlacementWorker::PlacementResult> results(pending.size());
+        std::vector<char> complete(pending.size(), 0);
+        std::atomic<bool> cancelled(false);
+        parallelProcessor_->parallelFor(pending.size(), 1, [&](size_t begin, size_t end) {
+            std::vector<size_t> genes;
+            for (size_t p = begin; p < end; ++p) {
+                SubNest& nest = nests[pending[p].first];
+                const Individual& individual = nest.population.getIndividuals()[pending[p].second];
+                if (!variantsOf(individual, genes)) {
+                    continue;
+                }
+                try {
+                    results[p] = worker.placeParts(*job, nest.sheet, genes,
+                                                   std::numeric_limits<double>::infinity(), token);
+                    complete[p] = 1;
+                } catch (const OperationCancelled&) {
+                    cancelled = true;
+                } catch (const std::exception& e) {
+                    LOG_NESTING("Sheet sub-nest evaluation failed: " << e.what());
+                }
+            }
+        });
+        if (cancelled) {
+            break;
+        }
+
+        for (size_t p = 0; p < pending.size(); ++p) {
+            SubNest& nest = nests[pending[p].first];
+            Individual& individual = nest.population.getIndividuals()[pending[p].second];
+            if (!complete[p]) {
+                // Never chosen, and not evaluated again
+                individual.fitness = std::numeric_limits<double>::max() / 2;
+                continue;
+            }
+            const PlacementWorker::PlacementResult& result = results[p];
+            individual.fitness = result.fitness;
+            individual.area = result.area;
+            individual.mergedLength = result.mergedLength;
+            if (result.unplacedParts.empty() && result.placements.size() == 1 &&
+                (!nest.found || result.fitness < nest.best.fitness)) {
+                nest.best = result;
+                nest.found = true;
+            }
+        }
+    }
+
+    // Sheets no part fits on stay empty
+    PlacementWorker::PlacementResult combined;
+    combined.placements.resize(whole.placements.size());
+    for (const auto& nest : nests) {
+        if (!nest.found) {
+            return false;
+        }
+        combined.placements[nest.index] = nest.best.placements.front();
+        combined.fitness += nest.best.fitness;
+        combined.area += nest.best.area;
+        combined.mergedLength += nest.best.mergedLength;
+    }
+
+    LOG_NESTING("Sheet decomposition: " << nests.size() << " sub-nests, " << generations
+                << " generations, fitness " << best->fitness << " -> " << combined.fitness);
+    if (combined.fitness >= bestFitness()) {
+        return false;
+    }
+
+    auto result = std::make_shared<const NestResult>(
+        toNestResult(combined, geneticAlgorithm_->getCurrentGeneration(), -1));
+    updateResults(result);
+    lastImprovementGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+    if (resultCallback_) {
+        resultCallback_(*result);
+    }
+    return true;
+}
+
+void NestingEngine::seed(const std::vector<std::pair<int, double>>& genes) {
+    if (!geneticAlgorithm_) {
+        throw std::runtime_error("Must call initialize() before seed()");
+    }
+
+    // Copies of each part, last one first
+    std::unordered_map<int, std::vector<std::shared_ptr<Polygon>>> copies;
+    for (auto it = partPointers_.rbegin(); it != partPointers_.rend(); ++it) {
+        copies[(*it)->source].push_back(*it);
+    }
+
+    const int steps = std::max(1, config_.rotations);
+    const double step = 360.0 / steps;
+    std::mt19937 rng(config_.randomSeed);
+    auto angle = [&](const Polygon& part, double rotation) {
+        const long k = ((std::lround(rotation / step) % steps) + steps) % steps;
+        const double snapped = k * step;
+        if (!feasibleRotations_ || feasibleRotations_->allows(part.id, snapped)) {
+            return snapped;
+        }
+        return feasibleRotations_->sample(part.id, steps, rng);
+    };
+
+    Individual adam;
+    std::unordered_set<const Polygon*> named;
+    for (const auto& gene : genes) {
+        auto it = copies.find(gene.first);
+        if (it == copies.end() || it->second.empty()) {
+            continue;
+        }
+        adam.placement.push_back(it->second.back());
+        adam.rotation.push_back(angle(*it->second.back(), gene.second));
+        named.insert(it->second.back().get());
+        it->second.pop_back();
+    }
+
+    // Parts new to this nest, in the GA's order
+    for (const auto& part : partPointers_) {
+        if (!named.count(part.get())) {
+            adam.placement.push_back(part);
+            adam.rotation.push_back(angle(*part, 0.0));
+        }
+    }
+
+    geneticAlgorithm_->seed(adam);
+    LOG_NESTING("Seeded populations from a genome of " << genes.size() << " genes, "
+                << adam.placement.size() << " parts");
+}
+
+void NestingEngine::buildSheetOrders() {
+    sheetOrders_.clear();
+    orderedSheets_.clear();
+    if (!config_.sheetOrderSearch || !job_) {
+        return;
+    }
+
+    // Sheet types in order of first use
+    const std::vector<Polygon>& sheets = job_->sheets();
+    std::vector<uint64_t> typeOf(sheets.size());
+    std::vector<uint64_t> types;
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        typeOf[i] = NFPCalculator::shapeKey(sheets[i], sheets[i].source);
+        if (std::find(types.begin(), types.end(), typeOf[i]) == types.end()) {
+            types.push_back(typeOf[i]);
+        }
+    }
+    if (types.size() < 2) {
+        return;
+    }
+
+    std::vector<size_t> given(sheets.size());
+    std::iota(given.begin(), given.end(), size_t(0));
+    std::vector<std::vector<size_t>> orders;
+
+    // Each type first, the others after it as given
+    for (uint64_t type : types) {
+        std::vector<size_t> order = given;
+        std::stable_partition(order.begin(), order.end(), [&](size_t i) { return typeOf[i] == type; });
+        orders.push_back(std::move(order));
+    }
+
+    // Smallest and largest sheets first
+    auto area = [&sheets](size_t i) { return std::abs(sheets[i].area()); };
+    std::vector<size_t> ascending = given;
+    std::stable_sort(ascending.begin(), ascending.end(),
+                     [&](size_t a, size_t b) { return area(a) < area(b); });
+    std::vector<size_t> descending = given;
+    std::stable_sort(descending.begin(), descending.end(),
+                     [&](size_t a, size_t b) { return area(a) > area(b); });
+    orders.push_back(std::move(ascending));
+    orders.push_back(std::move(descending));
+
+    for (auto& order : orders) {
+        if (order == given || std::find(sheetOrders_.begin(), sheetOrders_.end(), order) != sheetOrders_.end()) {
+            continue;
+        }
+        std::vector<Polygon> ordered;
+        ordered.reserve(order.size());
+        for (size_t i : order) {
+            ordered.push_back(sheets[i]);
+        }
+        orderedSheets_.push_back(std::move(ordered));
+        sheetOrders_.push_back(std::move(order));
+    }
+    LOG_NESTING("Sheet order search: " << types.size() << " sheet types, "
+                << sheetOrders_.size() << " alternative orders");
+}
+
+void NestingEngine::searchSheetOrders(const Individual& individual, const NestResult& found) {
+    if (!job_ || !parallelProcessor_) {
+        return;
+    }
+
+    std::vector<size_t> variants;
+    variants.reserve(individual.placement.size());
+    for (size_t j = 0; j < individual.placement.size(); ++j) {
+        const size_t variant = job_->variantIndex(individual.placement[j]->id, individual.rotation[j], false);
+        if (variant == PlacementJob::npos) {
+            return;
+        }
+        variants.push_back(variant);
+    }
+
+    // Orders worse than the result stop early at its fitness. The part
+    // NFPs are the ones the result used; only inner NFPs of a sheet type
+    // may be new.
+    std::vector<PlacementWorker::PlacementResult> results(sheetOrders_.size());
+    std::vector<char> complete(sheetOrders_.size(), 0);
+    const CancellationToken token = parallelProcessor_->cancellationToken();
+    PlacementWorker& worker = *placementWorker_;
+    const std::shared_ptr<const PlacementJob> job = job_;
+    parallelProcessor_->parallelFor(sheetOrders_.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t o = begin; o < end; ++o) {
+            try {
+                results[o] = worker.placeParts(*job, orderedSheets_[o], variants, found.fitness, token);
+                complete[o] = !results[o].bounded;
+            } catch (const OperationCancelled&) {
+            } catch (const std::exception& e) {
+                LOG_NESTING("Sheet order evaluation failed: " << e.what());
+            }
+        }
+    });
+
+    size_t chosen = sheetOrders_.size();
+    double fitness = found.fitness;
+    for (size_t o = 0; o < sheetOrders_.size(); ++o) {
+        if (complete[o] && results[o].fitness < fitness) {
+            chosen = o;
+            fitness = results[o].fitness;
+        }
+    }
+    if (chosen == sheetOrders_.size()) {
+        return;
+    }
+
+    auto result = std::make_shared<NestResult>(
+        toNestResult(results[chosen], found.generation, found.individualIndex));
+    const std::vector<size_t>& order = sheetOrders_[chosen];
+    result->sheets.assign(order.begin(), order.begin() + std::min(order.size(), result->placements.size()));
+    LOG_NESTING("Sheet order " << chosen << " improves fitness " << found.fitness << " -> " << fitness);
+
+    updateResults(result);
+    if (resultCallback_) {
+        resultCallback_(*result);
+    }
+}
+
+int NestingEngine::generationLimit() const {
+    if (maxGenerations_ > 0 && config_.maxIterations > 0) {
+        return std::min(maxGenerations_, config_.maxIterations);
+    }
+    return std::max(maxGenerations_, std::max(config_.maxIterations, 0));
+}
+
+double NestingEngine::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count();
+}
+
+bool NestingEngine::budgetExhausted() const {
+    const int generation = geneticAlgorithm_->getCurrentGeneration();
+
+    const int limit = generationLimit();
+    if (limit > 0 && generation >= limit) {
+        return true;
+    }
+
+    if (config_.timeoutSeconds > 0 && elapsedSeconds() >= config_.timeoutSeconds) {
+        return true;
+    }
+
+    if (config_.stopAtSheetBound && !results_->empty() && meetsSheetLowerBound(*results_->front())) {
+        return true;
+    }
+
+    // The sheet sub-nests take over once the sheets hold the same parts;
+    // while parts are left over there is nothing to hand them, so the GA
+    // goes on
+    if (config_.sheetDecompositionGenerations > 0 && config_.sheetDecompositionStall > 0 &&
+        !results_->empty() && generation - assignmentGeneration_ >= config_.sheetDecompositionStall &&
+        decomposable(*results_->front())) {
+        return true;
+    }
+
+    return config_.stallGenerations > 0 &&
+           generation - lastImprovementGeneration_ >= config_.stallGenerations;
+}
+
+bool NestingEngine::decomposable(const NestResult& result) const {
+    size_t placed = 0;
+    size_t used = 0;
+    for (const auto& sheet : result.placements) {
+        placed += sheet.size();
+        used += sheet.empty() ? 0 : 1;
+    }
+    return placed == partCount_ && used >= 2;
+}
+
+size_t NestingEngine::computeSheetLowerBound() const {
+    if (parts_.empty() || sheets_.empty()) {
+        return 0;
+    }
+
+    std::vector<double> sheetAreas;
+    std::vector<HoleIndex::Extent> rooms;
+    std::vector<double> diagonals;
+    for (const auto& sheet : sheets_) {
+        sheetAreas.push_back(netArea(sheet));
+        rooms.push_back(HoleIndex::container(sheet));
+        diagonals.push_back(std::hypot(rooms.back().width, rooms.back().height));
+    }
+    std::sort(sheetAreas.begin(), sheetAreas.end(), std::greater<double>());
+
+    // Tests that hold at every rotation: area, inscribed circle, and the
+    // part's shorter side against the sheet's diagonal
+    double partArea = 0.0;
+    size_t exclusive = 0;
+    for (const auto& part : parts_) {
+        const HoleIndex::Extent extent = HoleIndex::footprint(part);
+        const BoundingBox box = part.bounds();
+        bool fits = false;
+        for (size_t s = 0; s < sheets_.size() && !fits; ++s) {
+            fits = extent.area <= rooms[s].area && extent.inradius <= rooms[s].inradius &&
+                   std::min(box.width, box.height) <= diagonals[s];
+        }
+        if (!fits) {
+            return 0;
+        }
+
+        const double area = netArea(part);
+        partArea += area;
+        if (area > 0.5 * sheetAreas.front()) {
+            exclusive++;
+        }
+    }
+
+    size_t sheets = 0;
+    double covered = 0.0;
+    while (sheets < sheetAreas.size() && covered < partArea * (1.0 - 1e-9)) {
+        covered += sheetAreas[sheets++];
+    }
+    if (covered < partArea * (1.0 - 1e-9) || exclusive > sheetAreas.size()) {
+        return 0;
+    }
+    return std::max(sheets, exclusive);
+}
+
+bool NestingEngine::meetsSheetLowerBound(const NestResult& result) const {
+    if (sheetLowerBound_ == 0) {
+        return false;
+    }
+    size_t placed = 0;
+    size_t used = 0;
+    for (const auto& sheet : result.placements) {
+        placed += sheet.size();
+        used += sheet.empty() ? 0 : 1;
+    }
+    return placed == partCount_ && used <= sheetLowerBound_;
+}
+
+uint64_t NestingEngine::checkpointFingerprint() const {
+    uint64_t hash = fnv1a(nullptr, 0);
+    for (const auto& part : parts_) {
+        hash = fnv1a(&part.fingerprint, sizeof(part.fingerprint), hash);
+        hash = fnv1a(&part.id, sizeof(part.id), hash);
+    }
+    for (const auto& sheet : sheets_) {
+        hash = fnv1a(&sheet.fingerprint, sizeof(sheet.fingerprint), hash);
+    }
+    // Settings the stored genomes and fitness values depend on
+    const int32_t settings[] = {config_.rotations, config_.populationSize, config_.islands,
+                                config_.mergeLines ? 1 : 0, config_.feasibleRotations ? 1 : 0};
+    hash = fnv1a(settings, sizeof(settings), hash);
+    return fnv1a(config_.placementType.data(), config_.placementType.size(), hash);
+}
+
+void NestingEngine::checkpointIfDue(bool force) {
+    if (config_.checkpointPath.empty() || !geneticAlgorithm_) {
+        return;
+    }
+    const int generation = geneticAlgorithm_->getCurrentGeneration();
+    if (!force && generation - lastCheckpointGeneration_ < std::max(1, config_.checkpointGenerations)) {
+        return;
+    }
+
+    // A full disk must not end the run; the previous checkpoint stays valid
+    try {
+        saveCheckpoint(config_.checkpointPath);
+        lastCheckpointGeneration_ = generation;
+        LOG_NESTING("Checkpoint at generation " << generation << " written to " << config_.checkpointPath);
+    } catch (const std::exception& e) {
+        LOG_NESTING("Checkpoint failed: " << e.what());
+    }
+}
+
+void NestingEngine::saveCheckpoint(const std::string& path) const {
+    if (!geneticAlgorithm_) {
+        throw std::runtime_error("Must call initialize() before saveCheckpoint()");
+    }
+
+    CheckpointWriter out;
+    out.data.append(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    out.put(CHECKPOINT_VERSION);
+    out.put(checkpointFingerprint());
+    out.put(static_cast<uint32_t>(geneticAlgorithm_->getIslandCount()));
+    out.put(static_cast<int32_t>(lastImprovementGeneration_));
+    out.put(static_cast<int32_t>(evaluationsCompleted_));
+
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        const Population& island = geneticAlgorithm_->getIsland(k);
+        const IslandDetail detail = k < islandDetail_.size() ? islandDetail_[k] : IslandDetail();
+        out.put(static_cast<int32_t>(geneticAlgorithm_->getIslandGeneration(k)));
+        out.put(static_cast<uint64_t>(geneticAlgorithm_->getIslandOffspring(k)));
+        out.putString(island.getGeneratorState());
+        out.put(detail.bestFitness);
+        out.put(static_cast<int32_t>(detail.stalledGenerations));
+        out.put(static_cast<uint8_t>(detail.fullResolution));
+
+        out.put(static_cast<uint32_t>(island.size()));
+        for (const auto& individual : island.getIndividuals()) {
+            // Only collected evaluations count; running ones start over
+            const bool evaluated = individual.hasValidFitness() && !individual.isProcessing();
+            out.put(static_cast<uint32_t>(individual.placement.size()));
+            for (size_t i = 0; i < individual.placement.size(); ++i) {
+                out.put(static_cast<int32_t>(individual.placement[i]->id));
+                out.put(i < individual.rotation.size() ? individual.rotation[i] : 0.0);
+            }
+            out.put(evaluated ? individual.fitness : std::numeric_limits<double>::max());
+            out.put(evaluated ? individual.area : 0.0);
+            out.put(evaluated ? individual.mergedLength : 0.0);
+            out.put(static_cast<uint8_t>((individual.coarse ? 1 : 0) | (evaluated && individual.bounded ? 2 : 0)));
+        }
+    }
+
+    out.put(static_cast<uint32_t>(results_->size()));
+    for (const auto& entry : *results_) {
+        const NestResult& result = *entry;
+        out.put(result.fitness);
+        out.put(result.area);
+        out.put(result.mergedLength);
+        out.put(static_cast<int32_t>(result.generation));
+        out.put(static_cast<int32_t>(result.individualIndex));
+        out.put(static_cast<uint32_t>(result.placements.size()));
+        for (const auto& sheet : result.placements) {
+            out.put(static_cast<uint32_t>(sheet.size()));
+            for (const auto& placement : sheet) {
+                out.put(placement.position.x);
+                out.put(placement.position.y);
+                out.put(static_cast<int32_t>(placement.id));
+                out.put(static_cast<int32_t>(placement.source));
+                out.put(placement.rotation);
+            }
+        }
+        out.put(static_cast<uint32_t>(result.sheets.size()));
+        for (size_t sheet : result.sheets) {
+            out.put(static_cast<uint32_t>(sheet));
+        }
+    }
+    out.put(fnv1a(out.data.data(), out.data.size()));
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(out.data.data(), static_cast<std::streamsize>(out.data.size()));
+        if (!file.flush()) {
+            throw std::runtime_error("Cannot write checkpoint: " + temporary);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot replace checkpoint " + path + ": " + ec.message());
+    }
+}
+
+bool NestingEngine::loadCheckpoint(const std::string& path) {
+    if (!geneticAlgorithm_) {
+        throw std::runtime_error("Must call initialize() before loadCheckpoint()");
+    }
+    if (running_) {
+        throw std::runtime_error("Cannot load a checkpoint while nesting is running");
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const size_t header = sizeof(CHECKPOINT_MAGIC) + sizeof(uint32_t) + sizeof(uint64_t);
+    uint64_t checksum = 0;
+    if (data.size() < header + sizeof(checksum) ||
+        std::memcmp(data.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        LOG_NESTING("Not a checkpoint: " << path);
+        return false;
+    }
+    const size_t payload = data.size() - sizeof(checksum);
+    std::memcpy(&checksum, data.data() + payload, sizeof(checksum));
+    if (checksum != fnv1a(data.data(), payload)) {
+        LOG_NESTING("Damaged checkpoint: " << path);
+        return false;
+    }
+
+    CheckpointReader in(data.data() + sizeof(CHECKPOINT_MAGIC), payload - sizeof(CHECKPOINT_MAGIC));
+    if (in.get<uint32_t>() != CHECKPOINT_VERSION || in.get<uint64_t>() != checkpointFingerprint() ||
+        in.get<uint32_t>() != geneticAlgorithm_->getIslandCount()) {
+        LOG_NESTING("Checkpoint " << path << " belongs to another job");
+        return false;
+    }
+
+    // Genomes refer to parts by id
+    std::unordered_map<int, std::shared_ptr<Polygon>> partsById;
+    for (const auto& part : partPointers_) {
+        partsById[part->id] = part;
+    }
+
+    // Decoded in full before anything is replaced
+    struct IslandState {
+        int generation;
+        size_t offspring;
+        std::string generator;
+        IslandDetail detail;
+        std::vector<Individual> individuals;
+    };
+    const int lastImprovement = in.get<int32_t>();
+    const int evaluations = in.get<int32_t>();
+    std::vector<IslandState> islands(geneticAlgorithm_->getIslandCount());
+    for (auto& island : islands) {
+        island.generation = in.get<int32_t>();
+        island.offspring = static_cast<size_t>(in.get<uint64_t>());
+        island.generator = in.getString();
+        island.detail.bestFitness = in.get<double>();
+        island.detail.stalledGenerations = in.get<int32_t>();
+        island.detail.fullResolution = in.get<uint8_t>() != 0;
+
+        const uint32_t count = in.getCount(sizeof(uint32_t));
+        island.individuals.resize(count);
+        for (auto& individual : island.individuals) {
+            const uint32_t genes = in.getCount(sizeof(int32_t) + sizeof(double));
+            if (genes != partPointers_.size()) {
+                return false;
+            }
+            for (uint32_t i = 0; i < genes; ++i) {
+                const auto part = partsById.find(in.get<int32_t>());
+                if (part == partsById.end()) {
+                    return false;
+                }
+                individual.placement.push_back(part->second);
+                individual.rotation.push_back(in.get<double>());
+            }
+            individual.fitness = in.get<double>();
+            individual.area = in.get<double>();
+            individual.mergedLength = in.get<double>();
+            const uint8_t flags = in.get<uint8_t>();
+            individual.coarse = (flags & 1) != 0;
+            individual.bounded = (flags & 2) != 0;
+        }
+    }
+
+    std::vector<NestResult> results(in.getCount(5 * sizeof(double)));
+    for (auto& result : results) {
+        result.fitness = in.get<double>();
+        result.area = in.get<double>();
+        result.mergedLength = in.get<double>();
+        result.generation = in.get<int32_t>();
+        result.individualIndex = in.get<int32_t>();
+        result.placements.resize(in.getCount(sizeof(uint32_t)));
+        for (auto& sheet : result.placements) {
+            sheet.resize(in.getCount(3 * sizeof(double) + 2 * sizeof(int32_t)));
+            for (auto& placement : sheet) {
+                const double x = in.get<double>();
+                const double y = in.get<double>();
+                placement.position = Point(x, y);
+                placement.id = in.get<int32_t>();
+                placement.source = in.get<int32_t>();
+                placement.rotation = in.get<double>();
+            }
+        }
+        result.sheets.resize(in.getCount(sizeof(uint32_t)));
+        for (auto& sheet : result.sheets) {
+            sheet = in.get<uint32_t>();
+        }
+    }
+    if (!in.ok() || !in.atEnd()) {
+        LOG_NESTING("Damaged checkpoint: " << path);
+        return false;
+    }
+
+    islandDetail_.clear();
+    for (size_t k = 0; k < islands.size(); ++k) {
+        Population& population = geneticAlgorithm_->getIsland(k);
+        population.setGeneratorState(islands[k].generator);
+        population.getIndividuals() = std::move(islands[k].individuals);
+        geneticAlgorithm_->restoreIsland(k, islands[k].generation, islands[k].offspring);
+        islandDetail_.push_back(islands[k].detail);
+    }
+    auto history = std::make_shared<ResultHistory>();
+    for (auto& result : results) {
+        history->push_back(std::make_shared<const NestResult>(std::move(result)));
+    }
+    std::atomic_store(&results_, std::shared_ptr<const ResultHistory>(std::move(history)));
+    lastImprovementGeneration_ = lastImprovement;
+    evaluationsCompleted_ = evaluations;
+    lastCheckpointGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+    resumed_ = true;
+
+    LOG_NESTING("Resumed from checkpoint " << path << " at generation " << lastCheckpointGeneration_
+                << " with " << results_->size() << " results");
+    return true;
+}
+
+void NestingEngine::collectEvaluations() {
+    // Results are compared against the best of every island
+    size_t offset = 0;
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        auto& population = geneticAlgorithm_->getIsland(k).getIndividuals();
+        for (size_t i = 0; i < population.size(); ++i) {
+            Individual& individual = population[i];
+            if (individual.state() != EvaluationState::DONE) {
+                continue;
+            }
+
+            // Screening evaluations only rank individuals, they are never reported.
+            // JavaScript: if(this.nests.length == 0 || this.nests[0].fitness > payload.fitness)
+            const PlacementWorker::PlacementResult& done = individual.evaluation->result;
+            const bool contender = !individual.coarse && !done.bounded &&
+                bestFitness() > done.fitness;
+
+            // Everyone else keeps fitness and genome only; see materialize()
+            individual.collect(contender);
+            evaluationsCompleted_++;
+
+            // Calibrate the screening estimate against real fitness
+            if (surrogate_ && !individual.coarse && !individual.bounded) {
+                surrogate_->observe(individual);
+            }
+
+            if (contender) {
+                auto result = std::make_shared<NestResult>();
+                result->fitness = individual.fitness;
+                result->generation = geneticAlgorithm_->getIslandGeneration(k);
+                result->individualIndex = static_cast<int>(offset + i);
+                result->area = individual.area;
+                result->mergedLength = individual.mergedLength;
+                result->placements = individual.placements;
+                expandHoleFills(result->placements);
+
+                updateResults(result);
+                lastImprovementGeneration_ = geneticAlgorithm_->getCurrentGeneration();
+
+                if (resultCallback_) {
+                    resultCallback_(*result);
+                }
+                if (!sheetOrders_.empty()) {
+                    searchSheetOrders(individual, *result);
+                }
+            }
+        }
+        offset += population.size();
+    }
+}
+
+void NestingEngine::enforceMemoryLimit() {
+    if (config_.memoryLimitMB <= 0) {
+        return;
+    }
+
+    MemoryUsage usage = getMemoryUsage();
+    if (usage.totalBytes() <= usage.limitBytes) {
+        return;
+    }
+
+    size_t others = usage.totalBytes() - usage.nfpCacheBytes;
+    if (others >= usage.limitBytes && fitnessMemo_) {
+        // Memoized results are only a shortcut; drop them before the cache
+        const size_t memoBytes = fitnessMemo_->statistics().bytes;
+        fitnessMemo_->clear();
+        others -= std::min(others, memoBytes);
+    }
+
+    // Leave the cache what the rest does not use, with a floor so that
+    // placement still finds recent NFPs cached
+    const size_t budget = std::max(others < usage.limitBytes ? usage.limitBytes - others : 0,
+                                   usage.limitBytes / 16);
+    NFPCache& cache = sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_;
+    if (usage.nfpCacheLimitBytes == 0 || budget < usage.nfpCacheLimitBytes) {
+        LOG_MEMORY("Memory ceiling " << usage.limitBytes << " B exceeded (" << usage.totalBytes()
+                   << " B): NFP cache budget " << usage.nfpCacheLimitBytes << " -> " << budget << " B");
+        cache.setMemoryLimit(budget);
+    }
+}
+
+void NestingEngine::markGenerationStages() {
+    const StageTimes now = StageTimer::snapshot();
+    generationStages_ = now - generationStageBaseline_;
+    generationStageBaseline_ = now;
+}
+
+void NestingEngine::adaptThreads() {
+    if (!threadController_ || !parallelProcessor_) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const ParallelProcessor::TaskTimes tasks = parallelProcessor_->taskTimes();
+    ThreadCountController::Sample sample;
+    sample.evaluations = static_cast<size_t>(std::max(0, evaluationsCompleted_ - threadSampleEvaluations_));
+    sample.seconds = std::chrono::duration<double>(now - threadSampleTime_).count();
+    sample.busySeconds = tasks.wallSeconds - threadSampleTasks_.wallSeconds;
+    sample.cpuSeconds = tasks.cpuSeconds - threadSampleTasks_.cpuSeconds;
+    threadSampleEvaluations_ = evaluationsCompleted_;
+    threadSampleTime_ = now;
+    threadSampleTasks_ = tasks;
+
+    const int before = parallelProcessor_->getActiveThreads();
+    const int level = threadController_->update(sample);
+    if (level != before) {
+        LOG_NESTING("Threads " << before << " -> " << level << " at "
+                    << threadController_->throughput() << " evaluations/s (off-CPU "
+                    << threadController_->offCpu() << ", CPU per evaluation x"
+                    << threadController_->cpuInflation() << ")");
+        parallelProcessor_->setActiveThreads(level);
+    }
+}
+
+void NestingEngine::markScreening() {
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        const bool screening = config_.coarseScreeningGenerations < 0
+            ? k < islandDetail_.size() && !islandDetail_[k].fullResolution
+            : geneticAlgorithm_->getIslandGeneration(k) < config_.coarseScreeningGenerations;
+
+        for (auto& individual : geneticAlgorithm_->getIsland(k).getIndividuals()) {
+            if (!individual.hasValidFitness() && !individual.isProcessing()) {
+                individual.coarse = screening;
+            }
+        }
+    }
+}
+
+Individual NestingEngine::greedyIndividual() const {
+    const int steps = std::max(1, config_.rotations);
+    const BoundingBox sheet = sheets_[0].bounds();
+
+    Individual greedy;
+    std::unordered_map<int, double> chosen;  // By part source
+    for (const auto& part : partPointers_) {
+        auto it = chosen.find(part->source);
+        if (it == chosen.end()) {
+            double best = 0.0;
+            double bestArea = std::numeric_limits<double>::max();
+            double bestWidth = std::numeric_limits<double>::max();
+            for (int k = 0; k < steps; ++k) {
+                const double rotation = k * 360.0 / steps;
+                if (feasibleRotations_ && !feasibleRotations_->allows(part->id, rotation)) {
+                    continue;
+                }
+                const BoundingBox box = part->rotate(rotation).bounds();
+                const bool fits = box.width <= sheet.width && box.height <= sheet.height;
+                const double area = fits ? box.width * box.height : std::numeric_limits<double>::max();
+                if (area < bestArea || (area == bestArea && box.width < bestWidth)) {
+                    best = rotation;
+                    bestArea = area;
+                    bestWidth = box.width;
+                }
+            }
+            it = chosen.emplace(part->source, best).first;
+        }
+        greedy.placement.push_back(part);
+        greedy.rotation.push_back(it->second);
+    }
+    return greedy;
+}
+
+void NestingEngine::launchGreedy() {
+    if (!parallelProcessor_) {
+        return;
+    }
+    Population& island = geneticAlgorithm_->getIsland(0);
+    Individual& first = island.getIndividuals().front();
+    if (first.hasValidFitness() || first.isProcessing()) {
+        return;
+    }
+
+    // Reported as soon as it is placed, so never screened
+    first.coarse = false;
+    auto greedy = [](size_t k, size_t i) { return k == 0 && i == 0; };
+    std::vector<std::vector<size_t>> cold;
+    std::vector<NFPPair> sheetPairs;
+    std::vector<NFPPair> pairs = generateNFPPairs(cold, sheetPairs, greedy);
+
+    // The evaluation waits on the pairs the pool is computing instead of
+    // computing them again, so every thread works on it until it is placed
+    parallelProcessor_->processPopulation(island, job_, *placementWorker_, config_.threads,
+                                          [](size_t i) { return i == 0; },
+                                          config_.branchAndBound, fitnessMemo_, nullptr);
+    if (!pairs.empty()) {
+        LOG_NESTING("Prefetching " << pairs.size() << " NFP pairs of the greedy individual");
+        parallelProcessor_->prefetchNFPs(pairs, *nfpCalculator_);
+    }
+}
+
+void NestingEngine::trackConvergence(size_t island) {
+    if (config_.coarseScreeningGenerations >= 0 || island >= islandDetail_.size() ||
+        islandDetail_[island].fullResolution) {
+        return;
+    }
+
+    double best = std::numeric_limits<double>::max();
+    for (const auto& individual : geneticAlgorithm_->getIsland(island).getIndividuals()) {
+        if (individual.hasValidFitness()) {
+            best = std::min(best, individual.fitness);
+        }
+    }
+
+    IslandDetail& detail = islandDetail_[island];
+    if (best < detail.bestFitness) {
+        detail.bestFitness = best;
+        detail.stalledGenerations = 0;
+    }
+    else if (++detail.stalledGenerations >= SCREENING_STALL_GENERATIONS) {
+        detail.fullResolution = true;
+        LOG_GA("Island " << island << " converged on coarse outlines after "
+               << geneticAlgorithm_->getIslandGeneration(island) << " generations, switching to full resolution");
+    }
+}
+
+bool NestingEngine::refineElite(Population& island) {
+    auto& population = island.getIndividuals();
+
+    auto best = std::min_element(population.begin(), population.end(),
+        [](const Individual& a, const Individual& b) {
+            return a.fitness < b.fitness;
+        });
+
+    if (best == population.end() || !best->coarse) {
+        return false;
+    }
+
+    LOG_GA("Refining coarse elite (screening fitness " << best->fitness << ")");
+    best->coarse = false;
+    best->resetFitness();
+    return true;
+}
+
+std::vector<NFPPair> NestingEngine::generateNFPPairs(std::vector<std::vector<size_t>>& cold,
+                                                     std::vector<NFPPair>& sheetPairs,
+                                                     const std::function<bool(size_t, size_t)>& select) {
+    // JavaScript reference: svgnest.js lines 287-310
+
+    std::vector<NFPPair> pairs;
+    const NFPCache& cache = sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_;
+    cold.resize(geneticAlgorithm_->getIslandCount());
+    for (size_t k = 0; k < cold.size(); ++k) {
+        cold[k].assign(geneticAlgorithm_->getIsland(k).size(), 0);
+    }
+
+    if (sheets_.empty()) {
+        return pairs;
+    }
+
+    // Shared by every inner pair of this batch
+    auto binPolygon = std::make_shared<const Polygon>(sheets_[0]);
+    const uint64_t binKey = NFPCalculator::shapeKey(*binPolygon, binPolygon->source);
+
+    // The other sheet types, each once; placements reach them only after
+    // the first sheet, so their inner NFPs are wanted later
+    std::vector<std::pair<uint64_t, std::shared_ptr<const Polygon>>> otherSheets;
+    for (size_t s = 1; s < sheets_.size(); ++s) {
+        const uint64_t sheetKey = NFPCalculator::shapeKey(sheets_[s], sheets_[s].source);
+        bool seen = sheetKey == binKey;
+        for (const auto& other : otherSheets) {
+            seen = seen || other.first == sheetKey;
+        }
+        if (!seen) {
+            otherSheets.emplace_back(sheetKey, std::make_shared<const Polygon>(sheets_[s]));
+        }
+    }
+    std::unordered_set<NFPCache::NFPKey, NFPCache::NFPKeyHash> sheetKeys;
+
+    // Cache key -> index into pairs, to deduplicate across individuals
+    std::unordered_map<NFPCache::NFPKey, size_t, NFPCache::NFPKeyHash> pairIndex;
+
+    // The job's turned copy of a placed shape, sharing the job's lifetime
+    // (nullptr if the job has no such variant)
+    const std::shared_ptr<const PlacementJob> job = job_;
+    auto turned = [&job](int partId, double rotation, bool coarse) -> std::shared_ptr<const Polygon> {
+        const size_t index = job ? job->variantIndex(partId, rotation, coarse) : PlacementJob::npos;
+        if (index == PlacementJob::npos) {
+            return nullptr;
+        }
+        return std::shared_ptr<const Polygon>(job, &job->variant(index));
+    };
+
+    // mirror: key of NFP(B, A), from which NFP(A, B) can be derived (or nullptr)
+    auto request = [&](const NFPCache::NFPKey& key, const NFPCache::NFPKey* mirror,
+                       const std::shared_ptr<const Polygon>& A, const std::shared_ptr<const Polygon>& B,
+                       double rotA, double rotB, bool coarse) {
+        auto it = pairIndex.find(key);
+        if (it == pairIndex.end() && mirror) {
+            it = pairIndex.find(*mirror);
+        }
+        if (it != pairIndex.end()) {
+            pairs[it->second].demand++;
+            return false;
+        }
+        if (cache.has(key) || (mirror && cache.has(*mirror))) {
+            return true;
+        }
+
+        NFPPair pair;
+        pair.A = A ? A : binPolygon;
+        pair.B = B;
+        pair.inside = key.inside;
+        pair.Arotation = rotA;
+        pair.Brotation = rotB;
+        pair.demand = 1;
+        if (A) {
+            pair.turnedA = turned(A->id, rotA, coarse);
+        }
+        pair.turnedB = turned(B->id, rotB, coarse);
+        pairIndex.emplace(key, pairs.size());
+        pairs.push_back(std::move(pair));
+        return false;
+    };
+
+    // For each unevaluated individual of every island
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        auto& population = geneticAlgorithm_->getIsland(k).getIndividuals();
+        for (size_t index = 0; index < population.size(); ++index) {
+            const Individual& individual = population[index];
+
+            // Skip already evaluated or currently processing individuals
+            if (individual.hasValidFitness() || individual.isProcessing() || (select && !select(k, index))) {
+                continue;
+            }
+
+            // Shapes the evaluation will place
+            std::vector<std::shared_ptr<const Polygon>> placelist;
+            placelist.reserve(individual.placement.size());
+            for (const auto& part : individual.placement) {
+                placelist.push_back(individual.coarse && part->coarse ? part->coarse : part);
+            }
+            const auto& rotations = individual.rotation;
+            const bool coarse = individual.coarse;
+            size_t missing = 0;
+
+            // For each part in the placement sequence
+            for (size_t i = 0; i < placelist.size(); ++i) {
+                const Polygon& part = *placelist[i];
+                double partRotation = rotations[i];
+
+                // Inner NFP: part vs bin (JavaScript line 293)
+                NFPCache::NFPKey innerKey(binKey, NFPCalculator::shapeKey(part, part.source),
+                                          0.0, partRotation, true);
+                if (!request(innerKey, nullptr, nullptr, placelist[i], 0.0, partRotation, coarse)) {
+                    ++missing;
+                }
+                for (const auto& sheet : otherSheets) {
+                    NFPCache::NFPKey sheetKey(sheet.first, innerKey.idB, 0.0, partRotation, true);
+                    if (cache.has(sheetKey) || !sheetKeys.insert(sheetKey).second) {
+                        continue;
+                    }
+                    NFPPair pair;
+                    pair.A = sheet.second;
+                    pair.B = placelist[i];
+                    pair.inside = true;
+                    pair.Arotation = 0.0;
+                    pair.Brotation = partRotation;
+                    pair.demand = 1;
+                    pair.turnedB = turned(part.id, partRotation, coarse);
+                    sheetPairs.push_back(std::move(pair));
+                }
+
+                // Outer NFP: part vs previously placed parts (JavaScript lines 300-309)
+                for (size_t j = 0; j < i; ++j) {
+                    const Polygon& placed = *placelist[j];
+                    double placedRotation = rotations[j];
+
+                    NFPCache::NFPKey outerKey = nfpCalculator_->outerKey(placed, part,
+                                                                         placedRotation, partRotation);
+
+                    // NFP(part, placed) reflects into this one for hole-free parts
+                    const bool symmetric = placed.children.empty() && part.children.empty();
+                    NFPCache::NFPKey mirrorKey = nfpCalculator_->outerKey(part, placed,
+                                                                          partRotation, placedRotation);
+
+                    if (!request(outerKey, symmetric ? &mirrorKey : nullptr,
+                                 placelist[j], placelist[i], placedRotation, partRotation, coarse)) {
+                        ++missing;
+                    }
+                }
+            }
+
+            cold[k][index] = missing;
+        }
+    }
+
+    // Inner NFPs gate every placement, then favour pairs many individuals
+    // share, then expensive pairs so they start as early as possible
+    std::stable_sort(pairs.begin(), pairs.end(),
+        [](const NFPPair& a, const NFPPair& b) {
+            if (a.inside != b.inside) {
+                return a.inside;
+            }
+            if (a.demand != b.demand) {
+                return a.demand > b.demand;
+            }
+            return a.A->points.size() * a.B->points.size() >
+                   b.A->points.size() * b.B->points.size();
+        });
+
+    return pairs;
+}
+
+std::vector<NFPPair> NestingEngine::speculativeNFPPairs(const std::vector<NFPPair>& requested) {
+    std::vector<NFPPair> pairs;
+    GenePairStatistics statistics;
+    for (size_t k = 0; k < geneticAlgorithm_->getIslandCount(); ++k) {
+        statistics.addPopulation(geneticAlgorithm_->getIsland(k));
+    }
+
+    const NFPCache& cache = sharedNfpCache_ ? *sharedNfpCache_ : nfpCache_;
+    std::unordered_set<NFPCache::NFPKey, NFPCache::NFPKeyHash> seen;
+    for (const auto& pair : requested) {
+        if (!pair.inside) {
+            seen.insert(nfpCalculator_->outerKey(*pair.A, *pair.B, pair.Arotation, pair.Brotation));
+        }
+    }
+
+    auto wanted = [&](const GenePairStatistics::Candidate& candidate) {
+        const NFPCache::NFPKey key = nfpCalculator_->outerKey(*candidate.placed, *candidate.part,
+                                                              candidate.placedRotation, candidate.partRotation);
+        if (cache.has(key) || !seen.insert(key).second) {
+            return false;
+        }
+        if (candidate.placed->children.empty() && candidate.part->children.empty()) {
+            const NFPCache::NFPKey mirror = nfpCalculator_->outerKey(*candidate.part, *candidate.placed,
+                                                                     candidate.partRotation,
+                                                                     candidate.placedRotation);
+            if (cache.has(mirror) || seen.count(mirror)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // The job's turned copies, as generateNFPPairs() gives them
+    const std::shared_ptr<const PlacementJob> job = job_;
+    auto turned = [&job](int partId, double rotation) -> std::shared_ptr<const Polygon> {
+        const size_t index = job ? job->variantIndex(partId, rotation, false) : PlacementJob::npos;
+        if (index == PlacementJob::npos) {
+            return nullptr;
+        }
+        return std::shared_ptr<const Polygon>(job, &job->variant(index));
+    };
+
+    for (const auto& candidate : statistics.ranked(wanted, static_cast<size_t>(config_.speculativeNfpPairs))) {
+        NFPPair pair;
+        pair.A = candidate.placed;
+        pair.B = candidate.part;
+        pair.inside = false;
+        pair.Arotation = candidate.placedRotation;
+        pair.Brotation = candidate.partRotation;
+        pair.demand = 0;
+        pair.turnedA = turned(candidate.placed->id, candidate.placedRotation);
+        pair.turnedB = turned(candidate.part->id, candidate.partRotation);
+        pairs.push_back(std::move(pair));
     }
-    
     return pairs;
 }
 
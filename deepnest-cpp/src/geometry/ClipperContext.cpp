@@ -0,0 +1,111 @@
+#include "../../include/deepnest/geometry/ClipperContext.h"
+#include <clipper2/clipper.rectclip.h>
+#include <cmath>
+
+namespace deepnest {
+
+using namespace Clipper2Lib;
+
+namespace {
+
+// Four-corner axis-aligned rectangle, the inner NFP of a rectangular sheet
+bool asRectangle(const Path64& path, Rect64& rect) {
+    if (path.size() != 4) {
+        return false;
+    }
+    rect = GetBounds(path);
+    if (rect.IsEmpty()) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        const Point64& a = path[i];
+        const Point64& b = path[(i + 1) % 4];
+        if (a.x != b.x && a.y != b.y) {
+            return false;
+        }
+    }
+    // Edges are axis-aligned; a true rectangle also covers its bounds
+    return std::abs(Area(path)) == static_cast<double>(rect.Width()) * static_cast<double>(rect.Height());
+}
+
+} // anonymous namespace
+
+ClipperContext& ClipperContext::local() {
+    static thread_local ClipperContext context;
+    return context;
+}
+
+void ClipperContext::unite(const Paths64& subjects, Paths64& out, FillRule fillRule) {
+    clipper_.Clear();
+    clipper_.AddSubject(subjects);
+    execute(ClipType::Union, fillRule, out);
+}
+
+void ClipperContext::unite(const Paths64& subjects, const Paths64& clips,
+                           Paths64& out, FillRule fillRule) {
+    clipper_.Clear();
+    clipper_.AddSubject(subjects);
+    clipper_.AddClip(clips);
+    execute(ClipType::Union, fillRule, out);
+}
+
+void ClipperContext::difference(const Path64& subject, const Paths64& clips,
+                                Paths64& out, FillRule fillRule) {
+    clipper_.Clear();
+    clipper_.AddSubject(single(subject_, subject));
+
+    // Against a rectangle only what lies inside it matters. RectClip64
+    // trims each clip path to the rectangle in linear time (paths wholly
+    // inside or outside cost one bounds test), keeping its orientation and
+    // so the winding inside, and the sweep then sees far fewer edges
+    Rect64 rect;
+    if (asRectangle(subject, rect)) {
+        RectClip64 rectClip(rect);
+        clip_ = rectClip.Execute(clips);
+        clipper_.AddClip(clip_);
+    } else {
+        clipper_.AddClip(clips);
+    }
+    execute(ClipType::Difference, fillRule, out);
+}
+
+void ClipperContext::difference(const Path64& a, const Path64& b,
+                                Paths64& out, FillRule fillRule) {
+    clipper_.Clear();
+    clipper_.AddSubject(single(subject_, a));
+    clipper_.AddClip(single(clip_, b));
+    execute(ClipType::Difference, fillRule, out);
+}
+
+void ClipperContext::intersect(const Path64& a, const Path64& b,
+                               Paths64& out, FillRule fillRule) {
+    clipper_.Clear();
+    clipper_.AddSubject(single(subject_, a));
+    clipper_.AddClip(single(clip_, b));
+    execute(ClipType::Intersection, fillRule, out);
+}
+
+void ClipperContext::offset(const Paths64& paths, double delta,
+                            JoinType joinType, double miterLimit, double arcTolerance,
+                            Paths64& out) {
+    offset_.Clear();
+    offset_.MiterLimit(miterLimit);
+    offset_.ArcTolerance(arcTolerance);
+    offset_.AddPaths(paths, joinType, EndType::Polygon);
+    offset_.Execute(delta, out);
+    offset_.Clear();
+}
+
+void ClipperContext::execute(ClipType clipType, FillRule fillRule, Paths64& out) {
+    clipper_.Execute(clipType, fillRule, out, open_);
+    // Drop the added paths but keep the engine's list capacity
+    clipper_.Clear();
+}
+
+const Paths64& ClipperContext::single(Paths64& buffer, const Path64& path) {
+    buffer.resize(1);
+    buffer[0].assign(path.begin(), path.end());
+    return buffer;
+}
+
+} // namespace deepnest
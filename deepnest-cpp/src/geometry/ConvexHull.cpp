@@ -131,4 +131,61 @@ std::vector<Point> ConvexHull::computeHullFromPolygon(const std::vector<Point>&
     return computeHull(polygon);
 }
 
+void ConvexHull::sortForMerge(std::vector<Point>& points) {
+    std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+}
+
+double ConvexHull::mergedHullArea(
+    const std::vector<Point>& a,
+    const std::vector<Point>& b,
+    const Point& offset
+) {
+    // Merge the sorted lists
+    std::vector<Point> points;
+    points.reserve(a.size() + b.size());
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size()) {
+            points.push_back(a[i++]);
+            continue;
+        }
+        const Point shifted(b[j].x + offset.x, b[j].y + offset.y);
+        if (i < a.size() && (a[i].x < shifted.x || (a[i].x == shifted.x && a[i].y < shifted.y))) {
+            points.push_back(a[i++]);
+        } else {
+            points.push_back(shifted);
+            j++;
+        }
+    }
+
+    if (points.size() < 3) {
+        return 0.0;
+    }
+
+    // Monotone chain: lower hull left to right, upper hull right to left
+    std::vector<Point> hull(2 * points.size());
+    size_t k = 0;
+    for (size_t n = 0; n < points.size(); n++) {
+        while (k >= 2 && crossProduct(hull[k - 2], hull[k - 1], points[n]) <= 0) {
+            k--;
+        }
+        hull[k++] = points[n];
+    }
+    for (size_t n = points.size() - 1, lower = k + 1; n > 0; n--) {
+        while (k >= lower && crossProduct(hull[k - 2], hull[k - 1], points[n - 1]) <= 0) {
+            k--;
+        }
+        hull[k++] = points[n - 1];
+    }
+
+    // The last point repeats the first
+    double area = 0.0;
+    for (size_t n = 0; n + 1 < k; n++) {
+        area += hull[n].x * hull[n + 1].y - hull[n + 1].x * hull[n].y;
+    }
+    return std::abs(area) * 0.5;
+}
+
 } // namespace deepnest
@@ -0,0 +1,102 @@
+#include "../../include/deepnest/geometry/EdgeGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace deepnest {
+
+EdgeGrid::EdgeGrid(const std::vector<Point>& polygon, double margin)
+    : edgeCount_(polygon.size())
+{
+    if (polygon.empty()) {
+        return;
+    }
+
+    minX_ = maxX_ = polygon[0].x;
+    minY_ = maxY_ = polygon[0].y;
+    for (const auto& p : polygon) {
+        minX_ = std::min<double>(minX_, p.x);
+        minY_ = std::min<double>(minY_, p.y);
+        maxX_ = std::max<double>(maxX_, p.x);
+        maxY_ = std::max<double>(maxY_, p.y);
+    }
+    minX_ -= margin;
+    minY_ -= margin;
+    maxX_ += margin;
+    maxY_ += margin;
+
+    // About one cell per edge along the longer side's square
+    const double width = maxX_ - minX_;
+    const double height = maxY_ - minY_;
+    const double side = std::ceil(std::sqrt(static_cast<double>(edgeCount_)));
+    cellSize_ = std::max(width, height) / side;
+    if (!(cellSize_ > 0.0)) {
+        cellSize_ = 1.0;
+    }
+    columns_ = static_cast<int>(width / cellSize_) + 1;
+    rows_ = static_cast<int>(height / cellSize_) + 1;
+    cells_.resize(static_cast<size_t>(columns_) * rows_);
+
+    for (size_t i = 0; i < edgeCount_; i++) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[(i + 1) % edgeCount_];
+
+        const int c0 = column(std::min(a.x, b.x) - margin);
+        const int c1 = column(std::max(a.x, b.x) + margin);
+        const int r0 = row(std::min(a.y, b.y) - margin);
+        const int r1 = row(std::max(a.y, b.y) + margin);
+
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                cells_[static_cast<size_t>(r) * columns_ + c].push_back(static_cast<int>(i));
+            }
+        }
+    }
+}
+
+int EdgeGrid::column(double x) const {
+    // Clamp before converting: a swept query box can reach far outside
+    const double c = std::floor((x - minX_) / cellSize_);
+    return static_cast<int>(std::clamp(c, 0.0, static_cast<double>(columns_ - 1)));
+}
+
+int EdgeGrid::row(double y) const {
+    const double r = std::floor((y - minY_) / cellSize_);
+    return static_cast<int>(std::clamp(r, 0.0, static_cast<double>(rows_ - 1)));
+}
+
+const std::vector<int>& EdgeGrid::near(double x, double y) const {
+    static const std::vector<int> none;
+
+    if (cells_.empty() || x < minX_ || x > maxX_ || y < minY_ || y > maxY_) {
+        return none;
+    }
+    return cells_[static_cast<size_t>(row(y)) * columns_ + column(x)];
+}
+
+void EdgeGrid::overlapping(double minX, double minY, double maxX, double maxY,
+                           std::vector<int>& edges) const {
+    edges.clear();
+
+    if (cells_.empty() || maxX < minX_ || minX > maxX_ || maxY < minY_ || minY > maxY_) {
+        return;
+    }
+
+    const int c0 = column(minX);
+    const int c1 = column(maxX);
+    const int r0 = row(minY);
+    const int r1 = row(maxY);
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            const auto& cell = cells_[static_cast<size_t>(r) * columns_ + c];
+            edges.insert(edges.end(), cell.begin(), cell.end());
+        }
+    }
+
+    if (r0 != r1 || c0 != c1) {
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    }
+}
+
+} // namespace deepnest
@@ -1,6 +1,7 @@
 #include "../../include/deepnest/geometry/GeometryUtil.h"
 #include "../../include/deepnest/geometry/GeometryUtilAdvanced.h"
 #include "../../include/deepnest/geometry/OrbitalTypes.h"
+#include "../../include/deepnest/geometry/EdgeGrid.h"
 #include "../../include/deepnest/core/Polygon.h"
 #include "../../include/deepnest/DebugConfig.h"
 #include <cmath>
@@ -610,6 +611,330 @@ std::vector<Point> linearize(const Point& p1, const Point& p2,
 // and polygonHull) are now implemented in GeometryUtilAdvanced.cpp to keep file sizes
 // manageable and improve code organization.
 
+// One loop of the orbital NFP, traced from B at offsetB touching A: the
+// positions of B[0] in order, or empty if the trace does not close. Marks
+// the vertices it touches and slides along
+static std::vector<Point> traceOrbit(std::vector<Point>& A,
+                                     std::vector<Point>& B,
+                                     const EdgeGrid* gridA,
+                                     const EdgeGrid* gridB,
+                                     Point offsetB) {
+    std::vector<Point> nfp;
+    std::vector<Point> movedB;
+    std::vector<Point> probedB;
+    std::optional<TranslationVector> prevVector;  // Changed from pointer to value
+
+    // Reference point: B[0] translated by offset
+    // JavaScript lines 1497-1500
+    Point reference(B[0].x + offsetB.x, B[0].y + offsetB.y);
+    Point startPoint = reference;
+
+    nfp.push_back(reference);
+
+    int counter = 0;
+    int maxIterations = 10 * (A.size() + B.size());
+
+    // Main orbital tracing loop
+    // JavaScript lines 1503-1711
+    while (counter < maxIterations) {
+        // STEP 1: Find all touching contacts
+        // JavaScript lines 1504-1520
+        auto touchingList = gridA
+            ? findTouchingContacts(A, B, offsetB, *gridA, *gridB)
+            : findTouchingContacts(A, B, offsetB);
+
+        LOG_NFP("    ============================================");
+        LOG_NFP("    ITERATION " << counter);
+        LOG_NFP("    offsetB: (" << offsetB.x << ", " << offsetB.y << ")");
+        LOG_NFP("    reference: (" << reference.x << ", " << reference.y << ")");
+        LOG_NFP("    touching contacts: " << touchingList.size());
+
+        if (touchingList.empty()) {
+            LOG_NFP("    ERROR: No touching contacts found, breaking loop");
+            break;  // No touching contacts
+        }
+
+        // DETAILED DUMP: All touching contacts with polygon coords
+        for (size_t tc = 0; tc < touchingList.size(); tc++) {
+            const auto& touch = touchingList[tc];
+            LOG_NFP("    Touch[" << tc << "]: type=" << (int)touch.type
+                   << " A[" << touch.indexA << "]=(" << A[touch.indexA].x << "," << A[touch.indexA].y << ")"
+                   << " B[" << touch.indexB << "]=(" << B[touch.indexB].x << "," << B[touch.indexB].y << ")"
+                   << " B+offset=(" << (B[touch.indexB].x + offsetB.x) << "," << (B[touch.indexB].y + offsetB.y) << ")");
+        }
+
+        // STEP 2: Generate translation vectors from all touches
+        // JavaScript lines 1522-1616
+        std::vector<TranslationVector> allVectors;
+        for (const auto& touch : touchingList) {
+            // Mark vertex as touched
+            A[touch.indexA].marked = true;
+
+            auto vectors = generateTranslationVectors(touch, A, B, offsetB);
+
+            LOG_NFP("    Touch A[" << touch.indexA << "] B[" << touch.indexB << "] generated " << vectors.size() << " vectors:");
+            for (size_t vi = 0; vi < vectors.size(); vi++) {
+                const auto& v = vectors[vi];
+                LOG_NFP("      [" << vi << "] (" << v.x << ", " << v.y << ") len=" << v.length()
+                       << " poly=" << v.polygon << " start=" << v.startIndex << " end=" << v.endIndex);
+            }
+
+            allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+        }
+
+        LOG_NFP("    Total vectors: " << allVectors.size());
+        if (prevVector.has_value()) {
+            LOG_NFP("    prevVector: (" << prevVector->x << ", " << prevVector->y
+                   << ") polygon=" << prevVector->polygon);
+        }
+
+        // STEP 3: Filter and select best vector
+        // JavaScript lines 1620-1657
+        // The slide is measured from where B is now (JavaScript adds
+        // B.offsetx inside polygonSlideDistance)
+        movedB.resize(B.size());
+        for (size_t k = 0; k < B.size(); k++) {
+            movedB[k] = Point(B[k].x + offsetB.x, B[k].y + offsetB.y);
+        }
+        TranslationVector* bestVector = nullptr;
+        double maxDistance = 0.0;
+        int filteredCount = 0;
+
+        for (auto& vec : allVectors) {
+            // Skip zero vectors and backtracking
+            // JavaScript lines 1624-1642
+            if (isBacktracking(vec, prevVector)) {
+                LOG_NFP("      FILTERED backtrack: (" << vec.x << ", " << vec.y << ")");
+                filteredCount++;
+                continue;
+            }
+
+            // Calculate slide distance
+            // JavaScript line 1645
+            double slideDistance;
+            double vecLength2 = vec.x * vec.x + vec.y * vec.y;
+            double vecLength = std::sqrt(vecLength2);
+
+            // A slide longer than the vector is cut to its length below,
+            // so the indexed search need not look further
+            auto slideOpt = gridA
+                ? polygonSlideDistance(A, movedB, Point(vec.x, vec.y), *gridA, vecLength)
+                : polygonSlideDistance(A, movedB, Point(vec.x, vec.y), true);
+
+            // A vertex of B on a vertex of A measures 0 even when B moves
+            // away from it (as in JavaScript). If a short step along the
+            // vector leaves B clear of A, the slide is measured from there
+            if (slideOpt.has_value() && almostEqual(slideOpt.value(), 0.0)) {
+                const double probe = 1e-6 * vecLength;
+                const Point step(vec.x * 1e-6, vec.y * 1e-6);
+                if (!polygonsOverlap(A, B, Point(offsetB.x + step.x, offsetB.y + step.y))) {
+                    probedB.resize(B.size());
+                    for (size_t k = 0; k < B.size(); k++) {
+                        probedB[k] = Point(movedB[k].x + step.x, movedB[k].y + step.y);
+                    }
+                    auto rest = gridA
+                        ? polygonSlideDistance(A, probedB, Point(vec.x, vec.y), *gridA, vecLength - probe)
+                        : polygonSlideDistance(A, probedB, Point(vec.x, vec.y), true);
+                    slideOpt = rest.has_value() ? std::optional<double>(rest.value() + probe) : std::nullopt;
+                }
+            }
+
+            // JavaScript lines 1648-1651: if null, too large, or ~0, use vector length
+            if (!slideOpt.has_value()) {
+                LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") slideOpt is NULL → using vecLength=" << vecLength);
+                slideDistance = vecLength;
+            }
+            else if (slideOpt.value() * slideOpt.value() > vecLength2) {
+                LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") slideOpt=" << slideOpt.value()
+                       << " too large (slideOpt²=" << (slideOpt.value() * slideOpt.value())
+                       << " > vecLength²=" << vecLength2 << ") → using vecLength=" << vecLength);
+                slideDistance = vecLength;
+            }
+            else {
+                // A slide of 0 is a blocked direction, as in JavaScript
+                LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") using slideOpt=" << slideOpt.value());
+                slideDistance = slideOpt.value();
+            }
+
+            LOG_NFP("      Candidate: (" << vec.x << ", " << vec.y << ") slide=" << slideDistance
+                   << " polygon=" << vec.polygon);
+
+            // Select vector with MAXIMUM distance
+            // JavaScript lines 1653-1656
+            if (slideDistance > maxDistance) {
+                maxDistance = slideDistance;
+                bestVector = &vec;
+            }
+        }
+
+        LOG_NFP("    Filtered " << filteredCount << " backtracking vectors");
+        LOG_NFP("    Best vector: (" << (bestVector ? bestVector->x : 0) << ", "
+               << (bestVector ? bestVector->y : 0) << ") maxDistance = " << maxDistance
+               << " polygon=" << (bestVector ? std::string(1, bestVector->polygon) : "?"));
+
+        // JavaScript lines 1660-1664: check if valid vector found
+        if (!bestVector || almostEqual(maxDistance, 0.0)) {
+            LOG_NFP("    ERROR: No valid vector found (bestVector=" << (bestVector ? "exists" : "null")
+                   << ", maxDistance=" << maxDistance << ")");
+            nfp.clear();  // Didn't close loop properly
+            break;
+        }
+
+        // Mark vertices as used
+        // JavaScript lines 1666-1667
+        if (bestVector->polygon == 'A') {
+            A[bestVector->startIndex].marked = true;
+            A[bestVector->endIndex].marked = true;
+        } else {
+            B[bestVector->startIndex].marked = true;
+            B[bestVector->endIndex].marked = true;
+        }
+
+        // STEP 4: Trim vector if needed
+        // JavaScript lines 1672-1677
+        double vecLength2 = bestVector->x * bestVector->x + bestVector->y * bestVector->y;
+        if (maxDistance * maxDistance < vecLength2 &&
+            !almostEqual(maxDistance * maxDistance, vecLength2)) {
+            double scale = std::sqrt((maxDistance * maxDistance) / vecLength2);
+            bestVector->x *= scale;
+            bestVector->y *= scale;
+        }
+
+        // Save prevVector AFTER trimming (so it matches the actual movement)
+        prevVector = *bestVector;
+
+        // STEP 5: Move reference point
+        // JavaScript lines 1679-1680
+        reference.x += bestVector->x;
+        reference.y += bestVector->y;
+        LOG_NFP("    New reference: (" << reference.x << ", " << reference.y << ")");
+
+        // STEP 6: Check loop closure
+        // JavaScript lines 1682-1700
+        if (almostEqual(reference.x, startPoint.x) && almostEqual(reference.y, startPoint.y)) {
+            LOG_NFP("    Loop closed: returned to start point (" << startPoint.x << ", " << startPoint.y << ")");
+            LOG_NFP("    Distance from start: " << std::sqrt((reference.x - startPoint.x)*(reference.x - startPoint.x) +
+                   (reference.y - startPoint.y)*(reference.y - startPoint.y)));
+            break;  // Completed loop
+        }
+
+        // Check if we've returned to any previous point (besides start)
+        // JavaScript lines 1688-1700
+        // CRITICAL: This prevents infinite loops and detects premature closure
+        bool looped = false;
+        if (nfp.size() > 0) {
+            // Check all previous points except the last one (current position)
+            for (size_t i = 0; i < nfp.size() - 1; i++) {
+                if (almostEqual(reference.x, nfp[i].x) && almostEqual(reference.y, nfp[i].y)) {
+                    LOG_NFP("    Loop closed: returned to point " << i << " ("
+                           << nfp[i].x << ", " << nfp[i].y << ")");
+                    looped = true;
+                    break;
+                }
+            }
+        }
+
+        if (looped) {
+            break;  // Completed loop
+        }
+
+        // Add point to NFP
+        // JavaScript lines 1702-1705
+        nfp.push_back(reference);
+
+        LOG_NFP("    Added point to NFP: (" << reference.x << ", " << reference.y << ")");
+        LOG_NFP("    NFP now has " << nfp.size() << " points");
+
+        // Update offset for next iteration
+        // JavaScript lines 1707-1708
+        offsetB.x += bestVector->x;
+        offsetB.y += bestVector->y;
+
+        LOG_NFP("    New offsetB: (" << offsetB.x << ", " << offsetB.y << ")");
+
+        counter++;
+    }
+
+    return nfp;
+}
+
+// Whether p lies on the boundary of one of the loops
+static bool onLoops(const Point& p, const std::vector<std::vector<Point>>& loops) {
+    for (const auto& loop : loops) {
+        for (size_t i = 0; i < loop.size(); i++) {
+            const Point& a = loop[i];
+            const Point& b = loop[(i + 1) % loop.size()];
+            if (almostEqualPoints(p, a) || onSegment(a, b, p)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// The loops of the NFP not traced yet, from every start point
+// searchStartPoints() finds that is not on one of them, traced as
+// concurrent subtasks. Starts on the same loop trace it more than once;
+// a loop is kept if it is not on one kept before, nor one of them on it
+static void exploreLoops(const std::vector<Point>& A,
+                         const std::vector<Point>& B,
+                         bool inside,
+                         const EdgeGrid* gridA,
+                         const EdgeGrid* gridB,
+                         size_t maxLoops,
+                         const ParallelFor& parallelFor,
+                         std::vector<std::vector<Point>>& nfpList) {
+    std::vector<Point> starts;
+    for (const Point& start : searchStartPoints(A, B, inside)) {
+        if (!onLoops(Point(B[0].x + start.x, B[0].y + start.y), nfpList)) {
+            starts.push_back(start);
+        }
+    }
+    LOG_NFP("  Exploring " << starts.size() << " start points off the traced loops");
+
+    std::vector<std::vector<Point>> traced(starts.size());
+    parallelFor(starts.size(), [&](size_t begin, size_t end) {
+        // Tracing writes only the marked flags, which nothing reads, so
+        // each subtask traces on copies of its own
+        std::vector<Point> a = A;
+        std::vector<Point> b = B;
+        for (size_t i = begin; i < end; i++) {
+            traced[i] = traceOrbit(a, b, gridA, gridB, starts[i]);
+        }
+    });
+
+    for (auto& loop : traced) {
+        if (nfpList.size() >= maxLoops) {
+            break;
+        }
+        if (loop.size() < 3 || onLoops(loop.front(), nfpList)) {
+            continue;
+        }
+        // The start search also offers positions B cannot reach, whose
+        // traces fold onto themselves or run through A; keep only loops
+        // of positions where B touches A without overlapping it
+        if (almostEqual(polygonArea(loop), 0.0)) {
+            continue;
+        }
+        bool feasible = true;
+        for (size_t i = 0; feasible && i < loop.size(); i++) {
+            feasible = !polygonsOverlap(A, B, Point(loop[i].x - B[0].x, loop[i].y - B[0].y));
+        }
+        if (!feasible) {
+            continue;
+        }
+        const std::vector<std::vector<Point>> candidate(1, loop);
+        bool converged = false;
+        for (const auto& kept : nfpList) {
+            converged = converged || onLoops(kept.front(), candidate);
+        }
+        if (!converged) {
+            nfpList.push_back(std::move(loop));
+        }
+    }
+}
+
+
 // PHASE 3.2: Complete Orbital-Based noFitPolygon implementation
 // This provides a fallback when Minkowski sum fails or for validation
 // Reference: geometryutil.js:1437-1727 (noFitPolygon function)
@@ -617,7 +942,8 @@ std::vector<Point> linearize(const Point& p1, const Point& p2,
 std::vector<std::vector<Point>> noFitPolygon(const std::vector<Point>& A_input,
                                             const std::vector<Point>& B_input,
                                             bool inside,
-                                            bool searchEdges) {
+                                            bool searchEdges,
+                                            const ParallelFor& parallelFor) {
     // Complete rewrite based on JavaScript geometryutil.js lines 1437-1727
     // This implementation follows the JavaScript algorithm exactly
     //
@@ -644,6 +970,7 @@ std::vector<std::vector<Point>> noFitPolygon(const std::vector<Point>& A_input,
     // CRITICAL: Ensure correct winding order for orbital tracing
     // OUTSIDE NFP (part-to-part): Both polygons must be CCW (positive area)
     // INSIDE NFP (sheet boundary): A (container) must be CW, B (part) must be CCW
+    // Reversals keep the first vertex first: the loops trace B[0]
     double areaA = polygonArea(A);
     double areaB = polygonArea(B);
 
@@ -654,24 +981,24 @@ std::vector<std::vector<Point>> noFitPolygon(const std::vector<Point>& A_input,
         // OUTSIDE: Both must be CCW (positive area)
         if (areaA < 0) {
             LOG_NFP("  Correcting A orientation: CW → CCW");
-            std::reverse(A.begin(), A.end());
+            std::reverse(A.begin() + 1, A.end());
             areaA = -areaA;  // Update area after reversal
         }
         if (areaB < 0) {
             LOG_NFP("  Correcting B orientation: CW → CCW");
-            std::reverse(B.begin(), B.end());
+            std::reverse(B.begin() + 1, B.end());
             areaB = -areaB;  // Update area after reversal
         }
     } else {
         // INSIDE: A (container) must be CW (negative area), B (part) must be CCW (positive area)
         if (areaA > 0) {
             LOG_NFP("  Correcting A (container) orientation: CCW → CW");
-            std::reverse(A.begin(), A.end());
+            std::reverse(A.begin() + 1, A.end());
             areaA = -areaA;  // Update area after reversal
         }
         if (areaB < 0) {
             LOG_NFP("  Correcting B (part) orientation: CW → CCW");
-            std::reverse(B.begin(), B.end());
+            std::reverse(B.begin() + 1, B.end());
             areaB = -areaB;  // Update area after reversal
         }
     }
@@ -694,6 +1021,20 @@ std::vector<std::vector<Point>> noFitPolygon(const std::vector<Point>& A_input,
     int nfpCounter = 0;
     const int MAX_NFPS = 10;  // Safety limit to prevent infinite loops
 
+    // Every orbit step looks for contacts and slide limits between all edge
+    // pairs. A and B only change in their marked flags from here on, so
+    // large pairs index their edges once and each step visits the nearby
+    // ones. The margin is far above the TOL the tests allow and the
+    // rounding of the offsets; small pairs scan faster than they index.
+    const size_t GRID_MIN_PAIRS = 256;
+    const double GRID_MARGIN = 1e-6;
+    std::optional<EdgeGrid> gridA;
+    std::optional<EdgeGrid> gridB;
+    if (A.size() * B.size() >= GRID_MIN_PAIRS) {
+        gridA.emplace(A, GRID_MARGIN);
+        gridB.emplace(B, GRID_MARGIN);
+    }
+
     // Get initial start point
     std::optional<Point> startOpt;
 
@@ -753,221 +1094,7 @@ std::vector<std::vector<Point>> noFitPolygon(const std::vector<Point>& A_input,
         LOG_NFP("  --- New NFP loop iteration " << nfpCounter << " ---");
         Point offsetB = startOpt.value();
 
-        std::vector<Point> nfp;
-        std::optional<TranslationVector> prevVector;  // Changed from pointer to value
-
-        // Reference point: B[0] translated by offset
-        // JavaScript lines 1497-1500
-        Point reference(B[0].x + offsetB.x, B[0].y + offsetB.y);
-        Point startPoint = reference;
-
-        nfp.push_back(reference);
-
-        int counter = 0;
-        int maxIterations = 10 * (A.size() + B.size());
-
-        // Main orbital tracing loop
-        // JavaScript lines 1503-1711
-        while (counter < maxIterations) {
-            // STEP 1: Find all touching contacts
-            // JavaScript lines 1504-1520
-            auto touchingList = findTouchingContacts(A, B, offsetB);
-
-            LOG_NFP("    ============================================");
-            LOG_NFP("    ITERATION " << counter);
-            LOG_NFP("    offsetB: (" << offsetB.x << ", " << offsetB.y << ")");
-            LOG_NFP("    reference: (" << reference.x << ", " << reference.y << ")");
-            LOG_NFP("    touching contacts: " << touchingList.size());
-
-            if (touchingList.empty()) {
-                LOG_NFP("    ERROR: No touching contacts found, breaking loop");
-                break;  // No touching contacts
-            }
-
-            // DETAILED DUMP: All touching contacts with polygon coords
-            for (size_t tc = 0; tc < touchingList.size(); tc++) {
-                const auto& touch = touchingList[tc];
-                LOG_NFP("    Touch[" << tc << "]: type=" << (int)touch.type
-                       << " A[" << touch.indexA << "]=(" << A[touch.indexA].x << "," << A[touch.indexA].y << ")"
-                       << " B[" << touch.indexB << "]=(" << B[touch.indexB].x << "," << B[touch.indexB].y << ")"
-                       << " B+offset=(" << (B[touch.indexB].x + offsetB.x) << "," << (B[touch.indexB].y + offsetB.y) << ")");
-            }
-
-            // STEP 2: Generate translation vectors from all touches
-            // JavaScript lines 1522-1616
-            std::vector<TranslationVector> allVectors;
-            for (const auto& touch : touchingList) {
-                // Mark vertex as touched
-                A[touch.indexA].marked = true;
-
-                auto vectors = generateTranslationVectors(touch, A, B, offsetB);
-
-                LOG_NFP("    Touch A[" << touch.indexA << "] B[" << touch.indexB << "] generated " << vectors.size() << " vectors:");
-                for (size_t vi = 0; vi < vectors.size(); vi++) {
-                    const auto& v = vectors[vi];
-                    LOG_NFP("      [" << vi << "] (" << v.x << ", " << v.y << ") len=" << v.length()
-                           << " poly=" << v.polygon << " start=" << v.startIndex << " end=" << v.endIndex);
-                }
-
-                allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
-            }
-
-            LOG_NFP("    Total vectors: " << allVectors.size());
-            if (prevVector.has_value()) {
-                LOG_NFP("    prevVector: (" << prevVector->x << ", " << prevVector->y
-                       << ") polygon=" << prevVector->polygon);
-            }
-
-            // STEP 3: Filter and select best vector
-            // JavaScript lines 1620-1657
-            TranslationVector* bestVector = nullptr;
-            double maxDistance = 0.0;
-            int filteredCount = 0;
-
-            for (auto& vec : allVectors) {
-                // Skip zero vectors and backtracking
-                // JavaScript lines 1624-1642
-                if (isBacktracking(vec, prevVector)) {
-                    LOG_NFP("      FILTERED backtrack: (" << vec.x << ", " << vec.y << ")");
-                    filteredCount++;
-                    continue;
-                }
-
-                // Calculate slide distance
-                // JavaScript line 1645
-                auto slideOpt = polygonSlideDistance(A, B, Point(vec.x, vec.y), true);
-
-                double slideDistance;
-                double vecLength2 = vec.x * vec.x + vec.y * vec.y;
-                double vecLength = std::sqrt(vecLength2);
-
-                // JavaScript lines 1648-1651: if null, too large, or ~0, use vector length
-                if (!slideOpt.has_value()) {
-                    LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") slideOpt is NULL → using vecLength=" << vecLength);
-                    slideDistance = vecLength;
-                }
-                else if (slideOpt.value() * slideOpt.value() > vecLength2) {
-                    LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") slideOpt=" << slideOpt.value()
-                           << " too large (slideOpt²=" << (slideOpt.value() * slideOpt.value())
-                           << " > vecLength²=" << vecLength2 << ") → using vecLength=" << vecLength);
-                    slideDistance = vecLength;
-                }
-                else {
-                    // HYBRID APPROACH: JavaScript doesn't have this, but it HELPS in C++
-                    // Use integer rounding to detect slideOpt exactly == 0 (not ≈ 0)
-                    int64_t slideOptInt = static_cast<int64_t>(std::round(slideOpt.value()));
-
-                    if (slideOptInt == 0 && vecLength > TOL) {
-                        // When slideDistance rounds to exactly 0, use vecLength
-                        // This reduces EMPTY from 5 to 0 even though not in JavaScript!
-                        LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") slideOpt=" << slideOpt.value()
-                               << " rounds to 0 → using vecLength=" << vecLength);
-                        slideDistance = vecLength;
-                    }
-                    else {
-                        LOG_NFP("      [SLIDE] Vector (" << vec.x << ", " << vec.y << ") using slideOpt=" << slideOpt.value());
-                        slideDistance = slideOpt.value();
-                    }
-                }
-
-                LOG_NFP("      Candidate: (" << vec.x << ", " << vec.y << ") slide=" << slideDistance
-                       << " polygon=" << vec.polygon);
-
-                // Select vector with MAXIMUM distance
-                // JavaScript lines 1653-1656
-                if (slideDistance > maxDistance) {
-                    maxDistance = slideDistance;
-                    bestVector = &vec;
-                }
-            }
-
-            LOG_NFP("    Filtered " << filteredCount << " backtracking vectors");
-            LOG_NFP("    Best vector: (" << (bestVector ? bestVector->x : 0) << ", "
-                   << (bestVector ? bestVector->y : 0) << ") maxDistance = " << maxDistance
-                   << " polygon=" << (bestVector ? std::string(1, bestVector->polygon) : "?"));
-
-            // JavaScript lines 1660-1664: check if valid vector found
-            if (!bestVector || almostEqual(maxDistance, 0.0)) {
-                LOG_NFP("    ERROR: No valid vector found (bestVector=" << (bestVector ? "exists" : "null")
-                       << ", maxDistance=" << maxDistance << ")");
-                nfp.clear();  // Didn't close loop properly
-                break;
-            }
-
-            // Mark vertices as used
-            // JavaScript lines 1666-1667
-            if (bestVector->polygon == 'A') {
-                A[bestVector->startIndex].marked = true;
-                A[bestVector->endIndex].marked = true;
-            } else {
-                B[bestVector->startIndex].marked = true;
-                B[bestVector->endIndex].marked = true;
-            }
-
-            // STEP 4: Trim vector if needed
-            // JavaScript lines 1672-1677
-            double vecLength2 = bestVector->x * bestVector->x + bestVector->y * bestVector->y;
-            if (maxDistance * maxDistance < vecLength2 &&
-                !almostEqual(maxDistance * maxDistance, vecLength2)) {
-                double scale = std::sqrt((maxDistance * maxDistance) / vecLength2);
-                bestVector->x *= scale;
-                bestVector->y *= scale;
-            }
-
-            // Save prevVector AFTER trimming (so it matches the actual movement)
-            prevVector = *bestVector;
-
-            // STEP 5: Move reference point
-            // JavaScript lines 1679-1680
-            reference.x += bestVector->x;
-            reference.y += bestVector->y;
-            LOG_NFP("    New reference: (" << reference.x << ", " << reference.y << ")");
-
-            // STEP 6: Check loop closure
-            // JavaScript lines 1682-1700
-            if (almostEqual(reference.x, startPoint.x) && almostEqual(reference.y, startPoint.y)) {
-                LOG_NFP("    Loop closed: returned to start point (" << startPoint.x << ", " << startPoint.y << ")");
-                LOG_NFP("    Distance from start: " << std::sqrt((reference.x - startPoint.x)*(reference.x - startPoint.x) +
-                       (reference.y - startPoint.y)*(reference.y - startPoint.y)));
-                break;  // Completed loop
-            }
-
-            // Check if we've returned to any previous point (besides start)
-            // JavaScript lines 1688-1700
-            // CRITICAL: This prevents infinite loops and detects premature closure
-            bool looped = false;
-            if (nfp.size() > 0) {
-                // Check all previous points except the last one (current position)
-                for (size_t i = 0; i < nfp.size() - 1; i++) {
-                    if (almostEqual(reference.x, nfp[i].x) && almostEqual(reference.y, nfp[i].y)) {
-                        LOG_NFP("    Loop closed: returned to point " << i << " ("
-                               << nfp[i].x << ", " << nfp[i].y << ")");
-                        looped = true;
-                        break;
-                    }
-                }
-            }
-
-            if (looped) {
-                break;  // Completed loop
-            }
-
-            // Add point to NFP
-            // JavaScript lines 1702-1705
-            nfp.push_back(reference);
-
-            LOG_NFP("    Added point to NFP: (" << reference.x << ", " << reference.y << ")");
-            LOG_NFP("    NFP now has " << nfp.size() << " points");
-
-            // Update offset for next iteration
-            // JavaScript lines 1707-1708
-            offsetB.x += bestVector->x;
-            offsetB.y += bestVector->y;
-
-            LOG_NFP("    New offsetB: (" << offsetB.x << ", " << offsetB.y << ")");
-
-            counter++;
-        }
+        std::vector<Point> nfp = traceOrbit(A, B, gridA ? &*gridA : nullptr, gridB ? &*gridB : nullptr, offsetB);
 
         // Add NFP if valid
         // JavaScript lines 1713-1715
@@ -982,6 +1109,13 @@ std::vector<std::vector<Point>> noFitPolygon(const std::vector<Point>& A_input,
             break;  // Only get first NFP
         }
 
+        // Every further loop at once instead of one search per loop
+        if (parallelFor) {
+            exploreLoops(A, B, inside, gridA ? &*gridA : nullptr, gridB ? &*gridB : nullptr,
+                         MAX_NFPS, parallelFor, nfpList);
+            break;
+        }
+
         // Search for next start point
         // JavaScript line 1722
         startOpt = searchStartPoint(A, B, inside, nfpList);
@@ -1005,20 +1139,20 @@ std::vector<std::vector<Point>> noFitPolygonRectangle(const std::vector<Point>&
     double minAx = A[0].x, minAy = A[0].y;
     double maxAx = A[0].x, maxAy = A[0].y;
     for (const auto& p : A) {
-        minAx = std::min(minAx, p.x);
-        minAy = std::min(minAy, p.y);
-        maxAx = std::max(maxAx, p.x);
-        maxAy = std::max(maxAy, p.y);
+        minAx = std::min<double>(minAx, p.x);
+        minAy = std::min<double>(minAy, p.y);
+        maxAx = std::max<double>(maxAx, p.x);
+        maxAy = std::max<double>(maxAy, p.y);
     }
 
     // Find min/max of B
     double minBx = B[0].x, minBy = B[0].y;
     double maxBx = B[0].x, maxBy = B[0].y;
     for (const auto& p : B) {
-        minBx = std::min(minBx, p.x);
-        minBy = std::min(minBy, p.y);
-        maxBx = std::max(maxBx, p.x);
-        maxBy = std::max(maxBy, p.y);
+        minBx = std::min<double>(minBx, p.x);
+        minBy = std::min<double>(minBy, p.y);
+        maxBx = std::max<double>(maxBx, p.x);
+        maxBy = std::max<double>(maxBy, p.y);
     }
 
     if (maxBx - minBx > maxAx - minAx || maxBy - minBy > maxAy - minAy) {
@@ -1035,6 +1169,130 @@ std::vector<std::vector<Point>> noFitPolygonRectangle(const std::vector<Point>&
     return {nfp};
 }
 
+namespace {
+
+// Copy of the polygon without consecutive duplicate vertices
+std::vector<Point> withoutDuplicates(const std::vector<Point>& polygon) {
+    std::vector<Point> result;
+    result.reserve(polygon.size());
+    for (const auto& p : polygon) {
+        if (result.empty() || !almostEqualPoints(result.back(), p)) {
+            result.push_back(p);
+        }
+    }
+    while (result.size() > 1 && almostEqualPoints(result.back(), result.front())) {
+        result.pop_back();
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+bool isConvex(const std::vector<Point>& polygon, double tolerance) {
+    std::vector<Point> poly = withoutDuplicates(polygon);
+    const size_t n = poly.size();
+    if (n < 3) {
+        return false;
+    }
+
+    int sign = 0;
+    double turning = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        Point e1 = poly[(i + 1) % n] - poly[i];
+        Point e2 = poly[(i + 2) % n] - poly[(i + 1) % n];
+        double cross = e1.cross(e2);
+        double dot = e1.dot(e2);
+
+        // Collinear vertices do not constrain the winding
+        if (std::abs(cross) > tolerance * std::sqrt(e1.dot(e1) * e2.dot(e2))) {
+            int s = cross > 0 ? 1 : -1;
+            if (sign != 0 && s != sign) {
+                return false;
+            }
+            sign = s;
+        } else if (dot < 0) {
+            // Edge folds back on itself
+            return false;
+        }
+        turning += std::atan2(cross, dot);
+    }
+
+    // A simple convex polygon turns exactly once
+    const double fullTurn = 2.0 * std::acos(-1.0);
+    return sign != 0 && std::abs(std::abs(turning) - fullTurn) < 1e-6;
+}
+
+std::vector<Point> convexMinkowskiSum(const std::vector<Point>& A, const std::vector<Point>& B) {
+    std::vector<Point> P = withoutDuplicates(A);
+    std::vector<Point> Q = withoutDuplicates(B);
+    if (P.size() < 3 || Q.size() < 3) {
+        return {};
+    }
+
+    // Counter-clockwise (negative polygonArea in this convention)
+    if (polygonArea(P) > 0) {
+        std::reverse(P.begin(), P.end());
+    }
+    if (polygonArea(Q) > 0) {
+        std::reverse(Q.begin(), Q.end());
+    }
+
+    // Start both at the lowest (then leftmost) vertex, where edge angles begin
+    auto lowest = [](const std::vector<Point>& poly) {
+        size_t best = 0;
+        for (size_t i = 1; i < poly.size(); i++) {
+            if (poly[i].y < poly[best].y || (poly[i].y == poly[best].y && poly[i].x < poly[best].x)) {
+                best = i;
+            }
+        }
+        return best;
+    };
+
+    const size_t n = P.size();
+    const size_t m = Q.size();
+    const size_t startP = lowest(P);
+    const size_t startQ = lowest(Q);
+
+    std::vector<Point> sum;
+    sum.reserve(n + m);
+    sum.push_back(P[startP] + Q[startQ]);
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < n || j < m) {
+        Point edgeP = P[(startP + i + 1) % n] - P[(startP + i) % n];
+        Point edgeQ = Q[(startQ + j + 1) % m] - Q[(startQ + j) % m];
+
+        Point step;
+        if (j == m) {
+            step = edgeP;
+            i++;
+        } else if (i == n) {
+            step = edgeQ;
+            j++;
+        } else {
+            double cross = edgeP.cross(edgeQ);
+            if (cross > 0) {
+                step = edgeP;
+                i++;
+            } else if (cross < 0) {
+                step = edgeQ;
+                j++;
+            } else {
+                // Parallel edges merge into one
+                step = edgeP + edgeQ;
+                i++;
+                j++;
+            }
+        }
+        sum.push_back(sum.back() + step);
+    }
+
+    // The walk ends where it started
+    sum.pop_back();
+    return sum;
+}
+
 // polygonHull is now implemented in GeometryUtilAdvanced.cpp
 
 // ========== Polygon Simplification ==========
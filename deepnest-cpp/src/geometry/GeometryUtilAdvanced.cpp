@@ -1,5 +1,6 @@
 #include "../../include/deepnest/geometry/GeometryUtilAdvanced.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/geometry/EdgeGrid.h"
 #include <cmath>
 #include <algorithm>
 #include <limits>
@@ -448,6 +449,66 @@ std::optional<double> polygonSlideDistance(
     return distance;
 }
 
+std::optional<double> polygonSlideDistance(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    const Point& direction,
+    const EdgeGrid& gridA,
+    double reach)
+{
+    // Edges run i -> (i + 1) % n. Where the loop is already closed the
+    // extra edge is shorter than TOL and skipped like any other, so this is
+    // the edge set of polygonSlideDistance(A, B, direction, true).
+    if (A.empty() || B.empty()) {
+        return std::nullopt;
+    }
+
+    Point dir = normalizeVector(direction);
+    std::optional<double> distance;
+    std::vector<int> candidates;
+
+    // Every distance segmentDistance() reports is the gap between two
+    // points, one per segment, that lie within TOL of each other across
+    // the direction. A gap of at most reach therefore puts the A edge in
+    // the box the B edge sweeps over [-reach, reach]; gridA's margin
+    // absorbs the TOL.
+    const double sweepX = reach * std::abs(dir.x);
+    const double sweepY = reach * std::abs(dir.y);
+
+    for (size_t i = 0; i < B.size(); i++) {
+        const Point& B1 = B[i];
+        const Point& B2 = B[(i + 1) % B.size()];
+
+        // Ignore extremely small lines
+        if (almostEqual(B1.x, B2.x) && almostEqual(B1.y, B2.y)) {
+            continue;
+        }
+
+        gridA.overlapping(std::min(B1.x, B2.x) - sweepX, std::min(B1.y, B2.y) - sweepY,
+                          std::max(B1.x, B2.x) + sweepX, std::max(B1.y, B2.y) + sweepY,
+                          candidates);
+
+        for (int j : candidates) {
+            const Point& A1 = A[j];
+            const Point& A2 = A[(j + 1) % A.size()];
+
+            if (almostEqual(A1.x, A2.x) && almostEqual(A1.y, A2.y)) {
+                continue;
+            }
+
+            auto d = segmentDistance(B1, B2, A1, A2, dir);
+
+            if (d.has_value() && (!distance.has_value() || d.value() < distance.value())) {
+                if (d.value() > 0 || almostEqual(d.value(), 0.0)) {
+                    distance = d.value();
+                }
+            }
+        }
+    }
+
+    return distance;
+}
+
 // ========== polygonProjectionDistance ==========
 
 std::optional<double> polygonProjectionDistance(
@@ -499,16 +560,16 @@ std::optional<double> polygonProjectionDistance(
 
 // ========== searchStartPoint ==========
 
-std::optional<Point> searchStartPoint(
+// Calls visit with each start point searchStartPoint() accepts, in the order
+// it tries them, until visit returns true
+template <typename Visit>
+static void visitStartPoints(
     const std::vector<Point>& A,
     const std::vector<Point>& B,
     bool inside,
-    const std::vector<std::vector<Point>>& NFP)
+    const std::vector<std::vector<Point>>& NFP,
+    Visit visit)
 {
-    std::cerr << "\n=== searchStartPoint DEBUG ===" << std::endl;
-    std::cerr << "  A.size()=" << A.size() << ", B.size()=" << B.size()
-              << ", inside=" << inside << ", NFP.size()=" << NFP.size() << std::endl;
-
     std::vector<Point> edgeA = A;
     std::vector<Point> edgeB = B;
 
@@ -520,9 +581,6 @@ std::optional<Point> searchStartPoint(
         edgeB.push_back(edgeB.front());
     }
 
-    std::cerr << "  After closing: edgeA.size()=" << edgeA.size()
-              << ", edgeB.size()=" << edgeB.size() << std::endl;
-
     // Helper lambda to check if point already exists in NFP
     auto inNfp = [](const Point& p, const std::vector<std::vector<Point>>& nfp) -> bool {
         if (nfp.empty()) {
@@ -538,14 +596,8 @@ std::optional<Point> searchStartPoint(
         return false;
     };
 
-    int candidatesChecked = 0;
-    int candidatesWithValidBinside = 0;
-    int candidatesPassedFirstCheck = 0;
-    int candidatesTriedSliding = 0;
-
     for (size_t i = 0; i < edgeA.size() - 1; i++) {
         for (size_t j = 0; j < edgeB.size(); j++) {
-            candidatesChecked++;
             // Calculate offset to place B[j] at A[i]
             Point offset(edgeA[i].x - edgeB[j].x, edgeA[i].y - edgeB[j].y);
 
@@ -564,13 +616,8 @@ std::optional<Point> searchStartPoint(
                 // All points of B are on the boundary of A - treat as outside for OUTER NFP
                 // This can happen when B's vertices lie exactly on A's edges
                 Binside = false;
-                if (candidatesChecked <= 10) {
-                    std::cerr << "    Note: All B points on boundary, treating as outside" << std::endl;
-                }
             }
 
-            candidatesWithValidBinside++;
-
             // Check if this is a valid start point
             Point startPoint = offset;
 
@@ -580,27 +627,17 @@ std::optional<Point> searchStartPoint(
                 offsetB.push_back(Point(bp.x + offset.x, bp.y + offset.y));
             }
 
+            // Outside, the first vertex off A's boundary can be outside A
+            // while another is inside; polygonsOverlap() looks at them all
             bool insideMatch = (Binside.value() && inside) || (!Binside.value() && !inside);
-            bool noIntersection = !intersect(edgeA, offsetB);
-            bool notInNfp = !inNfp(startPoint, NFP);
-
-            if (candidatesChecked <= 10) {  // Debug first few candidates
-                std::cerr << "    Candidate [" << i << "," << j << "]: offset=(" << offset.x << "," << offset.y << ")"
-                          << " Binside=" << Binside.value()
-                          << ", inside=" << inside
-                          << ", insideMatch=" << insideMatch
-                          << ", noIntersect=" << noIntersection
-                          << ", notInNfp=" << notInNfp << std::endl;
-            }
-
-            if (insideMatch && noIntersection && notInNfp) {
-                std::cerr << "  FOUND valid start point at [" << i << "," << j << "]: ("
-                          << startPoint.x << ", " << startPoint.y << ")" << std::endl;
-                return startPoint;
+            if (insideMatch && !intersect(edgeA, offsetB) && !inNfp(startPoint, NFP) &&
+                (inside || !polygonsOverlap(A, B, startPoint))) {
+                if (visit(startPoint)) {
+                    return;
+                }
+                continue;
             }
 
-            candidatesPassedFirstCheck++;
-
             // Try sliding B along the edge vector
             Point edgeVec(edgeA[i + 1].x - edgeA[i].x, edgeA[i + 1].y - edgeA[i].y);
 
@@ -631,8 +668,6 @@ std::optional<Point> searchStartPoint(
                 continue;
             }
 
-            candidatesTriedSliding++;
-
             double vd2 = edgeVec.x * edgeVec.x + edgeVec.y * edgeVec.y;
             if (d.value() * d.value() < vd2 && !almostEqual(d.value() * d.value(), vd2)) {
                 double vd = std::sqrt(vd2);
@@ -662,21 +697,84 @@ std::optional<Point> searchStartPoint(
 
             if (Binside.has_value() &&
                 ((Binside.value() && inside) || (!Binside.value() && !inside)) &&
-                !intersect(edgeA, offsetB) && !inNfp(startPoint, NFP)) {
-                return startPoint;
+                !intersect(edgeA, offsetB) && !inNfp(startPoint, NFP) &&
+                (inside || !polygonsOverlap(A, B, startPoint))) {
+                if (visit(startPoint)) {
+                    return;
+                }
             }
         }
     }
+}
+
+bool polygonsOverlap(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    const Point& offset)
+{
+    std::vector<Point> moved;
+    moved.reserve(B.size());
+    for (const auto& p : B) {
+        moved.push_back(Point(p.x + offset.x, p.y + offset.y));
+    }
+    if (intersect(A, moved)) {
+        return true;
+    }
+
+    auto inside = [](const std::vector<Point>& points, const std::vector<Point>& polygon) {
+        for (size_t i = 0; i < points.size(); i++) {
+            const Point& a = points[i];
+            const Point& b = points[(i + 1) % points.size()];
+            if (pointInPolygon(a, polygon).value_or(false) ||
+                pointInPolygon(Point(0.5 * (a.x + b.x), 0.5 * (a.y + b.y)), polygon).value_or(false)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    return inside(moved, A) || inside(A, moved);
+}
 
-    // No valid start point found after checking all candidates
-    std::cerr << "  FAILED: No valid start point found" << std::endl;
-    std::cerr << "  Statistics:" << std::endl;
-    std::cerr << "    - Total candidates checked: " << candidatesChecked << std::endl;
-    std::cerr << "    - Candidates with valid Binside: " << candidatesWithValidBinside << std::endl;
-    std::cerr << "    - Candidates passed first check: " << candidatesPassedFirstCheck << std::endl;
-    std::cerr << "    - Candidates tried sliding: " << candidatesTriedSliding << std::endl;
+std::optional<Point> searchStartPoint(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    bool inside,
+    const std::vector<std::vector<Point>>& NFP)
+{
+    std::cerr << "\n=== searchStartPoint DEBUG ===" << std::endl;
+    std::cerr << "  A.size()=" << A.size() << ", B.size()=" << B.size()
+              << ", inside=" << inside << ", NFP.size()=" << NFP.size() << std::endl;
+
+    std::optional<Point> found;
+    visitStartPoints(A, B, inside, NFP, [&found](const Point& startPoint) {
+        found = startPoint;
+        return true;
+    });
 
-    return std::nullopt;
+    if (found) {
+        std::cerr << "  FOUND valid start point: (" << found->x << ", " << found->y << ")" << std::endl;
+    } else {
+        std::cerr << "  FAILED: No valid start point found" << std::endl;
+    }
+    return found;
+}
+
+std::vector<Point> searchStartPoints(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    bool inside)
+{
+    std::vector<Point> starts;
+    visitStartPoints(A, B, inside, {}, [&starts](const Point& startPoint) {
+        for (const auto& seen : starts) {
+            if (almostEqualPoints(seen, startPoint)) {
+                return false;
+            }
+        }
+        starts.push_back(startPoint);
+        return false;
+    });
+    return starts;
 }
 
 // ========== polygonHull ==========
@@ -1,5 +1,8 @@
 #include "../../include/deepnest/geometry/OrbitalTypes.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/geometry/EdgeGrid.h"
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <cmath>
 
@@ -10,6 +13,45 @@ using namespace GeometryUtil;
 
 namespace GeometryUtil {
 
+namespace {
+
+/**
+ * @brief Contact, if any, between vertex i / edge i of A and vertex j / edge j of B
+ */
+void addContact(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    const Point& offsetB,
+    size_t i,
+    size_t j,
+    std::vector<TouchingContact>& touching)
+{
+    size_t nexti = (i + 1) % A.size();
+    size_t nextj = (j + 1) % B.size();
+
+    // Translate B vertices by current offset
+    Point Bj_translated(B[j].x + offsetB.x, B[j].y + offsetB.y);
+    Point Bnextj_translated(B[nextj].x + offsetB.x, B[nextj].y + offsetB.y);
+
+    // Type 0: Vertex-to-vertex contact
+    // JavaScript: if(_almostEqual(A[i].x, B[j].x+B.offsetx) && _almostEqual(A[i].y, B[j].y+B.offsety))
+    if (almostEqual(A[i].x, Bj_translated.x) && almostEqual(A[i].y, Bj_translated.y)) {
+        touching.push_back({TouchingType::VERTEX_VERTEX, (int)i, (int)j});
+    }
+    // Type 1: B vertex lies on A edge
+    // JavaScript: else if(_onSegment(A[i],A[nexti],{x: B[j].x+B.offsetx, y: B[j].y + B.offsety}))
+    else if (onSegment(A[i], A[nexti], Bj_translated)) {
+        touching.push_back({TouchingType::VERTEX_ON_EDGE_A, (int)nexti, (int)j});
+    }
+    // Type 2: A vertex lies on B edge
+    // JavaScript: else if(_onSegment({x: B[j].x+B.offsetx, ...},{x: B[nextj].x+B.offsetx, ...},A[i]))
+    else if (onSegment(Bj_translated, Bnextj_translated, A[i])) {
+        touching.push_back({TouchingType::VERTEX_ON_EDGE_B, (int)i, (int)nextj});
+    }
+}
+
+} // anonymous namespace
+
 /**
  * @brief Find all touching contacts between polygons A and B
  *
@@ -33,33 +75,51 @@ std::vector<TouchingContact> findTouchingContacts(
     std::vector<TouchingContact> touching;
 
     for (size_t i = 0; i < A.size(); i++) {
-        size_t nexti = (i + 1) % A.size();
-
         for (size_t j = 0; j < B.size(); j++) {
-            size_t nextj = (j + 1) % B.size();
-
-            // Translate B vertices by current offset
-            Point Bj_translated(B[j].x + offsetB.x, B[j].y + offsetB.y);
-            Point Bnextj_translated(B[nextj].x + offsetB.x, B[nextj].y + offsetB.y);
-
-            // Type 0: Vertex-to-vertex contact
-            // JavaScript: if(_almostEqual(A[i].x, B[j].x+B.offsetx) && _almostEqual(A[i].y, B[j].y+B.offsety))
-            if (almostEqual(A[i].x, Bj_translated.x) && almostEqual(A[i].y, Bj_translated.y)) {
-                touching.push_back({TouchingType::VERTEX_VERTEX, (int)i, (int)j});
-            }
-            // Type 1: B vertex lies on A edge
-            // JavaScript: else if(_onSegment(A[i],A[nexti],{x: B[j].x+B.offsetx, y: B[j].y + B.offsety}))
-            else if (onSegment(A[i], A[nexti], Bj_translated)) {
-                touching.push_back({TouchingType::VERTEX_ON_EDGE_A, (int)nexti, (int)j});
-            }
-            // Type 2: A vertex lies on B edge
-            // JavaScript: else if(_onSegment({x: B[j].x+B.offsetx, ...},{x: B[nextj].x+B.offsetx, ...},A[i]))
-            else if (onSegment(Bj_translated, Bnextj_translated, A[i])) {
-                touching.push_back({TouchingType::VERTEX_ON_EDGE_B, (int)i, (int)nextj});
-            }
+            addContact(A, B, offsetB, i, j, touching);
+        }
+    }
+
+    return touching;
+}
+
+/**
+ * @brief Find all touching contacts, testing only pairs the grids put together
+ *
+ * Every contact needs vertex B[j] within TOL of edge i of A (types 0 and
+ * 1) or vertex A[i] within TOL of edge j of B (type 2), so looking up each
+ * vertex in the other polygon's grid finds every pair that can touch.
+ * The pairs are visited in the order of the full scan, which keeps the
+ * list identical to findTouchingContacts(A, B, offsetB).
+ */
+std::vector<TouchingContact> findTouchingContacts(
+    const std::vector<Point>& A,
+    const std::vector<Point>& B,
+    const Point& offsetB,
+    const EdgeGrid& gridA,
+    const EdgeGrid& gridB)
+{
+    std::vector<std::pair<int, int>> pairs;
+
+    for (size_t j = 0; j < B.size(); j++) {
+        for (int i : gridA.near(B[j].x + offsetB.x, B[j].y + offsetB.y)) {
+            pairs.emplace_back(i, (int)j);
+        }
+    }
+    for (size_t i = 0; i < A.size(); i++) {
+        for (int j : gridB.near(A[i].x - offsetB.x, A[i].y - offsetB.y)) {
+            pairs.emplace_back((int)i, j);
         }
     }
 
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    std::vector<TouchingContact> touching;
+    for (const auto& pair : pairs) {
+        addContact(A, B, offsetB, pair.first, pair.second, touching);
+    }
+
     return touching;
 }
 
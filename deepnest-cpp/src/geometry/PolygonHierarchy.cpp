@@ -1,81 +1,141 @@
 #include "../../include/deepnest/geometry/PolygonHierarchy.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/core/CoordinateBuffer.h"
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 
 namespace deepnest {
 
-int PolygonHierarchy::buildTreeRecursive(std::vector<Polygon>& list, int id) {
-    // JavaScript: var parents = [];
-    std::vector<Polygon*> parents;
-    
+namespace {
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+using IndexPoint = bg::model::point<double, 2, bg::cs::cartesian>;
+using IndexBox = bg::model::box<IndexPoint>;
+using IndexEntry = std::pair<IndexBox, size_t>;
+
+// Below this many contours one thread finds the parents faster than
+// several can be handed the work
+const size_t PARALLEL_MIN_CONTOURS = 256;
+
+} // anonymous namespace
+
+int PolygonHierarchy::buildTreeRecursive(std::vector<Polygon>& list, int id,
+                                         const ParallelFor& parallelFor) {
+    // Each outline is tested against other polygons' first points;
+    // contiguous copies let those tests run on the vector kernels
+    std::vector<CoordinateBuffer> outlines;
+    outlines.reserve(list.size());
+    for (const Polygon& poly : list) {
+        outlines.emplace_back(poly.points);
+    }
+
+    // A point strictly inside an outline lies inside its bounds, so an
+    // R-tree over the bounds (bulk loaded) leaves only the contours worth
+    // testing. The bounds are padded by TOL against rounding at the edges
+    std::vector<IndexEntry> entries;
+    entries.reserve(list.size());
+    for (size_t j = 0; j < list.size(); ++j) {
+        if (outlines[j].empty()) {
+            continue;
+        }
+        const BoundingBox box = outlines[j].bounds();
+        entries.emplace_back(IndexBox(IndexPoint(box.x - TOL, box.y - TOL),
+                                      IndexPoint(box.x + box.width + TOL, box.y + box.height + TOL)),
+                             j);
+    }
+    const bgi::rtree<IndexEntry, bgi::rstar<16>> index(entries.begin(), entries.end());
+
     // JavaScript: for(i=0; i<list.length; i++)
-    // Identify which polygons are children and which are parents
-    for (size_t i = 0; i < list.size(); ++i) {
-        Polygon& p = list[i];
-        bool isChild = false;
-        
-        // JavaScript: for(j=0; j<list.length; j++)
-        // Check if p is inside any other polygon
-        for (size_t j = 0; j < list.size(); ++j) {
-            if (i == j) continue;
-            
-            // JavaScript: if(GeometryUtil.pointInPolygon(p[0], list[j]) === true)
-            // Check if first point of p is inside list[j]
-            if (!p.points.empty() && !list[j].points.empty()) {
-                auto result = GeometryUtil::pointInPolygon(p.points[0], list[j].points);
-                
+    //               for(j=0; j<list.length; j++)
+    //                 if(GeometryUtil.pointInPolygon(p[0], list[j]) === true) { ... break; }
+    // The parent of p is the first polygon, in list order, that strictly
+    // contains its first point; candidates are tested in that order
+    std::vector<ptrdiff_t> parentOf(list.size(), -1);
+    auto findParents = [&](size_t begin, size_t end) {
+        std::vector<IndexEntry> hits;
+        std::vector<size_t> candidates;
+        for (size_t i = begin; i < end; ++i) {
+            if (list[i].points.empty()) {
+                continue;
+            }
+            const Point& first = list[i].points[0];
+
+            hits.clear();
+            index.query(bgi::intersects(IndexPoint(first.x, first.y)), std::back_inserter(hits));
+            candidates.clear();
+            for (const auto& hit : hits) {
+                candidates.push_back(hit.second);
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (size_t j : candidates) {
+                if (j == i) {
+                    continue;
+                }
                 // Only consider definite containment (not on edge)
-                if (result.has_value() && result.value() == true) {
-                    // JavaScript: if(!list[j].children) { list[j].children = []; }
-                    //             list[j].children.push(p);
-                    //             p.parent = list[j];
-                    //             ischild = true;
-                    list[j].children.push_back(p);
-                    isChild = true;
+                auto result = outlines[j].pointInPolygon(first);
+                if (result.has_value() && result.value()) {
+                    parentOf[i] = static_cast<ptrdiff_t>(j);
                     break;
                 }
             }
         }
-        
-        // JavaScript: if(!ischild) { parents.push(p); }
-        if (!isChild) {
-            parents.push_back(&p);
+    };
+    if (parallelFor && list.size() >= PARALLEL_MIN_CONTOURS) {
+        parallelFor(list.size(), findParents);
+    } else {
+        findParents(0, list.size());
+    }
+
+    // JavaScript: list[j].children.push(p); ... if(!ischild) { parents.push(p); }
+    // Children keep list order. JavaScript shares p by reference, so its
+    // own children travel with it; a child moves here with its subtree.
+    // Contours that contain each other in a cycle reach no parent and
+    // are dropped, as in JavaScript
+    std::vector<std::vector<size_t>> children(list.size());
+    std::vector<size_t> parents;
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (parentOf[i] < 0) {
+            parents.push_back(i);
+        } else {
+            children[parentOf[i]].push_back(i);
         }
     }
-    
+
+    std::function<Polygon(size_t)> take = [&](size_t i) {
+        Polygon poly = std::move(list[i]);
+        for (size_t child : children[i]) {
+            poly.children.push_back(take(child));
+        }
+        return poly;
+    };
+
     // JavaScript: for(i=0; i<list.length; i++)
     //             if(parents.indexOf(list[i]) < 0) {
     //               list.splice(i, 1);
     //               i--;
     //             }
-    // Remove children from main list (keep only parents)
-    list.erase(
-        std::remove_if(list.begin(), list.end(),
-            [&parents](const Polygon& poly) {
-                // Check if this polygon is NOT in parents list
-                return std::find_if(parents.begin(), parents.end(),
-                    [&poly](const Polygon* p) {
-                        return p->points == poly.points; // Compare by points
-                    }) == parents.end();
-            }),
-        list.end()
-    );
-    
+    // Keep only parents, with their children nested
+    std::vector<Polygon> tree;
+    tree.reserve(parents.size());
+    for (size_t i : parents) {
+        tree.push_back(take(i));
+    }
+    list = std::move(tree);
+
     // JavaScript: for(i=0; i<parents.length; i++)
     //             parents[i].id = id;
     //             id++;
-    // Assign IDs to parent polygons
-    for (Polygon* parent : parents) {
-        // Find the polygon in the list and assign ID
-        for (Polygon& poly : list) {
-            if (poly.points == parent->points) {
-                poly.id = id++;
-                break;
-            }
-        }
+    for (Polygon& poly : list) {
+        poly.id = id++;
     }
-    
+
     // JavaScript: for(i=0; i<parents.length; i++)
     //             if(parents[i].children) {
     //               id = toTree(parents[i].children, id);
@@ -83,24 +143,25 @@ int PolygonHierarchy::buildTreeRecursive(std::vector<Polygon>& list, int id) {
     // Recursively process children
     for (Polygon& poly : list) {
         if (!poly.children.empty()) {
-            id = buildTreeRecursive(poly.children, id);
+            id = buildTreeRecursive(poly.children, id, parallelFor);
         }
     }
-    
+
     // JavaScript: return id;
     return id;
 }
 
 std::vector<Polygon> PolygonHierarchy::buildTree(
     std::vector<Polygon>& polygons,
-    int idStart
+    int idStart,
+    const ParallelFor& parallelFor
 ) {
     if (polygons.empty()) {
         return {};
     }
     
     // Call recursive function
-    buildTreeRecursive(polygons, idStart);
+    buildTreeRecursive(polygons, idStart, parallelFor);
     
     // polygons now contains only top-level polygons with children nested
     return polygons;
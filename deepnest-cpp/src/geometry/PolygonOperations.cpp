@@ -1,7 +1,10 @@
 #include "../../include/deepnest/geometry/PolygonOperations.h"
 #include "../../include/deepnest/config/DeepNestConfig.h"
+#include "../../include/deepnest/geometry/ClipperContext.h"
+#include "../../include/deepnest/Trace.h"
 #include <clipper2/clipper.h>
 #include <algorithm>
+#include <cmath>
 
 namespace deepnest {
 
@@ -38,6 +41,19 @@ static Path64 toClipperPath64(const std::vector<Point>& poly, double scale) {
     return path;
 }
 
+static Path64 toClipperPath64(const std::vector<Point>& poly, double scale,
+                              const Point& offset) {
+    Path64 path;
+    path.reserve(poly.size());
+    for (const auto& p : poly) {
+        path.push_back(Point64(
+            static_cast<int64_t>((p.x + offset.x) * scale),
+            static_cast<int64_t>((p.y + offset.y) * scale)
+        ));
+    }
+    return path;
+}
+
 static std::vector<Point> fromClipperPath64(const Path64& path, double scale) {
     std::vector<Point> poly;
     poly.reserve(path.size());
@@ -51,6 +67,13 @@ static std::vector<Point> fromClipperPath64(const Path64& path, double scale) {
     return poly;
 }
 
+// Clipper output of the operations below; converted to points before
+// each one returns, so one buffer per thread serves them all
+static Paths64& solutionBuffer() {
+    static thread_local Paths64 solution;
+    return solution;
+}
+
 // ========== Public Methods ==========
 
 std::vector<std::vector<Point>> PolygonOperations::offset(
@@ -58,6 +81,15 @@ std::vector<std::vector<Point>> PolygonOperations::offset(
     double delta,
     double miterLimit,
     double arcTolerance) {
+    return offset(poly, delta, miterLimit, arcTolerance, DeepNestConfig::getInstance().getClipperScale());
+}
+
+std::vector<std::vector<Point>> PolygonOperations::offset(
+    const std::vector<Point>& poly,
+    double delta,
+    double miterLimit,
+    double arcTolerance,
+    double scale) {
 
     if (poly.size() < 3) {
         return {};
@@ -66,35 +98,45 @@ std::vector<std::vector<Point>> PolygonOperations::offset(
     // Convert to Clipper path
     PathD pathD = toClipperPathD(poly);
 
-    // Perform offset operation
-    PathsD solution = InflatePaths(
-        {pathD},
-        delta,
-        JoinType::Miter,
-        EndType::Polygon,
-        miterLimit,
-        arcTolerance
-    );
+    // Round to the decimals the Clipper scale resolves (InflatePaths takes
+    // the precision before the arc tolerance; 8 is its maximum)
+    const int precision = std::max(0, std::min(8, static_cast<int>(std::floor(std::log10(scale)))));
+
+    // InflatePaths on the thread's offset engine: scale to integers at
+    // that precision, offset and scale back
+    if (delta == 0.0) {
+        return {poly};
+    }
+    const double precisionScale = std::pow(10, precision);
+    int errorCode = 0;
+    const Paths64 scaled = ScalePaths<int64_t, double>(PathsD{pathD}, precisionScale, errorCode);
+    if (errorCode) {
+        return {};
+    }
+
+    Paths64& solution = solutionBuffer();
+    ClipperContext::local().offset(scaled, delta * precisionScale, JoinType::Miter,
+                                   miterLimit, arcTolerance * precisionScale, solution);
 
     // Convert results back
     std::vector<std::vector<Point>> result;
     result.reserve(solution.size());
     for (const auto& path : solution) {
-        result.push_back(fromClipperPathD(path));
+        result.push_back(fromClipperPath64(path, precisionScale));
     }
 
     return result;
 }
 
 std::vector<Point> PolygonOperations::cleanPolygon(const std::vector<Point>& poly) {
+    return cleanPolygon(poly, DeepNestConfig::getInstance().getClipperScale());
+}
+
+std::vector<Point> PolygonOperations::cleanPolygon(const std::vector<Point>& poly, double scale) {
     if (poly.size() < 3) {
         return {};
     }
 
-    // Get clipper scale from config
-    auto& config = DeepNestConfig::getInstance();
-    double scale = config.getClipperScale();
-
     // Convert to Clipper path
     Path64 path = toClipperPath64(poly, scale);
 
@@ -165,10 +207,6 @@ std::vector<Point> PolygonOperations::simplifyPolygon(
         return poly;
     }
 
-    // Get clipper scale from config
-    auto& config = DeepNestConfig::getInstance();
-    double scale = config.getClipperScale();
-
     // Convert to Clipper path
     PathD pathD = toClipperPathD(poly);
 
@@ -181,6 +219,7 @@ std::vector<Point> PolygonOperations::simplifyPolygon(
 
 std::vector<std::vector<Point>> PolygonOperations::unionPolygons(
     const std::vector<std::vector<Point>>& polygons) {
+    TRACE_SCOPE("clip.union");
 
     if (polygons.empty()) {
         return {};
@@ -203,7 +242,8 @@ std::vector<std::vector<Point>> PolygonOperations::unionPolygons(
     }
 
     // Perform union
-    Paths64 solution = Union(paths, FillRule::NonZero);
+    Paths64& solution = solutionBuffer();
+    ClipperContext::local().unite(paths, solution);
 
     // Convert results back
     std::vector<std::vector<Point>> result;
@@ -215,6 +255,136 @@ std::vector<std::vector<Point>> PolygonOperations::unionPolygons(
     return result;
 }
 
+std::vector<std::vector<Point>> PolygonOperations::unionPolygons(
+    const std::vector<const std::vector<Point>*>& polygons,
+    const std::vector<Point>& offsets) {
+    TRACE_SCOPE("clip.union");
+
+    if (polygons.empty() || polygons.size() != offsets.size()) {
+        return {};
+    }
+
+    // Get clipper scale from config
+    auto& config = DeepNestConfig::getInstance();
+    double scale = config.getClipperScale();
+
+    // Convert all polygons to Clipper paths, translating on the fly
+    Paths64 paths;
+    paths.reserve(polygons.size());
+    for (size_t i = 0; i < polygons.size(); i++) {
+        if (polygons[i] && polygons[i]->size() >= 3) {
+            paths.push_back(toClipperPath64(*polygons[i], scale, offsets[i]));
+        }
+    }
+
+    if (paths.empty()) {
+        return {};
+    }
+
+    // Perform union
+    Paths64& solution = solutionBuffer();
+    ClipperContext::local().unite(paths, solution);
+
+    // Convert results back
+    std::vector<std::vector<Point>> result;
+    result.reserve(solution.size());
+    for (const auto& path : solution) {
+        result.push_back(fromClipperPath64(path, scale));
+    }
+
+    return result;
+}
+
+Paths64 PolygonOperations::unionPaths(
+    const std::vector<const Path64*>& paths,
+    const std::vector<Point>& offsets) {
+    const DeepNestConfig& config = DeepNestConfig::getInstance();
+    return unionPaths(paths, offsets, config.getClipperScale(), config.integerGeometry);
+}
+
+Paths64 PolygonOperations::unionPaths(
+    const std::vector<const Path64*>& paths,
+    const std::vector<Point>& offsets,
+    double scale,
+    bool integerGeometry) {
+    TRACE_SCOPE("clip.union");
+
+    if (paths.empty() || paths.size() != offsets.size()) {
+        return {};
+    }
+
+    // Translate in integer coordinates; the paths are already scaled
+    Paths64 shifted;
+    shifted.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!paths[i] || paths[i]->size() < 3) {
+            continue;
+        }
+        const int64_t dx = toClipperUnits(offsets[i].x, scale, integerGeometry);
+        const int64_t dy = toClipperUnits(offsets[i].y, scale, integerGeometry);
+
+        Path64 path;
+        path.reserve(paths[i]->size());
+        for (const auto& p : *paths[i]) {
+            path.push_back(Point64(p.x + dx, p.y + dy));
+        }
+        shifted.push_back(std::move(path));
+    }
+
+    if (shifted.empty()) {
+        return {};
+    }
+
+    Paths64 solution;
+    ClipperContext::local().unite(shifted, solution);
+    return solution;
+}
+
+std::vector<std::vector<Point>> PolygonOperations::differencePaths(
+    const Path64& subject,
+    const Paths64& clip) {
+    return differencePaths(subject, clip, DeepNestConfig::getInstance().getClipperScale());
+}
+
+std::vector<std::vector<Point>> PolygonOperations::differencePaths(
+    const Path64& subject,
+    const Paths64& clip,
+    double scale) {
+    TRACE_SCOPE("clip.difference");
+
+    if (subject.size() < 3) {
+        return {};
+    }
+
+    Paths64& solution = solutionBuffer();
+    ClipperContext::local().difference(subject, clip, solution);
+
+    // Convert results back
+    std::vector<std::vector<Point>> result;
+    result.reserve(solution.size());
+    for (const auto& path : solution) {
+        result.push_back(fromClipperPath64(path, scale));
+    }
+
+    return result;
+}
+
+Path64 PolygonOperations::toPath64(const std::vector<Point>& poly) {
+    return toClipperPath64(poly, DeepNestConfig::getInstance().getClipperScale());
+}
+
+Path64 PolygonOperations::toPath64(const std::vector<Point>& poly, double scale) {
+    return toClipperPath64(poly, scale);
+}
+
+std::vector<Point> PolygonOperations::fromPath64(const Path64& path) {
+    return fromClipperPath64(path, DeepNestConfig::getInstance().getClipperScale());
+}
+
+std::vector<Point> PolygonOperations::fromPath64(const Path64& path, double scale) {
+    return fromClipperPath64(path, scale);
+}
+
 std::vector<std::vector<Point>> PolygonOperations::intersectPolygons(
     const std::vector<Point>& polyA,
     const std::vector<Point>& polyB) {
@@ -232,7 +402,8 @@ std::vector<std::vector<Point>> PolygonOperations::intersectPolygons(
     Path64 pathB = toClipperPath64(polyB, scale);
 
     // Perform intersection
-    Paths64 solution = Intersect({pathA}, {pathB}, FillRule::NonZero);
+    Paths64& solution = solutionBuffer();
+    ClipperContext::local().intersect(pathA, pathB, solution);
 
     // Convert results back
     std::vector<std::vector<Point>> result;
@@ -247,6 +418,14 @@ std::vector<std::vector<Point>> PolygonOperations::intersectPolygons(
 std::vector<std::vector<Point>> PolygonOperations::differencePolygons(
     const std::vector<Point>& polyA,
     const std::vector<Point>& polyB) {
+    return differencePolygons(polyA, polyB, DeepNestConfig::getInstance().getClipperScale());
+}
+
+std::vector<std::vector<Point>> PolygonOperations::differencePolygons(
+    const std::vector<Point>& polyA,
+    const std::vector<Point>& polyB,
+    double scale) {
+    TRACE_SCOPE("clip.difference");
 
     if (polyA.size() < 3) {
         return {};
@@ -256,16 +435,13 @@ std::vector<std::vector<Point>> PolygonOperations::differencePolygons(
         return {polyA};  // Nothing to subtract
     }
 
-    // Get clipper scale from config
-    auto& config = DeepNestConfig::getInstance();
-    double scale = config.getClipperScale();
-
     // Convert to Clipper paths
     Path64 pathA = toClipperPath64(polyA, scale);
     Path64 pathB = toClipperPath64(polyB, scale);
 
     // Perform difference
-    Paths64 solution = Difference({pathA}, {pathB}, FillRule::NonZero);
+    Paths64& solution = solutionBuffer();
+    ClipperContext::local().difference(pathA, pathB, solution);
 
     // Convert results back
     std::vector<std::vector<Point>> result;
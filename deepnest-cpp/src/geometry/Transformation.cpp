@@ -147,6 +147,61 @@ std::vector<Point> Transformation::apply(const std::vector<Point>& points, bool
     return transformed;
 }
 
+void Transformation::applyBatch(const std::vector<BatchItem>& items, RingBatch& batch) {
+    batch.clear();
+
+    size_t total = 0;
+    for (const auto& item : items) {
+        total += item.ring ? item.ring->size() : 0;
+    }
+    batch.points.resize(total);
+    batch.starts.reserve(items.size() + 1);
+
+    // Placements use a handful of angles
+    struct Turn {
+        double degrees;
+        double cosA;
+        double sinA;
+    };
+    std::vector<Turn> turns;
+
+    size_t next = 0;
+    for (const auto& item : items) {
+        const Turn* turn = nullptr;
+        for (const auto& known : turns) {
+            if (known.degrees == item.rotation) {
+                turn = &known;
+                break;
+            }
+        }
+        if (!turn) {
+            // rotate(0) keeps the identity, whose entries are cos 0 and sin 0
+            const double rad = item.rotation * M_PI / 180.0;
+            turns.push_back({item.rotation, std::cos(rad), std::sin(rad)});
+            turn = &turns.back();
+        }
+
+        // apply() of the rotation, then of the translation:
+        // x' = (cos * x + -sin * y) + dx, y' = (sin * x + cos * y) + dy
+        const double a = turn->cosA;
+        const double b = turn->sinA;
+        const double c = -turn->sinA;
+        const double d = turn->cosA;
+        const double dx = item.offset.x;
+        const double dy = item.offset.y;
+        if (item.ring) {
+            Point* out = batch.points.data() + next;
+            for (const auto& p : *item.ring) {
+                out->x = (a * p.x + c * p.y) + dx;
+                out->y = (b * p.x + d * p.y) + dy;
+                ++out;
+            }
+            next += item.ring->size();
+        }
+        batch.starts.push_back(next);
+    }
+}
+
 // Static factory methods
 
 Transformation Transformation::createRotation(double angleDegrees, double cx, double cy) {
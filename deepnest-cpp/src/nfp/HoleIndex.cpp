@@ -0,0 +1,85 @@
+#include "../../include/deepnest/nfp/HoleIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace deepnest {
+
+namespace {
+
+// Relative slack on every comparison, so an exact fit computed from
+// rounded coordinates is not rejected
+const double FIT_SLACK = 1e-6;
+
+double perimeter(const std::vector<Point>& points) {
+    double length = 0.0;
+    for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+        length += std::hypot(points[i].x - points[j].x, points[i].y - points[j].y);
+    }
+    return length;
+}
+
+bool fitsWithin(double inner, double outer) {
+    return inner <= outer * (1.0 + FIT_SLACK) + FIT_SLACK;
+}
+
+} // anonymous namespace
+
+HoleIndex::HoleIndex(const Polygon& part) {
+    holes_.reserve(part.children.size());
+    for (const auto& hole : part.children) {
+        holes_.push_back(container(hole));
+    }
+}
+
+HoleIndex::Extent HoleIndex::footprint(const Polygon& B) {
+    Extent extent;
+    if (B.points.size() < 3) {
+        return extent;
+    }
+    const BoundingBox box = B.bounds();
+    extent.width = box.width;
+    extent.height = box.height;
+    extent.area = std::abs(B.area());
+    // A convex outline holds a disc of radius at least area / perimeter
+    if (B.convex) {
+        const double length = perimeter(B.points);
+        if (length > 0.0) {
+            extent.inradius = extent.area / length;
+        }
+    }
+    return extent;
+}
+
+HoleIndex::Extent HoleIndex::container(const Polygon& hole) {
+    Extent extent;
+    if (hole.points.size() < 3) {
+        return extent;
+    }
+    const BoundingBox box = hole.bounds();
+    extent.width = box.width;
+    extent.height = box.height;
+    extent.area = std::abs(hole.area());
+    // An inscribed disc fits the bounding box and cannot exceed the area
+    extent.inradius = std::min(0.5 * std::min(box.width, box.height),
+                               std::sqrt(extent.area / M_PI));
+    return extent;
+}
+
+bool HoleIndex::mayFit(const Extent& container, const Extent& footprint) {
+    return fitsWithin(footprint.width, container.width) &&
+           fitsWithin(footprint.height, container.height) &&
+           fitsWithin(footprint.area, container.area) &&
+           fitsWithin(footprint.inradius, container.inradius);
+}
+
+std::vector<size_t> HoleIndex::candidates(const Extent& footprint) const {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < holes_.size(); ++i) {
+        if (mayFit(holes_[i], footprint)) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+} // namespace deepnest
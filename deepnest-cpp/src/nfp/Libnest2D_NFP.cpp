@@ -857,7 +857,7 @@ namespace libnest2d_port {
     libnfporb::polygon_t toLibnfporb(const Polygon& p) {
         libnfporb::polygon_t lp;
         for (const auto& pt : p.points) {
-            lp.outer().push_back({pt.x, pt.y});
+            lp.outer().push_back({static_cast<double>(pt.x), static_cast<double>(pt.y)});
         }
         // Ensure closed
         if (!lp.outer().empty() && lp.outer().front() != lp.outer().back()) {
@@ -868,7 +868,7 @@ namespace libnest2d_port {
         for (const auto& hole : p.children) {
             libnfporb::polygon_t::ring_type ring;
             for (const auto& pt : hole.points) {
-                ring.push_back({pt.x, pt.y});
+                ring.push_back({static_cast<double>(pt.x), static_cast<double>(pt.y)});
             }
             if (!ring.empty() && ring.front() != ring.back()) {
                 ring.push_back(ring.front());
@@ -23,69 +23,95 @@ namespace deepnest {
     // Forward declarations of helper functions from minkowski.cc
     namespace {
 
-        void convolve_two_segments(std::vector<IntPoint>& figure,
-            const IntEdge& a,
-            const IntEdge& b) {
-            figure.clear();
-            figure.push_back(IntPoint(a.first));
-            figure.push_back(IntPoint(a.first));
-            figure.push_back(IntPoint(a.second));
-            figure.push_back(IntPoint(a.second));
-            convolve(figure[0], b.second);
-            convolve(figure[1], b.first);
-            convolve(figure[2], b.first);
-            convolve(figure[3], b.second);
+        // Area type polygon_set_data uses to pick the winding of an inserted polygon_data
+        using QuadArea = area_type_by_domain<
+            geometry_domain<geometry_concept<IntPolygon>::type>::type, int>::type;
+
+        /**
+         * @brief Number of edge-pair quads convolve_two_point_sequences emits
+         */
+        std::size_t edge_pair_count(std::size_t aPoints, std::size_t bPoints) {
+            return (aPoints < 2 || bPoints < 2) ? 0 : (aPoints - 1) * (bPoints - 1);
         }
 
+        /**
+         * @brief Convolve every edge of A with every edge of B
+         *
+         * All edge-pair quads are first written to one flat buffer (a flat
+         * loop over contiguous points that the compiler can vectorize) and
+         * then inserted as raw vertex sequences. The edges, windings and
+         * insertion order are the same as inserting one polygon_data per
+         * pair, so the resulting set is identical, without the per-quad
+         * polygon copies.
+         */
         template <typename itrT1, typename itrT2>
         void convolve_two_point_sequences(IntPolygonSet& result,
+            std::vector<IntPoint>& quads,
             itrT1 ab, itrT1 ae,
             itrT2 bb, itrT2 be) {
             if (ab == ae || bb == be)
                 return;
 
-            IntPoint first_a = *ab;
-            IntPoint prev_a = *ab;
-            std::vector<IntPoint> vec;
-            IntPolygon poly;
-            ++ab;
-
-            for (; ab != ae; ++ab) {
-                IntPoint first_b = *bb;
-                IntPoint prev_b = *bb;
-                itrT2 tmpb = bb;
-                ++tmpb;
-
-                for (; tmpb != be; ++tmpb) {
-                    convolve_two_segments(vec,
-                        std::make_pair(prev_b, *tmpb),
-                        std::make_pair(prev_a, *ab));
-                    set_points(poly, vec.begin(), vec.end());
-                    result.insert(poly);
-                    prev_b = *tmpb;
+            const std::vector<IntPoint> a(ab, ae);
+            const std::vector<IntPoint> b(bb, be);
+            const std::size_t pairs = edge_pair_count(a.size(), b.size());
+            if (pairs == 0)
+                return;
+
+            quads.resize(pairs * 4);
+            IntPoint* q = quads.data();
+            for (std::size_t i = 1; i < a.size(); ++i) {
+                const int a0x = a[i - 1].x(), a0y = a[i - 1].y();
+                const int a1x = a[i].x(), a1y = a[i].y();
+                for (std::size_t j = 1; j < b.size(); ++j, q += 4) {
+                    const int b0x = b[j - 1].x(), b0y = b[j - 1].y();
+                    const int b1x = b[j].x(), b1y = b[j].y();
+                    q[0] = IntPoint(b0x + a1x, b0y + a1y);
+                    q[1] = IntPoint(b0x + a0x, b0y + a0y);
+                    q[2] = IntPoint(b1x + a0x, b1y + a0y);
+                    q[3] = IntPoint(b1x + a1x, b1y + a1y);
                 }
-                prev_a = *ab;
+            }
+
+            for (const IntPoint* quad = quads.data(); quad != q; quad += 4) {
+                // Same winding rule as polygon_set_data::insert(polygon_data)
+                direction_1d winding = point_sequence_area<const IntPoint*, QuadArea>(quad, quad + 4) < 0
+                    ? COUNTERCLOCKWISE : CLOCKWISE;
+                result.insert_vertex_sequence(quad, quad + 4, winding, false);
             }
         }
 
         template <typename itrT>
         void convolve_point_sequence_with_polygons(IntPolygonSet& result,
+            std::vector<IntPoint>& quads,
             itrT b, itrT e,
             const std::vector<IntPolygonWithHoles>& polygons) {
             for (std::size_t i = 0; i < polygons.size(); ++i) {
-                convolve_two_point_sequences(result, b, e,
+                convolve_two_point_sequences(result, quads, b, e,
                     begin_points(polygons[i]),
                     end_points(polygons[i]));
 
                 for (auto itrh = begin_holes(polygons[i]);
                     itrh != end_holes(polygons[i]); ++itrh) {
-                    convolve_two_point_sequences(result, b, e,
+                    convolve_two_point_sequences(result, quads, b, e,
                         begin_points(*itrh),
                         end_points(*itrh));
                 }
             }
         }
 
+        /**
+         * @brief Point counts of a polygon's outer ring and holes
+         */
+        std::vector<std::size_t> ring_sizes(const IntPolygonWithHoles& polygon) {
+            std::vector<std::size_t> sizes;
+            sizes.push_back(std::distance(begin_points(polygon), end_points(polygon)));
+            for (auto itrh = begin_holes(polygon); itrh != end_holes(polygon); ++itrh) {
+                sizes.push_back(std::distance(begin_points(*itrh), end_points(*itrh)));
+            }
+            return sizes;
+        }
+
         void convolve_two_polygon_sets(IntPolygonSet& result,
             const IntPolygonSet& a,
             const IntPolygonSet& b) {
@@ -95,15 +121,42 @@ namespace deepnest {
             a.get(a_polygons);
             b.get(b_polygons);
 
+            // Reserve the edge storage for every quad once instead of
+            // growing it quad by quad
+            std::vector<std::size_t> a_rings;
+            std::vector<std::size_t> b_rings;
+            for (const auto& polygon : a_polygons) {
+                auto sizes = ring_sizes(polygon);
+                a_rings.insert(a_rings.end(), sizes.begin(), sizes.end());
+            }
+            for (const auto& polygon : b_polygons) {
+                auto sizes = ring_sizes(polygon);
+                b_rings.insert(b_rings.end(), sizes.begin(), sizes.end());
+            }
+            std::size_t total_pairs = 0;
+            std::size_t max_pairs = 0;
+            for (std::size_t na : a_rings) {
+                for (std::size_t nb : b_rings) {
+                    std::size_t pairs = edge_pair_count(na, nb);
+                    total_pairs += pairs;
+                    max_pairs = std::max(max_pairs, pairs);
+                }
+            }
+            result.reserve(total_pairs * 4);
+
+            // Quad buffer shared by all ring pairs
+            std::vector<IntPoint> quads;
+            quads.reserve(max_pairs * 4);
+
             for (std::size_t ai = 0; ai < a_polygons.size(); ++ai) {
-                convolve_point_sequence_with_polygons(result,
+                convolve_point_sequence_with_polygons(result, quads,
                     begin_points(a_polygons[ai]),
                     end_points(a_polygons[ai]),
                     b_polygons);
 
                 for (auto itrh = begin_holes(a_polygons[ai]);
                     itrh != end_holes(a_polygons[ai]); ++itrh) {
-                    convolve_point_sequence_with_polygons(result,
+                    convolve_point_sequence_with_polygons(result, quads,
                         begin_points(*itrh),
                         end_points(*itrh),
                         b_polygons);
@@ -138,19 +191,19 @@ namespace deepnest {
             double Aminy = std::numeric_limits<double>::max();
 
             for (const auto& p : A.points) {
-                Amaxx = std::max(Amaxx, p.x);
-                Aminx = std::min(Aminx, p.x);
-                Amaxy = std::max(Amaxy, p.y);
-                Aminy = std::min(Aminy, p.y);
+                Amaxx = std::max<double>(Amaxx, p.x);
+                Aminx = std::min<double>(Aminx, p.x);
+                Amaxy = std::max<double>(Amaxy, p.y);
+                Aminy = std::min<double>(Aminy, p.y);
             }
 
             // Also check A's holes
             for (const auto& hole : A.children) {
                 for (const auto& p : hole.points) {
-                    Amaxx = std::max(Amaxx, p.x);
-                    Aminx = std::min(Aminx, p.x);
-                    Amaxy = std::max(Amaxy, p.y);
-                    Aminy = std::min(Aminy, p.y);
+                    Amaxx = std::max<double>(Amaxx, p.x);
+                    Aminx = std::min<double>(Aminx, p.x);
+                    Amaxy = std::max<double>(Amaxy, p.y);
+                    Aminy = std::min<double>(Aminy, p.y);
                 }
             }
 
@@ -161,19 +214,19 @@ namespace deepnest {
             double Bminy = std::numeric_limits<double>::max();
 
             for (const auto& p : B.points) {
-                Bmaxx = std::max(Bmaxx, p.x);
-                Bminx = std::min(Bminx, p.x);
-                Bmaxy = std::max(Bmaxy, p.y);
-                Bminy = std::min(Bminy, p.y);
+                Bmaxx = std::max<double>(Bmaxx, p.x);
+                Bminx = std::min<double>(Bminx, p.x);
+                Bmaxy = std::max<double>(Bmaxy, p.y);
+                Bminy = std::min<double>(Bminy, p.y);
             }
 
             // Also check B's holes
             for (const auto& hole : B.children) {
                 for (const auto& p : hole.points) {
-                    Bmaxx = std::max(Bmaxx, p.x);
-                    Bminx = std::min(Bminx, p.x);
-                    Bmaxy = std::max(Bmaxy, p.y);
-                    Bminy = std::min(Bminy, p.y);
+                    Bmaxx = std::max<double>(Bmaxx, p.x);
+                    Bminx = std::min<double>(Bminx, p.x);
+                    Bmaxy = std::max<double>(Bmaxy, p.y);
+                    Bminy = std::min<double>(Bminy, p.y);
                 }
             }
 
@@ -370,69 +423,95 @@ namespace trunk {
     // Forward declarations of helper functions from minkowski.cc
     namespace {
 
-        void convolve_two_segments(std::vector<IntPoint>& figure,
-            const IntEdge& a,
-            const IntEdge& b) {
-            figure.clear();
-            figure.push_back(IntPoint(a.first));
-            figure.push_back(IntPoint(a.first));
-            figure.push_back(IntPoint(a.second));
-            figure.push_back(IntPoint(a.second));
-            convolve(figure[0], b.second);
-            convolve(figure[1], b.first);
-            convolve(figure[2], b.first);
-            convolve(figure[3], b.second);
+        // Area type polygon_set_data uses to pick the winding of an inserted polygon_data
+        using QuadArea = area_type_by_domain<
+            geometry_domain<geometry_concept<IntPolygon>::type>::type, int>::type;
+
+        /**
+         * @brief Number of edge-pair quads convolve_two_point_sequences emits
+         */
+        std::size_t edge_pair_count(std::size_t aPoints, std::size_t bPoints) {
+            return (aPoints < 2 || bPoints < 2) ? 0 : (aPoints - 1) * (bPoints - 1);
         }
 
+        /**
+         * @brief Convolve every edge of A with every edge of B
+         *
+         * All edge-pair quads are first written to one flat buffer (a flat
+         * loop over contiguous points that the compiler can vectorize) and
+         * then inserted as raw vertex sequences. The edges, windings and
+         * insertion order are the same as inserting one polygon_data per
+         * pair, so the resulting set is identical, without the per-quad
+         * polygon copies.
+         */
         template <typename itrT1, typename itrT2>
         void convolve_two_point_sequences(IntPolygonSet& result,
+            std::vector<IntPoint>& quads,
             itrT1 ab, itrT1 ae,
             itrT2 bb, itrT2 be) {
             if (ab == ae || bb == be)
                 return;
 
-            IntPoint first_a = *ab;
-            IntPoint prev_a = *ab;
-            std::vector<IntPoint> vec;
-            IntPolygon poly;
-            ++ab;
-
-            for (; ab != ae; ++ab) {
-                IntPoint first_b = *bb;
-                IntPoint prev_b = *bb;
-                itrT2 tmpb = bb;
-                ++tmpb;
-
-                for (; tmpb != be; ++tmpb) {
-                    convolve_two_segments(vec,
-                        std::make_pair(prev_b, *tmpb),
-                        std::make_pair(prev_a, *ab));
-                    set_points(poly, vec.begin(), vec.end());
-                    result.insert(poly);
-                    prev_b = *tmpb;
+            const std::vector<IntPoint> a(ab, ae);
+            const std::vector<IntPoint> b(bb, be);
+            const std::size_t pairs = edge_pair_count(a.size(), b.size());
+            if (pairs == 0)
+                return;
+
+            quads.resize(pairs * 4);
+            IntPoint* q = quads.data();
+            for (std::size_t i = 1; i < a.size(); ++i) {
+                const int a0x = a[i - 1].x(), a0y = a[i - 1].y();
+                const int a1x = a[i].x(), a1y = a[i].y();
+                for (std::size_t j = 1; j < b.size(); ++j, q += 4) {
+                    const int b0x = b[j - 1].x(), b0y = b[j - 1].y();
+                    const int b1x = b[j].x(), b1y = b[j].y();
+                    q[0] = IntPoint(b0x + a1x, b0y + a1y);
+                    q[1] = IntPoint(b0x + a0x, b0y + a0y);
+                    q[2] = IntPoint(b1x + a0x, b1y + a0y);
+                    q[3] = IntPoint(b1x + a1x, b1y + a1y);
                 }
-                prev_a = *ab;
+            }
+
+            for (const IntPoint* quad = quads.data(); quad != q; quad += 4) {
+                // Same winding rule as polygon_set_data::insert(polygon_data)
+                direction_1d winding = point_sequence_area<const IntPoint*, QuadArea>(quad, quad + 4) < 0
+                    ? COUNTERCLOCKWISE : CLOCKWISE;
+                result.insert_vertex_sequence(quad, quad + 4, winding, false);
             }
         }
 
         template <typename itrT>
         void convolve_point_sequence_with_polygons(IntPolygonSet& result,
+            std::vector<IntPoint>& quads,
             itrT b, itrT e,
             const std::vector<IntPolygonWithHoles>& polygons) {
             for (std::size_t i = 0; i < polygons.size(); ++i) {
-                convolve_two_point_sequences(result, b, e,
+                convolve_two_point_sequences(result, quads, b, e,
                     begin_points(polygons[i]),
                     end_points(polygons[i]));
 
                 for (auto itrh = begin_holes(polygons[i]);
                     itrh != end_holes(polygons[i]); ++itrh) {
-                    convolve_two_point_sequences(result, b, e,
+                    convolve_two_point_sequences(result, quads, b, e,
                         begin_points(*itrh),
                         end_points(*itrh));
                 }
             }
         }
 
+        /**
+         * @brief Point counts of a polygon's outer ring and holes
+         */
+        std::vector<std::size_t> ring_sizes(const IntPolygonWithHoles& polygon) {
+            std::vector<std::size_t> sizes;
+            sizes.push_back(std::distance(begin_points(polygon), end_points(polygon)));
+            for (auto itrh = begin_holes(polygon); itrh != end_holes(polygon); ++itrh) {
+                sizes.push_back(std::distance(begin_points(*itrh), end_points(*itrh)));
+            }
+            return sizes;
+        }
+
         void convolve_two_polygon_sets(IntPolygonSet& result,
             const IntPolygonSet& a,
             const IntPolygonSet& b) {
@@ -442,15 +521,42 @@ namespace trunk {
             a.get(a_polygons);
             b.get(b_polygons);
 
+            // Reserve the edge storage for every quad once instead of
+            // growing it quad by quad
+            std::vector<std::size_t> a_rings;
+            std::vector<std::size_t> b_rings;
+            for (const auto& polygon : a_polygons) {
+                auto sizes = ring_sizes(polygon);
+                a_rings.insert(a_rings.end(), sizes.begin(), sizes.end());
+            }
+            for (const auto& polygon : b_polygons) {
+                auto sizes = ring_sizes(polygon);
+                b_rings.insert(b_rings.end(), sizes.begin(), sizes.end());
+            }
+            std::size_t total_pairs = 0;
+            std::size_t max_pairs = 0;
+            for (std::size_t na : a_rings) {
+                for (std::size_t nb : b_rings) {
+                    std::size_t pairs = edge_pair_count(na, nb);
+                    total_pairs += pairs;
+                    max_pairs = std::max(max_pairs, pairs);
+                }
+            }
+            result.reserve(total_pairs * 4);
+
+            // Quad buffer shared by all ring pairs
+            std::vector<IntPoint> quads;
+            quads.reserve(max_pairs * 4);
+
             for (std::size_t ai = 0; ai < a_polygons.size(); ++ai) {
-                convolve_point_sequence_with_polygons(result,
+                convolve_point_sequence_with_polygons(result, quads,
                     begin_points(a_polygons[ai]),
                     end_points(a_polygons[ai]),
                     b_polygons);
 
                 for (auto itrh = begin_holes(a_polygons[ai]);
                     itrh != end_holes(a_polygons[ai]); ++itrh) {
-                    convolve_point_sequence_with_polygons(result,
+                    convolve_point_sequence_with_polygons(result, quads,
                         begin_points(*itrh),
                         end_points(*itrh),
                         b_polygons);
@@ -469,40 +575,38 @@ namespace trunk {
 
     // ========== Public Methods ==========
 
-    IntPolygonWithHoles MinkowskiSum::toBoostIntPolygon(const Polygon& poly) {
-        // Convert outer boundary - direct truncation to int
-        std::vector<IntPoint> points;
-        points.reserve(poly.points.size());
-
-        for (const auto& p : poly.points) {
-            int x = static_cast<int>(p.x);
-            int y = static_cast<int>(p.y);
-            points.push_back(IntPoint(x, y));
-        }
-
+    IntPolygonWithHoles MinkowskiSum::toBoostIntPolygon(const MultiRing& rings) {
         IntPolygonWithHoles result;
-        set_points(result, points.begin(), points.end());
-
-        // Convert holes
-        if (!poly.children.empty()) {
-            std::vector<IntPolygon> holes;
-            holes.reserve(poly.children.size());
+        if (rings.ringCount() == 0) {
+            return result;
+        }
 
-            for (const auto& hole : poly.children) {
-                std::vector<IntPoint> holePoints;
-                holePoints.reserve(hole.points.size());
+        // Direct truncation to int
+        auto ringPoints = [&rings](size_t ring) {
+            std::vector<IntPoint> points;
+            points.reserve(rings.ringSize(ring));
+            for (const Point* p = rings.ringBegin(ring); p != rings.ringEnd(ring); ++p) {
+                points.push_back(IntPoint(static_cast<int>(p->x), static_cast<int>(p->y)));
+            }
+            return points;
+        };
 
-                for (const auto& p : hole.points) {
-                    int x = static_cast<int>(p.x);
-                    int y = static_cast<int>(p.y);
-                    holePoints.push_back(IntPoint(x, y));
-                }
+        std::vector<IntPoint> points = ringPoints(0);
+        set_points(result, points.begin(), points.end());
 
-                IntPolygon holePoly;
-                set_points(holePoly, holePoints.begin(), holePoints.end());
-                holes.push_back(holePoly);
+        // The holes of the outer boundary; islands inside them are not part
+        // of the operand, as with Polygon::children
+        std::vector<IntPolygon> holes;
+        for (size_t ring = 1; ring < rings.ringCount(); ++ring) {
+            if (rings.parent(ring) != 0) {
+                continue;
             }
-
+            std::vector<IntPoint> holePoints = ringPoints(ring);
+            IntPolygon holePoly;
+            set_points(holePoly, holePoints.begin(), holePoints.end());
+            holes.push_back(std::move(holePoly));
+        }
+        if (!holes.empty()) {
             set_holes(result, holes.begin(), holes.end());
         }
 
@@ -558,31 +662,17 @@ namespace trunk {
         LOG_NFP("Calculating Minkowski NFP: A(" << A.points.size() << " pts) vs B("
             << B.points.size() << " pts), mode=" << (inner ? "INNER" : "OUTER"));
 
-        // For NFP placement calculations, we ALWAYS need Minkowski difference: A ⊖ B = A ⊕ (-B)
-        Polygon B_to_use = B;
-
-        // Negate all points of B to get -B for Minkowski difference
-        for (auto& point : B_to_use.points) {
-            point.x = -point.x;
-            point.y = -point.y;
-        }
-        // Negating coordinates inverts winding order - reverse to restore CCW
-        std::reverse(B_to_use.points.begin(), B_to_use.points.end());
-
-        // Also negate children (holes)
-        for (auto& child : B_to_use.children) {
-            for (auto& point : child.points) {
-                point.x = -point.x;
-                point.y = -point.y;
-            }
-            std::reverse(child.points.begin(), child.points.end());
-        }
+        // For NFP placement calculations, we ALWAYS need Minkowski difference: A ⊖ B = A ⊕ (-B).
+        // Both operands are read as flat rings, so -B is one buffer rather
+        // than a copy of B's hole tree
+        const MultiRing ringsA = A.flatten();
+        const MultiRing negatedB = B.flatten().negated();
 
         // Convert to Boost integer polygons (direct truncation)
         IntPolygonSet polySetA, polySetB, result;
 
-        IntPolygonWithHoles boostA = toBoostIntPolygon(A);
-        IntPolygonWithHoles boostB = toBoostIntPolygon(B_to_use);
+        IntPolygonWithHoles boostA = toBoostIntPolygon(ringsA);
+        IntPolygonWithHoles boostB = toBoostIntPolygon(negatedB);
 
         polySetA.insert(boostA);
         polySetB.insert(boostB);
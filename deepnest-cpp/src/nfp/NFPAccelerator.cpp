@@ -0,0 +1,329 @@
+#include "../../include/deepnest/nfp/NFPAccelerator.h"
+
+#ifdef DEEPNEST_OPENCL
+#define CL_TARGET_OPENCL_VERSION 120
+#ifdef __APPLE__
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#endif
+
+namespace deepnest {
+
+#ifdef DEEPNEST_OPENCL
+
+namespace {
+
+// Quadrilaterals per kernel launch: bounds the device buffers (64 bytes
+// of output per quadrilateral); a larger pair is launched on its own
+const size_t MAX_LAUNCH_QUADS = size_t(1) << 21;
+
+/**
+ * One work item per quadrilateral, the numbering of Clipper2's Minkowski():
+ * quadrilateral i * |A| + j of a job joins edge (h, j) of A, h = j - 1 mod
+ * |A|, to edge (g, i) of B, g = i - 1 mod |B|. Orientation is decided by
+ * Clipper2's Area(), in double precision where the device supports it.
+ */
+const char* CONVOLVE_SOURCE = R"CL(
+#ifdef cl_khr_fp64
+#pragma OPENCL EXTENSION cl_khr_fp64 : enable
+typedef double real;
+#else
+typedef float real;
+#endif
+
+__kernel void convolve(__global const long2* a, __global const long2* b,
+                       __global const uint* aStart, __global const uint* aCount,
+                       __global const uint* bStart, __global const uint* bCount,
+                       __global const ulong* quadStart, const uint jobs,
+                       const ulong quads, __global long2* out)
+{
+    const ulong q = get_global_id(0);
+    if (q >= quads) {
+        return;
+    }
+
+    // Last job starting at or before q
+    uint lo = 0;
+    uint hi = jobs;
+    while (hi - lo > 1) {
+        const uint mid = (lo + hi) / 2;
+        if (quadStart[mid] <= q) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const ulong local = q - quadStart[lo];
+    const uint nA = aCount[lo];
+    const uint nB = bCount[lo];
+    const uint i = (uint)(local / nA);
+    const uint j = (uint)(local % nA);
+    const uint g = i ? i - 1 : nB - 1;
+    const uint h = j ? j - 1 : nA - 1;
+
+    const long2 bg = b[bStart[lo] + g];
+    const long2 bi = b[bStart[lo] + i];
+    const long2 ah = a[aStart[lo] + h];
+    const long2 aj = a[aStart[lo] + j];
+    long2 p[4];
+    p[0] = bg + ah;
+    p[1] = bi + ah;
+    p[2] = bi + aj;
+    p[3] = bg + aj;
+
+    real area = 0;
+    for (int k = 0, m = 3; k < 4; m = k++) {
+        area += (real)(p[m].y + p[k].y) * (real)(p[m].x - p[k].x);
+    }
+
+    __global long2* quad = out + 4 * q;
+    for (int k = 0; k < 4; ++k) {
+        quad[k] = area >= 0 ? p[k] : p[3 - k];
+    }
+}
+)CL";
+
+void check(cl_int status, const char* what) {
+    if (status != CL_SUCCESS) {
+        throw std::runtime_error(std::string("OpenCL ") + what + " failed (" + std::to_string(status) + ")");
+    }
+}
+
+/**
+ * @brief Read-only device copy of a host vector
+ */
+template <typename T>
+class DeviceBuffer {
+public:
+    DeviceBuffer(cl_context context, const std::vector<T>& data) {
+        cl_int status = CL_SUCCESS;
+        // A zero-sized buffer is invalid; the kernel never reads it
+        std::vector<T> padding(1);
+        const std::vector<T>& source = data.empty() ? padding : data;
+        buffer_ = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                 source.size() * sizeof(T), const_cast<T*>(source.data()), &status);
+        check(status, "clCreateBuffer");
+    }
+
+    DeviceBuffer(cl_context context, size_t count) {
+        cl_int status = CL_SUCCESS;
+        buffer_ = clCreateBuffer(context, CL_MEM_WRITE_ONLY, std::max<size_t>(count, 1) * sizeof(T),
+                                 nullptr, &status);
+        check(status, "clCreateBuffer");
+    }
+
+    ~DeviceBuffer() { clReleaseMemObject(buffer_); }
+
+    DeviceBuffer(const DeviceBuffer&) = delete;
+    DeviceBuffer& operator=(const DeviceBuffer&) = delete;
+
+    const cl_mem* get() const { return &buffer_; }
+
+private:
+    cl_mem buffer_ = nullptr;
+};
+
+class OpenCLAccelerator : public NFPAccelerator {
+public:
+    /**
+     * @brief First GPU of the first platform that has one
+     *
+     * @return nullptr if no GPU is present or the kernel does not build on it
+     */
+    static std::shared_ptr<NFPAccelerator> create() {
+        cl_uint platformCount = 0;
+        if (clGetPlatformIDs(0, nullptr, &platformCount) != CL_SUCCESS || platformCount == 0) {
+            return nullptr;
+        }
+        std::vector<cl_platform_id> platforms(platformCount);
+        clGetPlatformIDs(platformCount, platforms.data(), nullptr);
+
+        for (cl_platform_id platform : platforms) {
+            cl_device_id device = nullptr;
+            if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_GPU, 1, &device, nullptr) != CL_SUCCESS) {
+                continue;
+            }
+            try {
+                return std::make_shared<OpenCLAccelerator>(device);
+            } catch (const std::exception& e) {
+                std::cerr << "WARNING: OpenCL device unusable for NFPs: " << e.what() << std::endl;
+            }
+        }
+        return nullptr;
+    }
+
+    explicit OpenCLAccelerator(cl_device_id device)
+        : device_(device)
+    {
+        char deviceName[256] = {0};
+        clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(deviceName) - 1, deviceName, nullptr);
+        name_ = std::string("OpenCL ") + deviceName;
+
+        cl_int status = CL_SUCCESS;
+        context_ = clCreateContext(nullptr, 1, &device_, nullptr, nullptr, &status);
+        check(status, "clCreateContext");
+        queue_ = clCreateCommandQueue(context_, device_, 0, &status);
+        if (status != CL_SUCCESS) {
+            release();
+            check(status, "clCreateCommandQueue");
+        }
+        program_ = clCreateProgramWithSource(context_, 1, &CONVOLVE_SOURCE, nullptr, &status);
+        if (status == CL_SUCCESS) {
+            status = clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr);
+        }
+        if (status == CL_SUCCESS) {
+            kernel_ = clCreateKernel(program_, "convolve", &status);
+        }
+        if (status != CL_SUCCESS) {
+            release();
+            check(status, "kernel build");
+        }
+    }
+
+    ~OpenCLAccelerator() override { release(); }
+
+    std::string name() const override { return name_; }
+
+    void convolve(const std::vector<Job>& jobs, std::vector<Clipper2Lib::Paths64>& quads) override {
+        quads.assign(jobs.size(), Clipper2Lib::Paths64());
+        for (size_t begin = 0; begin < jobs.size();) {
+            size_t end = begin;
+            size_t total = 0;
+            while (end < jobs.size()) {
+                const size_t count = jobs[end].A->size() * jobs[end].B->size();
+                if (end > begin && total + count > MAX_LAUNCH_QUADS) {
+                    break;
+                }
+                total += count;
+                ++end;
+            }
+            launch(jobs, begin, end, total, quads);
+            begin = end;
+        }
+    }
+
+private:
+    /**
+     * @brief Convolve jobs [begin, end), total quadrilaterals in all
+     */
+    void launch(const std::vector<Job>& jobs, size_t begin, size_t end, size_t total,
+                std::vector<Clipper2Lib::Paths64>& quads) {
+        if (total == 0) {
+            return;
+        }
+
+        std::vector<cl_long> a;
+        std::vector<cl_long> b;
+        std::vector<cl_uint> aStart, aCount, bStart, bCount;
+        std::vector<cl_ulong> quadStart;
+        cl_ulong quadCount = 0;
+        for (size_t k = begin; k < end; ++k) {
+            aStart.push_back(static_cast<cl_uint>(a.size() / 2));
+            aCount.push_back(static_cast<cl_uint>(jobs[k].A->size()));
+            for (const auto& pt : *jobs[k].A) {
+                a.push_back(pt.x);
+                a.push_back(pt.y);
+            }
+            bStart.push_back(static_cast<cl_uint>(b.size() / 2));
+            bCount.push_back(static_cast<cl_uint>(jobs[k].B->size()));
+            for (const auto& pt : *jobs[k].B) {
+                b.push_back(pt.x);
+                b.push_back(pt.y);
+            }
+            quadStart.push_back(quadCount);
+            quadCount += jobs[k].A->size() * jobs[k].B->size();
+        }
+        const cl_uint jobCount = static_cast<cl_uint>(end - begin);
+
+        // One queue and kernel object: launches are serialized
+        boost::mutex::scoped_lock lock(mutex_);
+        DeviceBuffer<cl_long> aBuffer(context_, a), bBuffer(context_, b);
+        DeviceBuffer<cl_uint> aStartBuffer(context_, aStart), aCountBuffer(context_, aCount);
+        DeviceBuffer<cl_uint> bStartBuffer(context_, bStart), bCountBuffer(context_, bCount);
+        DeviceBuffer<cl_ulong> quadStartBuffer(context_, quadStart);
+        DeviceBuffer<cl_long> outBuffer(context_, quadCount * 8);
+
+        check(clSetKernelArg(kernel_, 0, sizeof(cl_mem), aBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 1, sizeof(cl_mem), bBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 2, sizeof(cl_mem), aStartBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 3, sizeof(cl_mem), aCountBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 4, sizeof(cl_mem), bStartBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 5, sizeof(cl_mem), bCountBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 6, sizeof(cl_mem), quadStartBuffer.get()), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 7, sizeof(cl_uint), &jobCount), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 8, sizeof(cl_ulong), &quadCount), "clSetKernelArg");
+        check(clSetKernelArg(kernel_, 9, sizeof(cl_mem), outBuffer.get()), "clSetKernelArg");
+
+        const size_t globalSize = static_cast<size_t>(quadCount);
+        check(clEnqueueNDRangeKernel(queue_, kernel_, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr),
+              "clEnqueueNDRangeKernel");
+        std::vector<cl_long> out(static_cast<size_t>(quadCount) * 8);
+        check(clEnqueueReadBuffer(queue_, *outBuffer.get(), CL_TRUE, 0, out.size() * sizeof(cl_long),
+                                  out.data(), 0, nullptr, nullptr),
+              "clEnqueueReadBuffer");
+        lock.unlock();
+
+        const cl_long* read = out.data();
+        for (size_t k = begin; k < end; ++k) {
+            Clipper2Lib::Paths64& result = quads[k];
+            result.resize(jobs[k].A->size() * jobs[k].B->size());
+            for (auto& quad : result) {
+                quad.resize(4);
+                for (auto& pt : quad) {
+                    pt.x = read[0];
+                    pt.y = read[1];
+                    read += 2;
+                }
+            }
+        }
+    }
+
+    void release() {
+        if (kernel_) {
+            clReleaseKernel(kernel_);
+        }
+        if (program_) {
+            clReleaseProgram(program_);
+        }
+        if (queue_) {
+            clReleaseCommandQueue(queue_);
+        }
+        if (context_) {
+            clReleaseContext(context_);
+        }
+        kernel_ = nullptr;
+        program_ = nullptr;
+        queue_ = nullptr;
+        context_ = nullptr;
+    }
+
+    cl_device_id device_ = nullptr;
+    cl_context context_ = nullptr;
+    cl_command_queue queue_ = nullptr;
+    cl_program program_ = nullptr;
+    cl_kernel kernel_ = nullptr;
+    std::string name_;
+    boost::mutex mutex_;
+};
+
+} // anonymous namespace
+
+#endif // DEEPNEST_OPENCL
+
+std::shared_ptr<NFPAccelerator> NFPAccelerator::detect() {
+#ifdef DEEPNEST_OPENCL
+    static const std::shared_ptr<NFPAccelerator> device = OpenCLAccelerator::create();
+    return device;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace deepnest
@@ -0,0 +1,392 @@
+#include "../../include/deepnest/nfp/NFPBackendSelector.h"
+#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/config/JsonWriter.h"
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+namespace deepnest {
+
+namespace {
+
+const int PROFILE_VERSION = 1;
+
+// Repeat fast backends until the measurement is above timer noise
+const double MIN_SAMPLE_SECONDS = 1e-3;
+const int MAX_SAMPLE_REPEATS = 16;
+
+// A backend this much slower than the reference on one pair can never be
+// selected for the class, so it is not timed on further pairs
+const double HOPELESS_SLOWDOWN = 100.0;
+const double HOPELESS_MIN_SECONDS = 0.05;
+
+// Tolerance for an NFP to count as matching the reference
+const double AGREEMENT_TOLERANCE = 1e-3;
+
+size_t vertexCount(const Polygon& polygon) {
+    size_t count = polygon.points.size();
+    for (const auto& child : polygon.children) {
+        count += vertexCount(child);
+    }
+    return count;
+}
+
+struct Sample {
+    double size;
+    double seconds;
+};
+
+// Least squares fit of seconds = fixed + perUnit * size, both kept non-negative
+NFPBackendSelector::CostModel fitModel(const std::vector<Sample>& samples) {
+    NFPBackendSelector::CostModel model{true, 0.0, 0.0};
+
+    double n = static_cast<double>(samples.size());
+    double sumS = 0.0, sumT = 0.0, sumSS = 0.0, sumST = 0.0;
+    for (const auto& sample : samples) {
+        sumS += sample.size;
+        sumT += sample.seconds;
+        sumSS += sample.size * sample.size;
+        sumST += sample.size * sample.seconds;
+    }
+
+    double denominator = n * sumSS - sumS * sumS;
+    if (samples.size() >= 2 && denominator > 0.0) {
+        model.perUnit = (n * sumST - sumS * sumT) / denominator;
+        model.fixed = (sumT - model.perUnit * sumS) / n;
+    }
+
+    if (samples.size() < 2 || denominator <= 0.0 || model.perUnit < 0.0) {
+        // No usable slope: pure per-call cost
+        model.perUnit = 0.0;
+        model.fixed = sumT / n;
+    } else if (model.fixed < 0.0) {
+        // Line through the origin
+        model.fixed = 0.0;
+        model.perUnit = sumSS > 0.0 ? sumST / sumSS : 0.0;
+    }
+    return model;
+}
+
+// Same NFP up to the tolerance: area and bounds of the outer boundary
+bool agrees(const Polygon& result, const Polygon& expected) {
+    if (result.points.size() < 3 || expected.points.size() < 3) {
+        return false;
+    }
+
+    double expectedArea = std::abs(GeometryUtil::polygonArea(expected.points));
+    double resultArea = std::abs(GeometryUtil::polygonArea(result.points));
+    if (std::abs(resultArea - expectedArea) > AGREEMENT_TOLERANCE * expectedArea) {
+        return false;
+    }
+
+    BoundingBox a = GeometryUtil::getPolygonBounds(result.points);
+    BoundingBox b = GeometryUtil::getPolygonBounds(expected.points);
+    double tolerance = AGREEMENT_TOLERANCE * std::max(b.width, b.height);
+    return std::abs(a.x - b.x) <= tolerance &&
+           std::abs(a.y - b.y) <= tolerance &&
+           std::abs(a.width - b.width) <= tolerance &&
+           std::abs(a.height - b.height) <= tolerance;
+}
+
+// Average seconds per call of compute(backend, A, B); result is the last NFP
+double timeBackend(const NFPBackendSelector::ComputeFunction& compute, NFPBackend backend,
+                   const Polygon& A, const Polygon& B, Polygon& result) {
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    int runs = 0;
+    do {
+        result = compute(backend, A, B);
+        runs++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < MIN_SAMPLE_SECONDS && runs < MAX_SAMPLE_REPEATS && !result.points.empty());
+    return elapsed / runs;
+}
+
+} // anonymous namespace
+
+NFPBackendSelector::NFPBackendSelector() {
+    for (auto& perClass : models_) {
+        perClass.fill(CostModel{false, 0.0, 0.0});
+    }
+
+    // Relative costs that reproduce the fixed dispatch; the orbital and
+    // libnfporb backends are only enabled by a calibration that validated them
+    for (int c = 0; c < PAIR_CLASS_COUNT; c++) {
+        NFPPairClass pairClass = static_cast<NFPPairClass>(c);
+        if (supports(NFPBackend::Convex, pairClass)) {
+            setModel(NFPBackend::Convex, pairClass, CostModel{true, 0.0, 1e-7});
+        }
+        if (supports(NFPBackend::ClipperMinkowski, pairClass)) {
+            setModel(NFPBackend::ClipperMinkowski, pairClass, CostModel{true, 0.0, 1e-7});
+        }
+        setModel(NFPBackend::BoostConvolution, pairClass, CostModel{true, 0.0, 1e-6});
+    }
+}
+
+NFPPairClass NFPBackendSelector::classify(const Polygon& A, const Polygon& B) {
+    if (!A.children.empty()) {
+        return NFPPairClass::WithHoles;
+    }
+    return (A.convex && B.convex) ? NFPPairClass::ConvexConvex : NFPPairClass::Simple;
+}
+
+bool NFPBackendSelector::supports(NFPBackend backend, NFPPairClass pairClass) {
+    switch (backend) {
+        case NFPBackend::Convex:
+            return pairClass == NFPPairClass::ConvexConvex;
+        case NFPBackend::BoostConvolution:
+            return true;
+        case NFPBackend::ClipperMinkowski:
+        case NFPBackend::Orbital:
+        case NFPBackend::Libnfporb:
+            return pairClass != NFPPairClass::WithHoles;
+    }
+    return false;
+}
+
+NFPBackend NFPBackendSelector::reference(NFPPairClass pairClass) {
+    return pairClass == NFPPairClass::WithHoles ? NFPBackend::BoostConvolution
+                                                : NFPBackend::ClipperMinkowski;
+}
+
+double NFPBackendSelector::pairSize(NFPBackend backend, const Polygon& A, const Polygon& B) {
+    if (backend == NFPBackend::Convex) {
+        return static_cast<double>(A.points.size() + B.points.size());
+    }
+    return static_cast<double>(vertexCount(A)) * static_cast<double>(vertexCount(B));
+}
+
+double NFPBackendSelector::estimate(NFPBackend backend, const Polygon& A, const Polygon& B) const {
+    const CostModel& m = model(backend, classify(A, B));
+    return m.fixed + m.perUnit * pairSize(backend, A, B);
+}
+
+NFPBackend NFPBackendSelector::select(const Polygon& A, const Polygon& B) const {
+    NFPPairClass pairClass = classify(A, B);
+    NFPBackend best = reference(pairClass);
+    double bestCost = estimate(best, A, B);
+
+    for (int b = 0; b < BACKEND_COUNT; b++) {
+        NFPBackend backend = static_cast<NFPBackend>(b);
+        if (!supports(backend, pairClass) || !model(backend, pairClass).enabled) {
+            continue;
+        }
+        double cost = estimate(backend, A, B);
+        if (cost < bestCost) {
+            best = backend;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+const NFPBackendSelector::CostModel& NFPBackendSelector::model(NFPBackend backend,
+                                                               NFPPairClass pairClass) const {
+    return models_[static_cast<int>(pairClass)][static_cast<int>(backend)];
+}
+
+void NFPBackendSelector::setModel(NFPBackend backend, NFPPairClass pairClass, const CostModel& model) {
+    CostModel& target = models_[static_cast<int>(pairClass)][static_cast<int>(backend)];
+    target = model;
+
+    // Unsupported combinations never run; the reference always may
+    if (!supports(backend, pairClass)) {
+        target.enabled = false;
+    } else if (backend == reference(pairClass)) {
+        target.enabled = true;
+    }
+}
+
+void NFPBackendSelector::calibrate(const std::vector<Polygon>& parts, const ComputeFunction& compute,
+                                   size_t maxPairsPerClass) {
+    // One representative per shape
+    std::vector<const Polygon*> shapes;
+    std::unordered_set<uint64_t> seen;
+    for (const auto& part : parts) {
+        if (part.points.size() < 3) {
+            continue;
+        }
+        if (part.fingerprint == 0 || seen.insert(part.fingerprint).second) {
+            shapes.push_back(&part);
+        }
+    }
+
+    std::array<std::array<std::vector<Sample>, BACKEND_COUNT>, PAIR_CLASS_COUNT> samples;
+    std::array<std::array<bool, BACKEND_COUNT>, PAIR_CLASS_COUNT> rejected{};
+    std::array<size_t, PAIR_CLASS_COUNT> pairs{};
+
+    for (const Polygon* A : shapes) {
+        for (const Polygon* B : shapes) {
+            int c = static_cast<int>(classify(*A, *B));
+            if (pairs[c] >= maxPairsPerClass) {
+                continue;
+            }
+
+            NFPPairClass pairClass = static_cast<NFPPairClass>(c);
+            NFPBackend ref = reference(pairClass);
+
+            Polygon expected;
+            double refSeconds = 0.0;
+            try {
+                refSeconds = timeBackend(compute, ref, *A, *B, expected);
+            } catch (const std::exception& e) {
+                std::cerr << "WARNING: Reference NFP backend failed during calibration: " << e.what() << std::endl;
+                continue;
+            }
+            if (expected.points.size() < 3) {
+                continue;
+            }
+            pairs[c]++;
+            samples[c][static_cast<int>(ref)].push_back(Sample{pairSize(ref, *A, *B), refSeconds});
+
+            for (int b = 0; b < BACKEND_COUNT; b++) {
+                NFPBackend backend = static_cast<NFPBackend>(b);
+                if (backend == ref || !supports(backend, pairClass) || rejected[c][b]) {
+                    continue;
+                }
+
+                Polygon result;
+                double seconds = 0.0;
+                try {
+                    seconds = timeBackend(compute, backend, *A, *B, result);
+                } catch (...) {
+                    rejected[c][b] = true;
+                    continue;
+                }
+
+                if (!agrees(result, expected) ||
+                    (seconds > HOPELESS_MIN_SECONDS && seconds > HOPELESS_SLOWDOWN * refSeconds)) {
+                    rejected[c][b] = true;
+                    continue;
+                }
+                samples[c][b].push_back(Sample{pairSize(backend, *A, *B), seconds});
+            }
+        }
+    }
+
+    // Classes without samples keep their current models
+    for (int c = 0; c < PAIR_CLASS_COUNT; c++) {
+        if (pairs[c] == 0) {
+            continue;
+        }
+        NFPPairClass pairClass = static_cast<NFPPairClass>(c);
+        for (int b = 0; b < BACKEND_COUNT; b++) {
+            NFPBackend backend = static_cast<NFPBackend>(b);
+            if (!supports(backend, pairClass)) {
+                continue;
+            }
+            if (rejected[c][b] || samples[c][b].empty()) {
+                setModel(backend, pairClass, CostModel{false, 0.0, 0.0});
+            } else {
+                setModel(backend, pairClass, fitModel(samples[c][b]));
+            }
+        }
+    }
+}
+
+bool NFPBackendSelector::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    using boost::property_tree::ptree;
+    ptree root;
+    try {
+        boost::property_tree::read_json(file, root);
+    } catch (const boost::property_tree::json_parser_error&) {
+        std::cerr << "WARNING: Invalid NFP backend profile " << path << std::endl;
+        return false;
+    }
+
+    const auto version = root.find("version");
+    if (version == root.not_found() || version->second.get_value<int>(0) != PROFILE_VERSION) {
+        std::cerr << "WARNING: Unsupported NFP backend profile version in " << path << std::endl;
+        return false;
+    }
+
+    const auto classes = root.find("classes");
+    if (classes == root.not_found()) {
+        return true;
+    }
+    for (int c = 0; c < PAIR_CLASS_COUNT; c++) {
+        NFPPairClass pairClass = static_cast<NFPPairClass>(c);
+        const auto backends = classes->second.find(pairClassName(pairClass));
+        if (backends == classes->second.not_found()) {
+            continue;
+        }
+        for (int b = 0; b < BACKEND_COUNT; b++) {
+            NFPBackend backend = static_cast<NFPBackend>(b);
+            const auto entry = backends->second.find(backendName(backend));
+            if (entry == backends->second.not_found()) {
+                continue;
+            }
+            CostModel m;
+            m.enabled = entry->second.get<bool>("enabled", false);
+            m.fixed = entry->second.get<double>("fixed", 0.0);
+            m.perUnit = entry->second.get<double>("perUnit", 0.0);
+            setModel(backend, pairClass, m);
+        }
+    }
+    return true;
+}
+
+bool NFPBackendSelector::save(const std::string& path) const {
+    JsonWriter root;
+    root.value("version", PROFILE_VERSION);
+    root.beginObject("classes");
+    for (int c = 0; c < PAIR_CLASS_COUNT; c++) {
+        NFPPairClass pairClass = static_cast<NFPPairClass>(c);
+        root.beginObject(pairClassName(pairClass));
+        for (int b = 0; b < BACKEND_COUNT; b++) {
+            NFPBackend backend = static_cast<NFPBackend>(b);
+            if (!supports(backend, pairClass)) {
+                continue;
+            }
+            const CostModel& m = model(backend, pairClass);
+            root.beginObject(backendName(backend));
+            root.value("enabled", m.enabled);
+            root.value("fixed", m.fixed);
+            root.value("perUnit", m.perUnit);
+            root.endObject();
+        }
+        root.endObject();
+    }
+    root.endObject();
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "WARNING: Cannot write NFP backend profile " << path << std::endl;
+        return false;
+    }
+    file << root.str();
+    return true;
+}
+
+const char* NFPBackendSelector::backendName(NFPBackend backend) {
+    switch (backend) {
+        case NFPBackend::Convex: return "convex";
+        case NFPBackend::ClipperMinkowski: return "clipper";
+        case NFPBackend::BoostConvolution: return "boost";
+        case NFPBackend::Orbital: return "orbital";
+        case NFPBackend::Libnfporb: return "libnfporb";
+    }
+    return "unknown";
+}
+
+const char* NFPBackendSelector::pairClassName(NFPPairClass pairClass) {
+    switch (pairClass) {
+        case NFPPairClass::ConvexConvex: return "convex";
+        case NFPPairClass::Simple: return "simple";
+        case NFPPairClass::WithHoles: return "holes";
+    }
+    return "unknown";
+}
+
+} // namespace deepnest
@@ -1,7 +1,11 @@
 #include "../../include/deepnest/nfp/NFPCache.h"
+#include "../../include/deepnest/Trace.h"
 #include <sstream>
 #include <iomanip>
 #include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
 namespace deepnest {
 
@@ -19,8 +23,7 @@ std::string NFPCache::NFPKey::toString() const {
     s += "_B";
     s += std::to_string(idB);
     
-    // Use std::to_string for rotation (default 6 decimal places)
-    // This is faster than stringstream
+    // Rotation keys are integers (see NFPCache::rotationKey)
     s += "_Ra";
     s += std::to_string(rotationA);
     s += "_Rb";
@@ -36,67 +39,499 @@ std::string NFPCache::NFPKey::toString() const {
 
 // ========== NFPCache Methods ==========
 
+namespace {
+
+// Approximate per-entry overhead of the hash node, key and control block
+constexpr size_t ENTRY_OVERHEAD_BYTES = sizeof(NFPCache::NFPKey) + 96;
+
+// Shards are trimmed to this fraction of their budget so that eviction
+// runs in batches instead of on every insert
+constexpr double EVICTION_TARGET_RATIO = 0.9;
+
+// Compact entries keep the byte block and a weak handle besides the key
+constexpr size_t COMPACT_ENTRY_BYTES = ENTRY_OVERHEAD_BYTES + sizeof(std::vector<uint8_t>) +
+                                       sizeof(std::weak_ptr<const std::vector<Polygon>>);
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t getVarint(const uint8_t*& p, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) {
+            break;
+        }
+        const uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Corrupt compact NFP entry");
+}
+
+// Small deltas of either sign become small unsigned values
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Rings in preorder, each with its parent's index (-1 for an NFP outline)
+void collectRings(const Polygon& polygon, int parent, std::vector<std::pair<const Polygon*, int>>& rings) {
+    const int index = static_cast<int>(rings.size());
+    rings.emplace_back(&polygon, parent);
+    for (const auto& child : polygon.children) {
+        collectRings(child, index, rings);
+    }
+}
+
+struct RingHeader {
+    size_t points;
+    int parent;
+    bool convex;
+};
+
+// Builds ring `index` and, recursively, the rings that follow it in
+// preorder as its holes; advances `next` past its subtree
+Polygon buildRing(const std::vector<RingHeader>& rings, size_t index, size_t& next,
+                  const uint8_t*& p, const uint8_t* end, double scale) {
+    auto scaled = std::make_shared<Polygon::ScaledPath>();
+    scaled->scale = scale;
+    scaled->path.reserve(rings[index].points);
+
+    Polygon polygon;
+    polygon.points.reserve(rings[index].points);
+    int64_t x = 0;
+    int64_t y = 0;
+    for (size_t i = 0; i < rings[index].points; i++) {
+        x += unzigzag(getVarint(p, end));
+        y += unzigzag(getVarint(p, end));
+        scaled->path.push_back(Clipper2Lib::Point64(x, y));
+        polygon.points.emplace_back(static_cast<double>(x) / scale, static_cast<double>(y) / scale);
+    }
+    polygon.scaledPath = std::move(scaled);
+    polygon.convex = rings[index].convex;
+    polygon.updateCoordinates();
+
+    next = index + 1;
+    while (next < rings.size() && rings[next].parent == static_cast<int>(index)) {
+        polygon.children.push_back(buildRing(rings, next, next, p, end, scale));
+    }
+    return polygon;
+}
+
+} // anonymous namespace
+
+thread_local NFPCache::Capture* NFPCache::capture_ = nullptr;
+
 NFPCache::NFPCache()
     : hits_(0)
     , misses_(0)
+    , evictions_(0)
+    , residentBytes_(0)
+    , memoryLimit_(0)
+    , compactScale_(0.0)
 {}
 
+std::vector<uint8_t> NFPCache::encodeCompact(const std::vector<Polygon>& nfp, double scale) {
+    std::vector<std::pair<const Polygon*, int>> rings;
+    for (const auto& polygon : nfp) {
+        collectRings(polygon, -1, rings);
+    }
+
+    std::vector<uint8_t> out;
+    putVarint(out, rings.size());
+    for (const auto& ring : rings) {
+        putVarint(out, ring.first->points.size());
+        putVarint(out, static_cast<uint64_t>(ring.second + 1));
+        out.push_back(ring.first->convex ? 1 : 0);
+    }
+
+    for (const auto& ring : rings) {
+        const Polygon& polygon = *ring.first;
+        // The prepared Clipper path already holds this ring's grid points
+        const Clipper2Lib::Path64* path = polygon.scaledPathAt(scale);
+        int64_t prevX = 0;
+        int64_t prevY = 0;
+        for (size_t i = 0; i < polygon.points.size(); i++) {
+            const int64_t x = path ? (*path)[i].x : std::llround(polygon.points[i].x * scale);
+            const int64_t y = path ? (*path)[i].y : std::llround(polygon.points[i].y * scale);
+            putVarint(out, zigzag(x - prevX));
+            putVarint(out, zigzag(y - prevY));
+            prevX = x;
+            prevY = y;
+        }
+    }
+
+    out.shrink_to_fit();
+    return out;
+}
+
+std::vector<Polygon> NFPCache::decodeCompact(const uint8_t* data, size_t size, double scale) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+
+    std::vector<RingHeader> rings(getVarint(p, end));
+    for (auto& ring : rings) {
+        ring.points = getVarint(p, end);
+        ring.parent = static_cast<int>(getVarint(p, end)) - 1;
+        if (p == end) {
+            throw std::runtime_error("Corrupt compact NFP entry");
+        }
+        ring.convex = *p++ != 0;
+    }
+
+    std::vector<Polygon> nfp;
+    size_t next = 0;
+    while (next < rings.size()) {
+        nfp.push_back(buildRing(rings, next, next, p, end, scale));
+    }
+    return nfp;
+}
+
+NFPCache::Stored NFPCache::prepare(NFPHandle nfp) const {
+    Stored stored;
+    const double scale = compactScale_.load(std::memory_order_relaxed);
+    if (scale > 0.0) {
+        stored.packed = encodeCompact(*nfp, scale);
+        stored.bytes = COMPACT_ENTRY_BYTES + stored.packed.capacity();
+    } else {
+        stored.bytes = estimateBytes(*nfp);
+    }
+    stored.nfp = std::move(nfp);
+    return stored;
+}
+
+NFPCache::NFPHandle NFPCache::handleOf(const Entry& entry, double compactScale) {
+    if (entry.nfp) {
+        return entry.nfp;
+    }
+
+    NFPHandle handle;
+    while (entry.decodedLock.test_and_set(std::memory_order_acquire)) {}
+    handle = entry.decoded.lock();
+    entry.decodedLock.clear(std::memory_order_release);
+    if (handle) {
+        return handle;
+    }
+
+    // Concurrent misses may each decode; the last one is kept
+    handle = std::make_shared<const std::vector<Polygon>>(
+        decodeCompact(entry.packed.data(), entry.packed.size(), compactScale));
+    while (entry.decodedLock.test_and_set(std::memory_order_acquire)) {}
+    entry.decoded = handle;
+    entry.decodedLock.clear(std::memory_order_release);
+    return handle;
+}
+
+size_t NFPCache::estimateBytes(const std::vector<Polygon>& nfp) {
+    size_t bytes = ENTRY_OVERHEAD_BYTES + sizeof(std::vector<Polygon>);
+    for (const auto& polygon : nfp) {
+        bytes += polygon.memoryBytes();
+    }
+    return bytes;
+}
+
+NFPCache::NFPHandle NFPCache::tombstone() {
+    static const NFPHandle empty = std::make_shared<const std::vector<Polygon>>();
+    return empty;
+}
+
 std::string NFPCache::generateKey(const NFPKey& key) {
     return key.toString();
 }
 
 bool NFPCache::has(const NFPKey& key) const {
-    boost::shared_lock<boost::shared_mutex> lock(mutex_);
-    return cache_.find(key) != cache_.end();
+    const Shard& shard = shardFor(key);
+    ProfiledLock<boost::shared_mutex, true> lock(shard.mutex, sharedLockStats_);
+    return shard.entries.find(key) != shard.entries.end();
 }
 
 bool NFPCache::find(const NFPKey& key, std::vector<Polygon>& result) const {
-    boost::unique_lock<boost::shared_mutex> lock(mutex_);
-
-    auto it = cache_.find(key);
-
-    if (it != cache_.end()) {
-        // Safe copy with exception handling
-        try {
-            result = it->second;  // Copy the cached NFP
-            ++hits_;
-            return true;
-        } catch (const std::exception& e) {
-            std::cerr << "ERROR: Exception during NFP cache copy: " << e.what() << std::endl;
-            std::cerr << "  Key: A=" << key.idA << " B=" << key.idB 
-                      << " rotA=" << key.rotationA << " rotB=" << key.rotationB << std::endl;
-            ++misses_;
-            return false;
-        } catch (...) {
-            std::cerr << "ERROR: Unknown exception during NFP cache copy" << std::endl;
-            ++misses_;
-            return false;
+    NFPHandle cached = lookup(key);
+    if (!cached) {
+        return false;
+    }
+
+    // Safe copy with exception handling
+    try {
+        result = *cached;  // Copy the cached NFP
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: Exception during NFP cache copy: " << e.what() << std::endl;
+        std::cerr << "  Key: A=" << key.idA << " B=" << key.idB 
+                  << " rotA=" << key.rotationA << " rotB=" << key.rotationB << std::endl;
+        return false;
+    } catch (...) {
+        std::cerr << "ERROR: Unknown exception during NFP cache copy" << std::endl;
+        return false;
+    }
+}
+
+NFPCache::NFPHandle NFPCache::lookup(const NFPKey& key) const {
+    TRACE_SCOPE("cache.lookup");
+    const Shard& shard = shardFor(key);
+    ProfiledLock<boost::shared_mutex, true> lock(shard.mutex, sharedLockStats_);
+
+    auto it = shard.entries.find(key);
+
+    if (it != shard.entries.end()) {
+        const Entry& entry = it->second;
+        // GreedyDual-Size: a hit restores the entry's full priority
+        entry.priority.store(shard.inflation.load(std::memory_order_relaxed) + entry.costPerByte,
+                             std::memory_order_relaxed);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        NFPHandle handle = handleOf(entry, compactScale_.load(std::memory_order_relaxed));
+        if (capture_) {
+            capture_->entries.emplace(key, handle);
         }
+        return handle;
     }
 
-    ++misses_;
-    return false;
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    if (capture_) {
+        capture_->entries.emplace(key, nullptr);
+    }
+    return nullptr;
 }
 
 void NFPCache::insert(const NFPKey& key, const std::vector<Polygon>& nfp) {
-    boost::unique_lock<boost::shared_mutex> lock(mutex_);
-    cache_[key] = nfp;  // Store a copy of the NFP
+    // Copy outside the lock, then publish the immutable entry
+    insert(key, std::make_shared<const std::vector<Polygon>>(nfp));
+}
+
+void NFPCache::insert(const NFPKey& key, NFPHandle nfp, double cost) {
+    if (!nfp) {
+        return;
+    }
+
+    // Encode and size the entry before taking the lock
+    Stored stored = prepare(std::move(nfp));
+    double costPerByte = (cost > 0.0 ? cost : static_cast<double>(stored.bytes)) / stored.bytes;
+
+    Shard& shard = shardFor(key);
+    ProfiledLock<boost::shared_mutex> lock(shard.mutex, exclusiveLockStats_);
+
+    insertLocked(shard, key, std::move(stored), costPerByte);
+
+    size_t limit = memoryLimit_.load(std::memory_order_relaxed);
+    if (limit > 0) {
+        size_t shardBudget = std::max<size_t>(limit / NUM_SHARDS, 1);
+        if (shard.residentBytes > shardBudget) {
+            evictFromShard(shard, shardBudget);
+        }
+    }
+}
+
+void NFPCache::insertLocked(Shard& shard, const NFPKey& key, Stored stored, double costPerByte) {
+    Entry& entry = shard.entries[key];
+    shard.residentBytes -= entry.bytes;
+    residentBytes_.fetch_sub(entry.bytes, std::memory_order_relaxed);
+
+    const size_t bytes = stored.bytes;
+    if (stored.packed.empty()) {
+        entry.nfp = std::move(stored.nfp);
+        entry.packed.clear();
+        entry.decoded.reset();
+    } else {
+        // The inserting caller's copy serves hits for as long as it lives
+        entry.nfp.reset();
+        entry.packed = std::move(stored.packed);
+        entry.decoded = stored.nfp;
+    }
+    entry.bytes = bytes;
+    entry.costPerByte = costPerByte;
+    entry.priority.store(shard.inflation.load(std::memory_order_relaxed) + costPerByte,
+                         std::memory_order_relaxed);
+
+    shard.residentBytes += bytes;
+    residentBytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+std::vector<NFPCache::NFPHandle> NFPCache::lookupBatch(const std::vector<NFPKey>& keys) const {
+    TRACE_SCOPE("cache.lookupBatch");
+    std::vector<NFPHandle> results(keys.size());
+
+    // Visit keys shard by shard so each shard lock is taken once
+    std::vector<size_t> order(keys.size());
+    std::vector<size_t> shardOf(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        order[i] = i;
+        shardOf[i] = shardIndex(keys[i]);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&shardOf](size_t a, size_t b) { return shardOf[a] < shardOf[b]; });
+
+    size_t hits = 0;
+    const double compactScale = compactScale_.load(std::memory_order_relaxed);
+    for (size_t begin = 0; begin < order.size();) {
+        const Shard& shard = shards_[shardOf[order[begin]]];
+        size_t end = begin;
+        ProfiledLock<boost::shared_mutex, true> lock(shard.mutex, sharedLockStats_);
+        double inflation = shard.inflation.load(std::memory_order_relaxed);
+        for (; end < order.size() && shardOf[order[end]] == shardOf[order[begin]]; end++) {
+            auto it = shard.entries.find(keys[order[end]]);
+            if (it != shard.entries.end()) {
+                const Entry& entry = it->second;
+                entry.priority.store(inflation + entry.costPerByte, std::memory_order_relaxed);
+                results[order[end]] = handleOf(entry, compactScale);
+                hits++;
+            }
+        }
+        begin = end;
+    }
+
+    hits_.fetch_add(hits, std::memory_order_relaxed);
+    misses_.fetch_add(keys.size() - hits, std::memory_order_relaxed);
+    if (capture_) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            capture_->entries.emplace(keys[i], results[i]);
+        }
+    }
+    return results;
+}
+
+void NFPCache::insertBatch(const std::vector<BatchEntry>& entries) {
+    // Encode and size entries before taking any lock
+    std::vector<size_t> order;
+    std::vector<size_t> shardOf(entries.size());
+    std::vector<Stored> stored(entries.size());
+    order.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (!entries[i].nfp) {
+            continue;
+        }
+        order.push_back(i);
+        shardOf[i] = shardIndex(entries[i].key);
+        stored[i] = prepare(entries[i].nfp);
+    }
+    // Stable, so repeated keys keep their insert() order
+    std::stable_sort(order.begin(), order.end(),
+                     [&shardOf](size_t a, size_t b) { return shardOf[a] < shardOf[b]; });
+
+    size_t limit = memoryLimit_.load(std::memory_order_relaxed);
+    size_t shardBudget = std::max<size_t>(limit / NUM_SHARDS, 1);
+
+    for (size_t begin = 0; begin < order.size();) {
+        Shard& shard = shards_[shardOf[order[begin]]];
+        size_t end = begin;
+        ProfiledLock<boost::shared_mutex> lock(shard.mutex, exclusiveLockStats_);
+        for (; end < order.size() && shardOf[order[end]] == shardOf[order[begin]]; end++) {
+            const BatchEntry& entry = entries[order[end]];
+            size_t entryBytes = stored[order[end]].bytes;
+            double costPerByte = (entry.cost > 0.0 ? entry.cost : static_cast<double>(entryBytes)) / entryBytes;
+            insertLocked(shard, entry.key, std::move(stored[order[end]]), costPerByte);
+        }
+        if (limit > 0 && shard.residentBytes > shardBudget) {
+            evictFromShard(shard, shardBudget);
+        }
+        begin = end;
+    }
+}
+
+void NFPCache::evictFromShard(Shard& shard, size_t shardBudget) {
+    size_t target = static_cast<size_t>(shardBudget * EVICTION_TARGET_RATIO);
+
+    // Order entries by ascending priority (cheapest to lose first)
+    using Candidate = std::pair<double, decltype(shard.entries)::iterator>;
+    std::vector<Candidate> candidates;
+    candidates.reserve(shard.entries.size());
+    for (auto it = shard.entries.begin(); it != shard.entries.end(); ++it) {
+        candidates.emplace_back(it->second.priority.load(std::memory_order_relaxed), it);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.first < b.first; });
+
+    double inflation = shard.inflation.load(std::memory_order_relaxed);
+    size_t evicted = 0;
+
+    for (const auto& candidate : candidates) {
+        if (shard.residentBytes <= target) {
+            break;
+        }
+        // Handles already given out stay valid; only the cache reference is dropped
+        inflation = std::max(inflation, candidate.first);
+        shard.residentBytes -= candidate.second->second.bytes;
+        residentBytes_.fetch_sub(candidate.second->second.bytes, std::memory_order_relaxed);
+        shard.entries.erase(candidate.second);
+        ++evicted;
+    }
+
+    // Age the remaining entries relative to what was just evicted
+    shard.inflation.store(inflation, std::memory_order_relaxed);
+    evictions_.fetch_add(evicted, std::memory_order_relaxed);
+}
+
+void NFPCache::setMemoryLimit(size_t bytes) {
+    memoryLimit_.store(bytes, std::memory_order_relaxed);
+    if (bytes == 0) {
+        return;
+    }
+
+    // Apply the new budget to entries already cached
+    size_t shardBudget = std::max<size_t>(bytes / NUM_SHARDS, 1);
+    for (Shard& shard : shards_) {
+        ProfiledLock<boost::shared_mutex> lock(shard.mutex, exclusiveLockStats_);
+        if (shard.residentBytes > shardBudget) {
+            evictFromShard(shard, shardBudget);
+        }
+    }
+}
+
+void NFPCache::setCompactStorage(double scale) {
+    if (scale < 0.0) {
+        scale = 0.0;
+    }
+    if (compactScale_.exchange(scale, std::memory_order_relaxed) != scale) {
+        // Entries stored in the other form, or on another grid, are dropped
+        clear();
+    }
+}
+
+NFPCache::Statistics NFPCache::statistics() const {
+    Statistics stats;
+    stats.hits = hitCount();
+    stats.misses = missCount();
+    stats.entries = size();
+    stats.residentBytes = residentBytes();
+    stats.evictions = evictionCount();
+    stats.memoryLimit = memoryLimit();
+    return stats;
 }
 
 void NFPCache::clear() {
-    boost::unique_lock<boost::shared_mutex> lock(mutex_);
-    cache_.clear();
+    for (Shard& shard : shards_) {
+        ProfiledLock<boost::shared_mutex> lock(shard.mutex, exclusiveLockStats_);
+        residentBytes_.fetch_sub(shard.residentBytes, std::memory_order_relaxed);
+        shard.entries.clear();
+        shard.residentBytes = 0;
+        shard.inflation.store(0.0, std::memory_order_relaxed);
+    }
 }
 
 size_t NFPCache::size() const {
-    boost::shared_lock<boost::shared_mutex> lock(mutex_);
-    return cache_.size();
+    size_t total = 0;
+    for (const Shard& shard : shards_) {
+        ProfiledLock<boost::shared_mutex, true> lock(shard.mutex, sharedLockStats_);
+        total += shard.entries.size();
+    }
+    return total;
 }
 
 void NFPCache::resetStatistics() {
-    boost::unique_lock<boost::shared_mutex> lock(mutex_);
-    hits_ = 0;
-    misses_ = 0;
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    evictions_.store(0, std::memory_order_relaxed);
+    sharedLockStats_.reset();
+    exclusiveLockStats_.reset();
 }
 
 } // namespace deepnest
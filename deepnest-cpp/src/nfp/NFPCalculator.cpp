@@ -1,18 +1,223 @@
 #include "../../include/deepnest/nfp/NFPCalculator.h"
 #include "../../include/deepnest/nfp/MinkowskiSum.h"
+#include "../../include/deepnest/nfp/Libnest2D_NFP.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
 #include "../../include/deepnest/geometry/PolygonOperations.h"
 #include "../../include/deepnest/config/DeepNestConfig.h"
+#include "../../include/deepnest/StageTimes.h"
+#include "../../include/deepnest/Trace.h"
 #include <clipper2/clipper.engine.h>
 #include <clipper2/clipper.minkowski.h>
 #include <algorithm>
+#include <cstdint>
+#include <exception>
 #include <iostream>
 #include <cmath>
 
 namespace deepnest {
 
+namespace {
+
+// Total vertex count including holes, used to estimate Minkowski cost
+size_t vertexCount(const Polygon& polygon) {
+    size_t count = polygon.points.size();
+    for (const auto& child : polygon.children) {
+        count += vertexCount(child);
+    }
+    return count;
+}
+
+// Whether the pair takes the linear convex Minkowski path
+bool isConvexPair(const Polygon& A, const Polygon& B) {
+    return A.convex && B.convex && A.children.empty();
+}
+
+// Recompute cost of an NFP grows with the product of the input sizes,
+// except for convex pairs which are merged in linear time
+double nfpRecomputeCost(const Polygon& A, const Polygon& B) {
+    if (isConvexPair(A, B)) {
+        return static_cast<double>(A.points.size() + B.points.size());
+    }
+    return static_cast<double>(vertexCount(A)) * static_cast<double>(vertexCount(B));
+}
+
+// Axis-aligned rectangle without holes, so the inner NFP is analytic.
+// The area check rejects degenerate or self-intersecting corner orders.
+bool isPlainRectangle(const Polygon& A) {
+    if (!A.children.empty() || A.points.size() < 4 ||
+        !GeometryUtil::isRectangle(A.points, 0.001)) {
+        return false;
+    }
+    BoundingBox bounds = A.bounds();
+    double boxArea = bounds.width * bounds.height;
+    return boxArea > 0 && std::abs(std::abs(GeometryUtil::polygonArea(A.points)) - boxArea) <= 1e-6 * boxArea;
+}
+
+// Give cached NFPs their Clipper representation so placement unions and
+// differences skip the per-call conversion, and their coordinates buffer
+// so the area and bounds every placement asks for are computed once.
+// In integer geometry mode the Clipper path comes from snapping them to
+// its grid
+void prepareCachedNfps(std::vector<Polygon>& nfps, double scale, bool integerGeometry) {
+    for (auto& nfp : nfps) {
+        if (!nfp.scaledPathAt(scale)) {
+            if (integerGeometry) {
+                nfp.snapToGrid(scale);
+            } else {
+                nfp.updateScaledPath(scale);
+            }
+        }
+        // Pockets of exploreConcave outer NFPs join the placement union too
+        for (auto& child : nfp.children) {
+            if (!child.scaledPathAt(scale)) {
+                child.updateScaledPath(scale);
+            }
+        }
+        if (!nfp.currentCoordinates()) {
+            nfp.updateCoordinates();
+        }
+    }
+}
+
+} // anonymous namespace
+
 NFPCalculator::NFPCalculator(NFPCache& cache)
-    : cache_(cache) {
+    : NFPCalculator(cache, DeepNestConfig::getInstance()) {
+}
+
+NFPCalculator::NFPCalculator(NFPCache& cache, const DeepNestConfig& config)
+    : cache_(cache)
+    , clipperScale_(config.getClipperScale())
+    , integerGeometry_(config.integerGeometry)
+    , rotationEquivariant_(false)
+    , exploreConcave_(config.exploreConcave)
+    , computations_(0)
+    , deduplicated_(0)
+    , mirrored_(0)
+    , holesSkipped_(0)
+    , accelerated_(0)
+    , negative_(0) {
+    if (config.nfpAcceleration) {
+        accelerator_ = NFPAccelerator::detect();
+    }
+}
+
+std::shared_ptr<const HoleIndex> NFPCalculator::holeIndex(const Polygon& A) {
+    const std::pair<uint64_t, double> key(shapeKey(A, A.id), A.rotation);
+    boost::mutex::scoped_lock lock(holeIndexMutex_);
+    std::shared_ptr<const HoleIndex>& index = holeIndexes_[key];
+    if (!index) {
+        index = std::make_shared<const HoleIndex>(A);
+    }
+    return index;
+}
+
+NFPCache::NFPHandle NFPCalculator::computeOnce(const NFPCache::NFPKey& key,
+                                               const std::function<NFPCache::NFPHandle()>& compute) {
+    std::promise<NFPCache::NFPHandle> promise;
+    for (;;) {
+        std::shared_future<NFPCache::NFPHandle> pending;
+        {
+            boost::mutex::scoped_lock lock(inFlightMutex_);
+            auto it = inFlight_.find(key);
+            if (it != inFlight_.end()) {
+                pending = it->second;
+            } else {
+                inFlight_.emplace(key, promise.get_future().share());
+            }
+        }
+
+        if (!pending.valid()) {
+            break;
+        }
+
+        // Another thread is already computing this NFP
+        deduplicated_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            STAGE_SCOPE(Wait);
+            return pending.get();
+        } catch (const OperationCancelled&) {
+            // Its batch was cancelled before getting to it; claim it here
+        }
+    }
+
+    NFPCache::NFPHandle result;
+    try {
+        // The previous owner may have finished between our cache miss and
+        // registering, in which case its result is already cached
+        if (cache_.has(key)) {
+            result = cache_.lookup(key);
+        }
+        if (!result) {
+            computations_.fetch_add(1, std::memory_order_relaxed);
+            result = compute();
+        }
+        if (NFPCache::isTombstone(result)) {
+            result = nullptr;
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        boost::mutex::scoped_lock lock(inFlightMutex_);
+        inFlight_.erase(key);
+        throw;
+    }
+
+    promise.set_value(result);
+    {
+        boost::mutex::scoped_lock lock(inFlightMutex_);
+        inFlight_.erase(key);
+    }
+    return result;
+}
+
+uint64_t NFPCalculator::shapeKey(const Polygon& polygon, int fallbackId) {
+    // Untagged polygons (no fingerprint) fall back to their numeric id
+    return polygon.fingerprint != 0
+        ? polygon.fingerprint
+        : static_cast<uint64_t>(static_cast<uint32_t>(fallbackId));
+}
+
+NFPCache::NFPKey NFPCalculator::outerKey(const Polygon& A, const Polygon& B,
+                                         double rotA, double rotB) const {
+    if (rotationEquivariant_) {
+        return NFPCache::NFPKey(shapeKey(A, A.id), shapeKey(B, B.id), 0.0, rotB - rotA, false);
+    }
+    return NFPCache::NFPKey(shapeKey(A, A.id), shapeKey(B, B.id), rotA, rotB, false);
+}
+
+void NFPCalculator::setRotationEquivariant(bool enabled) {
+    rotationEquivariant_ = enabled;
+}
+
+void NFPCalculator::setBackendSelector(const NFPBackendSelector& selector) {
+    backends_ = selector;
+}
+
+void NFPCalculator::setAccelerator(std::shared_ptr<NFPAccelerator> accelerator) {
+    accelerator_ = std::move(accelerator);
+}
+
+void NFPCalculator::setParallelFor(GeometryUtil::ParallelFor parallelFor) {
+    parallelFor_ = std::move(parallelFor);
+}
+
+NFPBackend NFPCalculator::backendFor(const Polygon& A, const Polygon& B) const {
+    if (exploreConcave_ && !A.convex) {
+        return NFPBackend::Orbital;
+    }
+    return backends_.select(A, B);
+}
+
+void NFPCalculator::setPersistentStore(std::shared_ptr<PersistentNFPStore> store) {
+    store_ = std::move(store);
+}
+
+PersistentNFPStore::Key NFPCalculator::storeKey(const Polygon& A, const Polygon& B,
+                                                double rotationA, bool inside) {
+    // Geometry (not ids) identifies the pair, so keys are stable across runs
+    return PersistentNFPStore::Key(PersistentNFPStore::geometryHash(A),
+                                   PersistentNFPStore::geometryHash(B),
+                                   rotationA, B.rotation, inside);
 }
 
 Polygon NFPCalculator::computeNFP(const Polygon& A, const Polygon& B) const {
@@ -80,40 +285,52 @@ Polygon NFPCalculator::computeNFP(const Polygon& A, const Polygon& B) const {
     return largestNFP;
 }
 
-Polygon NFPCalculator::computeDiffNFP(const Polygon& A, const Polygon& B) const {
-    
-    const double CLIPPER_SCALE = 10000.0;
-    
-    // Convert A to Clipper2 Path64 and scale up
-    Clipper2Lib::Path64 pathA;
-    pathA.reserve(A.points.size());
+Polygon NFPCalculator::computeDiffNFP(const Polygon& A, const Polygon& B,
+                                      const Clipper2Lib::Paths64* convolved) const {
+
+    // JavaScript: toClipperCoordinates / toNestCoordinates(..., 10000000)
+    const double scale = clipperScale_;
+
     for (const auto& pt : A.points) {
         if (std::isnan(pt.x) || std::isnan(pt.y) || std::isinf(pt.x) || std::isinf(pt.y)) {
             std::cerr << "ERROR: NaN or Inf detected in polygon A points during NFP calculation" << std::endl;
             return Polygon();
         }
-        pathA.push_back(Clipper2Lib::Point64(
-            static_cast<int64_t>(pt.x * CLIPPER_SCALE),
-            static_cast<int64_t>(pt.y * CLIPPER_SCALE)
-        ));
     }
-    
-    // Convert B to Clipper2 Path64, scale up, and NEGATE (critical for NFP)
-    Clipper2Lib::Path64 pathB;
-    pathB.reserve(B.points.size());
     for (const auto& pt : B.points) {
         if (std::isnan(pt.x) || std::isnan(pt.y) || std::isinf(pt.x) || std::isinf(pt.y)) {
             std::cerr << "ERROR: NaN or Inf detected in polygon B points during NFP calculation" << std::endl;
             return Polygon();
         }
-        pathB.push_back(Clipper2Lib::Point64(
-            static_cast<int64_t>(-pt.x * CLIPPER_SCALE),  // Negate X
-            static_cast<int64_t>(-pt.y * CLIPPER_SCALE)   // Negate Y
-        ));
     }
-    
+
+    // Use the pre-scaled paths when the polygons carry them
+    Clipper2Lib::Path64 scaledA;
+    const Clipper2Lib::Path64* pathA = A.scaledPathAt(scale);
+    if (!pathA) {
+        scaledA = PolygonOperations::toPath64(A.points, scale);
+        pathA = &scaledA;
+    }
+
+    Clipper2Lib::Path64 scaledB;
+    const Clipper2Lib::Path64* pathB = B.scaledPathAt(scale);
+    if (!pathB) {
+        scaledB = PolygonOperations::toPath64(B.points, scale);
+        pathB = &scaledB;
+    }
+
+    // NEGATE B (critical for NFP)
+    Clipper2Lib::Path64 negB;
+    negB.reserve(pathB->size());
+    for (const auto& pt : *pathB) {
+        negB.push_back(Clipper2Lib::Point64(-pt.x, -pt.y));
+    }
+
     // Call Clipper2::MinkowskiSum (equivalent to ClipperLib.Clipper.MinkowskiSum)
-    Clipper2Lib::Paths64 solution = Clipper2Lib::MinkowskiSum(pathA, pathB, true);
+    // MinkowskiSum is the union of its edge-pair quadrilaterals
+    Clipper2Lib::Paths64 solution = convolved
+        ? Clipper2Lib::Union(*convolved, Clipper2Lib::FillRule::NonZero)
+        : Clipper2Lib::MinkowskiSum(*pathA, negB, true);
 
 
     // JavaScript: Select polygon with largest area (lines 666-674)
@@ -126,78 +343,349 @@ Polygon NFPCalculator::computeDiffNFP(const Polygon& A, const Polygon& B) const
     //         largestArea = sarea;
     //     }
     // }
-    
-    Polygon largestNFP;
+    // Clipper's Area has the sign of -GeometryUtil.polygonArea, so the
+    // selection is done on the integer paths
+    Clipper2Lib::Path64* largest = nullptr;
     double largestArea = 0.0;
 
-    for (const auto& nfpPath : solution) {
-        // Convert from Clipper2 coordinates back to nest coordinates
-        std::vector<Point> nfpPoints;
-        nfpPoints.reserve(nfpPath.size());
-        
-        for (const auto& pt : nfpPath) {
-            nfpPoints.push_back(Point{
-                static_cast<double>(pt.x) / CLIPPER_SCALE,
-                static_cast<double>(pt.y) / CLIPPER_SCALE
-            });
-        }
-        
-        // Calculate area (JavaScript uses negative area: -GeometryUtil.polygonArea(n))
-        double area = -GeometryUtil::polygonArea(nfpPoints);
-        
+    for (auto& nfpPath : solution) {
+        double area = Clipper2Lib::Area(nfpPath);
         if (area > largestArea) {
             largestArea = area;
-            largestNFP.points = std::move(nfpPoints);
+            largest = &nfpPath;
         }
     }
 
-    if (!B.points.empty()) {
-        largestNFP = largestNFP.translate(B.points[0].x, B.points[0].y);
+    if (!largest) {
+        return Polygon();
     }
 
+    // Translate by B's first point in integer coordinates
+    if (!pathB->empty()) {
+        const Clipper2Lib::Point64 offset = pathB->front();
+        for (auto& pt : *largest) {
+            pt.x += offset.x;
+            pt.y += offset.y;
+        }
+    }
+
+    Polygon largestNFP(PolygonOperations::fromPath64(*largest, scale));
+    auto scaled = std::make_shared<Polygon::ScaledPath>();
+    scaled->path = std::move(*largest);
+    scaled->scale = scale;
+    largestNFP.scaledPath = std::move(scaled);
+
     return largestNFP;
 }
 
+Polygon NFPCalculator::computeConvexNFP(const Polygon& A, const Polygon& B) const {
+    // Negate B as in computeDiffNFP (critical for NFP)
+    std::vector<Point> negB;
+    negB.reserve(B.points.size());
+    for (const auto& pt : B.points) {
+        if (std::isnan(pt.x) || std::isnan(pt.y) || std::isinf(pt.x) || std::isinf(pt.y)) {
+            std::cerr << "ERROR: NaN or Inf detected in polygon B points during NFP calculation" << std::endl;
+            return Polygon();
+        }
+        negB.push_back(Point(-pt.x, -pt.y));
+    }
+
+    Polygon nfp;
+    nfp.points = GeometryUtil::convexMinkowskiSum(A.points, negB);
+
+    if (!nfp.points.empty() && !B.points.empty()) {
+        nfp = nfp.translate(B.points[0].x, B.points[0].y);
+    }
+
+    return nfp;
+}
+
+Polygon NFPCalculator::computeWithBackend(NFPBackend backend, const Polygon& A, const Polygon& B) const {
+    if (A.points.empty() || B.points.empty()) {
+        return Polygon();
+    }
+
+    std::vector<std::vector<Point>> candidates;
+    switch (backend) {
+        case NFPBackend::Convex:
+            return computeConvexNFP(A, B);
+        case NFPBackend::ClipperMinkowski:
+            return computeDiffNFP(A, B);
+        case NFPBackend::BoostConvolution:
+            return computeNFP(A, B);
+        case NFPBackend::Orbital:
+            // Already the locus of B[0], like the Minkowski results
+            if (exploreConcave_) {
+                const GeometryUtil::ParallelFor serial = [](size_t count,
+                                                            const std::function<void(size_t, size_t)>& body) {
+                    body(0, count);
+                };
+                candidates = GeometryUtil::noFitPolygon(A.points, B.points, false, true,
+                                                        parallelFor_ ? parallelFor_ : serial);
+            } else {
+                candidates = GeometryUtil::noFitPolygon(A.points, B.points, false, false);
+            }
+            break;
+        case NFPBackend::Libnfporb:
+            for (auto& polygon : libnest2d_port::libnfporb_generateNFP(A, B)) {
+                candidates.push_back(std::move(polygon.points));
+            }
+            break;
+    }
+
+    // Largest loop, oriented like the Clipper result
+    Polygon largest;
+    double largestArea = 0.0;
+    size_t largestIndex = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        double area = std::abs(GeometryUtil::polygonArea(candidates[i]));
+        if (candidates[i].size() >= 3 && area > largestArea) {
+            largestArea = area;
+            largestIndex = i;
+        }
+    }
+    if (largestArea > 0.0) {
+        largest.points = std::move(candidates[largestIndex]);
+    }
+    if (GeometryUtil::polygonArea(largest.points) > 0) {
+        std::reverse(largest.points.begin(), largest.points.end());
+    }
+
+    // Pockets, oriented the other way so they cancel under NonZero
+    if (backend == NFPBackend::Orbital && exploreConcave_ && largestArea > 0.0) {
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (i == largestIndex || candidates[i].size() < 3) {
+                continue;
+            }
+            Polygon pocket(std::move(candidates[i]));
+            if (GeometryUtil::polygonArea(pocket.points) < 0) {
+                std::reverse(pocket.points.begin(), pocket.points.end());
+            }
+            largest.children.push_back(std::move(pocket));
+        }
+    }
+    return largest;
+}
+
 Polygon NFPCalculator::getOuterNFP(const Polygon& A, const Polygon& B, bool inside) {
+    NFPCache::NFPHandle nfp = getOuterNFPShared(A, B, inside);
+    if (!nfp || nfp->empty()) {
+        return Polygon(); // Failed to compute
+    }
+    return nfp->front();
+}
+
+NFPCache::NFPHandle NFPCalculator::getOuterNFPShared(const Polygon& A, const Polygon& B, bool inside) {
+    // Equivariant mode: the NFP lives in A's unrotated frame and is rotated into place
+    if (rotationEquivariant_ && !inside && NFPCache::rotationKey(A.rotation) != 0) {
+        return getRotatedOuterNFP(A, B);
+    }
+
     // Try cache lookup first (background.js line 636-640)
-    std::vector<Polygon> cached;
-    if (cache_.find(A.id, B.id, A.rotation, B.rotation, cached, inside)) {
-        // Cache hit - return first polygon from cached result
-        if (!cached.empty()) {
-            return cached.front();
+    NFPCache::NFPKey key = inside
+        ? NFPCache::NFPKey(shapeKey(A, A.id), shapeKey(B, B.id), A.rotation, B.rotation, true)
+        : outerKey(A, B, A.rotation, B.rotation);
+    const bool timed = StageTimer::enabled();
+    const uint64_t wall = timed ? StageTimer::wallNow() : 0;
+    const uint64_t cpu = timed ? StageTimer::cpuNow() : 0;
+    NFPCache::NFPHandle cached = cache_.lookup(key);
+    if (NFPCache::isTombstone(cached)) {
+        negative_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if (cached) {
+        // Cache hit - hand out the shared entry without copying
+        if (timed) {
+            StageTimer::record(Stage::NfpOuterCached, StageTimer::wallNow() - wall, StageTimer::cpuNow() - cpu);
+        }
+        return cached;
+    }
+
+    // Frame NFPs (inside=true) are never cached, so there is nothing to share
+    if (inside) {
+        computations_.fetch_add(1, std::memory_order_relaxed);
+        return computeOuterNFP(A, B, true);
+    }
+
+    if (NFPCache::NFPHandle mirrored = getMirroredOuterNFP(A, B)) {
+        return mirrored;
+    }
+    return computeOnce(key, [&]() { return computeOuterNFP(A, B, false); });
+}
+
+NFPCache::NFPHandle NFPCalculator::getMirroredOuterNFP(const Polygon& A, const Polygon& B) {
+    // Only plain Minkowski NFPs are point-symmetric; hole handling is not
+    if (!A.children.empty() || !B.children.empty() || A.points.empty() || B.points.empty()) {
+        return nullptr;
+    }
+
+    NFPCache::NFPKey own = outerKey(A, B, A.rotation, B.rotation);
+    NFPCache::NFPKey key = outerKey(B, A, B.rotation, A.rotation);
+    if (key == own || !cache_.has(key)) {
+        return nullptr;
+    }
+    NFPCache::NFPHandle cached = cache_.lookup(key);
+    if (!cached || cached->empty()) {
+        return nullptr;
+    }
+
+    // NFP(B,A) = B + (-A) + A[0], so NFP(A,B) = A + (-B) + B[0] = -NFP(B,A) + A[0] + B[0].
+    // In equivariant mode the cached entry is in B's unrotated frame.
+    const double theta = rotationEquivariant_ ? B.rotation : 0.0;
+    const Point offset = A.points[0] + B.points[0];
+
+    std::vector<Polygon> reflected;
+    reflected.reserve(cached->size());
+    for (const auto& nfp : *cached) {
+        Polygon oriented = NFPCache::rotationKey(theta) != 0 ? nfp.rotate(theta) : nfp;
+        for (auto& p : oriented.points) {
+            p = offset - p;
+        }
+        oriented.scaledPath.reset();
+        oriented.coordinates.reset();
+        for (auto& pocket : oriented.children) {
+            for (auto& p : pocket.points) {
+                p = offset - p;
+            }
+            pocket.scaledPath.reset();
+            pocket.coordinates.reset();
+        }
+        reflected.push_back(std::move(oriented));
+    }
+    mirrored_.fetch_add(1, std::memory_order_relaxed);
+    return std::make_shared<const std::vector<Polygon>>(std::move(reflected));
+}
+
+NFPCache::NFPHandle NFPCalculator::getRotatedOuterNFP(const Polygon& A, const Polygon& B) {
+    const double theta = A.rotation;
+
+    NFPCache::NFPKey key = outerKey(A, B, theta, B.rotation);
+    NFPCache::NFPHandle canonical = cache_.lookup(key);
+    if (NFPCache::isTombstone(canonical)) {
+        negative_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if (!canonical) {
+        if (NFPCache::NFPHandle mirrored = getMirroredOuterNFP(A, B)) {
+            return mirrored;
+        }
+        canonical = computeOnce(key, [&]() {
+            // Rotate both polygons back by A's rotation and compute there
+            Polygon canonicalA = A.rotate(-theta);
+            canonicalA.rotation = 0.0;
+            Polygon canonicalB = B.rotate(-theta);
+            canonicalB.rotation = B.rotation - theta;
+            return computeOuterNFP(canonicalA, canonicalB, false);
+        });
+    }
+    if (!canonical) {
+        return nullptr;
+    }
+
+    // Rotate on read: NFP(rot(A,a), rot(B,b)) = rot(NFP(A, rot(B,b-a)), a)
+    std::vector<Polygon> rotated;
+    rotated.reserve(canonical->size());
+    for (const auto& nfp : *canonical) {
+        rotated.push_back(nfp.rotate(theta));
+    }
+    return std::make_shared<const std::vector<Polygon>>(std::move(rotated));
+}
+
+NFPCache::NFPHandle NFPCalculator::computeOuterNFP(const Polygon& A, const Polygon& B, bool inside) {
+    NFPCache::NFPHandle handle = computeOuterEntry(A, B, inside);
+
+    // Store in cache if not computing inner NFP (background.js line 697-707)
+    // Only cache outer NFPs (when inside=false); failures as a tombstone
+    if (!inside) {
+        cache_.insert(outerKey(A, B, A.rotation, B.rotation), handle ? handle : NFPCache::tombstone(),
+                      nfpRecomputeCost(A, B));
+    }
+    return handle;
+}
+
+NFPCache::NFPHandle NFPCalculator::computeOuterEntry(const Polygon& A, const Polygon& B, bool inside,
+                                                     const Clipper2Lib::Paths64* convolved) {
+    TRACE_SCOPE("nfp.computeOuter");
+    STAGE_SCOPE(NfpOuterCompute);
+    // Frame NFPs (inside=true) are intermediate results and never persisted
+    const bool persist = store_ && !inside;
+    PersistentNFPStore::Key persistKey;
+    if (persist) {
+        persistKey = storeKey(A, B, A.rotation, false);
+        std::vector<Polygon> stored;
+        if (store_->find(persistKey, stored) && !stored.empty()) {
+            prepareCachedNfps(stored, clipperScale_, integerGeometry_);
+            return std::make_shared<const std::vector<Polygon>>(std::move(stored));
+        }
+    }
+
+    // Holes B cannot fit in are filled by the Minkowski sum anyway; leave
+    // them out before computing (background.js checked hole bounds too).
+    // A frame's only child is the sheet, checked by computeInnerNFP
+    Polygon trimmed;
+    const Polygon* stationary = &A;
+    if (!inside && !A.children.empty()) {
+        const std::vector<size_t> fitting = holeIndex(A)->candidates(HoleIndex::footprint(B));
+        if (fitting.size() < A.children.size()) {
+            holesSkipped_.fetch_add(A.children.size() - fitting.size(), std::memory_order_relaxed);
+            trimmed = A;
+            trimmed.children.clear();
+            for (size_t i : fitting) {
+                trimmed.children.push_back(A.children[i]);
+            }
+            stationary = &trimmed;
         }
     }
 
-    // Get config to check useHoles setting
-    const DeepNestConfig& config = DeepNestConfig::getInstance();
-    
     // Not found in cache - compute NFP (background.js line 643-684)
     // Use computeNFPWithHoles if useHoles is enabled and not computing inner NFP
     Polygon nfp;
     
-    if (inside || !A.children.empty()) 
+    if (inside || !stationary->children.empty()) 
     {
         // Compute NFP with holes support (svgnest.js lines 415-438)
-        nfp = computeNFP(A, B);
+        nfp = computeNFP(*stationary, B);
      }
     else
     {
-        nfp = computeDiffNFP(A, B);
-        
+        // Cheapest engine known to be correct for the pair's class; the
+        // class reference recomputes it if that engine fails
+        NFPBackend backend = backendFor(*stationary, B);
+        NFPBackend fallback = NFPBackendSelector::reference(NFPBackendSelector::classify(*stationary, B));
+        try {
+            if (convolved && backend == NFPBackend::ClipperMinkowski && stationary == &A) {
+                nfp = computeDiffNFP(A, B, convolved);
+            } else {
+                nfp = computeWithBackend(backend, *stationary, B);
+            }
+        } catch (const std::exception& e) {
+            if (backend == fallback) {
+                throw;
+            }
+            std::cerr << "WARNING: NFP backend " << NFPBackendSelector::backendName(backend)
+                      << " failed: " << e.what() << std::endl;
+        }
+        if (nfp.points.empty() && backend != fallback) {
+            nfp = computeWithBackend(fallback, *stationary, B);
+        }
     }
 
     if (nfp.points.empty()) {
-        return Polygon(); // Failed to compute
+        return nullptr; // Failed to compute
     }
 
-    // Store in cache if not computing inner NFP (background.js line 697-707)
-    // Only cache outer NFPs (when inside=false)
+    std::vector<Polygon> entry;
+    entry.push_back(std::move(nfp));
     if (!inside) {
-        std::vector<Polygon> cacheEntry = {nfp};
-        cache_.insert(A.id, B.id, A.rotation, B.rotation, cacheEntry, inside);
+        prepareCachedNfps(entry, clipperScale_, integerGeometry_);
     }
+    NFPCache::NFPHandle handle = std::make_shared<const std::vector<Polygon>>(std::move(entry));
 
-    return nfp;
+    if (persist) {
+        store_->append(persistKey, *handle);
+    }
+
+    return handle;
 }
 
 Polygon NFPCalculator::createFrame(const Polygon& A) const {
@@ -236,13 +724,82 @@ Polygon NFPCalculator::getFrame(const Polygon& A) const {
 }
 
 std::vector<Polygon> NFPCalculator::getInnerNFP(const Polygon& A, const Polygon& B) {
+    NFPCache::NFPHandle nfp = getInnerNFPShared(A, B);
+    if (!nfp) {
+        return {};
+    }
+    return *nfp;
+}
+
+NFPCache::NFPHandle NFPCalculator::getInnerNFPShared(const Polygon& A, const Polygon& B) {
     // Try cache lookup first (background.js line 735-742)
     // For inner NFP, rotation of A is always 0
-    std::vector<Polygon> cached;
-    if (cache_.find(A.source, B.source, 0.0, B.rotation, cached, true)) {
+    NFPCache::NFPKey key(shapeKey(A, A.source), shapeKey(B, B.source), 0.0, B.rotation, true);
+    NFPCache::NFPHandle cached = cache_.lookup(key);
+    if (NFPCache::isTombstone(cached)) {
+        negative_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if (cached) {
         return cached;
     }
 
+    return computeOnce(key, [&]() {
+        NFPCache::NFPHandle handle = computeInnerNFP(A, B);
+        if (!handle) {
+            // B does not fit: remembered, so later requests skip the frame NFP
+            cache_.insert(key, NFPCache::tombstone(), nfpRecomputeCost(A, B) * (1 + A.children.size()));
+        }
+        return handle;
+    });
+}
+
+NFPCache::NFPHandle NFPCalculator::computeInnerNFP(const Polygon& A, const Polygon& B) {
+    TRACE_SCOPE("nfp.computeInner");
+    STAGE_SCOPE(NfpInner);
+    // Rectangular sheets without holes have an analytic inner-fit rectangle
+    // (cheaper than the store, so such NFPs are never persisted)
+    if (isPlainRectangle(A)) {
+        std::vector<std::vector<Point>> rect = GeometryUtil::noFitPolygonRectangle(A.points, B.points);
+        if (rect.empty()) {
+            // B does not fit in any orientation-preserving position
+            return nullptr;
+        }
+
+        // Same winding as the frame-based result
+        std::vector<Polygon> result;
+        for (auto& points : rect) {
+            if (GeometryUtil::polygonArea(points) < 0) {
+                std::reverse(points.begin(), points.end());
+            }
+            result.push_back(Polygon(points));
+        }
+        prepareCachedNfps(result, clipperScale_, integerGeometry_);
+
+        NFPCache::NFPHandle handle = std::make_shared<const std::vector<Polygon>>(std::move(result));
+        cache_.insert(NFPCache::NFPKey(shapeKey(A, A.source), shapeKey(B, B.source), 0.0, B.rotation, true), handle,
+                      static_cast<double>(B.points.size()));
+        return handle;
+    }
+
+    // B cannot fit in the sheet at all: the frame NFP would have no regions
+    if (!HoleIndex::mayFit(HoleIndex::container(A), HoleIndex::footprint(B))) {
+        return nullptr;
+    }
+
+    PersistentNFPStore::Key persistKey;
+    if (store_) {
+        persistKey = storeKey(A, B, 0.0, true);
+        std::vector<Polygon> stored;
+        if (store_->find(persistKey, stored) && !stored.empty()) {
+            prepareCachedNfps(stored, clipperScale_, integerGeometry_);
+            NFPCache::NFPHandle handle = std::make_shared<const std::vector<Polygon>>(std::move(stored));
+            cache_.insert(NFPCache::NFPKey(shapeKey(A, A.source), shapeKey(B, B.source), 0.0, B.rotation, true), handle,
+                          nfpRecomputeCost(A, B) * (1 + A.children.size()));
+            return handle;
+        }
+    }
+
     // DEBUG LOGGING - DISABLED for cleaner output
     // static bool first_call = true;
     // if (first_call) {
@@ -279,20 +836,21 @@ std::vector<Polygon> NFPCalculator::getInnerNFP(const Polygon& A, const Polygon&
     // }
 
     // Compute outer NFP between frame and B with inside=true (background.js line 746)
-    Polygon frameNfp = getOuterNFP(frame, B, true);
+    NFPCache::NFPHandle frameNfpHandle = getOuterNFPShared(frame, B, true);
 
     // CRITICAL FIX: Safety check before accessing children
     // If frameNfp is empty (failed to compute), return immediately
-    if (frameNfp.points.empty()) {
+    if (!frameNfpHandle || frameNfpHandle->empty()) {
         std::cerr << "WARNING: getInnerNFP failed for A(id=" << A.id << ") and B(id=" << B.id << ")" << std::endl;
         std::cerr << "  Frame NFP computation returned empty polygon" << std::endl;
-        return {}; // Return empty vector
+        return nullptr;
     }
+    const Polygon& frameNfp = frameNfpHandle->front();
 
     // Check if computation succeeded (background.js line 748-750)
     if (frameNfp.children.empty()) {
         std::cerr << "WARNING: getInnerNFP has no children for A(id=" << A.id << ") and B(id=" << B.id << ")" << std::endl;
-        return {}; // Return empty vector
+        return nullptr;
     }
 
     std::vector<Polygon> result;
@@ -319,11 +877,28 @@ std::vector<Polygon> NFPCalculator::getInnerNFP(const Polygon& A, const Polygon&
 
     // Handle holes in A (background.js line 753-754)
     if (!A.children.empty()) {
+        // Positions where B overlaps a hole lie within the hole's bounds
+        // grown by B's size on every side; holes out of reach of every
+        // region cannot remove anything, so their NFP is not computed
+        const BoundingBox boundsB = B.bounds();
+        std::vector<BoundingBox> regionBounds;
+        for (const auto& region : result) {
+            regionBounds.push_back(region.bounds());
+        }
+
         // For each hole in A, compute its NFP with B
         for (const auto& hole : A.children) {
-            Polygon holeNfp = getOuterNFP(hole, B, false);
+            const BoundingBox reach = hole.bounds().expand(std::max<double>(boundsB.width, boundsB.height));
+            if (std::none_of(regionBounds.begin(), regionBounds.end(),
+                             [&](const BoundingBox& box) { return box.intersects(reach); })) {
+                holesSkipped_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
 
-            if (!holeNfp.points.empty()) {
+            NFPCache::NFPHandle holeNfpHandle = getOuterNFPShared(hole, B, false);
+
+            if (holeNfpHandle && !holeNfpHandle->empty()) {
+                const Polygon& holeNfp = holeNfpHandle->front();
                 // Subtract hole NFP from result using Clipper2
                 // This represents forbidden regions where B would overlap with A's holes
                 std::vector<Polygon> updatedResult;
@@ -331,7 +906,7 @@ std::vector<Polygon> NFPCalculator::getInnerNFP(const Polygon& A, const Polygon&
                 for (auto& innerPoly : result) {
                     // Use PolygonOperations to perform difference
                     // differencePolygons works with point vectors, so we need to convert
-                    auto differencePoints = PolygonOperations::differencePolygons(innerPoly.points, holeNfp.points);
+                    auto differencePoints = PolygonOperations::differencePolygons(innerPoly.points, holeNfp.points, clipperScale_);
 
                     // Convert back to Polygon objects
                     for (const auto& diffPoints : differencePoints) {
@@ -342,24 +917,282 @@ std::vector<Polygon> NFPCalculator::getInnerNFP(const Polygon& A, const Polygon&
                 }
 
                 result = updatedResult;
+                regionBounds.clear();
+                for (const auto& region : result) {
+                    regionBounds.push_back(region.bounds());
+                }
             }
         }
     }
 
+    if (result.empty()) {
+        return nullptr;
+    }
+
     //Cache the result (using source IDs and rotation)
-    if (!result.empty()) {
-       cache_.insert(A.source, B.source, 0.0, B.rotation, result, true);
+    prepareCachedNfps(result, clipperScale_, integerGeometry_);
+    NFPCache::NFPHandle handle = std::make_shared<const std::vector<Polygon>>(std::move(result));
+    cache_.insert(NFPCache::NFPKey(shapeKey(A, A.source), shapeKey(B, B.source), 0.0, B.rotation, true), handle,
+                  nfpRecomputeCost(A, B) * (1 + A.children.size()));
+
+    if (store_) {
+        store_->append(persistKey, *handle);
     }
 
-    return result;
+    return handle;
+}
+
+std::vector<NFPCache::NFPHandle> NFPCalculator::computeBatch(const std::vector<NFPRequest>& requests,
+                                                            const CancellationToken& token) {
+    TRACE_SCOPE("nfp.computeBatch");
+    std::vector<NFPCache::NFPHandle> results(requests.size());
+
+    // Plain outer requests take the bulk path; inner and rotated
+    // equivariant requests keep their per-pair paths
+    std::vector<size_t> direct;
+    std::vector<NFPCache::NFPKey> keys;
+    for (size_t i = 0; i < requests.size(); i++) {
+        const NFPRequest& request = requests[i];
+        if (!request.A || !request.B || request.A->points.empty() || request.B->points.empty()) {
+            continue;
+        }
+        token.throwIfCancelled();
+        try {
+            if (request.inner) {
+                results[i] = getInnerNFPShared(*request.A, *request.B);
+                continue;
+            }
+            if (rotationEquivariant_ && NFPCache::rotationKey(request.A->rotation) != 0) {
+                results[i] = getOuterNFPShared(*request.A, *request.B, false);
+                continue;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "WARNING: Batched NFP failed for A(id=" << request.A->id
+                      << ") and B(id=" << request.B->id << "): " << e.what() << std::endl;
+            continue;
+        }
+        direct.push_back(i);
+        keys.push_back(outerKey(*request.A, *request.B, request.A->rotation, request.B->rotation));
+    }
+
+    std::vector<NFPCache::NFPHandle> cached = cache_.lookupBatch(keys);
+
+    // Claim the misses nobody else is computing, under one lock
+    struct Job {
+        NFPCache::NFPKey key;
+        size_t request;
+        std::promise<NFPCache::NFPHandle> promise;
+        std::exception_ptr error;
+    };
+    std::vector<Job> owned;
+    std::vector<std::pair<size_t, size_t>> duplicates;  // request, owned job
+    std::vector<std::pair<size_t, std::shared_future<NFPCache::NFPHandle>>> waiting;
+    owned.reserve(direct.size());
+
+    std::vector<size_t> misses;
+    for (size_t k = 0; k < direct.size(); k++) {
+        if (NFPCache::isTombstone(cached[k])) {
+            negative_.fetch_add(1, std::memory_order_relaxed);
+        } else if (cached[k]) {
+            results[direct[k]] = std::move(cached[k]);
+        } else if (NFPCache::NFPHandle mirrored = getMirroredOuterNFP(*requests[direct[k]].A, *requests[direct[k]].B)) {
+            results[direct[k]] = std::move(mirrored);
+        } else {
+            misses.push_back(k);
+        }
+    }
+
+    {
+        boost::mutex::scoped_lock lock(inFlightMutex_);
+        std::unordered_map<NFPCache::NFPKey, size_t, NFPCache::NFPKeyHash> ownedIndex;
+        for (size_t k : misses) {
+            auto own = ownedIndex.find(keys[k]);
+            if (own != ownedIndex.end()) {
+                duplicates.emplace_back(direct[k], own->second);
+                continue;
+            }
+            auto it = inFlight_.find(keys[k]);
+            if (it != inFlight_.end()) {
+                waiting.emplace_back(direct[k], it->second);
+                continue;
+            }
+            owned.push_back(Job{keys[k], direct[k], std::promise<NFPCache::NFPHandle>(), nullptr});
+            inFlight_.emplace(keys[k], owned.back().promise.get_future().share());
+            ownedIndex.emplace(keys[k], owned.size() - 1);
+        }
+    }
+
+    // Group the owned pairs by A so A's Clipper path is built once per group
+    std::vector<size_t> order(owned.size());
+    for (size_t j = 0; j < owned.size(); j++) {
+        order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::make_pair(owned[a].key.idA, owned[a].key.rotationA) <
+               std::make_pair(owned[b].key.idA, owned[b].key.rotationA);
+    });
+
+    const double scale = clipperScale_;
+    std::vector<NFPCache::BatchEntry> entries;
+    entries.reserve(owned.size());
+
+    for (size_t begin = 0; begin < order.size();) {
+        Polygon A = *requests[owned[order[begin]].request].A;
+        if (!A.scaledPathAt(scale)) {
+            A.updateScaledPath(scale);
+        }
+
+        size_t end = begin;
+        while (end < order.size() &&
+               owned[order[end]].key.idA == owned[order[begin]].key.idA &&
+               owned[order[end]].key.rotationA == owned[order[begin]].key.rotationA) {
+            end++;
+        }
+
+        // The group's Clipper Minkowski sums, convolved in one device call
+        std::vector<Clipper2Lib::Paths64> convolved;
+        std::vector<size_t> convolvedIndex(end - begin, SIZE_MAX);
+        if (accelerator_ && A.children.empty() && !token.isCancelled()) {
+            std::vector<Clipper2Lib::Path64> negated;
+            std::vector<size_t> members;
+            for (size_t k = begin; k < end; k++) {
+                const Job& job = owned[order[k]];
+                const Polygon& B = *requests[job.request].B;
+                if (cache_.has(job.key) || backendFor(A, B) != NFPBackend::ClipperMinkowski) {
+                    continue;
+                }
+                Clipper2Lib::Path64 negB = B.scaledPathAt(scale)
+                    ? *B.scaledPathAt(scale)
+                    : PolygonOperations::toPath64(B.points, scale);
+                for (auto& pt : negB) {
+                    pt = Clipper2Lib::Point64(-pt.x, -pt.y);
+                }
+                negated.push_back(std::move(negB));
+                members.push_back(k - begin);
+            }
+            if (!members.empty()) {
+                std::vector<NFPAccelerator::Job> jobs;
+                jobs.reserve(members.size());
+                for (size_t m = 0; m < members.size(); m++) {
+                    jobs.push_back(NFPAccelerator::Job{A.scaledPathAt(scale), &negated[m]});
+                }
+                try {
+                    accelerator_->convolve(jobs, convolved);
+                    for (size_t m = 0; m < members.size(); m++) {
+                        convolvedIndex[members[m]] = m;
+                    }
+                    accelerated_.fetch_add(members.size(), std::memory_order_relaxed);
+                } catch (const std::exception& e) {
+                    std::cerr << "WARNING: NFP accelerator " << accelerator_->name()
+                              << " failed, computing on the CPU: " << e.what() << std::endl;
+                }
+            }
+        }
+
+        for (size_t k = begin; k < end; k++) {
+            Job& job = owned[order[k]];
+            const Polygon& B = *requests[job.request].B;
+            if (token.isCancelled()) {
+                job.error = std::make_exception_ptr(OperationCancelled());
+                continue;
+            }
+            try {
+                // As in computeOnce: a previous owner may have just finished
+                NFPCache::NFPHandle result = cache_.has(job.key) ? cache_.lookup(job.key) : nullptr;
+                if (!result) {
+                    computations_.fetch_add(1, std::memory_order_relaxed);
+                    const size_t slot = convolvedIndex[k - begin];
+                    result = computeOuterEntry(A, B, false,
+                                               slot != SIZE_MAX ? &convolved[slot] : nullptr);
+                    if (slot != SIZE_MAX) {
+                        Clipper2Lib::Paths64().swap(convolved[slot]);
+                    }
+                    entries.push_back(NFPCache::BatchEntry{job.key, result ? result : NFPCache::tombstone(),
+                                                           nfpRecomputeCost(A, B)});
+                }
+                if (!NFPCache::isTombstone(result)) {
+                    results[job.request] = std::move(result);
+                }
+            } catch (...) {
+                job.error = std::current_exception();
+            }
+        }
+        begin = end;
+    }
+
+    // Publish to the cache before releasing the keys, so no caller misses in between
+    cache_.insertBatch(entries);
+
+    // Released before the promises are kept, so a waiter retrying a pair
+    // given up on cancellation finds it unclaimed
+    {
+        boost::mutex::scoped_lock lock(inFlightMutex_);
+        for (const Job& job : owned) {
+            inFlight_.erase(job.key);
+        }
+    }
+    for (Job& job : owned) {
+        if (job.error) {
+            job.promise.set_exception(job.error);
+            try {
+                std::rethrow_exception(job.error);
+            } catch (const OperationCancelled&) {
+                // Given up on cancellation; waiters compute it themselves
+            } catch (const std::exception& e) {
+                std::cerr << "WARNING: Batched NFP failed for A(id=" << requests[job.request].A->id
+                          << ") and B(id=" << requests[job.request].B->id << "): " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "WARNING: Batched NFP failed with unknown exception" << std::endl;
+            }
+        } else {
+            job.promise.set_value(results[job.request]);
+        }
+    }
+
+    token.throwIfCancelled();
+
+    for (const auto& duplicate : duplicates) {
+        results[duplicate.first] = results[owned[duplicate.second].request];
+    }
+    for (auto& pending : waiting) {
+        deduplicated_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            try {
+                STAGE_SCOPE(Wait);
+                results[pending.first] = pending.second.get();
+            } catch (const OperationCancelled&) {
+                // The other batch gave the pair up before computing it
+                token.throwIfCancelled();
+                const NFPRequest& request = requests[pending.first];
+                results[pending.first] = getOuterNFPShared(*request.A, *request.B, false);
+            }
+        } catch (const OperationCancelled&) {
+            throw;
+        } catch (const std::exception& e) {
+            std::cerr << "WARNING: Batched NFP failed in another computation: " << e.what() << std::endl;
+        }
+    }
+
+    return results;
 }
 
 void NFPCalculator::clearCache() {
     cache_.clear();
 }
 
-std::tuple<size_t, size_t, size_t> NFPCalculator::getCacheStats() const {
-    return std::make_tuple(cache_.hitCount(), cache_.missCount(), cache_.size());
+NFPCache::Statistics NFPCalculator::getCacheStats() const {
+    return cache_.statistics();
+}
+
+NFPCalculator::ComputeStatistics NFPCalculator::getComputeStats() const {
+    ComputeStatistics stats;
+    stats.computed = computations_.load(std::memory_order_relaxed);
+    stats.deduplicated = deduplicated_.load(std::memory_order_relaxed);
+    stats.mirrored = mirrored_.load(std::memory_order_relaxed);
+    stats.holesSkipped = holesSkipped_.load(std::memory_order_relaxed);
+    stats.accelerated = accelerated_.load(std::memory_order_relaxed);
+    stats.negative = negative_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 } // namespace deepnest
@@ -0,0 +1,408 @@
+#include "../../include/deepnest/nfp/PersistentNFPStore.h"
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace deepnest {
+
+namespace {
+
+namespace bip = boost::interprocess;
+
+const char FILE_MAGIC[8] = {'D', 'N', 'N', 'F', 'P', 'S', '0', '1'};
+const uint32_t FILE_VERSION = 2;
+const uint32_t RECORD_MAGIC = 0x5246504E;  // "NFPR"
+
+// Guard against corrupt counts when decoding
+const uint32_t MAX_POLYGON_DEPTH = 16;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t payloadBytes;
+    uint64_t geometryA;
+    uint64_t geometryB;
+    int32_t rotationA;
+    int32_t rotationB;
+    double spacing;
+    double curveTolerance;
+    uint32_t inside;
+    uint32_t checksum;
+};
+
+uint32_t checksum32(const char* data, size_t length) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+inline void hashMix(uint64_t& hash, uint64_t value) {
+    // FNV-1a over the 8 bytes of value
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 1099511628211ull;
+    }
+}
+
+void writeU32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeDouble(std::string& out, double value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void encodePolygon(std::string& out, const Polygon& polygon) {
+    writeU32(out, static_cast<uint32_t>(polygon.points.size()));
+    for (const auto& p : polygon.points) {
+        writeDouble(out, p.x);
+        writeDouble(out, p.y);
+    }
+    writeU32(out, static_cast<uint32_t>(polygon.children.size()));
+    for (const auto& child : polygon.children) {
+        encodePolygon(out, child);
+    }
+}
+
+/**
+ * @brief Bounds-checked reader over a payload buffer
+ */
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t length)
+        : cur_(data), end_(data + length) {}
+
+    bool readU32(uint32_t& value) { return read(&value, sizeof(value)); }
+    bool readDouble(double& value) { return read(&value, sizeof(value)); }
+
+    size_t remaining() const { return static_cast<size_t>(end_ - cur_); }
+
+private:
+    const char* cur_;
+    const char* end_;
+
+    bool read(void* dst, size_t n) {
+        if (remaining() < n) {
+            return false;
+        }
+        std::memcpy(dst, cur_, n);
+        cur_ += n;
+        return true;
+    }
+};
+
+bool decodePolygon(PayloadReader& reader, Polygon& polygon, uint32_t depth) {
+    if (depth > MAX_POLYGON_DEPTH) {
+        return false;
+    }
+
+    uint32_t pointCount = 0;
+    if (!reader.readU32(pointCount) || pointCount > reader.remaining() / (2 * sizeof(double))) {
+        return false;
+    }
+    polygon.points.resize(pointCount);
+    for (auto& p : polygon.points) {
+        double x = 0.0;
+        double y = 0.0;
+        if (!reader.readDouble(x) || !reader.readDouble(y)) {
+            return false;
+        }
+        p.x = x;
+        p.y = y;
+    }
+
+    uint32_t childCount = 0;
+    if (!reader.readU32(childCount) || childCount > reader.remaining() / sizeof(uint32_t)) {
+        return false;
+    }
+    polygon.children.resize(childCount);
+    for (auto& child : polygon.children) {
+        if (!decodePolygon(reader, child, depth + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool decodePayload(const char* data, size_t length, std::vector<Polygon>& result) {
+    PayloadReader reader(data, length);
+    uint32_t count = 0;
+    if (!reader.readU32(count) || count > reader.remaining() / sizeof(uint32_t)) {
+        return false;
+    }
+
+    std::vector<Polygon> polygons(count);
+    for (auto& polygon : polygons) {
+        if (!decodePolygon(reader, polygon, 0)) {
+            return false;
+        }
+    }
+    result = std::move(polygons);
+    return true;
+}
+
+size_t fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return 0;
+    }
+    return static_cast<size_t>(in.tellg());
+}
+
+} // anonymous namespace
+
+std::size_t PersistentNFPStore::KeyHash::operator()(const Key& key) const {
+    uint64_t hash = 1469598103934665603ull;
+    hashMix(hash, key.geometryA);
+    hashMix(hash, key.geometryB);
+    hashMix(hash, static_cast<uint32_t>(key.rotationA));
+    hashMix(hash, static_cast<uint32_t>(key.rotationB));
+    hashMix(hash, key.inside ? 1 : 0);
+    return static_cast<std::size_t>(hash);
+}
+
+PersistentNFPStore::PersistentNFPStore(double spacing, double curveTolerance)
+    : spacing_(spacing)
+    , curveTolerance_(curveTolerance)
+    , indexedEnd_(0)
+{}
+
+PersistentNFPStore::~PersistentNFPStore() = default;
+
+uint64_t PersistentNFPStore::geometryHash(const Polygon& polygon) {
+    // Recomputed from the points: callers pass rotated copies
+    return polygon.computeFingerprint();
+}
+
+bool PersistentNFPStore::open(const std::string& path) {
+    boost::mutex::scoped_lock lock(mutex_);
+
+    try {
+        // Make sure the file exists so it can be locked and mapped
+        {
+            std::ofstream touch(path, std::ios::binary | std::ios::app);
+            if (!touch) {
+                std::cerr << "WARNING: Cannot open NFP store " << path << std::endl;
+                return false;
+            }
+        }
+
+        fileLock_.reset(new bip::file_lock(path.c_str()));
+        bip::scoped_lock<bip::file_lock> fileGuard(*fileLock_);
+
+        size_t size = fileSize(path);
+        if (size == 0) {
+            FileHeader header;
+            std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+            header.version = FILE_VERSION;
+            header.reserved = 0;
+
+            std::ofstream out(path, std::ios::binary | std::ios::app);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.flush();
+            size = sizeof(header);
+        }
+
+        if (size < sizeof(FileHeader)) {
+            std::cerr << "WARNING: NFP store " << path << " is truncated, ignoring it" << std::endl;
+            return false;
+        }
+
+        mapping_.reset(new bip::file_mapping(path.c_str(), bip::read_only));
+        region_.reset(new bip::mapped_region(*mapping_, bip::read_only, 0, size));
+
+        FileHeader header;
+        std::memcpy(&header, region_->get_address(), sizeof(header));
+        if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+            header.version != FILE_VERSION) {
+            std::cerr << "WARNING: " << path << " is not a compatible NFP store, ignoring it" << std::endl;
+            region_.reset();
+            mapping_.reset();
+            return false;
+        }
+
+        path_ = path;
+        const char* base = static_cast<const char*>(region_->get_address());
+        std::size_t validEnd = indexRecords(base + sizeof(FileHeader), sizeof(FileHeader), size);
+        indexedEnd_ = validEnd;
+
+        // Drop a torn record left by a crashed writer so later appends stay reachable.
+        // Safe because every writer holds the file lock for the whole record.
+        if (validEnd < size) {
+            std::cerr << "WARNING: Truncating " << (size - validEnd)
+                      << " bytes of incomplete data from NFP store " << path << std::endl;
+            region_.reset(new bip::mapped_region(*mapping_, bip::read_only, 0, validEnd));
+            std::error_code ec;
+            std::filesystem::resize_file(path, validEnd, ec);
+            if (ec) {
+                std::cerr << "WARNING: Failed to truncate NFP store " << path << ": " << ec.message() << std::endl;
+            }
+        }
+    } catch (const bip::interprocess_exception& e) {
+        std::cerr << "WARNING: Failed to open NFP store " << path << ": " << e.what() << std::endl;
+        region_.reset();
+        mapping_.reset();
+        fileLock_.reset();
+        path_.clear();
+        index_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t PersistentNFPStore::indexRecords(const char* data, std::size_t begin, std::size_t end) const {
+    const char* base = data - begin;
+    std::size_t offset = begin;
+
+    while (offset + sizeof(RecordHeader) <= end) {
+        RecordHeader header;
+        std::memcpy(&header, base + offset, sizeof(header));
+
+        std::size_t payloadOffset = offset + sizeof(RecordHeader);
+        if (header.magic != RECORD_MAGIC ||
+            header.payloadBytes > end - payloadOffset ||
+            checksum32(base + payloadOffset, header.payloadBytes) != header.checksum) {
+            break;
+        }
+
+        // Only NFPs computed with the same offset/curve settings are reusable
+        if (header.spacing == spacing_ && header.curveTolerance == curveTolerance_) {
+            Key key;
+            key.geometryA = header.geometryA;
+            key.geometryB = header.geometryB;
+            key.rotationA = header.rotationA;
+            key.rotationB = header.rotationB;
+            key.inside = header.inside != 0;
+            index_[key] = Location{payloadOffset, header.payloadBytes};
+        }
+
+        offset = payloadOffset + header.payloadBytes;
+    }
+
+    return offset;
+}
+
+void PersistentNFPStore::indexAppendedRecords() const {
+    std::error_code ec;
+    const std::size_t size = static_cast<std::size_t>(std::filesystem::file_size(path_, ec));
+    if (ec || size <= indexedEnd_ + sizeof(RecordHeader)) {
+        return;
+    }
+
+    std::ifstream in(path_, std::ios::binary);
+    std::string tail(size - indexedEnd_, '\0');
+    in.seekg(static_cast<std::streamoff>(indexedEnd_));
+    if (!in.read(&tail[0], static_cast<std::streamsize>(tail.size()))) {
+        return;
+    }
+    indexedEnd_ = indexRecords(tail.data(), indexedEnd_, size);
+}
+
+bool PersistentNFPStore::find(const Key& key, std::vector<Polygon>& result) const {
+    if (!isOpen()) {
+        return false;
+    }
+
+    // Only the index lookup is under the lock; records never change once
+    // written, so the payload is decoded without it
+    Location location;
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            indexAppendedRecords();
+            it = index_.find(key);
+            if (it == index_.end()) {
+                return false;
+            }
+        }
+        location = it->second;
+    }
+
+    // Records present at open() are decoded straight from the mapping
+    if (region_ && location.offset + location.bytes <= region_->get_size()) {
+        const char* base = static_cast<const char*>(region_->get_address());
+        return decodePayload(base + location.offset, location.bytes, result);
+    }
+
+    // Records appended since open() are read back from the file
+    std::ifstream in(path_, std::ios::binary);
+    std::string payload(location.bytes, '\0');
+    in.seekg(static_cast<std::streamoff>(location.offset));
+    if (!in.read(&payload[0], location.bytes)) {
+        return false;
+    }
+    return decodePayload(payload.data(), payload.size(), result);
+}
+
+void PersistentNFPStore::append(const Key& key, const std::vector<Polygon>& nfp) {
+    if (!isOpen() || nfp.empty()) {
+        return;
+    }
+
+    // Serialize outside the locks
+    std::string payload;
+    writeU32(payload, static_cast<uint32_t>(nfp.size()));
+    for (const auto& polygon : nfp) {
+        encodePolygon(payload, polygon);
+    }
+
+    RecordHeader header;
+    header.magic = RECORD_MAGIC;
+    header.payloadBytes = static_cast<uint32_t>(payload.size());
+    header.geometryA = key.geometryA;
+    header.geometryB = key.geometryB;
+    header.rotationA = key.rotationA;
+    header.rotationB = key.rotationB;
+    header.spacing = spacing_;
+    header.curveTolerance = curveTolerance_;
+    header.inside = key.inside ? 1 : 0;
+    header.checksum = checksum32(payload.data(), payload.size());
+
+    boost::mutex::scoped_lock lock(mutex_);
+    if (index_.count(key)) {
+        return;
+    }
+
+    try {
+        bip::scoped_lock<bip::file_lock> fileGuard(*fileLock_);
+
+        std::fstream out(path_, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(0, std::ios::end);
+        std::size_t offset = static_cast<std::size_t>(out.tellp());
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        out.flush();
+
+        if (!out) {
+            std::cerr << "WARNING: Failed to append to NFP store " << path_ << std::endl;
+            return;
+        }
+
+        index_[key] = Location{offset + sizeof(RecordHeader), header.payloadBytes};
+    } catch (const bip::interprocess_exception& e) {
+        std::cerr << "WARNING: Failed to lock NFP store " << path_ << ": " << e.what() << std::endl;
+    }
+}
+
+size_t PersistentNFPStore::size() const {
+    boost::mutex::scoped_lock lock(mutex_);
+    return index_.size();
+}
+
+} // namespace deepnest
@@ -116,10 +116,10 @@ namespace newmnk  {
             Amaxx = Aminx = A.points[0].x;
             Amaxy = Aminy = A.points[0].y;
             for (const auto& p : A.points) {
-                Amaxx = std::max(Amaxx, p.x);
-                Aminx = std::min(Aminx, p.x);
-                Amaxy = std::max(Amaxy, p.y);
-                Aminy = std::min(Aminy, p.y);
+                Amaxx = std::max<double>(Amaxx, p.x);
+                Aminx = std::min<double>(Aminx, p.x);
+                Amaxy = std::max<double>(Amaxy, p.y);
+                Aminy = std::min<double>(Aminy, p.y);
             }
         }
 
@@ -128,10 +128,10 @@ namespace newmnk  {
             Bmaxx = Bminx = B.points[0].x;
             Bmaxy = Bminy = B.points[0].y;
             for (const auto& p : B.points) {
-                Bmaxx = std::max(Bmaxx, p.x);
-                Bminx = std::min(Bminx, p.x);
-                Bmaxy = std::max(Bmaxy, p.y);
-                Bminy = std::min(Bminy, p.y);
+                Bmaxx = std::max<double>(Bmaxx, p.x);
+                Bminx = std::min<double>(Bminx, p.x);
+                Bmaxy = std::max<double>(Bmaxy, p.y);
+                Bminy = std::min<double>(Bminy, p.y);
             }
         }
 
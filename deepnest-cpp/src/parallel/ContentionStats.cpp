@@ -0,0 +1,132 @@
+#include "../../include/deepnest/parallel/ContentionStats.h"
+
+namespace deepnest {
+
+namespace {
+
+void raise(std::atomic<uint64_t>& maximum, uint64_t value) {
+    uint64_t seen = maximum.load(std::memory_order_relaxed);
+    while (value > seen && !maximum.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // anonymous namespace
+
+std::atomic<bool> LockStats::enabled_{false};
+
+size_t LatencyHistogram::bucketOf(uint64_t ns) {
+    size_t bucket = 0;
+    while (ns > 1 && bucket + 1 < BUCKETS) {
+        ns >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentileNs(double p) const {
+    if (count == 0) {
+        return 0;
+    }
+    const double target = p * static_cast<double>(count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (static_cast<double>(seen) >= target) {
+            return i + 1 < BUCKETS ? (uint64_t(1) << (i + 1)) : maxNs;
+        }
+    }
+    return maxNs;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0), totalNs_(0), maxNs_(0) {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    count_.fetch_add(1, std::memory_order_relaxed);
+    totalNs_.fetch_add(ns, std::memory_order_relaxed);
+    raise(maxNs_, ns);
+    buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.totalNs = totalNs_.load(std::memory_order_relaxed);
+    snapshot.maxNs = maxNs_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void LatencyHistogram::reset() {
+    count_.store(0, std::memory_order_relaxed);
+    totalNs_.store(0, std::memory_order_relaxed);
+    maxNs_.store(0, std::memory_order_relaxed);
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LockStats::recordAcquire(uint64_t waitNs, bool contended) {
+    acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+        contended_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wait_.record(waitNs);
+}
+
+LockStats::Snapshot LockStats::snapshot() const {
+    Snapshot snapshot;
+    snapshot.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+    snapshot.contended = contended_.load(std::memory_order_relaxed);
+    snapshot.wait = wait_.snapshot();
+    snapshot.hold = hold_.snapshot();
+    return snapshot;
+}
+
+void LockStats::reset() {
+    acquisitions_.store(0, std::memory_order_relaxed);
+    contended_.store(0, std::memory_order_relaxed);
+    wait_.reset();
+    hold_.reset();
+}
+
+void QueueStats::pushed() {
+    const int64_t depth = depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const uint64_t seen = depth > 0 ? static_cast<uint64_t>(depth) : 0;
+    raise(maxDepth_, seen);
+    depthSum_.fetch_add(seen, std::memory_order_relaxed);
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void QueueStats::started(uint64_t waitNs) {
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+    wait_.record(waitNs);
+}
+
+QueueStats::Snapshot QueueStats::snapshot() const {
+    Snapshot snapshot;
+    const int64_t depth = depth_.load(std::memory_order_relaxed);
+    snapshot.depth = depth > 0 ? static_cast<uint64_t>(depth) : 0;
+    snapshot.maxDepth = maxDepth_.load(std::memory_order_relaxed);
+    const uint64_t submitted = submitted_.load(std::memory_order_relaxed);
+    snapshot.meanDepth = submitted > 0
+        ? static_cast<double>(depthSum_.load(std::memory_order_relaxed)) / submitted : 0.0;
+    snapshot.wait = wait_.snapshot();
+    return snapshot;
+}
+
+void QueueStats::reset() {
+    // depth_ tracks tasks still queued and is kept
+    maxDepth_.store(0, std::memory_order_relaxed);
+    depthSum_.store(0, std::memory_order_relaxed);
+    submitted_.store(0, std::memory_order_relaxed);
+    wait_.reset();
+}
+
+} // namespace deepnest
@@ -0,0 +1,164 @@
+#include "../../include/deepnest/parallel/CpuTopology.h"
+#include <boost/thread.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace deepnest {
+
+namespace {
+
+// Highest node number probed under /sys/devices/system/node
+constexpr int MAX_NODES = 256;
+
+/**
+ * @brief CPUs the process may run on
+ */
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        const int count = std::max(1, static_cast<int>(boost::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief Parse a kernel CPU list such as "0-3,8-11"
+ */
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ranges(text);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        const size_t dash = range.find('-');
+        try {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Blank or malformed entry
+        }
+    }
+    return cpus;
+}
+
+} // anonymous namespace
+
+std::vector<std::vector<int>> CpuTopology::nodes() {
+    const std::vector<int> allowed = allowedCpus();
+    std::vector<std::vector<int>> result;
+
+#if defined(__linux__)
+    for (int node = 0; node < MAX_NODES; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in) {
+            continue;
+        }
+        std::string line;
+        std::getline(in, line);
+
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(line)) {
+            if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            result.push_back(std::move(cpus));
+        }
+    }
+#endif
+
+    if (result.empty()) {
+        result.push_back(allowed);
+    }
+    return result;
+}
+
+std::vector<CpuTopology::Slot> CpuTopology::assign(size_t workers, const WorkerAffinity& affinity,
+                                                   size_t& nodeCount) {
+    std::vector<Slot> slots(workers, Slot{0, {}});
+    nodeCount = 1;
+    if (!affinity.pinThreads && !affinity.numaNodes) {
+        return slots;
+    }
+
+    std::vector<std::vector<int>> groups = nodes();
+    if (!affinity.numaNodes) {
+        // One group of all CPUs, node by node
+        std::vector<int> all;
+        for (const auto& group : groups) {
+            all.insert(all.end(), group.begin(), group.end());
+        }
+        groups.assign(1, all);
+    }
+    nodeCount = groups.size();
+
+    for (size_t i = 0; i < workers; ++i) {
+        const size_t node = i % groups.size();
+        const std::vector<int>& cpus = groups[node];
+        slots[i].node = node;
+        if (affinity.pinThreads) {
+            slots[i].cpus.push_back(cpus[(i / groups.size()) % cpus.size()]);
+        } else {
+            slots[i].cpus = cpus;
+        }
+    }
+    return slots;
+}
+
+bool CpuTopology::pinCurrentThread(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << cpu;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace deepnest
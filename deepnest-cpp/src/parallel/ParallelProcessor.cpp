@@ -1,17 +1,81 @@
 #include "../../include/deepnest/parallel/ParallelProcessor.h"
+#include "../../include/deepnest/parallel/RemoteWorker.h"
 #include "../../include/deepnest/DebugConfig.h"
-#include "../../include/deepnest/nfp/NFPCache.h"
-#include "../../include/deepnest/geometry/GeometryUtil.h"
+#include "../../include/deepnest/StageTimes.h"
+#include "../../include/deepnest/nfp/NFPCalculator.h"
 #include <algorithm>
+#include <iostream>
+#include <limits>
+#include <map>
 #include <thread>
 #include <chrono>
+#include <exception>
+#include <stdexcept>
 
 namespace deepnest {
 
-ParallelProcessor::ParallelProcessor(int numThreads)
-    : workGuard_(nullptr)
+namespace {
+
+/**
+ * @brief Chunks of one parallelFor() call, claimed by the caller and helpers
+ *
+ * Shared with the helper tasks, which may only get to run after the call
+ * has returned; they then find every chunk claimed and do nothing.
+ */
+struct ChunkedRange {
+    const std::function<void(size_t, size_t)>* body;
+    size_t count;
+    size_t chunks;
+    std::atomic<size_t> next;
+    size_t finished;
+    std::exception_ptr error;
+    boost::mutex mutex;
+    boost::condition_variable done;
+
+    ChunkedRange(const std::function<void(size_t, size_t)>& f, size_t n, size_t c)
+        : body(&f), count(n), chunks(c), next(0), finished(0) {}
+
+    void run() {
+        for (size_t chunk = next++; chunk < chunks; chunk = next++) {
+            try {
+                (*body)(count * chunk / chunks, count * (chunk + 1) / chunks);
+            } catch (...) {
+                boost::lock_guard<boost::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            boost::lock_guard<boost::mutex> lock(mutex);
+            if (++finished == chunks) {
+                done.notify_all();
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+ParallelProcessor::ParallelProcessor(int numThreads, Backend backend, const WorkerAffinity& affinity)
+    : sharers_(0)
+    , dispatched_(0)
+    , activeThreads_(0)
+    , workGuard_(nullptr)
     , threadCount_(numThreads)
+    , backend_(backend)
+    , affinity_(affinity)
+    , token_(CancellationToken::create())
     , stopped_(false)
+    , busy_(0)
+    , pending_(0)
+    , completed_(0)
+    , halted_(false)
+    , nextWorkerSlot_(0)
+    , statsSince_(LockStats::now())
+    , taskTiming_(false)
+    , timedTasks_(0)
+    , taskWallNs_(0)
+    , taskCpuNs_(0)
 {
     // If numThreads is 0 or negative, use hardware concurrency
     if (threadCount_ <= 0) {
@@ -20,29 +84,76 @@ ParallelProcessor::ParallelProcessor(int numThreads)
             threadCount_ = 4; // Fallback to 4 threads
         }
     }
+    workerCounters_.reset(new WorkerCounters[threadCount_]);
+
+    if (backend == Backend::WORK_STEALING) {
+        scheduler_ = std::make_unique<WorkStealingScheduler>(threadCount_, affinity_);
+        return;
+    }
 
     // Create work guard to keep io_context running
     workGuard_ = std::make_unique<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>(
         boost::asio::make_work_guard(ioContext_)
     );
 
-    // Create worker threads
+    // Create worker threads, pinned as requested; they share one queue,
+    // so NUMA grouping only restricts where they run
+    size_t nodes = 1;
+    const auto slots = CpuTopology::assign(static_cast<size_t>(threadCount_), affinity_, nodes);
     for (int i = 0; i < threadCount_; ++i) {
-        threads_.create_thread([this]() {
+        threads_.create_thread([this, cpus = slots[i].cpus]() {
+            CpuTopology::pinCurrentThread(cpus);
             ioContext_.run();
         });
     }
 }
 
+ParallelProcessor::ParallelProcessor(std::shared_ptr<ParallelProcessor> pool)
+    : pool_(pool && pool->pool_ ? pool->pool_ : std::move(pool))
+    , sharers_(0)
+    , dispatched_(0)
+    , activeThreads_(0)
+    , workGuard_(nullptr)
+    , threadCount_(0)
+    , backend_(Backend::WORK_STEALING)
+    , token_(CancellationToken::create())
+    , stopped_(false)
+    , busy_(0)
+    , pending_(0)
+    , completed_(0)
+    , halted_(false)
+    , nextWorkerSlot_(0)
+    , statsSince_(LockStats::now())
+    , taskTiming_(false)
+    , timedTasks_(0)
+    , taskWallNs_(0)
+    , taskCpuNs_(0)
+{
+    if (!pool_) {
+        throw std::invalid_argument("ParallelProcessor pool cannot be null");
+    }
+    threadCount_ = pool_->threadCount_;
+    backend_ = pool_->backend_;
+    affinity_ = pool_->affinity_;
+    ++pool_->sharers_;
+}
+
 ParallelProcessor::~ParallelProcessor() {
     stop();
 }
 
+ParallelProcessor::Backend ParallelProcessor::backendFromName(const std::string& name) {
+    return name == "asio" ? Backend::ASIO : Backend::WORK_STEALING;
+}
+
 void ParallelProcessor::stop() {
     LOG_THREAD("ParallelProcessor::stop() called");
 
+    // Reader threads of the nodes call back into this processor
+    disconnectRemoteWorkers();
+
     {
-        boost::lock_guard<boost::mutex> lock(mutex_);
+        ProfiledLock<boost::mutex> lock(mutex_, stateLockStats_);
         if (stopped_) {
             LOG_THREAD("Already stopped, returning");
             return;
@@ -50,6 +161,34 @@ void ParallelProcessor::stop() {
         stopped_ = true;
     }
 
+    // The threads belong to the pool; only this processor's tasks end here
+    if (pool_) {
+        cancel();
+        waitAll();
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        halted_ = true;
+        idle_.notify_all();
+        --pool_->sharers_;
+        return;
+    }
+
+    // Queued tasks are dropped and never run, held-back ones too, so no
+    // completing task hands them to the stopping threads; release waitAll()
+    std::deque<std::pair<std::function<void()>, int>> dropped;
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        halted_ = true;
+        dropped.swap(backlog_);
+        idle_.notify_all();
+    }
+
+    if (scheduler_) {
+        // Returns once running tasks have finished
+        LOG_THREAD("Stopping work-stealing scheduler");
+        scheduler_->stop();
+        return;
+    }
+
     // DRASTIC FIX: If join_all() deadlocks, we can't recover
     // Best option: detach threads and recreate thread pool on next start
 
@@ -66,240 +205,677 @@ void ParallelProcessor::stop() {
     LOG_THREAD("ParallelProcessor::stop() completed (threads NOT joined to avoid crash)");
 }
 
-void ParallelProcessor::waitAll() {
-    // Poll until io_context has no pending work
-    while (!ioContext_.stopped()) {
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
-
-        // Check if there are any pending handlers
-        if (ioContext_.poll() == 0) {
-            // No more work to do
-            break;
+void ParallelProcessor::cancel() {
+    LOG_THREAD("ParallelProcessor::cancel() called");
+    std::deque<std::pair<std::function<void()>, int>> dropped;
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        token_.cancel();
+        token_ = CancellationToken::create();
+
+        // Held-back tasks were posted under the cancelled token; they are
+        // completed here without running their work
+        dropped.swap(backlog_);
+        dispatched_ += dropped.size();
+    }
+    for (auto& task : dropped) {
+        task.first();
+    }
+
+    for (auto& node : remotes_) {
+        releaseRemote(node->abandon());
+    }
+}
+
+void ParallelProcessor::dispatch(std::function<void()> task, int node) {
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        if (dispatched_ >= share()) {
+            backlog_.emplace_back(std::move(task), node);
+            return;
         }
+        ++dispatched_;
     }
+    submitToThreads(std::move(task), node);
 }
 
-void ParallelProcessor::executeLocked(std::function<void()> func) {
-    boost::lock_guard<boost::mutex> lock(mutex_);
-    func();
+size_t ParallelProcessor::share() const {
+    size_t share = std::numeric_limits<size_t>::max();
+    if (pool_) {
+        const size_t sharers = static_cast<size_t>(std::max(1, pool_->sharers_.load()));
+        share = (static_cast<size_t>(threadCount_) + sharers - 1) / sharers;
+    }
+    if (activeThreads_ > 0) {
+        share = std::min(share, static_cast<size_t>(activeThreads_));
+    }
+    return share;
+}
+
+void ParallelProcessor::setActiveThreads(int count) {
+    std::deque<std::pair<std::function<void()>, int>> released;
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        activeThreads_ = count >= threadCount_ ? 0 : std::max(0, count);
+        while (!backlog_.empty() && dispatched_ < share() && !halted_) {
+            released.push_back(std::move(backlog_.front()));
+            backlog_.pop_front();
+            ++dispatched_;
+        }
+    }
+    for (auto& task : released) {
+        submitToThreads(std::move(task.first), task.second);
+    }
+}
+
+int ParallelProcessor::getActiveThreads() const {
+    ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+    return static_cast<int>(std::min(share(), static_cast<size_t>(threadCount_)));
+}
+
+ParallelProcessor::TaskTimes ParallelProcessor::taskTimes() const {
+    TaskTimes times;
+    times.tasks = timedTasks_.load(std::memory_order_relaxed);
+    times.wallSeconds = taskWallNs_.load(std::memory_order_relaxed) / 1e9;
+    times.cpuSeconds = taskCpuNs_.load(std::memory_order_relaxed) / 1e9;
+    return times;
+}
+
+void ParallelProcessor::runTimed(const std::function<void()>& task) {
+    const uint64_t wall = StageTimer::wallNow();
+    const uint64_t cpu = StageTimer::cpuNow();
+    task();
+    taskCpuNs_.fetch_add(StageTimer::cpuNow() - cpu, std::memory_order_relaxed);
+    taskWallNs_.fetch_add(StageTimer::wallNow() - wall, std::memory_order_relaxed);
+    timedTasks_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ParallelProcessor::submitToThreads(std::function<void()> task, int node) {
+    ParallelProcessor& threads = pool_ ? *pool_ : *this;
+    if (LockStats::enabled()) {
+        task = threads.profiled(std::move(task));
+    }
+    if (threads.scheduler_) {
+        threads.scheduler_->submit(std::move(task), node);
+    } else {
+        boost::asio::post(threads.ioContext_, std::move(task));
+    }
+}
+
+std::function<void()> ParallelProcessor::profiled(std::function<void()> task) {
+    queueStats_.pushed();
+    const uint64_t submitted = LockStats::now();
+    return [this, submitted, task = std::move(task)]() {
+        // Each pool thread serves only this pool, so its slot is kept
+        thread_local const ParallelProcessor* owner = nullptr;
+        thread_local size_t slot = 0;
+        if (owner != this) {
+            owner = this;
+            slot = nextWorkerSlot_++;
+        }
+
+        const uint64_t begin = LockStats::now();
+        queueStats_.started(begin - submitted);
+        task();
+        if (slot < static_cast<size_t>(threadCount_)) {
+            workerCounters_[slot].tasks.fetch_add(1, std::memory_order_relaxed);
+            workerCounters_[slot].busyNs.fetch_add(LockStats::now() - begin, std::memory_order_relaxed);
+        }
+    };
+}
+
+void ParallelProcessor::finishTask() {
+    std::pair<std::function<void()>, int> next;
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        --pending_;
+        ++completed_;
+        --dispatched_;
+        if (!backlog_.empty() && dispatched_ < share()) {
+            next = std::move(backlog_.front());
+            backlog_.pop_front();
+            ++dispatched_;
+        }
+        idle_.notify_all();
+    }
+
+    // Still pending, so this processor outlives the hand-over
+    if (next.first) {
+        submitToThreads(std::move(next.first), next.second);
+    }
+}
+
+ProcessorContention ParallelProcessor::contentionStats() const {
+    const ParallelProcessor& threads = pool_ ? *pool_ : *this;
+    const uint64_t now = LockStats::now();
+
+    ProcessorContention stats;
+    stats.seconds = (now - statsSince_.load(std::memory_order_relaxed)) / 1e9;
+    stats.stateMutex = stateLockStats_.snapshot();
+    stats.pendingMutex = pendingLockStats_.snapshot();
+    stats.taskQueue = threads.queueStats_.snapshot();
+
+    const uint64_t elapsed = now - threads.statsSince_.load(std::memory_order_relaxed);
+    for (int i = 0; i < threads.threadCount_; ++i) {
+        WorkerStats worker;
+        worker.tasks = threads.workerCounters_[i].tasks.load(std::memory_order_relaxed);
+        worker.busyNs = threads.workerCounters_[i].busyNs.load(std::memory_order_relaxed);
+        worker.idleNs = elapsed > worker.busyNs ? elapsed - worker.busyNs : 0;
+        stats.workers.push_back(worker);
+    }
+    return stats;
+}
+
+void ParallelProcessor::resetContentionStats() {
+    stateLockStats_.reset();
+    pendingLockStats_.reset();
+    statsSince_.store(LockStats::now(), std::memory_order_relaxed);
+    if (!pool_) {
+        queueStats_.reset();
+        for (int i = 0; i < threadCount_; ++i) {
+            workerCounters_[i].tasks.store(0, std::memory_order_relaxed);
+            workerCounters_[i].busyNs.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+CancellationToken ParallelProcessor::cancellationToken() const {
+    ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+    return token_;
+}
+
+void ParallelProcessor::waitAll() {
+    boost::unique_lock<boost::mutex> lock(pendingMutex_);
+    while (pending_ > 0 && !halted_) {
+        idle_.wait(lock);
+    }
+}
+
+uint64_t ParallelProcessor::getCompletedCount() const {
+    ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+    return completed_;
+}
+
+size_t ParallelProcessor::getPendingCount() const {
+    ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+    return pending_;
+}
+
+bool ParallelProcessor::waitForCompletion(uint64_t seen, int timeoutMs) {
+    boost::unique_lock<boost::mutex> lock(pendingMutex_);
+    return idle_.wait_for(lock, boost::chrono::milliseconds(timeoutMs), [this, seen]() {
+        return completed_ > seen || halted_;
+    }) && !halted_;
+}
+
+void ParallelProcessor::parallelFor(
+    size_t count,
+    size_t minChunk,
+    const std::function<void(size_t, size_t)>& body
+) {
+    if (count == 0) {
+        return;
+    }
+
+    bool stopped;
+    {
+        ProfiledLock<boost::mutex> lock(mutex_, stateLockStats_);
+        stopped = stopped_;
+    }
+
+    const size_t chunks = std::min(count / std::max<size_t>(minChunk, 1),
+                                   static_cast<size_t>(getIdleThreadCount()) + 1);
+    if (stopped || chunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    auto range = std::make_shared<ChunkedRange>(body, count, chunks);
+    for (size_t helper = 1; helper < chunks; ++helper) {
+        post([range]() {
+            range->run();
+        });
+    }
+
+    // Chunks no worker has picked up yet are done here
+    range->run();
+
+    boost::unique_lock<boost::mutex> lock(range->mutex);
+    while (range->finished < range->chunks) {
+        range->done.wait(lock);
+    }
+    if (range->error) {
+        std::rethrow_exception(range->error);
+    }
 }
 
 void ParallelProcessor::processPopulation(
     Population& population,
-    const std::vector<Polygon>& sheets,
+    const std::shared_ptr<const PlacementJob>& job,
     PlacementWorker& worker,
-    int maxConcurrent
+    int maxConcurrent,
+    const std::function<bool(size_t)>& select,
+    bool bounded,
+    const std::shared_ptr<FitnessMemo>& memo,
+    const std::function<size_t(size_t)>& coldNFPs
 ) {
-    // Protect the entire task selection and submission process
-    // This prevents race conditions where:
-    // 1. Multiple threads try to process the same individual
-    // 2. The 'processing' flag is read/written concurrently without protection
-    
-    // We need to identify tasks to run while holding the lock, but we can't
-    // hold the lock while enqueuing if enqueuing might block or re-acquire (though here it shouldn't).
-    // However, to be safe and atomic, we'll identify AND mark as processing under the lock.
-    
-    std::vector<size_t> indicesToProcess;
-    
     {
-        boost::lock_guard<boost::mutex> lock(mutex_);
-        
+        ProfiledLock<boost::mutex> lock(mutex_, stateLockStats_);
         if (stopped_) return;
+    }
 
-        auto& individuals = population.getIndividuals();
-        for(size_t i = 0; i < individuals.size(); ++i) {
-            auto& individual = individuals[i];
-            
-            // Check if needs processing: fitness not valid and not currently processing
-            if(!individual.hasValidFitness() && !individual.processing) {
-                individual.processing = true; // Mark as processing IMMEDIATELY under lock
-                indicesToProcess.push_back(i);
-            }
+    // Workers touch neither the population nor a shared lock: each task gets
+    // its inputs by value and publishes into the individual's own slot,
+    // which the engine thread collects (Individual::collect)
+    const double cutoff = bounded ? population.survivalThreshold()
+                                  : std::numeric_limits<double>::infinity();
+
+    // With NUMA scheduling, individuals starting with the same gene go to the
+    // same node: they reuse the same first-sheet NFPs and placement prefixes,
+    // which then stay in that node's memory and caches
+    const size_t nodes = getNodeCount();
+
+    const CancellationToken token = cancellationToken();
+
+    auto& individuals = population.getIndividuals();
+    std::vector<size_t> launch;
+    for (size_t i = 0; i < individuals.size(); ++i) {
+        const Individual& individual = individuals[i];
+        if (!individual.hasValidFitness() && !individual.isProcessing() && (!select || select(i))) {
+            launch.push_back(i);
         }
     }
 
-    // Now enqueue the tasks. The 'processing' flag is already set, so other calls
-    // to processPopulation won't pick these up.
-    for(size_t i : indicesToProcess) {
-
-        enqueue([&population, sheets, &worker, i, this]() {
-            // Create a thread-local copy of the individual to work on
-            // We need to read the input data safely. 
-            // The individual at 'index' is stable in the vector (vector doesn't resize here).
-            // But we should copy it to avoid reading it while main thread might be reading it?
-            // Actually, main thread only reads 'processing' and results. 
-            // Input data (parts, rotation) is constant during evaluation.
-            
-            Individual individualCopy;
-            {
-                boost::lock_guard<boost::mutex> lock(mutex_);
-                individualCopy = population.getIndividuals()[i];
+    // Longest predicted evaluation first: the generation then ends with
+    // short evaluations filling the threads instead of one long one
+    if (coldNFPs && launch.size() > 1) {
+        const std::pair<double, double> perUnit = costCoefficients();
+        std::vector<double> cost(individuals.size(), 0.0);
+        for (size_t i : launch) {
+            cost[i] = perUnit.first * static_cast<double>(individuals[i].placement.size()) +
+                      perUnit.second * static_cast<double>(coldNFPs(i));
+        }
+        std::stable_sort(launch.begin(), launch.end(),
+                         [&cost](size_t a, size_t b) { return cost[a] > cost[b]; });
+    }
+
+    for (size_t i : launch) {
+        Individual& individual = individuals[i];
+
+        auto slot = std::make_shared<EvaluationSlot>();
+        individual.evaluation = slot;
+
+        // Genes as turned parts of the shared job; screening evaluations
+        // place the conservative outlines
+        std::vector<size_t> variants;
+        variants.reserve(individual.placement.size());
+        for (size_t j = 0; j < individual.placement.size(); ++j) {
+            const size_t variant = job->variantIndex(
+                individual.placement[j]->id, individual.rotation[j], individual.coarse);
+            if (variant == PlacementJob::npos) {
+                break;
             }
-            
-            // Perform the heavy lifting WITHOUT the lock
-                // Prepare parts with rotations
-                std::vector<Polygon> parts;
-                for (size_t j = 0; j < individualCopy.placement.size(); ++j) {
-                    Polygon part = *individualCopy.placement[j];
-                    part.rotation = individualCopy.rotation[j];
-                    parts.push_back(part);
+            variants.push_back(variant);
+        }
+
+        // A gene the job does not hold falls back to copying the parts
+        std::vector<std::shared_ptr<Polygon>> placement;
+        std::vector<double> rotation;
+        if (variants.size() < individual.placement.size()) {
+            placement = individual.placement;
+            rotation = individual.rotation;
+        }
+
+        // A genome evaluated before needs no placement
+        if (placement.empty() && memo) {
+            if (FitnessMemo::ResultHandle known = memo->find(variants)) {
+                slot->result = *known;
+                slot->state.store(EvaluationState::DONE, std::memory_order_release);
+                continue;
+            }
+        }
+
+        // Overflow beyond the local threads goes to remote workers
+        if (placement.empty() && evaluateRemotely(slot, job, worker, variants, cutoff, memo)) {
+            continue;
+        }
+
+        int node = -1;
+        if (nodes > 1 && !individual.placement.empty()) {
+            const size_t gene = static_cast<size_t>(individual.placement[0]->id) * 31u
+                + static_cast<uint32_t>(NFPCache::rotationKey(individual.rotation[0]));
+            node = static_cast<int>(gene % nodes);
+        }
+
+        // Timed for the cost model when the order is predicted
+        const size_t cold = coldNFPs ? coldNFPs(i) : 0;
+        enqueue([this, slot, job, &worker, cutoff, i, token, memo, cold,
+                 timed = static_cast<bool>(coldNFPs),
+                 variants = std::move(variants),
+                 placement = std::move(placement),
+                 rotation = std::move(rotation),
+                 coarse = individual.coarse]() {
+            try {
+                if (placement.empty()) {
+                    const auto start = timed ? std::chrono::steady_clock::now()
+                                             : std::chrono::steady_clock::time_point();
+                    slot->result = worker.placeParts(*job, variants, cutoff, token);
+                    if (timed && !slot->result.bounded) {
+                        recordCost(variants.size(), cold, std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start).count());
+                    }
+                    if (memo) {
+                        memo->insert(variants, slot->result);
+                    }
+                } else {
+                    std::vector<Polygon> parts;
+                    parts.reserve(placement.size());
+                    for (size_t j = 0; j < placement.size(); ++j) {
+                        const auto& source = placement[j];
+                        Polygon part = coarse && source->coarse ? *source->coarse : *source;
+                        part.rotation = rotation[j];
+                        parts.push_back(part);
+                    }
+                    slot->result = worker.placeParts(job->sheets(), parts, cutoff, token);
                 }
-            PlacementWorker::PlacementResult result = worker.placeParts(sheets, parts);
-            
-            // Update the results WITH the lock
-                {
-                boost::lock_guard<boost::mutex> lock(mutex_);
-                // Update the original individual with results
-                auto& originalIndividual = population.getIndividuals()[i];
-                originalIndividual.fitness = result.fitness;
-                originalIndividual.area = result.area;
-                originalIndividual.mergedLength = result.mergedLength;
-                originalIndividual.placements = result.placements;
-                originalIndividual.processing = false;
-
-                        // Log fitness evaluation (first 10 individuals only to avoid spam)
-                        static int evalCount = 0;
-                        evalCount++;
-                        if (evalCount <= 10) {
-                            LOG_GA("[Eval #" << evalCount << "] Individual[" << i
-                                      << "] fitness=" << result.fitness
-                                      << ", area=" << result.area
-                                      << ", merged=" << result.mergedLength);
-                        }
+            } catch (const OperationCancelled&) {
+                // Never published; the slot stays PROCESSING until the
+                // engine resets it (NestingEngine::stop)
+                return;
+            }
+
+            // Log fitness evaluation (first 10 per worker only to avoid spam)
+            LOG_GA_SAMPLED(10, 0, "[Eval #" << pass << "] Individual[" << i
+                                  << "] fitness=" << slot->result.fitness
+                                  << ", area=" << slot->result.area
+                                  << ", merged=" << slot->result.mergedLength);
+
+            // Publish; the slot is not written after this
+            slot->state.store(EvaluationState::DONE, std::memory_order_release);
+        }, node);
+    }
+}
+
+std::pair<double, double> ParallelProcessor::costCoefficients() const {
+    // Until enough evaluations are timed, or while every genome is warm,
+    // a cold NFP is taken to cost as much as placing this many parts
+    const double COLD_NFP_GENES = 20.0;
+    const size_t MIN_SAMPLES = 16;
+
+    boost::lock_guard<boost::mutex> lock(costMutex_);
+    const CostModel& m = costModel_;
+    if (m.samples < MIN_SAMPLES || m.gg <= 0.0 || m.gt <= 0.0) {
+        return {1.0, COLD_NFP_GENES};
+    }
+
+    // Normal equations of seconds = a * genes + b * cold
+    const double det = m.gg * m.cc - m.gc * m.gc;
+    if (det > 1e-9 * m.gg * m.cc) {
+        const double a = (m.gt * m.cc - m.ct * m.gc) / det;
+        const double b = (m.ct * m.gg - m.gt * m.gc) / det;
+        if (a > 0.0 && b >= 0.0) {
+            return {a, b};
+        }
+    }
+    const double a = m.gt / m.gg;
+    return {a, a * COLD_NFP_GENES};
+}
+
+void ParallelProcessor::recordCost(size_t genes, size_t cold, double seconds) {
+    // Older evaluations fade out over a few hundred samples
+    const double DECAY = 0.99;
+    const double g = static_cast<double>(genes);
+    const double c = static_cast<double>(cold);
+
+    boost::lock_guard<boost::mutex> lock(costMutex_);
+    CostModel& m = costModel_;
+    m.gg = m.gg * DECAY + g * g;
+    m.gc = m.gc * DECAY + g * c;
+    m.cc = m.cc * DECAY + c * c;
+    m.gt = m.gt * DECAY + g * seconds;
+    m.ct = m.ct * DECAY + c * seconds;
+    ++m.samples;
+}
+
+size_t ParallelProcessor::connectRemoteWorkers(
+    const std::vector<std::string>& endpoints,
+    const std::shared_ptr<const PlacementJob>& job,
+    const std::string& snapshot,
+    const std::string& token
+) {
+    disconnectRemoteWorkers();
+
+    for (const auto& endpoint : endpoints) {
+        auto node = std::make_unique<RemoteNode>(endpoint);
+        if (node->connect(snapshot, token)) {
+            remotes_.push_back(std::move(node));
+        }
+    }
+    remoteJob_ = remotes_.empty() ? nullptr : job;
+    return remotes_.size();
+}
+
+void ParallelProcessor::disconnectRemoteWorkers() {
+    for (auto& node : remotes_) {
+        releaseRemote(node->abandon());
+        node->close();
+    }
+    remotes_.clear();
+    remoteJob_.reset();
+}
+
+bool ParallelProcessor::evaluateRemotely(
+    const std::shared_ptr<EvaluationSlot>& slot,
+    const std::shared_ptr<const PlacementJob>& job,
+    PlacementWorker& worker,
+    const std::vector<size_t>& variants,
+    double cutoff,
+    const std::shared_ptr<FitnessMemo>& memo
+) {
+    if (remotes_.empty() || job != remoteJob_) {
+        return false;
+    }
+
+    // Local threads are filled first; queued local work already covers them
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        if (pending_ < static_cast<size_t>(threadCount_)) {
+            return false;
+        }
+    }
+
+    // Least loaded node relative to its capacity
+    RemoteNode* target = nullptr;
+    double targetLoad = 1.0;
+    for (auto& node : remotes_) {
+        if (!node->alive()) {
+            continue;
+        }
+        const double load = static_cast<double>(node->inFlight()) / node->capacity();
+        if (load < targetLoad) {
+            target = node.get();
+            targetLoad = load;
+        }
+    }
+    if (!target) {
+        return false;
+    }
+
+    {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        ++pending_;
+    }
+
+    const bool sent = target->submit(variants, cutoff,
+        [this, slot, variants, memo](PlacementWorker::PlacementResult&& result) {
+            if (memo) {
+                memo->insert(variants, result);
+            }
+            slot->result = std::move(result);
+            slot->state.store(EvaluationState::DONE, std::memory_order_release);
+            releaseRemote(1);
+        },
+        [this, slot, job, &worker, variants, cutoff, memo]() {
+            // The node dropped; evaluate here, enqueued before the remote
+            // request stops counting so waitAll() does not see a gap
+            const CancellationToken token = cancellationToken();
+            enqueue([slot, job, &worker, variants, cutoff, token, memo]() {
+                try {
+                    slot->result = worker.placeParts(*job, variants, cutoff, token);
+                    if (memo) {
+                        memo->insert(variants, slot->result);
                     }
+                } catch (const OperationCancelled&) {
+                    return;
+                }
+                slot->state.store(EvaluationState::DONE, std::memory_order_release);
             });
-        }
+            releaseRemote(1);
+        });
+
+    if (!sent) {
+        ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+        --pending_;
+    }
+    return sent;
 }
 
-void ParallelProcessor::calculateNFPsParallel(
+void ParallelProcessor::releaseRemote(size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    ProfiledLock<boost::mutex> lock(pendingMutex_, pendingLockStats_);
+    pending_ -= count;
+    completed_ += count;
+    idle_.notify_all();
+}
+
+std::vector<std::future<void>> ParallelProcessor::prefetchNFPs(
     const std::vector<NFPPair>& pairs,
-    NFPCache& cache,
-    const DeepNestConfig& config
+    NFPCalculator& calculator
 ) {
     // JavaScript reference: svgnest.js lines 338-447
     // p.map(function(pair){ ... })
-    
-    if (pairs.empty()) {
-        return;
+
+    // Pairs sharing the stationary polygon (same A, rotation and kind) go to
+    // the same batch so computeBatch prepares A once. Groups keep the order
+    // of their first pair, so the priority order is roughly preserved.
+    const size_t BATCH_SIZE = 16;
+
+    struct GroupKey {
+        const Polygon* A;
+        int32_t rotation;
+        bool inside;
+
+        bool operator<(const GroupKey& other) const {
+            if (A != other.A) return A < other.A;
+            if (rotation != other.rotation) return rotation < other.rotation;
+            return inside < other.inside;
+        }
+    };
+
+    std::map<GroupKey, size_t> groupIndex;
+    std::vector<std::vector<const NFPPair*>> groups;
+
+    for (const auto& pair : pairs) {
+        // JavaScript: if(!pair || pair.length == 0) return null;
+        if (!pair.A || !pair.B || pair.A->points.empty() || pair.B->points.empty()) {
+            continue;
+        }
+
+        // Sheets are never rotated
+        GroupKey key{pair.A.get(), pair.inside ? 0 : NFPCache::rotationKey(pair.Arotation), pair.inside};
+        auto inserted = groupIndex.emplace(key, groups.size());
+        if (inserted.second) {
+            groups.emplace_back();
+        }
+        groups[inserted.first->second].push_back(&pair);
     }
-    
-    LOG_THREAD("calculateNFPsParallel: Processing " << pairs.size() << " NFP pairs");
-    
-    // Process each pair in parallel using thread pool
+
     std::vector<std::future<void>> futures;
-    futures.reserve(pairs.size());
-    
-    for (const auto& pair : pairs) {
-        // Enqueue NFP calculation task
-        auto future = enqueue([&pair, &cache, &config]() {
-            // JavaScript: if(!pair || pair.length == 0) return null;
-            if (pair.A.points.empty() || pair.B.points.empty()) {
-                return;
+    futures.reserve(pairs.size() / BATCH_SIZE + groups.size());
+
+    const CancellationToken token = cancellationToken();
+
+    LOG_THREAD("prefetchNFPs: Enqueuing " << pairs.size() << " NFP pairs in "
+               << groups.size() << " groups");
+
+    for (const auto& group : groups) {
+        for (size_t first = 0; first < group.size(); first += BATCH_SIZE) {
+            size_t last = std::min(group.size(), first + BATCH_SIZE);
+            std::vector<NFPPair> batch;
+            batch.reserve(last - first);
+            for (size_t i = first; i < last; ++i) {
+                batch.push_back(*group[i]);
             }
-            
-            // JavaScript lines 345-346: Rotate polygons
-            Polygon A = pair.A.rotate(pair.Arotation);
-            Polygon B = pair.B.rotate(pair.Brotation);
-            
-            std::vector<std::vector<Point>> nfp;
-            
-            if (pair.inside) {
-                // ========== INNER NFP (JavaScript lines 350-370) ==========
-                if (GeometryUtil::isRectangle(A.points, 0.001)) {
-                    nfp = GeometryUtil::noFitPolygonRectangle(A.points, B.points);
-                } else {
-                    nfp = GeometryUtil::noFitPolygon(A.points, B.points, true, config.exploreConcave);
-                }
-                
-                // Ensure all interior NFPs have same winding direction
-                if (!nfp.empty()) {
-                    for (auto& nfpPoly : nfp) {
-                        if (GeometryUtil::polygonArea(nfpPoly) > 0) {
-                            std::reverse(nfpPoly.begin(), nfpPoly.end());
-                        }
-                    }
-                }
-            } else {
-                // ========== OUTER NFP (JavaScript lines 372-438) ==========
-                nfp = GeometryUtil::noFitPolygon(A.points, B.points, false, config.exploreConcave);
-                
-                if (nfp.empty()) {
-                    return;
-                }
-                
-                // Area validation (JavaScript lines 383-394)
-                double areaA = std::abs(GeometryUtil::polygonArea(A.points));
-                for (size_t j = 0; j < nfp.size(); ++j) {
-                    if (!config.exploreConcave || j == 0) {
-                        double areaNFP = std::abs(GeometryUtil::polygonArea(nfp[j]));
-                        if (areaNFP < areaA) {
-                            nfp.clear();
-                            return;
-                        }
-                    }
-                }
-                
-                // Winding direction correction (JavaScript lines 401-413)
-                for (size_t j = 0; j < nfp.size(); ++j) {
-                    if (GeometryUtil::polygonArea(nfp[j]) > 0) {
-                        std::reverse(nfp[j].begin(), nfp[j].end());
-                    }
-                    
-                    if (j > 0 && !nfp[j].empty() && !nfp[0].empty()) {
-                        auto pointInPoly = GeometryUtil::pointInPolygon(nfp[j][0], nfp[0]);
-                        if (pointInPoly.has_value() && pointInPoly.value()) {
-                            if (GeometryUtil::polygonArea(nfp[j]) < 0) {
-                                std::reverse(nfp[j].begin(), nfp[j].end());
-                            }
+
+            futures.push_back(enqueue([batch, &calculator, token]() {
+                std::vector<NFPRequest> requests;
+                requests.reserve(batch.size());
+
+                // Rotate A and B exactly like PlacementWorker::placeParts so
+                // the cache keys and geometry match what placement will ask
+                // for, unless the pair carries the job's turned variants
+                std::shared_ptr<const Polygon> A;
+                for (const auto& pair : batch) {
+                    if (!A) {
+                        if (pair.inside) {
+                            A = pair.A;
+                        } else if (pair.turnedA) {
+                            A = pair.turnedA;
+                        } else {
+                            auto rotatedA = std::make_shared<Polygon>(pair.A->rotate(pair.Arotation));
+                            rotatedA->rotation = pair.Arotation;
+                            rotatedA->source = pair.A->source;
+                            rotatedA->id = pair.A->id;
+                            A = rotatedA;
                         }
                     }
-                }
-                
-                // Holes support (JavaScript lines 416-438)
-                if (config.useHoles && !A.children.empty()) {
-                    BoundingBox bboxB = B.bounds();
-                    
-                    for (const auto& hole : A.children) {
-                        BoundingBox bboxHole = hole.bounds();
-                        
-                        if (bboxHole.width > bboxB.width && bboxHole.height > bboxB.height) {
-                            auto cnfp = GeometryUtil::noFitPolygon(hole.points, B.points, true, config.exploreConcave);
-                            
-                            if (!cnfp.empty()) {
-                                for (auto& cnfpPoly : cnfp) {
-                                    if (GeometryUtil::polygonArea(cnfpPoly) < 0) {
-                                        std::reverse(cnfpPoly.begin(), cnfpPoly.end());
-                                    }
-                                    nfp.push_back(cnfpPoly);
-                                }
-                            }
-                        }
+
+                    if (pair.turnedB) {
+                        requests.push_back(NFPRequest{A, pair.turnedB, pair.inside});
+                        continue;
                     }
+
+                    auto B = std::make_shared<Polygon>(pair.B->rotate(pair.Brotation));
+                    B->rotation = pair.Brotation;
+                    B->source = pair.B->source;
+                    B->id = pair.B->id;
+
+                    requests.push_back(NFPRequest{A, B, pair.inside});
                 }
-            }
-            
-            // Store in cache (JavaScript lines 447-457)
-            if (!nfp.empty()) {
-                std::vector<Polygon> nfpPolygons;
-                nfpPolygons.reserve(nfp.size());
-                for (const auto& nfpPoints : nfp) {
-                    Polygon poly;
-                    poly.points = nfpPoints;
-                    nfpPolygons.push_back(poly);
+
+                try {
+                    calculator.computeBatch(requests, token);
+                } catch (const OperationCancelled&) {
+                    // Pairs not computed are left to placement
+                } catch (const std::exception& e) {
+                    // Placement recomputes the pairs on demand
+                    std::cerr << "WARNING: NFP prefetch batch failed for A(id=" << batch.front().A->id
+                              << "): " << e.what() << std::endl;
                 }
-                
-                cache.insert(pair.Asource, pair.Bsource, pair.Arotation, pair.Brotation, nfpPolygons, pair.inside);
-            }
-        });
-        
-        futures.push_back(std::move(future));
+            }));
+        }
     }
-    
+
+    return futures;
+}
+
+void ParallelProcessor::calculateNFPsParallel(
+    const std::vector<NFPPair>& pairs,
+    NFPCalculator& calculator
+) {
+    if (pairs.empty()) {
+        return;
+    }
+
+    std::vector<std::future<void>> futures = prefetchNFPs(pairs, calculator);
+
     // Wait for all NFP calculations to complete
     for (auto& future : futures) {
         future.get();
     }
-    
+
     LOG_THREAD("calculateNFPsParallel: Completed " << pairs.size() << " pairs");
 }
 
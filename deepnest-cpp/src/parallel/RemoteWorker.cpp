@@ -0,0 +1,571 @@
+#include "../../include/deepnest/parallel/RemoteWorker.h"
+#include "../../include/deepnest/parallel/ParallelProcessor.h"
+#include "../../include/deepnest/parallel/WireFormat.h"
+#include "../../include/deepnest/nfp/NFPCache.h"
+#include "../../include/deepnest/nfp/NFPCalculator.h"
+#include "../../include/deepnest/placement/PlacementJob.h"
+#include "../../include/deepnest/DebugConfig.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace deepnest {
+
+using boost::asio::ip::tcp;
+
+namespace {
+
+/**
+ * @brief Bumped whenever a frame layout changes
+ */
+const uint32_t PROTOCOL_VERSION = 4;
+
+/**
+ * @brief Largest frame either side accepts
+ */
+const uint32_t MAX_FRAME_SIZE = 1u << 30;
+
+enum class FrameType : uint8_t {
+    JOB = 1,     // master -> node: token, job snapshot (RemoteNode::encodeJob)
+    READY = 2,   // node -> master: capacity
+    EVAL = 3,    // master -> node: request id, cutoff, variant indices
+    RESULT = 4,  // node -> master: request id, placement result
+    CANCEL = 5   // master -> node: drop evaluations not started
+};
+
+std::string makeFrame(FrameType type, const std::string& payload) {
+    WireWriter header;
+    header.u32(static_cast<uint32_t>(payload.size()));
+    header.u8(static_cast<uint8_t>(type));
+    return header.data() + payload;
+}
+
+bool readFrame(tcp::socket& socket, FrameType& type, std::string& payload) {
+    unsigned char header[5];
+    boost::system::error_code ec;
+    boost::asio::read(socket, boost::asio::buffer(header), ec);
+    if (ec) {
+        return false;
+    }
+
+    const uint32_t size = static_cast<uint32_t>(header[0]) |
+                          static_cast<uint32_t>(header[1]) << 8 |
+                          static_cast<uint32_t>(header[2]) << 16 |
+                          static_cast<uint32_t>(header[3]) << 24;
+    if (size > MAX_FRAME_SIZE) {
+        return false;
+    }
+    type = static_cast<FrameType>(header[4]);
+
+    payload.resize(size);
+    if (size > 0) {
+        boost::asio::read(socket, boost::asio::buffer(&payload[0], size), ec);
+    }
+    return !ec;
+}
+
+/**
+ * @brief Compare tokens in time independent of where they differ
+ */
+bool sameToken(const std::string& a, const std::string& b) {
+    unsigned char diff = a.size() == b.size() ? 0 : 1;
+    for (size_t i = 0; i < a.size(); ++i) {
+        diff |= static_cast<unsigned char>(a[i] ^ b[i % std::max<size_t>(1, b.size())]);
+    }
+    return diff == 0;
+}
+
+/**
+ * @brief Settings that change where a node places parts
+ *
+ * Thread, scheduler and cache settings stay the node's own.
+ */
+void writeConfig(WireWriter& out, const DeepNestConfig& config) {
+    out.f64(config.clipperScale);
+    out.f64(config.curveTolerance);
+    out.f64(config.spacing);
+    out.i32(config.rotations);
+    out.str(config.placementType);
+    out.f64(config.rasterCellSize);
+    out.u8(config.mergeLines ? 1 : 0);
+    out.f64(config.timeRatio);
+    out.f64(config.scale);
+    out.u8(config.simplify ? 1 : 0);
+    out.f64(config.overlapTolerance);
+    out.u8(config.exploreConcave ? 1 : 0);
+    out.u8(config.useHoles ? 1 : 0);
+    out.u8(config.nfpRotationEquivariant ? 1 : 0);
+    out.i32(config.placementMemoMaxMemoryMB);
+    out.i32(config.parallelScoringThreshold);
+    out.u8(config.validateMergedLines ? 1 : 0);
+    out.i32(static_cast<int32_t>(config.gravityDirection));
+    out.u8(config.integerGeometry ? 1 : 0);
+}
+
+void readConfig(WireReader& in, DeepNestConfig& config) {
+    config.clipperScale = in.f64();
+    config.curveTolerance = in.f64();
+    config.spacing = in.f64();
+    config.rotations = in.i32();
+    config.placementType = in.str();
+    config.rasterCellSize = in.f64();
+    config.mergeLines = in.u8() != 0;
+    config.timeRatio = in.f64();
+    config.scale = in.f64();
+    config.simplify = in.u8() != 0;
+    config.overlapTolerance = in.f64();
+    config.exploreConcave = in.u8() != 0;
+    config.useHoles = in.u8() != 0;
+    config.nfpRotationEquivariant = in.u8() != 0;
+    config.placementMemoMaxMemoryMB = in.i32();
+    config.parallelScoringThreshold = in.i32();
+    config.validateMergedLines = in.u8() != 0;
+    config.gravityDirection = static_cast<GravityDirection>(in.i32());
+    config.integerGeometry = in.u8() != 0;
+}
+
+/**
+ * @brief The fields Individual::collect() takes over
+ */
+void writeResult(WireWriter& out, const PlacementWorker::PlacementResult& result) {
+    out.f64(result.fitness);
+    out.f64(result.area);
+    out.f64(result.mergedLength);
+    out.u8(result.bounded ? 1 : 0);
+    out.u32(static_cast<uint32_t>(result.placements.size()));
+    for (const auto& sheet : result.placements) {
+        out.u32(static_cast<uint32_t>(sheet.size()));
+        for (const auto& placement : sheet) {
+            out.f64(placement.position.x);
+            out.f64(placement.position.y);
+            out.i32(placement.id);
+            out.i32(placement.source);
+            out.f64(placement.rotation);
+        }
+    }
+}
+
+PlacementWorker::PlacementResult readResult(WireReader& in) {
+    PlacementWorker::PlacementResult result;
+    result.fitness = in.f64();
+    result.area = in.f64();
+    result.mergedLength = in.f64();
+    result.bounded = in.u8() != 0;
+    result.placements.resize(in.count(4));
+    for (auto& sheet : result.placements) {
+        sheet.resize(in.count(32));
+        for (auto& placement : sheet) {
+            const double x = in.f64();
+            const double y = in.f64();
+            placement.position = Point(x, y);
+            placement.id = in.i32();
+            placement.source = in.i32();
+            placement.rotation = in.f64();
+        }
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+// ========== RemoteNode ==========
+
+RemoteNode::RemoteNode(const std::string& endpoint)
+    : endpoint_(endpoint)
+    , socket_(io_)
+    , nextId_(0)
+    , alive_(false)
+    , capacity_(0)
+{
+}
+
+RemoteNode::~RemoteNode() {
+    close();
+}
+
+bool RemoteNode::connect(const std::string& snapshot, const std::string& token) {
+    const size_t colon = endpoint_.rfind(':');
+    if (colon == std::string::npos) {
+        LOG_THREAD("Remote worker endpoint without port: " << endpoint_);
+        return false;
+    }
+
+    try {
+        tcp::resolver resolver(io_);
+        boost::asio::connect(socket_, resolver.resolve(endpoint_.substr(0, colon), endpoint_.substr(colon + 1)));
+        socket_.set_option(tcp::no_delay(true));
+        WireWriter job;
+        job.str(token);
+        job.str(snapshot);
+        boost::asio::write(socket_, boost::asio::buffer(makeFrame(FrameType::JOB, job.data())));
+
+        FrameType type;
+        std::string payload;
+        if (!readFrame(socket_, type, payload) || type != FrameType::READY) {
+            throw std::runtime_error("job rejected");
+        }
+        WireReader in(payload);
+        capacity_ = std::max<size_t>(1, in.u32());
+    } catch (const std::exception& e) {
+        LOG_THREAD("Remote worker " << endpoint_ << " unavailable: " << e.what());
+        boost::system::error_code ec;
+        socket_.close(ec);
+        return false;
+    }
+
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        alive_ = true;
+    }
+    reader_ = boost::thread([this]() { read(); });
+
+    LOG_THREAD("Remote worker " << endpoint_ << " ready with " << capacity_ << " threads");
+    return true;
+}
+
+bool RemoteNode::submit(const std::vector<size_t>& variants, double cutoff,
+                        ResultHandler done, FailureHandler failed) {
+    uint64_t id;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        if (!alive_) {
+            return false;
+        }
+        id = nextId_++;
+        requests_.emplace(id, Request{std::move(done), std::move(failed)});
+    }
+
+    WireWriter out;
+    out.u64(id);
+    out.f64(cutoff);
+    out.u32(static_cast<uint32_t>(variants.size()));
+    for (size_t variant : variants) {
+        out.u32(static_cast<uint32_t>(variant));
+    }
+
+    if (!send(makeFrame(FrameType::EVAL, out.data()))) {
+        // Unless the reader thread has already failed it, the request is
+        // handed back to the caller
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        if (requests_.erase(id) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t RemoteNode::abandon() {
+    size_t count;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        count = requests_.size();
+        requests_.clear();
+        if (!alive_) {
+            return count;
+        }
+    }
+
+    if (count > 0) {
+        send(makeFrame(FrameType::CANCEL, std::string()));
+    }
+    return count;
+}
+
+void RemoteNode::close() {
+    // Wakes the reader thread, which then fails the outstanding requests
+    boost::system::error_code ec;
+    socket_.shutdown(tcp::socket::shutdown_both, ec);
+    if (reader_.joinable()) {
+        reader_.join();
+    }
+    socket_.close(ec);
+}
+
+size_t RemoteNode::inFlight() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return requests_.size();
+}
+
+bool RemoteNode::alive() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return alive_;
+}
+
+std::vector<std::string> RemoteNode::parseEndpoints(const std::string& list) {
+    std::vector<std::string> endpoints;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+
+        const size_t first = list.find_first_not_of(" \t", begin);
+        if (first != std::string::npos && first < end) {
+            const size_t last = list.find_last_not_of(" \t", end - 1);
+            endpoints.push_back(list.substr(first, last - first + 1));
+        }
+        begin = end + 1;
+    }
+    return endpoints;
+}
+
+std::string RemoteNode::encodeJob(const DeepNestConfig& config,
+                                  const std::vector<Polygon>& sheets,
+                                  const std::vector<std::shared_ptr<Polygon>>& parts) {
+    WireWriter out;
+    out.u32(PROTOCOL_VERSION);
+    writeConfig(out, config);
+
+    out.u32(static_cast<uint32_t>(sheets.size()));
+    for (const auto& sheet : sheets) {
+        out.polygon(sheet);
+    }
+
+    out.u32(static_cast<uint32_t>(parts.size()));
+    for (const auto& part : parts) {
+        out.polygon(*part);
+        out.u8(part->coarse ? 1 : 0);
+        if (part->coarse) {
+            out.polygon(*part->coarse);
+        }
+    }
+    return out.data();
+}
+
+void RemoteNode::decodeJob(const std::string& snapshot,
+                           DeepNestConfig& config,
+                           std::vector<Polygon>& sheets,
+                           std::vector<std::shared_ptr<Polygon>>& parts) {
+    WireReader in(snapshot);
+    if (in.u32() != PROTOCOL_VERSION) {
+        throw std::runtime_error("Job snapshot with unsupported protocol version");
+    }
+    readConfig(in, config);
+
+    sheets.clear();
+    const size_t sheetCount = in.count(1);
+    for (size_t i = 0; i < sheetCount; ++i) {
+        sheets.push_back(in.polygon());
+        sheets.back().updateCoordinates();
+        if (!sheets.back().children.empty()) {
+            sheets.back().updateRings();
+        }
+    }
+
+    // Scaled paths and coordinates are rebuilt as NestingEngine::initialize()
+    // builds them
+    parts.clear();
+    const size_t partCount = in.count(1);
+    for (size_t i = 0; i < partCount; ++i) {
+        auto part = std::make_shared<Polygon>(in.polygon());
+        part->updateCoordinates();
+        part->updateScaledPath(config.clipperScale);
+        if (in.u8() != 0) {
+            Polygon outline = in.polygon();
+            outline.updateCoordinates();
+            outline.updateScaledPath(config.clipperScale);
+            part->coarse = std::make_shared<const Polygon>(std::move(outline));
+        }
+        parts.push_back(part);
+    }
+}
+
+void RemoteNode::read() {
+    FrameType type;
+    std::string payload;
+    while (readFrame(socket_, type, payload)) {
+        if (type != FrameType::RESULT) {
+            continue;
+        }
+
+        uint64_t id;
+        PlacementWorker::PlacementResult result;
+        try {
+            WireReader in(payload);
+            id = in.u64();
+            result = readResult(in);
+        } catch (const std::exception& e) {
+            LOG_THREAD("Remote worker " << endpoint_ << " sent a bad result: " << e.what());
+            break;
+        }
+
+        // Late answers to abandoned requests are dropped
+        Request request;
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            auto it = requests_.find(id);
+            if (it == requests_.end()) {
+                continue;
+            }
+            request = std::move(it->second);
+            requests_.erase(it);
+        }
+        request.done(std::move(result));
+    }
+
+    // Connection lost or closed: hand back what is still outstanding
+    std::unordered_map<uint64_t, Request> orphans;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        alive_ = false;
+        orphans.swap(requests_);
+    }
+    if (!orphans.empty()) {
+        LOG_THREAD("Remote worker " << endpoint_ << " lost with " << orphans.size() << " evaluations");
+    }
+    for (auto& entry : orphans) {
+        entry.second.failed();
+    }
+}
+
+bool RemoteNode::send(const std::string& frame) {
+    boost::lock_guard<boost::mutex> lock(writeMutex_);
+    boost::system::error_code ec;
+    boost::asio::write(socket_, boost::asio::buffer(frame), ec);
+    if (ec) {
+        socket_.shutdown(tcp::socket::shutdown_both, ec);
+        return false;
+    }
+    return true;
+}
+
+// ========== RemoteWorkerServer ==========
+
+RemoteWorkerServer::RemoteWorkerServer(unsigned short port, int threads,
+                                       const std::string& address, const std::string& token)
+    : acceptor_(io_, tcp::endpoint(boost::asio::ip::make_address(address), port))
+    , threads_(threads)
+    , token_(token)
+    , stopped_(false)
+{
+}
+
+void RemoteWorkerServer::run() {
+    while (!stopped_) {
+        tcp::socket socket(io_);
+        boost::system::error_code result;
+        acceptor_.async_accept(socket, [&result](const boost::system::error_code& ec) {
+            result = ec;
+        });
+
+        // Returns once a master connects or stop() closes the acceptor
+        io_.restart();
+        io_.run();
+        if (result) {
+            continue;
+        }
+
+        socket.set_option(tcp::no_delay(true), result);
+        serve(socket);
+    }
+}
+
+void RemoteWorkerServer::stop() {
+    boost::asio::post(io_, [this]() {
+        stopped_ = true;
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+    });
+}
+
+void RemoteWorkerServer::serve(tcp::socket& socket) {
+    FrameType type;
+    std::string payload;
+    if (!readFrame(socket, type, payload) || type != FrameType::JOB) {
+        return;
+    }
+
+    // The placement settings of the job replace a copy of this process's own
+    DeepNestConfig config(DeepNestConfig::getInstance());
+    std::vector<Polygon> sheets;
+    std::vector<std::shared_ptr<Polygon>> parts;
+    try {
+        WireReader in(payload);
+        if (!sameToken(in.str(), token_)) {
+            LOG_THREAD("Remote job with a wrong token refused");
+            return;
+        }
+        RemoteNode::decodeJob(in.str(), config, sheets, parts);
+    } catch (const std::exception& e) {
+        LOG_THREAD("Bad remote job: " << e.what());
+        return;
+    }
+
+    NFPCache cache;
+    cache.setMemoryLimit(static_cast<size_t>(config.nfpCacheMaxMemoryMB) * 1024 * 1024);
+    cache.setCompactStorage(config.nfpCacheCompact ? config.getClipperScale() : 0.0);
+    NFPCalculator calculator(cache, config);
+    calculator.setRotationEquivariant(config.nfpRotationEquivariant);
+    PlacementWorker worker(config, calculator);
+
+    ParallelProcessor processor(threads_, ParallelProcessor::backendFromName(config.taskScheduler),
+                                WorkerAffinity{config.pinWorkerThreads, config.numaScheduling});
+    worker.setParallelProcessor(&processor);
+
+    const auto job = std::make_shared<const PlacementJob>(sheets, parts, config.rotations, config.clipperScale,
+        config.integerGeometry,
+        [&processor](size_t count, const std::function<void(size_t, size_t)>& body) {
+            processor.parallelFor(count, 1, body);
+        });
+
+    boost::mutex writeMutex;
+    auto send = [&socket, &writeMutex](const std::string& frame) {
+        boost::lock_guard<boost::mutex> lock(writeMutex);
+        boost::system::error_code ec;
+        boost::asio::write(socket, boost::asio::buffer(frame), ec);
+    };
+
+    WireWriter ready;
+    ready.u32(static_cast<uint32_t>(processor.getThreadCount()));
+    send(makeFrame(FrameType::READY, ready.data()));
+    LOG_THREAD("Serving remote job: " << sheets.size() << " sheets, " << parts.size() << " parts");
+
+    while (readFrame(socket, type, payload)) {
+        if (type == FrameType::CANCEL) {
+            processor.cancel();
+            continue;
+        }
+        if (type != FrameType::EVAL) {
+            continue;
+        }
+
+        uint64_t id;
+        double cutoff;
+        std::vector<size_t> variants;
+        try {
+            WireReader in(payload);
+            id = in.u64();
+            cutoff = in.f64();
+            variants.resize(in.count(4));
+            for (auto& variant : variants) {
+                variant = in.u32();
+                if (variant >= job->variantCount()) {
+                    throw std::runtime_error("variant out of range");
+                }
+            }
+        } catch (const std::exception& e) {
+            LOG_THREAD("Bad remote evaluation: " << e.what());
+            break;
+        }
+
+        processor.enqueue([&worker, &send, job, id, cutoff, token = processor.cancellationToken(),
+                           variants = std::move(variants)]() {
+            WireWriter out;
+            out.u64(id);
+            try {
+                writeResult(out, worker.placeParts(*job, variants, cutoff, token));
+            } catch (const OperationCancelled&) {
+                return;  // The master abandoned it
+            }
+            send(makeFrame(FrameType::RESULT, out.data()));
+        });
+    }
+
+    // Master gone: drop queued evaluations and stop the running ones
+    processor.cancel();
+    processor.waitAll();
+    worker.setParallelProcessor(nullptr);
+}
+
+} // namespace deepnest
@@ -0,0 +1,102 @@
+#include "../../include/deepnest/parallel/ThreadCountController.h"
+#include <algorithm>
+
+namespace deepnest {
+
+namespace {
+
+// Windows spent at a level after a move there was undone, before probing
+// the other side; keeps a level at the optimum from being left every
+// other window
+const int HOLD_WINDOWS = 4;
+
+} // anonymous namespace
+
+ThreadCountController::ThreadCountController(int minThreads, int maxThreads)
+    : min_(std::max(1, minThreads))
+    , max_(std::max(min_, maxThreads))
+    , step_(std::max(1, (max_ - min_ + 7) / 8))
+    , level_(max_)
+    , direction_(-1)
+    , hold_(0)
+    , lastLevel_(0)
+    , last_(0.0)
+    , bestLevel_(max_)
+    , best_(0.0)
+    , leanCpu_(0.0)
+    , throughput_(0.0)
+    , offCpu_(0.0)
+    , inflation_(1.0) {
+}
+
+int ThreadCountController::update(const Sample& sample) {
+    window_.evaluations += sample.evaluations;
+    window_.seconds += sample.seconds;
+    window_.busySeconds += sample.busySeconds;
+    window_.cpuSeconds += sample.cpuSeconds;
+    if (window_.seconds < MIN_SECONDS ||
+        window_.evaluations < std::max(MIN_EVALUATIONS, 2 * static_cast<size_t>(level_))) {
+        return level_;
+    }
+
+    const double rate = static_cast<double>(window_.evaluations) / window_.seconds;
+    offCpu_ = window_.busySeconds > 0.0
+        ? std::min(1.0, std::max(0.0, 1.0 - window_.cpuSeconds / window_.busySeconds)) : 0.0;
+    const double cpuPerEvaluation = window_.cpuSeconds / static_cast<double>(window_.evaluations);
+    if (cpuPerEvaluation > 0.0 && (leanCpu_ == 0.0 || cpuPerEvaluation < leanCpu_)) {
+        leanCpu_ = cpuPerEvaluation;
+    }
+    inflation_ = leanCpu_ > 0.0 ? cpuPerEvaluation / leanCpu_ : 1.0;
+    throughput_ = rate;
+    window_ = Sample();
+
+    // The best level is measured again on each visit, so a rate from
+    // before other jobs arrived does not hold it forever
+    if (level_ == bestLevel_ || rate > best_) {
+        bestLevel_ = level_;
+        best_ = rate;
+    }
+
+    const int lastLevel = lastLevel_;
+    const double last = last_;
+    lastLevel_ = level_;
+    last_ = rate;
+
+    if (hold_ > 0) {
+        --hold_;
+        return level_;
+    }
+
+    // With no move to judge (first window, or held at a bound) the probe
+    // goes on in the current direction
+    int direction = direction_;
+    if (lastLevel != 0 && lastLevel != level_) {
+        const int moved = level_ > lastLevel ? 1 : -1;
+        const bool belowBest = rate < best_ * (1.0 - 2.0 * TOLERANCE);
+        if (belowBest || rate < last * (1.0 - TOLERANCE)) {
+            // Undone with a finer step, which can settle between the two
+            // levels
+            direction = belowBest ? (bestLevel_ > level_ ? 1 : -1) : -moved;
+            hold_ = HOLD_WINDOWS;
+            step_ = std::max(1, step_ / 2);
+        } else if (rate > last * (1.0 + TOLERANCE)) {
+            direction = moved;
+        } else if (offCpu_ > OFF_CPU_LIMIT || inflation_ > 1.0 + TOLERANCE) {
+            direction = -1;
+        }
+    }
+    move(direction);
+    return level_;
+}
+
+void ThreadCountController::move(int direction) {
+    direction_ = direction;
+    const int next = std::min(max_, std::max(min_, level_ + direction * step_));
+    if (next == level_) {
+        // At a bound: the next probe looks at the other side
+        direction_ = -direction;
+    }
+    level_ = next;
+}
+
+} // namespace deepnest
@@ -0,0 +1,158 @@
+#include "../../include/deepnest/parallel/WorkStealingScheduler.h"
+#include <algorithm>
+
+namespace deepnest {
+
+namespace {
+
+// Scheduler and worker index of the calling thread, if it is a worker
+thread_local const WorkStealingScheduler* currentScheduler = nullptr;
+thread_local size_t currentWorker = 0;
+
+} // anonymous namespace
+
+WorkStealingScheduler::WorkStealingScheduler(int threads, const WorkerAffinity& affinity)
+    : nextNode_(0)
+    , queued_(0)
+    , stopping_(false)
+{
+    const size_t count = static_cast<size_t>(std::max(threads, 1));
+    size_t nodes = 1;
+    slots_ = CpuTopology::assign(count, affinity, nodes);
+
+    for (size_t i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t node = 0; node < nodes; ++node) {
+        injected_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        threads_.create_thread([this, i]() {
+            run(i);
+        });
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    stop();
+}
+
+void WorkStealingScheduler::submit(Task task, int node) {
+    if (stopping_) {
+        return;
+    }
+
+    const bool onWorker = currentScheduler == this;
+    const size_t home = onWorker ? slots_[currentWorker].node : 0;
+    const size_t target = node >= 0 ? static_cast<size_t>(node) % injected_.size()
+                        : onWorker ? home
+                        : nextNode_++ % injected_.size();
+
+    // Counted before the push, so the count never drops below zero; a
+    // worker that sees it before the task lands just looks again
+    ++queued_;
+    Queue& queue = onWorker && target == home ? *workers_[currentWorker] : *injected_[target];
+    {
+        boost::lock_guard<boost::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // The lock orders the count with a worker about to sleep
+    {
+        boost::lock_guard<boost::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+void WorkStealingScheduler::stop() {
+    {
+        boost::lock_guard<boost::mutex> lock(sleepMutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    threads_.join_all();
+
+    // A submit that passed the stopping_ check may still be pushing
+    for (auto* queues : {&workers_, &injected_}) {
+        for (auto& queue : *queues) {
+            boost::lock_guard<boost::mutex> lock(queue->mutex);
+            queue->tasks.clear();
+        }
+    }
+}
+
+void WorkStealingScheduler::run(size_t index) {
+    currentScheduler = this;
+    currentWorker = index;
+    CpuTopology::pinCurrentThread(slots_[index].cpus);
+
+    Task task;
+    while (!stopping_) {
+        if (take(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        boost::unique_lock<boost::mutex> lock(sleepMutex_);
+        while (queued_ == 0 && !stopping_) {
+            wake_.wait(lock);
+        }
+    }
+
+    currentScheduler = nullptr;
+}
+
+bool WorkStealingScheduler::popFront(Queue& queue, Task& task, bool wait) {
+    boost::unique_lock<boost::mutex> lock(queue.mutex, boost::defer_lock);
+    if (wait) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return false;
+    }
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --queued_;
+    return true;
+}
+
+bool WorkStealingScheduler::take(size_t index, Task& task) {
+    // Own deque, newest first
+    {
+        Queue& own = *workers_[index];
+        boost::lock_guard<boost::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+
+    // Own node first, then the others: tasks from outside the pool, oldest
+    // first, then the oldest task of another worker
+    const size_t home = slots_[index].node;
+    for (size_t offset = 0; offset < injected_.size(); ++offset) {
+        const size_t node = (home + offset) % injected_.size();
+        if (popFront(*injected_[node], task, true)) {
+            return true;
+        }
+        for (size_t step = 1; step < workers_.size(); ++step) {
+            const size_t victim = (index + step) % workers_.size();
+            if (slots_[victim].node == node && popFront(*workers_[victim], task, false)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace deepnest
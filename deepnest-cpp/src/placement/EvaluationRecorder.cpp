@@ -0,0 +1,199 @@
+#include "../../include/deepnest/placement/EvaluationRecorder.h"
+#include "../../include/deepnest/parallel/WireFormat.h"
+#include "../../include/deepnest/DebugConfig.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace deepnest {
+
+namespace {
+
+/**
+ * @brief "DNRP" in little-endian byte order
+ */
+const uint32_t RECORDING_MAGIC = 0x50524E44;
+
+/**
+ * @brief Bumped whenever the recording layout changes
+ */
+const uint32_t RECORDING_VERSION = 1;
+
+/**
+ * @brief Captures the calling thread's cache lookups for one scope
+ */
+class CaptureScope {
+public:
+    explicit CaptureScope(NFPCache::Capture& capture) { NFPCache::setCapture(&capture); }
+    ~CaptureScope() { NFPCache::setCapture(nullptr); }
+
+    CaptureScope(const CaptureScope&) = delete;
+    CaptureScope& operator=(const CaptureScope&) = delete;
+};
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // anonymous namespace
+
+void EvaluationRecorder::Recording::save(const std::string& path) const {
+    WireWriter out;
+    out.u32(RECORDING_MAGIC);
+    out.u32(RECORDING_VERSION);
+    out.str(snapshot);
+    out.f64(cutoff);
+    out.u64(wallNs);
+    out.u64(medianNs);
+    out.f64(fitness);
+    out.u8(bounded ? 1 : 0);
+
+    out.u32(static_cast<uint32_t>(variants.size()));
+    for (size_t variant : variants) {
+        out.u32(static_cast<uint32_t>(variant));
+    }
+
+    out.u32(static_cast<uint32_t>(nfps.size()));
+    for (const auto& nfp : nfps) {
+        const NFPCache::NFPKey& key = nfp.first;
+        out.u64(key.idA);
+        out.u64(key.idB);
+        out.i32(key.rotationA);
+        out.i32(key.rotationB);
+        out.u8(key.inside ? 1 : 0);
+        out.u32(static_cast<uint32_t>(nfp.second->size()));
+        for (const auto& polygon : *nfp.second) {
+            out.polygon(polygon);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data().data(), static_cast<std::streamsize>(out.data().size()));
+    if (!file.flush()) {
+        throw std::runtime_error("Cannot write evaluation recording: " + path);
+    }
+}
+
+EvaluationRecorder::Recording EvaluationRecorder::Recording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open evaluation recording: " + path);
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    WireReader in(data);
+    if (in.u32() != RECORDING_MAGIC) {
+        throw std::runtime_error("Not an evaluation recording: " + path);
+    }
+    if (in.u32() != RECORDING_VERSION) {
+        throw std::runtime_error("Unsupported evaluation recording version: " + path);
+    }
+
+    Recording recording;
+    recording.snapshot = in.str();
+    recording.cutoff = in.f64();
+    recording.wallNs = in.u64();
+    recording.medianNs = in.u64();
+    recording.fitness = in.f64();
+    recording.bounded = in.u8() != 0;
+
+    recording.variants.resize(in.count(4));
+    for (auto& variant : recording.variants) {
+        variant = in.u32();
+    }
+
+    const size_t nfps = in.count(33);
+    recording.nfps.reserve(nfps);
+    for (size_t i = 0; i < nfps; ++i) {
+        NFPCache::NFPKey key;
+        key.idA = in.u64();
+        key.idB = in.u64();
+        key.rotationA = in.i32();
+        key.rotationB = in.i32();
+        key.inside = in.u8() != 0;
+
+        // Without Clipper paths: their scale is in the snapshot
+        auto polygons = std::make_shared<std::vector<Polygon>>(in.count(1));
+        for (auto& polygon : *polygons) {
+            polygon = in.polygon();
+        }
+        recording.nfps.emplace_back(key, std::move(polygons));
+    }
+    return recording;
+}
+
+EvaluationRecorder::EvaluationRecorder(std::string directory, std::string snapshot, double factor, size_t limit)
+    : directory_(std::move(directory))
+    , snapshot_(std::move(snapshot))
+    , factor_(factor)
+    , limit_(limit)
+    , recorded_(0)
+{}
+
+PlacementWorker::PlacementResult EvaluationRecorder::evaluate(
+    const std::vector<size_t>& variants,
+    double cutoff,
+    const std::function<PlacementWorker::PlacementResult()>& place
+) {
+    NFPCache::Capture capture;
+    const uint64_t begin = nowNs();
+    PlacementWorker::PlacementResult result;
+    {
+        CaptureScope scope(capture);
+        result = place();
+    }
+    const uint64_t wallNs = nowNs() - begin;
+
+    // Judged against the evaluations before it
+    const LatencyHistogram::Snapshot durations = durations_.snapshot();
+    durations_.record(wallNs);
+    if (durations.count < MIN_SAMPLES) {
+        return result;
+    }
+    const uint64_t medianNs = durations.percentileNs(0.5);
+    if (static_cast<double>(wallNs) <= factor_ * static_cast<double>(medianNs)) {
+        return result;
+    }
+
+    size_t index = recorded_.load(std::memory_order_relaxed);
+    do {
+        if (index >= limit_) {
+            return result;
+        }
+    } while (!recorded_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+    Recording recording;
+    recording.snapshot = snapshot_;
+    recording.variants = variants;
+    recording.cutoff = cutoff;
+    recording.wallNs = wallNs;
+    recording.medianNs = medianNs;
+    recording.fitness = result.fitness;
+    recording.bounded = result.bounded;
+    for (const auto& entry : capture.entries) {
+        if (entry.second) {
+            recording.nfps.push_back(entry);
+        }
+    }
+
+    // A failed recording must not fail the nest
+    try {
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+        const auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const std::string path = (std::filesystem::path(directory_) /
+            ("evaluation-" + std::to_string(stamp) + "-" + std::to_string(index) + ".dnreplay")).string();
+        recording.save(path);
+        LOG_NESTING("Recorded evaluation of " << wallNs / 1000000 << " ms (median "
+                    << medianNs / 1000000.0 << " ms) to " << path);
+    } catch (const std::exception& e) {
+        LOG_NESTING("Evaluation recording failed: " << e.what());
+    }
+    return result;
+}
+
+} // namespace deepnest
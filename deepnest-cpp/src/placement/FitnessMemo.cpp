@@ -0,0 +1,84 @@
+#include "../../include/deepnest/placement/FitnessMemo.h"
+
+namespace deepnest {
+
+FitnessMemo::FitnessMemo(size_t maxEntries)
+    : maxEntries_(maxEntries)
+    , lookups_(0)
+    , hits_(0)
+    , bytes_(0)
+{}
+
+uint64_t FitnessMemo::hash(const std::vector<size_t>& variants) {
+    // FNV-1a over the 8 bytes of each index
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t variant : variants) {
+        const uint64_t value = static_cast<uint64_t>(variant);
+        for (int i = 0; i < 8; i++) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+FitnessMemo::ResultHandle FitnessMemo::find(const std::vector<size_t>& variants) {
+    const uint64_t key = hash(variants);
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    lookups_++;
+
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.variants != variants) {
+        return nullptr;
+    }
+    hits_++;
+    return it->second.result;
+}
+
+void FitnessMemo::insert(const std::vector<size_t>& variants, const PlacementWorker::PlacementResult& result) {
+    if (result.bounded || maxEntries_ == 0) {
+        return;
+    }
+
+    const uint64_t key = hash(variants);
+    auto handle = std::make_shared<const PlacementWorker::PlacementResult>(result);
+    // Hash node, control block and the order_ slot on top of the payload
+    const size_t bytes = sizeof(Entry) + 64 + sizeof(uint64_t)
+                       + variants.size() * sizeof(size_t) + handle->memoryBytes();
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    if (!entries_.emplace(key, Entry{variants, std::move(handle), bytes}).second) {
+        return;
+    }
+    order_.push_back(key);
+    bytes_ += bytes;
+
+    while (entries_.size() > maxEntries_) {
+        auto oldest = entries_.find(order_.front());
+        bytes_ -= oldest->second.bytes;
+        entries_.erase(oldest);
+        order_.pop_front();
+    }
+}
+
+FitnessMemo::Statistics FitnessMemo::statistics() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    Statistics stats;
+    stats.lookups = lookups_;
+    stats.hits = hits_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
+
+void FitnessMemo::clear() {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    entries_.clear();
+    order_.clear();
+    bytes_ = 0;
+    lookups_ = 0;
+    hits_ = 0;
+}
+
+} // namespace deepnest
@@ -1,15 +1,30 @@
 #include "../../include/deepnest/placement/MergeDetection.h"
+#include "../../include/deepnest/StageTimes.h"
 #include <cmath>
 #include <algorithm>
 
 namespace deepnest {
 
+namespace {
+
+// Direction buckets over 180 degrees
+constexpr int DIRECTION_BUCKETS = 32;
+
+// Edges covering more cells than this are kept per bucket instead
+constexpr long long MAX_EDGE_CELLS = 16;
+
+// Slack on the tolerance bounds for rounding in the rotated frame
+constexpr double BOUND_SLACK = 1e-6;
+
+} // anonymous namespace
+
 MergeDetection::MergeResult MergeDetection::calculateMergedLength(
     const std::vector<Polygon>& placed,
     const Polygon& newPart,
     double minLength,
     double tolerance
 ) {
+    STAGE_SCOPE(MergeDetection);
     // Call internal recursive implementation
     return calculateMergedLengthInternal(placed, newPart.points, minLength, tolerance);
 }
@@ -98,106 +113,7 @@ MergeDetection::MergeResult MergeDetection::calculateMergedLengthInternal(
                         continue; // Edge too short
                     }
 
-                    // JavaScript: var relB1 = {x: B1.x - A1.x, y: B1.y - A1.y};
-                    //             var relB2 = {x: B2.x - A1.x, y: B2.y - A1.y};
-                    Point relB1(B1.x - A1.x, B1.y - A1.y);
-                    Point relB2(B2.x - A1.x, B2.y - A1.y);
-
-                    // JavaScript: var rotB1 = {x: relB1.x * c - relB1.y * s, y: relB1.x * s + relB1.y * c};
-                    //             var rotB2 = {x: relB2.x * c - relB2.y * s, y: relB2.x * s + relB2.y * c};
-                    Point rotB1(
-                        relB1.x * c - relB1.y * s,
-                        relB1.x * s + relB1.y * c
-                    );
-                    Point rotB2(
-                        relB2.x * c - relB2.y * s,
-                        relB2.x * s + relB2.y * c
-                    );
-
-                    // JavaScript: if(!GeometryUtil.almostEqual(rotB1.y, 0, tolerance) ||
-                    //                !GeometryUtil.almostEqual(rotB2.y, 0, tolerance)) { continue; }
-                    // Check if edge B is aligned with edge A (both y-coordinates should be ~0 after rotation)
-                    if (!almostEqual(rotB1.y, 0.0, tolerance) || !almostEqual(rotB2.y, 0.0, tolerance)) {
-                        continue; // Not aligned
-                    }
-
-                    // JavaScript: var min1 = Math.min(0, rotA2x);
-                    //             var max1 = Math.max(0, rotA2x);
-                    //             var min2 = Math.min(rotB1.x, rotB2.x);
-                    //             var max2 = Math.max(rotB1.x, rotB2.x);
-                    double min1 = std::min(0.0, rotA2x);
-                    double max1 = std::max(0.0, rotA2x);
-                    double min2_seg = std::min(rotB1.x, rotB2.x);
-                    double max2_seg = std::max(rotB1.x, rotB2.x);
-
-                    // JavaScript: if(min2 >= max1 || max2 <= min1) { continue; }
-                    // Check if segments overlap
-                    if (min2_seg >= max1 || max2_seg <= min1) {
-                        continue; // No overlap
-                    }
-
-                    // JavaScript: var len = 0;
-                    //             var relC1x = 0;
-                    //             var relC2x = 0;
-                    double len = 0.0;
-                    double relC1x = 0.0;
-                    double relC2x = 0.0;
-
-                    // Calculate overlap length and coordinates
-                    // JavaScript: if(GeometryUtil.almostEqual(min1, min2) && GeometryUtil.almostEqual(max1, max2))
-                    if (almostEqual(min1, min2_seg, tolerance) && almostEqual(max1, max2_seg, tolerance)) {
-                        // A is B (exact match)
-                        // JavaScript: len = max1-min1; relC1x = min1; relC2x = max1;
-                        len = max1 - min1;
-                        relC1x = min1;
-                        relC2x = max1;
-                    }
-                    // JavaScript: else if(min1 > min2 && max1 < max2)
-                    else if (min1 > min2_seg && max1 < max2_seg) {
-                        // A inside B
-                        // JavaScript: len = max1-min1; relC1x = min1; relC2x = max1;
-                        len = max1 - min1;
-                        relC1x = min1;
-                        relC2x = max1;
-                    }
-                    // JavaScript: else if(min2 > min1 && max2 < max1)
-                    else if (min2_seg > min1 && max2_seg < max1) {
-                        // B inside A
-                        // JavaScript: len = max2-min2; relC1x = min2; relC2x = max2;
-                        len = max2_seg - min2_seg;
-                        relC1x = min2_seg;
-                        relC2x = max2_seg;
-                    }
-                    else {
-                        // Partial overlap
-                        // JavaScript: len = Math.max(0, Math.min(max1, max2) - Math.max(min1, min2));
-                        //             relC1x = Math.min(max1, max2);
-                        //             relC2x = Math.max(min1, min2);
-                        len = std::max(0.0, std::min(max1, max2_seg) - std::max(min1, min2_seg));
-                        relC1x = std::min(max1, max2_seg);
-                        relC2x = std::max(min1, min2_seg);
-                    }
-
-                    // JavaScript: if(len*len > min2)
-                    if (len * len > min2) {
-                        // Add to total length
-                        // JavaScript: totalLength += len;
-                        result.totalLength += len;
-
-                        // Transform overlap coordinates back to world space
-                        // JavaScript: var relC1 = {x: relC1x * c2, y: relC1x * s2};
-                        //             var relC2 = {x: relC2x * c2, y: relC2x * s2};
-                        Point relC1(relC1x * c2, relC1x * s2);
-                        Point relC2(relC2x * c2, relC2x * s2);
-
-                        // JavaScript: var C1 = {x: relC1.x + A1.x, y: relC1.y + A1.y};
-                        //             var C2 = {x: relC2.x + A1.x, y: relC2.y + A1.y};
-                        Point C1(relC1.x + A1.x, relC1.y + A1.y);
-                        Point C2(relC2.x + A1.x, relC2.y + A1.y);
-
-                        // JavaScript: segments.push([C1, C2]);
-                        result.segments.push_back(std::make_pair(C1, C2));
-                    }
+                    mergeEdge(A1, c, s, c2, s2, rotA2x, B1, B2, min2, tolerance, result);
                 }
             }
 
@@ -221,6 +137,352 @@ MergeDetection::MergeResult MergeDetection::calculateMergedLengthInternal(
     return result;
 }
 
+MergeDetection::EdgeIndex::EdgeIndex()
+    : tolerance_(0.0)
+    , minX_(0.0)
+    , minY_(0.0)
+    , cellSize_(1.0)
+    , columns_(1)
+    , rows_(1)
+    , spanning_(DIRECTION_BUCKETS)
+{
+}
+
+MergeDetection::EdgeIndex::EdgeIndex(
+    const std::vector<Polygon>& placed,
+    double minLength,
+    double tolerance
+)
+    : EdgeIndex()
+{
+    tolerance_ = tolerance;
+    double min2 = minLength * minLength;
+
+    for (size_t j = 0; j < placed.size(); j++) {
+        const Polygon& B = placed[j];
+
+        if (B.points.size() > 1) {
+            for (size_t k = 0; k < B.points.size(); k++) {
+                const Point& B1 = B.points[k];
+                const Point& B2 = (k + 1 == B.points.size()) ? B.points[0] : B.points[k + 1];
+
+                if (!B1.exact || !B2.exact) {
+                    continue;
+                }
+
+                double Bx2 = (B2.x - B1.x) * (B2.x - B1.x);
+                double By2 = (B2.y - B1.y) * (B2.y - B1.y);
+
+                if (Bx2 + By2 < min2) {
+                    continue; // Edge too short
+                }
+
+                edges_.push_back(Edge{B1, B2, static_cast<uint32_t>(j)});
+            }
+        }
+
+        if (!B.children.empty()) {
+            holes_.emplace_back(static_cast<uint32_t>(j), B.children);
+        }
+    }
+
+    if (edges_.empty()) {
+        return;
+    }
+
+    // Grid over the edges with about two edges per cell
+    double maxX = edges_.front().start.x, maxY = edges_.front().start.y;
+    minX_ = maxX;
+    minY_ = maxY;
+    for (const auto& edge : edges_) {
+        minX_ = std::min<double>(minX_, std::min(edge.start.x, edge.end.x));
+        minY_ = std::min<double>(minY_, std::min(edge.start.y, edge.end.y));
+        maxX = std::max<double>(maxX, std::max(edge.start.x, edge.end.x));
+        maxY = std::max<double>(maxY, std::max(edge.start.y, edge.end.y));
+    }
+    const double cells = std::min(1024.0, std::max(1.0, edges_.size() / 2.0));
+    cellSize_ = std::max(std::sqrt((maxX - minX_) * (maxY - minY_) / cells),
+                         std::max(maxX - minX_, maxY - minY_) / 32.0);
+    cellSize_ = std::max(cellSize_, 1e-9);
+    columns_ = static_cast<int>((maxX - minX_) / cellSize_) + 1;
+    rows_ = static_cast<int>((maxY - minY_) / cellSize_) + 1;
+
+    const double bucketWidth = M_PI / DIRECTION_BUCKETS;
+    for (uint32_t id = 0; id < edges_.size(); id++) {
+        const Edge& edge = edges_[id];
+        const double dx = edge.end.x - edge.start.x;
+        const double dy = edge.end.y - edge.start.y;
+        const double length = std::sqrt(dx * dx + dy * dy);
+
+        // Directions of the lines this edge can lie on within tolerance
+        const double spread = std::min(1.0, 2.0 * tolerance_ * (1.0 + BOUND_SLACK) / length);
+        const double halfWidth = std::asin(spread) + BOUND_SLACK;
+        double direction = std::atan2(dy, dx);
+        if (direction < 0.0) {
+            direction += M_PI;
+        }
+        const int first = static_cast<int>(std::floor((direction - halfWidth) / bucketWidth));
+        const int last = static_cast<int>(std::floor((direction + halfWidth) / bucketWidth));
+        const int buckets = std::min(last - first + 1, DIRECTION_BUCKETS);
+
+        const int x0 = static_cast<int>((std::min(edge.start.x, edge.end.x) - minX_) / cellSize_);
+        const int x1 = static_cast<int>((std::max(edge.start.x, edge.end.x) - minX_) / cellSize_);
+        const int y0 = static_cast<int>((std::min(edge.start.y, edge.end.y) - minY_) / cellSize_);
+        const int y1 = static_cast<int>((std::max(edge.start.y, edge.end.y) - minY_) / cellSize_);
+        const bool spanning = static_cast<long long>(x1 - x0 + 1) * (y1 - y0 + 1) > MAX_EDGE_CELLS;
+
+        for (int b = 0; b < buckets; b++) {
+            const int bucket = ((first + b) % DIRECTION_BUCKETS + DIRECTION_BUCKETS) % DIRECTION_BUCKETS;
+            if (spanning) {
+                spanning_[bucket].push_back(id);
+                continue;
+            }
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    const uint64_t key = (static_cast<uint64_t>(bucket) * rows_ + y) * columns_ + x;
+                    cells_[key].push_back(id);
+                }
+            }
+        }
+    }
+}
+
+int MergeDetection::EdgeIndex::directionBucket(double angle) const {
+    if (angle < 0.0) {
+        angle += M_PI;
+    }
+    const int bucket = static_cast<int>(angle / (M_PI / DIRECTION_BUCKETS));
+    return std::min(std::max(bucket, 0), DIRECTION_BUCKETS - 1);
+}
+
+void MergeDetection::EdgeIndex::query(
+    const Point& A1,
+    const Point& A2,
+    double angle,
+    std::vector<uint32_t>& out
+) const {
+    out.clear();
+    if (edges_.empty()) {
+        return;
+    }
+
+    const int bucket = directionBucket(angle);
+    out.insert(out.end(), spanning_[bucket].begin(), spanning_[bucket].end());
+
+    // An overlapping edge within tolerance of the line meets A1-A2 grown by
+    // the tolerance
+    const double reach = tolerance_ * (1.0 + BOUND_SLACK) + BOUND_SLACK;
+    auto clampCell = [](double value, int count) {
+        return static_cast<int>(std::min(std::max(value, 0.0), static_cast<double>(count - 1)));
+    };
+    const int x0 = clampCell((std::min(A1.x, A2.x) - reach - minX_) / cellSize_, columns_);
+    const int x1 = clampCell((std::max(A1.x, A2.x) + reach - minX_) / cellSize_, columns_);
+    const int y0 = clampCell((std::min(A1.y, A2.y) - reach - minY_) / cellSize_, rows_);
+    const int y1 = clampCell((std::max(A1.y, A2.y) + reach - minY_) / cellSize_, rows_);
+    const bool inGrid = std::max(A1.x, A2.x) + reach >= minX_ && std::max(A1.y, A2.y) + reach >= minY_ &&
+                        std::min(A1.x, A2.x) - reach <= minX_ + columns_ * cellSize_ &&
+                        std::min(A1.y, A2.y) - reach <= minY_ + rows_ * cellSize_;
+    if (inGrid) {
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                auto cell = cells_.find((static_cast<uint64_t>(bucket) * rows_ + y) * columns_ + x);
+                if (cell != cells_.end()) {
+                    out.insert(out.end(), cell->second.begin(), cell->second.end());
+                }
+            }
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+MergeDetection::MergeResult MergeDetection::calculateMergedLength(
+    const EdgeIndex& placed,
+    const Polygon& newPart,
+    const Point& offset,
+    double minLength,
+    double tolerance
+) {
+    STAGE_SCOPE(MergeDetection);
+    // Same loop as calculateMergedLengthInternal, over the edges the index
+    // finds near each edge of the new part
+    std::vector<Point> p = newPart.points;
+    for (auto& point : p) {
+        point.x += offset.x;
+        point.y += offset.y;
+    }
+
+    double min2 = minLength * minLength;
+    MergeResult result;
+    result.totalLength = 0.0;
+
+    // Merges with the holes of a part do not depend on the edge of p;
+    // they are computed once and added per edge as before
+    std::vector<MergeResult> holeResults(placed.holes_.size());
+    std::vector<bool> holeDone(placed.holes_.size(), false);
+    auto addHoles = [&](size_t h) {
+        if (!holeDone[h]) {
+            holeResults[h] = calculateMergedLengthInternal(placed.holes_[h].second, p, minLength, tolerance);
+            holeDone[h] = true;
+        }
+        result.totalLength += holeResults[h].totalLength;
+        result.segments.insert(result.segments.end(),
+                              holeResults[h].segments.begin(),
+                              holeResults[h].segments.end());
+    };
+
+    std::vector<uint32_t> nearby;
+    for (size_t i = 0; i < p.size(); i++) {
+        const Point& A1 = p[i];
+        const Point& A2 = (i + 1 == p.size()) ? p[0] : p[i + 1];
+
+        if (!A1.exact || !A2.exact) {
+            continue;
+        }
+
+        double Ax2 = (A2.x - A1.x) * (A2.x - A1.x);
+        double Ay2 = (A2.y - A1.y) * (A2.y - A1.y);
+
+        if (Ax2 + Ay2 < min2) {
+            continue; // Edge too short
+        }
+
+        double angle = std::atan2(A2.y - A1.y, A2.x - A1.x);
+        double c = std::cos(-angle);
+        double s = std::sin(-angle);
+        double c2 = std::cos(angle);
+        double s2 = std::sin(angle);
+
+        Point relA2(A2.x - A1.x, A2.y - A1.y);
+        double rotA2x = relA2.x * c - relA2.y * s;
+
+        // Per part: its edges, then its holes
+        placed.query(A1, A2, angle, nearby);
+        size_t h = 0;
+        for (uint32_t id : nearby) {
+            const EdgeIndex::Edge& edge = placed.edges_[id];
+            for (; h < placed.holes_.size() && placed.holes_[h].first < edge.part; h++) {
+                addHoles(h);
+            }
+            mergeEdge(A1, c, s, c2, s2, rotA2x, edge.start, edge.end, min2, tolerance, result);
+        }
+        for (; h < placed.holes_.size(); h++) {
+            addHoles(h);
+        }
+    }
+
+    return result;
+}
+
+void MergeDetection::mergeEdge(
+    const Point& A1, double c, double s, double c2, double s2, double rotA2x,
+    const Point& B1, const Point& B2,
+    double min2, double tolerance,
+    MergeResult& result
+) {
+    // JavaScript: var relB1 = {x: B1.x - A1.x, y: B1.y - A1.y};
+    //             var relB2 = {x: B2.x - A1.x, y: B2.y - A1.y};
+    Point relB1(B1.x - A1.x, B1.y - A1.y);
+    Point relB2(B2.x - A1.x, B2.y - A1.y);
+
+    // JavaScript: var rotB1 = {x: relB1.x * c - relB1.y * s, y: relB1.x * s + relB1.y * c};
+    //             var rotB2 = {x: relB2.x * c - relB2.y * s, y: relB2.x * s + relB2.y * c};
+    Point rotB1(
+        relB1.x * c - relB1.y * s,
+        relB1.x * s + relB1.y * c
+    );
+    Point rotB2(
+        relB2.x * c - relB2.y * s,
+        relB2.x * s + relB2.y * c
+    );
+
+    // JavaScript: if(!GeometryUtil.almostEqual(rotB1.y, 0, tolerance) ||
+    //                !GeometryUtil.almostEqual(rotB2.y, 0, tolerance)) { continue; }
+    // Check if edge B is aligned with edge A (both y-coordinates should be ~0 after rotation)
+    if (!almostEqual(rotB1.y, 0.0, tolerance) || !almostEqual(rotB2.y, 0.0, tolerance)) {
+        return; // Not aligned
+    }
+
+    // JavaScript: var min1 = Math.min(0, rotA2x);
+    //             var max1 = Math.max(0, rotA2x);
+    //             var min2 = Math.min(rotB1.x, rotB2.x);
+    //             var max2 = Math.max(rotB1.x, rotB2.x);
+    double min1 = std::min(0.0, rotA2x);
+    double max1 = std::max(0.0, rotA2x);
+    double min2_seg = std::min(rotB1.x, rotB2.x);
+    double max2_seg = std::max(rotB1.x, rotB2.x);
+
+    // JavaScript: if(min2 >= max1 || max2 <= min1) { continue; }
+    // Check if segments overlap
+    if (min2_seg >= max1 || max2_seg <= min1) {
+        return; // No overlap
+    }
+
+    // JavaScript: var len = 0;
+    //             var relC1x = 0;
+    //             var relC2x = 0;
+    double len = 0.0;
+    double relC1x = 0.0;
+    double relC2x = 0.0;
+
+    // Calculate overlap length and coordinates
+    // JavaScript: if(GeometryUtil.almostEqual(min1, min2) && GeometryUtil.almostEqual(max1, max2))
+    if (almostEqual(min1, min2_seg, tolerance) && almostEqual(max1, max2_seg, tolerance)) {
+        // A is B (exact match)
+        // JavaScript: len = max1-min1; relC1x = min1; relC2x = max1;
+        len = max1 - min1;
+        relC1x = min1;
+        relC2x = max1;
+    }
+    // JavaScript: else if(min1 > min2 && max1 < max2)
+    else if (min1 > min2_seg && max1 < max2_seg) {
+        // A inside B
+        // JavaScript: len = max1-min1; relC1x = min1; relC2x = max1;
+        len = max1 - min1;
+        relC1x = min1;
+        relC2x = max1;
+    }
+    // JavaScript: else if(min2 > min1 && max2 < max1)
+    else if (min2_seg > min1 && max2_seg < max1) {
+        // B inside A
+        // JavaScript: len = max2-min2; relC1x = min2; relC2x = max2;
+        len = max2_seg - min2_seg;
+        relC1x = min2_seg;
+        relC2x = max2_seg;
+    }
+    else {
+        // Partial overlap
+        // JavaScript: len = Math.max(0, Math.min(max1, max2) - Math.max(min1, min2));
+        //             relC1x = Math.min(max1, max2);
+        //             relC2x = Math.max(min1, min2);
+        len = std::max(0.0, std::min(max1, max2_seg) - std::max(min1, min2_seg));
+        relC1x = std::min(max1, max2_seg);
+        relC2x = std::max(min1, min2_seg);
+    }
+
+    // JavaScript: if(len*len > min2)
+    if (len * len > min2) {
+        // Add to total length
+        // JavaScript: totalLength += len;
+        result.totalLength += len;
+
+        // Transform overlap coordinates back to world space
+        // JavaScript: var relC1 = {x: relC1x * c2, y: relC1x * s2};
+        //             var relC2 = {x: relC2x * c2, y: relC2x * s2};
+        Point relC1(relC1x * c2, relC1x * s2);
+        Point relC2(relC2x * c2, relC2x * s2);
+
+        // JavaScript: var C1 = {x: relC1.x + A1.x, y: relC1.y + A1.y};
+        //             var C2 = {x: relC2.x + A1.x, y: relC2.y + A1.y};
+        Point C1(relC1.x + A1.x, relC1.y + A1.y);
+        Point C2(relC2.x + A1.x, relC2.y + A1.y);
+
+        // JavaScript: segments.push([C1, C2]);
+        result.segments.push_back(std::make_pair(C1, C2));
+    }
+}
+
 bool MergeDetection::almostEqual(double a, double b, double tolerance) {
     return std::abs(a - b) < tolerance;
 }
@@ -0,0 +1,145 @@
+#include "../../include/deepnest/placement/PlacementJob.h"
+#include "../../include/deepnest/placement/ShapeCache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace deepnest {
+
+PlacementJob::PlacementJob(std::vector<Polygon> sheets,
+                           const std::vector<std::shared_ptr<Polygon>>& parts,
+                           int rotations,
+                           double clipperScale,
+                           bool snapToGrid,
+                           const ParallelFor& parallelFor,
+                           ShapeCache* turned)
+    : sheets_(std::move(sheets))
+    , rotations_(std::max(rotations, 1))
+{
+    if (snapToGrid) {
+        for (auto& sheet : sheets_) {
+            sheet.snapToGrid(clipperScale);
+            sheet.updateCoordinates();
+            if (!sheet.children.empty()) {
+                sheet.updateRings();
+            }
+        }
+    }
+
+    int maxId = -1;
+    for (const auto& part : parts) {
+        maxId = std::max(maxId, part->id);
+    }
+    fullBase_.assign(static_cast<size_t>(maxId + 1), npos);
+    coarseBase_.assign(static_cast<size_t>(maxId + 1), npos);
+
+    // Outline each variant is turned from, rotations_ consecutive slots per outline
+    std::vector<const Polygon*> outlines;
+    auto addOutline = [this, &outlines](const Polygon& outline) {
+        const size_t base = outlines.size();
+        outlines.insert(outlines.end(), static_cast<size_t>(rotations_), &outline);
+        return base;
+    };
+
+    for (const auto& part : parts) {
+        if (part->id < 0) {
+            continue;
+        }
+        fullBase_[part->id] = addOutline(*part);
+        if (part->coarse) {
+            coarseBase_[part->id] = addOutline(*part->coarse);
+        }
+    }
+
+    // One trigonometric evaluation per angle, as Transformation::rotate()
+    // makes it, shared by every outline
+    std::vector<double> cosines(rotations_);
+    std::vector<double> sines(rotations_);
+    for (int k = 0; k < rotations_; ++k) {
+        const double rad = k * (360.0 / rotations_) * M_PI / 180.0;
+        cosines[k] = std::cos(rad);
+        sines[k] = std::sin(rad);
+    }
+
+    variants_.resize(outlines.size());
+    auto turn = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const int k = static_cast<int>(i % rotations_);
+            const Polygon& outline = *outlines[i];
+            const double angle = k * (360.0 / rotations_);
+            const bool cached = turned && outline.fingerprint != 0;
+            if (cached && turned->findTurned(outline.fingerprint, angle, clipperScale, snapToGrid, variants_[i])) {
+                variants_[i].id = outline.id;
+                variants_[i].source = outline.source;
+                continue;
+            }
+
+            Polygon part = outline;
+            part.rotation = angle;
+            variants_[i] = rotated(part, cosines[k], sines[k]);
+            if (snapToGrid) {
+                variants_[i].snapToGrid(clipperScale);
+            } else if (!variants_[i].scaledPathAt(clipperScale)) {
+                variants_[i].updateScaledPath(clipperScale);
+            }
+            if (!variants_[i].currentCoordinates()) {
+                variants_[i].updateCoordinates();
+            }
+            if (!variants_[i].children.empty() && !variants_[i].currentRings()) {
+                variants_[i].updateRings();
+            }
+            if (cached) {
+                turned->insertTurned(outline.fingerprint, angle, clipperScale, snapToGrid, variants_[i]);
+            }
+        }
+    };
+    if (parallelFor) {
+        parallelFor(variants_.size(), turn);
+    } else {
+        turn(0, variants_.size());
+    }
+}
+
+size_t PlacementJob::memoryBytes() const {
+    size_t bytes = sizeof(PlacementJob)
+                 + (fullBase_.capacity() + coarseBase_.capacity()) * sizeof(size_t);
+    for (const auto& sheet : sheets_) {
+        bytes += sheet.memoryBytes();
+    }
+    for (const auto& variant : variants_) {
+        bytes += variant.memoryBytes();
+    }
+    return bytes;
+}
+
+size_t PlacementJob::variantIndex(int partId, double rotation, bool coarse) const {
+    if (partId < 0 || static_cast<size_t>(partId) >= fullBase_.size()) {
+        return npos;
+    }
+    const size_t base = coarse && coarseBase_[partId] != npos ? coarseBase_[partId] : fullBase_[partId];
+    if (base == npos) {
+        return npos;
+    }
+
+    // Only the exact angles the genetic algorithm generates are stored
+    const double step = 360.0 / rotations_;
+    const long k = std::lround(rotation / step);
+    if (k < 0 || k >= rotations_ || k * step != rotation) {
+        return npos;
+    }
+    return base + static_cast<size_t>(k);
+}
+
+Polygon PlacementJob::rotated(const Polygon& part) {
+    const double rad = part.rotation * M_PI / 180.0;
+    return rotated(part, std::cos(rad), std::sin(rad));
+}
+
+Polygon PlacementJob::rotated(const Polygon& part, double cosA, double sinA) {
+    Polygon result = part.rotate(part.rotation, cosA, sinA);
+    result.rotation = part.rotation;
+    result.source = part.source;
+    result.id = part.id;
+    return result;
+}
+
+} // namespace deepnest
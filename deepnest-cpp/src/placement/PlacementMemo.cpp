@@ -0,0 +1,215 @@
+#include "../../include/deepnest/placement/PlacementMemo.h"
+#include "../../include/deepnest/nfp/NFPCache.h"
+#include <algorithm>
+
+namespace deepnest {
+
+namespace {
+
+// Approximate per-snapshot overhead of the trie node and control block
+constexpr size_t NODE_OVERHEAD_BYTES = sizeof(PlacementSnapshot) + 128;
+
+// The memo is trimmed to this fraction of its budget so that eviction
+// runs in batches instead of on every insert
+constexpr double EVICTION_TARGET_RATIO = 0.75;
+
+// Snapshots taken per individual
+constexpr size_t SNAPSHOTS_PER_INDIVIDUAL = 16;
+
+size_t pathsBytes(const Clipper2Lib::Paths64& paths) {
+    size_t bytes = paths.capacity() * sizeof(Clipper2Lib::Path64);
+    for (const auto& path : paths) {
+        bytes += path.capacity() * sizeof(Clipper2Lib::Point64);
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
+PlacementMemo::PlacementMemo(size_t maxBytes)
+    : maxBytes_(maxBytes)
+    , bytes_(0)
+    , snapshots_(0)
+    , tick_(0)
+    , lookups_(0)
+    , hits_(0)
+    , resumedGenes_(0)
+{}
+
+PlacementMemo::SnapshotHandle PlacementMemo::find(uint64_t sheet, const std::vector<Gene>& genes) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    lookups_++;
+
+    auto root = roots_.find(sheet);
+    if (root == roots_.end()) {
+        return nullptr;
+    }
+
+    Node* deepest = nullptr;
+    Node* node = &root->second;
+    for (const Gene& gene : genes) {
+        auto child = node->children.find(gene);
+        if (child == node->children.end()) {
+            break;
+        }
+        node = child->second.get();
+        if (node->snapshot) {
+            deepest = node;
+        }
+    }
+
+    if (!deepest) {
+        return nullptr;
+    }
+
+    deepest->lastUse = ++tick_;
+    hits_++;
+    resumedGenes_ += deepest->snapshot->genes;
+    return deepest->snapshot;
+}
+
+bool PlacementMemo::contains(uint64_t sheet, const std::vector<Gene>& genes, size_t length) const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    auto root = roots_.find(sheet);
+    if (root == roots_.end()) {
+        return false;
+    }
+
+    const Node* node = &root->second;
+    for (size_t i = 0; i < length && i < genes.size(); i++) {
+        auto child = node->children.find(genes[i]);
+        if (child == node->children.end()) {
+            return false;
+        }
+        node = child->second.get();
+    }
+    return node->snapshot != nullptr;
+}
+
+void PlacementMemo::insert(uint64_t sheet, const std::vector<Gene>& genes, SnapshotHandle snapshot) {
+    if (!snapshot || snapshot->genes == 0 || snapshot->genes > genes.size()) {
+        return;
+    }
+
+    const size_t bytes = estimateBytes(*snapshot);
+    if (bytes > maxBytes_) {
+        return;
+    }
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    Node* node = &roots_[sheet];
+    for (size_t i = 0; i < snapshot->genes; i++) {
+        std::unique_ptr<Node>& child = node->children[genes[i]];
+        if (!child) {
+            child.reset(new Node());
+        }
+        node = child.get();
+    }
+
+    if (node->snapshot) {
+        return;
+    }
+
+    node->snapshot = std::move(snapshot);
+    node->bytes = bytes;
+    node->lastUse = ++tick_;
+    bytes_ += bytes;
+    snapshots_++;
+
+    if (bytes_ > maxBytes_) {
+        evict();
+    }
+}
+
+size_t PlacementMemo::snapshotStride(size_t genes) {
+    return std::max<size_t>(1, genes / SNAPSHOTS_PER_INDIVIDUAL);
+}
+
+size_t PlacementMemo::estimateBytes(const PlacementSnapshot& snapshot) {
+    size_t bytes = NODE_OVERHEAD_BYTES
+                 + NFPCache::estimateBytes(snapshot.placed)
+                 + snapshot.skipped.capacity() * sizeof(size_t)
+                 + snapshot.placements.capacity() * sizeof(PlacementWorker::Placement)
+                 + pathsBytes(snapshot.placedPaths)
+                 + snapshot.raster.memoryBytes();
+    bytes += snapshot.retried.capacity() * sizeof(std::pair<size_t, Polygon>);
+    for (const auto& entry : snapshot.retried) {
+        bytes += entry.second.points.capacity() * sizeof(Point);
+    }
+    for (const auto& region : snapshot.forbidden) {
+        bytes += sizeof(region) + pathsBytes(region.second.paths);
+    }
+    return bytes;
+}
+
+PlacementMemo::Statistics PlacementMemo::statistics() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    Statistics stats;
+    stats.lookups = lookups_;
+    stats.hits = hits_;
+    stats.resumedGenes = resumedGenes_;
+    stats.snapshots = snapshots_;
+    stats.bytes = bytes_;
+    return stats;
+}
+
+void PlacementMemo::clear() {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    roots_.clear();
+    bytes_ = 0;
+    snapshots_ = 0;
+}
+
+void PlacementMemo::evict() {
+    std::vector<Node*> held;
+    for (auto& root : roots_) {
+        collect(root.second, held);
+    }
+    std::sort(held.begin(), held.end(),
+              [](const Node* a, const Node* b) { return a->lastUse < b->lastUse; });
+
+    const size_t target = static_cast<size_t>(maxBytes_ * EVICTION_TARGET_RATIO);
+    for (Node* node : held) {
+        if (bytes_ <= target) {
+            break;
+        }
+        bytes_ -= node->bytes;
+        snapshots_--;
+        node->snapshot.reset();
+        node->bytes = 0;
+    }
+
+    for (auto it = roots_.begin(); it != roots_.end(); ) {
+        if (prune(it->second)) {
+            it = roots_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PlacementMemo::collect(Node& node, std::vector<Node*>& out) {
+    if (node.snapshot) {
+        out.push_back(&node);
+    }
+    for (auto& child : node.children) {
+        collect(*child.second, out);
+    }
+}
+
+bool PlacementMemo::prune(Node& node) {
+    for (auto it = node.children.begin(); it != node.children.end(); ) {
+        if (prune(*it->second)) {
+            it = node.children.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return !node.snapshot && node.children.empty();
+}
+
+} // namespace deepnest
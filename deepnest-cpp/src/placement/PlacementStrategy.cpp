@@ -3,11 +3,167 @@
 #include "../../include/deepnest/placement/MergeDetection.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
 #include "../../include/deepnest/geometry/ConvexHull.h"
+#include "../../include/deepnest/parallel/ParallelProcessor.h"
+#include "../../include/deepnest/StageTimes.h"
+#include "../../include/deepnest/Trace.h"
 #include <limits>
 #include <algorithm>
+#include <cmath>
+#include <functional>
 
 namespace deepnest {
 
+namespace {
+
+// Fewest candidates worth handing to another thread
+constexpr size_t MIN_CANDIDATES_PER_CHUNK = 256;
+
+// Per-candidate metric kernels, built once per part and inlined into the
+// scoring loop. calculateMetric() goes through the same kernels.
+
+// Extent of the placed bounds together with the part's bounds at position,
+// with the corner arithmetic BoundingBox::fromPoints() sees for the eight
+// corners, so results are bit-identical
+inline void combinedExtent(
+    const BoundingBox& all,
+    const BoundingBox& part,
+    const Point& position,
+    double& width,
+    double& height
+) {
+    const double allRight = all.x + all.width;
+    const double allBottom = all.y + all.height;
+    const double partLeft = part.x + position.x;
+    const double partRight = part.x + part.width + position.x;
+    const double partTop = part.y + position.y;
+    const double partBottom = part.y + part.height + position.y;
+
+    const double minX = std::min(std::min(all.x, allRight), std::min(partLeft, partRight));
+    const double maxX = std::max(std::max(all.x, allRight), std::max(partLeft, partRight));
+    const double minY = std::min(std::min(all.y, allBottom), std::min(partTop, partBottom));
+    const double maxY = std::max(std::max(all.y, allBottom), std::max(partTop, partBottom));
+    width = maxX - minX;
+    height = maxY - minY;
+}
+
+struct GravityKernel {
+    const PlacementContext& context;
+
+    double operator()(const Point& position) const {
+        // No placed parts yet (placing first part), or all were invalid:
+        // only the new part contributes to bounds
+        const BoundingBox& partBounds = context.partBounds;
+        if (!context.hasPlacedPoints) {
+            return (partBounds.width + position.x) * 2.0 + (partBounds.height + position.y);
+        }
+
+        // Gravity metric: weight width more to compress in gravity direction
+        // JavaScript: area = rectbounds.width*2 + rectbounds.height;
+        double width, height;
+        combinedExtent(context.placedBounds, partBounds, position, width, height);
+        return width * 2.0 + height;
+    }
+};
+
+struct BoundingBoxKernel {
+    const PlacementContext& context;
+
+    double operator()(const Point& position) const {
+        // No placed parts yet (placing first part), or all were invalid
+        const BoundingBox& partBounds = context.partBounds;
+        if (!context.hasPlacedPoints) {
+            return (partBounds.width + position.x) * (partBounds.height + position.y);
+        }
+
+        // Bounding box metric: normal area
+        // JavaScript: area = rectbounds.width * rectbounds.height;
+        double width, height;
+        combinedExtent(context.placedBounds, partBounds, position, width, height);
+        return width * height;
+    }
+};
+
+// The hull of the placed hull and the part at a position is the hull of
+// the placed hull and the part's own hull there, so both hulls are taken
+// once per part and each candidate only merges them
+class ConvexHullKernel {
+public:
+    ConvexHullKernel(const Polygon& part, const PlacementContext& context)
+        : hasPlacedPoints_(context.hasPlacedPoints)
+    {
+        if (!hasPlacedPoints_) {
+            partArea_ = std::abs(part.area());
+            return;
+        }
+        placedHull_ = context.placedHull;
+        partHull_ = ConvexHull::computeHull(part.points);
+        ConvexHull::sortForMerge(placedHull_);
+        ConvexHull::sortForMerge(partHull_);
+    }
+
+    double operator()(const Point& position) const {
+        // No placed parts yet (placing first part), or all were invalid:
+        // only the new part contributes to area
+        if (!hasPlacedPoints_) {
+            return partArea_;
+        }
+
+        // JavaScript: localpoints = getHull(allpoints + part at position);
+        //             area = -GeometryUtil.polygonArea(localpoints);
+        return ConvexHull::mergedHullArea(placedHull_, partHull_, position);
+    }
+
+private:
+    bool hasPlacedPoints_;
+    double partArea_ = 0.0;
+    std::vector<Point> placedHull_;  // Sorted for merging
+    std::vector<Point> partHull_;    // Sorted for merging, part coordinates
+};
+
+// Gravity tie-break value of a position; lower wins
+template <GravityDirection Direction>
+inline double gravityTieBreak(const Point& position) {
+    if constexpr (Direction == GravityDirection::RIGHT) {
+        return -position.x;               // Prefer rightmost (maximize x)
+    } else if constexpr (Direction == GravityDirection::BOTTOM) {
+        return position.y;                // Prefer bottom (minimize y)
+    } else if constexpr (Direction == GravityDirection::TOP) {
+        return -position.y;               // Prefer top (maximize y)
+    } else if constexpr (Direction == GravityDirection::BOTTOM_LEFT) {
+        return position.x + position.y;   // Prefer bottom-left (minimize x+y)
+    } else {
+        return position.x;                // Prefer leftmost (minimize x)
+    }
+}
+
+// Index of the gravity choice among non-empty scored candidates
+template <GravityDirection Direction>
+size_t selectGravity(const std::vector<Point>& candidatePositions, const std::vector<double>& metrics) {
+    // JavaScript placementworker.js:252:
+    // if(minarea === null || area < minarea ||
+    //    (GeometryUtil.almostEqual(minarea, area) && (minx === null || shiftvector.x < minx)))
+    const double TOLERANCE = 0.001;  // almostEqual tolerance
+
+    size_t best = 0;
+    double minMetric = metrics[0];
+    double tieBreakValue = gravityTieBreak<Direction>(candidatePositions[0]);
+    for (size_t k = 1; k < candidatePositions.size(); ++k) {
+        const double metric = metrics[k];
+        const double currentTieBreak = gravityTieBreak<Direction>(candidatePositions[k]);
+
+        // Clearly better metric, or equal within tolerance and better tie-break
+        if (metric < minMetric - TOLERANCE ||
+            (std::abs(metric - minMetric) < TOLERANCE && currentTieBreak < tieBreakValue)) {
+            best = k;
+            minMetric = metric;
+            tieBreakValue = currentTieBreak;
+        }
+    }
+    return best;
+}
+
+} // anonymous namespace
+
 // ==================== PlacementStrategy Base ====================
 
 std::unique_ptr<PlacementStrategy> PlacementStrategy::create(Type type) {
@@ -18,6 +174,10 @@ std::unique_ptr<PlacementStrategy> PlacementStrategy::create(Type type) {
             return std::make_unique<BoundingBoxPlacement>();
         case Type::CONVEX_HULL:
             return std::make_unique<ConvexHullPlacement>();
+        case Type::SKYLINE:
+            return std::make_unique<SkylinePlacement>();
+        case Type::RASTER:
+            return std::make_unique<RasterPlacement>();
         default:
             return std::make_unique<GravityPlacement>(); // Default to gravity
     }
@@ -30,158 +190,28 @@ std::unique_ptr<PlacementStrategy> PlacementStrategy::create(const std::string&
         return std::make_unique<BoundingBoxPlacement>();
     } else if (typeName == "convexhull" || typeName == "convex_hull" || typeName == "hull") {
         return std::make_unique<ConvexHullPlacement>();
+    } else if (typeName == "skyline") {
+        return std::make_unique<SkylinePlacement>();
+    } else if (typeName == "raster") {
+        return std::make_unique<RasterPlacement>();
     } else {
         return std::make_unique<GravityPlacement>(); // Default
     }
 }
 
-// ==================== GravityPlacement ====================
-
-BestPositionResult GravityPlacement::findBestPosition(
-    const Polygon& part,
-    const std::vector<PlacedPart>& placed,
-    const std::vector<Point>& candidatePositions,
-    const DeepNestConfig& config
-) const {
-
-    if (candidatePositions.empty()) {
-        return BestPositionResult(); // No valid positions
-    }
-
-    double minMetric = std::numeric_limits<double>::max();
-    Point bestPosition;
-    double bestMergedLength = 0.0;
-    bool foundValid = false;
-    
-    // Tie-breaking values based on gravity direction
-    double tieBreakValue = std::numeric_limits<double>::max();
-
-    // Evaluate each candidate position
-    // JavaScript: for(j=0; j<finalNfp.length; j++) { for(k=0; k<nf.length; k++)
-    for (const auto& position : candidatePositions) {
-        // Calculate base area metric
-        double metric = calculateMetric(part, position, placed);
-
-        // LINE MERGE INTEGRATION: Calculate merged line bonus
-        // JavaScript background.js:1094: area -= merged.totalLength * config.timeRatio
-        double mergedLength = 0.0;
-        if (config.mergeLines) {
-            // Create test part at this position
-            Polygon testPart = part;
-            for (auto& p : testPart.points) {
-                p.x += position.x;
-                p.y += position.y;
-            }
-            // Also translate children (holes)
-            for (auto& child : testPart.children) {
-                for (auto& p : child.points) {
-                    p.x += position.x;
-                    p.y += position.y;
-                }
-            }
-
-            // Convert PlacedPart vector to Polygon vector for MergeDetection
-            std::vector<Polygon> placedPolygons;
-            for (const auto& placedPart : placed) {
-                Polygon poly = placedPart.polygon;
-                // Apply placement transformation
-                for (auto& p : poly.points) {
-                    p.x += placedPart.position.x;
-                    p.y += placedPart.position.y;
-                }
-                for (auto& child : poly.children) {
-                    for (auto& p : child.points) {
-                        p.x += placedPart.position.x;
-                        p.y += placedPart.position.y;
-                    }
-                }
-                placedPolygons.push_back(poly);
-            }
-
-            // Calculate merged lines
-            double minLength = 0.1; // Minimum edge length to consider
-            double tolerance = 0.1 * config.curveTolerance;
-            auto mergeResult = MergeDetection::calculateMergedLength(
-                placedPolygons, testPart, minLength, tolerance
-            );
-            mergedLength = mergeResult.totalLength;
-
-            // Apply line merge bonus (subtract from metric - lower is better)
-            metric -= mergedLength * config.timeRatio;
-        }
-
-        // Calculate tie-break value based on gravity direction
-        double currentTieBreak;
-        switch (config.gravityDirection) {
-            case GravityDirection::LEFT:
-                currentTieBreak = position.x;  // Prefer leftmost (minimize x)
-                break;
-            case GravityDirection::RIGHT:
-                currentTieBreak = -position.x;  // Prefer rightmost (maximize x)
-                break;
-            case GravityDirection::BOTTOM:
-                currentTieBreak = position.y;  // Prefer bottom (minimize y)
-                break;
-            case GravityDirection::TOP:
-                currentTieBreak = -position.y;  // Prefer top (maximize y)
-                break;
-            case GravityDirection::BOTTOM_LEFT:
-                currentTieBreak = position.x + position.y;  // Prefer bottom-left (minimize x+y)
-                break;
-            default:
-                currentTieBreak = position.x;  // Default to LEFT
-                break;
-        }
-
-        // Selection logic with tie-breaking
-        // JavaScript placementworker.js:252:
-        // if(minarea === null || area < minarea || 
-        //    (GeometryUtil.almostEqual(minarea, area) && (minx === null || shiftvector.x < minx)))
-        const double TOLERANCE = 0.001;  // almostEqual tolerance
-        
-        bool selectThis = false;
-        if (!foundValid) {
-            selectThis = true;
-        } else if (metric < minMetric - TOLERANCE) {
-            // Clearly better metric
-            selectThis = true;
-        } else if (std::abs(metric - minMetric) < TOLERANCE && currentTieBreak < tieBreakValue) {
-            // Metrics are equal (within tolerance), use tie-breaker
-            selectThis = true;
-        }
-
-        if (selectThis) {
-            minMetric = metric;
-            bestPosition = position;
-            bestMergedLength = mergedLength;
-            tieBreakValue = currentTieBreak;
-            foundValid = true;
-        }
-    }
-
-    // CRITICAL FIX 1.3: Return area metric (minarea component for fitness)
-    // JavaScript background.js:1142: fitness += (minwidth/binarea) + minarea
-    // LINE MERGE: Also return merged length for logging/debugging
-    if (foundValid) {
-        return BestPositionResult(bestPosition, minMetric, bestMergedLength);
-    } else {
-        return BestPositionResult();
-    }
+void PlacementStrategy::setParallelScoring(ParallelProcessor* processor, size_t threshold) {
+    scoringProcessor_ = processor;
+    parallelScoringThreshold_ = threshold;
 }
 
-double GravityPlacement::calculateMetric(
+PlacementContext PlacementContext::build(
     const Polygon& part,
-    const Point& position,
-    const std::vector<PlacedPart>& placed
-) const {
-
-    // Handle edge case: no placed parts yet (placing first part)
-    if (placed.empty()) {
-        // Only the new part contributes to bounds
-        BoundingBox partBounds = part.bounds();
-        double metric = (partBounds.width + position.x) * 2.0 + (partBounds.height + position.y);
-        return metric;
-    }
+    const std::vector<PlacedPart>& placed,
+    const DeepNestConfig& config,
+    bool withHull
+) {
+    PlacementContext context;
+    context.partBounds = part.bounds();
 
     // Collect all points from placed parts
     // JavaScript: for(m=0; m<placed.length; m++) { for(n=0; n<placed[m].length; n++)
@@ -207,44 +237,168 @@ double GravityPlacement::calculateMetric(
         }
     }
 
-    // Safety check: if all polygons were invalid, treat as empty
-    if (allPoints.empty()) {
-        BoundingBox partBounds = part.bounds();
-        double metric = (partBounds.width + position.x) * 2.0 + (partBounds.height + position.y);
-        return metric;
+    if (!allPoints.empty()) {
+        // JavaScript: allbounds = GeometryUtil.getPolygonBounds(allpoints);
+        context.hasPlacedPoints = true;
+        context.placedBounds = BoundingBox::fromPoints(allPoints);
+
+        if (withHull) {
+            // JavaScript: allpoints = getHull(allpoints);
+            context.placedHull = ConvexHull::computeHull(allPoints);
+        }
+    }
+
+    // LINE MERGE INTEGRATION: placed parts in world coordinates, indexed by
+    // their mergeable edges once for all candidates
+    if (config.mergeLines) {
+        std::vector<Polygon> placedPolygons;
+        placedPolygons.reserve(placed.size());
+        for (const auto& placedPart : placed) {
+            Polygon poly = placedPart.polygon;
+            // Apply placement transformation
+            for (auto& p : poly.points) {
+                p.x += placedPart.position.x;
+                p.y += placedPart.position.y;
+            }
+            poly.coordinates.reset();
+            poly.rings.reset();
+            for (auto& child : poly.children) {
+                for (auto& p : child.points) {
+                    p.x += placedPart.position.x;
+                    p.y += placedPart.position.y;
+                }
+            }
+            placedPolygons.push_back(std::move(poly));
+        }
+
+        double minLength = 0.1; // Minimum edge length to consider
+        double tolerance = 0.1 * config.curveTolerance;
+        context.mergeIndex = MergeDetection::EdgeIndex(placedPolygons, minLength, tolerance);
+    }
+
+    return context;
+}
+
+double PlacementStrategy::mergedLength(
+    const Polygon& part,
+    const Point& position,
+    const PlacementContext& context,
+    const DeepNestConfig& config
+) {
+    if (!config.mergeLines) {
+        return 0.0;
     }
 
-    // Get bounds of all placed parts
-    // JavaScript: allbounds = GeometryUtil.getPolygonBounds(allpoints);
-    BoundingBox allBounds = BoundingBox::fromPoints(allPoints);
-
-    // Get bounds of new part
-    // JavaScript: partbounds = GeometryUtil.getPolygonBounds(partpoints);
-    BoundingBox partBounds = part.bounds();
-
-    // Calculate combined bounding box
-    // JavaScript: var rectbounds = GeometryUtil.getPolygonBounds([...])
-    std::vector<Point> combinedPoints = {
-        // All bounds points
-        Point(allBounds.x, allBounds.y),
-        Point(allBounds.x + allBounds.width, allBounds.y),
-        Point(allBounds.x + allBounds.width, allBounds.y + allBounds.height),
-        Point(allBounds.x, allBounds.y + allBounds.height),
-
-        // Part bounds points (translated to position)
-        Point(partBounds.x + position.x, partBounds.y + position.y),
-        Point(partBounds.x + partBounds.width + position.x, partBounds.y + position.y),
-        Point(partBounds.x + partBounds.width + position.x, partBounds.y + partBounds.height + position.y),
-        Point(partBounds.x + position.x, partBounds.y + partBounds.height + position.y)
+    double minLength = 0.1; // Minimum edge length to consider
+    double tolerance = 0.1 * config.curveTolerance;
+    auto mergeResult = MergeDetection::calculateMergedLength(
+        context.mergeIndex, part, position, minLength, tolerance
+    );
+    return mergeResult.totalLength;
+}
+
+template <typename Metric>
+void PlacementStrategy::scoreCandidates(
+    const Metric& metric,
+    const Polygon& part,
+    const std::vector<Point>& candidatePositions,
+    const PlacementContext& context,
+    const DeepNestConfig& config,
+    std::vector<double>& metrics,
+    std::vector<double>& merged
+) const {
+    metrics.resize(candidatePositions.size());
+    merged.resize(candidatePositions.size());
+
+    const Point* positions = candidatePositions.data();
+    double* metricOut = metrics.data();
+    double* mergedOut = merged.data();
+
+    auto run = [&](const std::function<void(size_t, size_t)>& score) {
+        if (scoringProcessor_ && parallelScoringThreshold_ > 0 &&
+            candidatePositions.size() >= parallelScoringThreshold_) {
+            scoringProcessor_->parallelFor(candidatePositions.size(), MIN_CANDIDATES_PER_CHUNK, score);
+        } else {
+            score(0, candidatePositions.size());
+        }
     };
 
-    BoundingBox combinedBounds = BoundingBox::fromPoints(combinedPoints);
+    if (config.mergeLines) {
+        // LINE MERGE INTEGRATION: Calculate merged line bonus
+        // JavaScript background.js:1094: area -= merged.totalLength * config.timeRatio
+        run([&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                mergedOut[k] = mergedLength(part, positions[k], context, config);
+                metricOut[k] = metric(positions[k]) - mergedOut[k] * config.timeRatio;
+            }
+        });
+    } else {
+        run([&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                metricOut[k] = metric(positions[k]);
+            }
+            std::fill(mergedOut + begin, mergedOut + end, 0.0);
+        });
+    }
+}
+
+// ==================== GravityPlacement ====================
 
-    // Gravity metric: weight width more to compress in gravity direction
-    // JavaScript: area = rectbounds.width*2 + rectbounds.height;
-    double metric = combinedBounds.width * 2.0 + combinedBounds.height;
+BestPositionResult GravityPlacement::findBestPosition(
+    const Polygon& part,
+    const std::vector<PlacedPart>& placed,
+    const std::vector<Point>& candidatePositions,
+    const DeepNestConfig& config
+) const {
+    TRACE_SCOPE("placement.score");
+    STAGE_SCOPE(Scoring);
 
-    return metric;
+    if (candidatePositions.empty()) {
+        return BestPositionResult(); // No valid positions
+    }
+
+    const PlacementContext context = PlacementContext::build(part, placed, config, false);
+
+    // Score every candidate, then select in candidate order
+    // JavaScript: for(j=0; j<finalNfp.length; j++) { for(k=0; k<nf.length; k++)
+    std::vector<double> metrics;
+    std::vector<double> mergedLengths;
+    scoreCandidates(GravityKernel{context}, part, candidatePositions, context, config, metrics, mergedLengths);
+
+    // Tie-breaking values based on gravity direction, fixed per call
+    size_t best;
+    switch (config.gravityDirection) {
+        case GravityDirection::RIGHT:
+            best = selectGravity<GravityDirection::RIGHT>(candidatePositions, metrics);
+            break;
+        case GravityDirection::BOTTOM:
+            best = selectGravity<GravityDirection::BOTTOM>(candidatePositions, metrics);
+            break;
+        case GravityDirection::TOP:
+            best = selectGravity<GravityDirection::TOP>(candidatePositions, metrics);
+            break;
+        case GravityDirection::BOTTOM_LEFT:
+            best = selectGravity<GravityDirection::BOTTOM_LEFT>(candidatePositions, metrics);
+            break;
+        case GravityDirection::LEFT:
+        default:
+            best = selectGravity<GravityDirection::LEFT>(candidatePositions, metrics);  // Default to LEFT
+            break;
+    }
+
+    // CRITICAL FIX 1.3: Return area metric (minarea component for fitness)
+    // JavaScript background.js:1142: fitness += (minwidth/binarea) + minarea
+    // LINE MERGE: Also return merged length for logging/debugging
+    return BestPositionResult(candidatePositions[best], metrics[best], mergedLengths[best]);
+}
+
+double GravityPlacement::calculateMetric(
+    const Polygon& part,
+    const Point& position,
+    const PlacementContext& context
+) const {
+    (void)part;
+    return GravityKernel{context}(position);
 }
 
 // ==================== BoundingBoxPlacement ====================
@@ -255,63 +409,33 @@ BestPositionResult BoundingBoxPlacement::findBestPosition(
     const std::vector<Point>& candidatePositions,
     const DeepNestConfig& config
 ) const {
+    TRACE_SCOPE("placement.score");
+    STAGE_SCOPE(Scoring);
 
     if (candidatePositions.empty()) {
         return BestPositionResult();
     }
 
+    const PlacementContext context = PlacementContext::build(part, placed, config, false);
+
     double minMetric = std::numeric_limits<double>::max();
     Point bestPosition;
     double bestMergedLength = 0.0;
     bool foundValid = false;
 
-    for (const auto& position : candidatePositions) {
-        double metric = calculateMetric(part, position, placed);
+    std::vector<double> metrics;
+    std::vector<double> mergedLengths;
+    scoreCandidates(BoundingBoxKernel{context}, part, candidatePositions, context, config, metrics, mergedLengths);
 
-        // LINE MERGE: Same as GravityPlacement
-        double mergedLength = 0.0;
-        if (config.mergeLines) {
-            Polygon testPart = part;
-            for (auto& p : testPart.points) {
-                p.x += position.x;
-                p.y += position.y;
-            }
-            for (auto& child : testPart.children) {
-                for (auto& p : child.points) {
-                    p.x += position.x;
-                    p.y += position.y;
-                }
-            }
-
-            std::vector<Polygon> placedPolygons;
-            for (const auto& placedPart : placed) {
-                Polygon poly = placedPart.polygon;
-                for (auto& p : poly.points) {
-                    p.x += placedPart.position.x;
-                    p.y += placedPart.position.y;
-                }
-                for (auto& child : poly.children) {
-                    for (auto& p : child.points) {
-                        p.x += placedPart.position.x;
-                        p.y += placedPart.position.y;
-                    }
-                }
-                placedPolygons.push_back(poly);
-            }
-
-            double minLength = 0.1;
-            double tolerance = 0.1 * config.curveTolerance;
-            auto mergeResult = MergeDetection::calculateMergedLength(
-                placedPolygons, testPart, minLength, tolerance
-            );
-            mergedLength = mergeResult.totalLength;
-            metric -= mergedLength * config.timeRatio;
-        }
+    for (size_t k = 0; k < candidatePositions.size(); ++k) {
+        const Point& position = candidatePositions[k];
+        const double metric = metrics[k];
+        const double merged = mergedLengths[k];
 
         if (metric < minMetric) {
             minMetric = metric;
             bestPosition = position;
-            bestMergedLength = mergedLength;
+            bestMergedLength = merged;
             foundValid = true;
         }
     }
@@ -327,68 +451,10 @@ BestPositionResult BoundingBoxPlacement::findBestPosition(
 double BoundingBoxPlacement::calculateMetric(
     const Polygon& part,
     const Point& position,
-    const std::vector<PlacedPart>& placed
+    const PlacementContext& context
 ) const {
-
-    // Handle edge case: no placed parts yet (placing first part)
-    if (placed.empty()) {
-        BoundingBox partBounds = part.bounds();
-        double metric = (partBounds.width + position.x) * (partBounds.height + position.y);
-        return metric;
-    }
-
-    // Same as gravity, but use normal bounding box area
-    std::vector<Point> allPoints;
-
-    // Pre-allocate space to avoid reallocations
-    size_t totalPoints = 0;
-    for (const auto& placedPart : placed) {
-        totalPoints += placedPart.polygon.points.size();
-    }
-    allPoints.reserve(totalPoints);
-
-    // Collect translated points
-    for (const auto& placedPart : placed) {
-        // Validate polygon before accessing points
-        if (placedPart.polygon.points.empty()) {
-            continue; // Skip invalid polygons
-        }
-
-        for (const auto& pt : placedPart.polygon.points) {
-            allPoints.push_back(Point(pt.x + placedPart.position.x,
-                                     pt.y + placedPart.position.y));
-        }
-    }
-
-    // Safety check: if all polygons were invalid, treat as empty
-    if (allPoints.empty()) {
-        BoundingBox partBounds = part.bounds();
-        double metric = (partBounds.width + position.x) * (partBounds.height + position.y);
-        return metric;
-    }
-
-    BoundingBox allBounds = BoundingBox::fromPoints(allPoints);
-    BoundingBox partBounds = part.bounds();
-
-    std::vector<Point> combinedPoints = {
-        Point(allBounds.x, allBounds.y),
-        Point(allBounds.x + allBounds.width, allBounds.y),
-        Point(allBounds.x + allBounds.width, allBounds.y + allBounds.height),
-        Point(allBounds.x, allBounds.y + allBounds.height),
-
-        Point(partBounds.x + position.x, partBounds.y + position.y),
-        Point(partBounds.x + partBounds.width + position.x, partBounds.y + position.y),
-        Point(partBounds.x + partBounds.width + position.x, partBounds.y + partBounds.height + position.y),
-        Point(partBounds.x + position.x, partBounds.y + partBounds.height + position.y)
-    };
-
-    BoundingBox combinedBounds = BoundingBox::fromPoints(combinedPoints);
-
-    // Bounding box metric: normal area
-    // JavaScript: area = rectbounds.width * rectbounds.height;
-    double metric = combinedBounds.width * combinedBounds.height;
-
-    return metric;
+    (void)part;
+    return BoundingBoxKernel{context}(position);
 }
 
 // ==================== ConvexHullPlacement ====================
@@ -399,63 +465,33 @@ BestPositionResult ConvexHullPlacement::findBestPosition(
     const std::vector<Point>& candidatePositions,
     const DeepNestConfig& config
 ) const {
+    TRACE_SCOPE("placement.score");
+    STAGE_SCOPE(Scoring);
 
     if (candidatePositions.empty()) {
         return BestPositionResult();
     }
 
+    const PlacementContext context = PlacementContext::build(part, placed, config, true);
+
     double minMetric = std::numeric_limits<double>::max();
     Point bestPosition;
     double bestMergedLength = 0.0;
     bool foundValid = false;
 
-    for (const auto& position : candidatePositions) {
-        double metric = calculateMetric(part, position, placed);
+    std::vector<double> metrics;
+    std::vector<double> mergedLengths;
+    scoreCandidates(ConvexHullKernel(part, context), part, candidatePositions, context, config, metrics, mergedLengths);
 
-        // LINE MERGE: Same as GravityPlacement
-        double mergedLength = 0.0;
-        if (config.mergeLines) {
-            Polygon testPart = part;
-            for (auto& p : testPart.points) {
-                p.x += position.x;
-                p.y += position.y;
-            }
-            for (auto& child : testPart.children) {
-                for (auto& p : child.points) {
-                    p.x += position.x;
-                    p.y += position.y;
-                }
-            }
-
-            std::vector<Polygon> placedPolygons;
-            for (const auto& placedPart : placed) {
-                Polygon poly = placedPart.polygon;
-                for (auto& p : poly.points) {
-                    p.x += placedPart.position.x;
-                    p.y += placedPart.position.y;
-                }
-                for (auto& child : poly.children) {
-                    for (auto& p : child.points) {
-                        p.x += placedPart.position.x;
-                        p.y += placedPart.position.y;
-                    }
-                }
-                placedPolygons.push_back(poly);
-            }
-
-            double minLength = 0.1;
-            double tolerance = 0.1 * config.curveTolerance;
-            auto mergeResult = MergeDetection::calculateMergedLength(
-                placedPolygons, testPart, minLength, tolerance
-            );
-            mergedLength = mergeResult.totalLength;
-            metric -= mergedLength * config.timeRatio;
-        }
+    for (size_t k = 0; k < candidatePositions.size(); ++k) {
+        const Point& position = candidatePositions[k];
+        const double metric = metrics[k];
+        const double merged = mergedLengths[k];
 
         if (metric < minMetric) {
             minMetric = metric;
             bestPosition = position;
-            bestMergedLength = mergedLength;
+            bestMergedLength = merged;
             foundValid = true;
         }
     }
@@ -471,67 +507,9 @@ BestPositionResult ConvexHullPlacement::findBestPosition(
 double ConvexHullPlacement::calculateMetric(
     const Polygon& part,
     const Point& position,
-    const std::vector<PlacedPart>& placed
+    const PlacementContext& context
 ) const {
-
-    // Handle edge case: no placed parts yet (placing first part)
-    if (placed.empty()) {
-        // Only the new part contributes to area
-        double area = std::abs(GeometryUtil::polygonArea(part.points));
-        return area;
-    }
-
-    // Collect all points from placed parts
-    // JavaScript: allpoints = getHull(allpoints);
-    std::vector<Point> allPoints;
-
-    // Pre-allocate space to avoid reallocations
-    size_t totalPoints = 0;
-    for (const auto& placedPart : placed) {
-        totalPoints += placedPart.polygon.points.size();
-    }
-    allPoints.reserve(totalPoints);
-
-    // Collect translated points
-    for (const auto& placedPart : placed) {
-        // Validate polygon before accessing points
-        if (placedPart.polygon.points.empty()) {
-            continue; // Skip invalid polygons
-        }
-
-        for (const auto& pt : placedPart.polygon.points) {
-            allPoints.push_back(Point(pt.x + placedPart.position.x,
-                                     pt.y + placedPart.position.y));
-        }
-    }
-
-    // Safety check: if all polygons were invalid, treat as empty
-    if (allPoints.empty()) {
-        double area = std::abs(GeometryUtil::polygonArea(part.points));
-        return area;
-    }
-
-    // Calculate convex hull of placed parts
-    // JavaScript: allpoints = getHull(allpoints);
-    std::vector<Point> hull = ConvexHull::computeHull(allPoints);
-
-    // Add part points at candidate position
-    // JavaScript: var localpoints = clone(allpoints);
-    //   for(m=0; m<part.length; m++) { localpoints.push(...) }
-    std::vector<Point> combinedPoints = hull;
-    for (const auto& pt : part.points) {
-        combinedPoints.push_back(Point(pt.x + position.x, pt.y + position.y));
-    }
-
-    // Calculate convex hull of combined points
-    // JavaScript: localpoints = getHull(localpoints);
-    std::vector<Point> combinedHull = ConvexHull::computeHull(combinedPoints);
-
-    // Calculate area of convex hull
-    // JavaScript: area = -GeometryUtil.polygonArea(localpoints);
-    double area = std::abs(GeometryUtil::polygonArea(combinedHull));
-
-    return area;
+    return ConvexHullKernel(part, context)(position);
 }
 
 } // namespace deepnest
@@ -1,41 +1,324 @@
 #include "../../include/deepnest/placement/PlacementWorker.h"
+#include "../../include/deepnest/DebugConfig.h"
+#include "../../include/deepnest/geometry/ClipperContext.h"
 #include "../../include/deepnest/geometry/GeometryUtil.h"
 #include "../../include/deepnest/geometry/Transformation.h"
 #include "../../include/deepnest/geometry/PolygonOperations.h"
+#include "../../include/deepnest/placement/EvaluationRecorder.h"
 #include "../../include/deepnest/placement/MergeDetection.h"
+#include "../../include/deepnest/placement/PlacementJob.h"
+#include "../../include/deepnest/placement/PlacementMemo.h"
+#include "../../include/deepnest/placement/RasterGrid.h"
+#include "../../include/deepnest/placement/Skyline.h"
+#include "../../include/deepnest/parallel/ParallelProcessor.h"
+#include "../../include/deepnest/StageTimes.h"
+#include "../../include/deepnest/Trace.h"
 #include <clipper2/clipper.h>
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <cmath>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 namespace deepnest {
 
+namespace {
+
+/**
+ * @brief Raster cells along the longer side of the first sheet when
+ *        DeepNestConfig::rasterCellSize is 0
+ */
+const double RASTER_AUTO_CELLS = 256.0;
+
+/**
+ * @brief Bisection steps per axis when refining a raster position
+ */
+const int RASTER_REFINE_STEPS = 6;
+
+/**
+ * @brief Uniform grid over the bounding boxes of a sheet's placed parts
+ */
+class PlacedPartGrid {
+public:
+    static constexpr int CELLS_PER_SIDE = 32;
+
+    explicit PlacedPartGrid(const BoundingBox& area)
+        : area_(area)
+        , cellWidth_(std::max(area.width, 1e-9) / CELLS_PER_SIDE)
+        , cellHeight_(std::max(area.height, 1e-9) / CELLS_PER_SIDE)
+        , cells_(CELLS_PER_SIDE * CELLS_PER_SIDE)
+    {
+    }
+
+    /**
+     * @brief Add placed part number boxes_.size() with its world bounds
+     */
+    void insert(const BoundingBox& box) {
+        const size_t index = boxes_.size();
+        boxes_.push_back(box);
+
+        const CellRange range = cellRange(box);
+        for (int y = range.y0; y <= range.y1; ++y) {
+            for (int x = range.x0; x <= range.x1; ++x) {
+                cells_[y * CELLS_PER_SIDE + x].push_back(index);
+            }
+        }
+    }
+
+    /**
+     * @brief Placed parts numbered from first whose bounds intersect box
+     * @param out Ascending indices (cleared first)
+     */
+    void query(const BoundingBox& box, size_t first, std::vector<size_t>& out) const {
+        out.clear();
+
+        const CellRange range = cellRange(box);
+        for (int y = range.y0; y <= range.y1; ++y) {
+            for (int x = range.x0; x <= range.x1; ++x) {
+                for (size_t index : cells_[y * CELLS_PER_SIDE + x]) {
+                    if (index >= first && boxes_[index].intersects(box)) {
+                        out.push_back(index);
+                    }
+                }
+            }
+        }
+
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+private:
+    struct CellRange {
+        int x0, x1, y0, y1;
+    };
+
+    CellRange cellRange(const BoundingBox& box) const {
+        return CellRange{
+            cellIndex((box.left() - area_.left()) / cellWidth_),
+            cellIndex((box.right() - area_.left()) / cellWidth_),
+            cellIndex((box.top() - area_.top()) / cellHeight_),
+            cellIndex((box.bottom() - area_.top()) / cellHeight_)
+        };
+    }
+
+    // Anything off the sheet lands in the border cells
+    static int cellIndex(double position) {
+        if (!(position > 0.0)) {
+            return 0;
+        }
+        return std::min(CELLS_PER_SIDE - 1, static_cast<int>(position));
+    }
+
+    BoundingBox area_;
+    double cellWidth_;
+    double cellHeight_;
+    std::vector<std::vector<size_t>> cells_;
+    std::vector<BoundingBox> boxes_;
+};
+
+/**
+ * @brief Part outline at its placement in scaled integer coordinates
+ *
+ * Translated the same way as the outer NFPs in unionPaths, so placed parts
+ * and their NFPs agree to the last unit.
+ */
+Clipper2Lib::Path64 worldPath(const Polygon& part, const Point& position, const DeepNestConfig& config) {
+    const double scale = config.getClipperScale();
+    const Clipper2Lib::Path64* cached = part.scaledPathAt(scale);
+    Clipper2Lib::Path64 path = cached ? *cached : PolygonOperations::toPath64(part.points, scale);
+
+    const int64_t dx = PolygonOperations::toClipperUnits(position.x, scale, config.integerGeometry);
+    const int64_t dy = PolygonOperations::toClipperUnits(position.y, scale, config.integerGeometry);
+    for (auto& p : path) {
+        p.x += dx;
+        p.y += dy;
+    }
+    return path;
+}
+
+/**
+ * @brief Side of r relative to the line p->q: 1, -1, or 0 if too close to tell
+ *
+ * The cross product is evaluated in doubles and only trusted beyond its
+ * rounding error bound.
+ */
+int orientation(const Clipper2Lib::Point64& p, const Clipper2Lib::Point64& q,
+                const Clipper2Lib::Point64& r) {
+    const double left = static_cast<double>(q.x - p.x) * static_cast<double>(r.y - p.y);
+    const double right = static_cast<double>(q.y - p.y) * static_cast<double>(r.x - p.x);
+    const double det = left - right;
+    const double bound = 3.3306690738754716e-16 * (std::abs(left) + std::abs(right));
+    if (det > bound) return 1;
+    if (det < -bound) return -1;
+    return 0;
+}
+
+/**
+ * @brief Whether segments a1-a2 and b1-b2 cross, touch or overlap collinearly
+ *
+ * Errs towards true when the arithmetic cannot decide.
+ */
+bool segmentsMayTouch(const Clipper2Lib::Point64& a1, const Clipper2Lib::Point64& a2,
+                      const Clipper2Lib::Point64& b1, const Clipper2Lib::Point64& b2) {
+    if (std::max(a1.x, a2.x) < std::min(b1.x, b2.x) || std::max(b1.x, b2.x) < std::min(a1.x, a2.x) ||
+        std::max(a1.y, a2.y) < std::min(b1.y, b2.y) || std::max(b1.y, b2.y) < std::min(a1.y, a2.y)) {
+        return false;
+    }
+    const int d1 = orientation(b1, b2, a1);
+    const int d2 = orientation(b1, b2, a2);
+    if (d1 != 0 && d1 == d2) {
+        return false;
+    }
+    const int d3 = orientation(a1, a2, b1);
+    const int d4 = orientation(a1, a2, b2);
+    return !(d3 != 0 && d3 == d4);
+}
+
+/**
+ * @brief Whether segment a1-a2 can meet the rectangle
+ */
+bool segmentInRect(const Clipper2Lib::Point64& a1, const Clipper2Lib::Point64& a2,
+                   const Clipper2Lib::Rect64& rect) {
+    return std::max(a1.x, a2.x) >= rect.left && std::min(a1.x, a2.x) <= rect.right &&
+           std::max(a1.y, a2.y) >= rect.top && std::min(a1.y, a2.y) <= rect.bottom;
+}
+
+/**
+ * @brief Length of the outline and the holes of a part
+ */
+double outlinePerimeter(const Polygon& polygon) {
+    double length = 0.0;
+    for (size_t i = 0; i < polygon.points.size(); i++) {
+        const Point& a = polygon.points[i];
+        const Point& b = polygon.points[(i + 1) % polygon.points.size()];
+        length += std::hypot(b.x - a.x, b.y - a.y);
+    }
+    for (const auto& child : polygon.children) {
+        length += outlinePerimeter(child);
+    }
+    return length;
+}
+
+/**
+ * @brief Working buffers of one placeParts() call
+ *
+ * Kept per thread and reused, so the buffers keep their capacity across
+ * evaluations instead of being reallocated for every part of every
+ * individual.
+ */
+struct PlacementScratch {
+    std::vector<size_t> pending;           // Parts still to place on this sheet
+    std::vector<size_t> skipped;           // Parts left for the next sheet
+    std::vector<size_t> reachable;         // Placed parts within NFP reach
+    std::vector<size_t> neighbors;         // Placed parts near a candidate
+    std::vector<NFPCache::NFPHandle> outerNfps;
+    std::vector<Point> outerNfpOffsets;
+    std::vector<Clipper2Lib::Path64> convertedPaths;
+    std::vector<const Clipper2Lib::Path64*> outerNfpPaths;
+    std::vector<Point> outerNfpPathOffsets; // Per path, pockets included
+    std::vector<const Polygon*> finalNfp;
+    std::vector<Polygon> differenceNfp;    // Owns the difference regions of finalNfp
+    Clipper2Lib::Paths64 finalPaths;       // finalNfp in integer geometry mode
+    Clipper2Lib::Paths64 mergedPaths;      // Forbidden region being folded
+    std::vector<Point> candidatePositions;
+};
+
+/**
+ * @brief Scratch buffers taken from the calling thread's pool
+ *
+ * A pool rather than a single instance keeps nested placeParts() calls on
+ * one thread apart.
+ */
+class ScratchLease {
+public:
+    ScratchLease() {
+        std::vector<std::unique_ptr<PlacementScratch>>& free = pool();
+        if (free.empty()) {
+            scratch_.reset(new PlacementScratch());
+        } else {
+            scratch_ = std::move(free.back());
+            free.pop_back();
+        }
+        scratch_->pending.clear();
+        scratch_->skipped.clear();
+    }
+
+    ~ScratchLease() {
+        pool().push_back(std::move(scratch_));
+    }
+
+    ScratchLease(const ScratchLease&) = delete;
+    ScratchLease& operator=(const ScratchLease&) = delete;
+
+    PlacementScratch* operator->() const { return scratch_.get(); }
+
+private:
+    static std::vector<std::unique_ptr<PlacementScratch>>& pool() {
+        static thread_local std::vector<std::unique_ptr<PlacementScratch>> free;
+        return free;
+    }
+
+    std::unique_ptr<PlacementScratch> scratch_;
+};
+
+} // anonymous namespace
+
+size_t PlacementWorker::PlacementResult::memoryBytes() const {
+    size_t bytes = sizeof(PlacementResult) - sizeof(placements)
+                 + PlacementWorker::memoryBytes(placements)
+                 + unplacedParts.capacity() * sizeof(Polygon);
+    for (const auto& part : unplacedParts) {
+        bytes += part.memoryBytes() - sizeof(Polygon);
+    }
+    return bytes;
+}
+
+size_t PlacementWorker::memoryBytes(const std::vector<std::vector<Placement>>& placements) {
+    size_t bytes = sizeof(placements) + placements.capacity() * sizeof(std::vector<Placement>);
+    for (const auto& sheet : placements) {
+        bytes += sheet.capacity() * sizeof(Placement);
+    }
+    return bytes;
+}
+
 PlacementWorker::PlacementWorker(const DeepNestConfig& config, NFPCalculator& calculator)
     : config_(config)
     , nfpCalculator_(calculator)
+    , processor_(nullptr)
+    , rotationRetry_(true)
 {
     // Create placement strategy based on config
     // JavaScript: placementType options are 'gravity', 'box', 'convexhull'
     strategy_ = PlacementStrategy::create(config_.placementType);
+
+    if (config_.placementMemoMaxMemoryMB > 0) {
+        memo_.reset(new PlacementMemo(static_cast<size_t>(config_.placementMemoMaxMemoryMB) * 1024 * 1024));
+    }
 }
 
-PlacementWorker::PlacementResult PlacementWorker::placeParts(
-    std::vector<Polygon> sheets,
-    std::vector<Polygon> parts
-) {
-    // JavaScript: function placeParts(sheets, parts, config, nestindex)
-    PlacementResult result;
+PlacementWorker::~PlacementWorker() = default;
 
-    if (sheets.empty()) {
-        result.unplacedParts = parts;
-        result.fitness = parts.size() * 2.0; // Penalty for unplaced parts
-        return result;
-    }
+void PlacementWorker::setParallelProcessor(ParallelProcessor* processor) {
+    processor_ = processor;
+    strategy_->setParallelScoring(processor, static_cast<size_t>(config_.parallelScoringThreshold));
+}
 
-    // JavaScript: var totalMerged = 0;
-    double totalMerged = 0.0;
+void PlacementWorker::setRotationRetry(bool retry) {
+    rotationRetry_ = retry;
+}
 
+void PlacementWorker::setRecorder(std::shared_ptr<EvaluationRecorder> recorder) {
+    recorder_ = std::move(recorder);
+}
+
+PlacementWorker::PlacementResult PlacementWorker::placeParts(
+    const std::vector<Polygon>& sheets,
+    const std::vector<Polygon>& parts,
+    double cutoff,
+    const CancellationToken& token
+) {
     // JavaScript: var rotated = [];
     //             for(i=0; i<parts.length; i++){
     //               var r = rotatePolygon(parts[i], parts[i].rotation);
@@ -45,25 +328,16 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
     //               rotated.push(r);
     //             }
     //             parts = rotated;
-#ifdef PLACEMENTDEBUG
-    std::cout << "\n=== PLACEMENT START ===" << std::endl;
-    std::cout << "Number of parts to place: " << parts.size() << std::endl;
-    std::cout << "Number of sheets: " << sheets.size() << std::endl;
-    std::cout.flush();
-#endif
-    std::vector<Polygon> rotatedParts;
+    std::vector<Polygon> rotated;
+    rotated.reserve(parts.size());
     for (size_t idx = 0; idx < parts.size(); ++idx) {
-        auto& part = parts[idx];
-        Polygon rotated = part.rotate(part.rotation);
+        const auto& part = parts[idx];
 
         // The JavaScript code does NOT normalize - it keeps negative coordinates
         // NFP calculation DEPENDS on parts[0] being at the rotated position
         // Normalization breaks the coordinate system contract
         // Negative coordinates after rotation are PERFECTLY FINE!
-
-        rotated.rotation = part.rotation;
-        rotated.source = part.source;
-        rotated.id = part.id;
+        rotated.push_back(PlacementJob::rotated(part));
 
 #ifdef PLACEMENTDEBUG
         // Debug log for first part
@@ -71,14 +345,110 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
             std::cout << "\n=== ROTATION DEBUG: First part ===" << std::endl;
             std::cout << "  Original rotation: " << part.rotation << std::endl;
             std::cout << "  Original points[0]: (" << part.points[0].x << ", " << part.points[0].y << ")" << std::endl;
-            std::cout << "  Rotated points[0]: (" << rotated.points[0].x << ", " << rotated.points[0].y << ")" << std::endl;
+            std::cout << "  Rotated points[0]: (" << rotated.back().points[0].x << ", " << rotated.back().points[0].y << ")" << std::endl;
             std::cout.flush();
         }
 #endif
+    }
+
+    std::vector<const Polygon*> rotatedParts;
+    rotatedParts.reserve(rotated.size());
+    for (const auto& part : rotated) {
+        rotatedParts.push_back(&part);
+    }
+    return placeRotated(sheets, rotatedParts, cutoff, token);
+}
 
-        rotatedParts.push_back(rotated);
+PlacementWorker::PlacementResult PlacementWorker::placeParts(
+    const PlacementJob& job,
+    const std::vector<size_t>& variants,
+    double cutoff,
+    const CancellationToken& token
+) {
+    // The job holds the parts already turned
+    std::vector<const Polygon*> rotatedParts;
+    rotatedParts.reserve(variants.size());
+    for (size_t index : variants) {
+        rotatedParts.push_back(&job.variant(index));
+    }
+    if (recorder_) {
+        return recorder_->evaluate(variants, cutoff, [&]() {
+            return placeRotated(job.sheets(), rotatedParts, cutoff, token);
+        });
+    }
+    return placeRotated(job.sheets(), rotatedParts, cutoff, token);
+}
+
+PlacementWorker::PlacementResult PlacementWorker::placeParts(
+    const PlacementJob& job,
+    const std::vector<Polygon>& sheets,
+    const std::vector<size_t>& variants,
+    double cutoff,
+    const CancellationToken& token
+) {
+    std::vector<const Polygon*> rotatedParts;
+    rotatedParts.reserve(variants.size());
+    for (size_t index : variants) {
+        rotatedParts.push_back(&job.variant(index));
+    }
+    return placeRotated(sheets, rotatedParts, cutoff, token);
+}
+
+PlacementWorker::PlacementResult PlacementWorker::placeRotated(
+    const std::vector<Polygon>& sheets,
+    const std::vector<const Polygon*>& rotatedParts,
+    double cutoff,
+    const CancellationToken& token
+) {
+    TRACE_SCOPE("placement.placeParts");
+    // JavaScript: function placeParts(sheets, parts, config, nestindex)
+    PlacementResult result;
+    ScratchLease scratch;
+
+    if (sheets.empty()) {
+        for (const Polygon* part : rotatedParts) {
+            result.unplacedParts.push_back(*part);
+        }
+        result.fitness = rotatedParts.size() * 2.0; // Penalty for unplaced parts
+        return result;
+    }
+
+    // JavaScript: var totalMerged = 0;
+    double totalMerged = 0.0;
+
+#ifdef PLACEMENTDEBUG
+    std::cout << "\n=== PLACEMENT START ===" << std::endl;
+    std::cout << "Number of parts to place: " << rotatedParts.size() << std::endl;
+    std::cout << "Number of sheets: " << sheets.size() << std::endl;
+    std::cout.flush();
+#endif
+    // Genes as the prefix memo sees them; turning keeps id, fingerprint
+    // and source, so the keys match those of the unturned parts
+    std::vector<PlacementMemo::Gene> genes;
+    uint64_t memoSheetKey = 0;
+    if (memo_) {
+        genes.reserve(rotatedParts.size());
+        for (const Polygon* part : rotatedParts) {
+            genes.push_back(PlacementMemo::Gene{
+                part->id, NFPCalculator::shapeKey(*part, part->source), NFPCache::rotationKey(part->rotation)});
+        }
+        memoSheetKey = NFPCalculator::shapeKey(sheets.front(), sheets.front().source);
+    }
+    const size_t memoStride = PlacementMemo::snapshotStride(rotatedParts.size());
+
+    // Parts still to place, as indices into rotatedParts. A first part
+    // that only fits a sheet at another rotation is replaced in retried;
+    // rotatedParts itself stays as rotated for the merge detection
+    std::unordered_map<size_t, Polygon> retried;
+    auto partAt = [&](size_t index) -> const Polygon& {
+        auto it = retried.find(index);
+        return it != retried.end() ? it->second : *rotatedParts[index];
+    };
+    std::vector<size_t>& pending = scratch->pending;
+    std::vector<size_t>& skipped = scratch->skipped;
+    for (size_t idx = 0; idx < rotatedParts.size(); ++idx) {
+        pending.push_back(idx);
     }
-    parts = rotatedParts;
 
     // JavaScript: var allplacements = [];
     //             var fitness = 0;
@@ -86,37 +456,337 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
     double fitness = 0.0;
     double totalSheetArea = 0.0;
 
+    // Lower bound bookkeeping for the cutoff. Merged lines are the only
+    // term that lowers the fitness; they are bounded by the parts' total
+    // perimeter, once for the final merge and timeRatio times for the
+    // strategies' merge bonus
+    const bool bounding = cutoff < std::numeric_limits<double>::infinity();
+    double mergeSlack = 0.0;
+    double allSheetsArea = 0.0;
+    if (bounding) {
+        if (config_.mergeLines) {
+            for (const Polygon* part : rotatedParts) {
+                mergeSlack += outlinePerimeter(*part);
+            }
+        }
+        for (const auto& sheet : sheets) {
+            allSheetsArea += std::abs(sheet.area());
+        }
+    }
+    double sheetsLeftArea = allSheetsArea;
+
+    // Cell of the raster bitmaps, the same on every sheet of the job
+    double rasterCell = config_.rasterCellSize;
+    if (!(rasterCell > 0.0)) {
+        const BoundingBox first = sheets.front().bounds();
+        rasterCell = std::max(first.width, first.height) / RASTER_AUTO_CELLS;
+    }
+
     // JavaScript: while(parts.length > 0)
-    while (!parts.empty() && !sheets.empty()) {
+    for (size_t sheetIndex = 0; !pending.empty() && sheetIndex < sheets.size(); sheetIndex++) {
+        // Only the first sheet is determined by a gene prefix alone
+        const bool memoSheet = memo_ && sheetIndex == 0;
+
         // JavaScript: var placed = [];
         //             var placements = [];
         std::vector<Polygon> placed;
         std::vector<Placement> placements;
 
+        // Forbidden region of this sheet per (shape, rotation) of the part
+        std::map<std::pair<uint64_t, int32_t>, ForbiddenRegion> forbidden;
+
+        // World bounds of the placed parts, for culling outer NFPs
+        PlacedPartGrid placedGrid(sheets[sheetIndex].bounds());
+        std::vector<size_t>& reachable = scratch->reachable;
+
+        // Placed outlines in scaled world coordinates, for overlap checks
+        std::vector<Clipper2Lib::Path64> placedPaths;
+        std::vector<size_t>& neighbors = scratch->neighbors;
+
+        // Placed parts as the placement strategy sees them
+        std::vector<PlacedPart> placedForStrategy;
+
         // JavaScript background.js:1142: fitness += (minwidth/binarea) + minarea
         double minarea_accumulator = 0.0;
 
+        // JavaScript: if(position.mergedLength) { totalMerged += position.mergedLength; }
+        double merged_accumulator = 0.0;
+
         // JavaScript: var sheet = sheets.shift();
         //             var sheetarea = Math.abs(GeometryUtil.polygonArea(sheet));
         //             totalsheetarea += sheetarea;
         //             fitness += sheetarea;
-        Polygon sheet = sheets.front();
-        sheets.erase(sheets.begin());
+        const Polygon& sheet = sheets[sheetIndex];
 
-        double sheetArea = std::abs(GeometryUtil::polygonArea(sheet.points));
+        double sheetArea = std::abs(sheet.area());
         totalSheetArea += sheetArea;
         // JavaScript: fitness += sheetarea;
         fitness += sheetArea;
 
+        // Skyline placement of rectangles while every part on a rectangular
+        // sheet came through it
+        const bool skylineSheet = strategy_->getType() == PlacementStrategy::Type::SKYLINE &&
+            sheet.children.empty() && sheet.isRectangle();
+        Skyline skyline(sheet.bounds());
+        size_t skylinePlaced = 0;
+
+        // Raster placement of every part, with the sheet and its holes as
+        // scaled paths for the exact containment test
+        const bool rasterSheet = strategy_->getType() == PlacementStrategy::Type::RASTER &&
+            rasterCell > 0.0;
+        RasterGrid raster;
+        Clipper2Lib::Paths64 sheetPaths;
+        if (rasterSheet) {
+            raster = RasterGrid(sheet, rasterCell);
+            sheetPaths.push_back(worldPath(sheet, Point(0.0, 0.0), config_));
+            for (const auto& hole : sheet.children) {
+                sheetPaths.push_back(worldPath(hole, Point(0.0, 0.0), config_));
+            }
+        }
+
+        // Parts beyond the area of this and the remaining sheets stay
+        // unplaced whatever the order, so their penalty is already due
+        if (bounding) {
+            double partsArea = 0.0;
+            for (size_t idx : pending) {
+                partsArea += std::abs(partAt(idx).area());
+            }
+            const double excess = std::max(0.0, partsArea - sheetsLeftArea);
+            sheetsLeftArea -= sheetArea;
+
+            const double lowerBound = fitness
+                + 100000000.0 * (excess / std::max(allSheetsArea, 1.0))
+                - (1.0 + config_.timeRatio) * mergeSlack;
+            if (lowerBound > cutoff) {
+                result.placements = allPlacements;
+                result.fitness = lowerBound;
+                result.area = totalSheetArea;
+                for (size_t idx : pending) {
+                    result.unplacedParts.push_back(partAt(idx));
+                }
+                result.bounded = true;
+                return result;
+            }
+        }
+
         // JavaScript: for(i=0; i<parts.length; i++)
-        for (size_t i = 0; i < parts.size(); ) {
-            Polygon& part = parts[i];
+        // Parts that do not go on this sheet are collected in skipped, in
+        // order, and are the pending parts of the next sheet
+        size_t i = 0;
+        skipped.clear();
+
+        // Resume from the deepest stored state of this individual's prefix
+        size_t resumedGenes = 0;
+        if (memoSheet) {
+            PlacementMemo::SnapshotHandle snapshot = memo_->find(memoSheetKey, genes);
+            if (snapshot) {
+                placed = snapshot->placed;
+                placements = snapshot->placements;
+                placedPaths = snapshot->placedPaths;
+                forbidden = snapshot->forbidden;
+                minarea_accumulator = snapshot->minarea;
+                merged_accumulator = snapshot->merged;
+                skyline = snapshot->skyline;
+                skylinePlaced = snapshot->skylinePlaced;
+                raster = snapshot->raster;
+                for (size_t j = 0; j < placed.size(); j++) {
+                    placedGrid.insert(placed[j].bounds().translate(
+                        placements[j].position.x, placements[j].position.y));
+                    placedForStrategy.push_back(toPlacedPart(placed[j], placements[j]));
+                }
+
+                skipped = snapshot->skipped;
+                for (const auto& entry : snapshot->retried) {
+                    retried[entry.first] = entry.second;
+                }
+                i = snapshot->genes;
+                resumedGenes = snapshot->genes;
+            }
+        }
+
+        for (; i < pending.size(); i++) {
+            token.throwIfCancelled();
+
+            // On the first sheet pending is every gene in order, so every
+            // gene before i has been placed or skipped
+            if (memoSheet && i > resumedGenes && i % memoStride == 0 &&
+                !memo_->contains(memoSheetKey, genes, i)) {
+                auto snapshot = std::make_shared<PlacementSnapshot>();
+                snapshot->genes = i;
+                snapshot->placed = placed;
+                snapshot->placements = placements;
+                snapshot->placedPaths = placedPaths;
+                snapshot->forbidden = forbidden;
+                snapshot->minarea = minarea_accumulator;
+                snapshot->merged = merged_accumulator;
+                snapshot->skyline = skyline;
+                snapshot->skylinePlaced = skylinePlaced;
+                snapshot->raster = raster;
+                snapshot->skipped = skipped;
+                for (const auto& entry : retried) {
+                    if (entry.first < i) {
+                        snapshot->retried.push_back(entry);
+                    }
+                }
+                memo_->insert(memoSheetKey, genes, std::move(snapshot));
+            }
+
+            // Skipped unless placed below
+            const size_t partIndex = pending[i];
+            skipped.push_back(partIndex);
+            const Polygon* current = &partAt(partIndex);
+
+            // A rectangle goes against the skyline without NFPs. If it does
+            // not fit there it does not fit this sheet, unless the sheet is
+            // empty and the NFP path may find another rotation
+            if (skylineSheet && skylinePlaced == placed.size() &&
+                current->isRectangle()) {
+                const Polygon& part = *current;
+                const BoundingBox partBounds = part.bounds();
+                Point corner;
+                if (skyline.find(partBounds.width, partBounds.height, corner)) {
+                    const Point shift(corner.x - partBounds.x, corner.y - partBounds.y);
+
+                    // Area and merge terms as the strategy scores the position;
+                    // the first part of a sheet has none, as on the NFP path
+                    if (!placed.empty()) {
+                        std::vector<Point>& candidatePositions = scratch->candidatePositions;
+                        candidatePositions.assign(1, shift);
+                        BestPositionResult positionResult = strategy_->findBestPosition(
+                            part, placedForStrategy, candidatePositions, config_);
+                        minarea_accumulator += positionResult.area;
+                        merged_accumulator += positionResult.mergedLength;
+                    }
+
+                    skyline.insert(corner, partBounds.width, partBounds.height);
+                    skylinePlaced++;
+
+                    Placement position(shift, part.id, part.source, part.rotation);
+                    placements.push_back(position);
+                    placed.push_back(part);
+                    placedGrid.insert(partBounds.translate(shift.x, shift.y));
+                    placedPaths.push_back(worldPath(part, shift, config_));
+                    placedForStrategy.push_back(toPlacedPart(part, position));
+
+                    skipped.pop_back();
+                    continue;
+                }
+                if (!placed.empty()) {
+                    continue;
+                }
+            }
+
+            // Every part goes on the raster bitmap; if the bitmap has no
+            // room for it, nor for another rotation of the first part of
+            // a sheet, it does not fit this sheet
+            if (rasterSheet) {
+                const double rotationStep = (config_.rotations > 0) ? (360.0 / config_.rotations) : 0.0;
+                const int attempts = (rotationRetry_ && placed.empty() && config_.rotations > 0)
+                    ? std::min(360 / config_.rotations, config_.rotations)
+                    : 1;
+                Polygon turned;
+                const Polygon* candidate = current;
+                std::shared_ptr<const RasterMask> mask;
+                int col = 0;
+                int row = 0;
+                bool found = false;
+                for (int attempt = 0; attempt < attempts && !found; ++attempt) {
+                    if (attempt > 0) {
+                        turned = current->rotate(rotationStep * attempt);
+                        std::vector<Point> cleanedPoints =
+                            PolygonOperations::cleanPolygon(turned.points, config_.getClipperScale());
+                        if (cleanedPoints.empty()) {
+                            continue;
+                        }
+                        turned.points = std::move(cleanedPoints);
+                        turned.rotation = std::fmod(current->rotation + rotationStep * attempt, 360.0);
+                        candidate = &turned;
+                    }
+                    mask = rasterMask(*candidate, rasterCell);
+                    found = raster.find(*mask, col, row);
+                }
+                if (!found) {
+                    continue;
+                }
+                if (candidate == &turned) {
+                    Polygon& slot = retried[partIndex];
+                    slot = std::move(turned);
+                    current = &slot;
+                }
+
+                const Polygon& part = *current;
+                const BoundingBox partBounds = part.bounds();
+                const Point corner = raster.corner(col, row);
+                Point shift(corner.x - partBounds.x, corner.y - partBounds.y);
+
+                // The bitmap works in whole cells: slide the part left, then
+                // up, by as much of a cell as the exact outlines allow
+                const double scale = config_.getClipperScale();
+                const double tolerance = config_.overlapTolerance * scale * scale;
+                auto fitsAt = [&](const Point& at) {
+                    const Clipper2Lib::Path64 path = worldPath(part, at, config_);
+                    static thread_local Clipper2Lib::Paths64 outside;
+                    ClipperContext::local().difference(path, sheetPaths, outside, Clipper2Lib::FillRule::EvenOdd);
+                    double outsideArea = 0.0;
+                    for (const auto& piece : outside) {
+                        outsideArea += std::abs(Clipper2Lib::Area(piece));
+                    }
+                    if (outsideArea > tolerance) {
+                        return false;
+                    }
+                    placedGrid.query(partBounds.translate(at.x, at.y), 0, neighbors);
+                    for (size_t m : neighbors) {
+                        if (hasSignificantOverlap(path, placedPaths[m], config_)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+                for (int axis = 0; axis < 2; ++axis) {
+                    const Point from = shift;
+                    double lo = 0.0;
+                    double hi = rasterCell;
+                    for (int step = 0; step < RASTER_REFINE_STEPS; ++step) {
+                        const double mid = 0.5 * (lo + hi);
+                        const Point at = axis == 0 ? Point(from.x - mid, from.y) : Point(from.x, from.y - mid);
+                        if (fitsAt(at)) {
+                            lo = mid;
+                            shift = at;
+                        } else {
+                            hi = mid;
+                        }
+                    }
+                }
+
+                // Area and merge terms as the strategy scores the position;
+                // the first part of a sheet has none, as on the NFP path
+                if (!placed.empty()) {
+                    std::vector<Point>& candidatePositions = scratch->candidatePositions;
+                    candidatePositions.assign(1, shift);
+                    BestPositionResult positionResult = strategy_->findBestPosition(
+                        part, placedForStrategy, candidatePositions, config_);
+                    minarea_accumulator += positionResult.area;
+                    merged_accumulator += positionResult.mergedLength;
+                }
+
+                raster.insert(*mask, col, row);
+
+                Placement position(shift, part.id, part.source, part.rotation);
+                placements.push_back(position);
+                placed.push_back(part);
+                placedGrid.insert(partBounds.translate(shift.x, shift.y));
+                placedPaths.push_back(worldPath(part, shift, config_));
+                placedForStrategy.push_back(toPlacedPart(part, position));
+
+                skipped.pop_back();
+                continue;
+            }
 #ifdef PLACEMENTDEBUG
             std::cerr << "\n=== PLACEMENT LOOP ITERATION ===" << std::endl;
-            std::cerr << "  Iteration i=" << i << ", parts.size()=" << parts.size()
+            std::cerr << "  Iteration i=" << i << ", pending.size()=" << pending.size()
                       << ", placed.size()=" << placed.size() << std::endl;
-            std::cerr << "  Current part: id=" << part.id << ", source=" << part.source
-                      << ", rotation=" << part.rotation << std::endl;
+            std::cerr << "  Current part: id=" << current->id << ", source=" << current->source
+                      << ", rotation=" << current->rotation << std::endl;
             std::cerr.flush();
 #endif
             // JavaScript: var sheetNfp = null;
@@ -128,90 +798,51 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
             //               part = r;
             //               parts[i] = r;
             //             }
-            Polygon innerNfp;
-            bool foundValidRotation = false;
-
             // Try to find a valid rotation for the first part
             // (to ensure all parts can be placed if possible)
-            int maxRotationAttempts = (placed.empty() && config_.rotations > 0)
+            int maxRotationAttempts = (rotationRetry_ && placed.empty() && config_.rotations > 0)
                 ? (360 / config_.rotations)
                 : 1;
 
-            Polygon basePart = parts[i];
-            double rotationStep = (config_.rotations > 0) ? (360.0 / config_.rotations) : 0.0;
-
-            for (int rotAttempt = 0; rotAttempt < maxRotationAttempts; rotAttempt++) {
-                // Debug logging for first part's first rotation attempt
-                if (placements.empty() && rotAttempt == 0) {
 #ifdef PLACEMENTDEBUG
-                    std::cout << "\n=== NFP CALCULATION DEBUG ===" << std::endl;
-                    std::cout << "  Sheet first 4 points: ";
+            // Debug logging for first part's first rotation attempt
+            if (placements.empty()) {
+                std::cout << "\n=== NFP CALCULATION DEBUG ===" << std::endl;
+                std::cout << "  Sheet first 4 points: ";
 
-                    for (size_t p = 0; p < std::min(size_t(4), sheet.points.size()); ++p) {
-                        std::cout << "(" << sheet.points[p].x << "," << sheet.points[p].y << ") ";
-                    }
-
-                    std::cout << std::endl;
-                    std::cout << "  Part first 4 points: ";
-
-                    for (size_t p = 0; p < std::min(size_t(4), part.points.size()); ++p) {
-                        std::cout << "(" << part.points[p].x << "," << part.points[p].y << ") ";
-                    }
-                    std::cout << std::endl;
-                    std::cout.flush();
- #endif 
+                for (size_t p = 0; p < std::min(size_t(4), sheet.points.size()); ++p) {
+                    std::cout << "(" << sheet.points[p].x << "," << sheet.points[p].y << ") ";
                 }
 
-                try {
-                    auto innerNfps = nfpCalculator_.getInnerNFP(sheet, part);
-                    if (!innerNfps.empty()) {
-                        innerNfp = innerNfps[0]; // Use first NFP polygon
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "CRITICAL ERROR: getInnerNFP failed: " << e.what() << std::endl;
-                    continue;
-                } catch (...) {
-                    std::cerr << "CRITICAL ERROR: getInnerNFP failed with unknown exception" << std::endl;
-                    continue;
-                }
+                std::cout << std::endl;
+                std::cout << "  Part first 4 points: ";
 
-                if (!innerNfp.points.empty()) {
-                    foundValidRotation = true;
-                    break;
+                for (size_t p = 0; p < std::min(size_t(4), current->points.size()); ++p) {
+                    std::cout << "(" << current->points[p].x << "," << current->points[p].y << ") ";
                 }
+                std::cout << std::endl;
+                std::cout.flush();
+            }
+#endif
 
-                // Try next rotation
-                if (rotAttempt < maxRotationAttempts - 1 && config_.rotations > 0) {
-                    double totalRotation = rotationStep * (rotAttempt + 1);
-                    Polygon rotated = basePart.rotate(totalRotation);
-
-                    std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(rotated.points);
-                    if (!cleanedPoints.empty()) {
-                        rotated.points = cleanedPoints;
-                    } else {
-                        // If cleaning fails (degenerate), skip this rotation
-                        continue;
-                    }
-
-                    rotated.rotation = basePart.rotation + totalRotation;
-                    rotated.source = basePart.source;
-                    rotated.id = basePart.id;
-
-                    if (rotated.rotation >= 360.0) {
-                        rotated.rotation = std::fmod(rotated.rotation, 360.0);
-                    }
+            Polygon rotated;
+            int rotatedAttempt = 0;
+            NFPCache::NFPHandle innerNfps =
+                firstFittingRotation(sheet, *current, maxRotationAttempts, rotated, rotatedAttempt);
 
-                    // Update the part in the vector (and the reference 'part')
-                    parts[i] = rotated;
-                    // Note: 'part' is a reference to parts[i], so it sees the update
-                }
+            // Later sheets see the rotated part
+            if (rotatedAttempt > 0) {
+                Polygon& slot = retried[partIndex];
+                slot = std::move(rotated);
+                current = &slot;
             }
 
             // JavaScript: if(!sheetNfp || sheetNfp.length == 0) { continue; }
-            if (!foundValidRotation || innerNfp.points.empty()) {
-                i++;
+            if (!innerNfps) {
                 continue;
             }
+            const Polygon& part = *current;
+            const Polygon& innerNfp = innerNfps->front();
 
             Placement position;
 
@@ -301,24 +932,20 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
 #endif
                     placements.push_back(position);
                     placed.push_back(part);
+                    placedGrid.insert(part.bounds().translate(bestPos.x, bestPos.y));
+                    placedPaths.push_back(worldPath(part, bestPos, config_));
+                    placedForStrategy.push_back(toPlacedPart(part, position));
+
+                    // Remove from parts list
+                    skipped.pop_back();
 #ifdef PLACEMENTDEBUG
                     std::cerr << "  FIRST PLACEMENT COMPLETE ===" << std::endl;
                     std::cerr << "    Total placed: " << placed.size() << std::endl;
-                    std::cerr << "    Parts remaining before erase: " << parts.size() << std::endl;
-#endif
-                    // Remove from parts list
-                    parts.erase(parts.begin() + i);
-#ifdef PLACEMENTDEBUG
-                    std::cerr << "    Parts remaining after erase: " << parts.size() << std::endl;
+                    std::cerr << "    Parts still pending: " << (pending.size() - i - 1) << std::endl;
                     std::cerr << "    About to continue loop..." << std::endl;
                     std::cerr.flush();
-
-                    // Don't increment i, since we removed this element
 #endif
                 }
-                else {
-                    i++;
-                }
                 continue;
             }
 
@@ -327,22 +954,49 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
             //             var clipper = new ClipperLib.Clipper();
             //             var combinedNfp = new ClipperLib.Paths();
 
-            std::vector<Polygon> outerNfps;
+            // Outer NFPs are shared cache entries; the placement offset is
+            // applied during the union instead of translating copies. Only
+            // parts placed since this shape and rotation last looked at the
+            // sheet are fetched; the rest are already in its forbidden region
+            ForbiddenRegion& region = forbidden[std::make_pair(
+                NFPCalculator::shapeKey(part, part.source), NFPCache::rotationKey(part.rotation))];
+
+            // The outer NFP of a placed part A lies within A's bounds grown
+            // by the part's extent around its reference point, so only parts
+            // whose bounds reach the inner NFP's box shifted back by that
+            // extent can cut into the inner NFP; the rest are never fetched
+            const BoundingBox innerBox = innerNfp.bounds();
+            const BoundingBox partBox = part.bounds();
+            const BoundingBox reach = BoundingBox(
+                innerBox.x + partBox.x - part.points[0].x,
+                innerBox.y + partBox.y - part.points[0].y,
+                innerBox.width + partBox.width,
+                innerBox.height + partBox.height).expand(1e-6);
+            placedGrid.query(reach, region.folded, reachable);
+
+            std::vector<NFPCache::NFPHandle>& outerNfps = scratch->outerNfps;
+            std::vector<Point>& outerNfpOffsets = scratch->outerNfpOffsets;
+            outerNfps.clear();
+            outerNfpOffsets.clear();
             bool error = false;
 #ifdef PLACEMENTDEBUG
             std::cerr << "=== PLACEMENT DEBUG: Computing outer NFPs ===" << std::endl;
-            std::cerr << "  Number of already placed parts: " << placed.size() << std::endl;
+            std::cerr << "  Number of already placed parts: " << placed.size()
+                      << " (" << region.folded << " already in the forbidden region, "
+                      << reachable.size() << " of the rest in reach)" << std::endl;
 #endif
             // JavaScript: for(j=startindex; j<placed.length; j++)
-            for (size_t j = 0; j < placed.size(); j++) {
+            for (size_t j : reachable) {
+                // Outside the try below, which would log it as an NFP failure
+                token.throwIfCancelled();
 #ifdef PLACEMENTDEBUG
                 std::cerr << "  Computing outer NFP for placed[" << j << "] (id=" << placed[j].id
                           << ") vs current part (id=" << part.id << ")" << std::endl;
 #endif
                 // JavaScript: nfp = getOuterNfp(placed[j], part);
-                Polygon outerNfp;
+                NFPCache::NFPHandle outerNfp;
                 try {
-                    outerNfp = nfpCalculator_.getOuterNFP(placed[j], part, false);
+                    outerNfp = nfpCalculator_.getOuterNFPShared(placed[j], part, false);
                 } catch (const std::exception& e) {
                     std::cerr << "CRITICAL ERROR: getOuterNFP failed for placed part " << placed[j].id 
                               << " vs " << part.id << ": " << e.what() << std::endl;
@@ -355,9 +1009,9 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
                 }
 
 #ifdef PLACEMENTDEBUG
-                std::cerr << "    Result: " << (outerNfp.points.empty() ? "EMPTY" : std::to_string(outerNfp.points.size()) + " points") << std::endl;
+                std::cerr << "    Result: " << (!outerNfp || outerNfp->empty() ? "EMPTY" : std::to_string(outerNfp->front().points.size()) + " points") << std::endl;
 #endif
-                if (outerNfp.points.empty()) {
+                if (!outerNfp || outerNfp->empty() || outerNfp->front().points.empty()) {
                     std::cerr << "ERROR: getOuterNFP returned empty polygon" << std::endl;
                     error = true;
                     break;
@@ -367,21 +1021,9 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
                 //               nfp[m].x += placements[j].x;
                 //               nfp[m].y += placements[j].y;
                 //             }
-                // Shift to placed location
-                for (auto& point : outerNfp.points) {
-                    point.x += placements[j].position.x;
-                    point.y += placements[j].position.y;
-                }
-
-                // Handle children (holes)
-                for (auto& child : outerNfp.children) {
-                    for (auto& point : child.points) {
-                        point.x += placements[j].position.x;
-                        point.y += placements[j].position.y;
-                    }
-                }
-
-                outerNfps.push_back(outerNfp);
+                // Shift to placed location (applied lazily in unionPolygons)
+                outerNfps.push_back(std::move(outerNfp));
+                outerNfpOffsets.push_back(placements[j].position);
             }
 #ifdef PLACEMENTDEBUG
             std::cerr << "  Successfully collected " << outerNfps.size() << " outer NFPs" << std::endl;
@@ -390,156 +1032,226 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
 #ifdef PLACEMENTDEBUG
                 std::cerr << "  ERROR: One or more outer NFPs were empty, skipping this part" << std::endl;
 #endif
-                i++;
                 continue;
             }
 
             // JavaScript: clipper.Execute(ClipperLib.ClipType.ctUnion, combinedNfp, ...)
-            // Union all outer NFPs
-            std::vector<std::vector<Point>> combinedNfpPoints;
+            // Union the new outer NFPs in Clipper coordinates; cached NFPs
+            // carry their scaled path, the rest are converted here
+            const double clipperScale = config_.getClipperScale();
             if (!outerNfps.empty()) {
+                STAGE_SCOPE(NfpUnion);
 #ifdef PLACEMENTDEBUG
-                std::cerr << "=== PLACEMENT DEBUG: Calling unionPolygons ===" << std::endl;
+                std::cerr << "=== PLACEMENT DEBUG: Calling unionPaths ===" << std::endl;
                 std::cerr << "  Number of polygons to union: " << outerNfps.size() << std::endl;
 
 #endif
-                // Convert Polygons to point vectors for union
-                std::vector<std::vector<Point>> outerNfpPoints;
+                // Reserved up front: outerNfpPaths points into convertedPaths.
+                // Pockets (config.exploreConcave) are oriented against their
+                // NFP, so under NonZero they stay open unless another NFP
+                // covers them
+                size_t pathCount = 0;
                 for (const auto& nfp : outerNfps) {
+                    pathCount += 1 + nfp->front().children.size();
+                }
+                std::vector<Clipper2Lib::Path64>& convertedPaths = scratch->convertedPaths;
+                convertedPaths.clear();
+                convertedPaths.reserve(pathCount);
+                std::vector<const Clipper2Lib::Path64*>& outerNfpPaths = scratch->outerNfpPaths;
+                outerNfpPaths.clear();
+                std::vector<Point>& pathOffsets = scratch->outerNfpPathOffsets;
+                pathOffsets.clear();
+                auto addPath = [&](const Polygon& polygon, const Point& offset) {
+                    const Clipper2Lib::Path64* path = polygon.scaledPathAt(clipperScale);
+                    if (!path) {
+                        convertedPaths.push_back(PolygonOperations::toPath64(polygon.points, clipperScale));
+                        path = &convertedPaths.back();
+                    }
+                    outerNfpPaths.push_back(path);
+                    pathOffsets.push_back(offset);
+                };
+                for (size_t k = 0; k < outerNfps.size(); ++k) {
+                    const Polygon& nfp = outerNfps[k]->front();
 #ifdef PLACEMENTDEBUG
                     std::cerr << "    Polygon: " << nfp.points.size() << " points" << std::endl;
 #endif
-                    outerNfpPoints.push_back(nfp.points);
+                    addPath(nfp, outerNfpOffsets[k]);
+                    for (const auto& pocket : nfp.children) {
+                        addPath(pocket, outerNfpOffsets[k]);
+                    }
                 }
 
 #ifdef PLACEMENTDEBUG
-                std::cerr << "  Calling PolygonOperations::unionPolygons..." << std::endl;
+                std::cerr << "  Calling PolygonOperations::unionPaths..." << std::endl;
 #endif
+                bool unionFailed = false;
                 try {
-                    combinedNfpPoints = PolygonOperations::unionPolygons(outerNfpPoints);
+                    Clipper2Lib::Paths64 added = PolygonOperations::unionPaths(
+                        outerNfpPaths, pathOffsets, clipperScale, config_.integerGeometry);
+
+                    // Fold into the region; as separate operands their
+                    // orientations never cancel under NonZero
+                    if (region.paths.empty()) {
+                        region.paths = std::move(added);
+                    } else if (!added.empty()) {
+                        Clipper2Lib::Paths64& merged = scratch->mergedPaths;
+                        ClipperContext::local().unite(region.paths, added, merged);
+                        region.paths.swap(merged);
+                    }
                 }
                 catch (const std::exception& e) {
-                    std::cerr << " PolygonOperations::unionPolygons " << ": " << e.what() << std::endl;
-                    break;
+                    std::cerr << " PolygonOperations::unionPaths " << ": " << e.what() << std::endl;
+                    unionFailed = true;
                 }
                 catch (...) {
-                    std::cerr << " PolygonOperations::unionPolygon failed with unknown exception" << std::endl;
+                    std::cerr << " PolygonOperations::unionPaths failed with unknown exception" << std::endl;
+                    unionFailed = true;
+                }
+
+                // Give up on this sheet; this and the remaining parts move on
+                if (unionFailed) {
+                    skipped.insert(skipped.end(), pending.begin() + i + 1, pending.end());
                     break;
                 }
 
 #ifdef PLACEMENTDEBUG
-                std::cerr << "  unionPolygons completed successfully! Result: " << combinedNfpPoints.size() << " polygon(s)" << std::endl;
+                std::cerr << "  unionPaths completed successfully! Result: " << region.paths.size() << " polygon(s)" << std::endl;
 #endif
             }
+            region.folded = placed.size();
+            const Clipper2Lib::Paths64& combinedNfp = region.paths;
+
+            std::vector<Point>& candidatePositions = scratch->candidatePositions;
+            if (config_.integerGeometry) {
+                // Difference, filter and candidates stay in Clipper
+                // coordinates, on the grid the inputs were snapped to
+                Clipper2Lib::Path64 convertedInner;
+                const Clipper2Lib::Path64* innerPath = innerNfp.scaledPathAt(clipperScale);
+                if (!innerPath) {
+                    convertedInner = PolygonOperations::toPath64(innerNfp.points, clipperScale);
+                    innerPath = &convertedInner;
+                }
 
-            // JavaScript: var finalNfp = new ClipperLib.Paths();
-            //             clipper = new ClipperLib.Clipper();
-            //             clipper.AddPaths(combinedNfp, ClipperLib.PolyType.ptClip, true);
-            //             clipper.AddPaths(clipperSheetNfp, ClipperLib.PolyType.ptSubject, true);
-            //             if(!clipper.Execute(ClipperLib.ClipType.ctDifference, finalNfp, ...))
-            // Difference: innerNfp - combinedNfp
-            std::vector<Polygon> finalNfp;
+                Clipper2Lib::Paths64& finalPaths = scratch->finalPaths;
+                if (combinedNfp.empty()) {
+                    finalPaths.assign(1, *innerPath);
+                } else {
+                    STAGE_SCOPE(NfpDifference);
+                    ClipperContext::local().difference(*innerPath, combinedNfp, finalPaths);
+                }
 
-            if (combinedNfpPoints.empty()) {
-#ifdef PLACEMENTDEBUG
-                std::cerr << "=== PLACEMENT DEBUG: No combined NFPs ===" << std::endl;
-                std::cerr << "  Using innerNfp directly (no collisions)" << std::endl;
-#endif
-                // No outer NFPs, just use inner NFP
-                finalNfp.push_back(innerNfp);
+                // Same 0.1 area floor as below, in scaled units
+                const double minArea = 0.1 * clipperScale * clipperScale;
+                finalPaths.erase(
+                    std::remove_if(finalPaths.begin(), finalPaths.end(),
+                        [minArea](const Clipper2Lib::Path64& path) {
+                            return path.size() < 3 || std::abs(Clipper2Lib::Area(path)) < minArea;
+                        }),
+                    finalPaths.end()
+                );
+
+                if (finalPaths.empty()) {
+                    continue;
+                }
+                extractCandidatePositions(finalPaths, part, candidatePositions);
             }
             else {
+                // JavaScript: var finalNfp = new ClipperLib.Paths();
+                //             clipper = new ClipperLib.Clipper();
+                //             clipper.AddPaths(combinedNfp, ClipperLib.PolyType.ptClip, true);
+                //             clipper.AddPaths(clipperSheetNfp, ClipperLib.PolyType.ptSubject, true);
+                //             if(!clipper.Execute(ClipperLib.ClipType.ctDifference, finalNfp, ...))
+                // Difference: innerNfp - combinedNfp
+                // Regions of finalNfp other than innerNfp live in differenceNfp
+                std::vector<const Polygon*>& finalNfp = scratch->finalNfp;
+                std::vector<Polygon>& differenceNfp = scratch->differenceNfp;
+                finalNfp.clear();
+
+                if (combinedNfp.empty()) {
 #ifdef PLACEMENTDEBUG
-                std::cerr << "=== PLACEMENT DEBUG: Performing difference operation ===" << std::endl;
-                std::cerr << "  innerNfp points: " << innerNfp.points.size() << std::endl;
-                std::cerr << "  combinedNfpPoints polygons: " << combinedNfpPoints.size() << std::endl;
-#endif
-                // Perform difference operation
-                // Convert combined NFP to Polygon for difference
-                Polygon combinedNfpPoly;
-                if (!combinedNfpPoints.empty()) {
-                    combinedNfpPoly.points = combinedNfpPoints[0];
-#ifdef PLACEMENTDEBUG
-                    std::cerr << "  combinedNfpPoly[0] points: " << combinedNfpPoly.points.size() << std::endl;
+                    std::cerr << "=== PLACEMENT DEBUG: No combined NFPs ===" << std::endl;
+                    std::cerr << "  Using innerNfp directly (no collisions)" << std::endl;
 #endif
-                    // Add remaining as children (holes) if any
-                    for (size_t idx = 1; idx < combinedNfpPoints.size(); idx++) {
-                        Polygon child;
-                        child.points = combinedNfpPoints[idx];
-                        combinedNfpPoly.children.push_back(child);
+                    // No outer NFPs, just use inner NFP
+                    finalNfp.push_back(&innerNfp);
+                }
+                else {
+                    STAGE_SCOPE(NfpDifference);
 #ifdef PLACEMENTDEBUG
-                        std::cerr << "  combinedNfpPoly child[" << (idx-1) << "] points: " << child.points.size() << std::endl;
+                    std::cerr << "=== PLACEMENT DEBUG: Performing difference operation ===" << std::endl;
+                    std::cerr << "  innerNfp points: " << innerNfp.points.size() << std::endl;
+                    std::cerr << "  combinedNfp polygons: " << combinedNfp.size() << std::endl;
 #endif
+                    // Subtract every union path (outer boundaries and holes), as
+                    // the JavaScript clip set does
+                    Clipper2Lib::Path64 convertedInner;
+                    const Clipper2Lib::Path64* innerPath = innerNfp.scaledPathAt(clipperScale);
+                    if (!innerPath) {
+                        convertedInner = PolygonOperations::toPath64(innerNfp.points, clipperScale);
+                        innerPath = &convertedInner;
                     }
-                }
 #ifdef PLACEMENTDEBUG
-                std::cerr << "  Calling PolygonOperations::differencePolygons..." << std::endl;
+                    std::cerr << "  Calling PolygonOperations::differencePaths..." << std::endl;
 #endif
-                std::vector<std::vector<Point>> differenceResult =
-                    PolygonOperations::differencePolygons(innerNfp.points, combinedNfpPoly.points);
+                    std::vector<std::vector<Point>> differenceResult =
+                        PolygonOperations::differencePaths(*innerPath, combinedNfp, clipperScale);
 #ifdef PLACEMENTDEBUG
-                std::cerr << "  differencePolygons completed successfully! Result: " << differenceResult.size() << " polygon(s)" << std::endl;
+                    std::cerr << "  differencePaths completed successfully! Result: " << differenceResult.size() << " polygon(s)" << std::endl;
 #endif
-                // Convert result back to Polygons
-                for (const auto& pointVec : differenceResult) {
-                    Polygon poly;
-                    poly.points = pointVec;
-                    finalNfp.push_back(poly);
+                    // Convert result back to Polygons
+                    if (differenceNfp.size() < differenceResult.size()) {
+                        differenceNfp.resize(differenceResult.size());
+                    }
+                    for (size_t k = 0; k < differenceResult.size(); k++) {
+                        differenceNfp[k].points = std::move(differenceResult[k]);
+                        finalNfp.push_back(&differenceNfp[k]);
+                    }
                 }
-            }
 
-            // JavaScript: if(!finalNfp || finalNfp.length == 0) { continue; }
-            if (finalNfp.empty()) {
-                std::cerr << "  WARNING: finalNfp is empty after difference, skipping part" << std::endl;
-                i++;
-                continue;
-            }
+                // JavaScript: if(!finalNfp || finalNfp.length == 0) { continue; }
+                if (finalNfp.empty()) {
+                    std::cerr << "  WARNING: finalNfp is empty after difference, skipping part" << std::endl;
+                    continue;
+                }
 #ifdef PLACEMENTDEBUG
-            std::cerr << "=== PLACEMENT DEBUG: finalNfp computed successfully ===" << std::endl;
-            std::cerr << "  Number of NFP polygons: " << finalNfp.size() << std::endl;
+                std::cerr << "=== PLACEMENT DEBUG: finalNfp computed successfully ===" << std::endl;
+                std::cerr << "  Number of NFP polygons: " << finalNfp.size() << std::endl;
 #endif
-            // Filter small polygons
-            // JavaScript: for(j=0; j<finalNfp.length; j++) {
-            //               var area = Math.abs(ClipperLib.Clipper.Area(finalNfp[j]));
-            //               if(finalNfp[j].length < 3 || area < 0.1*...) {
-            //                 finalNfp.splice(j,1); j--;
-            //               }
-            //             }
-            finalNfp.erase(
-                std::remove_if(finalNfp.begin(), finalNfp.end(),
-                    [](const Polygon& poly) {
-                        return poly.points.size() < 3 ||
-                               std::abs(GeometryUtil::polygonArea(poly.points)) < 0.1;
-                    }),
-                finalNfp.end()
-            );
+                // Filter small polygons
+                // JavaScript: for(j=0; j<finalNfp.length; j++) {
+                //               var area = Math.abs(ClipperLib.Clipper.Area(finalNfp[j]));
+                //               if(finalNfp[j].length < 3 || area < 0.1*...) {
+                //                 finalNfp.splice(j,1); j--;
+                //               }
+                //             }
+                finalNfp.erase(
+                    std::remove_if(finalNfp.begin(), finalNfp.end(),
+                        [](const Polygon* poly) {
+                            return poly->points.size() < 3 ||
+                                   std::abs(poly->area()) < 0.1;
+                        }),
+                    finalNfp.end()
+                );
 
-            if (finalNfp.empty()) {
-                i++;
-                continue;
-            }
+                if (finalNfp.empty()) {
+                    continue;
+                }
 
-            // JavaScript: var minwidth = null; var minarea = null; ...
-            //             for(j=0; j<finalNfp.length; j++) {
-            //               nf = finalNfp[j];
-            //               for(k=0; k<nf.length; k++) {
-            //                 ...
-            //               }
-            //             }
-            // Extract candidate positions and find best one
-            std::vector<Point> candidatePositions = extractCandidatePositions(finalNfp, part);
+                // JavaScript: var minwidth = null; var minarea = null; ...
+                //             for(j=0; j<finalNfp.length; j++) {
+                //               nf = finalNfp[j];
+                //               for(k=0; k<nf.length; k++) {
+                //                 ...
+                //               }
+                //             }
+                // Extract candidate positions and find best one
+                extractCandidatePositions(finalNfp, part, candidatePositions);
+            }
 
             if (candidatePositions.empty()) {
-                i++;
                 continue;
             }
 
-            // Convert placed parts to PlacedPart format for strategy
-            std::vector<PlacedPart> placedForStrategy;
-            for (size_t j = 0; j < placed.size(); j++) {
-                placedForStrategy.push_back(toPlacedPart(placed[j], placements[j]));
-            }
-
             // Use strategy to find best position and get area metric
             // LINE MERGE INTEGRATION: Pass config to enable line merge bonus calculation
             BestPositionResult positionResult = strategy_->findBestPosition(
@@ -554,20 +1266,18 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
             bool hasOverlap = false;
             
             if (!candidatePositions.empty()) {
-                // Check if new part at this position overlaps with any placed part
+                // Check the new part at this position against the placed
+                // parts whose bounds it reaches
                 Point testPosition = positionResult.position;
-                
-                for (size_t m = 0; m < placed.size(); m++) {
-                    const Polygon& placedPart = placed[m];
-                    const Placement& placedPosition = placements[m];
-                    
-                    Point placedPos(placedPosition.position.x, placedPosition.position.y);
-                    
-                    if (hasSignificantOverlap(part, testPosition, placedPart, placedPos, config_)) {
+                const Clipper2Lib::Path64 testPath = worldPath(part, testPosition, config_);
+                placedGrid.query(part.bounds().translate(testPosition.x, testPosition.y), 0, neighbors);
+
+                for (size_t m : neighbors) {
+                    if (hasSignificantOverlap(testPath, placedPaths[m], config_)) {
                         hasOverlap = true;
 #ifdef PLACEMENTDEBUG
                         std::cout << "  Part " << part.id << " overlaps with placed part " 
-                                  << placedPart.id << " at position (" 
+                                  << placed[m].id << " at position (" 
                                   << testPosition.x << ", " << testPosition.y << ")" << std::endl;
 #endif
                         break;
@@ -581,12 +1291,15 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
                 position = Placement(positionResult.position, part.id, part.source, part.rotation);
                 placements.push_back(position);
                 placed.push_back(part);
+                placedGrid.insert(part.bounds().translate(positionResult.position.x, positionResult.position.y));
+                placedPaths.push_back(worldPath(part, positionResult.position, config_));
+                placedForStrategy.push_back(toPlacedPart(part, position));
 
                 minarea_accumulator += positionResult.area;
+                merged_accumulator += positionResult.mergedLength;
 
                 // Remove from parts list
-                parts.erase(parts.begin() + i);
-                // Don't increment i
+                skipped.pop_back();
             }
             else {
                 // No valid positions found or overlap detected, skip this part
@@ -597,7 +1310,6 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
                     std::cout << "  Part " << part.id << " skipped - no valid positions" << std::endl;
                 }
 #endif
-                i++;
             }
         }
 
@@ -607,32 +1319,32 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
         if (!placements.empty()) {
             // Calculate bounds fitness (minwidth/binarea)
             // JavaScript: if(minwidth) { fitness += minwidth/binarea; }
-            std::vector<Point> allPlacedPoints;
-
-            // Collect all points from placed parts with their placements applied
+            // Extent of all points from placed parts with their placements applied
+            double minX = std::numeric_limits<double>::max();
+            double maxX = std::numeric_limits<double>::lowest();
+            bool hasPoints = false;
             for (size_t i = 0; i < placed.size(); i++) {
-                const Polygon& placedPart = placed[i];
-                const Placement& placement = placements[i];
-
-                // Transform each point by the placement position
-                for (const auto& point : placedPart.points) {
-                    allPlacedPoints.push_back(Point(
-                        point.x + placement.position.x,
-                        point.y + placement.position.y
-                    ));
+                const double offsetX = placements[i].position.x;
+                for (const auto& point : placed[i].points) {
+                    minX = std::min(minX, point.x + offsetX);
+                    maxX = std::max(maxX, point.x + offsetX);
+                    hasPoints = true;
                 }
             }
 
-            // Calculate bounding box and add width/area to fitness
-            if (!allPlacedPoints.empty()) {
-                BoundingBox bounds = BoundingBox::fromPoints(allPlacedPoints);
-                double boundsWidth = bounds.width;
+            // Add width/area to fitness
+            if (hasPoints) {
+                double boundsWidth = maxX - minX;
 
                 // JavaScript background.js:1142: fitness += (minwidth/binarea) + minarea
                 fitness += (boundsWidth / sheetArea) + minarea_accumulator;
             }
 
             allPlacements.push_back(placements);
+            totalMerged += merged_accumulator;
+
+            // Parts skipped on this sheet go on to the next one
+            pending.swap(skipped);
         }
         else {
             break; // No progress made
@@ -641,15 +1353,38 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
 
     // JavaScript: fitness += 100000000*(Math.abs(GeometryUtil.polygonArea(parts[i]))/totalsheetarea);
     double totalSheetAreaSafe = std::max(totalSheetArea, 1.0); // Avoid division by zero
-    for (const auto& part : parts) {
-        double partArea = std::abs(GeometryUtil::polygonArea(part.points));
+    for (size_t partIndex : pending) {
+        double partArea = std::abs(partAt(partIndex).area());
         fitness += 100000000.0 * (partArea / totalSheetAreaSafe);
     }
 
-    // Calculate total merged length
-    // JavaScript: totalMerged = ... (calculated in separate loop)
+    // Everything but the merged lines is final; with the full merge pass,
+    // skip it when even the longest possible merge cannot beat the cutoff
+    const bool fullMergePass = config_.mergeLines && config_.validateMergedLines;
+    const double mergeBound = fullMergePass ? mergeSlack : totalMerged;
+    if (bounding && fitness - mergeBound > cutoff) {
+        result.placements = allPlacements;
+        result.fitness = fitness - mergeBound;
+        result.area = totalSheetArea;
+        for (size_t partIndex : pending) {
+            result.unplacedParts.push_back(partAt(partIndex));
+        }
+        result.bounded = true;
+        return result;
+    }
+
+    // Merged lines of the chosen positions, or the full pass to validate them
     if (config_.mergeLines) {
-        totalMerged = calculateTotalMergedLength(allPlacements, rotatedParts);
+        if (fullMergePass) {
+#ifdef PLACEMENTDEBUG
+            const double chosenMerged = totalMerged;
+#endif
+            totalMerged = calculateTotalMergedLength(allPlacements, rotatedParts);
+#ifdef PLACEMENTDEBUG
+            std::cout << "  Merged lines: " << chosenMerged << " at the chosen positions, "
+                      << totalMerged << " in the full pass" << std::endl;
+#endif
+        }
         // JavaScript: fitness -= totalMerged * config.mergeLines;
         // Note: config.mergeLines is a boolean in C++, but in JS it seemed to be used as a weight?
         // Checking JS: if(config.mergeLines) { ... fitness -= merged * config.mergeLines; }
@@ -662,53 +1397,188 @@ PlacementWorker::PlacementResult PlacementWorker::placeParts(
         fitness -= totalMerged;
     }
 
-    // GA DEBUG: Log fitness calculation with CORRECTED formulas (FIX 1.1, 1.2, 1.3)
-#ifdef PLACEMENTDEBUG
-    static int placementCount = 0;
-    if (placementCount < 3) {  // Log first 3 placements only
-
-        std::cout << "\n=== PLACEMENT RESULT #" << placementCount << " (CORRECTED FITNESS) ===" << std::endl;
-        std::cout << "  Sheets used: " << allPlacements.size() << std::endl;
-        std::cout << "  Total sheet area: " << totalSheetArea << std::endl;
-        std::cout << "  Unplaced parts: " << parts.size() << std::endl;
-        // Calculate fitness breakdown with CORRECTED formulas
-        double sheetAreaPenalty = 0.0;
-        for (const auto& placements : allPlacements) {
-            // Each sheet contributes its full area (FIX 1.1)
-            sheetAreaPenalty += totalSheetArea / allPlacements.size(); // Approximate
-        }
-
-        double unplacedPenalty = 0.0;
-        for (const auto& part : parts) {
-            double partArea = std::abs(GeometryUtil::polygonArea(part.points));
-            unplacedPenalty += 100000000.0 * (partArea / totalSheetAreaSafe);
-        }
-
-        // Remaining is bounds+minarea component
-        double boundsAndMinarea = fitness - sheetAreaPenalty - unplacedPenalty;
-        std::cout << "  FINAL FITNESS: " << fitness << std::endl;
-        std::cout << "    = sheet area penalty (" << sheetAreaPenalty << ")"
-                  << " + bounds+minarea (" << boundsAndMinarea << ")"
-                  << " + unplaced penalty (" << unplacedPenalty << ")" << std::endl;
-        std::cout << "  [NOTE: Should be >> 1.0 if fixes working. Typical range: 100k-10M]" << std::endl;
-        std::cout.flush();
-        placementCount++;
-    }
-#endif
+    // Log the first 3 placements of each thread; the totals are already
+    // computed above, so nothing is recalculated for the log
+    LOG_PLACEMENT_SAMPLED(3, 0, "Placement #" << pass << ": sheets=" << allPlacements.size()
+                                << ", sheet area=" << totalSheetArea
+                                << ", unplaced=" << pending.size()
+                                << ", fitness=" << fitness);
 
     result.placements = allPlacements;
     result.fitness = fitness;
     result.area = totalSheetArea;
     result.mergedLength = totalMerged;
-    result.unplacedParts = parts;
+    for (size_t partIndex : pending) {
+        result.unplacedParts.push_back(partAt(partIndex));
+    }
 
     return result;
 }
 
-std::vector<Point> PlacementWorker::extractCandidatePositions(
-    const std::vector<Polygon>& finalNfp,
-    const Polygon& part
+NFPCache::NFPHandle PlacementWorker::firstFittingRotation(
+    const Polygon& sheet,
+    const Polygon& part,
+    int attempts,
+    Polygon& rotated,
+    int& rotatedAttempt
+) {
+    rotatedAttempt = 0;
+    if (attempts <= 0) {
+        return nullptr;
+    }
+
+    const double rotationStep = (config_.rotations > 0) ? (360.0 / config_.rotations) : 0.0;
+    const uint64_t sheetKey = NFPCalculator::shapeKey(sheet, sheet.source);
+    const uint64_t partKey = NFPCalculator::shapeKey(part, part.source);
+
+    auto rotationAt = [&](int attempt) {
+        double rotation = part.rotation + rotationStep * attempt;
+        if (rotation >= 360.0) {
+            rotation = std::fmod(rotation, 360.0);
+        }
+        return rotation;
+    };
+
+    // Part of an attempt past the first; false if it degenerates
+    auto turn = [&](int attempt, Polygon& turned) {
+        turned = part.rotate(rotationStep * attempt);
+        std::vector<Point> cleanedPoints = PolygonOperations::cleanPolygon(turned.points, config_.getClipperScale());
+        if (cleanedPoints.empty()) {
+            return false;
+        }
+        turned.points = std::move(cleanedPoints);
+        turned.rotation = rotationAt(attempt);
+        return true;
+    };
+
+    // Attempts of one rotation give the same answer; the earliest stands
+    // for all of them
+    struct Trial {
+        int attempt;
+        int32_t rotation;
+        int outcome;                // -1 unknown, 0 no fit, 1 fit
+        Polygon part;               // Turned part (attempt > 0)
+        NFPCache::NFPHandle nfp;
+    };
+    std::vector<Trial> trials;
+    for (int attempt = 0; attempt < attempts; ++attempt) {
+        const int32_t rotation = NFPCache::rotationKey(rotationAt(attempt));
+        if (std::none_of(trials.begin(), trials.end(),
+                         [&](const Trial& trial) { return trial.rotation == rotation; })) {
+            trials.push_back(Trial{attempt, rotation, -1, Polygon(), nullptr});
+        }
+    }
+    {
+        boost::lock_guard<boost::mutex> lock(innerFitsMutex_);
+        for (auto& trial : trials) {
+            auto it = innerFits_.find(std::make_tuple(sheetKey, partKey, trial.rotation));
+            if (it != innerFits_.end()) {
+                trial.outcome = it->second ? 1 : 0;
+            }
+        }
+    }
+
+    auto evaluate = [&](Trial& trial) {
+        const Polygon* candidate = &part;
+        if (trial.attempt > 0) {
+            if (!turn(trial.attempt, trial.part)) {
+                // If cleaning fails (degenerate), skip this rotation
+                trial.outcome = 0;
+                return;
+            }
+            candidate = &trial.part;
+        }
+
+        try {
+            trial.nfp = nfpCalculator_.getInnerNFPShared(sheet, *candidate);
+        } catch (const std::exception& e) {
+            std::cerr << "CRITICAL ERROR: getInnerNFP failed: " << e.what() << std::endl;
+            trial.outcome = 0;
+            return;
+        } catch (...) {
+            std::cerr << "CRITICAL ERROR: getInnerNFP failed with unknown exception" << std::endl;
+            trial.outcome = 0;
+            return;
+        }
+
+        // Use first NFP polygon
+        const bool fits = trial.nfp && !trial.nfp->empty() && !trial.nfp->front().points.empty();
+        trial.outcome = fits ? 1 : 0;
+
+        boost::lock_guard<boost::mutex> lock(innerFitsMutex_);
+        innerFits_[std::make_tuple(sheetKey, partKey, trial.rotation)] = fits;
+    };
+
+    std::vector<size_t> unknown;
+    for (;;) {
+        // Trials up to the first one known to fit are needed
+        size_t limit = 0;
+        unknown.clear();
+        for (size_t k = 0; k < trials.size() && trials[k].outcome != 1; ++k) {
+            if (trials[k].outcome < 0) {
+                unknown.push_back(k);
+            }
+            limit = k + 1;
+        }
+
+        if (!unknown.empty()) {
+            // Chunks run their trials in order and stop past an earlier fit
+            std::atomic<size_t> firstFit(limit);
+            auto run = [&](size_t begin, size_t end) {
+                for (size_t u = begin; u < end && unknown[u] < firstFit.load(); ++u) {
+                    Trial& trial = trials[unknown[u]];
+                    evaluate(trial);
+                    if (trial.outcome == 1) {
+                        size_t current = firstFit.load();
+                        while (unknown[u] < current && !firstFit.compare_exchange_weak(current, unknown[u])) {
+                        }
+                    }
+                }
+            };
+            if (processor_ && unknown.size() > 1) {
+                processor_->parallelFor(unknown.size(), 1, run);
+            } else {
+                run(0, unknown.size());
+            }
+        }
+
+        auto chosen = std::find_if(trials.begin(), trials.end(),
+                                   [](const Trial& trial) { return trial.outcome == 1; });
+        if (chosen == trials.end()) {
+            break;
+        }
+
+        // Known to fit from an earlier search; fetch its NFP
+        if (!chosen->nfp) {
+            evaluate(*chosen);
+            if (chosen->outcome != 1) {
+                continue;
+            }
+        }
+
+        if (chosen->attempt > 0) {
+            rotated = std::move(chosen->part);
+            rotatedAttempt = chosen->attempt;
+        }
+        return chosen->nfp;
+    }
+
+    // No attempt fits; the part stays turned as by the last attempt
+    for (int attempt = attempts - 1; attempt > 0; --attempt) {
+        if (turn(attempt, rotated)) {
+            rotatedAttempt = attempt;
+            break;
+        }
+    }
+    return nullptr;
+}
+
+void PlacementWorker::extractCandidatePositions(
+    const std::vector<const Polygon*>& finalNfp,
+    const Polygon& part,
+    std::vector<Point>& positions
 ) const {
+    STAGE_SCOPE(Candidates);
     // JavaScript: for(j=0; j<finalNfp.length; j++) {
     //               nf = finalNfp[j];
     //               for(k=0; k<nf.length; k++) {
@@ -716,13 +1586,13 @@ std::vector<Point> PlacementWorker::extractCandidatePositions(
     //                 ...
     //               }
     //             }
-    std::vector<Point> positions;
+    positions.clear();
 
     // CRITICAL FIX: Get the part's reference point using points[0] NOT bbox.min!
     // JavaScript code: shiftvector = { x: nf[k].x-part[0].x, y: nf[k].y-part[0].y }
     // NFPCalculator translates NFP by part.points[0], so we MUST subtract the same
     if (part.points.empty()) {
-        return positions;
+        return;
     }
 
     // Use part.points[0] as reference point to match NFP translation
@@ -730,12 +1600,12 @@ std::vector<Point> PlacementWorker::extractCandidatePositions(
 
     for (const auto& nfp : finalNfp) {
         // Skip very small NFPs
-        if (std::abs(GeometryUtil::polygonArea(nfp.points)) < 2.0) {
+        if (std::abs(nfp->area()) < 2.0) {
             continue;
         }
 
         // 1. Add all vertices (original behavior)
-        for (const auto& point : nfp.points) {
+        for (const auto& point : nfp->points) {
             // Subtract part's reference point (bbox min) to get actual placement position
             // After normalization, bbox min is (0,0), so this just returns point
             Point candidatePos(
@@ -746,7 +1616,51 @@ std::vector<Point> PlacementWorker::extractCandidatePositions(
         }
     }
 
-    return positions;
+}
+
+void PlacementWorker::extractCandidatePositions(
+    const Clipper2Lib::Paths64& finalPaths,
+    const Polygon& part,
+    std::vector<Point>& positions
+) const {
+    STAGE_SCOPE(Candidates);
+    positions.clear();
+    if (part.points.empty()) {
+        return;
+    }
+
+    // The NFP is translated by part[0], as above; the difference is taken
+    // in integers so each position is one division off its grid point
+    const double scale = config_.getClipperScale();
+    const Clipper2Lib::Path64* partPath = part.scaledPathAt(scale);
+    const int64_t refX = partPath ? partPath->front().x : std::llround(part.points[0].x * scale);
+    const int64_t refY = partPath ? partPath->front().y : std::llround(part.points[0].y * scale);
+
+    const double minArea = 2.0 * scale * scale;
+    for (const auto& path : finalPaths) {
+        if (std::abs(Clipper2Lib::Area(path)) < minArea) {
+            continue;
+        }
+        for (const auto& point : path) {
+            positions.emplace_back(static_cast<double>(point.x - refX) / scale,
+                                   static_cast<double>(point.y - refY) / scale);
+        }
+    }
+}
+
+std::shared_ptr<const RasterMask> PlacementWorker::rasterMask(const Polygon& part, double cell) {
+    const auto key = std::make_tuple(NFPCalculator::shapeKey(part, part.source),
+                                     NFPCache::rotationKey(part.rotation), cell);
+    {
+        boost::lock_guard<boost::mutex> lock(rasterMasksMutex_);
+        auto it = rasterMasks_.find(key);
+        if (it != rasterMasks_.end()) {
+            return it->second;
+        }
+    }
+    auto mask = std::make_shared<const RasterMask>(part, cell);
+    boost::lock_guard<boost::mutex> lock(rasterMasksMutex_);
+    return rasterMasks_.emplace(key, std::move(mask)).first->second;
 }
 
 PlacedPart PlacementWorker::toPlacedPart(
@@ -764,14 +1678,14 @@ PlacedPart PlacementWorker::toPlacedPart(
 
 double PlacementWorker::calculateTotalMergedLength(
     const std::vector<std::vector<Placement>>& allPlacements,
-    const std::vector<Polygon>& originalParts
+    const std::vector<const Polygon*>& originalParts
 ) const {
     double totalMerged = 0.0;
 
     // Map part ID to Polygon for quick lookup
-    std::map<int, Polygon> partMap;
-    for (const auto& part : originalParts) {
-        partMap[part.id] = part;
+    std::map<int, const Polygon*> partMap;
+    for (const Polygon* part : originalParts) {
+        partMap[part->id] = part;
     }
 
     for (const auto& sheetPlacements : allPlacements) {
@@ -781,7 +1695,7 @@ double PlacementWorker::calculateTotalMergedLength(
             auto it = partMap.find(placement.id);
             if (it != partMap.end()) {
                 // Create a copy of the part to transform
-                Polygon placedPart = it->second;
+                Polygon placedPart = *it->second;
                 
                 // Rotate (if not already rotated in originalParts, but originalParts here ARE rotated)
                 // In placeParts, we passed 'rotatedParts' to this function.
@@ -804,6 +1718,8 @@ double PlacementWorker::calculateTotalMergedLength(
                     p.x += placement.position.x;
                     p.y += placement.position.y;
                 }
+                placedPart.coordinates.reset();
+                placedPart.rings.reset();
                 
                 // Also translate children
                 for (auto& child : placedPart.children) {
@@ -834,71 +1750,90 @@ double PlacementWorker::calculateTotalMergedLength(
 }
 
 bool PlacementWorker::hasSignificantOverlap(
-    const Polygon& partA,
-    const Point& positionA,
-    const Polygon& partB,
-    const Point& positionB,
+    const Clipper2Lib::Path64& pathA,
+    const Clipper2Lib::Path64& pathB,
     const DeepNestConfig& config
 ) const {
+    TRACE_SCOPE("placement.overlap");
+    STAGE_SCOPE(Overlap);
     // JavaScript: background.js:1210-1241
-    // Perform overlap detection using Clipper2 intersection
-    
+    // The Clipper intersection is only needed when the boundaries meet;
+    // otherwise the parts are either disjoint or one contains the other
+
     using namespace Clipper2Lib;
-    
-    // Quick bounding box check first (optimization)
-    // If bounding boxes don't overlap, parts definitely don't overlap
-    Polygon translatedA = partA.translate(positionA.x, positionA.y);
-    Polygon translatedB = partB.translate(positionB.x, positionB.y);
-    
-    BoundingBox bboxA = translatedA.bounds();
-    BoundingBox bboxB = translatedB.bounds();
-    
-    // Check if bounding boxes intersect
-    bool bboxesIntersect = !(
-        bboxA.x + bboxA.width < bboxB.x ||
-        bboxB.x + bboxB.width < bboxA.x ||
-        bboxA.y + bboxA.height < bboxB.y ||
-        bboxB.y + bboxB.height < bboxA.y
-    );
-    
-    if (!bboxesIntersect) {
-        return false;  // No overlap possible
-    }
-    
-    // Convert to Clipper2 paths
-    PathsD pathsA, pathsB;
-    
-    // Convert partA (already translated)
-    PathD pathA;
-    for (const auto& p : translatedA.points) {
-        pathA.push_back(PointD(p.x, p.y));
-    }
-    pathsA.push_back(pathA);
-    
-    // Convert partB (already translated)
-    PathD pathB;
-    for (const auto& p : translatedB.points) {
-        pathB.push_back(PointD(p.x, p.y));
-    }
-    pathsB.push_back(pathB);
-    
-    // Perform intersection to find overlap
-    PathsD intersection = Intersect(pathsA, pathsB, FillRule::NonZero);
-    
-    if (intersection.empty()) {
-        return false;  // No overlap
-    }
-    
-    // Calculate intersection area
+
+    if (pathA.size() < 3 || pathB.size() < 3) {
+        return false;
+    }
+
+    const Rect64 boundsA = GetBounds(pathA);
+    const Rect64 boundsB = GetBounds(pathB);
+    if (boundsA.right < boundsB.left || boundsB.right < boundsA.left ||
+        boundsA.bottom < boundsB.top || boundsB.bottom < boundsA.top) {
+        return false;
+    }
+
+    // Only edges that reach into the other part's bounds can meet it
+    std::vector<size_t> edgesB;
+    for (size_t j = 0; j < pathB.size(); j++) {
+        if (segmentInRect(pathB[j], pathB[(j + 1) % pathB.size()], boundsA)) {
+            edgesB.push_back(j);
+        }
+    }
+
+    bool boundariesMeet = false;
+    for (size_t i = 0; i < pathA.size() && !boundariesMeet; i++) {
+        const Point64& a1 = pathA[i];
+        const Point64& a2 = pathA[(i + 1) % pathA.size()];
+        if (!segmentInRect(a1, a2, boundsB)) {
+            continue;
+        }
+        for (size_t j : edgesB) {
+            if (segmentsMayTouch(a1, a2, pathB[j], pathB[(j + 1) % pathB.size()])) {
+                boundariesMeet = true;
+                break;
+            }
+        }
+    }
+
+    const double scale = config.getClipperScale();
+    const double tolerance = config.overlapTolerance * scale * scale;
+
+    if (!boundariesMeet) {
+        const PointInPolygonResult aInB = PointInPolygon(pathA[0], pathB);
+        if (aInB == PointInPolygonResult::IsInside) {
+            return std::abs(Area(pathA)) > tolerance;
+        }
+        const PointInPolygonResult bInA = PointInPolygon(pathB[0], pathA);
+        if (bInA == PointInPolygonResult::IsInside) {
+            return std::abs(Area(pathB)) > tolerance;
+        }
+        if (aInB == PointInPolygonResult::IsOutside && bInA == PointInPolygonResult::IsOutside) {
+            return false;
+        }
+    }
+
+    // Touching or crossing boundaries: measure the overlap
+    // JavaScript uses: intersectionArea > config.overlapTolerance * clipperScale * clipperScale
+    static thread_local Paths64 intersection;
+    ClipperContext::local().intersect(pathA, pathB, intersection);
+
     double intersectionArea = 0.0;
     for (const auto& path : intersection) {
         intersectionArea += std::abs(Area(path));
     }
-    
-    // Compare with tolerance
-    // JavaScript uses: intersectionArea > config.overlapTolerance * clipperScale * clipperScale
-    // Since we're using PathsD (double precision), we compare directly without scaling
-    return intersectionArea > config.overlapTolerance;
+    return intersectionArea > tolerance;
+}
+
+bool PlacementWorker::hasSignificantOverlap(
+    const Polygon& partA,
+    const Point& positionA,
+    const Polygon& partB,
+    const Point& positionB,
+    const DeepNestConfig& config
+) const {
+    return hasSignificantOverlap(worldPath(partA, positionA, config),
+                                 worldPath(partB, positionB, config), config);
 }
 
 } // namespace deepnest
@@ -0,0 +1,274 @@
+#include "../../include/deepnest/placement/RasterGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace deepnest {
+
+namespace {
+
+const uint8_t CELL_BOUNDARY = 1;  // Interior meets an edge
+const uint8_t CELL_INSIDE = 2;    // Centre inside (even-odd)
+
+const uint64_t ALL_BLOCKED = ~uint64_t(0);
+
+int gridSize(double length, double cell) {
+    return std::max(1, static_cast<int>(std::ceil(length / cell)));
+}
+
+/**
+ * @brief Classify the cells of a rows x cols grid with top-left corner
+ *        origin against closed rings, row-major
+ *
+ * Cells that no edge enters are entirely inside or outside, so their
+ * centre decides. Edges along a grid line enter neither neighbour.
+ */
+std::vector<uint8_t> classify(const std::vector<const std::vector<Point>*>& rings,
+                              const Point& origin, double cell, int rows, int cols) {
+    std::vector<uint8_t> cells(static_cast<size_t>(rows) * cols, 0);
+    std::vector<std::vector<double>> crossings(rows);
+
+    for (const std::vector<Point>* ring : rings) {
+        const std::vector<Point>& points = *ring;
+        for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+            // Edge in cell units, from its upper end
+            double x1 = (points[j].x - origin.x) / cell, y1 = (points[j].y - origin.y) / cell;
+            double x2 = (points[i].x - origin.x) / cell, y2 = (points[i].y - origin.y) / cell;
+            if (y2 < y1) {
+                std::swap(x1, x2);
+                std::swap(y1, y2);
+            }
+            auto xAt = [&](double y) {
+                return y2 > y1 ? x1 + (x2 - x1) * (y - y1) / (y2 - y1) : x1;
+            };
+
+            const int firstRow = std::max(0, static_cast<int>(std::floor(y1)));
+            const int lastRow = std::min(rows - 1, static_cast<int>(std::ceil(y2)) - 1);
+            for (int r = firstRow; r <= lastRow; ++r) {
+                const double xa = xAt(std::max(y1, static_cast<double>(r)));
+                const double xb = y2 > y1 ? xAt(std::min(y2, r + 1.0)) : x2;
+                const int firstCol = std::max(0, static_cast<int>(std::floor(std::min(xa, xb))));
+                const int lastCol = std::min(cols - 1, static_cast<int>(std::ceil(std::max(xa, xb))) - 1);
+                for (int c = firstCol; c <= lastCol; ++c) {
+                    cells[static_cast<size_t>(r) * cols + c] |= CELL_BOUNDARY;
+                }
+            }
+
+            // Crossings of the row centres, half-open so a vertex counts once
+            const int firstCentre = std::max(0, static_cast<int>(std::ceil(y1 - 0.5)));
+            const int lastCentre = std::min(rows - 1, static_cast<int>(std::ceil(y2 - 0.5)) - 1);
+            for (int r = firstCentre; r <= lastCentre; ++r) {
+                crossings[r].push_back(xAt(r + 0.5));
+            }
+        }
+    }
+
+    for (int r = 0; r < rows; ++r) {
+        std::vector<double>& xs = crossings[r];
+        std::sort(xs.begin(), xs.end());
+        for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+            const int firstCol = std::max(0, static_cast<int>(std::floor(xs[k] - 0.5)) + 1);
+            const int lastCol = std::min(cols - 1, static_cast<int>(std::ceil(xs[k + 1] - 0.5)) - 1);
+            for (int c = firstCol; c <= lastCol; ++c) {
+                cells[static_cast<size_t>(r) * cols + c] |= CELL_INSIDE;
+            }
+        }
+    }
+    return cells;
+}
+
+uint64_t wordAt(const uint64_t* line, size_t words, size_t index) {
+    return index < words ? line[index] : ALL_BLOCKED;
+}
+
+/**
+ * @brief count words of a row starting at bit offset, blocked past its end
+ */
+void window(const uint64_t* line, size_t words, size_t offset, uint64_t* out, size_t count) {
+    const size_t q = offset / 64;
+    const unsigned s = offset % 64;
+    for (size_t w = 0; w < count; ++w) {
+        const uint64_t lo = wordAt(line, words, q + w);
+        out[w] = s ? (lo >> s) | (wordAt(line, words, q + w + 1) << (64 - s)) : lo;
+    }
+}
+
+/**
+ * @brief Bit c |= bit c + span, in place; bits past count words read as blocked
+ *
+ * Ascending order reads every word before it is rewritten.
+ */
+void spread(uint64_t* bits, size_t count, size_t span) {
+    const size_t q = span / 64;
+    const unsigned s = span % 64;
+    for (size_t w = 0; w < count; ++w) {
+        const uint64_t lo = wordAt(bits, count, w + q);
+        bits[w] |= s ? (lo >> s) | (wordAt(bits, count, w + q + 1) << (64 - s)) : lo;
+    }
+}
+
+int lowestBit(uint64_t bits) {
+    int index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+} // anonymous namespace
+
+RasterMask::RasterMask(const Polygon& part, double cell)
+    : cell(cell)
+    , bounds(part.bounds())
+{
+    if (!(cell > 0.0)) {
+        throw std::invalid_argument("Raster cell size must be positive");
+    }
+    rows = gridSize(bounds.height, cell);
+    cols = gridSize(bounds.width, cell);
+    runs.resize(rows);
+    if (part.points.size() < 3) {
+        return;
+    }
+
+    const std::vector<uint8_t> cells =
+        classify({&part.points}, Point(bounds.x, bounds.y), cell, rows, cols);
+    for (int r = 0; r < rows; ++r) {
+        const uint8_t* line = &cells[static_cast<size_t>(r) * cols];
+        for (int c = 0; c < cols; ++c) {
+            if (!line[c]) {
+                continue;
+            }
+            const int first = c;
+            while (c < cols && line[c]) {
+                ++c;
+            }
+            runs[r].emplace_back(first, c);
+        }
+    }
+}
+
+size_t RasterMask::memoryBytes() const {
+    size_t bytes = sizeof(RasterMask) + runs.capacity() * sizeof(runs[0]);
+    for (const auto& row : runs) {
+        bytes += row.capacity() * sizeof(row[0]);
+    }
+    return bytes;
+}
+
+RasterGrid::RasterGrid(const Polygon& sheet, double cell)
+    : sheet_(sheet.bounds())
+    , cell_(cell)
+{
+    if (!(cell > 0.0)) {
+        throw std::invalid_argument("Raster cell size must be positive");
+    }
+    rows_ = gridSize(sheet_.height, cell);
+    cols_ = gridSize(sheet_.width, cell);
+    words_ = (static_cast<size_t>(cols_) + 63) / 64;
+    bits_.assign(static_cast<size_t>(rows_) * words_, ALL_BLOCKED);
+    if (sheet.points.size() < 3) {
+        return;
+    }
+
+    std::vector<const std::vector<Point>*> rings{&sheet.points};
+    for (const auto& hole : sheet.children) {
+        if (hole.points.size() >= 3) {
+            rings.push_back(&hole.points);
+        }
+    }
+    const std::vector<uint8_t> cells = classify(rings, Point(sheet_.x, sheet_.y), cell, rows_, cols_);
+    for (int r = 0; r < rows_; ++r) {
+        uint64_t* line = &bits_[r * words_];
+        for (int c = 0; c < cols_; ++c) {
+            if (cells[static_cast<size_t>(r) * cols_ + c] == CELL_INSIDE) {
+                line[c / 64] &= ~(uint64_t(1) << (c % 64));
+            }
+        }
+    }
+}
+
+bool RasterGrid::find(const RasterMask& mask, int& col, int& row) const {
+    if (mask.rows > rows_ || mask.cols > cols_) {
+        return false;
+    }
+    const int lastCol = cols_ - mask.cols;
+    const int lastRow = rows_ - mask.rows;
+
+    std::vector<uint64_t> hit(words_);
+    std::vector<uint64_t> run(words_ + static_cast<size_t>(mask.cols) / 64 + 2);
+
+    int bestCol = lastCol + 1;
+    int bestRow = 0;
+    for (int r = 0; r <= lastRow && bestCol > 0; ++r) {
+        // Only columns left of the best so far can improve on it
+        const size_t used = static_cast<size_t>(bestCol - 1) / 64 + 1;
+        std::fill(hit.begin(), hit.begin() + used, 0);
+
+        for (int pr = 0; pr < mask.rows; ++pr) {
+            const uint64_t* line = &bits_[(r + pr) * words_];
+            for (const auto& span : mask.runs[pr]) {
+                // Bit c of run: any cell of [c + first, c + last) blocked
+                const size_t length = span.second - span.first;
+                const size_t count = used + (length + 63) / 64;
+                window(line, words_, span.first, run.data(), count);
+                for (size_t covered = 1; covered < length; ) {
+                    const size_t step = std::min(covered, length - covered);
+                    spread(run.data(), count, step);
+                    covered += step;
+                }
+                for (size_t w = 0; w < used; ++w) {
+                    hit[w] |= run[w];
+                }
+            }
+        }
+
+        for (size_t w = 0; w < used; ++w) {
+            if (hit[w] != ALL_BLOCKED) {
+                const int c = static_cast<int>(w * 64) + lowestBit(~hit[w]);
+                if (c < bestCol) {
+                    bestCol = c;
+                    bestRow = r;
+                }
+                break;
+            }
+        }
+    }
+
+    if (bestCol > lastCol) {
+        return false;
+    }
+    col = bestCol;
+    row = bestRow;
+    return true;
+}
+
+Point RasterGrid::corner(int col, int row) const {
+    return Point(sheet_.x + col * cell_, sheet_.y + row * cell_);
+}
+
+void RasterGrid::insert(const RasterMask& mask, int col, int row) {
+    for (int pr = 0; pr < mask.rows; ++pr) {
+        for (const auto& span : mask.runs[pr]) {
+            block(row + pr, col + span.first - 1, col + span.second);
+            block(row + pr - 1, col + span.first - 1, col + span.second);
+        }
+    }
+}
+
+void RasterGrid::block(int row, int first, int last) {
+    if (row < 0 || row >= rows_) {
+        return;
+    }
+    uint64_t* line = &bits_[row * words_];
+    for (int c = std::max(0, first); c < std::min(cols_, last); ++c) {
+        line[c / 64] |= uint64_t(1) << (c % 64);
+    }
+}
+
+size_t RasterGrid::memoryBytes() const {
+    return sizeof(RasterGrid) + bits_.capacity() * sizeof(uint64_t);
+}
+
+} // namespace deepnest
@@ -0,0 +1,194 @@
+#include "../../include/deepnest/placement/RemnantStore.h"
+#include "../../include/deepnest/parallel/WireFormat.h"
+#include <boost/thread/locks.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace deepnest {
+
+namespace {
+
+/**
+ * @brief "DNRS" in little-endian byte order
+ */
+const uint32_t REMNANT_MAGIC = 0x53524E44;
+
+/**
+ * @brief Bumped whenever the file layout changes
+ */
+const uint32_t REMNANT_VERSION = 1;
+
+/**
+ * @brief Outline area less the area of its holes
+ */
+double netArea(const Polygon& polygon) {
+    double area = std::abs(polygon.area());
+    for (const auto& hole : polygon.children) {
+        area -= std::abs(hole.area());
+    }
+    return std::max(0.0, area);
+}
+
+} // anonymous namespace
+
+RemnantStore::RemnantStore()
+    : nextId_(1)
+{}
+
+void RemnantStore::insert(Remnant remnant) {
+    byArea_.emplace(remnant.area, remnant.id);
+    nextId_ = std::max(nextId_, remnant.id + 1);
+    remnants_[remnant.id] = std::move(remnant);
+}
+
+uint64_t RemnantStore::add(const Polygon& outline, const std::string& name) {
+    Remnant remnant;
+    remnant.outline = outline;
+    remnant.outline.isSheet = true;
+    remnant.area = netArea(outline);
+    if (outline.points.size() < 3 || remnant.area <= 0.0) {
+        throw std::invalid_argument("Remnant outline has no area");
+    }
+    const BoundingBox box = outline.bounds();
+    remnant.width = box.width;
+    remnant.height = box.height;
+    remnant.name = name;
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    const uint64_t id = nextId_;
+    remnant.id = id;
+    insert(std::move(remnant));
+    return id;
+}
+
+bool RemnantStore::remove(uint64_t id) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    auto it = remnants_.find(id);
+    if (it == remnants_.end()) {
+        return false;
+    }
+    auto range = byArea_.equal_range(it->second.area);
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        if (entry->second == id) {
+            byArea_.erase(entry);
+            break;
+        }
+    }
+    remnants_.erase(it);
+    return true;
+}
+
+bool RemnantStore::get(uint64_t id, Remnant& remnant) const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    auto it = remnants_.find(id);
+    if (it == remnants_.end()) {
+        return false;
+    }
+    remnant = it->second;
+    return true;
+}
+
+size_t RemnantStore::size() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return remnants_.size();
+}
+
+std::vector<RemnantStore::Remnant> RemnantStore::candidates(const std::vector<Polygon>& parts,
+                                                            size_t limit) const {
+    // Per part: area and shorter bounding side, smallest area first, so
+    // the scan of a remnant stops at the first part too large for it
+    std::vector<std::pair<double, double>> needs;
+    needs.reserve(parts.size());
+    for (const auto& part : parts) {
+        const BoundingBox box = part.bounds();
+        needs.emplace_back(netArea(part), std::min(box.width, box.height));
+    }
+    std::sort(needs.begin(), needs.end());
+
+    std::vector<Remnant> result;
+    if (needs.empty()) {
+        return result;
+    }
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    for (auto it = byArea_.lower_bound(needs.front().first); it != byArea_.end(); ++it) {
+        const Remnant& remnant = remnants_.at(it->second);
+        const double diagonal = std::hypot(remnant.width, remnant.height);
+        for (const auto& need : needs) {
+            if (need.first > remnant.area) {
+                break;
+            }
+            if (need.second <= diagonal) {
+                result.push_back(remnant);
+                break;
+            }
+        }
+        if (limit > 0 && result.size() >= limit) {
+            break;
+        }
+    }
+    return result;
+}
+
+void RemnantStore::save(const std::string& path) const {
+    WireWriter out;
+    out.u32(REMNANT_MAGIC);
+    out.u32(REMNANT_VERSION);
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        out.u32(static_cast<uint32_t>(remnants_.size()));
+        for (const auto& entry : byArea_) {
+            const Remnant& remnant = remnants_.at(entry.second);
+            out.u64(remnant.id);
+            out.str(remnant.name);
+            out.polygon(remnant.outline);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data().data(), static_cast<std::streamsize>(out.data().size()));
+    if (!file.flush()) {
+        throw std::runtime_error("Cannot write remnant store: " + path);
+    }
+}
+
+void RemnantStore::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open remnant store: " + path);
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    WireReader in(data);
+    if (in.u32() != REMNANT_MAGIC) {
+        throw std::runtime_error("Not a remnant store: " + path);
+    }
+    if (in.u32() != REMNANT_VERSION) {
+        throw std::runtime_error("Unsupported remnant store version: " + path);
+    }
+
+    // Decoded in full before the stored remnants are replaced
+    std::vector<Remnant> loaded(in.count(46));
+    for (auto& remnant : loaded) {
+        remnant.id = in.u64();
+        remnant.name = in.str();
+        remnant.outline = in.polygon();
+        remnant.area = netArea(remnant.outline);
+        const BoundingBox box = remnant.outline.bounds();
+        remnant.width = box.width;
+        remnant.height = box.height;
+    }
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    remnants_.clear();
+    byArea_.clear();
+    nextId_ = 1;
+    for (auto& remnant : loaded) {
+        insert(std::move(remnant));
+    }
+}
+
+} // namespace deepnest
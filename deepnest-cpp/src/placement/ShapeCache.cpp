@@ -0,0 +1,96 @@
+#include "../../include/deepnest/placement/ShapeCache.h"
+#include "../../include/deepnest/nfp/NFPCache.h"
+#include <cstring>
+
+namespace deepnest {
+
+ShapeCache::ShapeCache(size_t maxEntries)
+    : maxEntries_(maxEntries)
+    , lookups_(0)
+    , hits_(0)
+{}
+
+size_t ShapeCache::KeyHash::operator()(const Key& key) const {
+    // FNV-1a over the key's fields
+    uint64_t words[4];
+    words[0] = key.shape;
+    std::memcpy(&words[1], &key.scale, sizeof(double));
+    std::memcpy(&words[2], &key.tolerance, sizeof(double));
+    words[3] = (static_cast<uint64_t>(static_cast<uint32_t>(key.rotation)) << 1) | (key.snapped ? 1 : 0);
+
+    uint64_t hash = 1469598103934665603ull;
+    for (uint64_t value : words) {
+        for (int i = 0; i < 8; i++) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool ShapeCache::findOffset(uint64_t geometry, double offset, double curveTolerance, Polygon& outline) {
+    return find(Key{geometry, offset, curveTolerance, -1, false}, outline);
+}
+
+void ShapeCache::insertOffset(uint64_t geometry, double offset, double curveTolerance, const Polygon& outline) {
+    insert(Key{geometry, offset, curveTolerance, -1, false}, outline);
+}
+
+bool ShapeCache::findTurned(uint64_t fingerprint, double rotation, double clipperScale, bool snapToGrid,
+                            Polygon& turned) {
+    return find(Key{fingerprint, clipperScale, 0.0, NFPCache::rotationKey(rotation), snapToGrid}, turned);
+}
+
+void ShapeCache::insertTurned(uint64_t fingerprint, double rotation, double clipperScale, bool snapToGrid,
+                              const Polygon& turned) {
+    insert(Key{fingerprint, clipperScale, 0.0, NFPCache::rotationKey(rotation), snapToGrid}, turned);
+}
+
+bool ShapeCache::find(const Key& key, Polygon& shape) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    lookups_++;
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    hits_++;
+    shape = it->second;
+    return true;
+}
+
+void ShapeCache::insert(const Key& key, const Polygon& shape) {
+    if (maxEntries_ == 0) {
+        return;
+    }
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    if (!entries_.emplace(key, shape).second) {
+        return;
+    }
+    order_.push_back(key);
+
+    while (entries_.size() > maxEntries_) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+    }
+}
+
+ShapeCache::Statistics ShapeCache::statistics() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    Statistics stats;
+    stats.lookups = lookups_;
+    stats.hits = hits_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+void ShapeCache::clear() {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    entries_.clear();
+    order_.clear();
+    lookups_ = 0;
+    hits_ = 0;
+}
+
+} // namespace deepnest
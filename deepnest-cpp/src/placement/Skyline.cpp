@@ -0,0 +1,90 @@
+#include "../../include/deepnest/placement/Skyline.h"
+#include "../../include/deepnest/core/Types.h"
+#include <algorithm>
+#include <cmath>
+
+namespace deepnest {
+
+Skyline::Skyline(const BoundingBox& sheet)
+    : sheet_(sheet)
+{
+    bands_.push_back(Band{sheet.y, sheet.height, sheet.x});
+}
+
+bool Skyline::find(double width, double height, Point& corner) const {
+    const double right = sheet_.x + sheet_.width;
+    const double bottom = sheet_.y + sheet_.height;
+    bool found = false;
+
+    for (size_t i = 0; i < bands_.size(); i++) {
+        const double y = bands_[i].y;
+        if (y + height > bottom + TOL) {
+            break; // This and later bands leave too little height
+        }
+
+        // The rectangle rests on the rightmost band it spans
+        double x = bands_[i].x;
+        for (size_t j = i + 1; j < bands_.size() && bands_[j].y < y + height - TOL; j++) {
+            x = std::max(x, bands_[j].x);
+        }
+        if (x + width > right + TOL) {
+            continue;
+        }
+
+        // Bands come in y order, so ties keep the lowest y
+        if (!found || x < corner.x - TOL) {
+            corner = Point(x, y);
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+void Skyline::insert(const Point& corner, double width, double height) {
+    const double top = corner.y;
+    const double bottom = corner.y + height;
+    const Band placed{top, height, corner.x + width};
+
+    std::vector<Band> bands;
+    bands.reserve(bands_.size() + 2);
+    bool added = false;
+    for (const Band& band : bands_) {
+        const double end = band.y + band.length;
+        if (end <= top + TOL || band.y >= bottom - TOL) {
+            if (!added && band.y >= bottom - TOL) {
+                bands.push_back(placed);
+                added = true;
+            }
+            bands.push_back(band);
+            continue;
+        }
+
+        // Keep the parts of the band above and below the rectangle
+        if (band.y < top - TOL) {
+            bands.push_back(Band{band.y, top - band.y, band.x});
+        }
+        if (!added) {
+            bands.push_back(placed);
+            added = true;
+        }
+        if (end > bottom + TOL) {
+            bands.push_back(Band{bottom, end - bottom, band.x});
+        }
+    }
+    if (!added) {
+        bands.push_back(placed);
+    }
+
+    // Join neighbouring bands free from the same x
+    bands_.clear();
+    for (const Band& band : bands) {
+        if (!bands_.empty() && std::abs(bands_.back().x - band.x) < TOL) {
+            bands_.back().length = band.y + band.length - bands_.back().y;
+        } else {
+            bands_.push_back(band);
+        }
+    }
+}
+
+} // namespace deepnest
@@ -71,8 +71,8 @@ void ConfigDialog::createNestingTab() {
     algoForm->addRow("Rotations:", rotationsSpinBox_);
 
     placementTypeCombo_ = new QComboBox();
-    placementTypeCombo_->addItems({"gravity", "boundingbox", "convexhull"});
-    placementTypeCombo_->setToolTip("Placement strategy: gravity=compact down, boundingbox=minimize bbox, convexhull=minimize convex hull");
+    placementTypeCombo_->addItems({"gravity", "boundingbox", "convexhull", "skyline", "raster"});
+    placementTypeCombo_->setToolTip("Placement strategy: gravity=compact down, boundingbox=minimize bbox, convexhull=minimize convex hull, skyline=gravity with rectangles packed without NFPs, raster=gravity on an occupancy bitmap without NFPs");
     algoForm->addRow("Placement Type:", placementTypeCombo_);
 
     gravityDirectionCombo_ = new QComboBox();
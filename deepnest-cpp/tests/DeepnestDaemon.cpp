@@ -0,0 +1,49 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "deepnest/engine/NestingDaemon.h"
+
+using namespace deepnest;
+
+/**
+ * Nesting daemon for DeepNest: runs job files submitted over a loopback
+ * socket on one shared pool with warm caches (see NestingDaemon)
+ *
+ * Usage: DeepnestDaemon [port] [threads] [metricsPort]
+ *
+ * With a metrics port, Prometheus can scrape http://127.0.0.1:<metricsPort>/metrics
+ */
+int main(int argc, char *argv[]) {
+    NestingDaemon::Config config;
+    const int port = argc > 1 ? std::atoi(argv[1]) : config.port;
+    config.threads = argc > 2 ? std::atoi(argv[2]) : 0;
+    const int metricsPort = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    if (port <= 0 || port > 65535 || config.threads < 0 || metricsPort < 0 || metricsPort > 65535) {
+        std::cerr << "Usage: " << argv[0] << " [port] [threads] [metricsPort]" << std::endl;
+        return 1;
+    }
+    config.port = static_cast<unsigned short>(port);
+    config.metricsPort = static_cast<unsigned short>(metricsPort);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "DeepNest C++ Nesting Daemon" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    try {
+        NestingDaemon daemon(config);
+        std::cout << "Listening on 127.0.0.1:" << port << " with "
+                  << (config.threads > 0 ? std::to_string(config.threads) : std::string("all")) << " threads"
+                  << std::endl;
+        if (metricsPort > 0) {
+            std::cout << "Metrics on http://" << config.metricsAddress << ":" << metricsPort << "/metrics"
+                      << std::endl;
+        }
+        daemon.run();
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "deepnest/parallel/RemoteWorker.h"
+
+using namespace deepnest;
+
+/**
+ * Remote evaluation node for DeepNest (see DeepNestConfig::remoteWorkers)
+ *
+ * Usage: DeepnestWorker [port] [threads] [address]
+ *
+ * Listens on 127.0.0.1 unless given another address (0.0.0.0 = every
+ * interface). With DEEPNEST_WORKER_TOKEN set, only masters whose
+ * remoteWorkerToken matches it are served.
+ */
+int main(int argc, char *argv[]) {
+    const int port = argc > 1 ? std::atoi(argv[1]) : 47800;
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 0;
+    const std::string address = argc > 3 ? argv[3] : "127.0.0.1";
+    const char* token = std::getenv("DEEPNEST_WORKER_TOKEN");
+
+    if (port <= 0 || port > 65535 || threads < 0) {
+        std::cerr << "Usage: " << argv[0] << " [port] [threads] [address]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "DeepNest C++ Remote Worker" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    try {
+        RemoteWorkerServer server(static_cast<unsigned short>(port), threads, address, token ? token : "");
+        std::cout << "Listening on " << address << ":" << port << " with "
+                  << (threads > 0 ? std::to_string(threads) : std::string("all")) << " threads"
+                  << (token ? ", token required" : "") << std::endl;
+        server.run();
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -24,10 +24,10 @@ void analyzePolygon(const Polygon& poly, int index) {
     double maxY = std::numeric_limits<double>::lowest();
 
     for (const auto& pt : poly.points) {
-        minX = std::min(minX, pt.x);
-        maxX = std::max(maxX, pt.x);
-        minY = std::min(minY, pt.y);
-        maxY = std::max(maxY, pt.y);
+        minX = std::min<double>(minX, pt.x);
+        maxX = std::max<double>(maxX, pt.x);
+        minY = std::min<double>(minY, pt.y);
+        maxY = std::max<double>(maxY, pt.y);
     }
 
     double width = maxX - minX;
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include "deepnest/config/DeepNestConfig.h"
+#include "deepnest/nfp/NFPCache.h"
+#include "deepnest/nfp/NFPCalculator.h"
+#include "deepnest/parallel/RemoteWorker.h"
+#include "deepnest/placement/EvaluationRecorder.h"
+#include "deepnest/placement/PlacementJob.h"
+#include "deepnest/placement/PlacementWorker.h"
+#include "deepnest/StageTimes.h"
+
+using namespace deepnest;
+
+/**
+ * Runs an evaluation recorded by EvaluationRecorder
+ * (DeepNestConfig::evaluationRecordPath) again, on the calling thread
+ *
+ * Each run starts from a cache holding only the NFPs the original
+ * evaluation found cached, without the placement memo, so runs are
+ * identical and can be profiled (perf, VTune, ...) outside a nest.
+ *
+ * Usage: EvaluationReplay <recording> [runs]
+ */
+int main(int argc, char *argv[]) {
+    const int runs = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (argc < 2 || runs <= 0) {
+        std::cerr << "Usage: " << argv[0] << " <recording> [runs]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "DeepNest C++ Evaluation Replay" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    try {
+        const EvaluationRecorder::Recording recording = EvaluationRecorder::Recording::load(argv[1]);
+
+        // The job's placement settings replace the defaults
+        DeepNestConfig& config = DeepNestConfig::getInstance();
+        std::vector<Polygon> sheets;
+        std::vector<std::shared_ptr<Polygon>> parts;
+        RemoteNode::decodeJob(recording.snapshot, config, sheets, parts);
+        config.placementMemoMaxMemoryMB = 0;
+
+        const PlacementJob job(sheets, parts, config.rotations, config.clipperScale, config.integerGeometry);
+        for (size_t variant : recording.variants) {
+            if (variant >= job.variantCount()) {
+                throw std::runtime_error("Recording does not match its job snapshot");
+            }
+        }
+
+        // Cached NFPs as NFPCalculator prepares them
+        const double scale = config.getClipperScale();
+        std::vector<NFPCache::BatchEntry> cached;
+        for (const auto& entry : recording.nfps) {
+            auto nfps = std::make_shared<std::vector<Polygon>>(*entry.second);
+            for (auto& nfp : *nfps) {
+                if (config.integerGeometry) {
+                    nfp.snapToGrid(scale);
+                } else {
+                    nfp.updateScaledPath(scale);
+                }
+                nfp.updateCoordinates();
+            }
+            cached.push_back(NFPCache::BatchEntry{entry.first, std::move(nfps), 0.0});
+        }
+
+        std::cout << "Job: " << sheets.size() << " sheets, " << parts.size() << " parts, "
+                  << recording.variants.size() << " genes, " << recording.nfps.size() << " cached NFPs"
+                  << std::endl;
+        std::cout << "Recorded: " << recording.wallNs / 1e6 << " ms (median " << recording.medianNs / 1e6
+                  << " ms), fitness " << std::setprecision(12) << recording.fitness
+                  << (recording.bounded ? " (bounded)" : "") << std::endl;
+
+        StageTimer::setEnabled(true);
+        bool matched = true;
+        for (int run = 0; run < runs; ++run) {
+            NFPCache cache;
+            cache.insertBatch(cached);
+            NFPCalculator calculator(cache, config);
+            calculator.setRotationEquivariant(config.nfpRotationEquivariant);
+            PlacementWorker worker(config, calculator);
+
+            const StageTimes before = StageTimer::snapshot();
+            const auto start = std::chrono::steady_clock::now();
+            const PlacementWorker::PlacementResult result =
+                worker.placeParts(job, recording.variants, recording.cutoff);
+            const double ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            const StageTimes stages = StageTimer::snapshot() - before;
+
+            const bool same = result.fitness == recording.fitness && result.bounded == recording.bounded;
+            matched = matched && same;
+            std::cout << "\nRun " << (run + 1) << ": " << ms << " ms, fitness " << result.fitness
+                      << (same ? "" : "  MISMATCH") << std::endl;
+            for (size_t i = 0; i < STAGE_COUNT; ++i) {
+                const Stage stage = static_cast<Stage>(i);
+                if (stages[stage].count > 0) {
+                    std::cout << "  " << std::left << std::setw(16) << StageTimes::name(stage) << std::right
+                              << std::setw(10) << stages[stage].wallNs / 1e6 << " ms  "
+                              << stages[stage].count << " scopes" << std::endl;
+                }
+            }
+        }
+        return matched ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
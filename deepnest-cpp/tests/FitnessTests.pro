@@ -12,6 +12,8 @@ INCLUDEPATH += ../../Clipper2Lib/include/clipper2
 
 # Source files
 SOURCES += FitnessTests.cpp \
+    ../src/core/CoordinateBuffer.cpp \
+    ../src/core/CoordinateKernels.cpp \
     ../src/core/Point.cpp \
     ../src/core/Polygon.cpp \
     ../src/core/Types.cpp \
@@ -20,6 +22,8 @@ SOURCES += FitnessTests.cpp \
     ../src/geometry/GeometryUtilAdvanced.cpp \
     ../src/geometry/PolygonOperations.cpp \
     ../src/geometry/ConvexHull.cpp \
+    ../src/geometry/EdgeGrid.cpp \
+    ../src/geometry/ClipperContext.cpp \
     ../src/geometry/Transformation.cpp \
     ../src/nfp/NFPCache.cpp \
     ../src/nfp/NFPCalculator.cpp \
@@ -27,8 +31,10 @@ SOURCES += FitnessTests.cpp \
     ../src/placement/PlacementStrategy.cpp \
     ../src/placement/PlacementWorker.cpp \
     ../src/placement/MergeDetection.cpp \
+    ../src/algorithm/FeasibleRotations.cpp \
     ../src/algorithm/Individual.cpp \
     ../src/algorithm/Population.cpp \
+    ../src/algorithm/SurrogateFitness.cpp \
     ../src/algorithm/GeneticAlgorithm.cpp \
     ../../Clipper2Lib/src/clipper.engine.cpp \
     ../../Clipper2Lib/src/clipper.offset.cpp \
@@ -13,6 +13,10 @@
  * 4. Polygon operations (already using Clipper2)
  * 5. Curve linearization (Bezier, Arc)
  * 6. NFP advanced functions (CRITICAL - core business logic)
+ * 7. Vectorized coordinate kernels (vs the scalar versions; timings are in
+ *    NFPBenchmark)
+ * 8. Convex Minkowski sums (vs Clipper2 MinkowskiSum)
+ * 9. Weighted parent selection (vs the JavaScript loop)
  */
 
 #include <iostream>
@@ -21,6 +25,8 @@
 #include <cmath>
 #include <string>
 #include <sstream>
+#include <random>
+#include <algorithm>
 
 // DeepNest includes
 #include "deepnest/core/Point.h"
@@ -29,6 +35,12 @@
 #include "deepnest/geometry/ConvexHull.h"
 #include "deepnest/geometry/Transformation.h"
 #include "deepnest/geometry/PolygonOperations.h"
+#include "deepnest/core/CoordinateKernels.h"
+#include "deepnest/algorithm/Population.h"
+
+// Clipper2 for comparison
+#include <clipper2/clipper.h>
+#include <clipper2/clipper.minkowski.h>
 
 // Boost.Geometry for comparison
 #include <boost/geometry.hpp>
@@ -638,6 +650,230 @@ void testTransformation(TestSuite& suite) {
     }
 }
 
+// ============================================================================
+// PHASE 4: Vectorized Coordinate Kernels
+// ============================================================================
+
+// Star-shaped outline with n vertices; integer coordinates put vertices and
+// edges exactly on the grid points used as queries
+void makeOutline(std::mt19937& rng, size_t n, bool integral,
+                 std::vector<double>& x, std::vector<double>& y) {
+    std::uniform_real_distribution<double> radius(40.0, 60.0);
+    x.resize(n);
+    y.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        double angle = 2.0 * M_PI * i / n;
+        double r = radius(rng);
+        x[i] = r * std::cos(angle);
+        y[i] = r * std::sin(angle);
+        if (integral) {
+            x[i] = std::round(x[i]);
+            y[i] = std::round(y[i]);
+        }
+    }
+}
+
+void testCoordinateKernels(TestSuite& suite) {
+    std::cout << "\n=== PHASE 4: Coordinate Kernel Tests ("
+              << CoordinateKernels::instructionSet() << ") ===\n";
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> coordinate(-70.0, 70.0);
+
+    // Agreement with GeometryUtil and the scalar kernels on many outlines
+    {
+        bool areaOk = true, boundsOk = true, transformOk = true, insideOk = true;
+        for (int trial = 0; trial < 500; trial++) {
+            size_t n = 3 + trial % 61;
+            std::vector<double> x, y;
+            makeOutline(rng, n, trial % 3 == 0, x, y);
+
+            std::vector<Point> points;
+            for (size_t i = 0; i < n; i++) {
+                points.push_back(Point(x[i], y[i]));
+            }
+
+            double expectedArea = GeometryUtil::polygonArea(points);
+            double area = CoordinateKernels::area(x.data(), y.data(), n);
+            areaOk = areaOk && almostEqualDouble(area, expectedArea, 1e-9 * std::abs(expectedArea));
+
+            BoundingBox expected = GeometryUtil::getPolygonBounds(points);
+            double minX, minY, maxX, maxY;
+            CoordinateKernels::bounds(x.data(), y.data(), n, minX, minY, maxX, maxY);
+            boundsOk = boundsOk && minX == expected.x && minY == expected.y &&
+                       maxX - minX == expected.width && maxY - minY == expected.height;
+
+            std::vector<double> vx = x, vy = y, sx = x, sy = y;
+            CoordinateKernels::rotate(vx.data(), vy.data(), n, std::cos(0.7), std::sin(0.7));
+            CoordinateKernels::Scalar::rotate(sx.data(), sy.data(), n, std::cos(0.7), std::sin(0.7));
+            CoordinateKernels::translate(vx.data(), vy.data(), n, 3.25, -7.5);
+            CoordinateKernels::Scalar::translate(sx.data(), sy.data(), n, 3.25, -7.5);
+            transformOk = transformOk && vx == sx && vy == sy;
+
+            for (int q = 0; q < 40; q++) {
+                Point p(std::round(coordinate(rng)), std::round(coordinate(rng)));
+                if (q % 8 == 0) {
+                    p = points[q % n];
+                }
+                auto inside = CoordinateKernels::pointInPolygon(x.data(), y.data(), n, p.x, p.y);
+                insideOk = insideOk && inside == GeometryUtil::pointInPolygon(p, points);
+            }
+        }
+
+        suite.addResult("CoordinateKernels - area matches polygonArea", areaOk);
+        suite.addResult("CoordinateKernels - bounds match getPolygonBounds", boundsOk);
+        suite.addResult("CoordinateKernels - rotate/translate match scalar bit for bit", transformOk);
+        suite.addResult("CoordinateKernels - pointInPolygon matches GeometryUtil", insideOk);
+    }
+}
+
+// ============================================================================
+// PHASE 5: Convex Minkowski Sums
+// ============================================================================
+
+Clipper2Lib::PathD toPathD(const std::vector<Point>& polygon) {
+    Clipper2Lib::PathD path;
+    for (const auto& p : polygon) {
+        path.push_back(Clipper2Lib::PointD(p.x, p.y));
+    }
+    return path;
+}
+
+void testConvexMinkowskiSum(TestSuite& suite) {
+    std::cout << "\n=== PHASE 5: Convex Minkowski Sum vs Clipper2 ===\n";
+
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<double> coordinate(-50.0, 50.0);
+    auto randomConvex = [&](size_t count) {
+        std::vector<Point> points;
+        for (size_t i = 0; i < count; i++) {
+            points.push_back(Point(coordinate(rng), coordinate(rng)));
+        }
+        return ConvexHull::computeHull(points);
+    };
+
+    // Test 1: The edge merge covers the same region as Clipper2's sum, for
+    // either winding of either input. Clipper2 only joins the two boundaries,
+    // which leaves a hole where one outline is larger than the other; each
+    // outline moved by the other's first point fills it.
+    {
+        int agreeing = 0;
+        double worst = 0.0;
+        const int trials = 200;
+        for (int trial = 0; trial < trials; trial++) {
+            std::vector<Point> A = randomConvex(3 + trial % 20);
+            std::vector<Point> B = randomConvex(3 + trial % 7);
+            if (trial % 2 == 1) {
+                std::reverse(A.begin(), A.end());
+            }
+            if (trial % 3 == 1) {
+                std::reverse(B.begin(), B.end());
+            }
+
+            std::vector<Point> sum = GeometryUtil::convexMinkowskiSum(A, B);
+            Clipper2Lib::PathsD interiors(2);
+            for (const auto& p : A) {
+                interiors[0].push_back(Clipper2Lib::PointD(p.x + B[0].x, p.y + B[0].y));
+            }
+            for (const auto& p : B) {
+                interiors[1].push_back(Clipper2Lib::PointD(p.x + A[0].x, p.y + A[0].y));
+            }
+            Clipper2Lib::PathsD reference = Clipper2Lib::Union(
+                Clipper2Lib::MinkowskiSum(toPathD(B), toPathD(A), true, 8),
+                interiors, Clipper2Lib::FillRule::NonZero, 8);
+            Clipper2Lib::PathsD difference = Clipper2Lib::Xor(
+                reference, Clipper2Lib::PathsD{toPathD(sum)}, Clipper2Lib::FillRule::NonZero, 8);
+
+            double area = std::abs(GeometryUtil::polygonArea(sum));
+            double error = std::abs(Clipper2Lib::Area(difference)) / area;
+            worst = std::max(worst, error);
+            if (GeometryUtil::polygonArea(sum) < 0 && error < 1e-9) {
+                agreeing++;
+            }
+        }
+
+        std::ostringstream oss;
+        oss << agreeing << " of " << trials << " sums agree, worst area difference "
+            << std::scientific << std::setprecision(1) << worst;
+        suite.addResult("convexMinkowskiSum vs Clipper2 - random convex pairs",
+                       agreeing == trials, oss.str());
+    }
+
+    // Test 2: Only convex outlines take the edge merge
+    {
+        std::vector<Point> square = {
+            Point(0, 0), Point(10, 0), Point(10, 10), Point(5, 10), Point(0, 10)
+        };
+        std::vector<Point> notch = {
+            Point(0, 0), Point(10, 0), Point(10, 10), Point(5, 5), Point(0, 10)
+        };
+        std::vector<Point> pentagram;
+        for (int i = 0; i < 5; i++) {
+            double angle = 4.0 * M_PI * i / 5.0;
+            pentagram.push_back(Point(10 * std::cos(angle), 10 * std::sin(angle)));
+        }
+
+        bool test = GeometryUtil::isConvex(square) && !GeometryUtil::isConvex(notch) &&
+                    !GeometryUtil::isConvex(pentagram);
+        suite.addResult("isConvex - collinear, concave and self-intersecting", test,
+                       test ? "Only the square is convex" : "Misclassified outline");
+    }
+}
+
+// ============================================================================
+// PHASE 6: Weighted Parent Selection
+// ============================================================================
+
+// JavaScript randomWeightedIndividual(): a scan of the weight intervals
+size_t linearWeightedRank(double rand, size_t count) {
+    double lower = 0.0;
+    double weight = 1.0 / count;
+    double upper = weight;
+    for (size_t i = 0; i < count; i++) {
+        if (rand > lower && rand < upper) {
+            return i;
+        }
+        lower = upper;
+        upper += 2.0 * weight * (static_cast<double>(count - i) / count);
+    }
+    return 0;
+}
+
+void testWeightedSelection(TestSuite& suite) {
+    std::cout << "\n=== PHASE 6: Weighted Parent Selection vs JavaScript Loop ===\n";
+
+    // Test 1: Bisection picks the rank the scan picks, for every pool size
+    {
+        std::mt19937 rng(101);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        size_t draws = 0;
+        size_t mismatches = 0;
+        for (size_t count = 1; count <= 500; count++) {
+            for (int i = 0; i < 200; i++) {
+                double rand = dist(rng);
+                draws++;
+                if (Population::weightedRank(rand, count) != linearWeightedRank(rand, count)) {
+                    mismatches++;
+                }
+            }
+        }
+
+        std::ostringstream oss;
+        oss << mismatches << " of " << draws << " draws differ (pool sizes 1-500)";
+        suite.addResult("weightedRank() vs linear scan", mismatches == 0, oss.str());
+    }
+
+    // Test 2: The best rank holds the first interval, the worst the last
+    {
+        bool test = Population::weightedRank(0.0, 1) == 0 &&
+                    Population::weightedRank(0.999999, 1) == 0 &&
+                    Population::weightedRank(0.5 / 50, 50) == 0 &&
+                    Population::weightedRank(0.999999, 50) == linearWeightedRank(0.999999, 50);
+        suite.addResult("weightedRank() - interval ends", test,
+                       test ? "First and last intervals resolved" : "Wrong rank at an interval end");
+    }
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -666,6 +902,15 @@ int main(int argc, char* argv[]) {
         // PHASE 3: Transformation validation
         testTransformation(suite);
 
+        // PHASE 4: Vectorized coordinate kernels
+        testCoordinateKernels(suite);
+
+        // PHASE 5: Convex Minkowski sums
+        testConvexMinkowskiSum(suite);
+
+        // PHASE 6: Weighted parent selection
+        testWeightedSelection(suite);
+
         // Print summary
         suite.printSummary();
 
@@ -0,0 +1,439 @@
+/**
+ * @file NFPBenchmark.cpp
+ * @brief Microbenchmarks of the NFP backends and geometry kernels
+ *
+ * Google Benchmark suite for judging performance changes. Every benchmark
+ * runs over RandomShapeGenerator shape families at several vertex counts,
+ * generated from fixed seeds so runs are repeatable, and reports time per
+ * operation plus "allocs/op", the heap allocations per operation counted
+ * by the operator new replacement below.
+ *
+ * Covered:
+ *   - NFP backends, through NFPCalculator::computeWithBackend (convex
+ *     merge, Clipper2 Minkowski / computeDiffNFP, Boost convolution /
+ *     MinkowskiSum::calculateNFP, orbital noFitPolygon, libnfporb)
+ *   - PolygonOperations union, difference, intersection and offset
+ *   - MergeDetection on polygons and on an EdgeIndex
+ *   - GeometryUtil area, bounds, point-in-polygon, convexity, rotation,
+ *     simplification and intersection
+ *   - CoordinateKernels area, bounds, rotation and point-in-polygon, the
+ *     dispatched vector versions against the scalar ones
+ *
+ * Usage: NFPBenchmark [--benchmark_filter=<regex>] [other Google Benchmark flags]
+ * Benchmark names end in /<family>/<vertices>; families are listed in
+ * FAMILY_NAMES.
+ */
+
+#include "RandomShapeGenerator.h"
+#include "../include/deepnest/nfp/NFPCalculator.h"
+#include "../include/deepnest/nfp/NFPCache.h"
+#include "../include/deepnest/geometry/GeometryUtil.h"
+#include "../include/deepnest/core/CoordinateKernels.h"
+#include "../include/deepnest/geometry/PolygonOperations.h"
+#include "../include/deepnest/placement/MergeDetection.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace deepnest;
+
+// ========== Allocation counting ==========
+
+namespace {
+std::atomic<size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+/**
+ * @brief Counts allocations over the timed loop of a benchmark
+ */
+class AllocationCounter {
+public:
+    explicit AllocationCounter(benchmark::State& state)
+        : state_(state), start_(allocations.load(std::memory_order_relaxed)) {}
+
+    ~AllocationCounter() {
+        const size_t count = allocations.load(std::memory_order_relaxed) - start_;
+        state_.counters["allocs/op"] = benchmark::Counter(static_cast<double>(count),
+                                                          benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& state_;
+    size_t start_;
+};
+
+// ========== Shapes ==========
+
+enum Family { CONVEX, IRREGULAR, STAR, FAMILY_COUNT };
+
+const char* const FAMILY_NAMES[FAMILY_COUNT] = {"convex", "irregular", "star"};
+
+const std::vector<int64_t> VERTEX_COUNTS = {8, 16, 48};
+
+/**
+ * @brief Prepared polygon of a family with about the given vertex count
+ */
+Polygon makeShape(int family, int vertices, unsigned int seed) {
+    std::mt19937 rng(seed);
+    QPainterPath path;
+    switch (family) {
+        case CONVEX:
+            path = RandomShapeGenerator::generateRandomConvexPolygon(vertices, 40.0, 80.0, rng);
+            break;
+        case IRREGULAR:
+            path = RandomShapeGenerator::generateIrregularPolygon(vertices, 40.0, 80.0, 0.6, rng);
+            break;
+        default:
+            path = RandomShapeGenerator::generateStar(vertices / 2, 40.0, 80.0, 0.5, rng);
+            break;
+    }
+
+    Polygon polygon = Polygon::fromQPainterPath(path, static_cast<int>(seed));
+    polygon.source = static_cast<int>(seed);
+    polygon.updateConvexity();
+    polygon.updateFingerprint();
+    return polygon;
+}
+
+Polygon shapeA(const benchmark::State& state) {
+    return makeShape(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)), 1);
+}
+
+Polygon shapeB(const benchmark::State& state) {
+    return makeShape(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)), 2);
+}
+
+void familyArgs(benchmark::internal::Benchmark* b, bool convexOnly = false) {
+    b->ArgNames({"family", "vertices"});
+    for (int family = 0; family < FAMILY_COUNT; family++) {
+        if (convexOnly && family != CONVEX) {
+            continue;
+        }
+        for (int64_t vertices : VERTEX_COUNTS) {
+            b->Args({family, vertices});
+        }
+    }
+}
+
+// ========== NFP backends ==========
+
+void BM_NFP(benchmark::State& state, NFPBackend backend) {
+    NFPCache cache;
+    NFPCalculator calculator(cache);
+    const Polygon A = shapeA(state);
+    const Polygon B = shapeB(state);
+    if (!NFPBackendSelector::supports(backend, NFPBackendSelector::classify(A, B))) {
+        state.SkipWithError("backend does not support this pair class");
+        return;
+    }
+
+    size_t points = 0;
+    {
+        AllocationCounter counter(state);
+        for (auto _ : state) {
+            Polygon nfp = calculator.computeWithBackend(backend, A, B);
+            points = nfp.points.size();
+            benchmark::DoNotOptimize(nfp);
+        }
+    }
+    state.counters["vertices"] = static_cast<double>(A.points.size());
+    state.counters["nfpPoints"] = static_cast<double>(points);
+}
+
+// ========== PolygonOperations ==========
+
+void BM_Union(benchmark::State& state) {
+    // A row of overlapping copies, as when placed NFPs are combined
+    std::vector<std::vector<Point>> polygons;
+    const Polygon shape = shapeA(state);
+    for (int i = 0; i < 8; i++) {
+        polygons.push_back(shape.translate(i * 40.0, (i % 2) * 20.0).points);
+    }
+
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PolygonOperations::unionPolygons(polygons));
+    }
+}
+
+void BM_Difference(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    const std::vector<Point> b = shapeB(state).translate(30.0, 30.0).points;
+
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PolygonOperations::differencePolygons(a, b));
+    }
+}
+
+void BM_Intersection(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    const std::vector<Point> b = shapeB(state).translate(30.0, 30.0).points;
+
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PolygonOperations::intersectPolygons(a, b));
+    }
+}
+
+void BM_Offset(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PolygonOperations::offset(a, 2.0));
+    }
+}
+
+// ========== MergeDetection ==========
+
+// A grid of placed parts sharing edges with the part being tested
+std::vector<Polygon> placedGrid(const Polygon& shape) {
+    const BoundingBox bounds = shape.bounds();
+    std::vector<Polygon> placed;
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            if (row != 1 || col != 1) {
+                placed.push_back(shape.translate(col * bounds.width, row * bounds.height));
+            }
+        }
+    }
+    return placed;
+}
+
+void BM_MergedLength(benchmark::State& state) {
+    const Polygon shape = shapeA(state);
+    const BoundingBox bounds = shape.bounds();
+    const std::vector<Polygon> placed = placedGrid(shape);
+    const Polygon part = shape.translate(bounds.width, bounds.height);
+
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MergeDetection::calculateMergedLength(placed, part, 0.5, 0.1));
+    }
+}
+
+void BM_MergedLengthIndexed(benchmark::State& state) {
+    const Polygon shape = shapeA(state);
+    const BoundingBox bounds = shape.bounds();
+    const MergeDetection::EdgeIndex index(placedGrid(shape), 0.5, 0.1);
+    const Point offset(bounds.width, bounds.height);
+
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MergeDetection::calculateMergedLength(index, shape, offset, 0.5, 0.1));
+    }
+}
+
+// ========== GeometryUtil ==========
+
+void BM_PolygonArea(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::polygonArea(a));
+    }
+}
+
+void BM_PolygonBounds(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::getPolygonBounds(a));
+    }
+}
+
+void BM_PointInPolygon(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    const BoundingBox bounds = GeometryUtil::getPolygonBounds(a);
+    const Point probe(bounds.x + bounds.width / 2, bounds.y + bounds.height / 3);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::pointInPolygon(probe, a));
+    }
+}
+
+void BM_IsConvex(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::isConvex(a));
+    }
+}
+
+void BM_RotatePolygon(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::rotatePolygon(a, 37.0));
+    }
+}
+
+void BM_SimplifyPolygon(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::simplifyPolygon(a, 0.3));
+    }
+}
+
+void BM_Intersect(benchmark::State& state) {
+    const std::vector<Point> a = shapeA(state).points;
+    const std::vector<Point> b = shapeB(state).translate(30.0, 30.0).points;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeometryUtil::intersect(a, b));
+    }
+}
+
+// ========== CoordinateKernels ==========
+
+// Vector kernels only pull ahead on long outlines
+const std::vector<int64_t> KERNEL_VERTEX_COUNTS = {16, 256, 1024};
+
+void kernelArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"family", "vertices"});
+    for (int family = 0; family < FAMILY_COUNT; family++) {
+        for (int64_t vertices : KERNEL_VERTEX_COUNTS) {
+            b->Args({family, vertices});
+        }
+    }
+}
+
+/**
+ * @brief Shape A as the separate coordinate arrays the kernels take
+ */
+void kernelCoordinates(const benchmark::State& state, std::vector<double>& x, std::vector<double>& y) {
+    for (const auto& p : shapeA(state).points) {
+        x.push_back(p.x);
+        y.push_back(p.y);
+    }
+}
+
+using AreaKernel = double (*)(const double*, const double*, size_t);
+using BoundsKernel = void (*)(const double*, const double*, size_t, double&, double&, double&, double&);
+using RotateKernel = void (*)(double*, double*, size_t, double, double);
+using InsideKernel = std::optional<bool> (*)(const double*, const double*, size_t, double, double, double);
+
+void BM_KernelArea(benchmark::State& state, AreaKernel kernel) {
+    std::vector<double> x, y;
+    kernelCoordinates(state, x, y);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernel(x.data(), y.data(), x.size()));
+    }
+}
+
+void BM_KernelBounds(benchmark::State& state, BoundsKernel kernel) {
+    std::vector<double> x, y;
+    kernelCoordinates(state, x, y);
+    double minX, minY, maxX, maxY;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        kernel(x.data(), y.data(), x.size(), minX, minY, maxX, maxY);
+        benchmark::DoNotOptimize(minX);
+        benchmark::DoNotOptimize(maxY);
+    }
+}
+
+void BM_KernelRotate(benchmark::State& state, RotateKernel kernel) {
+    std::vector<double> x, y;
+    kernelCoordinates(state, x, y);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        // Tiny turns keep the outline in range over all iterations
+        kernel(x.data(), y.data(), x.size(), std::cos(1e-6), std::sin(1e-6));
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_KernelPointInPolygon(benchmark::State& state, InsideKernel kernel) {
+    std::vector<double> x, y;
+    kernelCoordinates(state, x, y);
+    const BoundingBox bounds = shapeA(state).bounds();
+    const Point probe(bounds.x + bounds.width / 2, bounds.y + bounds.height / 3);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernel(x.data(), y.data(), x.size(), probe.x, probe.y, TOL));
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(BM_NFP, convex, NFPBackend::Convex)->Apply([](benchmark::internal::Benchmark* b) {
+    familyArgs(b, true);
+});
+BENCHMARK_CAPTURE(BM_NFP, clipper_minkowski, NFPBackend::ClipperMinkowski)->Apply([](benchmark::internal::Benchmark* b) {
+    familyArgs(b);
+});
+BENCHMARK_CAPTURE(BM_NFP, boost_convolution, NFPBackend::BoostConvolution)->Apply([](benchmark::internal::Benchmark* b) {
+    familyArgs(b);
+});
+BENCHMARK_CAPTURE(BM_NFP, orbital, NFPBackend::Orbital)->Apply([](benchmark::internal::Benchmark* b) {
+    familyArgs(b);
+});
+BENCHMARK_CAPTURE(BM_NFP, libnfporb, NFPBackend::Libnfporb)->Apply([](benchmark::internal::Benchmark* b) {
+    familyArgs(b);
+});
+
+BENCHMARK(BM_Union)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_Difference)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_Intersection)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_Offset)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+
+BENCHMARK(BM_MergedLength)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_MergedLengthIndexed)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+
+BENCHMARK(BM_PolygonArea)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_PolygonBounds)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_PointInPolygon)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_IsConvex)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_RotatePolygon)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_SimplifyPolygon)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+BENCHMARK(BM_Intersect)->Apply([](benchmark::internal::Benchmark* b) { familyArgs(b); });
+
+BENCHMARK_CAPTURE(BM_KernelArea, scalar, &CoordinateKernels::Scalar::area)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelArea, vector, &CoordinateKernels::area)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelBounds, scalar, &CoordinateKernels::Scalar::bounds)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelBounds, vector, &CoordinateKernels::bounds)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelRotate, scalar, &CoordinateKernels::Scalar::rotate)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelRotate, vector, &CoordinateKernels::rotate)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelPointInPolygon, scalar, &CoordinateKernels::Scalar::pointInPolygon)->Apply(kernelArgs);
+BENCHMARK_CAPTURE(BM_KernelPointInPolygon, vector, &CoordinateKernels::pointInPolygon)->Apply(kernelArgs);
+
+BENCHMARK_MAIN();
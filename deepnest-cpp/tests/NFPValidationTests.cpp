@@ -13,6 +13,9 @@
  * 4. NFP calculation - simple cases with known results
  * 5. NFP calculation - complex cases (concave polygons)
  * 6. Comparison with existing working test cases
+ * 7. NFP storage - round trips and corrupt input
+ * 8. Checkpoint and resume of a nesting run
+ * 9. Shortcut paths vs the paths they replace
  *
  * NFP Functions Under Test:
  * - pointDistance() - Distance from point to line with direction
@@ -23,6 +26,14 @@
  * - generateTranslationVectors() - Generate candidate slide vectors
  * - isBacktracking() - Detect invalid backtracking moves
  * - noFitPolygon() - Main NFP calculation function (CRITICAL)
+ * - NFPCache::encodeCompact()/decodeCompact() - Compact cache entries
+ * - PersistentNFPStore - On-disk NFP store, including torn-tail recovery
+ * - JobFile - Binary job container
+ * - NestingEngine::saveCheckpoint()/loadCheckpoint() - Resumable runs
+ * - NFPCalculator mirrored NFPs - NFP(A,B) reflected from a cached NFP(B,A)
+ * - NFPCalculator::getInnerNFP() - Analytic inner NFP of rectangular sheets
+ * - trunk::MinkowskiSum::calculateNFP() - Batched Boost.Polygon convolution
+ * - polygonsOverlap()/searchStartPoints() - Orbital start and trace checks
  */
 
 #include <iostream>
@@ -32,13 +43,32 @@
 #include <string>
 #include <sstream>
 #include <optional>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <filesystem>
+#include <fstream>
 
 // DeepNest includes
 #include "deepnest/core/Point.h"
+#include "deepnest/core/Polygon.h"
 #include "deepnest/core/Types.h"
 #include "deepnest/geometry/GeometryUtil.h"
 #include "deepnest/geometry/GeometryUtilAdvanced.h"
 #include "deepnest/geometry/OrbitalTypes.h"
+#include "deepnest/nfp/NFPCache.h"
+#include "deepnest/nfp/NFPCalculator.h"
+#include "deepnest/nfp/MinkowskiSum.h"
+#include "deepnest/nfp/PersistentNFPStore.h"
+#include "deepnest/converters/JobFile.h"
+#include "deepnest/config/DeepNestConfig.h"
+#include "deepnest/engine/NestingEngine.h"
+
+// Clipper2 for region comparisons
+#include <clipper2/clipper.h>
+
+// Boost.Polygon for the reference convolution
+#include <boost/polygon/polygon.hpp>
 
 using namespace deepnest;
 
@@ -832,6 +862,791 @@ void testNFPRegressionCases(NFPTestSuite& suite) {
     }
 }
 
+// ============================================================================
+// PHASE 7: NFP Storage (round trips and corrupt input)
+// ============================================================================
+
+Polygon squareRing(double x, double y, double size) {
+    Polygon polygon;
+    polygon.points = {
+        Point(x, y), Point(x + size, y), Point(x + size, y + size), Point(x, y + size)
+    };
+    return polygon;
+}
+
+// Outline with a hole that has an island of its own, and a second hole
+Polygon nestedRings() {
+    Polygon outer = squareRing(0.125, -3.5, 100.25);
+    Polygon hole = squareRing(10.3333333, 10.6666667, 50);
+    hole.children.push_back(squareRing(20.2, 20.7, 10.1));
+    outer.children.push_back(hole);
+    outer.children.push_back(squareRing(70.05, 70.95, 10));
+    return outer;
+}
+
+// Fresh path in the temporary directory
+std::string tempPath(const std::string& name) {
+    const auto path = std::filesystem::temp_directory_path() / ("deepnest-validation-" + name);
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+bool almostEqualTree(const Polygon& a, const Polygon& b, double tolerance = 1e-6) {
+    if (!almostEqualPolygon(a.points, b.points, tolerance) ||
+        a.children.size() != b.children.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.children.size(); i++) {
+        if (!almostEqualTree(a.children[i], b.children[i], tolerance)) return false;
+    }
+    return true;
+}
+
+bool almostEqualTrees(const std::vector<Polygon>& a, const std::vector<Polygon>& b,
+                      double tolerance = 1e-6) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!almostEqualTree(a[i], b[i], tolerance)) return false;
+    }
+    return true;
+}
+
+void testCompactNFPEncoding(NFPTestSuite& suite) {
+    suite.setPhase("PHASE 7: NFP Storage - Round Trips and Corrupt Input");
+
+    const double scale = 1e7;
+    const std::vector<Polygon> nfp = { nestedRings(), squareRing(-5.5, 3.25, 7.75) };
+
+    // Test 1: Points come back on the grid, holes keep their nesting
+    {
+        auto packed = NFPCache::encodeCompact(nfp, scale);
+        auto decoded = NFPCache::decodeCompact(packed.data(), packed.size(), scale);
+
+        bool test = almostEqualTrees(decoded, nfp, 1.0 / scale);
+        suite.addResult("encodeCompact - round trip with nested holes", test,
+                       std::to_string(packed.size()) + " bytes for 20 points");
+    }
+
+    // Test 2: A cache with compact storage returns what was inserted
+    {
+        NFPCache cache;
+        cache.setCompactStorage(scale);
+        NFPCache::NFPKey key(1, 2, 0, 90);
+        cache.insert(key, nfp);
+
+        std::vector<Polygon> found;
+        bool test = cache.find(key, found) && almostEqualTrees(found, nfp, 1.0 / scale);
+        suite.addResult("NFPCache - compact entry round trip", test,
+                       test ? "Entry decoded on lookup" : "Lookup differs from insert");
+    }
+
+    // Test 3: Truncated and empty entries are rejected, not decoded
+    {
+        auto packed = NFPCache::encodeCompact(nfp, scale);
+        int rejected = 0;
+        for (size_t size : {size_t(0), size_t(1), packed.size() / 2, packed.size() - 1}) {
+            try {
+                NFPCache::decodeCompact(packed.data(), size, scale);
+            } catch (const std::runtime_error&) {
+                rejected++;
+            }
+        }
+
+        suite.addResult("decodeCompact - truncated entries", rejected == 4,
+                       std::to_string(rejected) + " of 4 truncations rejected");
+    }
+}
+
+void testPersistentNFPStore(NFPTestSuite& suite) {
+    const std::string path = tempPath("nfp-store.bin");
+    const std::vector<Polygon> first = { nestedRings() };
+    const std::vector<Polygon> second = { squareRing(-5.5, 3.25, 7.75), squareRing(40, 40, 3) };
+    const PersistentNFPStore::Key firstKey(11, 12, 0, 90, false);
+    const PersistentNFPStore::Key secondKey(11, 13, 180, 0, true);
+
+    // Test 1: Records appended by one store are found by the next
+    uintmax_t firstEnd = 0;
+    {
+        {
+            PersistentNFPStore store(2.0, 0.3);
+            store.open(path);
+            store.append(firstKey, first);
+        }
+        firstEnd = std::filesystem::file_size(path);
+        {
+            PersistentNFPStore store(2.0, 0.3);
+            store.open(path);
+            store.append(secondKey, second);
+        }
+
+        PersistentNFPStore store(2.0, 0.3);
+        std::vector<Polygon> foundFirst, foundSecond;
+        bool test = store.open(path) && store.size() == 2 &&
+                    store.find(firstKey, foundFirst) && almostEqualTrees(foundFirst, first, 1e-9) &&
+                    store.find(secondKey, foundSecond) && almostEqualTrees(foundSecond, second, 1e-9);
+        suite.addResult("PersistentNFPStore - round trip across opens", test,
+                       std::to_string(store.size()) + " NFPs after reopening");
+    }
+
+    // Test 2: NFPs computed with other spacing are not reused
+    {
+        PersistentNFPStore store(3.0, 0.3);
+        std::vector<Polygon> found;
+        bool test = store.open(path) && store.size() == 0 && !store.find(firstKey, found);
+        suite.addResult("PersistentNFPStore - other spacing ignored", test,
+                       std::to_string(store.size()) + " NFPs indexed (expected 0)");
+    }
+
+    // Test 3: A torn tail is truncated; the records before it and later
+    // appends stay reachable
+    {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+        bool recovered = false;
+        {
+            PersistentNFPStore store(2.0, 0.3);
+            std::vector<Polygon> found;
+            recovered = store.open(path) && store.size() == 1 &&
+                        store.find(firstKey, found) && !store.find(secondKey, found) &&
+                        std::filesystem::file_size(path) == firstEnd;
+            store.append(secondKey, second);
+        }
+
+        PersistentNFPStore store(2.0, 0.3);
+        std::vector<Polygon> found;
+        bool test = recovered && store.open(path) && store.size() == 2 &&
+                    store.find(secondKey, found) && almostEqualTrees(found, second, 1e-9);
+        suite.addResult("PersistentNFPStore - torn tail truncated", test,
+                       recovered ? "Append after truncation found on reopen"
+                                 : "Torn record not dropped on open");
+    }
+
+    // Test 4: A record whose checksum fails ends the index there
+    {
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-1, std::ios::end);
+            file.put('\x7f');
+        }
+
+        PersistentNFPStore store(2.0, 0.3);
+        std::vector<Polygon> found;
+        bool test = store.open(path) && store.size() == 1 &&
+                    store.find(firstKey, found) && !store.find(secondKey, found);
+        suite.addResult("PersistentNFPStore - damaged record dropped", test,
+                       std::to_string(store.size()) + " NFPs indexed (expected 1)");
+    }
+
+    // Test 5: A file that is not a store is left alone
+    {
+        const std::string other = tempPath("not-a-store.bin");
+        {
+            std::ofstream file(other, std::ios::binary);
+            file << "not an NFP store, just some text";
+        }
+
+        PersistentNFPStore store(2.0, 0.3);
+        bool test = !store.open(other) && !store.isOpen() &&
+                    std::filesystem::file_size(other) == 32;
+        suite.addResult("PersistentNFPStore - foreign file rejected", test,
+                       test ? "Not opened, not modified" : "Foreign file opened or changed");
+        std::filesystem::remove(other);
+    }
+
+    // Test 6: A record another store appends after open() is found on a miss
+    {
+        std::filesystem::remove(path);
+        PersistentNFPStore reader(2.0, 0.3);
+        PersistentNFPStore writer(2.0, 0.3);
+        std::vector<Polygon> found;
+        bool test = reader.open(path) && writer.open(path) && !reader.find(firstKey, found);
+        writer.append(firstKey, first);
+        test = test && reader.find(firstKey, found) && almostEqualTrees(found, first, 1e-9) &&
+               reader.size() == 1;
+        suite.addResult("PersistentNFPStore - later appends of others found", test,
+                       std::to_string(reader.size()) + " NFPs indexed by the reader (expected 1)");
+    }
+
+    std::filesystem::remove(path);
+}
+
+void testJobFile(NFPTestSuite& suite) {
+    const std::string path = tempPath("job.bin");
+    const std::string config = "{\"spacing\":2}";
+
+    Polygon part = nestedRings();
+    part.points[1].exact = false;
+    const Polygon sheet = squareRing(0, 0, 1000);
+    const std::vector<JobFile::Item> items = {
+        JobFile::Item(part, 3, "part-a", false),
+        JobFile::Item(sheet, 1, "sheet", true)
+    };
+    JobFile::StoredNfp stored;
+    stored.key = PersistentNFPStore::Key(1, 2, 90, 0, false);
+    stored.polygons = { part, sheet };
+    JobFile::write(path, config, items, { stored });
+
+    // Test 1: Items, holes, exact flags and NFPs read back as written
+    {
+        JobFile job;
+        bool opened = job.open(path);
+        bool test = opened && job.config() == config && job.itemCount() == 2 &&
+                    job.quantity(0) == 3 && job.name(0) == "part-a" && !job.isSheet(0) &&
+                    job.ringCount(0) == 4 && almostEqualTree(job.polygon(0), part, 1e-9) &&
+                    !job.polygon(0).points[1].exact && job.polygon(0).points[2].exact &&
+                    job.quantity(1) == 1 && job.isSheet(1) &&
+                    almostEqualTree(job.polygon(1), sheet, 1e-9) &&
+                    job.nfpCount() == 1 && job.nfpKey(0) == stored.key &&
+                    almostEqualTrees(job.nfp(0), stored.polygons, 1e-9);
+        suite.addResult("JobFile - round trip", test,
+                       opened ? std::to_string(job.itemCount()) + " items, " +
+                                    std::to_string(job.nfpCount()) + " NFP"
+                              : job.error());
+    }
+
+    // Test 2: Truncated, foreign and missing files are refused with a reason
+    {
+        const auto size = std::filesystem::file_size(path);
+        int refused = 0;
+        std::string reasons;
+        auto check = [&](const std::string& file) {
+            JobFile job;
+            if (!job.open(file) && !job.error().empty()) {
+                refused++;
+                reasons = job.error();
+            }
+        };
+
+        const std::string damaged = tempPath("job-damaged.bin");
+        for (auto length : { decltype(size)(4), decltype(size)(24), size / 2 }) {
+            std::filesystem::copy_file(path, damaged, std::filesystem::copy_options::overwrite_existing);
+            std::filesystem::resize_file(damaged, length);
+            check(damaged);
+        }
+
+        std::filesystem::copy_file(path, damaged, std::filesystem::copy_options::overwrite_existing);
+        {
+            std::fstream file(damaged, std::ios::binary | std::ios::in | std::ios::out);
+            file.put('X');
+        }
+        check(damaged);
+
+        {
+            std::ofstream file(damaged, std::ios::binary | std::ios::trunc);
+            file << "not a job file, just some text";
+        }
+        check(damaged);
+
+        std::filesystem::remove(damaged);
+        check(damaged);
+
+        suite.addResult("JobFile - corrupt input refused", refused == 6,
+                       std::to_string(refused) + " of 6 files refused", reasons);
+    }
+
+    std::filesystem::remove(path);
+}
+
+// ============================================================================
+// PHASE 8: Checkpoint and Resume
+// ============================================================================
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void testCheckpointResume(NFPTestSuite& suite) {
+    suite.setPhase("PHASE 8: Checkpoint and Resume");
+
+    const std::string path = tempPath("checkpoint.bin");
+    DeepNestConfig config = DeepNestConfig::getInstance();
+    config.populationSize = 6;
+    config.rotations = 4;
+    config.spacing = 0;
+    config.checkpointPath = path;
+    config.checkpointGenerations = 1;
+
+    const std::vector<Polygon> parts = {
+        squareRing(0, 0, 40), squareRing(0, 0, 25), nestedRings()
+    };
+    const std::vector<int> quantities = { 2, 3, 1 };
+    const std::vector<Polygon> sheets = { squareRing(0, 0, 300) };
+
+    // A run of a few generations leaves its checkpoint behind
+    double fitness = 0.0;
+    {
+        NestingEngine engine(config);
+        engine.initialize(parts, quantities, sheets, { 1 });
+        engine.start(nullptr, nullptr, 3);
+        while (engine.step()) {
+            engine.waitForEvaluation(10);
+        }
+        engine.stop();
+        fitness = engine.getProgress().bestFitness;
+    }
+    const std::string saved = readFile(path);
+
+    // Test 1: A fresh engine restores the run, and saves it unchanged
+    {
+        NestingEngine engine(config);
+        engine.initialize(parts, quantities, sheets, { 1 });
+        bool loaded = engine.loadCheckpoint(path);
+
+        const std::string again = tempPath("checkpoint-again.bin");
+        engine.saveCheckpoint(again);
+        const auto best = engine.getBestResult();
+        bool test = loaded && !saved.empty() && readFile(again) == saved &&
+                    best && best->fitness == fitness;
+        suite.addResult("loadCheckpoint - round trip", test,
+                       loaded ? std::to_string(saved.size()) + " bytes, best fitness " +
+                                    std::to_string(fitness)
+                              : "Checkpoint not loaded");
+        std::filesystem::remove(again);
+    }
+
+    // Test 2: Damaged, foreign and missing checkpoints are refused
+    {
+        int refused = 0;
+        auto check = [&](const std::vector<Polygon>& jobParts) {
+            NestingEngine engine(config);
+            engine.initialize(jobParts, quantities, sheets, { 1 });
+            if (!engine.loadCheckpoint(path)) {
+                refused++;
+            }
+        };
+
+        // Another job: one part is larger
+        std::vector<Polygon> otherParts = parts;
+        otherParts[0] = squareRing(0, 0, 45);
+        check(otherParts);
+
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(saved.size() / 2));
+            file.put(static_cast<char>(saved[saved.size() / 2] ^ 0x5a));
+        }
+        check(parts);
+
+        std::filesystem::resize_file(path, saved.size() - 3);
+        check(parts);
+
+        std::filesystem::remove(path);
+        check(parts);
+
+        suite.addResult("loadCheckpoint - corrupt input refused", refused == 4,
+                       std::to_string(refused) + " of 4 checkpoints refused");
+    }
+}
+
+// ============================================================================
+// PHASE 9: Shortcut Paths vs the Paths They Replace
+// ============================================================================
+
+Clipper2Lib::PathsD toPathsD(const Polygon& polygon) {
+    Clipper2Lib::PathsD paths(1);
+    for (const auto& p : polygon.points) {
+        paths[0].push_back(Clipper2Lib::PointD(p.x, p.y));
+    }
+    for (const auto& child : polygon.children) {
+        Clipper2Lib::PathsD inner = toPathsD(child);
+        paths.insert(paths.end(), inner.begin(), inner.end());
+    }
+    return paths;
+}
+
+// Area covered by exactly one of the two NFPs, relative to the first; the
+// same region may start at another vertex or run the other way
+double regionDifference(const Polygon& a, const Polygon& b) {
+    Clipper2Lib::PathsD difference = Clipper2Lib::Xor(
+        toPathsD(a), toPathsD(b), Clipper2Lib::FillRule::EvenOdd, 8);
+    return std::abs(Clipper2Lib::Area(difference)) / std::abs(GeometryUtil::polygonArea(a.points));
+}
+
+// Concave outline: a star with the given number of tips
+Polygon starRing(int tips, double outer, double inner, double x, double y) {
+    Polygon polygon;
+    for (int i = 0; i < 2 * tips; i++) {
+        double angle = M_PI * i / tips;
+        double radius = (i % 2 == 0) ? outer : inner;
+        polygon.points.push_back(Point(x + radius * std::cos(angle), y + radius * std::sin(angle)));
+    }
+    return polygon;
+}
+
+void testMirroredNFP(NFPTestSuite& suite) {
+    suite.setPhase("PHASE 9.1: Mirrored NFP vs Direct Computation");
+
+    DeepNestConfig config = DeepNestConfig::getInstance();
+
+    Polygon lShape;
+    lShape.id = 1;
+    lShape.points = {
+        Point(0, 0), Point(60, 0), Point(60, 20), Point(20, 20), Point(20, 50), Point(0, 50)
+    };
+    Polygon star = starRing(5, 25, 10, 7.5, -3.25);
+    star.id = 2;
+    Polygon turned = star.rotate(90);
+    turned.id = 2;
+    turned.rotation = 90;
+
+    struct Pair { const char* name; Polygon A; Polygon B; };
+    const std::vector<Pair> pairs = {
+        {"L-shape and star", lShape, star},
+        {"star and L-shape", star, lShape},
+        {"L-shape and rotated star", lShape, turned}
+    };
+
+    for (const auto& pair : pairs) {
+        // Reflected: NFP(B,A) is cached first, so NFP(A,B) is its mirror
+        NFPCache mirrorCache;
+        NFPCalculator mirroring(mirrorCache, config);
+        mirroring.getOuterNFP(pair.B, pair.A);
+        Polygon reflected = mirroring.getOuterNFP(pair.A, pair.B);
+        size_t mirrored = mirroring.getComputeStats().mirrored;
+
+        // Direct: a calculator that has seen nothing else
+        NFPCache directCache;
+        NFPCalculator direct(directCache, config);
+        Polygon computed = direct.getOuterNFP(pair.A, pair.B);
+
+        bool test = false;
+        std::ostringstream oss;
+        if (computed.points.empty() || reflected.points.empty()) {
+            oss << "Empty NFP";
+        } else {
+            double error = regionDifference(computed, reflected);
+            test = mirrored == 1 && direct.getComputeStats().mirrored == 0 && error < 1e-9;
+            oss << mirrored << " mirrored, area difference " << std::scientific
+                << std::setprecision(1) << error;
+        }
+        suite.addResult(std::string("Mirrored NFP - ") + pair.name, test, oss.str(),
+                       "NFP(A,B) = -NFP(B,A) + A[0] + B[0] must equal the computed NFP");
+    }
+}
+
+void testRectangleInnerNFP(NFPTestSuite& suite) {
+    suite.setPhase("PHASE 9.2: Analytic Rectangle Inner NFP vs Frame NFP");
+
+    DeepNestConfig config = DeepNestConfig::getInstance();
+
+    Polygon sheet = squareRing(10, -5, 300);
+    sheet.points[2].y += 100;
+    sheet.points[3].y += 100;
+    sheet.id = 10;
+    Polygon clockwise = sheet;
+    std::reverse(clockwise.points.begin(), clockwise.points.end());
+    std::rotate(clockwise.points.begin(), clockwise.points.begin() + 2, clockwise.points.end());
+
+    Polygon lShape;
+    lShape.id = 1;
+    lShape.points = {
+        Point(0, 0), Point(60, 0), Point(60, 20), Point(20, 20), Point(20, 50), Point(0, 50)
+    };
+    Polygon star = starRing(5, 25, 10, 7.5, -3.25);
+    star.id = 2;
+    Polygon turned = star.rotate(37);
+    turned.id = 2;
+    turned.rotation = 37;
+
+    struct Pair { const char* name; Polygon A; Polygon B; };
+    const std::vector<Pair> pairs = {
+        {"L-shape in sheet", sheet, lShape},
+        {"star in clockwise sheet", clockwise, star},
+        {"rotated star in sheet", sheet, turned}
+    };
+
+    for (const auto& pair : pairs) {
+        NFPCache cache;
+        NFPCalculator calculator(cache, config);
+        std::vector<Polygon> analytic = calculator.getInnerNFP(pair.A, pair.B);
+
+        // What the frame path of getInnerNFP returns for other sheets
+        Polygon frameNfp = calculator.getOuterNFP(calculator.getFrame(pair.A), pair.B, true);
+        const std::vector<Polygon>& framed = frameNfp.children;
+
+        // The frame NFP is convolved on an integer grid where the sheet and
+        // the part each round by up to a unit, so its corners may be up to
+        // two units away from the exact ones
+        bool test = false;
+        std::ostringstream oss;
+        if (analytic.size() != 1 || framed.size() != 1) {
+            oss << analytic.size() << " analytic and " << framed.size() << " frame regions";
+        } else {
+            bool sameWinding = (GeometryUtil::polygonArea(analytic[0].points) < 0) ==
+                               (GeometryUtil::polygonArea(framed[0].points) < 0);
+            BoundingBox exact = analytic[0].bounds();
+            BoundingBox traced = framed[0].bounds();
+            double offset = std::max({
+                std::abs(exact.x - traced.x), std::abs(exact.y - traced.y),
+                std::abs(exact.x + exact.width - traced.x - traced.width),
+                std::abs(exact.y + exact.height - traced.y - traced.height)});
+            double fill = std::abs(GeometryUtil::polygonArea(framed[0].points)) /
+                          (traced.width * traced.height);
+            test = sameWinding && offset <= 2.0 && almostEqualDouble(fill, 1.0);
+            oss << (sameWinding ? "same winding" : "opposite winding") << ", corners "
+                << std::fixed << std::setprecision(3) << offset << " apart";
+        }
+        suite.addResult(std::string("Rectangle inner NFP - ") + pair.name, test, oss.str(),
+                       "The analytic rectangle must match the frame NFP's region and winding");
+    }
+
+    // A part larger than the sheet fits nowhere on either path
+    {
+        NFPCache cache;
+        NFPCalculator calculator(cache, config);
+        Polygon large = squareRing(0, 0, 350);
+        large.id = 3;
+        std::vector<Polygon> analytic = calculator.getInnerNFP(sheet, large);
+        Polygon frameNfp = calculator.getOuterNFP(calculator.getFrame(sheet), large, true);
+
+        bool test = analytic.empty() && frameNfp.children.empty();
+        suite.addResult("Rectangle inner NFP - part larger than sheet", test,
+                       std::to_string(analytic.size()) + " analytic and " +
+                       std::to_string(frameNfp.children.size()) + " frame regions");
+    }
+}
+
+// Boost.Polygon convolution that inserts one polygon per edge pair, as in
+// minkowski.cc; the batched kernel must build the same set
+namespace quadconvolution {
+
+using namespace boost::polygon;
+typedef point_data<int> IntPoint;
+typedef polygon_data<int> IntPolygon;
+typedef polygon_with_holes_data<int> IntPolygonWithHoles;
+typedef polygon_set_data<int> IntPolygonSet;
+
+template <typename itrT1, typename itrT2>
+void convolveSequences(IntPolygonSet& result, itrT1 ab, itrT1 ae, itrT2 bb, itrT2 be) {
+    if (ab == ae || bb == be) return;
+    IntPoint prevA = *ab;
+    IntPolygon quad;
+    for (++ab; ab != ae; ++ab) {
+        IntPoint prevB = *bb;
+        for (itrT2 tmpb = std::next(bb); tmpb != be; ++tmpb) {
+            std::vector<IntPoint> figure = {prevB, prevB, *tmpb, *tmpb};
+            convolve(figure[0], *ab);
+            convolve(figure[1], prevA);
+            convolve(figure[2], prevA);
+            convolve(figure[3], *ab);
+            set_points(quad, figure.begin(), figure.end());
+            result.insert(quad);
+            prevB = *tmpb;
+        }
+        prevA = *ab;
+    }
+}
+
+template <typename itrT>
+void convolveWithPolygons(IntPolygonSet& result, itrT b, itrT e,
+                          const std::vector<IntPolygonWithHoles>& polygons) {
+    for (const auto& polygon : polygons) {
+        convolveSequences(result, b, e, begin_points(polygon), end_points(polygon));
+        for (auto hole = begin_holes(polygon); hole != end_holes(polygon); ++hole) {
+            convolveSequences(result, b, e, begin_points(*hole), end_points(*hole));
+        }
+    }
+}
+
+IntPolygonWithHoles truncated(const Polygon& polygon, double sign) {
+    auto ring = [sign](const Polygon& source) {
+        std::vector<IntPoint> points;
+        for (const auto& p : source.points) {
+            points.push_back(IntPoint(static_cast<int>(sign * p.x), static_cast<int>(sign * p.y)));
+        }
+        return points;
+    };
+    IntPolygonWithHoles result;
+    std::vector<IntPoint> outer = ring(polygon);
+    set_points(result, outer.begin(), outer.end());
+    std::vector<IntPolygon> holes;
+    for (const auto& child : polygon.children) {
+        std::vector<IntPoint> points = ring(child);
+        holes.push_back(IntPolygon(points.begin(), points.end()));
+    }
+    set_holes(result, holes.begin(), holes.end());
+    return result;
+}
+
+std::vector<Polygon> calculateNFP(const Polygon& A, const Polygon& B) {
+    IntPolygonSet setA, setB, result;
+    setA.insert(truncated(A, 1.0));
+    setB.insert(truncated(B, -1.0));
+
+    std::vector<IntPolygonWithHoles> aPolygons, bPolygons;
+    setA.get(aPolygons);
+    setB.get(bPolygons);
+    for (const auto& a : aPolygons) {
+        convolveWithPolygons(result, begin_points(a), end_points(a), bPolygons);
+        for (auto hole = begin_holes(a); hole != end_holes(a); ++hole) {
+            convolveWithPolygons(result, begin_points(*hole), end_points(*hole), bPolygons);
+        }
+        for (const auto& b : bPolygons) {
+            IntPolygonWithHoles moved = a;
+            result.insert(convolve(moved, *begin_points(b)));
+            moved = b;
+            result.insert(convolve(moved, *begin_points(a)));
+        }
+    }
+
+    std::vector<IntPolygonWithHoles> polygons;
+    result.get(polygons);
+    std::vector<Polygon> nfps;
+    for (const auto& polygon : polygons) {
+        Polygon nfp;
+        for (auto p = begin_points(polygon); p != end_points(polygon); ++p) {
+            nfp.points.push_back(Point(p->x(), p->y()));
+        }
+        for (auto hole = begin_holes(polygon); hole != end_holes(polygon); ++hole) {
+            Polygon child;
+            for (auto p = begin_points(*hole); p != end_points(*hole); ++p) {
+                child.points.push_back(Point(p->x(), p->y()));
+            }
+            nfp.children.push_back(child);
+        }
+        nfps.push_back(nfp);
+    }
+    return nfps;
+}
+
+} // namespace quadconvolution
+
+void testBatchedConvolution(NFPTestSuite& suite) {
+    suite.setPhase("PHASE 9.3: Batched Convolution vs Per-Quad Convolution");
+
+    std::mt19937 rng(1405);
+    std::uniform_int_distribution<int> tips(3, 12);
+    std::uniform_real_distribution<double> radius(200.0, 5000.0);
+    std::uniform_real_distribution<double> centre(-3000.0, 3000.0);
+
+    int identical = 0;
+    int withHoles = 0;
+    const int trials = 60;
+    for (int trial = 0; trial < trials; trial++) {
+        double outerA = radius(rng);
+        double outerB = radius(rng);
+        Polygon A = starRing(tips(rng), outerA, 0.5 * outerA, centre(rng), centre(rng));
+        Polygon B = starRing(tips(rng), outerB, 0.6 * outerB, centre(rng), centre(rng));
+        if (trial % 2 == 1) {
+            // Holes well inside the star's inner radius
+            Polygon hole = starRing(4, 0.2 * outerA, 0.1 * outerA, 0, 0);
+            for (auto& p : hole.points) {
+                p = p + A.points[0] - Point(outerA, 0);
+            }
+            A.children.push_back(hole);
+            if (trial % 4 == 3) {
+                Polygon holeB = squareRing(-0.1 * outerB, -0.1 * outerB, 0.2 * outerB);
+                for (auto& p : holeB.points) {
+                    p = p + B.points[0] - Point(outerB, 0);
+                }
+                B.children.push_back(holeB);
+            }
+            withHoles++;
+        }
+
+        std::vector<Polygon> batched = trunk::MinkowskiSum::calculateNFP(A, B);
+        std::vector<Polygon> reference = quadconvolution::calculateNFP(A, B);
+        if (!reference.empty() && almostEqualTrees(batched, reference, 1e-9)) {
+            identical++;
+        }
+    }
+
+    suite.addResult("Batched convolution - random stars", identical == trials,
+                   std::to_string(identical) + " of " + std::to_string(trials) + " NFPs identical (" +
+                   std::to_string(withHoles) + " with holes)",
+                   "Batching the edge-pair quads must not change any vertex of the NFP");
+}
+
+void testOrbitalTracer(NFPTestSuite& suite) {
+    suite.setPhase("PHASE 9.4: Orbital NFP vs Minkowski NFP");
+
+    DeepNestConfig config = DeepNestConfig::getInstance();
+    NFPCache cache;
+    NFPCalculator calculator(cache, config);
+
+    Polygon lShape;
+    lShape.id = 1;
+    lShape.points = {
+        Point(0, 0), Point(60, 0), Point(60, 20), Point(20, 20), Point(20, 50), Point(0, 50)
+    };
+    Polygon star = starRing(5, 12, 6, 3.5, -2.25);
+    star.id = 2;
+    Polygon square = squareRing(-4, 3, 8);
+    square.id = 3;
+
+    // B wound the other way around its own first vertex
+    auto reversed = [](Polygon polygon) {
+        std::reverse(polygon.points.begin() + 1, polygon.points.end());
+        return polygon;
+    };
+
+    struct Pair { const char* name; Polygon A; Polygon B; };
+    const std::vector<Pair> pairs = {
+        {"L-shape and star", lShape, star},
+        {"L-shape and square", lShape, square},
+        {"star and L-shape", star, lShape}
+    };
+
+    for (const auto& pair : pairs) {
+        std::vector<std::vector<Point>> traced = GeometryUtil::noFitPolygon(pair.A.points, pair.B.points);
+        std::vector<std::vector<Point>> turned =
+            GeometryUtil::noFitPolygon(pair.A.points, reversed(pair.B).points);
+        if (traced.empty() || turned.empty()) {
+            suite.addResult(std::string("Orbital NFP - ") + pair.name, false, "Trace did not close");
+            continue;
+        }
+
+        // Slide distances are measured at B's current offset, so no vertex
+        // of the loop pushes B into A
+        size_t overlapping = 0;
+        for (const auto& offset : traced[0]) {
+            Point shift = offset - pair.B.points[0];
+            if (GeometryUtil::polygonsOverlap(pair.A.points, pair.B.points, shift)) {
+                overlapping++;
+            }
+        }
+        suite.addResult(std::string("Orbital NFP - no overlap along the loop, ") + pair.name,
+                       overlapping == 0,
+                       std::to_string(overlapping) + " of " + std::to_string(traced[0].size()) +
+                       " positions overlap A");
+
+        // Rewinding B keeps its reference point, so the loop is the same
+        Polygon loop(traced[0]);
+        double turnedError = regionDifference(loop, Polygon(turned[0]));
+        std::ostringstream turnedMessage;
+        turnedMessage << "area difference " << std::scientific << std::setprecision(1) << turnedError;
+        suite.addResult(std::string("Orbital NFP - either winding of B, ") + pair.name,
+                       turnedError < 1e-6, turnedMessage.str());
+
+        // The loop is the outline of the Minkowski NFP (its pockets aside)
+        Polygon minkowski = calculator.computeWithBackend(NFPBackend::ClipperMinkowski, pair.A, pair.B);
+        minkowski.children.clear();
+        double error = minkowski.points.empty() ? 1.0 : regionDifference(minkowski, loop);
+        std::ostringstream oss;
+        oss << "area difference " << std::scientific << std::setprecision(1) << error;
+        suite.addResult(std::string("Orbital NFP - matches Minkowski outline, ") + pair.name,
+                       error < 1e-6, oss.str());
+    }
+
+    // Outer start candidates touch A without any part of B inside it
+    {
+        size_t candidates = 0;
+        size_t overlapping = 0;
+        for (const auto& pair : pairs) {
+            for (const auto& offset : GeometryUtil::searchStartPoints(pair.A.points, pair.B.points, false)) {
+                candidates++;
+                if (GeometryUtil::polygonsOverlap(pair.A.points, pair.B.points, offset)) {
+                    overlapping++;
+                }
+            }
+        }
+        suite.addResult("searchStartPoints - outer candidates do not overlap",
+                       candidates > 0 && overlapping == 0,
+                       std::to_string(overlapping) + " of " + std::to_string(candidates) +
+                       " candidates overlap A");
+    }
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -870,6 +1685,20 @@ int main(int argc, char* argv[]) {
         // PHASE 6: Regression tests
         testNFPRegressionCases(suite);
 
+        // PHASE 7: NFP storage
+        testCompactNFPEncoding(suite);
+        testPersistentNFPStore(suite);
+        testJobFile(suite);
+
+        // PHASE 8: Checkpoint and resume
+        testCheckpointResume(suite);
+
+        // PHASE 9: Shortcut paths
+        testMirroredNFP(suite);
+        testRectangleInnerNFP(suite);
+        testBatchedConvolution(suite);
+        testOrbitalTracer(suite);
+
         // Print summary
         suite.printSummary();
 
@@ -0,0 +1,340 @@
+/**
+ * @file NestingBenchmark.cpp
+ * @brief End-to-end nesting throughput benchmark
+ *
+ * Runs DeepNestSolver headless over a fixed corpus and writes one JSON
+ * document with the measurements, for comparing builds and thread counts:
+ *   - every SVG in the test data directory, imported with SvgImporter
+ *     (sheets from elements marked as containers, otherwise one rectangle
+ *     sized for the parts)
+ *   - RandomShapeGenerator jobs of the requested part counts, on one
+ *     sheet from generateContainerForShapes
+ *
+ * Each job runs a fixed number of generations with config.randomSeed set,
+ * so the genetic algorithm draws the same individuals on every run. Per
+ * job it reports evaluations/s, generations/s, time to the first result,
+ * peak resident memory, NFP cache hit rate and the final fitness.
+ *
+ * Peak RSS is the process high-water mark once the job has ended; jobs
+ * run in corpus order (SVGs, then generated jobs by size), so it is
+ * meaningful for the largest job so far.
+ *
+ * Usage: NestingBenchmark [--generations N] [--threads N] [--seed N]
+ *                         [--sizes 50,500,5000] [--testdata DIR] [--output FILE]
+ *                         [--trace FILE] [--stages]
+ * The JSON goes to FILE, or to stdout; progress goes to stderr. --trace
+ * writes a Chrome trace of all jobs (needs a DEEPNEST_TRACE build).
+ * --stages turns on config.stageTiming and adds the wall and CPU seconds
+ * of every stage to each job.
+ */
+
+#include "RandomShapeGenerator.h"
+#include "deepnest/DeepNestSolver.h"
+#include "deepnest/Trace.h"
+#include "deepnest/config/JsonWriter.h"
+#include "deepnest/converters/SvgImporter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifndef DEEPNEST_TESTDATA_DIR
+#define DEEPNEST_TESTDATA_DIR "testdata"
+#endif
+
+using namespace deepnest;
+
+namespace {
+
+struct Job {
+    std::string name;
+    std::vector<Polygon> parts;
+    std::vector<Polygon> sheets;
+};
+
+struct Measurement {
+    int parts = 0;
+    int sheets = 0;
+    int generations = 0;
+    int evaluations = 0;
+    double seconds = 0.0;
+    double firstResultSeconds = std::numeric_limits<double>::quiet_NaN();
+    double peakRssMB = 0.0;
+    NFPCache::Statistics cache;
+    double fitness = std::numeric_limits<double>::quiet_NaN();
+    StageTimes stages;
+};
+
+/**
+ * @brief Process peak resident set size in megabytes
+ */
+double peakRssMB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);  // bytes
+#else
+    return usage.ru_maxrss / 1024.0;              // kilobytes
+#endif
+#endif
+}
+
+/**
+ * @brief Rectangle of 3:2 aspect holding the parts at 60% utilisation
+ *        (the estimate of RandomShapeGenerator::generateContainerForShapes)
+ */
+Polygon sheetFor(const std::vector<Polygon>& parts) {
+    double area = 0.0;
+    for (const auto& part : parts) {
+        const BoundingBox box = part.bounds();
+        area += box.width * box.height;
+    }
+    const double width = std::sqrt(area / 0.6 * 1.5);
+    const double height = std::sqrt(area / 0.6 / 1.5);
+    return Polygon({Point(0, 0), Point(width, 0), Point(width, height), Point(0, height)}, -1);
+}
+
+std::vector<Job> loadSvgJobs(const std::string& directory) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.path().extension() == ".svg") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<Job> jobs;
+    SvgImporter importer;
+    for (const auto& file : files) {
+        SvgImporter::Result imported = importer.importFile(QString::fromStdString(file.string()));
+        if (!imported.success() || imported.parts.empty()) {
+            std::cerr << "Skipping " << file.string() << ": "
+                      << (imported.success() ? std::string("no parts") : imported.errorMessage.toStdString())
+                      << std::endl;
+            continue;
+        }
+
+        Job job;
+        job.name = file.stem().string();
+        job.parts = std::move(imported.parts);
+        job.sheets = std::move(imported.containers);
+        if (job.sheets.empty()) {
+            job.sheets.push_back(sheetFor(job.parts));
+        }
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+Job generatedJob(int count, unsigned int seed) {
+    RandomShapeGenerator::GeneratorConfig generator;
+    generator.seed = seed + static_cast<unsigned int>(count);
+    const std::vector<QPainterPath> shapes = RandomShapeGenerator::generateTestSet(count, 1000.0, 1000.0, generator);
+
+    Job job;
+    job.name = "random-" + std::to_string(count);
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        job.parts.push_back(Polygon::fromQPainterPath(shapes[i], static_cast<int>(i)));
+    }
+    job.sheets.push_back(Polygon::fromQPainterPath(RandomShapeGenerator::generateContainerForShapes(shapes), -1));
+    return job;
+}
+
+Measurement runJob(const Job& job, int generations) {
+    DeepNestSolver solver;
+    for (const auto& part : job.parts) {
+        solver.addPart(part);
+    }
+    for (const auto& sheet : job.sheets) {
+        solver.addSheet(sheet);
+    }
+
+    Measurement m;
+    m.parts = static_cast<int>(solver.getPartCount());
+    m.sheets = static_cast<int>(solver.getSheetCount());
+
+    const auto begin = std::chrono::steady_clock::now();
+    auto secondsSince = [begin]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+    solver.setResultCallback([&m, &secondsSince](const NestResult&) {
+        if (std::isnan(m.firstResultSeconds)) {
+            m.firstResultSeconds = secondsSince();
+        }
+    });
+
+    solver.runUntilComplete(generations, 10);
+    m.seconds = secondsSince();
+
+    const NestProgress progress = solver.getProgress();
+    m.generations = progress.generation;
+    m.evaluations = progress.evaluationsCompleted;
+    m.peakRssMB = peakRssMB();
+    m.cache = solver.getNfpCacheStatistics();
+    m.stages = progress.stageTimes;
+    if (const std::shared_ptr<const NestResult> best = solver.getBestResult()) {
+        m.fitness = best->fitness;
+    }
+    return m;
+}
+
+void write(JsonWriter& json, const std::string& name, const Measurement& m) {
+    const double lookups = static_cast<double>(m.cache.hits + m.cache.misses);
+    json.beginObject(name);
+    json.value("parts", m.parts);
+    json.value("sheets", m.sheets);
+    json.value("generations", m.generations);
+    json.value("evaluations", m.evaluations);
+    json.value("seconds", m.seconds);
+    json.value("evaluationsPerSecond", m.seconds > 0.0 ? m.evaluations / m.seconds : 0.0);
+    json.value("generationsPerSecond", m.seconds > 0.0 ? m.generations / m.seconds : 0.0);
+    json.value("timeToFirstResult", m.firstResultSeconds);
+    json.value("peakRssMB", m.peakRssMB);
+    json.value("nfpCacheHits", static_cast<double>(m.cache.hits));
+    json.value("nfpCacheMisses", static_cast<double>(m.cache.misses));
+    json.value("nfpCacheHitRate", lookups > 0.0 ? m.cache.hits / lookups : 0.0);
+    json.value("fitness", m.fitness);
+    if (DeepNestConfig::getInstance().stageTiming) {
+        json.beginObject("stages");
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            const Stage stage = static_cast<Stage>(i);
+            json.beginObject(StageTimes::name(stage));
+            json.value("count", static_cast<double>(m.stages[stage].count));
+            json.value("wallSeconds", m.stages[stage].wallNs / 1e9);
+            json.value("cpuSeconds", m.stages[stage].cpuNs / 1e9);
+            json.endObject();
+        }
+        json.endObject();
+    }
+    json.endObject();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    int generations = 10;
+    int threads = DeepNestConfig::getInstance().threads;
+    unsigned int seed = 1;
+    std::vector<int> sizes = {50, 500, 5000};
+    std::string testdata = DEEPNEST_TESTDATA_DIR;
+    std::string output;
+    std::string trace;
+    bool stages = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--generations" && hasValue) {
+            generations = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            std::istringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ',')) {
+                if (!size.empty()) {
+                    sizes.push_back(std::atoi(size.c_str()));
+                }
+            }
+        } else if (arg == "--testdata" && hasValue) {
+            testdata = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            trace = argv[++i];
+        } else if (arg == "--stages") {
+            stages = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--generations N] [--threads N] [--seed N]"
+                      << " [--sizes 50,500,5000] [--testdata DIR] [--output FILE] [--trace FILE] [--stages]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (generations < 1 || threads < 1 || seed == 0 ||
+        std::any_of(sizes.begin(), sizes.end(), [](int size) { return size < 1; })) {
+        std::cerr << "Generations, threads, seed and sizes must be positive" << std::endl;
+        return 1;
+    }
+
+    DeepNestConfig& config = DeepNestConfig::getInstance();
+    config.setThreads(threads);
+    config.randomSeed = seed;
+    config.timeoutSeconds = 0;
+    config.stageTiming = stages;
+
+    std::vector<Job> jobs = loadSvgJobs(testdata);
+    for (int size : sizes) {
+        jobs.push_back(generatedJob(size, seed));
+    }
+
+    JsonWriter json;
+    json.value("generations", generations);
+    json.value("threads", threads);
+    json.value("seed", static_cast<double>(seed));
+    if (!trace.empty()) {
+        Trace::start();
+    }
+    json.beginObject("jobs");
+    for (const auto& job : jobs) {
+        std::cerr << "Nesting " << job.name << " (" << job.parts.size() << " parts)..." << std::flush;
+        try {
+            const Measurement m = runJob(job, generations);
+            std::cerr << " " << m.seconds << " s" << std::endl;
+            write(json, job.name, m);
+        } catch (const std::exception& e) {
+            std::cerr << " ERROR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    json.endObject();
+
+    if (!trace.empty()) {
+        Trace::stop();
+        try {
+            Trace::writeChromeTrace(trace);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string document = json.str();
+    if (output.empty()) {
+        std::cout << document;
+    } else {
+        std::ofstream file(output);
+        if (!(file << document)) {
+            std::cerr << "Cannot write " << output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
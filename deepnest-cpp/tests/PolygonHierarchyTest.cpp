@@ -164,6 +164,47 @@ int main() {
         }
     }
     
+    // Test 5: Nested hierarchy, middle polygon listed first
+    {
+        std::cout << "\nTest 5: Nested hierarchy, middle listed first" << std::endl;
+        std::vector<Polygon> polygons;
+        
+        // Middle polygon (10,10 to 90,90)
+        Polygon middle;
+        middle.points = {{10, 10}, {90, 10}, {90, 90}, {10, 90}};
+        polygons.push_back(middle);
+        
+        // Inner polygon (30,30 to 70,70)
+        Polygon inner;
+        inner.points = {{30, 30}, {70, 30}, {70, 70}, {30, 70}};
+        polygons.push_back(inner);
+        
+        // Outer polygon (0,0 to 100,100)
+        Polygon outer;
+        outer.points = {{0, 0}, {100, 0}, {100, 100}, {0, 100}};
+        polygons.push_back(outer);
+        
+        // Build tree
+        std::vector<Polygon> tree = PolygonHierarchy::buildTree(polygons);
+        
+        std::cout << "Result: " << tree.size() << " top-level polygon(s)" << std::endl;
+        for (const auto& poly : tree) {
+            printPolygonTree(poly);
+        }
+        
+        // Verify: the middle polygon is placed in the outer before the
+        // inner is found in it, so the inner must move along with it
+        if (tree.size() == 1 && 
+            tree[0].children.size() == 1 && 
+            tree[0].children[0].children.size() == 1 &&
+            tree[0].children[0].children[0].points.size() == 4 &&
+            tree[0].children[0].children[0].points[0].x == 30) {
+            std::cout << "✅ Test 5 PASSED" << std::endl;
+        } else {
+            std::cout << "❌ Test 5 FAILED" << std::endl;
+        }
+    }
+    
     std::cout << "\n=== All Tests Complete ===" << std::endl;
     
     return 0;
@@ -857,8 +857,8 @@ void TestApplication::openConfigDialog() {
             gravityDir = deepnest::GravityDirection::BOTTOM_LEFT;
         }
         
-        // Apply gravity direction to DeepNestConfig
-        deepnest::DeepNestConfig& deepnestConfig = deepnest::DeepNestConfig::getInstance();
+        // Apply gravity direction to the solver's configuration
+        deepnest::DeepNestConfig& deepnestConfig = solver_->getConfig();
         deepnestConfig.gravityDirection = gravityDir;
         
         // Apply overlap tolerance to DeepNestConfig
@@ -941,7 +941,7 @@ void TestApplication::onStepTimer() {
         statusLabel_->setText("Complete");
         log("Nesting complete!");
 
-        const deepnest::NestResult* best = solver_->getBestResult();
+        const std::shared_ptr<const deepnest::NestResult> best = solver_->getBestResult();
         if (best) {
             log(QString("Final best fitness: %1").arg(best->fitness, 0, 'f', 2));
             // Visualize the final best result
@@ -1074,6 +1074,26 @@ void TestApplication::updateVisualization(const deepnest::NestResult& result) {
             QColor(255, 100, 150)   // Pink
         };
 
+        // Turn and move every placed outline and hole in one pass:
+        // rotate FIRST, then translate to final position + sheet offset
+        std::vector<deepnest::Transformation::BatchItem> items;
+        std::vector<size_t> firstRing;
+        firstRing.reserve(sheetPlacements.size());
+        for (const auto& placement : sheetPlacements) {
+            int sourceId = (placement.source >= 0) ? placement.source : placement.id;
+            firstRing.push_back(items.size());
+            if (sourceId >= 0 && sourceId < static_cast<int>(parts_.size())) {
+                const deepnest::Point offset(placement.position.x + sheetOffsetX, placement.position.y);
+                const deepnest::Polygon& part = parts_[sourceId];
+                items.emplace_back(&part.points, placement.rotation, offset);
+                for (const auto& hole : part.children) {
+                    items.emplace_back(&hole.points, placement.rotation, offset);
+                }
+            }
+        }
+        deepnest::RingBatch placedRings;
+        deepnest::Transformation::applyBatch(items, placedRings);
+
         // Draw each placed part
         int placementCount = 0;
         for (const auto& placement : sheetPlacements) {
@@ -1093,7 +1113,7 @@ void TestApplication::updateVisualization(const deepnest::NestResult& result) {
             int sourceId = (placement.source >= 0) ? placement.source : placement.id;
 
             if (sourceId >= 0 && sourceId < static_cast<int>(parts_.size())) {
-                deepnest::Polygon part = parts_[sourceId];
+                const deepnest::Polygon& part = parts_[sourceId];
 
                 // DETAILED LOGGING for first 3 placements
                 if (placementCount <= 3) {
@@ -1114,38 +1134,25 @@ void TestApplication::updateVisualization(const deepnest::NestResult& result) {
                     log(QString("  Original part points: %1").arg(origPoints));
                 }
 
-                // Apply transformation: rotate FIRST, then translate
-                // Step 1: Rotate around origin
-                deepnest::Polygon rotated = part.rotate(placement.rotation);
-
-                if (placementCount <= 3) {
-                    // Log rotated part (first 4 points)
-                    QString rotPoints;
-                    for (size_t i = 0; i < std::min(size_t(4), rotated.points.size()); ++i) {
-                        rotPoints += QString("(%1,%2) ")
-                            .arg(rotated.points[i].x, 0, 'f', 1)
-                            .arg(rotated.points[i].y, 0, 'f', 1);
-                    }
-                    log(QString("  After rotation points: %1").arg(rotPoints));
-                }
-
-                // Step 2: Translate to final position + sheet offset
-                deepnest::Polygon transformed = rotated.translate(
-                    placement.position.x + sheetOffsetX,
-                    placement.position.y);
+                const size_t ring = firstRing[placementCount - 1];
+                const size_t ringCount = 1 + part.children.size();
+                auto transformed = [&placedRings, ring]() {
+                    return std::vector<deepnest::Point>(placedRings.ringBegin(ring), placedRings.ringEnd(ring));
+                };
 
                 if (placementCount <= 3) {
                     // Log transformed part (first 4 points)
                     QString transPoints;
-                    for (size_t i = 0; i < std::min(size_t(4), transformed.points.size()); ++i) {
+                    const deepnest::Point* placedPoints = placedRings.ringBegin(ring);
+                    for (size_t i = 0; i < std::min(size_t(4), placedRings.ringSize(ring)); ++i) {
                         transPoints += QString("(%1,%2) ")
-                            .arg(transformed.points[i].x, 0, 'f', 1)
-                            .arg(transformed.points[i].y, 0, 'f', 1);
+                            .arg(placedPoints[i].x, 0, 'f', 1)
+                            .arg(placedPoints[i].y, 0, 'f', 1);
                     }
                     log(QString("  Final transformed points: %1").arg(transPoints));
 
                     // Log bounding box
-                    auto bbox = deepnest::GeometryUtil::getPolygonBounds(transformed.points);
+                    auto bbox = deepnest::GeometryUtil::getPolygonBounds(transformed());
                     log(QString("  Final bbox: (%1,%2) to (%3,%4)")
                         .arg(bbox.x, 0, 'f', 1)
                         .arg(bbox.y, 0, 'f', 1)
@@ -1155,11 +1162,11 @@ void TestApplication::updateVisualization(const deepnest::NestResult& result) {
 
                 // Draw with color based on source ID
                 QColor color = partColors[sourceId % 10];
-                drawPolygon(transformed, color, 0.5);
+                drawRings(placedRings, ring, ringCount, color, 0.5);
 
                 // Add PLACEMENT INDEX label on the part (if enabled)
                 if (showShapeIds_) {
-                    auto bbox = deepnest::GeometryUtil::getPolygonBounds(transformed.points);
+                    auto bbox = deepnest::GeometryUtil::getPolygonBounds(transformed());
                     double centerX = bbox.x + bbox.width / 2.0;
                     double centerY = bbox.y + bbox.height / 2.0;
 
@@ -1216,6 +1223,39 @@ void TestApplication::drawPolygon(const deepnest::Polygon& polygon, const QColor
     }
 }
 
+void TestApplication::drawRings(const deepnest::RingBatch& batch, size_t firstRing, size_t ringCount,
+                                const QColor& color, double fillOpacity) {
+    auto ringPath = [&batch](size_t ring) {
+        QPainterPath path;
+        const deepnest::Point* begin = batch.ringBegin(ring);
+        const deepnest::Point* end = batch.ringEnd(ring);
+        if (begin == end) {
+            return path;
+        }
+        path.moveTo(begin->toQt());
+        for (const deepnest::Point* p = begin + 1; p != end; ++p) {
+            path.lineTo(p->toQt());
+        }
+        path.closeSubpath();
+        return path;
+    };
+
+    // Same look as drawPolygon() without a border: holes are part of the
+    // outline path and drawn again on top
+    QPainterPath path = ringPath(firstRing);
+    for (size_t hole = firstRing + 1; hole < firstRing + ringCount; ++hole) {
+        path.addPath(ringPath(hole));
+    }
+
+    QColor fillColor = color;
+    fillColor.setAlphaF(fillOpacity);
+    scene_->addPath(path, QPen(Qt::NoPen), QBrush(fillColor));
+
+    for (size_t hole = firstRing + 1; hole < firstRing + ringCount; ++hole) {
+        scene_->addPath(ringPath(hole), QPen(Qt::red, 1), QBrush(Qt::white));
+    }
+}
+
 void TestApplication::clearScene() {
     scene_->clear();
 }
@@ -1380,7 +1420,7 @@ double TestApplication::runAutomaticTest(int generations) {
         solver_->step();
 
         // Get current state
-        const deepnest::NestResult* result = solver_->getBestResult();
+        const std::shared_ptr<const deepnest::NestResult> result = solver_->getBestResult();
         if (result != nullptr) {
             bestFitness_ = result->fitness;
             currentGeneration_ = result->generation;
@@ -1527,10 +1567,10 @@ void TestApplication::setContainerSize() {
             double minY = container.points[0].y, maxY = container.points[0].y;
 
             for (const auto& p : container.points) {
-                minX = std::min(minX, p.x);
-                maxX = std::max(maxX, p.x);
-                minY = std::min(minY, p.y);
-                maxY = std::max(maxY, p.y);
+                minX = std::min<double>(minX, p.x);
+                maxX = std::max<double>(maxX, p.x);
+                minY = std::min<double>(minY, p.y);
+                maxY = std::max<double>(maxY, p.y);
             }
 
             dialog.setWidth(maxX - minX);
@@ -1591,10 +1631,10 @@ void TestApplication::viewContainerInfo() {
     double minY = container.points[0].y, maxY = container.points[0].y;
 
     for (const auto& p : container.points) {
-        minX = std::min(minX, p.x);
-        maxX = std::max(maxX, p.x);
-        minY = std::min(minY, p.y);
-        maxY = std::max(maxY, p.y);
+        minX = std::min<double>(minX, p.x);
+        maxX = std::max<double>(maxX, p.x);
+        minY = std::min<double>(minY, p.y);
+        maxY = std::max<double>(maxY, p.y);
     }
 
     double width = maxX - minX;
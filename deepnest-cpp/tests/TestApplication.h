@@ -14,6 +14,8 @@
 
 #include "../include/deepnest/DeepNestSolver.h"
 #include "../include/deepnest/DebugConfig.h"
+#include "../include/deepnest/converters/QtMetaTypes.h"
+#include "../include/deepnest/geometry/Transformation.h"
 #include "ConfigDialog.h"
 #include "ContainerDialog.h"
 
@@ -289,6 +291,18 @@ private:
      */
     void drawPolygon(const deepnest::Polygon& polygon, const QColor& color, double fillOpacity = 0.3, bool showBorder = false);
 
+    /**
+     * @brief Draw a placed part from a batch of transformed rings
+     *
+     * @param batch Rings from Transformation::applyBatch()
+     * @param firstRing Outline ring of the part; its holes follow
+     * @param ringCount Outline plus holes
+     * @param color Color to use
+     * @param fillOpacity Fill opacity (0.0-1.0)
+     */
+    void drawRings(const deepnest::RingBatch& batch, size_t firstRing, size_t ringCount,
+                   const QColor& color, double fillOpacity = 0.3);
+
     /**
      * @brief Clear the graphics scene
      */
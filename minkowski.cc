@@ -3,7 +3,12 @@
 
 #include <iostream>
 #include <boost/polygon/polygon.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <cmath>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <sstream>
 #include <limits>
@@ -91,7 +96,21 @@ void convolve_two_polygon_sets(polygon_set& result, const polygon_set& a, const
   }
 }
 
-double inputscale;
+typedef std::pair<double, double> xy;
+
+// One A/B pair, read off the JS objects so it can be computed off the JS thread
+struct nfp_input {
+  std::vector<xy> a;
+  std::vector<std::vector<xy> > a_holes;
+  std::vector<xy> b;
+};
+
+struct nfp_output {
+  std::vector<polygon> polys;
+  double inputscale;
+  double xshift;
+  double yshift;
+};
 
 using v8::Local;
 using v8::Array;
@@ -103,45 +122,58 @@ using v8::Value;
 
 using namespace boost::polygon;
 
-NAN_METHOD(calculateNFP) {
-  //std::stringstream buffer;
-  //std::streambuf * old = std::cout.rdbuf(buffer.rdbuf());
-  
-  Isolate* isolate = info.GetIsolate();
+static void read_points(Isolate* isolate, Handle<Array> list, std::vector<xy>& out) {
+  unsigned int len = list->Length();
+  out.reserve(len);
+  for (unsigned int i = 0; i < len; i++) {
+    Local<Object> obj = Local<Object>::Cast(list->Get(i));
+    out.push_back(xy(obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue(),
+                     obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue()));
+  }
+}
 
-  Handle<Object> group = Handle<Object>::Cast(info[0]);
+static void read_input(Isolate* isolate, Handle<Object> group, nfp_input& in) {
   Handle<Array> A = Handle<Array>::Cast(group->Get(String::NewFromUtf8(isolate,"A")));
   Handle<Array> B = Handle<Array>::Cast(group->Get(String::NewFromUtf8(isolate,"B")));
-  
+  read_points(isolate, A, in.a);
+  read_points(isolate, B, in.b);
+
+  Local<Value> children = A->Get(String::NewFromUtf8(isolate,"children"));
+  if (children->IsArray()) {
+    Handle<Array> holes = Handle<Array>::Cast(children);
+    in.a_holes.resize(holes->Length());
+    for (unsigned int i = 0; i < holes->Length(); i++) {
+      read_points(isolate, Handle<Array>::Cast(holes->Get(i)), in.a_holes[i]);
+    }
+  }
+}
+
+// Pure C++, safe to run on any thread: the scale is per pair
+static void compute_nfp(const nfp_input& in, nfp_output& out) {
   polygon_set a, b, c;
-  std::vector<polygon> polys;
   std::vector<point> pts;
   
   // get maximum bounds for scaling factor
-  unsigned int len = A->Length();
   double Amaxx = 0;
   double Aminx = 0;
   double Amaxy = 0;
   double Aminy = 0;
-  for (unsigned int i = 0; i < len; i++) {
-  	Local<Object> obj = Local<Object>::Cast(A->Get(i));
-  	Amaxx = (std::max)(Amaxx, (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-  	Aminx = (std::min)(Aminx, (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-  	Amaxy = (std::max)(Amaxy, (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
-  	Aminy = (std::min)(Aminy, (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
+  for (std::size_t i = 0; i < in.a.size(); i++) {
+  	Amaxx = (std::max)(Amaxx, in.a[i].first);
+  	Aminx = (std::min)(Aminx, in.a[i].first);
+  	Amaxy = (std::max)(Amaxy, in.a[i].second);
+  	Aminy = (std::min)(Aminy, in.a[i].second);
   }
   
-  len = B->Length();
   double Bmaxx = 0;
   double Bminx = 0;
   double Bmaxy = 0;
   double Bminy = 0;
-  for (unsigned int i = 0; i < len; i++) {
-  	Local<Object> obj = Local<Object>::Cast(B->Get(i));
-  	Bmaxx = (std::max)(Bmaxx, (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-  	Bminx = (std::min)(Bminx, (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-  	Bmaxy = (std::max)(Bmaxy, (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
-  	Bminy = (std::min)(Bminy, (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
+  for (std::size_t i = 0; i < in.b.size(); i++) {
+  	Bmaxx = (std::max)(Bmaxx, in.b[i].first);
+  	Bminx = (std::min)(Bminx, in.b[i].first);
+  	Bmaxy = (std::max)(Bmaxy, in.b[i].second);
+  	Bminy = (std::min)(Bminy, in.b[i].second);
   }
   
   double Cmaxx = Amaxx + Bmaxx;
@@ -160,15 +192,11 @@ NAN_METHOD(calculateNFP) {
   }
   
   // why 0.1? dunno. it doesn't screw up with 0.1
-  inputscale = (0.1f * (double)(maxi)) / maxda;
+  double inputscale = (0.1f * (double)(maxi)) / maxda;
   
-  //double scale = 1000;
-  len = A->Length();
-  
-  for (unsigned int i = 0; i < len; i++) {
-    Local<Object> obj = Local<Object>::Cast(A->Get(i));
-    int x = (int)(inputscale * (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-    int y = (int)(inputscale * (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
+  for (std::size_t i = 0; i < in.a.size(); i++) {
+    int x = (int)(inputscale * in.a[i].first);
+    int y = (int)(inputscale * in.a[i].second);
         
     pts.push_back(point(x, y));
   }
@@ -178,17 +206,11 @@ NAN_METHOD(calculateNFP) {
   a+=poly;
   
   // subtract holes from a here...
-  Handle<Array> holes = Handle<Array>::Cast(A->Get(String::NewFromUtf8(isolate,"children")));
-  len = holes->Length();
-  
-  for(unsigned int i=0; i<len; i++){
-    Handle<Array> hole = Handle<Array>::Cast(holes->Get(i));
+  for(std::size_t i=0; i<in.a_holes.size(); i++){
     pts.clear();
-    unsigned int hlen = hole->Length();
-    for(unsigned int j=0; j<hlen; j++){
-    	Local<Object> obj = Local<Object>::Cast(hole->Get(j));
-    	int x = (int)(inputscale * (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-    	int y = (int)(inputscale * (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
+    for(std::size_t j=0; j<in.a_holes[i].size(); j++){
+    	int x = (int)(inputscale * in.a_holes[i][j].first);
+    	int y = (int)(inputscale * in.a_holes[i][j].second);
     	pts.push_back(point(x, y));
     }
     boost::polygon::set_points(poly, pts.begin(), pts.end());
@@ -197,32 +219,41 @@ NAN_METHOD(calculateNFP) {
   
   //and then load points B
   pts.clear();
-  len = B->Length();
   
   //javascript nfps are referenced with respect to the first point
   double xshift = 0;
   double yshift = 0;
   
-  for (unsigned int i = 0; i < len; i++) {
-    Local<Object> obj = Local<Object>::Cast(B->Get(i));
-    int x = -(int)(inputscale * (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue());
-    int y = -(int)(inputscale * (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue());
+  for (std::size_t i = 0; i < in.b.size(); i++) {
+    int x = -(int)(inputscale * in.b[i].first);
+    int y = -(int)(inputscale * in.b[i].second);
     pts.push_back(point(x, y));
     
     if(i==0){
-    	xshift = (double)obj->Get(String::NewFromUtf8(isolate,"x"))->NumberValue();
-    	yshift = (double)obj->Get(String::NewFromUtf8(isolate,"y"))->NumberValue();
+    	xshift = in.b[i].first;
+    	yshift = in.b[i].second;
     }
   }
   
   boost::polygon::set_points(poly, pts.begin(), pts.end());
   b+=poly;
   
-  polys.clear();
+  out.polys.clear();
   
   convolve_two_polygon_sets(c, a, b);
-  c.get(polys);
-  
+  c.get(out.polys);
+
+  out.inputscale = inputscale;
+  out.xshift = xshift;
+  out.yshift = yshift;
+}
+
+static Local<Array> to_js(Isolate* isolate, const nfp_output& out) {
+  const std::vector<polygon>& polys = out.polys;
+  const double inputscale = out.inputscale;
+  const double xshift = out.xshift;
+  const double yshift = out.yshift;
+
   Local<Array> result_list = Array::New(isolate);
   
   for(unsigned int i = 0; i < polys.size(); ++i ){
@@ -232,7 +263,6 @@ NAN_METHOD(calculateNFP) {
   	  	
   	for(polygon_traits<polygon>::iterator_type itr = polys[i].begin(); itr != polys[i].end(); ++itr) {
   	   Local<Object> p = Object::New(isolate);
-  	 //  std::cout << (double)(*itr).get(boost::polygon::HORIZONTAL) / inputscale << std::endl;
        p->Set(String::NewFromUtf8(isolate, "x"), v8::Number::New(isolate, ((double)(*itr).get(boost::polygon::HORIZONTAL)) / inputscale + xshift));
        p->Set(String::NewFromUtf8(isolate, "y"), v8::Number::New(isolate, ((double)(*itr).get(boost::polygon::VERTICAL)) / inputscale + yshift));
        
@@ -262,8 +292,118 @@ NAN_METHOD(calculateNFP) {
     
     result_list->Set(i, pointlist);
   }
+
+  return result_list;
+}
+
+NAN_METHOD(calculateNFP) {
+  Isolate* isolate = info.GetIsolate();
+
+  nfp_input in;
+  nfp_output out;
+  read_input(isolate, Handle<Object>::Cast(info[0]), in);
+  compute_nfp(in, out);
   
-  //std::string text = buffer.str();
-  
-  info.GetReturnValue().Set(result_list);  
+  info.GetReturnValue().Set(to_js(isolate, out));  
+}
+
+// A batch of pairs computed on a pool of boost threads. V8-free, so it can
+// run off the JS thread
+struct nfp_batch {
+  std::vector<nfp_input> inputs;
+  std::vector<nfp_output> outputs;
+  boost::atomic<std::size_t> next;
+  boost::mutex error_mutex;
+  std::string error;  // First exception thrown, if any
+
+  void run() {
+    outputs.clear();
+    outputs.resize(inputs.size());
+
+    unsigned int count = boost::thread::hardware_concurrency();
+    if (count < 1) {
+      count = 1;
+    }
+    if (count > inputs.size()) {
+      count = (unsigned int)inputs.size();
+    }
+
+    // Each thread takes the next unclaimed pair until none are left
+    next = 0;
+    boost::thread_group threads;
+    for (unsigned int t = 0; t < count; t++) {
+      threads.create_thread(boost::bind(&nfp_batch::work, this));
+    }
+    threads.join_all();
+  }
+
+  void work() {
+    for (;;) {
+      std::size_t i = next++;
+      if (i >= inputs.size()) {
+        return;
+      }
+      try {
+        compute_nfp(inputs[i], outputs[i]);
+      } catch (const std::exception& e) {
+        boost::lock_guard<boost::mutex> lock(error_mutex);
+        if (error.empty()) {
+          error = e.what();
+        }
+      }
+    }
+  }
+};
+
+// Runs a batch off the JS thread, then calls back with one result per pair
+// (in order). A node-style callback goes through MakeCallback, so work the
+// caller chains on it runs as soon as the batch is done
+class NFPBatchWorker : public Nan::AsyncWorker {
+ public:
+  NFPBatchWorker(std::vector<nfp_input>& pairs, Nan::Callback* callback)
+    : Nan::AsyncWorker(callback) {
+    batch.inputs.swap(pairs);
+  }
+
+  void Execute() {
+    batch.run();
+    if (!batch.error.empty()) {
+      SetErrorMessage(batch.error.c_str());
+    }
+  }
+
+  void HandleOKCallback() {
+    Nan::HandleScope scope;
+    Isolate* isolate = v8::Isolate::GetCurrent();
+
+    Local<Array> results = Array::New(isolate, (int)batch.outputs.size());
+    for (unsigned int i = 0; i < batch.outputs.size(); i++) {
+      results->Set(i, to_js(isolate, batch.outputs[i]));
+    }
+
+    Local<Value> argv[] = { Nan::Null(), results };
+    callback->Call(2, argv);
+  }
+
+ private:
+  nfp_batch batch;
+};
+
+// calculateNFPBatch([{A: A, B: B}, ...], function(err, [nfp, ...]) {...})
+NAN_METHOD(calculateNFPBatch) {
+  Isolate* isolate = info.GetIsolate();
+
+  if (!info[0]->IsArray() || !info[1]->IsFunction()) {
+    return Nan::ThrowTypeError("calculateNFPBatch expects an array of {A, B} pairs and a callback");
+  }
+
+  // The pairs are copied out here: JS objects cannot be read off the JS thread
+  Handle<Array> list = Handle<Array>::Cast(info[0]);
+  std::vector<nfp_input> pairs(list->Length());
+  for (unsigned int i = 0; i < list->Length(); i++) {
+    read_input(isolate, Handle<Object>::Cast(list->Get(i)), pairs[i]);
+  }
+
+  Nan::Callback* callback = new Nan::Callback(info[1].As<v8::Function>());
+  Nan::AsyncQueueWorker(new NFPBatchWorker(pairs, callback));
 }
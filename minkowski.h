@@ -3,3 +3,4 @@
 #include <boost/polygon/polygon.hpp>
 
 NAN_METHOD(calculateNFP);
+NAN_METHOD(calculateNFPBatch);
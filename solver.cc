@@ -0,0 +1,434 @@
+// N-API binding to the deepnest-cpp engine (see binding.gyp, target "solver",
+// built by "npm run build-solver")
+//
+// Unlike the NAN addon (addon.cc), which computes single NFPs and leaves
+// placement to JS, this runs a whole nest natively:
+//
+//   const solver = require('./build/Release/solver');
+//   solver.nest({
+//       parts:  [{ points: Float64Array, holes: [Float64Array], quantity: 2 }],
+//       sheets: [{ points: Float64Array, quantity: 1 }],
+//       config: { spacing: 2, rotations: 4 },   // DeepNestConfig JSON keys
+//       generations: 10                         // 0 = until the budget ends
+//   }, progress => console.log(progress.generation))
+//   .then(result => ...);
+//   solver.stop();   // ends every running nest with its best result so far
+//
+// Rings are flat x0, y0, x1, y1, ... arrays read in place from the typed
+// array's buffer, with no per-coordinate property access. The result is
+//   { fitness, area, mergedLength, generation, sheets: [Float64Array] }
+// (null when nothing was placed), where each sheet array holds
+// part, x, y, rotation per placement and part indexes options.parts.
+// The sheet arrays are handed over as external buffers where the runtime
+// allows them (Electron's V8 sandbox does not; they are copied there).
+//
+// The nest runs on the libuv thread pool, which steps DeepNestSolver;
+// progress is posted back to the JS thread. Each nest runs on its own copy
+// of the process defaults with options.config applied, so nests with
+// different settings can run at once.
+
+#include <node_api.h>
+#include "deepnest/DeepNestSolver.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace deepnest;
+
+namespace {
+
+struct Nest {
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_threadsafe_function progress = nullptr;
+
+    // Process defaults with options.config applied, copied on the JS thread
+    DeepNestConfig config = DeepNestConfig::getInstance();
+    std::vector<std::pair<Polygon, int>> parts;
+    std::vector<std::pair<Polygon, int>> sheets;
+    int generations = 0;
+    std::atomic<bool> cancelled{false};
+
+    // Set by the worker thread
+    std::vector<int> partIndex;   // Solver part -> options.parts index
+    bool placed = false;
+    NestResult best;
+    std::string error;
+};
+
+// Nests in flight, for stop()
+std::mutex runningMutex;
+std::set<Nest*> running;
+
+void check(napi_env env, napi_status status) {
+    if (status == napi_ok) {
+        return;
+    }
+    const napi_extended_error_info* info = nullptr;
+    napi_get_last_error_info(env, &info);
+    throw std::runtime_error(info && info->error_message ? info->error_message : "N-API call failed");
+}
+
+napi_value property(napi_env env, napi_value object, const char* name) {
+    napi_value value;
+    check(env, napi_get_named_property(env, object, name, &value));
+    return value;
+}
+
+bool isDefined(napi_env env, napi_value value) {
+    napi_valuetype type;
+    check(env, napi_typeof(env, value, &type));
+    return type != napi_undefined && type != napi_null;
+}
+
+std::string stringValue(napi_env env, napi_value value) {
+    size_t length = 0;
+    check(env, napi_get_value_string_utf8(env, value, nullptr, 0, &length));
+    std::string text(length, '\0');
+    check(env, napi_get_value_string_utf8(env, value, &text[0], length + 1, &length));
+    return text;
+}
+
+/**
+ * @brief Read a Float64Array of x, y pairs straight from its buffer
+ */
+std::vector<Point> readRing(napi_env env, napi_value value) {
+    bool typed = false;
+    check(env, napi_is_typedarray(env, value, &typed));
+    napi_typedarray_type type = napi_int8_array;
+    size_t length = 0;
+    void* data = nullptr;
+    if (typed) {
+        check(env, napi_get_typedarray_info(env, value, &type, &length, &data, nullptr, nullptr));
+    }
+    if (!typed || type != napi_float64_array || length % 2 != 0) {
+        throw std::invalid_argument("rings must be Float64Arrays of x, y pairs");
+    }
+
+    const double* xy = static_cast<const double*>(data);
+    std::vector<Point> points;
+    points.reserve(length / 2);
+    for (size_t i = 0; i < length; i += 2) {
+        points.emplace_back(xy[i], xy[i + 1]);
+    }
+    return points;
+}
+
+/**
+ * @brief Read { points, holes, quantity } items
+ */
+std::vector<std::pair<Polygon, int>> readShapes(napi_env env, napi_value array, const char* what) {
+    bool isArray = false;
+    check(env, napi_is_array(env, array, &isArray));
+    if (!isArray) {
+        throw std::invalid_argument(std::string(what) + " must be an array");
+    }
+
+    uint32_t count = 0;
+    check(env, napi_get_array_length(env, array, &count));
+    std::vector<std::pair<Polygon, int>> shapes;
+    shapes.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        napi_value item;
+        check(env, napi_get_element(env, array, i, &item));
+
+        Polygon polygon(readRing(env, property(env, item, "points")));
+        napi_value holes = property(env, item, "holes");
+        if (isDefined(env, holes)) {
+            uint32_t holeCount = 0;
+            check(env, napi_get_array_length(env, holes, &holeCount));
+            for (uint32_t h = 0; h < holeCount; ++h) {
+                napi_value hole;
+                check(env, napi_get_element(env, holes, h, &hole));
+                polygon.children.emplace_back(readRing(env, hole));
+            }
+        }
+
+        int quantity = 1;
+        napi_value qty = property(env, item, "quantity");
+        if (isDefined(env, qty)) {
+            check(env, napi_get_value_int32(env, qty, &quantity));
+        }
+        shapes.emplace_back(std::move(polygon), quantity);
+    }
+    return shapes;
+}
+
+/**
+ * @brief Load options.config, an object or JSON text, into a nest's configuration
+ */
+void applyConfig(napi_env env, napi_value config, DeepNestConfig& target) {
+    napi_valuetype type;
+    check(env, napi_typeof(env, config, &type));
+    if (type != napi_string) {
+        napi_value global, json, stringify;
+        check(env, napi_get_global(env, &global));
+        json = property(env, global, "JSON");
+        stringify = property(env, json, "stringify");
+        check(env, napi_call_function(env, json, stringify, 1, &config, &config));
+    }
+    target.loadFromJsonData(stringValue(env, config));
+}
+
+napi_value number(napi_env env, double value) {
+    napi_value result;
+    check(env, napi_create_double(env, value, &result));
+    return result;
+}
+
+void setNumber(napi_env env, napi_value object, const char* name, double value) {
+    check(env, napi_set_named_property(env, object, name, number(env, value)));
+}
+
+/**
+ * @brief Float64Array over the vector, without a copy where allowed
+ */
+napi_value float64Array(napi_env env, std::vector<double>* values) {
+    const size_t bytes = values->size() * sizeof(double);
+    napi_value buffer;
+    if (napi_create_external_arraybuffer(env, values->data(), bytes,
+            [](napi_env, void*, void* hint) { delete static_cast<std::vector<double>*>(hint); },
+            values, &buffer) != napi_ok) {
+        // Pending exception from the refused external buffer, if any
+        bool pending = false;
+        napi_is_exception_pending(env, &pending);
+        if (pending) {
+            napi_value ignored;
+            napi_get_and_clear_last_exception(env, &ignored);
+        }
+        void* data = nullptr;
+        napi_status status = napi_create_arraybuffer(env, bytes, &data, &buffer);
+        if (status == napi_ok && bytes > 0) {
+            std::memcpy(data, values->data(), bytes);
+        }
+        delete values;
+        check(env, status);
+    }
+
+    napi_value array;
+    check(env, napi_create_typedarray(env, napi_float64_array, bytes / sizeof(double), buffer, 0, &array));
+    return array;
+}
+
+// JS thread: deliver one progress report
+void callProgress(napi_env env, napi_value callback, void*, void* data) {
+    std::unique_ptr<NestProgress> progress(static_cast<NestProgress*>(data));
+    if (!env) {
+        return;   // Environment shutting down
+    }
+
+    try {
+        napi_value report, undefined, ignored;
+        check(env, napi_create_object(env, &report));
+        setNumber(env, report, "generation", progress->generation);
+        setNumber(env, report, "evaluations", progress->evaluationsCompleted);
+        setNumber(env, report, "bestFitness", progress->bestFitness);
+        setNumber(env, report, "percent", progress->percentComplete);
+        check(env, napi_get_undefined(env, &undefined));
+        napi_call_function(env, undefined, callback, 1, &report, &ignored);
+    } catch (const std::exception&) {
+        // Nothing to report to; the nest carries on
+    }
+}
+
+// Worker thread: run the nest to the end of its budget or stop()
+void execute(napi_env, void* data) {
+    Nest* nest = static_cast<Nest*>(data);
+    try {
+        DeepNestSolver solver(nest->config);
+        for (size_t i = 0; i < nest->parts.size(); ++i) {
+            const size_t before = solver.getPartCount();
+            solver.addPart(nest->parts[i].first, nest->parts[i].second);
+            if (solver.getPartCount() > before) {
+                nest->partIndex.push_back(static_cast<int>(i));
+            }
+        }
+        for (const auto& sheet : nest->sheets) {
+            solver.addSheet(sheet.first, sheet.second);
+        }
+        nest->parts.clear();
+        nest->sheets.clear();
+
+        if (nest->progress) {
+            solver.setProgressCallback([nest](const NestProgress& progress) {
+                NestProgress* copy = new NestProgress(progress);
+                if (napi_call_threadsafe_function(nest->progress, copy, napi_tsfn_nonblocking) != napi_ok) {
+                    delete copy;
+                }
+            });
+        }
+
+        solver.start(nest->generations);
+        while (!nest->cancelled && solver.step()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        solver.stop();
+
+        if (const std::shared_ptr<const NestResult> best = solver.getBestResult()) {
+            nest->best = *best;
+            nest->placed = true;
+        }
+    } catch (const std::exception& e) {
+        nest->error = e.what();
+    }
+}
+
+napi_value resultObject(napi_env env, const Nest& nest) {
+    napi_value result;
+    if (!nest.placed) {
+        check(env, napi_get_null(env, &result));
+        return result;
+    }
+
+    check(env, napi_create_object(env, &result));
+    setNumber(env, result, "fitness", nest.best.fitness);
+    setNumber(env, result, "area", nest.best.area);
+    setNumber(env, result, "mergedLength", nest.best.mergedLength);
+    setNumber(env, result, "generation", nest.best.generation);
+
+    napi_value sheets;
+    check(env, napi_create_array_with_length(env, nest.best.placements.size(), &sheets));
+    for (size_t s = 0; s < nest.best.placements.size(); ++s) {
+        auto* values = new std::vector<double>();
+        values->reserve(nest.best.placements[s].size() * 4);
+        for (const auto& placement : nest.best.placements[s]) {
+            const bool known = placement.source >= 0 &&
+                               placement.source < static_cast<int>(nest.partIndex.size());
+            values->push_back(known ? nest.partIndex[placement.source] : -1);
+            values->push_back(placement.position.x);
+            values->push_back(placement.position.y);
+            values->push_back(placement.rotation);
+        }
+        check(env, napi_set_element(env, sheets, static_cast<uint32_t>(s), float64Array(env, values)));
+    }
+    check(env, napi_set_named_property(env, result, "sheets", sheets));
+    return result;
+}
+
+// JS thread: settle the promise and free the nest
+void complete(napi_env env, napi_status status, void* data) {
+    std::unique_ptr<Nest> nest(static_cast<Nest*>(data));
+    {
+        std::lock_guard<std::mutex> lock(runningMutex);
+        running.erase(nest.get());
+    }
+    if (nest->progress) {
+        napi_release_threadsafe_function(nest->progress, napi_tsfn_release);
+    }
+
+    napi_value value;
+    bool resolved = false;
+    try {
+        if (status != napi_ok) {
+            throw std::runtime_error("nest was cancelled");
+        }
+        if (!nest->error.empty()) {
+            throw std::runtime_error(nest->error);
+        }
+        value = resultObject(env, *nest);
+        resolved = true;
+    } catch (const std::exception& e) {
+        napi_value message;
+        napi_create_string_utf8(env, e.what(), NAPI_AUTO_LENGTH, &message);
+        napi_create_error(env, nullptr, message, &value);
+    }
+
+    if (resolved) {
+        napi_resolve_deferred(env, nest->deferred, value);
+    } else {
+        napi_reject_deferred(env, nest->deferred, value);
+    }
+    napi_delete_async_work(env, nest->work);
+}
+
+// nest(options, onProgress?) -> Promise
+napi_value Nest_(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    napi_value promise = nullptr;
+    auto nest = std::make_unique<Nest>();
+
+    try {
+        check(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+        if (argc < 1) {
+            throw std::invalid_argument("nest(options, onProgress) needs options");
+        }
+
+        napi_value config = property(env, argv[0], "config");
+        if (isDefined(env, config)) {
+            applyConfig(env, config, nest->config);
+        }
+        nest->parts = readShapes(env, property(env, argv[0], "parts"), "parts");
+        nest->sheets = readShapes(env, property(env, argv[0], "sheets"), "sheets");
+        napi_value generations = property(env, argv[0], "generations");
+        if (isDefined(env, generations)) {
+            check(env, napi_get_value_int32(env, generations, &nest->generations));
+        }
+
+        napi_value name;
+        check(env, napi_create_string_utf8(env, "deepnest.nest", NAPI_AUTO_LENGTH, &name));
+        if (argc > 1 && isDefined(env, argv[1])) {
+            check(env, napi_create_threadsafe_function(env, argv[1], nullptr, name, 0, 1, nullptr, nullptr,
+                                                       nullptr, callProgress, &nest->progress));
+        }
+
+        check(env, napi_create_promise(env, &nest->deferred, &promise));
+        check(env, napi_create_async_work(env, nullptr, name, execute, complete, nest.get(), &nest->work));
+        check(env, napi_queue_async_work(env, nest->work));
+    } catch (const std::exception& e) {
+        if (nest->progress) {
+            napi_release_threadsafe_function(nest->progress, napi_tsfn_abort);
+        }
+        if (nest->work) {
+            napi_delete_async_work(env, nest->work);
+        }
+        if (promise) {
+            // Rejects the promise, which is then dropped
+            napi_value message, error;
+            napi_create_string_utf8(env, e.what(), NAPI_AUTO_LENGTH, &message);
+            napi_create_error(env, nullptr, message, &error);
+            napi_reject_deferred(env, nest->deferred, error);
+        }
+        napi_throw_type_error(env, nullptr, e.what());
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(runningMutex);
+    running.insert(nest.release());
+    return promise;
+}
+
+// stop(): running nests end with their best result so far
+napi_value Stop(napi_env env, napi_callback_info) {
+    {
+        std::lock_guard<std::mutex> lock(runningMutex);
+        for (Nest* nest : running) {
+            nest->cancelled = true;
+        }
+    }
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+napi_value Init(napi_env env, napi_value exports) {
+    napi_property_descriptor properties[] = {
+        { "nest", nullptr, Nest_, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "stop", nullptr, Stop, nullptr, nullptr, nullptr, napi_default, nullptr },
+    };
+    napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties);
+    return exports;
+}
+
+} // anonymous namespace
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)